@@ -69,6 +69,13 @@ elseif(CC_IS_EMSCRIPTEN)
     set(CMAKE_RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/public_html)
     set(CMAKE_EXECUTABLE_SUFFIX ".html")
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${EMCC_COMPILE_FLAGS}")
+
+    if (BUILD_WASM_AUDIO_WORKLET)
+        # threads for the audio worker and the driver, SIMD for the mixer and the synthesizers
+        set(EMCC_THREADS_FLAGS "-pthread -msimd128 -msse2")
+        set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${EMCC_THREADS_FLAGS}")
+        set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${EMCC_THREADS_FLAGS}")
+    endif(BUILD_WASM_AUDIO_WORKLET)
     set(CMAKE_TOOLCHAIN_FILE ${EMCC_CMAKE_TOOLCHAIN})
     set(CMAKE_INSTALL_RPATH_USE_LINK_PATH TRUE)
 
@@ -0,0 +1,101 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include <vector>
+
+#include "mtest/testutils.h"
+
+#include "audio/internal/synthesizers/zerberus/internal/zerberus.h"
+#include "audio/internal/synthesizers/zerberus/internal/voicekernels.h"
+
+using namespace mu::zerberus;
+
+static constexpr float SAMPLE_RATE = 44100;
+static constexpr unsigned BLOCK_FRAMES = 512;
+static constexpr double AUDIO_SECONDS = 10.0;
+
+//---------------------------------------------------------
+//   TestSfzBenchmark
+//    renders a looping sample with a growing number of
+//    voices and reports how many of them one core can
+//    render in real time
+//---------------------------------------------------------
+
+class TestSfzBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void voicesPerCore_data();
+    void voicesPerCore();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzBenchmark::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   voicesPerCore
+//---------------------------------------------------------
+
+void TestSfzBenchmark::voicesPerCore_data()
+{
+    QTest::addColumn<int>("voices");
+
+    QTest::newRow("8") << 8;
+    QTest::newRow("64") << 64;
+    QTest::newRow("256") << 256;
+}
+
+void TestSfzBenchmark::voicesPerCore()
+{
+    QFETCH(int, voices);
+
+    Zerberus synth;
+    synth.setSampleRate(SAMPLE_RATE);
+    synth.setRenderThreads(1);
+    QVERIFY(synth.addSoundFont(root + "/zerberus/benchmark/benchmark.sfz"));
+
+    // one voice per key, spread over the channels
+    for (int i = 0; i < voices; ++i) {
+        QVERIFY(synth.noteOn(i / 128, i % 128, 100));
+    }
+
+    std::vector<float> buffer(BLOCK_FRAMES * 2);
+    const unsigned blocks = unsigned(AUDIO_SECONDS * SAMPLE_RATE / BLOCK_FRAMES);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (unsigned i = 0; i < blocks; ++i) {
+        std::fill(buffer.begin(), buffer.end(), 0.f);
+        synth.process(BLOCK_FRAMES, buffer.data(), nullptr, nullptr);
+    }
+    const double cpuSeconds = timer.nsecsElapsed() / 1e9;
+
+    const double realtimeFactor = (blocks * BLOCK_FRAMES / SAMPLE_RATE) / cpuSeconds;
+    qInfo("%s: %d voices rendered %.1fx real time, ~%d voices per core",
+          voiceKernels().name, voices, realtimeFactor, int(voices * realtimeFactor));
+
+    QVERIFY(buffer[0] != 0.f || buffer[1] != 0.f);
+}
+
+QTEST_MAIN(TestSfzBenchmark)
+
+#include "tst_sfzbenchmark.moc"
@@ -20,12 +20,14 @@
 #include "appshell.h"
 
 #include <QApplication>
+#include <QElapsedTimer>
 #include <QQmlApplicationEngine>
 #include <QQuickWindow>
 #ifndef Q_OS_WASM
 #include <QThreadPool>
 #endif
 #include "log.h"
+#include "perfcounters.h"
 #include "modularity/ioc.h"
 #include "ui/internal/uiengine.h"
 #include "version.h"
@@ -49,8 +51,19 @@ void AppShell::addModule(mu::framework::IModuleSetup* module)
     m_modules.push_back(module);
 }
 
+void AppShell::initModule(mu::framework::IModuleSetup* module, const framework::IApplication::RunMode& runMode)
+{
+    QElapsedTimer timer;
+    timer.start();
+    module->onInit(runMode);
+    LOGI() << module->moduleName() << " onInit: " << timer.elapsed() << " ms";
+}
+
 int AppShell::run(int argc, char** argv)
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
     // ====================================================
     // Setup global Qt application variables
     // ====================================================
@@ -103,19 +116,42 @@ int AppShell::run(int argc, char** argv)
     // ====================================================
     // Setup modules: onInit
     // ====================================================
+    //! NOTE The deferred modules are initialized by the first resolve of one of their exports,
+    //! so a module which needs one of them gets it initialized
     globalModule.onInit(runMode);
     for (mu::framework::IModuleSetup* m : m_modules) {
-        m->onInit(runMode);
+        if (m->isInitDeferred()) {
+            framework::ioc()->setModuleInit(m->moduleName(), [this, m, runMode]() {
+                initModule(m, runMode);
+            });
+        } else {
+            initModule(m, runMode);
+        }
     }
 
+    mu::perfcounters::record(mu::perfcounters::Histogram::StartupInitMs, startupTimer.elapsed());
+
     // ====================================================
     // Setup modules: onStartApp (on next event loop)
     // ====================================================
-    QMetaObject::invokeMethod(qApp, [this]() {
+    QMetaObject::invokeMethod(qApp, [this, startupTimer]() {
         globalModule.onStartApp();
         for (mu::framework::IModuleSetup* m : m_modules) {
-            m->onStartApp();
+            if (!m->isInitDeferred()) {
+                m->onStartApp();
+            }
         }
+        mu::perfcounters::record(mu::perfcounters::Histogram::StartupTotalMs, startupTimer.elapsed());
+
+        //! NOTE The deferred modules which were not needed yet are initialized once the application has started
+        QMetaObject::invokeMethod(qApp, [this]() {
+            for (mu::framework::IModuleSetup* m : m_modules) {
+                if (m->isInitDeferred()) {
+                    framework::ioc()->initModule(m->moduleName());
+                    m->onStartApp();
+                }
+            }
+        }, Qt::QueuedConnection);
     }, Qt::QueuedConnection);
 
     // ====================================================
@@ -200,10 +236,13 @@ int AppShell::run(int argc, char** argv)
 
     // Deinit
     for (mu::framework::IModuleSetup* m : m_modules) {
-        m->onDeinit();
+        if (!framework::ioc()->isModuleInitPending(m->moduleName())) {
+            m->onDeinit();
+        }
     }
 
     PROFILER_PRINT;
+    mu::tracer::stop();
 
     globalModule.onDeinit();
 
@@ -213,13 +252,28 @@ int AppShell::run(int argc, char** argv)
 int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 {
     Ret ret;
-    if (task.isBatchMode) {
-        ret = converter()->batchConvert(task.inputFile);
+    if (task.isServerMode) {
+        ret = converter()->runServer(task.serverName.toStdString());
+        if (!ret) {
+            LOGE() << "failed run converter server, error: " << ret.toString();
+        }
+    } else if (task.isMemoryReport) {
+        ret = converter()->memoryReport(task.inputFile, task.outputFile);
+        if (!ret) {
+            LOGE() << "failed memory report, error: " << ret.toString();
+        }
+    } else if (task.isBatchMode) {
+        ret = converter()->batchConvert(task.inputFile, task.resultFile, task.jobs);
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
         }
+    } else if (task.isStems) {
+        ret = converter()->stemsConvert(task.inputFile, task.outputFile);
+        if (!ret) {
+            LOGE() << "failed stems convert, error: " << ret.toString();
+        }
     } else {
-        ret = converter()->fileConvert(task.inputFile, task.outputFile);
+        ret = converter()->fileConvert(task.inputFile, task.outputFile, task.range);
         if (!ret) {
             LOGE() << "failed file convert, error: " << ret.toString();
         }
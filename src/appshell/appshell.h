@@ -44,6 +44,7 @@ public:
 
 private:
 
+    void initModule(mu::framework::IModuleSetup* module, const framework::IApplication::RunMode& runMode);
     int processConverter(const CommandLineController::ConverterTask& task);
 
     QList<mu::framework::IModuleSetup*> m_modules;
@@ -23,6 +23,25 @@
 using namespace mu::appshell;
 using namespace mu::framework;
 
+//! NOTE "first-last" or "first", the numbers start from 1
+static bool parseRange(const QString& value, int& first, int& last)
+{
+    const QStringList parts = value.split('-');
+    if (parts.size() > 2) {
+        return false;
+    }
+
+    bool ok = false;
+    first = parts.first().toInt(&ok);
+    if (ok && parts.size() == 2) {
+        last = parts.last().toInt(&ok);
+    } else {
+        last = first;
+    }
+
+    return ok && first > 0 && first <= last;
+}
+
 void CommandLineController::parse(const QStringList& args)
 {
     // Common
@@ -32,11 +51,31 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
     m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    m_parser.addOption(QCommandLineOption("trace", "Record the scopes of all threads and save them as a Chrome trace to 'file' on exit",
+                                          "file"));
 
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("jobs", "Run the conversion job in N worker processes", "N"));
+    m_parser.addOption(QCommandLineOption("job-result", "Write the result and timing of each job of the conversion job to 'file'", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption("export-pages",
+                                          "With -o, export only the pages 'first-last' of a PDF, PNG or SVG export, "
+                                          "for putting it together with the other parts later",
+                                          "range"));
+    m_parser.addOption(QCommandLineOption("export-measures",
+                                          "With -o, export only the measures 'first-last' of an audio export, "
+                                          "for putting it together with the other parts later",
+                                          "range"));
+    m_parser.addOption(QCommandLineOption("export-stems",
+                                          "With -o, also export each part of an audio export alone, to 'name-1.ext', "
+                                          "'name-2.ext', ..., from one render of the score"));
+    m_parser.addOption(QCommandLineOption("converter-server",
+                                          "Keep running and take conversion jobs as JSON lines over the local socket 'name'",
+                                          "name"));
+    m_parser.addOption(QCommandLineOption("memory-report", "Write what the score holds in memory, by element type, as JSON to 'file'",
+                                          "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
 
@@ -67,6 +106,10 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("trace")) {
+        mu::tracer::start(m_parser.value("trace").toStdString());
+    }
+
     // Converter mode
     if (m_parser.isSet("r")) {
         std::optional<float> val = floatValue("r");
@@ -88,12 +131,54 @@ void CommandLineController::apply()
             m_converterTask.inputFile = scorefiles[0];
             m_converterTask.outputFile = m_parser.value("o");
         }
+
+        converter::ExportRange& range = m_converterTask.range;
+        if (m_parser.isSet("export-pages") && !parseRange(m_parser.value("export-pages"), range.firstPage, range.lastPage)) {
+            LOGE() << "Option: --export-pages not recognized range: " << m_parser.value("export-pages");
+            range.firstPage = range.lastPage = 0;
+        }
+        if (m_parser.isSet("export-measures") && !parseRange(m_parser.value("export-measures"), range.firstMeasure, range.lastMeasure)) {
+            LOGE() << "Option: --export-measures not recognized range: " << m_parser.value("export-measures");
+            range.firstMeasure = range.lastMeasure = 0;
+        }
+        m_converterTask.isStems = m_parser.isSet("export-stems");
+        if (m_converterTask.isStems && !range.isEmpty()) {
+            LOGW() << "Option: --export-stems exports the whole score, the range is ignored";
+        }
     }
 
     if (m_parser.isSet("j")) {
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.isBatchMode = true;
         m_converterTask.inputFile = m_parser.value("j");
+        m_converterTask.resultFile = m_parser.value("job-result");
+
+        if (m_parser.isSet("jobs")) {
+            bool ok = false;
+            int jobs = m_parser.value("jobs").toInt(&ok);
+            if (ok && jobs > 0) {
+                m_converterTask.jobs = jobs;
+            } else {
+                LOGE() << "Option: --jobs not recognized number of workers: " << m_parser.value("jobs");
+            }
+        }
+    }
+
+    if (m_parser.isSet("converter-server")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.isServerMode = true;
+        m_converterTask.serverName = m_parser.value("converter-server");
+    }
+
+    if (m_parser.isSet("memory-report")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        if (scorefiles.size() < 1) {
+            LOGE() << "Option: --memory-report no input file specified";
+        } else {
+            m_converterTask.isMemoryReport = true;
+            m_converterTask.inputFile = scorefiles[0];
+            m_converterTask.outputFile = m_parser.value("memory-report");
+        }
     }
 
     if (m_parser.isSet("F") || m_parser.isSet("R")) {
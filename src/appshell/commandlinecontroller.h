@@ -26,6 +26,7 @@
 #include "global/iapplication.h"
 #include "ui/iuiconfiguration.h"
 #include "importexport/imagesexport/iimagesexportconfiguration.h"
+#include "converter/convertertypes.h"
 #include "iappshellconfiguration.h"
 
 namespace mu::appshell {
@@ -41,8 +42,15 @@ public:
 
     struct ConverterTask {
         bool isBatchMode = false;
+        bool isServerMode = false;
+        bool isMemoryReport = false;
+        bool isStems = false;
         QString inputFile;
         QString outputFile;
+        QString resultFile;
+        int jobs = 1;
+        QString serverName;
+        converter::ExportRange range;
     };
 
     void parse(const QStringList& args);
@@ -5,6 +5,7 @@ import MuseScore.Ui 1.0
 import MuseScore.UiComponents 1.0
 import MuseScore.Plugins 1.0
 import MuseScore.Audio 1.0
+import MuseScore.NotationScene 1.0
 
 import "../Settings"
 import "./Gallery"
@@ -43,6 +44,9 @@ DockPage {
                         { "name": "gallery", "title": "UI Gallery" },
                         { "name": "interactive", "title": "Interactive" },
                         { "name": "mu3dialogs", "title": "MU3Dialogs" },
+                        { "name": "layout", "title": "Layout" },
+                        { "name": "commands", "title": "Commands" },
+                        { "name": "memory", "title": "Memory" },
                         { "name": "telemetry", "title": "Telemetry" },
                         { "name": "audio", "title": "Audio" },
                         { "name": "synth", "title": "Synth" },
@@ -73,6 +77,9 @@ DockPage {
             case "gallery": currentComp = galleryComp; break
             case "interactive": currentComp = interactiveComp; break
             case "mu3dialogs": currentComp = notationDialogs; break
+            case "layout": currentComp = layoutStatisticsComp; break
+            case "commands": currentComp = commandStatisticsComp; break
+            case "memory": currentComp = memoryReportComp; break
             case "telemetry": currentComp = telemetryComp; break
             case "audio": currentComp = audioComp; break
             case "synth": currentComp = synthSettingsComp; break
@@ -112,6 +119,21 @@ DockPage {
         MU3Dialogs {}
     }
 
+    Component {
+        id: layoutStatisticsComp
+        LayoutStatistics {}
+    }
+
+    Component {
+        id: commandStatisticsComp
+        CommandStatistics {}
+    }
+
+    Component {
+        id: memoryReportComp
+        MemoryReport {}
+    }
+
     Component {
         id: telemetryComp
         Loader {
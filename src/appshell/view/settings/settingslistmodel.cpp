@@ -25,7 +25,7 @@ using namespace mu;
 using namespace mu::framework;
 
 SettingListModel::SettingListModel(QObject* parent)
-    : QAbstractListModel(parent)
+    : IncrementalListModel(parent)
 {
 }
 
@@ -63,17 +63,21 @@ QHash<int,QByteArray> SettingListModel::roleNames() const
 
 void SettingListModel::load()
 {
-    beginResetModel();
-
-    m_items.clear();
+    QList<Settings::Item> newItems;
 
     Settings::Items items = settings()->items();
 
     for (auto it = items.cbegin(); it != items.cend(); ++it) {
-        m_items << it->second;
+        newItems << it->second;
     }
 
-    endResetModel();
+    auto keyOf = [](const Settings::Item& item) {
+        return item.key.moduleName + "/" + item.key.key;
+    };
+
+    updateItems(m_items, newItems, keyOf, [](const Settings::Item& item1, const Settings::Item& item2) {
+        return item1.value.type() == item2.value.type() && item1.value.toQVariant() == item2.value.toQVariant();
+    });
 }
 
 void SettingListModel::changeVal(int idx, QVariant newVal)
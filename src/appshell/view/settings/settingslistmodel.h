@@ -19,13 +19,13 @@
 #ifndef MU_SETTINGLISTMODEL_H
 #define MU_SETTINGLISTMODEL_H
 
-#include <QAbstractListModel>
 #include <QMap>
 
 #include "settings.h"
+#include "uicomponents/view/incrementallistmodel.h"
 
 namespace mu {
-class SettingListModel : public QAbstractListModel
+class SettingListModel : public uicomponents::IncrementalListModel
 {
     Q_OBJECT
 public:
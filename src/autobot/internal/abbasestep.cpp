@@ -18,6 +18,8 @@
 //=============================================================================
 #include "abbasestep.h"
 
+#include "log.h"
+
 using namespace mu::autobot;
 
 void AbBaseStep::make(const AbContext& ctx)
@@ -30,6 +32,22 @@ void AbBaseStep::doFinish(const AbContext& ctx)
     m_finished.send(ctx);
 }
 
+void AbBaseStep::addTiming(AbContext& ctx, const std::string& name, double ms, double maxMs) const
+{
+    AbTiming t;
+    t.name = name;
+    t.ms = ms;
+    t.maxMs = maxMs;
+
+    if (t.passed()) {
+        LOGI() << name << ": " << ms << " ms";
+    } else {
+        LOGE() << name << ": " << ms << " ms, more than " << maxMs << " ms";
+    }
+
+    ctx.timings.push_back(std::move(t));
+}
+
 mu::async::Channel<AbContext> AbBaseStep::finished() const
 {
     return m_finished;
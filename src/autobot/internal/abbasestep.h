@@ -39,6 +39,8 @@ protected:
     virtual void doRun(AbContext ctx) = 0;
     void doFinish(const AbContext& ctx);
 
+    void addTiming(AbContext& ctx, const std::string& name, double ms, double maxMs) const;
+
 private:
     async::Channel<AbContext> m_finished;
 };
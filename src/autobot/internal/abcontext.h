@@ -21,10 +21,22 @@
 
 #include <any>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "ret.h"
 
 namespace mu::autobot {
+//! NOTE A time measured by a step, maxMs 0 is no threshold
+struct AbTiming
+{
+    std::string name;
+    double ms = 0.0;
+    double maxMs = 0.0;
+
+    bool passed() const { return maxMs <= 0.0 || ms <= maxMs; }
+};
+
 struct AbContext
 {
     enum class Key {
@@ -33,6 +45,7 @@ struct AbContext
     };
 
     Ret ret;
+    std::vector<AbTiming> timings;
 
     template<typename T>
     void setVal(const Key& key, const T& v)
@@ -57,6 +70,7 @@ struct AbContext
     {
         m_vals.clear();
         ret = Ret();
+        timings.clear();
     }
 
 private:
@@ -22,15 +22,22 @@
 
 #include "steps/abscoreloadstep.h"
 #include "steps/abscorezoom.h"
+#include "steps/abscoreeditstep.h"
+#include "steps/abscorescrollstep.h"
+#include "steps/abplaybackstartstep.h"
 #include "steps/abscoreclosestep.h"
 
 using namespace mu::autobot;
 
 void AbRunner::init()
 {
+    //! NOTE The thresholds are in ms, a timing over its threshold fails the score
     m_steps = {
-        Step(new AbScoreLoadStep()),
+        Step(new AbScoreLoadStep(5000)),
         Step(new AbScoreZoom(), 1000),
+        Step(new AbScoreEditStep(500), 1000),
+        Step(new AbScoreScrollStep(20, 100), 1000),
+        Step(new AbPlaybackStartStep(1000), 1000),
         Step(new AbScoreCloseStep(), 1000)
     };
 
@@ -18,7 +18,12 @@
 //=============================================================================
 #include "autobot.h"
 
+#include <algorithm>
+
 #include <QTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 #include "log.h"
 
@@ -29,7 +34,13 @@ using namespace mu::autobot;
 void Autobot::init()
 {
     m_runner.finished().onReceive(this, [this](const AbContext& ctx) {
-        if (ctx.ret) {
+        addToReport(ctx);
+
+        const bool timingsPassed = std::all_of(ctx.timings.cbegin(), ctx.timings.cend(), [](const AbTiming& t) {
+            return t.passed();
+        });
+
+        if (ctx.ret && timingsPassed) {
             LOGI() << "success finished, score: " << ctx.val<io::path>(AbContext::Key::ScoreFile);
         } else {
             LOGE() << "failed finished, score: " << ctx.val<io::path>(AbContext::Key::ScoreFile);
@@ -55,6 +66,7 @@ void Autobot::run()
     m_currentIndex = -1;
     m_scores = scores.val;
     m_running = true;
+    m_report = QJsonArray();
 
     nextScore();
 }
@@ -72,9 +84,42 @@ void Autobot::nextScore()
 
     m_currentIndex += 1;
     if (size_t(m_currentIndex) > (m_scores.size() - 1)) {
+        writeReport();
         return;
     }
 
     const io::path& score = m_scores.at(size_t(m_currentIndex));
     m_runner.run(score);
 }
+
+void Autobot::addToReport(const AbContext& ctx)
+{
+    QJsonArray timings;
+    for (const AbTiming& t : ctx.timings) {
+        QJsonObject obj;
+        obj["name"] = QString::fromStdString(t.name);
+        obj["ms"] = t.ms;
+        obj["maxMs"] = t.maxMs;
+        obj["passed"] = t.passed();
+        timings.append(obj);
+    }
+
+    QJsonObject score;
+    score["score"] = ctx.val<io::path>(AbContext::Key::ScoreFile).toQString();
+    score["code"] = ctx.ret ? 0 : ctx.ret.code();
+    score["timings"] = timings;
+    m_report.append(score);
+}
+
+void Autobot::writeReport()
+{
+    io::path file = globalConfiguration()->logsPath() + "/autobot.json";
+    QFile f(file.toQString());
+    if (!f.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed write report: " << file;
+        return;
+    }
+
+    f.write(QJsonDocument(m_report).toJson());
+    LOGI() << "report: " << file;
+}
@@ -19,15 +19,20 @@
 #ifndef MU_AUTOBOT_AUTOBOT_H
 #define MU_AUTOBOT_AUTOBOT_H
 
+#include <QJsonArray>
+
 #include "../iautobot.h"
 #include "io/path.h"
 #include "async/asyncable.h"
+#include "modularity/ioc.h"
+#include "iglobalconfiguration.h"
 
 #include "abrunner.h"
 
 namespace mu::autobot {
 class Autobot : public IAutobot, public async::Asyncable
 {
+    INJECT(autobot, framework::IGlobalConfiguration, globalConfiguration)
 public:
     Autobot() = default;
 
@@ -39,12 +44,15 @@ public:
 private:
 
     void nextScore();
+    void addToReport(const AbContext& ctx);
+    void writeReport();
 
     io::paths m_scores;
     int m_currentIndex = -1;
 
     bool m_running = false;
     AbRunner m_runner;
+    QJsonArray m_report;
 };
 }
 
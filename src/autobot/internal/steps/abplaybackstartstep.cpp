@@ -0,0 +1,82 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "abplaybackstartstep.h"
+
+#include "log.h"
+#include "../abinvoker.h"
+
+using namespace mu::autobot;
+
+static constexpr int START_TIMEOUT_MS = 5000;
+
+void AbPlaybackStartStep::doRun(AbContext ctx)
+{
+    m_ctx = ctx;
+    if (!playbackController()->isPlayAllowed() || playbackController()->isPlaying()) {
+        LOGW() << "playback can not be started";
+        m_ctx.ret = make_ret(Ret::Code::Ok);
+        doFinish(m_ctx);
+        return;
+    }
+
+    //! NOTE The position also changes by the rewind before the playback,
+    //! it is the first change after the sequencer has started that is heard.
+    //! Set once, the subscriptions stay for the next runs
+    playbackController()->isPlayingChanged().onNotify(this, [this]() {
+        if (m_waiting && playbackController()->isPlaying()) {
+            m_playing = true;
+        }
+    });
+    playbackController()->playbackPositionChanged().onNotify(this, [this]() {
+        if (m_waiting && m_playing) {
+            finish(true);
+        }
+    });
+
+    const int run = ++m_run;
+    AbInvoker::invoke(START_TIMEOUT_MS, [this, run]() {
+        if (m_waiting && m_run == run) {
+            finish(false);
+        }
+    });
+
+    m_waiting = true;
+    m_playing = false;
+    m_timer.start();
+    dispatcher()->dispatch("play");
+}
+
+void AbPlaybackStartStep::finish(bool started)
+{
+    m_waiting = false;
+
+    if (started) {
+        addTiming(m_ctx, "playbackStart", m_timer.nsecsElapsed() / 1e6, m_maxMs);
+        m_ctx.ret = make_ret(Ret::Code::Ok);
+    } else {
+        LOGE() << "playback has not started in " << START_TIMEOUT_MS << " ms";
+        m_ctx.ret = make_ret(Ret::Code::UnknownError);
+    }
+
+    if (playbackController()->isPlaying()) {
+        dispatcher()->dispatch("play");
+    }
+
+    doFinish(m_ctx);
+}
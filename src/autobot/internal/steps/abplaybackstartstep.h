@@ -0,0 +1,57 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUTOBOT_ABPLAYBACKSTARTSTEP_H
+#define MU_AUTOBOT_ABPLAYBACKSTARTSTEP_H
+
+#include <QElapsedTimer>
+
+#include "../abbasestep.h"
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "actions/iactionsdispatcher.h"
+#include "playback/iplaybackcontroller.h"
+
+namespace mu::autobot {
+//! NOTE Starts the playback and times it until the playback position first moves while playing, then stops it
+class AbPlaybackStartStep : public AbBaseStep, public async::Asyncable
+{
+    INJECT(autobot, actions::IActionsDispatcher, dispatcher)
+    INJECT(autobot, playback::IPlaybackController, playbackController)
+public:
+    explicit AbPlaybackStartStep(double maxMs = 0.0)
+        : m_maxMs(maxMs) {}
+
+protected:
+    void doRun(AbContext ctx) override;
+
+private:
+    void finish(bool started);
+
+    double m_maxMs = 0.0;
+
+    AbContext m_ctx;
+    QElapsedTimer m_timer;
+    int m_run = 0;
+    bool m_waiting = false;
+    bool m_playing = false;
+};
+}
+
+#endif // MU_AUTOBOT_ABPLAYBACKSTARTSTEP_H
@@ -0,0 +1,53 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "abscoreeditstep.h"
+
+#include <QElapsedTimer>
+
+#include "libmscore/score.h"
+#include "../abinvoker.h"
+
+using namespace mu::autobot;
+
+void AbScoreEditStep::doRun(AbContext ctx)
+{
+    notation::INotationPtr notation = context()->currentNotation();
+    const Ms::Score* score = notation ? notation->elements()->msScore() : nullptr;
+    if (!score) {
+        ctx.ret = make_ret(Ret::Code::UnknownError);
+        doFinish(ctx);
+        return;
+    }
+
+    //! NOTE The layout runs at the end of the command, so it is done when dispatch returns
+    QElapsedTimer timer;
+    timer.start();
+    dispatcher()->dispatch("append-measure");
+
+    addTiming(ctx, "edit", timer.nsecsElapsed() / 1e6, 0.0);
+    addTiming(ctx, "editLayout", score->layoutStatistics().timeMs, m_maxLayoutMs);
+
+    AbInvoker::invoke(500, [this, ctx]() {
+        dispatcher()->dispatch("undo");
+
+        AbContext newCtx = ctx;
+        newCtx.ret = make_ret(Ret::Code::Ok);
+        doFinish(newCtx);
+    });
+}
@@ -18,10 +18,19 @@
 //=============================================================================
 #include "abscoreloadstep.h"
 
+#include <QElapsedTimer>
+
 using namespace mu::autobot;
 
 void AbScoreLoadStep::doRun(AbContext ctx)
 {
+    QElapsedTimer timer;
+    timer.start();
+
     ctx.ret = fileScoreController()->openScore(ctx.val<io::path>(AbContext::Key::ScoreFile));
+    if (ctx.ret) {
+        addTiming(ctx, "open", timer.nsecsElapsed() / 1e6, m_maxMs);
+    }
+
     doFinish(ctx);
 }
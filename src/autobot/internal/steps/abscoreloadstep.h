@@ -29,10 +29,14 @@ class AbScoreLoadStep : public AbBaseStep
 {
     INJECT(autobot, mu::userscores::IFileScoreController, fileScoreController)
 public:
-    AbScoreLoadStep() = default;
+    explicit AbScoreLoadStep(double maxMs = 0.0)
+        : m_maxMs(maxMs) {}
 
 protected:
     void doRun(AbContext ctx) override;
+
+private:
+    double m_maxMs = 0.0;
 };
 }
 
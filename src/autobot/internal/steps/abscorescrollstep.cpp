@@ -0,0 +1,112 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "abscorescrollstep.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QGuiApplication>
+#include <QWheelEvent>
+
+#include "log.h"
+#include "../abinvoker.h"
+
+using namespace mu::autobot;
+
+static constexpr int STEP_INTERVAL_MS = 50;
+static constexpr int FRAME_TIMEOUT_MS = 500;
+
+void AbScoreScrollStep::doRun(AbContext ctx)
+{
+    m_ctx = ctx;
+    m_window = qobject_cast<QQuickWindow*>(QGuiApplication::focusWindow());
+    if (!m_window) {
+        LOGE() << "no window to scroll";
+        m_ctx.ret = make_ret(Ret::Code::UnknownError);
+        doFinish(m_ctx);
+        return;
+    }
+
+    //! NOTE With the threaded render loop the frame is swapped on the render thread,
+    //! the connection to the window queues it to the main thread
+    m_frameConnection = QObject::connect(m_window, &QQuickWindow::frameSwapped, m_window, [this]() {
+        onFrameSwapped();
+    });
+
+    m_frameTimes.clear();
+    m_scrolled = 0;
+    scroll(0);
+}
+
+void AbScoreScrollStep::scroll(int step)
+{
+    if (step >= m_steps || !m_window) {
+        finish();
+        return;
+    }
+
+    const QPointF pos(m_window->width() / 2.0, m_window->height() / 2.0);
+    const int delta = step < m_steps / 2 ? -QWheelEvent::DefaultDeltasPerStep : QWheelEvent::DefaultDeltasPerStep;
+    QWheelEvent event(pos, m_window->mapToGlobal(pos.toPoint()), QPoint(), QPoint(0, delta),
+                      Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+
+    m_step = step;
+    m_frameTimer.start();
+    QCoreApplication::sendEvent(m_window, &event);
+    ++m_scrolled;
+
+    //! NOTE If the score has not moved, at its end, there is no frame
+    AbInvoker::invoke(FRAME_TIMEOUT_MS, [this, step]() {
+        if (m_step == step) {
+            m_step = -1;
+            scroll(step + 1);
+        }
+    });
+}
+
+void AbScoreScrollStep::onFrameSwapped()
+{
+    if (m_step < 0) {
+        return;
+    }
+
+    m_frameTimes.push_back(m_frameTimer.nsecsElapsed() / 1e6);
+
+    const int next = m_step + 1;
+    m_step = -1;
+    AbInvoker::invoke(STEP_INTERVAL_MS, [this, next]() {
+        scroll(next);
+    });
+}
+
+void AbScoreScrollStep::finish()
+{
+    QObject::disconnect(m_frameConnection);
+
+    if (m_frameTimes.empty()) {
+        LOGW() << "no frames while scrolling, steps: " << m_scrolled;
+    } else {
+        const double sum = std::accumulate(m_frameTimes.cbegin(), m_frameTimes.cend(), 0.0);
+        addTiming(m_ctx, "scrollFrameAvg", sum / m_frameTimes.size(), 0.0);
+        addTiming(m_ctx, "scrollFrameMax", *std::max_element(m_frameTimes.cbegin(), m_frameTimes.cend()), m_maxFrameMs);
+    }
+
+    m_ctx.ret = make_ret(Ret::Code::Ok);
+    doFinish(m_ctx);
+}
@@ -0,0 +1,61 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUTOBOT_ABSCORESCROLLSTEP_H
+#define MU_AUTOBOT_ABSCORESCROLLSTEP_H
+
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QPointer>
+#include <QQuickWindow>
+
+#include "../abbasestep.h"
+
+namespace mu::autobot {
+//! NOTE Scrolls the score down and up again with the mouse wheel in the middle of the window,
+//! a frame time is from the wheel event until the window has shown the next frame
+class AbScoreScrollStep : public AbBaseStep
+{
+public:
+    explicit AbScoreScrollStep(int steps = 20, double maxFrameMs = 0.0)
+        : m_steps(steps), m_maxFrameMs(maxFrameMs) {}
+
+protected:
+    void doRun(AbContext ctx) override;
+
+private:
+    void scroll(int step);
+    void onFrameSwapped();
+    void finish();
+
+    int m_steps = 0;
+    double m_maxFrameMs = 0.0;
+
+    AbContext m_ctx;
+    QPointer<QQuickWindow> m_window;
+    QMetaObject::Connection m_frameConnection;
+    QElapsedTimer m_frameTimer;
+    int m_step = -1;            // the step waiting for its frame
+    int m_scrolled = 0;
+    std::vector<double> m_frameTimes;
+};
+}
+
+#endif // MU_AUTOBOT_ABSCORESCROLLSTEP_H
@@ -57,6 +57,11 @@ void CloudModule::registerUiTypes()
     framework::ioc()->resolve<ui::IUiEngine>(moduleName())->addSourceImportPath(cloud_QML_IMPORT);
 }
 
+bool CloudModule::isInitDeferred() const
+{
+    return true;
+}
+
 void CloudModule::onInit(const framework::IApplication::RunMode& mode)
 {
     if (framework::IApplication::RunMode::Editor != mode) {
@@ -29,6 +29,7 @@ public:
     void registerExports() override;
     void registerResources() override;
     void registerUiTypes() override;
+    bool isInitDeferred() const override;
     void onInit(const framework::IApplication::RunMode& mode) override;
 };
 }
@@ -15,6 +15,7 @@
 #include <QJsonObject>
 #include <QDir>
 #include <QMessageBox>
+#include <QTimer>
 
 #include "cloudmanager.h"
 #include "cloudmanager_p.h"
@@ -796,9 +797,14 @@ void CloudManager::uploadMedia()
         emit mediaUploadSuccess();
         return;
     }
-    if (m_mp3File->open(QIODevice::ReadOnly)) {   // probably cancelled, no error handling
+    // a retry sends the file again from its start
+    bool ok = m_mp3File->isOpen() ? m_mp3File->seek(0) : m_mp3File->open(QIODevice::ReadOnly);
+    if (ok) {   // probably cancelled, no error handling
         QNetworkRequest request;
         request.setUrl(QUrl(m_mediaUrl));
+        // the file is streamed from the disk, a stalled connection is given up and retried
+        request.setHeader(QNetworkRequest::ContentLengthHeader, m_mp3File->size());
+        request.setTransferTimeout(UPLOAD_STALL_TIMEOUT_MS);
         m_progressDialog->reset();
         m_progressDialog->setLabelText(tr("Uploading…"));
         m_progressDialog->setCancelButtonText(tr("Cancel"));
@@ -825,15 +831,21 @@ void CloudManager::mediaUploadFinished()
     reply->deleteLater();
     m_progressDialog->hide();
     m_progressDialog->reset();
-    if ((statusCode == 200 && reply->error() == QNetworkReply::NoError) || m_progressDialog->wasCanceled()) {
+    if ((statusCode == 200 && e == QNetworkReply::NoError) || m_progressDialog->wasCanceled()) {
         m_mp3File->remove();
         delete m_mp3File;
+        m_mp3File = nullptr;
         m_mediaUrl = "";
         emit mediaUploadSuccess();
-    } else if (e == QNetworkReply::RemoteHostClosedError && m_uploadTryCount < MAX_UPLOAD_TRY_COUNT) {
-        uploadMedia();
+    } else if (isTransientUploadError(e) && m_uploadTryCount < MAX_UPLOAD_TRY_COUNT) {
+        // give a flaky network time to come back, waiting longer after each failure
+        QTimer::singleShot(UPLOAD_RETRY_DELAY_MS * m_uploadTryCount, this, &CloudManager::uploadMedia);
     } else {
         qDebug() << "error uploading media" << e;
+        m_mp3File->remove();
+        delete m_mp3File;
+        m_mp3File = nullptr;
+        m_mediaUrl = "";
         QMessageBox::warning(0,
                              tr("Upload Error"),
                              tr("Sorry, MuseScore couldn't upload the audio file. Error %1").arg(e),
@@ -841,6 +853,32 @@ void CloudManager::mediaUploadFinished()
     }
 }
 
+//---------------------------------------------------------
+//   isTransientUploadError
+//    the upload may succeed when tried again; a stalled
+//    transfer is aborted as canceled by its timeout
+//---------------------------------------------------------
+
+bool CloudManager::isTransientUploadError(QNetworkReply::NetworkError e)
+{
+    switch (e) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::OperationCanceledError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionClosedError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownNetworkError:
+    case QNetworkReply::InternalServerError:
+    case QNetworkReply::ServiceUnavailableError:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
 //---------------------------------------------------------
 //   mediaUploadProgress
 //---------------------------------------------------------
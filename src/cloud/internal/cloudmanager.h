@@ -15,6 +15,7 @@
 
 #include <QAction>
 #include <QNetworkAccessManager>
+#include <QNetworkReply>
 #include <QFile>
 #include <QProgressDialog>
 
@@ -51,6 +52,8 @@ class CloudManager : public QObject
     };
 
     static constexpr int MAX_UPLOAD_TRY_COUNT = 5;
+    static constexpr int UPLOAD_RETRY_DELAY_MS = 2000;
+    static constexpr int UPLOAD_STALL_TIMEOUT_MS = 60000;
     static constexpr int MAX_REFRESH_LOGIN_RETRY_COUNT = 2;
 
     QNetworkAccessManager* m_networkManager = nullptr;
@@ -71,6 +74,8 @@ class CloudManager : public QObject
     QProgressDialog* m_progressDialog = nullptr;
     AsyncWait* m_asyncWait = nullptr;
 
+    static bool isTransientUploadError(QNetworkReply::NetworkError);
+
     void onReplyFinished(ApiRequest*, RequestType);
     void handleReply(QNetworkReply*, RequestType);
     static QString getErrorString(QNetworkReply*, const QJsonObject&);
@@ -29,13 +29,18 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    WorkerFailed = 1303,
 
     ConvertTypeUnknown = 1310,
+    ExportRangeInvalid = 1311,
 
     InFileFailedLoad = 1320,
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    ServerFailedListen = 1340,
+    ServerRequestFailedParse = 1341,
 };
 
 inline Ret make_ret(Err e)
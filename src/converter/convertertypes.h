@@ -0,0 +1,38 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_CONVERTERTYPES_H
+#define MU_CONVERTER_CONVERTERTYPES_H
+
+namespace mu::converter {
+//! NOTE A part of one export, so that a long score can be exported by several processes or machines
+//! and the parts put together afterwards. The pages (PDF, PNG and SVG) or the measures (audio) are
+//! numbered from 1, the last one is included, 0 is not set
+struct ExportRange {
+    int firstPage = 0;
+    int lastPage = 0;
+    int firstMeasure = 0;
+    int lastMeasure = 0;
+
+    bool isPages() const { return firstPage > 0; }
+    bool isMeasures() const { return firstMeasure > 0; }
+    bool isEmpty() const { return !isPages() && !isMeasures(); }
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERTYPES_H
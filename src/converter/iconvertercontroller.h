@@ -22,6 +22,7 @@
 #include "modularity/imoduleexport.h"
 #include "ret.h"
 #include "io/path.h"
+#include "convertertypes.h"
 
 namespace mu::converter {
 class IConverterController : MODULE_EXPORT_INTERFACE
@@ -30,8 +31,22 @@ class IConverterController : MODULE_EXPORT_INTERFACE
 public:
     virtual ~IConverterController() = default;
 
-    virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
-    virtual Ret batchConvert(const io::path& batchJobFile) = 0;
+    //! If range is given, writes only that part of the export, and the information to put the parts together
+    //! to out + ".shard.json"
+    virtual Ret fileConvert(const io::path& in, const io::path& out, const ExportRange& range = ExportRange()) = 0;
+    //! Writes the audio of the whole score to out and of each part alone to name-1.ext, name-2.ext, ...
+    //! beside it, all from one load and one render of the score
+    virtual Ret stemsConvert(const io::path& in, const io::path& out) = 0;
+    //! Runs all jobs of the batch in jobs worker processes (in this process if jobs is 1),
+    //! and writes the result of each job and a summary to resultFile, if it is given
+    //! The out of a job may be an array of files, the score is then loaded once for all of them
+    virtual Ret batchConvert(const io::path& batchJobFile, const io::path& resultFile, int jobs) = 0;
+
+    //! Takes conversion jobs over the local socket serverName until a client asks to quit
+    virtual Ret runServer(const std::string& serverName) = 0;
+
+    //! Loads the score and writes what it holds in memory, by element type, as JSON to out
+    virtual Ret memoryReport(const io::path& in, const io::path& out) = 0;
 };
 }
 
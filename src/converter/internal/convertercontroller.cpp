@@ -18,19 +18,99 @@
 //=============================================================================
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <QCryptographicHash>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QTemporaryDir>
 
 #include "log.h"
 #include "convertercodes.h"
+#include "converterserver.h"
 #include "stringutils.h"
 
+#include "libmscore/measure.h"
+#include "libmscore/memoryreport.h"
+#include "libmscore/page.h"
+#include "libmscore/repeatlist.h"
+#include "libmscore/score.h"
+#include "libmscore/system.h"
+
 using namespace mu::converter;
 
-mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
+static const QStringList WORKER_OPTIONS_WITH_VALUE = { "-j", "--job", "--jobs", "--job-result", "--converter-server" };
+
+static const std::set<std::string> AUDIO_SUFFIXES = { "wav", "mp3", "ogg", "flac" };
+static const std::set<std::string> PAGES_SUFFIXES = { "pdf", "png", "svg" };
+
+static QJsonValue outToJson(const std::vector<mu::io::path>& out)
+{
+    if (out.size() == 1) {
+        return out.front().toQString();
+    }
+    QJsonArray arr;
+    for (const mu::io::path& path : out) {
+        arr.append(path.toQString());
+    }
+    return arr;
+}
+
+//! NOTE The out of a job is a file or an array of files
+static std::vector<mu::io::path> outFromJson(const QJsonValue& val)
+{
+    std::vector<mu::io::path> out;
+    const QJsonArray arr = val.isArray() ? val.toArray() : QJsonArray { val };
+    for (const QJsonValue v : arr) {
+        const QString path = v.toString();
+        if (!path.isEmpty()) {
+            out.push_back(path);
+        }
+    }
+    return out;
+}
+
+static std::string outString(const std::vector<mu::io::path>& out)
+{
+    std::string str;
+    for (const mu::io::path& path : out) {
+        str += (str.empty() ? "" : ", ") + path.toStdString();
+    }
+    return str;
+}
+
+//! NOTE The arguments of this process for a worker, without the options that start the batch itself
+static QStringList workerArguments()
+{
+    QStringList args;
+    const QStringList all = QCoreApplication::arguments().mid(1);
+    for (int i = 0; i < all.size(); ++i) {
+        const QString& arg = all.at(i);
+        if (WORKER_OPTIONS_WITH_VALUE.contains(arg)) {
+            ++i;
+            continue;
+        }
+        if (std::any_of(WORKER_OPTIONS_WITH_VALUE.cbegin(), WORKER_OPTIONS_WITH_VALUE.cend(), [&arg](const QString& o) {
+            return arg.startsWith(o + "=");
+        })) {
+            continue;
+        }
+        args << arg;
+    }
+    return args;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const io::path& resultFile, int jobs)
 {
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
     if (!batchJob.ret) {
@@ -38,45 +118,397 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out);
+    QElapsedTimer timer;
+    timer.start();
+
+    BatchResult result;
+    if (jobs > 1 && batchJob.val.size() > 1) {
+        RetVal<BatchResult> rv = convertJobsInWorkers(batchJob.val, jobs);
+        if (!rv.ret) {
+            LOGE() << "failed run workers, err: " << rv.ret.toString();
+            return rv.ret;
+        }
+        result = rv.val;
+    } else {
+        result = convertJobs(batchJob.val);
+    }
+
+    if (!resultFile.empty()) {
+        Ret ret = writeBatchResult(result, timer.elapsed(), resultFile);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+            LOGE() << "failed write batch result, err: " << ret.toString() << ", path: " << resultFile;
         }
     }
 
-    return ret;
+    for (const JobResult& r : result) {
+        if (!r.ret) {
+            return r.ret;
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
 }
 
-mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out)
+ConverterController::BatchResult ConverterController::convertJobs(const BatchJob& batchJob)
+{
+    BatchResult result;
+    for (const Job& job : batchJob) {
+        QElapsedTimer timer;
+        timer.start();
+
+        JobResult r;
+        r.job = job;
+        r.ret = doFileConvert(job.in, job.out, ExportRange(), &r.times);
+        r.elapsedMs = timer.elapsed();
+        if (!r.ret) {
+            LOGE() << "failed convert, err: " << r.ret.toString() << ", in: " << job.in << ", out: " << outString(job.out);
+        }
+
+        result.push_back(std::move(r));
+    }
+
+    return result;
+}
+
+mu::RetVal<ConverterController::BatchResult> ConverterController::convertJobsInWorkers(const BatchJob& batchJob, int jobs)
+{
+    //! NOTE libmscore can not load and lay out scores on several threads at once,
+    //! so the jobs are shared out between worker processes, each one runs its part as a batch
+
+    RetVal<BatchResult> rv;
+
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen, dir.errorString().toStdString());
+        return rv;
+    }
+
+    std::vector<BatchJob> parts(std::min(size_t(jobs), batchJob.size()));
+    size_t n = 0;
+    for (const Job& job : batchJob) {
+        parts[n++ % parts.size()].push_back(job);
+    }
+
+    const QStringList args = workerArguments();
+    std::vector<std::unique_ptr<QProcess> > workers;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        const QString jobFile = dir.filePath(QString("job%1.json").arg(i));
+        const QString resultFile = dir.filePath(QString("result%1.json").arg(i));
+
+        Ret ret = writeBatchJob(parts[i], jobFile);
+        if (!ret) {
+            rv.ret = ret;
+            return rv;
+        }
+
+        auto worker = std::make_unique<QProcess>();
+        worker->setProcessChannelMode(QProcess::ForwardedChannels);
+        worker->start(QCoreApplication::applicationFilePath(), QStringList(args) << "-j" << jobFile << "--job-result" << resultFile);
+        workers.push_back(std::move(worker));
+    }
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->waitForFinished(-1);
+
+        RetVal<BatchResult> part = readBatchResult(dir.filePath(QString("result%1.json").arg(i)));
+        if (!part.ret) {
+            //! NOTE The worker has crashed before it could write its result
+            LOGE() << "worker " << i << " failed, exit code: " << workers[i]->exitCode();
+            for (const Job& job : parts[i]) {
+                rv.val.push_back({ job, make_ret(Err::WorkerFailed), 0, ConvertTimes() });
+            }
+            continue;
+        }
+
+        rv.val.splice(rv.val.end(), part.val);
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::writeBatchJob(const BatchJob& batchJob, const io::path& file) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+        obj["out"] = outToJson(job.out);
+        arr.append(obj);
+    }
+
+    QFile f(file.toQString());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+    f.write(QJsonDocument(arr).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::writeBatchResult(const BatchResult& result, qint64 elapsedMs, const io::path& file) const
+{
+    QJsonArray arr;
+    int failed = 0;
+    qint64 jobsMs = 0;
+    for (const JobResult& r : result) {
+        QJsonObject obj;
+        obj["in"] = r.job.in.toQString();
+        obj["out"] = outToJson(r.job.out);
+        obj["code"] = r.ret ? 0 : r.ret.code();
+        obj["text"] = QString::fromStdString(r.ret.text());
+        obj["timeMs"] = r.elapsedMs;
+        obj["loadMs"] = r.times.loadMs;
+        obj["layoutMs"] = r.times.layoutMs;
+        obj["writeMs"] = r.times.writeMs;
+        arr.append(obj);
+
+        jobsMs += r.elapsedMs;
+        if (!r.ret) {
+            ++failed;
+        }
+    }
+
+    QJsonObject summary;
+    summary["jobs"] = int(result.size());
+    summary["failed"] = failed;
+    summary["jobsTimeMs"] = jobsMs;
+    summary["wallTimeMs"] = elapsedMs;
+
+    QJsonObject root;
+    root["jobs"] = arr;
+    root["summary"] = summary;
+
+    QFile f(file.toQString());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+    f.write(QJsonDocument(root).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<ConverterController::BatchResult> ConverterController::readBatchResult(const io::path& file) const
+{
+    RetVal<BatchResult> rv;
+    QFile f(file.toQString());
+    if (!f.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    const QJsonArray arr = doc.object()["jobs"].toArray();
+    for (const QJsonValue v : arr) {
+        QJsonObject obj = v.toObject();
+
+        JobResult r;
+        r.job.in = obj["in"].toString();
+        r.job.out = outFromJson(obj["out"]);
+        int code = obj["code"].toInt();
+        r.ret = code == 0 ? make_ret(Ret::Code::Ok) : Ret(code, obj["text"].toString().toStdString());
+        r.elapsedMs = qint64(obj["timeMs"].toDouble());
+        r.times.loadMs = qint64(obj["loadMs"].toDouble());
+        r.times.layoutMs = obj["layoutMs"].toDouble();
+        r.times.writeMs = qint64(obj["writeMs"].toDouble());
+        rv.val.push_back(std::move(r));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
+
+mu::Ret ConverterController::runServer(const std::string& serverName)
+{
+    ConverterServer server([this](const io::path& in, const io::path& out, QJsonObject& info) {
+        ConvertTimes times;
+        Ret ret = doFileConvert(in, { out }, ExportRange(), &times);
+        info["loadMs"] = times.loadMs;
+        info["layoutMs"] = times.layoutMs;
+        info["writeMs"] = times.writeMs;
+        return ret;
+    });
+
+    return server.run(QString::fromStdString(serverName));
+}
+
+mu::Ret ConverterController::memoryReport(const io::path& in, const io::path& out)
 {
-    TRACEFUNC;
-    LOGI() << "in: " << in << ", out: " << out;
     auto masterNotation = notationCreator()->newMasterNotation();
     IF_ASSERT_FAILED(masterNotation) {
         return make_ret(Err::UnknownError);
     }
 
+    Ret ret = masterNotation->load(in);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    Ms::Score* score = masterNotation->notation()->elements()->msScore();
+    if (!score) {
+        return make_ret(Err::UnknownError);
+    }
+
+    QJsonObject obj = Ms::MemoryReport::collect(score->masterScore()).toJson();
+    obj["file"] = in.toQString();
+
+    QFile f(out.toQString());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+    f.write(QJsonDocument(obj).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out, const ExportRange& range)
+{
+    return doFileConvert(in, { out }, range, nullptr);
+}
+
+mu::Ret ConverterController::stemsConvert(const io::path& in, const io::path& out)
+{
+    TRACEFUNC;
+    LOGI() << "in: " << in << ", out: " << out;
     std::string suffix = io::syffix(out);
-    auto writer = writers()->writer(suffix);
+    auto writer = AUDIO_SUFFIXES.count(suffix) ? writers()->writer(suffix) : nullptr;
     if (!writer) {
         return make_ret(Err::ConvertTypeUnknown);
     }
 
+    auto masterNotation = notationCreator()->newMasterNotation();
+    IF_ASSERT_FAILED(masterNotation) {
+        return make_ret(Err::UnknownError);
+    }
+
     Ret ret = masterNotation->load(in);
     if (!ret) {
         LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
         return make_ret(Err::InFileFailedLoad);
     }
 
+    notation::INotationPtr notation = masterNotation->notation();
+    const Ms::Score* score = notation->elements()->msScore();
+    if (!score) {
+        return make_ret(Err::UnknownError);
+    }
+
+    //! NOTE The parts are numbered as the pages of a PNG export are: name-1.wav, name-2.wav, ...
+    QFileInfo outInfo(out.toQString());
+    std::vector<std::unique_ptr<QFile> > files;
+    files.push_back(std::make_unique<QFile>(out.toQString()));
+    for (int i = 0; i < score->parts().size(); ++i) {
+        QString stemPath = QString("%1/%2-%3.%4").arg(outInfo.path(), outInfo.completeBaseName()).arg(i + 1).arg(outInfo.suffix());
+        files.push_back(std::make_unique<QFile>(stemPath));
+    }
+
+    std::vector<system::IODevice*> devices;
+    for (const std::unique_ptr<QFile>& file : files) {
+        if (!file->open(QFile::WriteOnly)) {
+            return make_ret(Err::OutFileFailedOpen);
+        }
+        devices.push_back(file.get());
+    }
+
+    ret = writer->writeStems(notation, devices);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::doFileConvert(const io::path& in, const std::vector<io::path>& out, const ExportRange& range,
+                                           ConvertTimes* times)
+{
+    TRACEFUNC;
+    LOGI() << "in: " << in << ", out: " << outString(out);
+    auto masterNotation = notationCreator()->newMasterNotation();
+    IF_ASSERT_FAILED(masterNotation) {
+        return make_ret(Err::UnknownError);
+    }
+
+    std::vector<notation::INotationWriterPtr> outWriters;
+    for (const io::path& path : out) {
+        auto writer = writers()->writer(io::syffix(path));
+        if (!writer) {
+            return make_ret(Err::ConvertTypeUnknown);
+        }
+        outWriters.push_back(writer);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Ret ret = masterNotation->load(in);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    notation::INotationPtr notation = masterNotation->notation();
+    if (times) {
+        times->loadMs = timer.restart();
+        const Ms::Score* score = notation->elements()->msScore();
+        times->layoutMs = score ? score->layoutTotals().timeMs : 0.0;
+    }
+
+    //! NOTE The writers run one after another: they lay out, render and paint the same score,
+    //! which libmscore can not do on several threads at once. An output that fails does not stop the others
+    ret = make_ret(Ret::Code::Ok);
+    for (size_t i = 0; i < out.size(); ++i) {
+        Ret outRet = writeOutput(outWriters[i], notation, out[i], range);
+        if (!outRet && ret) {
+            ret = outRet;
+        }
+    }
+
+    if (times) {
+        times->writeMs = timer.elapsed();
+    }
+
+    return ret;
+}
+
+mu::Ret ConverterController::writeOutput(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out,
+                                         const ExportRange& range)
+{
+    std::string suffix = io::syffix(out);
+    notation::INotationWriter::Options options;
+    Ret ret;
+    if (!range.isEmpty()) {
+        RetVal<notation::INotationWriter::Options> rv = rangeOptions(notation, range, suffix);
+        if (!rv.ret) {
+            LOGE() << "invalid export range for: " << out;
+            return make_ret(Err::ExportRangeInvalid);
+        }
+        options = rv.val;
+
+        ret = writeShardInfo(notation, range, out.toQString() + ".shard.json");
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    const size_t pageCount = notation->elements()->pages().size();
+    if (suffix == "png" && pageCount > 1 && !range.isPages()) {
+        return pagesConvert(writer, notation, out, 0, pageCount, options);
+    }
+    if ((suffix == "png" || suffix == "svg") && range.isPages()) {
+        return pagesConvert(writer, notation, out, range.firstPage - 1, range.lastPage - range.firstPage + 1, options);
+    }
+
     QFile file(out.toQString());
     if (!file.open(QFile::WriteOnly)) {
         return make_ret(Err::OutFileFailedOpen);
     }
 
-    ret = writer->write(masterNotation->notation(), file);
+    ret = writer->write(notation, file, options);
     if (!ret) {
         LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
         return make_ret(Err::OutFileFailedWrite);
@@ -87,6 +519,114 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
     return make_ret(Ret::Code::Ok);
 }
 
+mu::Ret ConverterController::pagesConvert(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out,
+                                          size_t firstPage, size_t pageCount, const notation::INotationWriter::Options& options)
+{
+    //! NOTE As MuseScore 3 did, each page goes to its own file: name-1.png, name-2.png, ...
+    QFileInfo outInfo(out.toQString());
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<system::IODevice*> devices;
+    for (size_t i = firstPage; i < firstPage + pageCount; ++i) {
+        QString pagePath = QString("%1/%2-%3.%4").arg(outInfo.path(), outInfo.completeBaseName()).arg(i + 1).arg(outInfo.suffix());
+        files.push_back(std::make_unique<QFile>(pagePath));
+        if (!files.back()->open(QFile::WriteOnly)) {
+            return make_ret(Err::OutFileFailedOpen);
+        }
+        devices.push_back(files.back().get());
+    }
+
+    notation::INotationWriter::Options pagesOptions = options;
+    pagesOptions[notation::INotationWriter::OptionKey::FIRST_PAGE_NUMBER] = Val(int(firstPage));
+
+    Ret ret = writer->writePages(notation, devices, pagesOptions);
+    if (!ret) {
+        LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<notation::INotationWriter::Options> ConverterController::rangeOptions(notation::INotationPtr notation, const ExportRange& range,
+                                                                                  const std::string& suffix) const
+{
+    RetVal<notation::INotationWriter::Options> rv;
+    const Ms::Score* score = notation->elements()->msScore();
+    if (!score) {
+        rv.ret = make_ret(Err::UnknownError);
+        return rv;
+    }
+
+    if (range.isPages() == range.isMeasures()) {
+        rv.ret = make_ret(Err::ExportRangeInvalid);
+        return rv;
+    }
+
+    //! NOTE The writers number the pages and the measures from 0
+    const bool isPages = range.isPages() && PAGES_SUFFIXES.count(suffix);
+    const bool isMeasures = range.isMeasures() && AUDIO_SUFFIXES.count(suffix);
+    if (isPages && range.firstPage <= range.lastPage && range.lastPage <= score->npages()) {
+        rv.val[notation::INotationWriter::OptionKey::FIRST_PAGE_NUMBER] = Val(range.firstPage - 1);
+        rv.val[notation::INotationWriter::OptionKey::LAST_PAGE_NUMBER] = Val(range.lastPage - 1);
+        rv.ret = make_ret(Ret::Code::Ok);
+    } else if (isMeasures && range.firstMeasure <= range.lastMeasure && range.lastMeasure <= score->nmeasures()) {
+        rv.val[notation::INotationWriter::OptionKey::FIRST_MEASURE_INDEX] = Val(range.firstMeasure - 1);
+        rv.val[notation::INotationWriter::OptionKey::LAST_MEASURE_INDEX] = Val(range.lastMeasure - 1);
+        rv.ret = make_ret(Ret::Code::Ok);
+    } else {
+        rv.ret = make_ret(Err::ExportRangeInvalid);
+    }
+
+    return rv;
+}
+
+mu::Ret ConverterController::writeShardInfo(notation::INotationPtr notation, const ExportRange& range, const io::path& file) const
+{
+    const Ms::Score* score = notation->elements()->msScore();
+
+    //! NOTE The parts can only be put together if they were exported from the same layout.
+    //! Its hash is the same for all the parts of an export, wherever they are exported
+    QCryptographicHash layoutHash(QCryptographicHash::Sha1);
+    for (const Ms::Page* page : score->pages()) {
+        for (const Ms::System* system : page->systems()) {
+            const Ms::Measure* first = system->firstMeasure();
+            const Ms::Measure* last = system->lastMeasure();
+            if (first && last) {
+                layoutHash.addData(QString("%1:%2-%3;").arg(page->no()).arg(first->tick().ticks()).arg(last->endTick().ticks()).toUtf8());
+            }
+        }
+    }
+
+    QJsonObject obj;
+    obj["layoutHash"] = QString::fromLatin1(layoutHash.result().toHex());
+    if (range.isPages()) {
+        obj["firstPage"] = range.firstPage;
+        obj["lastPage"] = range.lastPage;
+        obj["pageCount"] = score->npages();
+    } else {
+        //! NOTE The audio parts follow each other without overlap, only the last one has the tail after the score
+        const Ms::Measure* first = score->crMeasure(range.firstMeasure - 1);
+        const Ms::Measure* next = score->crMeasure(range.lastMeasure);
+        const Ms::RepeatList& repeats = score->repeatList();
+        const int fromTick = repeats.tick2utick(first->tick().ticks());
+        const int toTick = next ? repeats.tick2utick(next->tick().ticks()) : notation->playback()->exportLastTick();
+
+        obj["firstMeasure"] = range.firstMeasure;
+        obj["lastMeasure"] = range.lastMeasure;
+        obj["measureCount"] = score->nmeasures();
+        obj["startTime"] = score->utick2utime(fromTick);
+        obj["endTime"] = score->utick2utime(toTick);
+        obj["hasTail"] = next == nullptr;
+    }
+
+    QFile f(file.toQString());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+    f.write(QJsonDocument(obj).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile) const
 {
     RetVal<BatchJob> rv;
@@ -111,7 +651,7 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
 
         Job job;
         job.in = obj["in"].toString();
-        job.out = obj["out"].toString();
+        job.out = outFromJson(obj["out"]);
 
         if (!job.in.empty() && !job.out.empty()) {
             rv.val.push_back(std::move(job));
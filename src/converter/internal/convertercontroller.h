@@ -20,6 +20,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -38,19 +39,56 @@ class ConverterController : public IConverterController
 public:
     ConverterController() = default;
 
-    Ret fileConvert(const io::path& in, const io::path& out) override;
-    Ret batchConvert(const io::path& batchJobFile) override;
+    Ret fileConvert(const io::path& in, const io::path& out, const ExportRange& range = ExportRange()) override;
+    Ret stemsConvert(const io::path& in, const io::path& out) override;
+    Ret batchConvert(const io::path& batchJobFile, const io::path& resultFile, int jobs) override;
+    Ret runServer(const std::string& serverName) override;
+    Ret memoryReport(const io::path& in, const io::path& out) override;
 
 private:
 
+    //! NOTE A job may have several outputs, as the PDF, the PNG pages and the MP3 of a score,
+    //! the score is loaded and laid out once for all of them
     struct Job {
         io::path in;
-        io::path out;
+        std::vector<io::path> out;
     };
 
     using BatchJob = std::list<Job>;
 
+    //! NOTE Where the time of a conversion goes, the layout is part of the load
+    struct ConvertTimes {
+        qint64 loadMs = 0;
+        double layoutMs = 0.0;
+        qint64 writeMs = 0;
+    };
+
+    struct JobResult {
+        Job job;
+        Ret ret;
+        qint64 elapsedMs = 0;
+        ConvertTimes times;
+    };
+
+    using BatchResult = std::list<JobResult>;
+
     RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+
+    Ret doFileConvert(const io::path& in, const std::vector<io::path>& out, const ExportRange& range, ConvertTimes* times);
+    Ret writeOutput(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out, const ExportRange& range);
+
+    Ret pagesConvert(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out, size_t firstPage,
+                     size_t pageCount, const notation::INotationWriter::Options& options);
+
+    RetVal<notation::INotationWriter::Options> rangeOptions(notation::INotationPtr notation, const ExportRange& range,
+                                                            const std::string& suffix) const;
+    Ret writeShardInfo(notation::INotationPtr notation, const ExportRange& range, const io::path& file) const;
+    BatchResult convertJobs(const BatchJob& batchJob);
+    RetVal<BatchResult> convertJobsInWorkers(const BatchJob& batchJob, int jobs);
+
+    Ret writeBatchJob(const BatchJob& batchJob, const io::path& file) const;
+    Ret writeBatchResult(const BatchResult& result, qint64 elapsedMs, const io::path& file) const;
+    RetVal<BatchResult> readBatchResult(const io::path& file) const;
 };
 }
 
@@ -0,0 +1,151 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "converterserver.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QTimer>
+
+#include "log.h"
+#include "convertercodes.h"
+
+using namespace mu::converter;
+
+ConverterServer::ConverterServer(ConvertFunction convert, QObject* parent)
+    : QObject(parent), m_convert(std::move(convert))
+{
+    connect(&m_server, &QLocalServer::newConnection, this, &ConverterServer::onNewConnection);
+}
+
+mu::Ret ConverterServer::run(const QString& name)
+{
+    //! NOTE A server that crashed leaves its socket file behind
+    QLocalServer::removeServer(name);
+
+    if (!m_server.listen(name)) {
+        LOGE() << "failed listen: " << name << ", err: " << m_server.errorString();
+        return make_ret(Err::ServerFailedListen, m_server.errorString().toStdString());
+    }
+
+    LOGI() << "converter server listens: " << m_server.fullServerName();
+    m_loop.exec();
+
+    m_server.close();
+    return make_ret(Ret::Code::Ok);
+}
+
+void ConverterServer::onNewConnection()
+{
+    while (QLocalSocket* client = m_server.nextPendingConnection()) {
+        connect(client, &QLocalSocket::readyRead, this, [this, client]() {
+            onReadyRead(client);
+        });
+        connect(client, &QLocalSocket::disconnected, client, &QObject::deleteLater);
+    }
+}
+
+void ConverterServer::onReadyRead(QLocalSocket* client)
+{
+    while (client->canReadLine()) {
+        QByteArray line = client->readLine().trimmed();
+        if (!line.isEmpty()) {
+            readRequest(client, line);
+        }
+    }
+}
+
+void ConverterServer::readRequest(QLocalSocket* client, const QByteArray& line)
+{
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        reply(client, QJsonValue(), make_ret(Err::ServerRequestFailedParse, err.errorString().toStdString()));
+        return;
+    }
+
+    QJsonObject obj = doc.object();
+    if (obj["quit"].toBool()) {
+        m_loop.quit();
+        return;
+    }
+
+    Job job;
+    job.client = client;
+    job.id = obj["id"];
+    job.in = obj["in"].toString();
+    job.out = obj["out"].toString();
+
+    if (job.in.empty() || job.out.empty()) {
+        reply(client, job.id, make_ret(Err::ServerRequestFailedParse, "no in or out file"));
+        return;
+    }
+
+    m_jobs.push_back(std::move(job));
+    scheduleNextJob();
+}
+
+void ConverterServer::reply(QLocalSocket* client, const QJsonValue& id, const Ret& ret, const QJsonObject& info)
+{
+    if (!client || client->state() != QLocalSocket::ConnectedState) {
+        return;
+    }
+
+    QJsonObject obj = info;
+    obj["id"] = id;
+    obj["code"] = ret ? 0 : ret.code();
+    obj["text"] = QString::fromStdString(ret.text());
+
+    client->write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    client->write("\n");
+    client->flush();
+}
+
+void ConverterServer::scheduleNextJob()
+{
+    //! NOTE One job per event loop pass, so that the clients are served in between
+    if (m_jobScheduled || m_jobs.empty()) {
+        return;
+    }
+
+    m_jobScheduled = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_jobScheduled = false;
+        runNextJob();
+        scheduleNextJob();
+    });
+}
+
+void ConverterServer::runNextJob()
+{
+    Job job = m_jobs.front();
+    m_jobs.pop_front();
+
+    if (!job.client) {
+        return;     // the client has gone
+    }
+
+    QJsonObject info;
+    Ret ret = m_convert(job.in, job.out, info);
+    if (!ret) {
+        LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
+    }
+
+    reply(job.client, job.id, ret, info);
+}
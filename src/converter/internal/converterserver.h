@@ -0,0 +1,79 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_CONVERTERSERVER_H
+#define MU_CONVERTER_CONVERTERSERVER_H
+
+#include <functional>
+#include <list>
+
+#include <QObject>
+#include <QPointer>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QEventLoop>
+#include <QJsonObject>
+#include <QJsonValue>
+
+#include "ret.h"
+#include "io/path.h"
+
+namespace mu::converter {
+//! NOTE Keeps the converter running and takes conversion jobs over a local socket,
+//! so the jobs do not pay for the application startup.
+//! A client writes one JSON object per line: {"id": ..., "in": "file", "out": "file"},
+//! or {"quit": true} to stop the server. Each job is answered with one line:
+//! {"id": ..., "code": 0, "text": "", "loadMs": ..., "layoutMs": ..., "writeMs": ...}, code 0 is success.
+//! The jobs are run one after another, in the order they came in.
+class ConverterServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! NOTE The function may add fields to the reply in info, as the timings of the job
+    using ConvertFunction = std::function<Ret(const io::path& in, const io::path& out, QJsonObject& info)>;
+
+    explicit ConverterServer(ConvertFunction convert, QObject* parent = nullptr);
+
+    //! Blocks until a client sends quit
+    Ret run(const QString& name);
+
+private:
+    struct Job {
+        QPointer<QLocalSocket> client;
+        QJsonValue id;
+        io::path in;
+        io::path out;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QLocalSocket* client);
+    void readRequest(QLocalSocket* client, const QByteArray& line);
+    void reply(QLocalSocket* client, const QJsonValue& id, const Ret& ret, const QJsonObject& info = QJsonObject());
+    void scheduleNextJob();
+    void runNextJob();
+
+    ConvertFunction m_convert;
+    QLocalServer m_server;
+    QEventLoop m_loop;
+    std::list<Job> m_jobs;
+    bool m_jobScheduled = false;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERSERVER_H
@@ -63,6 +63,11 @@ void ExtensionsModule::registerUiTypes()
     framework::ioc()->resolve<ui::IUiEngine>(moduleName())->addSourceImportPath(extensions_QML_IMPORT);
 }
 
+bool ExtensionsModule::isInitDeferred() const
+{
+    return true;
+}
+
 void ExtensionsModule::onInit(const framework::IApplication::RunMode& runMode)
 {
     if (framework::IApplication::RunMode::Editor != runMode) {
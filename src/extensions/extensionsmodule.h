@@ -31,6 +31,7 @@ public:
     void registerExports() override;
     void registerResources() override;
     void registerUiTypes() override;
+    bool isInitDeferred() const override;
     void onInit(const framework::IApplication::RunMode& mode) override;
 };
 }
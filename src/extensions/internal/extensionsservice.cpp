@@ -252,7 +252,8 @@ RetVal<QString> ExtensionsService::downloadExtension(const QString& extensionCod
 
     QString extensionArchivePath = configuration()->extensionArchivePath(extensionCode).toQString();
 
-    QBuffer buff;
+    //! NOTE The archive goes to the file as it is received, it is not kept in memory
+    QFile file(extensionArchivePath);
     INetworkManagerPtr networkManagerPtr = networkManagerCreator()->makeNetworkManager();
 
     async::Channel<Progress> downloadChannel = networkManagerPtr->progressChannel();
@@ -261,19 +262,15 @@ RetVal<QString> ExtensionsService::downloadExtension(const QString& extensionCod
                                                 progress.total));
     });
 
-    Ret getExtension = networkManagerPtr->get(configuration()->extensionFileServerUrl(extensionCode), &buff);
+    Ret getExtension = networkManagerPtr->get(configuration()->extensionFileServerUrl(extensionCode), &file);
 
     if (!getExtension) {
         LOGE() << "Error save file" << getExtension.toString();
+        file.remove();
         result.ret = make_ret(Err::ErrorLoadingExtension);
         return result;
     }
 
-    QFile file(extensionArchivePath);
-    file.open(QIODevice::WriteOnly);
-    file.write(buff.data());
-    file.close();
-
     result.ret = make_ret(Err::NoError);
     result.val = extensionArchivePath;
     return result;
@@ -393,6 +390,7 @@ void ExtensionsService::th_update(const QString& extensionCode, async::Channel<E
     RetVal<QString> download = downloadExtension(extensionCode, progressChannel);
     if (!download.ret) {
         finishChannel->send(download.ret);
+        return;
     }
 
     progressChannel->send(ExtensionProgress(ANALYSING_STATUS, true));
@@ -401,13 +399,17 @@ void ExtensionsService::th_update(const QString& extensionCode, async::Channel<E
 
     Ret remove = removeExtension(extensionCode);
     if (!remove) {
+        fileSystem()->remove(extensionArchivePath);
         finishChannel->send(remove);
+        return;
     }
 
     Ret unpack = extensionUnpacker()->unpack(extensionArchivePath, configuration()->extensionsSharePath().toQString());
     if (!unpack) {
         LOGE() << "Error unpack" << unpack.toString();
+        fileSystem()->remove(extensionArchivePath);
         finishChannel->send(unpack);
+        return;
     }
 
     fileSystem()->remove(extensionArchivePath);
@@ -18,6 +18,7 @@
 //=============================================================================
 #include "actionsdispatcher.h"
 #include "log.h"
+#include "commandstats.h"
 #include "actionable.h"
 
 using namespace mu::actions;
@@ -47,19 +48,16 @@ void ActionsDispatcher::dispatch(const ActionCode& actionCode, const ActionData&
         return;
     }
 
+    mu::commandstats::beginCommand(actionCode);
+    mu::commandstats::PhaseTimer commandTimer(mu::commandstats::Phase::Command);
+
     int canReceiveCount = 0;
     const Clients& clients = it->second;
     for (auto cit = clients.cbegin(); cit != clients.cend(); ++cit) {
         const Actionable* client = cit->first;
         if (client->canReceiveAction(actionCode)) {
             ++canReceiveCount;
-            const CallBacks& callbacks = cit->second;
-            auto cbit = callbacks.find(actionCode);
-            IF_ASSERT_FAILED(cbit != callbacks.end()) {
-                continue;
-            }
-
-            const ActionCallBackWithNameAndData& callback = cbit->second;
+            const ActionCallBackWithNameAndData& callback = cit->second;
             LOGI() << "try call action: " << actionCode;
             callback(actionCode, data);
         }
@@ -70,6 +68,8 @@ void ActionsDispatcher::dispatch(const ActionCode& actionCode, const ActionData&
     } else if (canReceiveCount > 1) {
         LOGW() << "More than one client can handle the action, this is not a typical situation.";
     }
+
+    mu::commandstats::endCommand();
 }
 
 void ActionsDispatcher::unReg(Actionable* client)
@@ -86,6 +86,5 @@ void ActionsDispatcher::reg(Actionable* client, const ActionCode& actionCode, co
     client->setDispatcher(this);
 
     Clients& clients = m_clients[actionCode];
-    CallBacks& callbacks = clients[client];
-    callbacks.insert({ actionCode, call });
+    clients.insert({ client, call });
 }
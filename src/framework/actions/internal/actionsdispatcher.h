@@ -20,6 +20,7 @@
 #define MU_ACTIONS_ACTIONSDISPATCHER_H
 
 #include <map>
+#include <unordered_map>
 
 #include "../iactionsdispatcher.h"
 
@@ -38,10 +39,10 @@ public:
 
 private:
 
-    using CallBacks = std::map<ActionCode, ActionCallBackWithNameAndData>;
-    using Clients = std::map<Actionable*, CallBacks>;
+    using Clients = std::map<Actionable*, ActionCallBackWithNameAndData>;
 
-    std::map<ActionCode, Clients > m_clients;
+    //! NOTE A dispatch finds the clients of an action with one lookup by hash
+    std::unordered_map<ActionCode, Clients> m_clients;
 };
 }
 
@@ -23,17 +23,26 @@ using namespace mu::actions;
 void ActionsRegister::reg(const std::shared_ptr<IModuleActions>& actions)
 {
     m_modules.push_back(actions);
+    m_actions.clear();
 }
 
 const ActionItem& ActionsRegister::action(const ActionCode& name) const
 {
+    auto it = m_actions.find(name);
+    if (it != m_actions.end()) {
+        return *it->second;
+    }
+
+    static ActionItem null;
+    const ActionItem* item = &null;
     for (const std::shared_ptr<IModuleActions>& m : m_modules) {
         const ActionItem& a = m->action(name);
         if (a.isValid()) {
-            return a;
+            item = &a;
+            break;
         }
     }
 
-    static ActionItem null;
-    return null;
+    m_actions.insert({ name, item });
+    return *item;
 }
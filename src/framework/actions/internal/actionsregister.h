@@ -20,6 +20,7 @@
 #define MU_ACTIONS_ACTIONSREGISTER_H
 
 #include <vector>
+#include <unordered_map>
 #include "../iactionsregister.h"
 
 namespace mu::actions {
@@ -34,6 +35,9 @@ public:
 private:
 
     std::vector<std::shared_ptr<IModuleActions> > m_modules;
+
+    //! NOTE The modules search their lists, the items found are kept by code until a module is registered
+    mutable std::unordered_map<ActionCode, const ActionItem*> m_actions;
 };
 }
 
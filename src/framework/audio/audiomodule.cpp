@@ -35,6 +35,8 @@
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
+#include "internal/ringaudiobuffer.h"
+#include "internal/offlineaudiorenderer.h"
 
 // synthesizers
 #include "internal/synthesizers/fluidsynth/fluidsynth.h"
@@ -51,7 +53,7 @@ using namespace mu::audio;
 
 static std::shared_ptr<AudioConfiguration> s_audioConfiguration = std::make_shared<AudioConfiguration>();
 static std::shared_ptr<AudioThread> s_audioWorker = std::make_shared<AudioThread>();
-static std::shared_ptr<mu::audio::AudioBuffer> s_audioBuffer = std::make_shared<mu::audio::AudioBuffer>();
+static std::shared_ptr<IAudioBuffer> s_audioBuffer = nullptr;
 
 static std::shared_ptr<rpc::RpcControllers> s_rpcControllers = std::make_shared<rpc::RpcControllers>();
 static std::shared_ptr<rpc::RpcSequencer> s_rpcSequencer = std::make_shared<rpc::RpcSequencer>();
@@ -108,6 +110,16 @@ void AudioModule::registerExports()
     ioc()->registerExport<synth::ISynthesizersRegister>(moduleName(), sreg);
     ioc()->registerExport<synth::ISoundFontsProvider>(moduleName(), new synth::SoundFontsProvider());
 
+    //! NOTE The offline renderer creates its own instances, so export doesn't share synthesizers with playback
+    std::shared_ptr<OfflineAudioRenderer> offlineRenderer = std::make_shared<OfflineAudioRenderer>();
+    offlineRenderer->registerSynthCreator("Zerberus", []() {
+        auto zerberus = std::make_shared<synth::ZerberusSynth>();
+        zerberus->setSampleStreaming(false);
+        return zerberus;
+    });
+    offlineRenderer->registerSynthCreator("Fluid", []() { return std::make_shared<synth::FluidSynth>(); });
+    ioc()->registerExport<IOfflineAudioRenderer>(moduleName(), offlineRenderer);
+
     //! TODO maybe need remove
     ioc()->registerExport<rpc::IRpcChannel>(moduleName(), s_audioWorker->channel());
 }
@@ -160,6 +172,12 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
     // Init configuration
     s_audioConfiguration->init();
 
+    if (s_audioConfiguration->useLegacyAudioBuffer()) {
+        s_audioBuffer = std::make_shared<mu::audio::AudioBuffer>();
+    } else {
+        s_audioBuffer = std::make_shared<RingAudioBuffer>();
+    }
+
     // Setup rpc system and worker
     s_rpcSequencer->setup();
     s_audioWorker->channel()->setupMainThread();
@@ -183,7 +201,9 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
     requiredSpec.format = IAudioDriver::Format::AudioF32;
     requiredSpec.channels = 2; // stereo
     requiredSpec.samples = s_audioConfiguration->driverBufferSize();
+    requiredSpec.exclusive = s_audioConfiguration->driverExclusiveMode();
     requiredSpec.callback = [](void* /*userdata*/, uint8_t* stream, int byteCount) {
+        AUDIO_REALTIME_SCOPE;
         auto samples = byteCount / (2 * sizeof(float));
         s_audioBuffer->pop(reinterpret_cast<float*>(stream), samples);
     };
@@ -220,4 +240,9 @@ void AudioModule::onDeinit()
         s_rpcControllers->deinit();
         AudioEngine::instance()->deinit();
     });
+
+    std::string realtimeReport = AudioSanitizer::realtimeReport();
+    if (!realtimeReport.empty()) {
+        LOGW() << realtimeReport;
+    }
 }
@@ -19,7 +19,7 @@
 #include "audioenginedevtools.h"
 #include "log.h"
 
-#include "internal/worker/audiostream.h"
+#include "internal/worker/audiofilestream.h"
 
 using namespace mu::audio;
 using namespace mu::midi;
@@ -35,6 +35,24 @@ AudioEngineDevTools::AudioEngineDevTools(QObject* parent)
     sequencer()->positionChanged().onNotify(this, [this]() {
         emit timeChanged();
     });
+
+    m_rpcStatsTimer.setInterval(500);
+    connect(&m_rpcStatsTimer, &QTimer::timeout, this, &AudioEngineDevTools::rpcStatsChanged);
+    m_rpcStatsTimer.start();
+
+    m_listenID = rpcChannel()->listen([this](const Msg& msg) {
+        if (msg.target.name != TargetName::DevTools || msg.method != "benchmarkFinished") {
+            return;
+        }
+
+        m_benchmarkResult = QString::fromStdString(msg.args.arg<std::string>(0));
+        emit benchmarkResultChanged();
+    });
+}
+
+AudioEngineDevTools::~AudioEngineDevTools()
+{
+    rpcChannel()->unlisten(m_listenID);
 }
 
 void AudioEngineDevTools::playSine()
@@ -149,7 +167,7 @@ void AudioEngineDevTools::openAudio()
 {
     auto path = interactive()->selectOpeningFile("audio file", "", "Audio files (*.wav *mp3 *ogg)");
     if (!m_audioStream) {
-        m_audioStream = std::make_shared<AudioStream>();
+        m_audioStream = std::make_shared<AudioFileStream>();
     }
 
     if (!path.empty()) {
@@ -164,11 +182,40 @@ void AudioEngineDevTools::closeAudio()
     sequencer()->setAudioTrack(1, nullptr);
 }
 
+void AudioEngineDevTools::runBenchmark(int sampleRate, int bufferSize)
+{
+    m_benchmarkResult = "running...";
+    emit benchmarkResultChanged();
+
+    rpcChannel()->send(Msg(TargetName::DevTools, "runBenchmark",
+                           Args::make_arg2<unsigned int, unsigned int>(static_cast<unsigned int>(sampleRate),
+                                                                       static_cast<unsigned int>(bufferSize))));
+}
+
 float AudioEngineDevTools::time() const
 {
     return sequencer()->playbackPositionInSeconds();
 }
 
+QString AudioEngineDevTools::rpcStats() const
+{
+    auto format = [](const QString& name, const QueueStats& st) {
+        return QString("%1: depth %2 (max %3), processed %4, overflowed %5, latency us: last %6 avg %7 max %8")
+               .arg(name)
+               .arg(st.depth).arg(st.maxDepth)
+               .arg(st.processed).arg(st.overflowed)
+               .arg(st.lastLatencyUs).arg(st.avgLatencyUs).arg(st.maxLatencyUs);
+    };
+
+    ChannelStats st = rpcChannel()->stats();
+    return format("to worker", st.toWorker) + "\n" + format("to main", st.toMain);
+}
+
+QString AudioEngineDevTools::benchmarkResult() const
+{
+    return m_benchmarkResult;
+}
+
 QVariantList AudioEngineDevTools::devices() const
 {
     QVariantList list;
@@ -45,9 +45,12 @@ class AudioEngineDevTools : public QObject, public async::Asyncable
 
     Q_PROPERTY(float time READ time NOTIFY timeChanged)
     Q_PROPERTY(QVariantList devices READ devices NOTIFY devicesChanged)
+    Q_PROPERTY(QString rpcStats READ rpcStats NOTIFY rpcStatsChanged)
+    Q_PROPERTY(QString benchmarkResult READ benchmarkResult NOTIFY benchmarkResultChanged)
 
 public:
     explicit AudioEngineDevTools(QObject* parent = nullptr);
+    ~AudioEngineDevTools();
 
     Q_INVOKABLE void playSine();
     Q_INVOKABLE void stopSine();
@@ -84,17 +87,27 @@ public:
     Q_INVOKABLE void openAudio();
     Q_INVOKABLE void closeAudio();
 
+    //! NOTE Blocks the worker for the duration of the benchmark, the playback is silent meanwhile
+    Q_INVOKABLE void runBenchmark(int sampleRate, int bufferSize);
+
     float time() const;
+    QString rpcStats() const;
+    QString benchmarkResult() const;
 
 signals:
     void timeChanged();
     void devicesChanged();
+    void rpcStatsChanged();
+    void benchmarkResultChanged();
 
 private:
     void makeArpeggio();
 
     std::shared_ptr<midi::MidiStream> m_midiStream = nullptr;
     std::shared_ptr<IAudioStream> m_audioStream = nullptr;
+    QTimer m_rpcStatsTimer;
+    rpc::IRpcChannel::ListenID m_listenID = -1;
+    QString m_benchmarkResult;
 };
 }
 
@@ -34,6 +34,35 @@ public:
 
     virtual unsigned int driverBufferSize() const = 0; // samples
 
+    //! NOTE Where the driver supports it, the device is used exclusively, with a buffer of driverBufferSize,
+    //! if it fails the driver shares the device
+    virtual bool driverExclusiveMode() const = 0;
+
+    //! NOTE The mutex based buffer is kept to compare dropouts with the lock-free one
+    virtual bool useLegacyAudioBuffer() const = 0;
+
+    //! NOTE Including the audio thread, 1 renders all voices on it
+    virtual unsigned int zerberusRenderThreads() const = 0;
+
+    //! NOTE Including the audio thread, each thread renders its own FluidSynth instance
+    //! and the MIDI channels are spread over them, 1 renders all channels on the audio thread
+    virtual unsigned int fluidRenderThreads() const = 0;
+
+    //! NOTE Including the audio thread, the mixer channels (the synths and their processors)
+    //! are processed in parallel on them, 1 processes them one after another on the audio thread
+    virtual unsigned int mixerThreads() const = 0;
+
+    //! NOTE Bytes of the paged Zerberus samples that are kept in memory
+    virtual size_t zerberusSampleCacheSize() const = 0;
+
+    //! NOTE The render time of a block as a part of its duration. Over the high load the synths
+    //! limit their voices and interpolate faster, under the low load they step back. 0 - never limit
+    virtual float renderHighLoad() const = 0;
+    virtual float renderLowLoad() const = 0;
+
+    //! NOTE The voice limit of the first step, each further step halves it
+    virtual unsigned int renderVoiceLimit() const = 0;
+
     // synthesizers
     virtual std::vector<io::path> soundFontPaths() const = 0;
     virtual const synth::SynthesizerState& synthesizerState() const = 0;
@@ -51,6 +51,7 @@ public:
         uint16_t samples;             // Audio buffer size in sample FRAMES (total samples divided by channel count)
         Callback callback;            // Callback that feeds the audio device
         void* userdata;               // Userdata passed to callback (ignored for NULL callbacks).
+        bool exclusive = false;       // Use the device exclusively, where the driver supports it
     };
 
     virtual std::string name() const = 0;
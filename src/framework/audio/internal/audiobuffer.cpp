@@ -19,6 +19,7 @@
 #include "audiobuffer.h"
 #include <cstring>
 #include "log.h"
+#include "perfcounters.h"
 
 using namespace mu::audio;
 
@@ -67,10 +68,15 @@ void AudioBuffer::push(const float* source, int sampleCount)
 
 void AudioBuffer::pop(float* dest, unsigned int sampleCount)
 {
+    TRACE_SCOPE("AudioBuffer::pop");
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
     //catch up if we are fall behind
     if (sampleCount > sampleLag()) {
+        TRACE_SCOPE("AudioBuffer::dropout");
+        m_dropoutCount.fetch_add(1, std::memory_order_relaxed);
+        mu::perfcounters::increment(mu::perfcounters::Counter::AudioDropouts);
+
         //! TODO We have to decide to wait or skip.
         //! We cannot make a direct call, this is a thread-unsafe.
         //fillup();
@@ -110,6 +116,11 @@ void AudioBuffer::setMinSampleLag(unsigned int lag)
     }
 }
 
+uint64_t AudioBuffer::dropoutCount() const
+{
+    return m_dropoutCount.load(std::memory_order_relaxed);
+}
+
 void AudioBuffer::fillup()
 {
     if (!m_source) {
@@ -117,6 +128,7 @@ void AudioBuffer::fillup()
     }
 
     while (sampleLag() < m_minSampleLag + FILL_OVER) {
+        TRACE_SCOPE("AudioBuffer::fillup");
         m_source->setBufferSize(FILL_SAMPLES);
         m_source->forward(FILL_SAMPLES);
         push(m_source->data(), FILL_SAMPLES);
@@ -22,6 +22,7 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <mutex>
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
@@ -41,12 +42,15 @@ public:
     void pop(float* dest, unsigned int sampleCount) override;
     void setMinSampleLag(unsigned int lag) override;
 
+    uint64_t dropoutCount() const override;
+
 private:
 
     unsigned int sampleLag() const;
     void fillup();
 
     std::recursive_mutex m_mutex; //! TODO get rid *recursive*
+    std::atomic<uint64_t> m_dropoutCount = { 0 };
     unsigned int m_streamsPerSample = 0;
     unsigned int m_minSampleLag = FILL_SAMPLES;
     unsigned int m_writeIndex = 0;
@@ -17,6 +17,7 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 #include "audioconfiguration.h"
+#include <algorithm>
 #include "settings.h"
 #include "stringutils.h"
 
@@ -35,6 +36,15 @@ using namespace mu::audio::synth;
 
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key AUDIO_EXCLUSIVE_MODE("audio", "driver_exclusive_mode");
+static const Settings::Key USE_LEGACY_AUDIO_BUFFER("audio", "use_legacy_buffer");
+static const Settings::Key ZERBERUS_RENDER_THREADS("audio", "zerberus_render_threads");
+static const Settings::Key ZERBERUS_SAMPLE_CACHE_MB("audio", "zerberus_sample_cache_mb");
+static const Settings::Key FLUID_RENDER_THREADS("audio", "fluid_render_threads");
+static const Settings::Key MIXER_THREADS("audio", "mixer_threads");
+static const Settings::Key RENDER_HIGH_LOAD("audio", "render_high_load");
+static const Settings::Key RENDER_LOW_LOAD("audio", "render_low_load");
+static const Settings::Key RENDER_VOICE_LIMIT("audio", "render_voice_limit");
 
 static const Settings::Key MY_SOUNDFONTS("midi", "application/paths/mySoundfonts");
 
@@ -45,12 +55,22 @@ static const std::string DEFAULT_ZERBERUS_SOUNDFONT = "FM-Piano1-20190916.sfz";
 void AudioConfiguration::init()
 {
     int defaultBufferSize = 0;
-#ifdef Q_OS_WASM
+#if defined(Q_OS_WASM) && !defined(__EMSCRIPTEN_PTHREADS__)
+    //! NOTE Without threads the audio is rendered on the browser main thread, between the events
     defaultBufferSize = 8192;
 #else
     defaultBufferSize = 1024;
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
+    settings()->setDefaultValue(AUDIO_EXCLUSIVE_MODE, Val(false));
+    settings()->setDefaultValue(USE_LEGACY_AUDIO_BUFFER, Val(false));
+    settings()->setDefaultValue(ZERBERUS_RENDER_THREADS, Val(1));
+    settings()->setDefaultValue(ZERBERUS_SAMPLE_CACHE_MB, Val(256));
+    settings()->setDefaultValue(FLUID_RENDER_THREADS, Val(1));
+    settings()->setDefaultValue(MIXER_THREADS, Val(1));
+    settings()->setDefaultValue(RENDER_HIGH_LOAD, Val(0.8));
+    settings()->setDefaultValue(RENDER_LOW_LOAD, Val(0.5));
+    settings()->setDefaultValue(RENDER_VOICE_LIMIT, Val(128));
 }
 
 unsigned int AudioConfiguration::driverBufferSize() const
@@ -58,6 +78,51 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+bool AudioConfiguration::driverExclusiveMode() const
+{
+    return settings()->value(AUDIO_EXCLUSIVE_MODE).toBool();
+}
+
+bool AudioConfiguration::useLegacyAudioBuffer() const
+{
+    return settings()->value(USE_LEGACY_AUDIO_BUFFER).toBool();
+}
+
+unsigned int AudioConfiguration::zerberusRenderThreads() const
+{
+    return static_cast<unsigned int>(std::max(1, settings()->value(ZERBERUS_RENDER_THREADS).toInt()));
+}
+
+unsigned int AudioConfiguration::fluidRenderThreads() const
+{
+    return static_cast<unsigned int>(std::max(1, settings()->value(FLUID_RENDER_THREADS).toInt()));
+}
+
+unsigned int AudioConfiguration::mixerThreads() const
+{
+    return static_cast<unsigned int>(std::max(1, settings()->value(MIXER_THREADS).toInt()));
+}
+
+size_t AudioConfiguration::zerberusSampleCacheSize() const
+{
+    return static_cast<size_t>(std::max(1, settings()->value(ZERBERUS_SAMPLE_CACHE_MB).toInt())) * 1024 * 1024;
+}
+
+float AudioConfiguration::renderHighLoad() const
+{
+    return std::max(0.f, settings()->value(RENDER_HIGH_LOAD).toFloat());
+}
+
+float AudioConfiguration::renderLowLoad() const
+{
+    return std::max(0.f, settings()->value(RENDER_LOW_LOAD).toFloat());
+}
+
+unsigned int AudioConfiguration::renderVoiceLimit() const
+{
+    return static_cast<unsigned int>(std::max(1, settings()->value(RENDER_VOICE_LIMIT).toInt()));
+}
+
 std::vector<io::path> AudioConfiguration::soundFontPaths() const
 {
     std::string pathsStr = settings()->value(MY_SOUNDFONTS).toString();
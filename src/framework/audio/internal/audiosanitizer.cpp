@@ -20,6 +20,33 @@
 
 #include <thread>
 
+#ifdef MU_AUDIO_RT_SANITIZER
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <vector>
+
+//! NOTE With glibc the functions of the C library can be replaced by the program,
+//! so malloc, the mutex locks and some system calls are seen, whoever calls them.
+//! Elsewhere only operator new and delete are replaced
+#if defined(__GLIBC__)
+#define MU_AUDIO_RT_INTERPOSE
+#include <cstdarg>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if __has_include(<execinfo.h>)
+#define MU_AUDIO_RT_BACKTRACE
+#include <execinfo.h>
+#endif
+#endif
+
 using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
@@ -38,6 +65,12 @@ bool AudioSanitizer::isMainThread()
 void AudioSanitizer::setupWorkerThread()
 {
     s_as_workerThreadID = std::this_thread::get_id();
+
+#ifdef MU_AUDIO_RT_BACKTRACE
+    //! NOTE The first backtrace loads the unwinder, not to be done on a realtime path
+    void* frames[1];
+    backtrace(frames, 1);
+#endif
 }
 
 std::thread::id AudioSanitizer::workerThread()
@@ -45,7 +78,320 @@ std::thread::id AudioSanitizer::workerThread()
     return s_as_workerThreadID;
 }
 
+static thread_local bool s_as_isWorkerHelper = false;
+
+void AudioSanitizer::setupWorkerHelperThread()
+{
+    s_as_isWorkerHelper = true;
+}
+
 bool AudioSanitizer::isWorkerThread()
 {
-    return std::this_thread::get_id() == s_as_workerThreadID;
+    return s_as_isWorkerHelper || std::this_thread::get_id() == s_as_workerThreadID;
+}
+
+#ifdef MU_AUDIO_RT_SANITIZER
+
+namespace {
+enum class Violation {
+    Allocation = 0,
+    Lock,
+    SystemCall,
+    Count
+};
+
+const char* violationName(Violation v)
+{
+    switch (v) {
+    case Violation::Allocation: return "allocation";
+    case Violation::Lock: return "lock";
+    case Violation::SystemCall: return "system call";
+    case Violation::Count: break;
+    }
+    return "";
+}
+
+constexpr int MAX_FRAMES = 24;
+constexpr int SKIP_FRAMES = 2;          // the sanitizer itself
+constexpr int MAX_STACKS = 256;
+constexpr unsigned SAMPLE_EVERY = 16;   // the stack of one in so many violations is kept
+
+struct Stack {
+    Violation violation = Violation::Allocation;
+    const char* function = nullptr;
+    int depth = 0;
+    void* frames[MAX_FRAMES];
+    int samples = 0;
+};
+
+//! NOTE Plain values only: they are used from malloc, before and after the static initialization
+thread_local int t_realtimeDepth = 0;
+thread_local bool t_inViolation = false;
+
+std::atomic<int> s_counts[int(Violation::Count)];
+std::atomic<unsigned> s_events { 0 };
+std::atomic_flag s_stacksLock = ATOMIC_FLAG_INIT;
+Stack s_stacks[MAX_STACKS];
+int s_stackCount = 0;
+int s_droppedSamples = 0;
+
+inline bool isRealtime()
+{
+    return t_realtimeDepth > 0 && !t_inViolation;
+}
+
+void addViolation(Violation v, const char* function)
+{
+    //! NOTE What is done here may allocate or lock itself
+    t_inViolation = true;
+    s_counts[int(v)].fetch_add(1, std::memory_order_relaxed);
+
+    if (s_events.fetch_add(1, std::memory_order_relaxed) % SAMPLE_EVERY == 0) {
+        Stack st;
+        st.violation = v;
+        st.function = function;
+#ifdef MU_AUDIO_RT_BACKTRACE
+        st.depth = backtrace(st.frames, MAX_FRAMES);
+#endif
+
+        while (s_stacksLock.test_and_set(std::memory_order_acquire)) {
+        }
+
+        Stack* found = nullptr;
+        for (int i = 0; i < s_stackCount && !found; ++i) {
+            const Stack& o = s_stacks[i];
+            if (o.violation == v && o.function == function && o.depth == st.depth
+                && std::memcmp(o.frames, st.frames, sizeof(void*) * st.depth) == 0) {
+                found = &s_stacks[i];
+            }
+        }
+
+        if (found) {
+            ++found->samples;
+        } else if (s_stackCount < MAX_STACKS) {
+            st.samples = 1;
+            s_stacks[s_stackCount++] = st;
+        } else {
+            ++s_droppedSamples;
+        }
+
+        s_stacksLock.clear(std::memory_order_release);
+    }
+
+    t_inViolation = false;
+}
+}
+
+AudioSanitizer::RealtimeScope::RealtimeScope()
+{
+    ++t_realtimeDepth;
+}
+
+AudioSanitizer::RealtimeScope::~RealtimeScope()
+{
+    --t_realtimeDepth;
+}
+
+std::string AudioSanitizer::realtimeReport()
+{
+    int total = 0;
+    for (const std::atomic<int>& c : s_counts) {
+        total += c.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return std::string();
+    }
+
+    while (s_stacksLock.test_and_set(std::memory_order_acquire)) {
+    }
+    std::vector<Stack> stacks(s_stacks, s_stacks + s_stackCount);
+    const int dropped = s_droppedSamples;
+    s_stacksLock.clear(std::memory_order_release);
+
+    std::sort(stacks.begin(), stacks.end(), [](const Stack& a, const Stack& b) {
+        return a.samples > b.samples;
+    });
+
+    std::ostringstream out;
+    out << "on the audio realtime paths:";
+    for (int v = 0; v < int(Violation::Count); ++v) {
+        out << " " << violationName(Violation(v)) << "s " << s_counts[v].load(std::memory_order_relaxed);
+    }
+    out << "; one in " << SAMPLE_EVERY << " sampled, by stack:\n";
+
+    for (const Stack& st : stacks) {
+        out << "\n" << st.samples << " x " << violationName(st.violation) << ", " << st.function << "\n";
+#ifdef MU_AUDIO_RT_BACKTRACE
+        char** symbols = backtrace_symbols(st.frames, st.depth);
+        for (int i = SKIP_FRAMES; symbols && i < st.depth; ++i) {
+            out << "    " << symbols[i] << "\n";
+        }
+        std::free(symbols);
+#endif
+    }
+
+    if (dropped > 0) {
+        out << "\n" << dropped << " samples of other stacks dropped\n";
+    }
+
+    return out.str();
+}
+
+#ifdef MU_AUDIO_RT_INTERPOSE
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void __libc_free(void* p);
+
+void* malloc(size_t size)
+{
+    if (isRealtime()) {
+        addViolation(Violation::Allocation, "malloc");
+    }
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size)
+{
+    if (isRealtime()) {
+        addViolation(Violation::Allocation, "calloc");
+    }
+    return __libc_calloc(n, size);
 }
+
+void* realloc(void* p, size_t size)
+{
+    if (isRealtime()) {
+        addViolation(Violation::Allocation, "realloc");
+    }
+    return __libc_realloc(p, size);
+}
+
+void free(void* p)
+{
+    if (p && isRealtime()) {
+        addViolation(Violation::Allocation, "free");
+    }
+    __libc_free(p);
+}
+}
+
+//! NOTE Not a function local static: its guard could lock a mutex
+template<typename F>
+static F realFunction(std::atomic<F>& f, const char* name)
+{
+    F p = f.load(std::memory_order_acquire);
+    if (!p) {
+        p = reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+        f.store(p, std::memory_order_release);
+    }
+    return p;
+}
+
+using MutexLockFunc = int (*)(pthread_mutex_t*);
+using ReadWriteFunc = ssize_t (*)(int, void*, size_t);
+using WriteFunc = ssize_t (*)(int, const void*, size_t);
+using NanosleepFunc = int (*)(const struct timespec*, struct timespec*);
+using UsleepFunc = int (*)(useconds_t);
+
+static std::atomic<MutexLockFunc> s_realMutexLock { nullptr };
+static std::atomic<ReadWriteFunc> s_realRead { nullptr };
+static std::atomic<WriteFunc> s_realWrite { nullptr };
+static std::atomic<NanosleepFunc> s_realNanosleep { nullptr };
+static std::atomic<UsleepFunc> s_realUsleep { nullptr };
+
+extern "C" {
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    if (isRealtime()) {
+        addViolation(Violation::Lock, "pthread_mutex_lock");
+    }
+    return realFunction(s_realMutexLock, "pthread_mutex_lock")(mutex);
+}
+
+ssize_t read(int fd, void* buf, size_t count)
+{
+    if (isRealtime()) {
+        addViolation(Violation::SystemCall, "read");
+    }
+    return realFunction(s_realRead, "read")(fd, buf, count);
+}
+
+ssize_t write(int fd, const void* buf, size_t count)
+{
+    if (isRealtime()) {
+        addViolation(Violation::SystemCall, "write");
+    }
+    return realFunction(s_realWrite, "write")(fd, buf, count);
+}
+
+int nanosleep(const struct timespec* req, struct timespec* rem)
+{
+    if (isRealtime()) {
+        addViolation(Violation::SystemCall, "nanosleep");
+    }
+    return realFunction(s_realNanosleep, "nanosleep")(req, rem);
+}
+
+int usleep(useconds_t usec)
+{
+    if (isRealtime()) {
+        addViolation(Violation::SystemCall, "usleep");
+    }
+    return realFunction(s_realUsleep, "usleep")(usec);
+}
+}
+
+#else
+
+void* operator new(std::size_t size)
+{
+    if (isRealtime()) {
+        addViolation(Violation::Allocation, "operator new");
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p && isRealtime()) {
+        addViolation(Violation::Allocation, "operator delete");
+    }
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+#endif // MU_AUDIO_RT_INTERPOSE
+
+#else
+
+std::string AudioSanitizer::realtimeReport()
+{
+    return std::string();
+}
+
+#endif // MU_AUDIO_RT_SANITIZER
@@ -22,6 +22,7 @@
 //! NOTE This is dev tools
 
 #include <cassert>
+#include <string>
 #include <thread>
 
 namespace mu::audio {
@@ -35,6 +36,22 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! NOTE A thread doing a part of the work of the worker while it waits for it, as the mixer threads.
+    //! It counts as the worker thread
+    static void setupWorkerHelperThread();
+
+#ifdef MU_AUDIO_RT_SANITIZER
+    //! NOTE While a scope is open on a thread, its heap allocations, mutex locks and blocking
+    //! system calls are counted, and the stacks of some of them are kept for the report
+    struct RealtimeScope {
+        RealtimeScope();
+        ~RealtimeScope();
+    };
+#endif
+
+    //! Empty if there was nothing on the realtime paths or if the build is without MU_AUDIO_RT_SANITIZER
+    static std::string realtimeReport();
 };
 }
 
@@ -42,4 +59,10 @@ public:
 #define ONLY_AUDIO_MAIN_THREAD assert(mu::audio::AudioSanitizer::isMainThread())
 #define ONLY_AUDIO_MAIN_OR_WORKER_THREAD assert((mu::audio::AudioSanitizer::isWorkerThread() || mu::audio::AudioSanitizer::isMainThread()))
 
+#ifdef MU_AUDIO_RT_SANITIZER
+#define AUDIO_REALTIME_SCOPE mu::audio::AudioSanitizer::RealtimeScope __audioRealtimeScope
+#else
+#define AUDIO_REALTIME_SCOPE
+#endif
+
 #endif // MU_AUDIO_AUDIOSANITIZER_H
@@ -21,6 +21,7 @@
 #include "log.h"
 #include "runtime.h"
 #include "async/processevents.h"
+#include "audiosanitizer.h"
 
 #ifdef Q_OS_WASM
 #include <emscripten/html5.h>
@@ -44,7 +45,7 @@ void AudioThread::run(const OnStart& onStart)
 {
     m_onStart = onStart;
 
-#ifndef Q_OS_WASM
+#if !defined(Q_OS_WASM) || defined(__EMSCRIPTEN_PTHREADS__)
     m_running = true;
     m_thread = std::make_shared<std::thread>([this]() {
         main();
@@ -76,7 +77,27 @@ void AudioThread::loopBody()
     mu::async::processEvents();
     m_channel->process();
     if (m_buffer) {
-        m_buffer->forward();
+        {
+            AUDIO_REALTIME_SCOPE;
+            m_buffer->forward();
+        }
+        checkDropouts();
+    }
+}
+
+void AudioThread::checkDropouts()
+{
+    //! NOTE The driver thread only counts the dropouts, they are reported from here
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_lastDropoutCheck < std::chrono::seconds(1)) {
+        return;
+    }
+    m_lastDropoutCheck = now;
+
+    uint64_t count = m_buffer->dropoutCount();
+    if (count != m_dropoutCount) {
+        LOGW() << "audio buffer dropouts: " << (count - m_dropoutCount) << ", total: " << count;
+        m_dropoutCount = count;
     }
 }
 
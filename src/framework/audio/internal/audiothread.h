@@ -24,6 +24,7 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <chrono>
 
 #include "iaudiobuffer.h"
 #include "modularity/ioc.h"
@@ -51,6 +52,7 @@ public:
 
 private:
     void main();
+    void checkDropouts();
 
     OnStart m_onStart;
     OnFinished m_onFinished;
@@ -59,6 +61,10 @@ private:
     std::shared_ptr<IAudioBuffer> m_buffer = nullptr;
     std::shared_ptr<std::thread> m_thread = nullptr;
     std::atomic<bool> m_running = false;
+
+    // worker thread only
+    uint64_t m_dropoutCount = 0;
+    std::chrono::steady_clock::time_point m_lastDropoutCheck;
 };
 }
 
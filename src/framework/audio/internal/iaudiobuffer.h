@@ -20,6 +20,7 @@
 #define MU_AUDIO_IAUDIOBUFFER_H
 
 #include <memory>
+#include <cstdint>
 #include "iaudiosource.h"
 
 namespace mu::audio {
@@ -34,6 +35,9 @@ public:
     virtual void push(const float* source, int sampleCount) = 0;
     virtual void pop(float* dest, unsigned int sampleCount) = 0;
     virtual void setMinSampleLag(unsigned int lag) = 0;
+
+    //! NOTE Number of pop calls that could not be fully served
+    virtual uint64_t dropoutCount() const = 0;
 };
 
 using IAudioBufferPtr = std::shared_ptr<IAudioBuffer>;
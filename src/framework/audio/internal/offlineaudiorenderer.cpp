@@ -0,0 +1,332 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "offlineaudiorenderer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef Q_OS_WASM
+#include <QtConcurrent>
+#endif
+
+#include "log.h"
+#include "audioerrors.h"
+#include "synthtypes.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static const tick_t LOAD_AHEAD_TICKS = 480 * 4 * 10; // about 10 measures of 4/4 time signature
+
+void OfflineAudioRenderer::registerSynthCreator(const SynthName& name, const SynthCreator& creator)
+{
+    m_creators[name] = creator;
+}
+
+Ret OfflineAudioRenderer::render(const MidiData& data, tick_t lastTick, const ChunkLoader& loadChunk, const BlockHandler& onBlock,
+                                 const Options& options)
+{
+    IF_ASSERT_FAILED(onBlock && options.sampleRate > 0 && options.blockSize > 0) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    Instances instances;
+    Ret ret = createInstances(instances, data, options);
+    if (!ret) {
+        return ret;
+    }
+
+    std::map<channel_t, size_t> channelInstance;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        for (channel_t ch : instances[i].channels) {
+            channelInstance[ch] = i;
+        }
+        instances[i].buf.resize(options.blockSize * AUDIO_CHANNELS);
+    }
+
+    TempoSegments segments = buildTempoSegments(data, options.sampleRate);
+
+    tick_t toTick = options.toTick > 0 ? std::min(options.toTick, lastTick) : lastTick;
+    IF_ASSERT_FAILED(options.fromTick <= toTick) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    uint64_t startSample = sampleAt(segments, options.fromTick);
+    uint64_t preRollSamples = std::min<uint64_t>(startSample, uint64_t(options.preRollMsec) * options.sampleRate / 1000);
+    uint64_t firstSample = startSample - preRollSamples;
+
+    tick_t loadedTick = 0;
+    for (const auto& it : data.chunks) {
+        enqueueChunk(instances, channelInstance, segments, it.second, firstSample);
+        loadedTick = std::max(loadedTick, it.second.endTick);
+    }
+
+    uint64_t tailSamples = uint64_t(options.tailMsec) * options.sampleRate / 1000;
+    uint64_t endSample = sampleAt(segments, toTick) + tailSamples;
+    uint64_t totalSamples = endSample - startSample;
+
+    std::vector<float> mixed(options.blockSize * AUDIO_CHANNELS);
+    std::vector<std::vector<float> > stems(options.stems.size(), std::vector<float>(options.blockSize * AUDIO_CHANNELS));
+
+    uint64_t position = firstSample;
+    while (position < endSample) {
+        //! NOTE The last block of the pre-roll ends at startSample, the blocks after it are output
+        bool isPreRoll = position < startSample;
+        uint64_t blockLimit = isPreRoll ? startSample : endSample;
+        unsigned int samples = static_cast<unsigned int>(std::min<uint64_t>(options.blockSize, blockLimit - position));
+
+        //! NOTE Load chunks ahead of the block end, so the events of the block are always queued
+        tick_t blockEndTick = tickAt(segments, position + samples);
+        while (loadChunk && loadedTick < lastTick && loadedTick <= blockEndTick + LOAD_AHEAD_TICKS) {
+            Chunk chunk = loadChunk(loadedTick);
+            if (chunk.endTick <= loadedTick) {
+                break;
+            }
+            enqueueChunk(instances, channelInstance, segments, chunk, firstSample);
+            loadedTick = chunk.endTick;
+        }
+
+#ifndef Q_OS_WASM
+        if (instances.size() > 1) {
+            QtConcurrent::blockingMap(instances, [this, position, samples](Instance& instance) {
+                renderInstance(instance, position, samples);
+            });
+        } else
+#endif
+        {
+            for (Instance& instance : instances) {
+                renderInstance(instance, position, samples);
+            }
+        }
+
+        position += samples;
+        if (isPreRoll) {
+            continue;
+        }
+
+        size_t count = samples * AUDIO_CHANNELS;
+        std::fill(mixed.begin(), mixed.begin() + count, 0.f);
+        for (std::vector<float>& stem : stems) {
+            std::fill(stem.begin(), stem.begin() + count, 0.f);
+        }
+        for (const Instance& instance : instances) {
+            const float* src = instance.buf.data();
+            for (size_t i = 0; i < count; ++i) {
+                mixed[i] += src[i];
+            }
+            if (instance.stem < stems.size()) {
+                float* dst = stems[instance.stem].data();
+                for (size_t i = 0; i < count; ++i) {
+                    dst[i] += src[i];
+                }
+            }
+        }
+
+        Block block;
+        block.data = mixed.data();
+        block.samples = samples;
+        block.renderedSamples = position - startSample;
+        block.totalSamples = totalSamples;
+        block.startSample = startSample;
+        for (const std::vector<float>& stem : stems) {
+            block.stems.push_back(stem.data());
+        }
+        if (!onBlock(block)) {
+            return make_ret(Ret::Code::Cancel);
+        }
+    }
+
+    return make_ret(Err::NoError);
+}
+
+SynthName OfflineAudioRenderer::resolveSynthName(channel_t ch, const SynthMap& synthMap) const
+{
+    ISynthesizerPtr defaultSynth = synthesizersRegister()->defaultSynthesizer();
+    SynthName defaultName = defaultSynth ? defaultSynth->name() : SynthName();
+
+    auto it = synthMap.find(ch);
+    if (it == synthMap.end() || m_creators.find(it->second) == m_creators.end()) {
+        return defaultName;
+    }
+
+    return it->second;
+}
+
+ISynthesizerPtr OfflineAudioRenderer::createSynth(const SynthName& name, unsigned int sampleRate) const
+{
+    auto it = m_creators.find(name);
+    if (it == m_creators.end()) {
+        LOGE() << "not found creator for synth: " << name;
+        return nullptr;
+    }
+
+    ISynthesizerPtr synth = it->second();
+    Ret ret = synth->init();
+    if (!ret) {
+        LOGE() << "failed init synth: " << name;
+        return nullptr;
+    }
+
+    synth->setSampleRate(sampleRate);
+    synth->addSoundFonts(soundFontsProvider()->soundFontPathsForSynth(name));
+    synth->setIsActive(true);
+
+    return synth;
+}
+
+Ret OfflineAudioRenderer::createInstances(Instances& instances, const MidiData& data, const Options& options) const
+{
+    auto stemOf = [&options](channel_t ch) {
+        for (size_t i = 0; i < options.stems.size(); ++i) {
+            if (options.stems[i].count(ch)) {
+                return i;
+            }
+        }
+        return options.stems.size();
+    };
+
+    std::map<std::pair<size_t /*stem*/, SynthName>, std::vector<channel_t> > synthChannels;
+    for (channel_t ch : data.channels()) {
+        synthChannels[{ stemOf(ch), resolveSynthName(ch, data.synthMap) }].push_back(ch);
+    }
+
+    //! NOTE Synthesizers are linear, so the sum of instances playing a part of the channels
+    //! is the same as one instance playing all of them
+    for (const auto& it : synthChannels) {
+        size_t count = std::max<size_t>(1, std::min<size_t>(options.instancesPerSynth, it.second.size()));
+        size_t first = instances.size();
+        for (size_t i = 0; i < count; ++i) {
+            Instance instance;
+            instance.synth = createSynth(it.first.second, options.sampleRate);
+            if (!instance.synth) {
+                return make_ret(Err::SynthNotInited);
+            }
+            instance.stem = it.first.first;
+            instances.push_back(std::move(instance));
+        }
+
+        for (size_t i = 0; i < it.second.size(); ++i) {
+            instances[first + i % count].channels.insert(it.second[i]);
+        }
+    }
+
+    for (Instance& instance : instances) {
+        instance.synth->setupChannels(data.initEventsForChannels(instance.channels));
+    }
+
+    return make_ret(Err::NoError);
+}
+
+OfflineAudioRenderer::TempoSegments OfflineAudioRenderer::buildTempoSegments(const MidiData& data, unsigned int sampleRate) const
+{
+    TempoMap tempos = data.tempoMap;
+    if (tempos.empty() || tempos.begin()->first != 0) {
+        //! NOTE If tempo is not set, then set the default tempo to 120
+        tempos.insert({ 0, 500000 });
+    }
+
+    TempoSegments segments;
+    double sample = 0.0;
+    for (auto it = tempos.cbegin(); it != tempos.cend(); ++it) {
+        TempoSegment s;
+        s.startTick = it->first;
+        s.startSample = sample;
+        s.samplesPerTick = static_cast<double>(it->second) / static_cast<double>(data.division) / 1000000. * sampleRate;
+
+        auto next = std::next(it);
+        if (next != tempos.cend()) {
+            sample += (next->first - s.startTick) * s.samplesPerTick;
+        }
+
+        segments.push_back(s);
+    }
+
+    return segments;
+}
+
+uint64_t OfflineAudioRenderer::sampleAt(const TempoSegments& segments, tick_t tick) const
+{
+    auto it = std::upper_bound(segments.cbegin(), segments.cend(), tick, [](tick_t t, const TempoSegment& s) {
+        return t < s.startTick;
+    });
+    const TempoSegment& s = *std::prev(it);
+    return static_cast<uint64_t>(s.startSample + (tick - s.startTick) * s.samplesPerTick);
+}
+
+tick_t OfflineAudioRenderer::tickAt(const TempoSegments& segments, uint64_t sample) const
+{
+    auto it = std::upper_bound(segments.cbegin(), segments.cend(), static_cast<double>(sample), [](double smp, const TempoSegment& s) {
+        return smp < s.startSample;
+    });
+    const TempoSegment& s = *std::prev(it);
+    return s.startTick + static_cast<tick_t>((sample - s.startSample) / s.samplesPerTick);
+}
+
+void OfflineAudioRenderer::enqueueChunk(Instances& instances, const std::map<channel_t, size_t>& channelInstance,
+                                        const TempoSegments& segments, const Chunk& chunk, uint64_t firstSample) const
+{
+    for (auto it = chunk.events.begin(); it != chunk.events.end(); ++it) {
+        const Event& event = it->second;
+        if (!event) {
+            continue;
+        }
+
+        auto inst = channelInstance.find(event.channel());
+        if (inst == channelInstance.end()) {
+            continue;
+        }
+
+        uint64_t sample = sampleAt(segments, it->first);
+        if (sample < firstSample && event.isOpcodeIn({ Event::Opcode::NoteOn, Event::Opcode::NoteOff })) {
+            continue;
+        }
+
+        instances[inst->second].events.push_back({ sample, event });
+    }
+}
+
+void OfflineAudioRenderer::renderInstance(Instance& instance, uint64_t blockStart, unsigned int samples) const
+{
+    float* buf = instance.buf.data();
+    std::memset(buf, 0, samples * AUDIO_CHANNELS * sizeof(float));
+
+    //! NOTE Events are sample accurate, the block is split at each event position
+    unsigned int done = 0;
+    while (!instance.events.empty()) {
+        const TimedEvent& te = instance.events.front();
+        if (te.sample >= blockStart + samples) {
+            break;
+        }
+
+        unsigned int offset = te.sample > blockStart ? static_cast<unsigned int>(te.sample - blockStart) : 0;
+        if (offset > done) {
+            instance.synth->writeBuf(buf + done * AUDIO_CHANNELS, offset - done);
+            done = offset;
+        }
+
+        instance.synth->handleEvent(te.event);
+        instance.events.pop_front();
+    }
+
+    if (done < samples) {
+        instance.synth->writeBuf(buf + done * AUDIO_CHANNELS, samples - done);
+    }
+}
@@ -0,0 +1,87 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_OFFLINEAUDIORENDERER_H
+#define MU_AUDIO_OFFLINEAUDIORENDERER_H
+
+#include <map>
+#include <set>
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include "iofflineaudiorenderer.h"
+#include "modularity/ioc.h"
+#include "isynthesizersregister.h"
+#include "isoundfontsprovider.h"
+
+namespace mu::audio {
+class OfflineAudioRenderer : public IOfflineAudioRenderer
+{
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+    INJECT(audio, synth::ISoundFontsProvider, soundFontsProvider)
+
+public:
+    using SynthCreator = std::function<synth::ISynthesizerPtr()>;
+
+    void registerSynthCreator(const synth::SynthName& name, const SynthCreator& creator);
+
+    Ret render(const midi::MidiData& data, midi::tick_t lastTick, const ChunkLoader& loadChunk, const BlockHandler& onBlock,
+               const Options& options = Options()) override;
+
+private:
+
+    struct TimedEvent {
+        uint64_t sample = 0;
+        midi::Event event;
+    };
+
+    struct Instance {
+        synth::ISynthesizerPtr synth;
+        size_t stem = 0;                // Options::stems.size() for the channels in no stem
+        std::set<midi::channel_t> channels;
+        std::deque<TimedEvent> events;
+        std::vector<float> buf;
+    };
+
+    struct TempoSegment {
+        midi::tick_t startTick = 0;
+        double startSample = 0.0;
+        double samplesPerTick = 0.0;
+    };
+
+    using Instances = std::vector<Instance>;
+    using TempoSegments = std::vector<TempoSegment>;
+
+    synth::SynthName resolveSynthName(midi::channel_t ch, const midi::SynthMap& synthMap) const;
+    synth::ISynthesizerPtr createSynth(const synth::SynthName& name, unsigned int sampleRate) const;
+    Ret createInstances(Instances& instances, const midi::MidiData& data, const Options& options) const;
+
+    TempoSegments buildTempoSegments(const midi::MidiData& data, unsigned int sampleRate) const;
+    uint64_t sampleAt(const TempoSegments& segments, midi::tick_t tick) const;
+    midi::tick_t tickAt(const TempoSegments& segments, uint64_t sample) const;
+
+    void enqueueChunk(Instances& instances, const std::map<midi::channel_t, size_t>& channelInstance, const TempoSegments& segments,
+                      const midi::Chunk& chunk, uint64_t firstSample) const;
+    void renderInstance(Instance& instance, uint64_t blockStart, unsigned int samples) const;
+
+    std::map<synth::SynthName, SynthCreator> m_creators;
+};
+}
+
+#endif // MU_AUDIO_OFFLINEAUDIORENDERER_H
@@ -8,6 +8,7 @@
 #include <string.h>
 #include <math.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include "log.h"
 #include "runtime.h"
@@ -21,6 +22,7 @@ struct ALSAData
     snd_pcm_t* alsaDeviceHandle;
     int samples;
     int channels;
+    bool mmap;
     bool audioProcessingDone;
     pthread_t threadHandle;
     IAudioDriver::Callback callback;
@@ -29,9 +31,79 @@ struct ALSAData
 
 static ALSAData* _alsaData{ nullptr };
 
+static void setRealtimePriority()
+{
+    //! NOTE Usually not allowed without privileges, then the driver keeps the normal priority.
+    //! Above the audio workers, which fill the buffer the driver reads
+    sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        LOGD() << "no realtime priority for the audio driver";
+    }
+}
+
+//! NOTE Writes a period straight into the ring buffer of the device,
+//! the callback renders into it without a copy
+static void writeMmap(ALSAData* data)
+{
+    snd_pcm_t* handle = data->alsaDeviceHandle;
+
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(handle);
+    if (avail < 0) {
+        snd_pcm_recover(handle, avail, 1);
+        return;
+    }
+
+    if (avail < data->samples) {
+        if (snd_pcm_state(handle) == SND_PCM_STATE_PREPARED) {
+            snd_pcm_start(handle);
+        }
+        snd_pcm_wait(handle, 1000);
+        return;
+    }
+
+    snd_pcm_uframes_t remains = data->samples;
+    while (remains > 0) {
+        const snd_pcm_channel_area_t* areas = nullptr;
+        snd_pcm_uframes_t offset = 0;
+        snd_pcm_uframes_t frames = remains;
+        int rc = snd_pcm_mmap_begin(handle, &areas, &offset, &frames);
+        if (rc < 0) {
+            snd_pcm_recover(handle, rc, 1);
+            return;
+        }
+
+        //! NOTE Interleaved, all channels are in the first area
+        uint8_t* stream = static_cast<uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        data->callback(data->userdata, stream, frames * data->channels * sizeof(float));
+
+        snd_pcm_sframes_t committed = snd_pcm_mmap_commit(handle, offset, frames);
+        if (committed < 0 || snd_pcm_uframes_t(committed) != frames) {
+            snd_pcm_recover(handle, committed < 0 ? committed : -EPIPE, 1);
+            return;
+        }
+        remains -= frames;
+    }
+}
+
+static void writeBuffer(ALSAData* data)
+{
+    uint8_t* stream = (uint8_t*)data->buffer;
+    int len = data->samples * data->channels * sizeof(float);
+
+    data->callback(data->userdata, stream, len);
+
+    snd_pcm_sframes_t pcm = snd_pcm_writei(data->alsaDeviceHandle, data->buffer, data->samples);
+    if (pcm != -EPIPE) {
+    } else {
+        snd_pcm_prepare(data->alsaDeviceHandle);
+    }
+}
+
 static void* alsaThread(void* aParam)
 {
     mu::runtime::setThreadName("audio_driver");
+    setRealtimePriority();
     ALSAData* data = static_cast<ALSAData*>(aParam);
 
     int ret = snd_pcm_wait(data->alsaDeviceHandle, 1000);
@@ -41,15 +113,10 @@ static void* alsaThread(void* aParam)
 
     while (!data->audioProcessingDone)
     {
-        uint8_t* stream = (uint8_t*)data->buffer;
-        int len = data->samples * data->channels * sizeof(float);
-
-        data->callback(data->userdata, stream, len);
-
-        snd_pcm_sframes_t pcm = snd_pcm_writei(data->alsaDeviceHandle, data->buffer, data->samples);
-        if (pcm != -EPIPE) {
+        if (data->mmap) {
+            writeMmap(data);
         } else {
-            snd_pcm_prepare(data->alsaDeviceHandle);
+            writeBuffer(data);
         }
     }
 
@@ -110,11 +177,22 @@ bool LinuxAudioDriver::open(const Spec& spec, Spec* activeSpec)
     snd_pcm_hw_params_alloca(&params);
     snd_pcm_hw_params_any(handle, params);
 
-    snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    //! NOTE Not all devices (and plugins) can be mapped, these are written through a buffer
+    _alsaData->mmap = snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0;
+    if (!_alsaData->mmap) {
+        snd_pcm_hw_params_set_access(handle, params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    }
     snd_pcm_hw_params_set_format(handle, params, SND_PCM_FORMAT_FLOAT_LE);
     snd_pcm_hw_params_set_channels(handle, params, spec.channels);
     snd_pcm_hw_params_set_buffer_size(handle, params, spec.samples);
 
+    //! NOTE Two periods in the buffer, one is written while the other one plays
+    if (_alsaData->mmap) {
+        snd_pcm_uframes_t period = spec.samples / 2;
+        int periodDir = 0;
+        snd_pcm_hw_params_set_period_size_near(handle, params, &period, &periodDir);
+    }
+
     unsigned int aSamplerate = spec.sampleRate;
     unsigned int val = aSamplerate;
     int dir = 0;
@@ -131,6 +209,14 @@ bool LinuxAudioDriver::open(const Spec& spec, Spec* activeSpec)
     snd_pcm_hw_params_get_rate(params, &val, &dir);
     aSamplerate = val;
 
+    if (_alsaData->mmap) {
+        snd_pcm_uframes_t period = 0;
+        snd_pcm_hw_params_get_period_size(params, &period, &dir);
+        if (period > 0) {
+            _alsaData->samples = period;
+        }
+    }
+
     _alsaData->buffer = new float[_alsaData->samples * _alsaData->channels];
     //_alsaData->sampleBuffer = new short[_alsaData->samples * _alsaData->channels];
 
@@ -0,0 +1,55 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+// Plays the frames that the audio_driver thread writes into the ring in the wasm memory,
+// see WorkletRing in webaudiodriver.cpp. Nothing is allocated or waited for here,
+// if the ring runs empty the rest of the quantum is silence.
+class MuAudioProcessor extends AudioWorkletProcessor {
+    constructor(options) {
+        super();
+        const o = options.processorOptions;
+        this.positions = new Int32Array(o.memory, o.positionsPtr, 2); // read, write
+        this.frames = new Float32Array(o.memory, o.framesPtr, o.capacity * o.channels);
+        this.mask = o.capacity - 1;
+        this.channels = o.channels;
+    }
+
+    process(inputs, outputs) {
+        const output = outputs[0];
+        const length = output[0].length;
+
+        const readPos = Atomics.load(this.positions, 0);
+        const writePos = Atomics.load(this.positions, 1);
+        const count = Math.min(length, (writePos - readPos) >>> 0);
+
+        for (let c = 0; c < output.length; ++c) {
+            const channelData = output[c];
+            const source = Math.min(c, this.channels - 1);
+            for (let i = 0; i < count; ++i) {
+                channelData[i] = this.frames[((readPos + i) & this.mask) * this.channels + source];
+            }
+            channelData.fill(0, count);
+        }
+
+        Atomics.store(this.positions, 0, (readPos + count) | 0);
+        return true;
+    }
+}
+
+registerProcessor("mu-audio-processor", MuAudioProcessor);
@@ -24,6 +24,15 @@
 #include <emscripten/bind.h>
 #include <emscripten/html5.h>
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "runtime.h"
+#endif
+
 using namespace mu::audio;
 using namespace emscripten;
 
@@ -64,10 +73,128 @@ EM_BOOL mouseCallback(int eventType, const EmscriptenMouseEvent* e, void* userDa
     }
     return true;
 }
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+//! NOTE With threads the audio is rendered by the audio_driver thread (a Web Worker) into a ring in the wasm memory,
+//! which is a SharedArrayBuffer, and played by the processor of muaudioworklet.js on the browser audio thread.
+//! The positions only grow, the frames are at position & (capacity - 1), interleaved.
+struct WorkletRing {
+    alignas(4) std::atomic<uint32_t> readPos { 0 };    // written by the worklet processor
+    alignas(4) std::atomic<uint32_t> writePos { 0 };   // written by the driver thread
+    uint32_t capacity = 0;
+    uint32_t channels = 0;
+    std::vector<float> frames;
+};
+static_assert(sizeof(std::atomic<uint32_t>) == 4, "the processor reads the positions as Int32Array");
+
+static const char* WORKLET_SCRIPT = "muaudioworklet.js";
+static const char* WORKLET_PROCESSOR = "mu-audio-processor";
+
+static WorkletRing ring;
+static std::thread driverThread;
+static std::atomic<bool> driverRunning { false };
+
+bool isWorkletSupported()
+{
+    return val::global("crossOriginIsolated").as<bool>()
+           && val::global("AudioWorkletNode").as<bool>()
+           && context["audioWorklet"].as<bool>();
+}
+
+void driverLoop(IAudioDriver::Callback callback, void* userdata, uint32_t chunk)
+{
+    mu::runtime::setThreadName("audio_driver");
+
+    const uint32_t mask = ring.capacity - 1;
+    std::vector<float> chunkBuffer(chunk * ring.channels, 0.f);
+    int bytes = static_cast<int>(chunkBuffer.size() * sizeof(float));
+
+    while (driverRunning) {
+        uint32_t writePos = ring.writePos.load(std::memory_order_relaxed);
+        while (ring.capacity - (writePos - ring.readPos.load(std::memory_order_acquire)) >= chunk) {
+            callback(userdata, reinterpret_cast<uint8_t*>(chunkBuffer.data()), bytes);
+
+            for (uint32_t i = 0; i < chunk; ++i) {
+                float* frame = ring.frames.data() + ((writePos + i) & mask) * ring.channels;
+                std::copy_n(chunkBuffer.data() + i * ring.channels, ring.channels, frame);
+            }
+
+            writePos += chunk;
+            ring.writePos.store(writePos, std::memory_order_release);
+        }
+
+        //! NOTE The worklet reads 128 frames a time, about 3 ms
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void workletLoaded(emscripten::val)
+{
+    val processorOptions = val::object();
+    processorOptions.set("memory", val::module_property("HEAPF32")["buffer"]);
+    processorOptions.set("positionsPtr", reinterpret_cast<uintptr_t>(&ring.readPos));
+    processorOptions.set("framesPtr", reinterpret_cast<uintptr_t>(ring.frames.data()));
+    processorOptions.set("capacity", ring.capacity);
+    processorOptions.set("channels", ring.channels);
+
+    val outputChannelCount = val::array();
+    outputChannelCount.call<void>("push", ring.channels);
+
+    val options = val::object();
+    options.set("numberOfInputs", 0);
+    options.set("numberOfOutputs", 1);
+    options.set("outputChannelCount", outputChannelCount);
+    options.set("processorOptions", processorOptions);
+
+    val audioNode = val::global("AudioWorkletNode").new_(context, val(WORKLET_PROCESSOR), options);
+    audioNode.call<val>("connect", context["destination"]);
+}
+
+void workletFailed(emscripten::val error)
+{
+    LOGE() << "can't load the audio worklet: " << error.call<std::string>("toString");
+}
+
+bool openWorklet(const IAudioDriver::Spec& spec)
+{
+    uint32_t capacity = 1;
+    while (capacity < 2u * spec.samples) {
+        capacity <<= 1;
+    }
+
+    ring.readPos = 0;
+    ring.writePos = 0;
+    ring.capacity = capacity;
+    ring.channels = spec.channels;
+    ring.frames.assign(capacity * spec.channels, 0.f);
+
+    driverRunning = true;
+    driverThread = std::thread(driverLoop, spec.callback, spec.userdata, spec.samples);
+
+    context["audioWorklet"].call<val>("addModule", val(WORKLET_SCRIPT))
+    .call<val>("then", val::module_property("workletLoaded"), val::module_property("workletFailed"));
+
+    return true;
+}
+
+void closeWorklet()
+{
+    if (!driverRunning) {
+        return;
+    }
+
+    driverRunning = false;
+    driverThread.join();
+}
+#endif
 }
 EMSCRIPTEN_BINDINGS(events)
 {
     function("audioCallback", web::audioCallback);
+#ifdef __EMSCRIPTEN_PTHREADS__
+    function("workletLoaded", web::workletLoaded);
+    function("workletFailed", web::workletFailed);
+#endif
 }
 
 WebAudioDriver::WebAudioDriver()
@@ -97,6 +224,16 @@ bool WebAudioDriver::open(const Spec& spec, Spec* activeSpec)
     activeSpec->sampleRate = sampleRate;
     web::format = activeSpec;
 
+    emscripten_set_mousedown_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, web::mouseCallback);
+
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (web::isWorkletSupported()) {
+        m_opened = web::openWorklet(*activeSpec);
+        return m_opened;
+    }
+    LOGW() << "no audio worklet, the audio is played from the main thread";
+#endif
+
     auto audioNode = web::context.call<val>("createScriptProcessor", spec.samples, 0, spec.channels);
     if (!audioNode.as<bool>()) {
         LOGE() << "can't create audio script processor";
@@ -107,13 +244,15 @@ bool WebAudioDriver::open(const Spec& spec, Spec* activeSpec)
     audioNode.set("onaudioprocess", val::module_property("audioCallback"));
     audioNode.call<val>("connect", web::context["destination"]);
 
-    emscripten_set_mousedown_callback(EMSCRIPTEN_EVENT_TARGET_WINDOW, nullptr, true, web::mouseCallback);
     m_opened = true;
     return m_opened;
 }
 
 void WebAudioDriver::close()
 {
+#ifdef __EMSCRIPTEN_PTHREADS__
+    web::closeWorklet();
+#endif
     web::context.call<val>("close");
 }
 
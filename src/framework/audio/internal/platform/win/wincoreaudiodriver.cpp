@@ -18,10 +18,12 @@
 //=============================================================================
 #include "wincoreaudiodriver.h"
 
+#include <algorithm>
 #include <system_error>
 #include "mmdeviceapi.h"
 #include "windows.h"
 #include "audioclient.h"
+#include "avrt.h"
 #include "log.h"
 
 #define CHECK_HRESULT(hr); if (hr != S_OK) { \
@@ -37,12 +39,57 @@ struct WinCoreData {
     IAudioDriver::Callback callback;
     WAVEFORMATEX pFormat;
     HANDLE hEvent;
+    bool exclusive = false;
 };
 
 static void logError(HRESULT hr);
 
 static WinCoreData* s_data = nullptr;
 
+static REFERENCE_TIME framesDuration(UINT32 frames)
+{
+    return static_cast<REFERENCE_TIME>(10000000.0 * frames / s_data->pFormat.nSamplesPerSec + 0.5);
+}
+
+static bool activateClient(IMMDevice* device)
+{
+    if (s_data->audioClient) {
+        s_data->audioClient->Release();
+        s_data->audioClient = nullptr;
+    }
+    HRESULT hr = device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, NULL, (void**)&s_data->audioClient);
+    logError(hr);
+    return hr == S_OK;
+}
+
+//! NOTE An event driven exclusive stream has a buffer of one period, of the required samples
+//! and at least the minimum period of the device. A duration the device can't align to is
+//! retried with the aligned buffer size on a new client, as a failed client can't be initialized again
+static bool initializeExclusive(IMMDevice* device, UINT32 samples, REFERENCE_TIME minimumTime)
+{
+    HRESULT hr = s_data->audioClient->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, &s_data->pFormat, NULL);
+    if (hr != S_OK) {
+        LOGI() << "exclusive mode is not supported for the format";
+        return false;
+    }
+
+    REFERENCE_TIME duration = std::max(minimumTime, framesDuration(samples));
+    hr = s_data->audioClient->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                                         duration, duration, &s_data->pFormat, NULL);
+    if (hr == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED) {
+        UINT32 alignedFrames = 0;
+        s_data->audioClient->GetBufferSize(&alignedFrames);
+        duration = framesDuration(alignedFrames);
+        if (!activateClient(device)) {
+            return false;
+        }
+        hr = s_data->audioClient->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                                             duration, duration, &s_data->pFormat, NULL);
+    }
+    logError(hr);
+    return hr == S_OK;
+}
+
 CoreAudioDriver::CoreAudioDriver()
 {
 }
@@ -80,7 +127,9 @@ bool CoreAudioDriver::open(const IAudioDriver::Spec& spec, IAudioDriver::Spec* a
     CHECK_HRESULT(hr);
 
     hr = pDdevice->Activate(MU_IID_IAudioClient, CLSCTX_ALL,NULL, (void**)&s_data->audioClient);
-    pDdevice->Release();
+    if (hr != S_OK) {
+        pDdevice->Release();
+    }
     CHECK_HRESULT(hr);
 
     WAVEFORMATEX* deviceFormat;
@@ -105,14 +154,29 @@ bool CoreAudioDriver::open(const IAudioDriver::Spec& spec, IAudioDriver::Spec* a
         activeSpec->format = Format::AudioF32;
         activeSpec->sampleRate = s_data->pFormat.nSamplesPerSec;
     }
-    hr = s_data->audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED, AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
-                                         defaultTime, defaultTime, &s_data->pFormat, NULL);
+
+    s_data->exclusive = spec.exclusive && initializeExclusive(pDdevice, spec.samples, minimumTime);
+    if (!s_data->exclusive) {
+        //! NOTE After a failed exclusive initialization the device is shared, with a client of its own
+        if (spec.exclusive && !activateClient(pDdevice)) {
+            pDdevice->Release();
+            return false;
+        }
+        hr = s_data->audioClient->Initialize(AUDCLNT_SHAREMODE_SHARED, AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+                                             defaultTime, defaultTime, &s_data->pFormat, NULL);
+    }
+    pDdevice->Release();
     CHECK_HRESULT(hr);
 
     UINT32 bufferFrameCount;
     hr = s_data->audioClient->GetBufferSize(&bufferFrameCount);
     CHECK_HRESULT(hr);
 
+    LOGI() << (s_data->exclusive ? "exclusive" : "shared") << " mode, buffer: " << bufferFrameCount;
+    if (activeSpec && s_data->exclusive) {
+        activeSpec->samples = bufferFrameCount;
+    }
+
     hr = s_data->audioClient->GetService(MU_IID_IAudioRenderClient, (void**)&s_data->renderClient);
     CHECK_HRESULT(hr);
 
@@ -122,15 +186,25 @@ bool CoreAudioDriver::open(const IAudioDriver::Spec& spec, IAudioDriver::Spec* a
 
     m_active = true;
     m_thread = std::thread([this]() {
+        //! NOTE Scheduled by MMCSS as pro audio, not to be preempted by the normal priority threads
+        DWORD taskIndex = 0;
+        HANDLE mmcssHandle = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+        if (!mmcssHandle) {
+            LOGW() << "no MMCSS registration for the audio driver: " << GetLastError();
+        }
+
         BYTE* pData;
         HRESULT hr = S_OK;
         do {
-            UINT32 bufferFrameCount, bufferPading;
+            UINT32 bufferFrameCount, bufferPading = 0;
             hr = s_data->audioClient->GetBufferSize(&bufferFrameCount);
             logError(hr);
 
-            hr = s_data->audioClient->GetCurrentPadding(&bufferPading);
-            logError(hr);
+            //! NOTE An exclusive stream takes a whole buffer on each event
+            if (!s_data->exclusive) {
+                hr = s_data->audioClient->GetCurrentPadding(&bufferPading);
+                logError(hr);
+            }
 
             auto bufferSize = bufferFrameCount - bufferPading;
             hr = s_data->renderClient->GetBuffer(bufferSize, &pData);
@@ -149,6 +223,10 @@ bool CoreAudioDriver::open(const IAudioDriver::Spec& spec, IAudioDriver::Spec* a
                 break;
             }
         } while (m_active);
+
+        if (mmcssHandle) {
+            AvRevertMmThreadCharacteristics(mmcssHandle);
+        }
     });
 
     hr = s_data->audioClient->Start();
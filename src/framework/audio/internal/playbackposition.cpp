@@ -0,0 +1,78 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "playbackposition.h"
+
+#include <chrono>
+#include <algorithm>
+
+using namespace mu::audio;
+
+//! NOTE If the audio thread stalls, the position does not run away further than this
+static constexpr int64_t MAX_EXTRAPOLATION_US = 200000;
+
+PlaybackPosition* PlaybackPosition::instance()
+{
+    static PlaybackPosition p;
+    return &p;
+}
+
+int64_t PlaybackPosition::now()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void PlaybackPosition::publish(float seconds, bool isPlaying)
+{
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_seconds.store(seconds, std::memory_order_relaxed);
+    m_isPlaying.store(isPlaying, std::memory_order_relaxed);
+    m_publishedAt.store(now(), std::memory_order_relaxed);
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+float PlaybackPosition::seconds() const
+{
+    float seconds = 0.f;
+    bool isPlaying = false;
+    int64_t publishedAt = 0;
+
+    uint32_t before = 0;
+    uint32_t after = 0;
+    do {
+        before = m_sequence.load(std::memory_order_acquire);
+        seconds = m_seconds.load(std::memory_order_relaxed);
+        isPlaying = m_isPlaying.load(std::memory_order_relaxed);
+        publishedAt = m_publishedAt.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = m_sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    if (!isPlaying) {
+        return seconds;
+    }
+
+    int64_t elapsed = std::clamp<int64_t>(now() - publishedAt, 0, MAX_EXTRAPOLATION_US);
+    return seconds + elapsed / 1000000.f;
+}
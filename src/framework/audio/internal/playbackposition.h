@@ -0,0 +1,54 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_PLAYBACKPOSITION_H
+#define MU_AUDIO_PLAYBACKPOSITION_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace mu::audio {
+//! NOTE The play position written by the audio thread and read by the main thread without messages.
+//! A sequence lock: the writer makes the sequence odd while it writes, the reader retries
+//! if the sequence was odd or has changed while it read
+class PlaybackPosition
+{
+public:
+    static PlaybackPosition* instance();
+
+    //! NOTE Called by the audio thread only
+    void publish(float seconds, bool isPlaying);
+
+    //! NOTE While playing, the position goes on from the published one by the time passed since,
+    //! so it moves smoothly between the blocks
+    float seconds() const;
+
+private:
+    PlaybackPosition() = default;
+
+    static int64_t now();
+
+    std::atomic<uint32_t> m_sequence = { 0 };
+    std::atomic<float> m_seconds = { 0.f };
+    std::atomic<bool> m_isPlaying = { false };
+    std::atomic<int64_t> m_publishedAt = { 0 }; // microseconds
+};
+}
+
+#endif // MU_AUDIO_PLAYBACKPOSITION_H
@@ -0,0 +1,133 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "ringaudiobuffer.h"
+#include <cstring>
+#include <algorithm>
+#include "log.h"
+
+using namespace mu::audio;
+
+static std::size_t nextPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+RingAudioBuffer::RingAudioBuffer(unsigned int streamsPerSample, unsigned int size)
+    : m_streamsPerSample(streamsPerSample)
+{
+    std::size_t capacity = nextPowerOfTwo(static_cast<std::size_t>(size) * m_streamsPerSample);
+    m_data.resize(capacity, 0.f);
+    m_mask = capacity - 1;
+}
+
+void RingAudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
+{
+    m_source = source;
+}
+
+void RingAudioBuffer::forward()
+{
+    fillup();
+}
+
+void RingAudioBuffer::push(const float* source, int sampleCount)
+{
+    const std::size_t write = m_writeIndex.load(std::memory_order_relaxed);
+    const std::size_t read = m_readIndex.load(std::memory_order_acquire);
+
+    std::size_t count = static_cast<std::size_t>(sampleCount) * m_streamsPerSample;
+    std::size_t freeSpace = m_data.size() - (write - read);
+    if (count > freeSpace) {
+        //! NOTE The consumer is too far behind, drop what doesn't fit instead of overwriting unread data
+        count = freeSpace;
+    }
+
+    std::size_t from = write & m_mask;
+    std::size_t first = std::min(count, m_data.size() - from);
+    std::memcpy(m_data.data() + from, source, first * sizeof(float));
+    if (count > first) {
+        std::memcpy(m_data.data(), source + first, (count - first) * sizeof(float));
+    }
+
+    m_writeIndex.store(write + count, std::memory_order_release);
+}
+
+void RingAudioBuffer::pop(float* dest, unsigned int sampleCount)
+{
+    const std::size_t read = m_readIndex.load(std::memory_order_relaxed);
+    const std::size_t write = m_writeIndex.load(std::memory_order_acquire);
+
+    std::size_t required = static_cast<std::size_t>(sampleCount) * m_streamsPerSample;
+    std::size_t available = write - read;
+    std::size_t count = std::min(required, available);
+
+    std::size_t from = read & m_mask;
+    std::size_t first = std::min(count, m_data.size() - from);
+    std::memcpy(dest, m_data.data() + from, first * sizeof(float));
+    if (count > first) {
+        std::memcpy(dest + first, m_data.data(), (count - first) * sizeof(float));
+    }
+
+    //! NOTE The worker didn't keep up, play silence instead of stale data
+    if (count < required) {
+        std::memset(dest + count, 0, (required - count) * sizeof(float));
+        m_dropoutCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_readIndex.store(read + count, std::memory_order_release);
+}
+
+void RingAudioBuffer::setMinSampleLag(unsigned int lag)
+{
+    //! NOTE The storage can't be resized here, the driver may be reading it right now
+    unsigned int maxLag = static_cast<unsigned int>(m_data.size() / m_streamsPerSample) - FILL_OVER - FILL_SAMPLES;
+    IF_ASSERT_FAILED(lag <= maxLag) {
+        lag = maxLag;
+    }
+    m_minSampleLag = lag;
+}
+
+uint64_t RingAudioBuffer::dropoutCount() const
+{
+    return m_dropoutCount.load(std::memory_order_relaxed);
+}
+
+void RingAudioBuffer::fillup()
+{
+    if (!m_source) {
+        return;
+    }
+
+    while (sampleLag() < m_minSampleLag + FILL_OVER) {
+        m_source->setBufferSize(FILL_SAMPLES);
+        m_source->forward(FILL_SAMPLES);
+        push(m_source->data(), FILL_SAMPLES);
+    }
+}
+
+unsigned int RingAudioBuffer::sampleLag() const
+{
+    const std::size_t write = m_writeIndex.load(std::memory_order_relaxed);
+    const std::size_t read = m_readIndex.load(std::memory_order_acquire);
+    return static_cast<unsigned int>((write - read) / m_streamsPerSample);
+}
@@ -0,0 +1,74 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_RINGAUDIOBUFFER_H
+#define MU_AUDIO_RINGAUDIOBUFFER_H
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "iaudiobuffer.h"
+
+namespace mu::audio {
+//! NOTE Wait-free single producer / single consumer buffer.
+//! The producer is the worker thread (forward, push, setMinSampleLag),
+//! the consumer is the driver thread (pop).
+//! The storage is allocated once, so nothing here allocates or locks on the hot path.
+class RingAudioBuffer : public IAudioBuffer
+{
+    static constexpr unsigned int DEFAULT_SIZE = 16384;
+    static constexpr unsigned int FILL_SAMPLES = 1024;
+    static constexpr unsigned int FILL_OVER    = 1024;
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+public:
+    RingAudioBuffer(unsigned int streamsPerSample = 2, unsigned int size = DEFAULT_SIZE);
+
+    void setSource(std::shared_ptr<IAudioSource> source) override;
+    void forward() override;
+
+    void push(const float* source, int sampleCount) override;
+    void pop(float* dest, unsigned int sampleCount) override;
+    void setMinSampleLag(unsigned int lag) override;
+
+    uint64_t dropoutCount() const override;
+
+private:
+
+    unsigned int sampleLag() const;
+    void fillup();
+
+    unsigned int m_streamsPerSample = 0;
+    std::size_t m_mask = 0;
+    std::vector<float> m_data;
+
+    // worker thread only
+    std::shared_ptr<IAudioSource> m_source = nullptr;
+    unsigned int m_minSampleLag = FILL_SAMPLES;
+
+    //! NOTE Indices are monotonic counters of floats, wrapped by m_mask on access.
+    //! Each one lives on its own cache line so the threads don't share a line.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_writeIndex = { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_readIndex = { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_dropoutCount = { 0 };
+};
+}
+
+#endif // MU_AUDIO_RINGAUDIOBUFFER_H
@@ -42,6 +42,9 @@ public:
 
     virtual ListenID listen(Handler h) = 0;
     virtual void unlisten(ListenID id) = 0;
+
+    //! NOTE For diagnostics
+    virtual ChannelStats stats() const = 0;
 };
 
 using IRpcChannelPtr = std::shared_ptr<IRpcChannel>;
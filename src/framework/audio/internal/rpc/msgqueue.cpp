@@ -0,0 +1,94 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "msgqueue.h"
+
+using namespace mu::audio::rpc;
+
+static size_t roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+MsgQueue::MsgQueue(size_t capacity)
+    : m_slots(roundUpToPowerOfTwo(capacity))
+{
+    m_mask = m_slots.size() - 1;
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool MsgQueue::tryPush(const Msg& msg)
+{
+    size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &m_slots[pos & m_mask];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->msg = msg;
+    slot->pushedAt = Clock::now();
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool MsgQueue::tryPop(Msg& msg, Clock::time_point& pushedAt)
+{
+    //! NOTE Single consumer, so no CAS is needed here
+    size_t pos = m_popPos.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & m_mask];
+    size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+        return false; // empty
+    }
+
+    msg = std::move(slot.msg);
+    slot.msg = Msg();
+    pushedAt = slot.pushedAt;
+    m_popPos.store(pos + 1, std::memory_order_relaxed);
+    slot.sequence.store(pos + m_slots.size(), std::memory_order_release);
+    return true;
+}
+
+size_t MsgQueue::capacity() const
+{
+    return m_slots.size();
+}
+
+size_t MsgQueue::size() const
+{
+    size_t push = m_pushPos.load(std::memory_order_relaxed);
+    size_t pop = m_popPos.load(std::memory_order_relaxed);
+    return push >= pop ? push - pop : 0;
+}
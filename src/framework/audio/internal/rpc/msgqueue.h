@@ -0,0 +1,67 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_MSGQUEUE_H
+#define MU_AUDIO_MSGQUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "rpctypes.h"
+
+namespace mu::audio::rpc {
+//! NOTE Bounded multi producer / single consumer queue of messages (Vyukov style).
+//! All slots are allocated in the constructor, push and pop do not allocate nodes
+//! and never block, push fails if the queue is full.
+class MsgQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit MsgQueue(size_t capacity = 1024);
+
+    MsgQueue(const MsgQueue&) = delete;
+    MsgQueue& operator=(const MsgQueue&) = delete;
+
+    bool tryPush(const Msg& msg);
+    bool tryPop(Msg& msg, Clock::time_point& pushedAt);
+
+    size_t capacity() const;
+    size_t size() const;
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence = { 0 };
+        Msg msg;
+        Clock::time_point pushedAt;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_pushPos = { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_popPos = { 0 };
+};
+}
+
+#endif // MU_AUDIO_MSGQUEUE_H
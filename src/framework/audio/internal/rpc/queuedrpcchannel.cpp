@@ -22,6 +22,11 @@
 
 using namespace mu::audio::rpc;
 
+QueuedRpcChannel::QueuedRpcChannel(Mode mode, size_t capacity)
+    : m_mode(mode), m_workerTh(capacity), m_mainTh(capacity)
+{
+}
+
 bool QueuedRpcChannel::isSerialized() const
 {
     return false;
@@ -30,14 +35,37 @@ bool QueuedRpcChannel::isSerialized() const
 void QueuedRpcChannel::send(const Msg& msg)
 {
     if (isWorkerThread()) {
-        std::lock_guard<std::mutex> lock(m_workerTh.mutex);
-        m_workerTh.queue.push(msg);
-
-        //! NOTE Calls the `process` method on the main thread
-        m_mainThreadInvoker->invoke([this]() { process(); });
+        push(m_workerTh, msg);
+        scheduleMainProcess();
     } else {
-        std::lock_guard<std::mutex> lock(m_mainTh.mutex);
-        m_mainTh.queue.push(msg);
+        push(m_mainTh, msg);
+    }
+}
+
+void QueuedRpcChannel::push(RpcData& to, const Msg& msg)
+{
+    if (m_mode == Mode::LockFree) {
+        //! NOTE While there are overflowed messages, new ones go after them to keep the order
+        if (!to.overflowed.load(std::memory_order_acquire) && to.lockFreeQueue.tryPush(msg)) {
+            return;
+        }
+        to.counters.overflowed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(to.mutex);
+    to.queue.push(msg);
+    to.lockedSize.store(to.queue.size(), std::memory_order_relaxed);
+    to.overflowed.store(true, std::memory_order_release);
+}
+
+void QueuedRpcChannel::scheduleMainProcess()
+{
+    //! NOTE Calls the `process` method on the main thread, one pending call is enough
+    if (!m_mainProcessScheduled.exchange(true, std::memory_order_acq_rel)) {
+        m_mainThreadInvoker->invoke([this]() {
+            m_mainProcessScheduled.store(false, std::memory_order_release);
+            process();
+        });
     }
 }
 
@@ -67,6 +95,27 @@ void QueuedRpcChannel::unlisten(ListenID id)
     }
 }
 
+ChannelStats QueuedRpcChannel::stats() const
+{
+    ChannelStats st;
+    st.toWorker = queueStats(m_mainTh);
+    st.toMain = queueStats(m_workerTh);
+    return st;
+}
+
+QueueStats QueuedRpcChannel::queueStats(const RpcData& data) const
+{
+    QueueStats st;
+    st.depth = data.lockFreeQueue.size() + data.lockedSize.load(std::memory_order_relaxed);
+    st.maxDepth = data.counters.maxDepth.load(std::memory_order_relaxed);
+    st.processed = data.counters.processed.load(std::memory_order_relaxed);
+    st.overflowed = data.counters.overflowed.load(std::memory_order_relaxed);
+    st.lastLatencyUs = data.counters.lastLatencyUs.load(std::memory_order_relaxed);
+    st.maxLatencyUs = data.counters.maxLatencyUs.load(std::memory_order_relaxed);
+    st.avgLatencyUs = st.processed > 0 ? data.counters.totalLatencyUs.load(std::memory_order_relaxed) / st.processed : 0;
+    return st;
+}
+
 bool QueuedRpcChannel::isWorkerThread() const
 {
     return std::this_thread::get_id() == m_streamThreadID;
@@ -82,32 +131,73 @@ void QueuedRpcChannel::setupMainThread()
     m_mainThreadInvoker = std::make_shared<framework::Invoker>();
 }
 
+void QueuedRpcChannel::setMaxBatch(size_t maxBatch)
+{
+    m_maxBatch = maxBatch;
+}
+
 void QueuedRpcChannel::process()
 {
     if (isWorkerThread()) {
         doProcess(m_mainTh, m_workerTh);
     } else {
-        doProcess(m_workerTh, m_mainTh);
+        size_t left = doProcess(m_workerTh, m_mainTh);
+        if (left > 0) {
+            scheduleMainProcess();
+        }
     }
 }
 
-void QueuedRpcChannel::doProcess(RpcData& from, RpcData& to)
+void QueuedRpcChannel::dispatch(RpcData& from, RpcData& to, const Msg& msg, MsgQueue::Clock::time_point pushedAt)
 {
-    MQ fromMQ;
-    {
-        std::lock_guard<std::mutex> lock(from.mutex);
-        fromMQ.swap(from.queue);
+    using namespace std::chrono;
+    uint64_t latency = duration_cast<microseconds>(MsgQueue::Clock::now() - pushedAt).count();
+    Counters& c = from.counters;
+    c.lastLatencyUs.store(latency, std::memory_order_relaxed);
+    c.totalLatencyUs.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > c.maxLatencyUs.load(std::memory_order_relaxed)) {
+        c.maxLatencyUs.store(latency, std::memory_order_relaxed);
     }
+    c.processed.fetch_add(1, std::memory_order_relaxed);
 
-    if (fromMQ.empty()) {
-        return;
+    for (auto it = to.listens.begin(); it != to.listens.end(); ++it) {
+        it->second(msg);
     }
+}
 
-    while (!fromMQ.empty()) {
-        const Msg& m = fromMQ.front();
-        for (auto it = to.listens.begin(); it != to.listens.end(); ++it) {
-            it->second(m);
+size_t QueuedRpcChannel::doProcess(RpcData& from, RpcData& to)
+{
+    size_t depth = from.lockFreeQueue.size() + from.lockedSize.load(std::memory_order_relaxed);
+    if (depth > from.counters.maxDepth.load(std::memory_order_relaxed)) {
+        from.counters.maxDepth.store(depth, std::memory_order_relaxed);
+    }
+
+    size_t count = 0;
+    Msg m;
+    MsgQueue::Clock::time_point pushedAt;
+    while (count < m_maxBatch && from.lockFreeQueue.tryPop(m, pushedAt)) {
+        dispatch(from, to, m, pushedAt);
+        ++count;
+    }
+
+    if (count < m_maxBatch && from.overflowed.load(std::memory_order_acquire)) {
+        //! NOTE Only when the bounded queue is drained, so the order is kept
+        MQ fromMQ;
+        {
+            std::lock_guard<std::mutex> lock(from.mutex);
+            fromMQ.swap(from.queue);
+            from.lockedSize.store(0, std::memory_order_relaxed);
+            from.overflowed.store(false, std::memory_order_release);
+        }
+
+        //! NOTE Overflowed messages are not timestamped, they are handled all at once
+        pushedAt = MsgQueue::Clock::now();
+        while (!fromMQ.empty()) {
+            dispatch(from, to, fromMQ.front(), pushedAt);
+            fromMQ.pop();
+            ++count;
         }
-        fromMQ.pop();
     }
+
+    return from.lockFreeQueue.size() + from.lockedSize.load(std::memory_order_relaxed);
 }
@@ -23,15 +23,25 @@
 #include <mutex>
 #include <queue>
 #include <memory>
+#include <atomic>
 
 #include "irpcchannel.h"
+#include "msgqueue.h"
 #include "invoker.h"
 
 namespace mu::audio::rpc {
 class QueuedRpcChannel : public IRpcChannel
 {
 public:
-    QueuedRpcChannel() = default;
+    enum class Mode {
+        Locked,     // std::queue under a mutex
+        LockFree    // bounded MPSC queue, falls back to the locked queue only when full
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    static constexpr size_t DEFAULT_MAX_BATCH = 256;
+
+    explicit QueuedRpcChannel(Mode mode = Mode::LockFree, size_t capacity = DEFAULT_CAPACITY);
 
     bool isSerialized() const override;
 
@@ -39,26 +49,53 @@ public:
     ListenID listen(Handler h) override;
     void unlisten(ListenID id) override;
 
+    ChannelStats stats() const override;
+
     bool isWorkerThread() const;
     void setupWorkerThread(); //! NOTE Must called from worker thread
 
     void setupMainThread(); //! NOTE Must called from main thread
 
+    //! NOTE Handles up to maxBatch messages per call, the others wait for the next call
     void process();
+    void setMaxBatch(size_t maxBatch);
 
 private:
 
     using MQ = std::queue<Msg>;
 
+    struct Counters {
+        std::atomic<size_t> maxDepth = { 0 };
+        std::atomic<uint64_t> processed = { 0 };
+        std::atomic<uint64_t> overflowed = { 0 };
+        std::atomic<uint64_t> lastLatencyUs = { 0 };
+        std::atomic<uint64_t> maxLatencyUs = { 0 };
+        std::atomic<uint64_t> totalLatencyUs = { 0 };
+    };
+
     struct RpcData {
+        explicit RpcData(size_t capacity)
+            : lockFreeQueue(capacity) {}
+
         std::mutex mutex;
         MQ queue;
+        MsgQueue lockFreeQueue;
+        std::atomic<bool> overflowed = { false };
+        std::atomic<size_t> lockedSize = { 0 };
         ListenID lastID = 0;
         std::map<ListenID, Handler> listens;
+        Counters counters;
     };
 
-    void doProcess(RpcData& from, RpcData& to);
+    void push(RpcData& to, const Msg& msg);
+    size_t doProcess(RpcData& from, RpcData& to);
+    void dispatch(RpcData& from, RpcData& to, const Msg& msg, MsgQueue::Clock::time_point pushedAt);
+    void scheduleMainProcess();
+    QueueStats queueStats(const RpcData& data) const;
 
+    Mode m_mode = Mode::LockFree;
+    size_t m_maxBatch = DEFAULT_MAX_BATCH;
+    std::atomic<bool> m_mainProcessScheduled = { false };
     std::shared_ptr<framework::Invoker> m_mainThreadInvoker;
     std::thread::id m_streamThreadID;
     RpcData m_workerTh;
@@ -21,6 +21,7 @@
 #include "internal/worker/sinesource.h"
 #include "internal/worker/noisesource.h"
 #include "internal/worker/equaliser.h"
+#include "internal/worker/audiobenchmark.h"
 
 using namespace mu::audio;
 using namespace mu::audio::rpc;
@@ -132,4 +133,16 @@ void RpcDevToolsController::doBind()
             }
         }
     });
+
+    // Benchmark
+
+    bindMethod("runBenchmark", [this](const Args& args) {
+        AudioBenchmark::Options options;
+        options.sampleRate = args.arg<unsigned int>(0, options.sampleRate);
+        options.bufferSize = args.arg<unsigned int>(1, options.bufferSize);
+
+        AudioBenchmark benchmark(audioEngine());
+        AudioBenchmark::Result result = benchmark.run(options);
+        sendToMain(Msg(TargetName::DevTools, "benchmarkFinished", Args::make_arg1<std::string>(result.toString())));
+    });
 }
@@ -19,6 +19,7 @@
 #include "rpcsequencer.h"
 
 #include "log.h"
+#include "internal/playbackposition.h"
 
 using namespace mu;
 using namespace mu::audio;
@@ -155,6 +156,16 @@ void RpcSequencer::unsetLoop()
     rpcChannel()->send(Msg(m_target, "unsetLoop"));
 }
 
+void RpcSequencer::setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen)
+{
+    rpcChannel()->send(Msg(m_target, "setIsTrackFrozen", Args::make_arg3<TrackID, midi::track_t, bool>(id, trackIndex, frozen)));
+}
+
+void RpcSequencer::setIsMetronomeEnabled(TrackID id, bool enabled)
+{
+    rpcChannel()->send(Msg(m_target, "setIsMetronomeEnabled", Args::make_arg2<TrackID, bool>(id, enabled)));
+}
+
 async::Channel<mu::midi::tick_t> RpcSequencer::midiTickPlayed(TrackID id) const
 {
     auto found = m_midiTickPlayed.find(id);
@@ -174,6 +185,10 @@ async::Notification RpcSequencer::positionChanged() const
 
 float RpcSequencer::playbackPositionInSeconds() const
 {
+    if (!rpcChannel()->isSerialized()) {
+        return PlaybackPosition::instance()->seconds();
+    }
+
     return m_playbackPositionInSeconds;
 }
 
@@ -49,6 +49,8 @@ public:
     void rewind() override;
     void setLoop(uint64_t fromMilliseconds, uint64_t toMilliseconds) override;
     void unsetLoop() override;
+    void setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen) override;
+    void setIsMetronomeEnabled(TrackID id, bool enabled) override;
 
     float playbackPositionInSeconds() const override;
     async::Notification positionChanged() const override;
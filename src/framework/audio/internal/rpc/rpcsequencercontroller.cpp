@@ -18,6 +18,8 @@
 //=============================================================================
 #include "rpcsequencercontroller.h"
 
+#include <cmath>
+
 #include "log.h"
 #include "internal/worker/audioengine.h"
 
@@ -25,6 +27,7 @@ using namespace mu::audio;
 using namespace mu::audio::rpc;
 
 static Target rpcSeqTarget = Target(TargetName::Sequencer);
+static constexpr float POSITION_NOTIFY_INTERVAL = 0.1f; // seconds
 
 TargetName RpcSequencerController::target() const
 {
@@ -90,6 +93,14 @@ void RpcSequencerController::doBind()
         sequencer()->unsetLoop();
     });
 
+    bindMethod("setIsTrackFrozen", [this](const Args& args) {
+        sequencer()->setIsTrackFrozen(args.arg<ISequencer::TrackID>(0), args.arg<midi::track_t>(1), args.arg<bool>(2));
+    });
+
+    bindMethod("setIsMetronomeEnabled", [this](const Args& args) {
+        sequencer()->setIsMetronomeEnabled(args.arg<ISequencer::TrackID>(0), args.arg<bool>(1));
+    });
+
     bindMethod("instantlyPlayMidi", [this](const Args& args) {
         if (isSerialized()) {
             NOT_IMPLEMENTED;
@@ -119,6 +130,15 @@ void RpcSequencerController::doBind()
 
     sequencer()->positionChanged().onNotify(this, [this]() {
         float pos = sequencer()->playbackPositionInSeconds();
+
+        //! NOTE Without serialization the main thread reads the position from PlaybackPosition itself,
+        //! while playing the notification is only needed for the views, which are updated less often
+        if (!isSerialized() && sequencer()->status() == ISequencer::PLAYING
+            && std::abs(pos - m_lastSentPosition) < POSITION_NOTIFY_INTERVAL) {
+            return;
+        }
+
+        m_lastSentPosition = pos;
         sendToMain(Msg(rpcSeqTarget, "positionChanged", Args::make_arg1<float>(pos)));
     });
 }
@@ -33,6 +33,9 @@ protected:
     void doBind() override;
 
     ISequencerPtr sequencer() const;
+
+private:
+    float m_lastSentPosition = -1.f;
 };
 }
 
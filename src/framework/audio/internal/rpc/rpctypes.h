@@ -22,6 +22,8 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 namespace mu::audio::rpc {
 enum class TargetName {
@@ -71,6 +73,16 @@ public:
         return d;
     }
 
+    template<typename T1, typename T2, typename T3>
+    static Args make_arg3(const T1& val1, const T2& val2, const T3& val3)
+    {
+        Args d;
+        d.setArg<T1>(0, val1);
+        d.setArg<T2>(1, val2);
+        d.setArg<T3>(2, val3);
+        return d;
+    }
+
     template<typename T>
     void setArg(int i, const T& val)
     {
@@ -141,6 +153,21 @@ struct Msg {
     Msg(const Target& t, const Method& m, const Args& a)
         : target(t), method(m), args(a) {}
 };
+
+struct QueueStats {
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    uint64_t processed = 0;
+    uint64_t overflowed = 0;  // pushed while the bounded queue was full
+    uint64_t lastLatencyUs = 0;
+    uint64_t maxLatencyUs = 0;
+    uint64_t avgLatencyUs = 0;
+};
+
+struct ChannelStats {
+    QueueStats toWorker;
+    QueueStats toMain;
+};
 }
 
 #endif // MU_AUDIO_RPCTYPES_H
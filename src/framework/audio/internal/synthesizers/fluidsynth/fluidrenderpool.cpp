@@ -0,0 +1,101 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "fluidrenderpool.h"
+
+#include <algorithm>
+
+#include "runtime.h"
+
+using namespace mu::audio::synth;
+
+FluidRenderPool::~FluidRenderPool()
+{
+    setThreadCount(1);
+}
+
+void FluidRenderPool::setThreadCount(unsigned int count)
+{
+    count = std::max(1u, count);
+    if (count == threadCount()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_started.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+
+    m_workers.clear();
+    m_quit = false;
+
+    for (size_t i = 1; i < count; ++i) {
+        m_workers.emplace_back(&FluidRenderPool::workerLoop, this, i, m_generation);
+    }
+}
+
+unsigned int FluidRenderPool::threadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size()) + 1;
+}
+
+void FluidRenderPool::workerLoop(size_t index, unsigned int generation)
+{
+    mu::runtime::setThreadName("audio_fluid_" + std::to_string(index));
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started.wait(lock, [this, generation]() { return m_quit || m_generation != generation; });
+            if (m_quit) {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        m_job(m_context, index);
+        m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void FluidRenderPool::run(Job job, void* context)
+{
+    if (m_workers.empty()) {
+        job(context, 0);
+        return;
+    }
+
+    m_job = job;
+    m_context = context;
+    m_pending.store(static_cast<int>(m_workers.size()), std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_started.notify_all();
+
+    job(context, 0);
+
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
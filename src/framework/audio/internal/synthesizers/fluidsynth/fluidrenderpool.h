@@ -0,0 +1,60 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_FLUIDRENDERPOOL_H
+#define MU_AUDIO_FLUIDRENDERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio::synth {
+//! NOTE Runs a job for the indexes 0 .. threadCount() - 1 at once, the index 0 on the calling thread
+//! and each other index on its own worker. run() returns when all of them are done
+class FluidRenderPool
+{
+public:
+    using Job = void (*)(void* context, size_t index);
+
+    FluidRenderPool() = default;
+    ~FluidRenderPool();
+
+    //! count includes the calling thread
+    void setThreadCount(unsigned int count);
+    unsigned int threadCount() const;
+
+    void run(Job job, void* context);
+
+private:
+    void workerLoop(size_t index, unsigned int generation);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_started;
+    unsigned int m_generation = 0;
+    bool m_quit = false;
+    std::atomic<int> m_pending { 0 };
+
+    Job m_job = nullptr;
+    void* m_context = nullptr;
+};
+}
+
+#endif // MU_AUDIO_FLUIDRENDERPOOL_H
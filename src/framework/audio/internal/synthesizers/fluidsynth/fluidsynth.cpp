@@ -35,15 +35,35 @@ using namespace mu;
 using namespace mu::midi;
 using namespace mu::audio::synth;
 
+//! NOTE With several instances each renders its share of the MIDI channels,
+//! the sample data of the sound fonts is shared between them by the fluid sample cache
 struct mu::audio::synth::Fluid {
     fluid_settings_t* settings = nullptr;
-    fluid_synth_t* synth = nullptr;
+    std::vector<fluid_synth_t*> synths;
 
     ~Fluid()
     {
-        delete_fluid_synth(synth);
+        for (fluid_synth_t* synth : synths) {
+            delete_fluid_synth(synth);
+        }
         delete_fluid_settings(settings);
     }
+
+    bool isInited() const
+    {
+        return !synths.empty();
+    }
+
+    fluid_synth_t* synth(channel_t chan) const
+    {
+        return synths[chan % synths.size()];
+    }
+};
+
+struct mu::audio::synth::FluidSynth::RenderJob {
+    FluidSynth* self = nullptr;
+    float* stream = nullptr;
+    unsigned int samples = 0;
 };
 
 FluidSynth::FluidSynth()
@@ -105,6 +125,13 @@ Ret FluidSynth::init()
     fluid_settings_setnum(m_fluid->settings, "synth.sample-rate", static_cast<double>(m_sampleRate));
     fluid_settings_setint(m_fluid->settings, "synth.midi-channels", 80);
 
+    unsigned int instances = configuration() ? configuration()->fluidRenderThreads() : 1;
+
+    //! NOTE The samples of a preset are loaded when a channel selects it, and shared between the synths.
+    //! The instances render at once, and unloading a sample no voice uses any more touches the sample
+    //! cache they share, so they keep all samples loaded instead
+    fluid_settings_setint(m_fluid->settings, "synth.dynamic-sample-loading", instances > 1 ? 0 : 1);
+
     //fluid_settings_setint(_fluid->settings, "synth.min-note-length", 50);
     //fluid_settings_setint(_fluid->settings, "synth.polyphony", conf.polyphony);
 
@@ -132,9 +159,14 @@ Ret FluidSynth::init()
 
     fluid_settings_setstr(m_fluid->settings, "audio.sample-format", "float");
 
-    m_fluid->synth = new_fluid_synth(m_fluid->settings);
+    for (unsigned int i = 0; i < instances; ++i) {
+        m_fluid->synths.push_back(new_fluid_synth(m_fluid->settings));
+    }
+    m_shardBuffers.resize(instances - 1);
+    m_renderPool.setThreadCount(instances);
+    applyRenderBudget();
 
-    LOGD() << "synth inited\n";
+    LOGD() << "synth inited, instances: " << instances;
     return true;
 }
 
@@ -149,16 +181,26 @@ void FluidSynth::setSampleRate(unsigned int sampleRate)
 
 Ret FluidSynth::addSoundFonts(const std::vector<io::path>& sfonts)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return make_ret(Err::SynthNotInited);
     }
 
     bool ok = true;
     for (const io::path& sfont : sfonts) {
         SoundFont sf;
-        sf.id = fluid_synth_sfload(m_fluid->synth, sfont.c_str(), 0);
-        if (sf.id == FLUID_FAILED) {
+        for (fluid_synth_t* synth : m_fluid->synths) {
+            int id = fluid_synth_sfload(synth, sfont.c_str(), 0);
+            if (id == FLUID_FAILED) {
+                break;
+            }
+            sf.ids.push_back(id);
+        }
+
+        if (sf.ids.size() != m_fluid->synths.size()) {
             LOGE() << "failed load soundfont: " << sfont;
+            for (size_t i = 0; i < sf.ids.size(); ++i) {
+                fluid_synth_sfunload(m_fluid->synths[i], sf.ids[i], true);
+            }
             ok = false;
             continue;
         }
@@ -174,7 +216,7 @@ Ret FluidSynth::addSoundFonts(const std::vector<io::path>& sfonts)
 
 Ret FluidSynth::removeSoundFonts()
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return make_ret(Err::SynthNotInited);
     }
 
@@ -184,10 +226,12 @@ Ret FluidSynth::removeSoundFonts()
 
     bool ok = true;
     for (const SoundFont& sf : m_soundFonts) {
-        int ret = fluid_synth_sfunload(m_fluid->synth, sf.id, true);
-        if (ret == FLUID_FAILED) {
-            LOGE() << "failed remove soundfont id: " << sf.id << ", path: " << sf.path;
-            ok = false;
+        for (size_t i = 0; i < sf.ids.size(); ++i) {
+            int ret = fluid_synth_sfunload(m_fluid->synths[i], sf.ids[i], true);
+            if (ret == FLUID_FAILED) {
+                LOGE() << "failed remove soundfont id: " << sf.ids[i] << ", path: " << sf.path;
+                ok = false;
+            }
         }
     }
 
@@ -198,7 +242,7 @@ Ret FluidSynth::removeSoundFonts()
 
 Ret FluidSynth::setupChannels(const std::vector<Event>& events)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return make_ret(Err::SynthNotInited);
     }
 
@@ -207,8 +251,10 @@ Ret FluidSynth::setupChannels(const std::vector<Event>& events)
         return make_ret(Err::SoundFontNotLoaded);
     }
 
-    fluid_synth_program_reset(m_fluid->synth);
-    fluid_synth_system_reset(m_fluid->synth);
+    for (fluid_synth_t* synth : m_fluid->synths) {
+        fluid_synth_program_reset(synth);
+        fluid_synth_system_reset(synth);
+    }
 
     std::set<channel_t> channels;
     for (const Event& e: events) {
@@ -216,8 +262,8 @@ Ret FluidSynth::setupChannels(const std::vector<Event>& events)
     }
 
     for (channel_t ch : channels) {
-        fluid_synth_set_interp_method(m_fluid->synth, ch, FLUID_INTERP_DEFAULT);
-        fluid_synth_pitch_wheel_sens(m_fluid->synth, ch, 12);
+        fluid_synth_set_interp_method(m_fluid->synth(ch), ch, interpolationMethod());
+        fluid_synth_pitch_wheel_sens(m_fluid->synth(ch), ch, 12);
     }
 
     for (const Event& e: events) {
@@ -242,26 +288,27 @@ bool FluidSynth::handleEvent(const Event& e)
         LOGD() << e.to_string();
     }
 
+    fluid_synth_t* synth = m_fluid->synth(e.channel());
     int ret = FLUID_OK;
     switch (e.type()) {
     case EventType::ME_NOTEON: {
-        ret = fluid_synth_noteon(m_fluid->synth, e.channel(), e.note(), e.velocity());
+        ret = fluid_synth_noteon(synth, e.channel(), e.note(), e.velocity());
     } break;
     case EventType::ME_NOTEOFF: {
-        ret = fluid_synth_noteoff(m_fluid->synth, e.channel(), e.note());
+        ret = fluid_synth_noteoff(synth, e.channel(), e.note());
     } break;
     case EventType::ME_CONTROLLER: {
         if (e.index() == CntrType::CTRL_PROGRAM) {
-            ret = fluid_synth_program_change(m_fluid->synth, e.channel(), e.data());
+            ret = fluid_synth_program_change(synth, e.channel(), e.data());
         } else {
-            ret = fluid_synth_cc(m_fluid->synth, e.channel(), e.index(), e.data());
+            ret = fluid_synth_cc(synth, e.channel(), e.index(), e.data());
         }
     } break;
     case EventType::ME_PROGRAM: {
-        fluid_synth_program_change(m_fluid->synth, e.channel(), e.program());
+        fluid_synth_program_change(synth, e.channel(), e.program());
     } break;
     case EventType::ME_PITCHBEND: {
-        ret = fluid_synth_pitch_bend(m_fluid->synth, e.channel(), e.data());
+        ret = fluid_synth_pitch_bend(synth, e.channel(), e.data());
     } break;
     default: {
         LOGW() << "not supported event type: " << static_cast<int>(e.type());
@@ -274,53 +321,57 @@ bool FluidSynth::handleEvent(const Event& e)
 
 void FluidSynth::allSoundsOff()
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return;
     }
 
-    fluid_synth_all_notes_off(m_fluid->synth, -1);
-    fluid_synth_all_sounds_off(m_fluid->synth, -1);
+    for (fluid_synth_t* synth : m_fluid->synths) {
+        fluid_synth_all_notes_off(synth, -1);
+        fluid_synth_all_sounds_off(synth, -1);
+    }
 }
 
 void FluidSynth::flushSound()
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return;
     }
 
-    fluid_synth_all_notes_off(m_fluid->synth, -1);
-    fluid_synth_all_sounds_off(m_fluid->synth, -1);
-
     int size = int(m_sampleRate);
 
-    fluid_synth_write_float(m_fluid->synth, size, &m_preallocated[0], 0, 1, &m_preallocated[0], size, 1);
+    for (fluid_synth_t* synth : m_fluid->synths) {
+        fluid_synth_all_notes_off(synth, -1);
+        fluid_synth_all_sounds_off(synth, -1);
+
+        fluid_synth_write_float(synth, size, &m_preallocated[0], 0, 1, &m_preallocated[0], size, 1);
+    }
 }
 
 void FluidSynth::channelSoundsOff(channel_t chan)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return;
     }
 
-    fluid_synth_all_sounds_off(m_fluid->synth, chan);
+    fluid_synth_all_sounds_off(m_fluid->synth(chan), chan);
 }
 
 bool FluidSynth::channelVolume(channel_t chan, float volume)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return false;
     }
 
     int val = static_cast<int>(volume * 100.f);
     val = std::clamp(val, 0, 127);
 
-    int ret = fluid_synth_cc(m_fluid->synth, chan, VOLUME_MSB, val);
+    int ret = fluid_synth_cc(m_fluid->synth(chan), chan, VOLUME_MSB, val);
     return ret == FLUID_OK;
 }
 
 bool FluidSynth::channelBalance(channel_t chan, float balance)
 {
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return false;
     }
 
@@ -329,7 +380,7 @@ bool FluidSynth::channelBalance(channel_t chan, float balance)
     int val = static_cast<int>(std::lround(normalized));
     val = std::clamp(val, 0, 127);
 
-    int ret = fluid_synth_cc(m_fluid->synth, chan, PAN_MSB, val);
+    int ret = fluid_synth_cc(m_fluid->synth(chan), chan, PAN_MSB, val);
     return ret == FLUID_OK;
 }
 
@@ -337,7 +388,7 @@ bool FluidSynth::channelPitch(channel_t chan, int16_t pitch)
 {
     // 0-16383 with 8192 being center
 
-    IF_ASSERT_FAILED(m_fluid->synth) {
+    IF_ASSERT_FAILED(m_fluid->isInited()) {
         return false;
     }
 
@@ -347,10 +398,45 @@ bool FluidSynth::channelPitch(channel_t chan, int16_t pitch)
     val = 8192 + val;
     val = std::clamp(val, 0, 16383);
 
-    int ret = fluid_synth_pitch_bend(m_fluid->synth, chan, val);
+    int ret = fluid_synth_pitch_bend(m_fluid->synth(chan), chan, val);
     return ret == FLUID_OK;
 }
 
+void FluidSynth::setRenderBudget(const RenderBudget& budget)
+{
+    if (m_renderBudget == budget) {
+        return;
+    }
+
+    m_renderBudget = budget;
+    applyRenderBudget();
+}
+
+int FluidSynth::interpolationMethod() const
+{
+    return m_renderBudget.fastInterpolation ? FLUID_INTERP_LINEAR : FLUID_INTERP_DEFAULT;
+}
+
+void FluidSynth::applyRenderBudget()
+{
+    if (!m_fluid->isInited()) {
+        return;
+    }
+
+    //! NOTE When the polyphony is lowered, fluid stops the voices over it and steals
+    //! the quietest released voices for the new notes
+    int polyphony = 0;
+    fluid_settings_getint(m_fluid->settings, "synth.polyphony", &polyphony);
+    if (m_renderBudget.maxVoices > 0) {
+        polyphony = std::max(1, static_cast<int>(m_renderBudget.maxVoices / m_fluid->synths.size()));
+    }
+
+    for (fluid_synth_t* synth : m_fluid->synths) {
+        fluid_synth_set_polyphony(synth, polyphony);
+        fluid_synth_set_interp_method(synth, -1, interpolationMethod());
+    }
+}
+
 bool FluidSynth::isActive() const
 {
     return m_isActive;
@@ -367,7 +453,40 @@ void FluidSynth::writeBuf(float* stream, unsigned int samples)
         return;
     }
 
-    fluid_synth_write_float(m_fluid->synth, static_cast<int>(samples),
+    if (m_fluid->synths.size() == 1) {
+        fluid_synth_write_float(m_fluid->synths.front(), static_cast<int>(samples),
+                                stream, 0, AUDIO_CHANNELS,
+                                stream, 1, AUDIO_CHANNELS);
+        return;
+    }
+
+    for (std::vector<float>& buffer : m_shardBuffers) {
+        if (buffer.size() < samples * AUDIO_CHANNELS) {
+            buffer.resize(samples * AUDIO_CHANNELS);
+        }
+    }
+
+    RenderJob job;
+    job.self = this;
+    job.stream = stream;
+    job.samples = samples;
+    m_renderPool.run(&FluidSynth::renderShard, &job);
+
+    for (const std::vector<float>& buffer : m_shardBuffers) {
+        const float* shard = buffer.data();
+        for (unsigned int i = 0; i < samples * AUDIO_CHANNELS; ++i) {
+            stream[i] += shard[i];
+        }
+    }
+}
+
+void FluidSynth::renderShard(void* context, size_t index)
+{
+    const RenderJob* job = static_cast<const RenderJob*>(context);
+    FluidSynth* self = job->self;
+    float* stream = index == 0 ? job->stream : self->m_shardBuffers[index - 1].data();
+
+    fluid_synth_write_float(self->m_fluid->synths[index], static_cast<int>(job->samples),
                             stream, 0, AUDIO_CHANNELS,
                             stream, 1, AUDIO_CHANNELS);
 }
@@ -377,9 +496,26 @@ unsigned int FluidSynth::streamCount() const
     return synth::AUDIO_CHANNELS;
 }
 
+void FluidSynth::scheduleEvent(const Event& e, unsigned int sampleOffset)
+{
+    //! NOTE More events than a block can hold, this one sounds at the start of the block then
+    if (!m_scheduledEvents.add(e, sampleOffset)) {
+        handleEvent(e);
+    }
+}
+
 void FluidSynth::forward(unsigned int sampleCount)
 {
-    writeBuf(m_buffer.data(), sampleCount);
+    if (m_scheduledEvents.empty()) {
+        writeBuf(m_buffer.data(), sampleCount);
+        return;
+    }
+
+    m_scheduledEvents.forward(sampleCount, [this](unsigned int from, unsigned int samples) {
+        writeBuf(m_buffer.data() + from * AUDIO_CHANNELS, samples);
+    }, [this](const Event& e) {
+        handleEvent(e);
+    });
 }
 
 async::Channel<unsigned int> FluidSynth::streamsCountChanged() const
@@ -399,4 +535,10 @@ void FluidSynth::setBufferSize(unsigned int samples)
     if (targetSize > 0 && m_buffer.size() < targetSize) {
         m_buffer.resize(samples * streamCount());
     }
+
+    for (std::vector<float>& buffer : m_shardBuffers) {
+        if (buffer.size() < targetSize) {
+            buffer.resize(targetSize);
+        }
+    }
 }
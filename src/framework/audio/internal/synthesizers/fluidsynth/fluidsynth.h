@@ -26,11 +26,17 @@
 #include <functional>
 
 #include "isynthesizer.h"
+#include "modularity/ioc.h"
+#include "iaudioconfiguration.h"
+#include "internal/synthesizers/scheduledevents.h"
+#include "fluidrenderpool.h"
 
 namespace mu::audio::synth {
 struct Fluid;
 class FluidSynth : public ISynthesizer
 {
+    INJECT(audio, IAudioConfiguration, configuration)
+
 public:
     FluidSynth();
 
@@ -49,6 +55,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -58,6 +65,7 @@ public:
     bool channelVolume(midi::channel_t chan, float val) override;  // 0. - 1.
     bool channelBalance(midi::channel_t chan, float val) override; // -1. - 1.
     bool channelPitch(midi::channel_t chan, int16_t pitch) override; // -12 - 12
+    void setRenderBudget(const RenderBudget& budget) override;
 
     unsigned int streamCount() const override;
     void forward(unsigned int sampleCount) override;
@@ -76,10 +84,16 @@ private:
     };
 
     struct SoundFont {
-        int id = -1;
+        std::vector<int> ids; // of each instance
         io::path path;
     };
 
+    int interpolationMethod() const;
+    void applyRenderBudget();
+
+    struct RenderJob;
+    static void renderShard(void* context, size_t index);
+
     std::shared_ptr<Fluid> m_fluid = nullptr;
     std::vector<SoundFont> m_soundFonts;
 
@@ -87,9 +101,14 @@ private:
 
     std::vector<float> m_preallocated; // used to flush a sound
     bool m_isActive = false;
+    RenderBudget m_renderBudget;
 
     unsigned int m_sampleRate = 1;
     std::vector<float> m_buffer = {};
+    ScheduledEvents m_scheduledEvents;
+
+    FluidRenderPool m_renderPool;
+    std::vector<std::vector<float> > m_shardBuffers; // of the instances after the first one
     async::Channel<unsigned int> m_streamsCountChanged;
 };
 }
@@ -87,6 +87,12 @@ bool SanitySynthesizer::handleEvent(const midi::Event& e)
     return m_synth->handleEvent(e);
 }
 
+void SanitySynthesizer::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_synth->scheduleEvent(e, sampleOffset);
+}
+
 void SanitySynthesizer::writeBuf(float* stream, unsigned int samples)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -129,6 +135,12 @@ bool SanitySynthesizer::channelPitch(midi::channel_t chan, int16_t val)
     return m_synth->channelPitch(chan, val);
 }
 
+void SanitySynthesizer::setRenderBudget(const RenderBudget& budget)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_synth->setRenderBudget(budget);
+}
+
 // IAudioSource
 void SanitySynthesizer::setSampleRate(unsigned int sampleRate)
 {
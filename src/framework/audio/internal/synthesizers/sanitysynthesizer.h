@@ -41,6 +41,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override;  // all channels
@@ -49,6 +50,7 @@ public:
     bool channelVolume(midi::channel_t chan, float val) override;   // 0. - 1.
     bool channelBalance(midi::channel_t chan, float val) override;  // -1. - 1.
     bool channelPitch(midi::channel_t chan, int16_t val) override;  // -12 - 12
+    void setRenderBudget(const RenderBudget& budget) override;
 
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
@@ -0,0 +1,93 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_SCHEDULEDEVENTS_H
+#define MU_AUDIO_SCHEDULEDEVENTS_H
+
+#include <array>
+#include <algorithm>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio::synth {
+//! NOTE The events of the block to be forwarded next, with their sample offsets in it.
+//! The block is rendered in parts split at the offsets, so the events sound at their time
+//! and not at the buffer boundary
+class ScheduledEvents
+{
+public:
+    bool empty() const
+    {
+        return m_count == 0;
+    }
+
+    //! NOTE The storage has a fixed capacity, so nothing is allocated on the audio thread.
+    //! Returns false if the block is full, the event is not scheduled then
+    bool add(const midi::Event& e, unsigned int sampleOffset)
+    {
+        if (m_count == MAX_EVENTS) {
+            return false;
+        }
+
+        //! NOTE The events come in the order of their ticks, so the place is almost always at the end
+        size_t place = m_count;
+        while (place > 0 && m_events[place - 1].sampleOffset > sampleOffset) {
+            --place;
+        }
+        std::move_backward(m_events.begin() + place, m_events.begin() + m_count, m_events.begin() + m_count + 1);
+        m_events[place] = { e, sampleOffset };
+        ++m_count;
+        return true;
+    }
+
+    template<typename Render, typename Handle>
+    void forward(unsigned int sampleCount, Render render, Handle handle)
+    {
+        unsigned int rendered = 0;
+        for (size_t i = 0; i < m_count; ++i) {
+            const TimedEvent& te = m_events[i];
+            unsigned int offset = std::min(te.sampleOffset, sampleCount);
+            if (offset > rendered) {
+                render(rendered, offset - rendered);
+                rendered = offset;
+            }
+            handle(te.event);
+        }
+
+        if (rendered < sampleCount) {
+            render(rendered, sampleCount - rendered);
+        }
+
+        m_count = 0;
+    }
+
+private:
+    static constexpr size_t MAX_EVENTS = 1024;
+
+    struct TimedEvent {
+        midi::Event event;
+        unsigned int sampleOffset = 0;
+    };
+
+    std::array<TimedEvent, MAX_EVENTS> m_events;
+    size_t m_count = 0;
+};
+}
+
+#endif // MU_AUDIO_SCHEDULEDEVENTS_H
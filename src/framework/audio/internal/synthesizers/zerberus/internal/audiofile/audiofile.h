@@ -44,6 +44,7 @@ public:
     const char* error() const;
     sf_count_t readData(short* data, sf_count_t frames);
 
+    int format() const { return info.format; }
     int channels() const { return info.channels; }
     sf_count_t frames() const { return info.frames; }
     int samplerate() const { return info.samplerate; }
@@ -28,7 +28,7 @@
 using namespace mu::zerberus;
 
 static constexpr int INTERP_MAX = 256;
-static float interpCoeff[INTERP_MAX][4];
+alignas(16) static float interpCoeff[INTERP_MAX][4];
 
 //---------------------------------------------------------
 //   FilterBQ
@@ -273,6 +273,17 @@ float ZFilter::apply(float inputValue, bool leftChannel)
         }
     }
 
+    stepCoefficients();
+
+    return value;
+}
+
+//---------------------------------------------------------
+//   stepCoefficients
+//---------------------------------------------------------
+
+void ZFilter::stepCoefficients()
+{
     if (filter_coeff_incr_count) {
         --filter_coeff_incr_count;
         a1 += a1_incr;
@@ -281,8 +292,62 @@ float ZFilter::apply(float inputValue, bool leftChannel)
         b1 += b1_incr;
         b2 += b2_incr;
     }
+}
 
-    return value;
+//---------------------------------------------------------
+//   applyBlock
+//    same as apply() for every frame (left, then right),
+//    with the filter type resolved once per block
+//---------------------------------------------------------
+
+template<typename Equation>
+void ZFilter::applyBlock(float* left, float* right, int frames, const Equation& equation)
+{
+    for (int i = 0; i < frames; ++i) {
+        left[i] = equation(monoL, left[i]);
+        stepCoefficients();
+        if (right) {
+            right[i] = equation(monoR, right[i]);
+            stepCoefficients();
+        }
+    }
+}
+
+void ZFilter::applyBlock(float* left, float* right, int frames)
+{
+    switch (sampleZone->fil_type) {
+    case FilterType::hpf_2p:
+    case FilterType::lpf_2p:
+    case FilterType::bpf_2p:
+    case FilterType::brf_2p:
+        applyBlock(left, right, frames, [this](FilterData& d, float x) {
+            float y = b0 * x + b1 * d.histX1 + b2 * d.histX2 + a1 * d.histY1 + a2 * d.histY2;
+            d.histX2 = d.histX1;
+            d.histX1 = x;
+            d.histY2 = d.histY1;
+            d.histY1 = y;
+            return y;
+        });
+        break;
+    case FilterType::hpf_1p:
+        applyBlock(left, right, frames, [this](FilterData& d, float x) {
+            float y = b0 * x + b1 * d.histX1 - a1 * d.histY1;
+            d.histX1 = x;
+            d.histY1 = y;
+            return y;
+        });
+        break;
+    case FilterType::lpf_1p:
+        applyBlock(left, right, frames, [this](FilterData& d, float x) {
+            float y = b0 * x - a1 * d.histY1;
+            d.histY1 = y;
+            return y;
+        });
+        break;
+    default:
+        qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+        applyBlock(left, right, frames, [](FilterData&, float) { return 0.f; });
+    }
 }
 
 //---------------------------------------------------------
@@ -297,3 +362,12 @@ float ZFilter::interpolate(unsigned phase, short prevVal, short currVal, short n
            + interpValTable[2] * nextVal
            + interpValTable[3] * nextNextVal;
 }
+
+//---------------------------------------------------------
+//   interpolationTable
+//---------------------------------------------------------
+
+const float* ZFilter::interpolationTable()
+{
+    return &interpCoeff[0][0];
+}
@@ -31,9 +31,16 @@ public:
 
     void update();
     float apply(float inputValue, bool leftChannel);
+    void applyBlock(float* left, float* right, int frames);   // right is nullptr for mono samples
     float interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const;   //pure function
 
+    static const float* interpolationTable();   // 4 coefficients per phase fract
+
 private:
+    template<typename Equation>
+    void applyBlock(float* left, float* right, int frames, const Equation& equation);
+    void stepCoefficients();
+
     const Zerberus* zerberus;
     const Zone* sampleZone;
 
@@ -23,6 +23,7 @@
 #include "instrument.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestore.h"
 
 #include "framework/global/xmlreader.h"
 
@@ -34,8 +35,21 @@ int ZInstrument::idx;
 
 //---------------------------------------------------------
 //   Sample
+//    a paged sample, only the first frames are read now
 //---------------------------------------------------------
 
+Sample::Sample(std::shared_ptr<SampleFile> file)
+    : _channel(file->channels()), _frames(file->frames()), _sampleRate(file->sampleRate()),
+    _loopStart(file->loopStart()), _loopEnd(file->loopEnd()), _loopMode(file->loopMode()),
+    _file(file), _residentFrames(SampleStore::HEAD_FRAMES)
+{
+    _data = new short[(_residentFrames + 1) * _channel];
+    file->read(0, _residentFrames, _data + _channel);
+    for (int i = 0; i < _channel; ++i) {
+        _data[i] = _data[_channel + i];
+    }
+}
+
 Sample::~Sample()
 {
     delete[] _data;
@@ -56,6 +70,10 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
             return 0;
         }
     } else {
+        if (std::shared_ptr<SampleFile> file = SampleFile::map(s)) {
+            return new Sample(file);
+        }
+
         QFile f(s);
         if (!f.open(QIODevice::ReadOnly)) {
             printf("Sample::read: open <%s> failed\n", qPrintable(s));
@@ -13,9 +13,13 @@
 #ifndef MU_ZERBERUS_SAMPLE_H
 #define MU_ZERBERUS_SAMPLE_H
 
+#include <memory>
+
 #include <QString>
 
 namespace mu::zerberus {
+class SampleFile;
+
 //---------------------------------------------------------
 //   Sample
 //---------------------------------------------------------
@@ -30,9 +34,14 @@ class Sample
     long long _loopEnd   { 0 };
     int _loopMode     { 0 };
 
+    // paged samples keep the first frames in _data, the others are read from the file
+    std::shared_ptr<SampleFile> _file;
+    long long _residentFrames { 0 };
+
 public:
     Sample(int ch, short* val, int f, int sr)
-        : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+        : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _residentFrames(f) {}
+    Sample(std::shared_ptr<SampleFile> file);
     ~Sample();
     bool read(const QString&);
     long long frames() const { return _frames; }
@@ -40,6 +49,10 @@ public:
     int channel() const { return _channel; }
     int sampleRate() const { return _sampleRate; }
 
+    bool isPaged() const { return _file != nullptr; }
+    const SampleFile* file() const { return _file.get(); }
+    long long residentFrames() const { return _residentFrames; }
+
     void setLoopStart(int v) { _loopStart = v; }
     void setLoopEnd(int v) { _loopEnd = v; }
     void setLoopMode(int v) { _loopMode = v; }
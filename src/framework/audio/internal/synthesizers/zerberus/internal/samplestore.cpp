@@ -0,0 +1,222 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "samplestore.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include <QByteArray>
+
+#include "audiofile/audiofile.h"
+
+using namespace mu::zerberus;
+
+//---------------------------------------------------------
+//   readLE32
+//---------------------------------------------------------
+
+static quint32 readLE32(const uchar* p)
+{
+    return quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+}
+
+//---------------------------------------------------------
+//   map
+//---------------------------------------------------------
+
+std::shared_ptr<SampleFile> SampleFile::map(const QString& path)
+{
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+    // the mapped samples are used as they are in the file
+    Q_UNUSED(path);
+    return nullptr;
+#else
+    std::shared_ptr<SampleFile> sf = std::make_shared<SampleFile>();
+    sf->_file.setFileName(path);
+    if (!sf->_file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    const qint64 size = sf->_file.size();
+    if (size < 12 || size > INT_MAX) {
+        return nullptr;
+    }
+    const uchar* base = sf->_file.map(0, size);
+    if (!base || memcmp(base, "RIFF", 4) != 0 || memcmp(base + 8, "WAVE", 4) != 0) {
+        return nullptr;
+    }
+
+    AudioFile a;
+    if (!a.open(QByteArray::fromRawData(reinterpret_cast<const char*>(base), int(size)))) {
+        return nullptr;
+    }
+    if ((a.format() & SF_FORMAT_SUBMASK) != SF_FORMAT_PCM_16
+        || a.frames() <= SampleStore::HEAD_FRAMES + SampleStore::PAGE_FRAMES) {
+        return nullptr;
+    }
+
+    // find the data chunk, libsndfile does not tell where it is
+    qint64 pos = 12;
+    while (pos + 8 <= size) {
+        const qint64 chunkSize = readLE32(base + pos + 4);
+        if (memcmp(base + pos, "data", 4) == 0) {
+            const qint64 dataSize = std::min(chunkSize, size - pos - 8);
+            if (dataSize < a.frames() * a.channels() * qint64(sizeof(short))) {
+                return nullptr;
+            }
+            sf->_data = base + pos + 8;
+            break;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+    if (!sf->_data) {
+        return nullptr;
+    }
+
+    sf->_channels = a.channels();
+    sf->_frames = a.frames();
+    sf->_sampleRate = a.samplerate();
+    sf->_loopStart = a.loopStart();
+    sf->_loopEnd = a.loopEnd();
+    sf->_loopMode = a.loopMode();
+    return sf;
+#endif
+}
+
+SampleFile::~SampleFile()
+{
+    SampleStore::instance()->remove(this);
+}
+
+//---------------------------------------------------------
+//   read
+//    same data as ZInstrument::readSample puts into
+//    memory, including the patched last frames
+//---------------------------------------------------------
+
+void SampleFile::read(long long frame, long long frames, short* dest) const
+{
+    frames = std::min(frames, _frames - frame);
+    if (frames <= 0) {
+        return;
+    }
+    memcpy(dest, _data + frame * _channels * sizeof(short), frames * _channels * sizeof(short));
+
+    const short* patch = reinterpret_cast<const short*>(_data) + (_frames - 4) * _channels;
+    for (long long f = std::max(frame, _frames - 3); f < std::min(frame + frames, _frames - 1); ++f) {
+        memcpy(dest + (f - frame) * _channels, patch, _channels * sizeof(short));
+    }
+}
+
+//---------------------------------------------------------
+//   SampleStore
+//---------------------------------------------------------
+
+SampleStore* SampleStore::instance()
+{
+    static SampleStore store;
+    return &store;
+}
+
+//---------------------------------------------------------
+//   setCapacity
+//---------------------------------------------------------
+
+void SampleStore::setCapacity(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = bytes;
+    shrink();
+}
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+SampleStore::Stats SampleStore::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s = _stats;
+    s.residentBytes = _resident;
+    s.capacityBytes = _capacity;
+    return s;
+}
+
+//---------------------------------------------------------
+//   page
+//    the frames [index * PAGE_FRAMES, (index + 1) * PAGE_FRAMES)
+//    of file, read from the mapping on the first use
+//---------------------------------------------------------
+
+SampleStore::PagePtr SampleStore::page(const SampleFile* file, long long index)
+{
+    const Key key(file, index);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            ++_stats.hits;
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return it->second->page;
+        }
+    }
+
+    // read without the lock, the other voices go on meanwhile
+    const long long first = index * PAGE_FRAMES;
+    const long long frames = std::max(0ll, std::min(PAGE_FRAMES, file->frames() - first));
+    std::shared_ptr<Page> p = std::make_shared<Page>(frames * file->channels());
+    file->read(first, frames, p->data());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        ++_stats.hits;
+        return it->second->page;
+    }
+    ++_stats.faults;
+    _lru.push_front(Entry { key, p });
+    _entries[key] = _lru.begin();
+    _resident += p->size() * sizeof(short);
+    shrink();
+    return p;
+}
+
+//---------------------------------------------------------
+//   remove
+//---------------------------------------------------------
+
+void SampleStore::remove(const SampleFile* file)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.lower_bound(Key(file, LLONG_MIN));
+    while (it != _entries.end() && it->first.first == file) {
+        _resident -= it->second->page->size() * sizeof(short);
+        _lru.erase(it->second);
+        it = _entries.erase(it);
+    }
+}
+
+//---------------------------------------------------------
+//   shrink
+//---------------------------------------------------------
+
+void SampleStore::shrink()
+{
+    while (_resident > _capacity && !_lru.empty()) {
+        const Entry& e = _lru.back();
+        _resident -= e.page->size() * sizeof(short);
+        _entries.erase(e.key);
+        _lru.pop_back();
+        ++_stats.evictions;
+    }
+}
@@ -0,0 +1,114 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_SAMPLESTORE_H
+#define MU_ZERBERUS_SAMPLESTORE_H
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QFile>
+#include <QString>
+
+namespace mu::zerberus {
+//---------------------------------------------------------
+//   SampleFile
+//    a 16 bit PCM wave file mapped into memory, only
+//    touched when the pages of the sample are read
+//---------------------------------------------------------
+
+class SampleFile
+{
+    QFile _file;
+    const uchar* _data { nullptr };     // first frame of the data chunk, inside the mapping
+    int _channels      { 0 };
+    long long _frames  { 0 };
+    int _sampleRate    { 44100 };
+    int _loopStart     { -1 };
+    int _loopEnd       { -1 };
+    int _loopMode      { -1 };
+
+public:
+    //! returns nullptr if the file is not a wave file with 16 bit samples,
+    //! or too short to be worth paging
+    static std::shared_ptr<SampleFile> map(const QString& path);
+    ~SampleFile();
+
+    int channels() const { return _channels; }
+    long long frames() const { return _frames; }
+    int sampleRate() const { return _sampleRate; }
+    int loopStart() const { return _loopStart; }
+    int loopEnd() const { return _loopEnd; }
+    int loopMode() const { return _loopMode; }
+
+    void read(long long frame, long long frames, short* dest) const;
+};
+
+//---------------------------------------------------------
+//   SampleStore
+//    keeps the pages of the paged samples that were played
+//    lately, up to capacity bytes; the least recently used
+//    pages are dropped first. A page that is still held by
+//    a voice stays valid until the voice lets it go.
+//---------------------------------------------------------
+
+class SampleStore
+{
+public:
+    static constexpr long long HEAD_FRAMES = 32768;   // resident from the start of each paged sample
+    static constexpr long long PAGE_FRAMES = 16384;
+    static constexpr size_t DEFAULT_CAPACITY = size_t(256) * 1024 * 1024;
+
+    using Page = std::vector<short>;
+    using PagePtr = std::shared_ptr<const Page>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t faults = 0;            // pages read from the mapped file
+        uint64_t evictions = 0;
+        size_t residentBytes = 0;
+        size_t capacityBytes = 0;
+    };
+
+    static SampleStore* instance();
+
+    void setCapacity(size_t bytes);
+    Stats stats() const;
+
+    PagePtr page(const SampleFile* file, long long index);
+    void remove(const SampleFile* file);
+
+private:
+    SampleStore() = default;
+
+    using Key = std::pair<const SampleFile*, long long>;
+    struct Entry {
+        Key key;
+        PagePtr page;
+    };
+
+    void shrink();
+
+    mutable std::mutex _mutex;
+    std::list<Entry> _lru;      // most recently used first
+    std::map<Key, std::list<Entry>::iterator> _entries;
+    size_t _capacity { DEFAULT_CAPACITY };
+    size_t _resident { 0 };
+    Stats _stats;
+};
+}
+
+#endif // MU_ZERBERUS_SAMPLESTORE_H
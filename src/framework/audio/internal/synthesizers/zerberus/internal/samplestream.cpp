@@ -0,0 +1,276 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "samplestream.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "sample.h"
+
+using namespace mu::zerberus;
+
+static constexpr long long HEAD_PAGES = SampleStore::HEAD_FRAMES / SampleStore::PAGE_FRAMES;
+static constexpr std::chrono::milliseconds STREAMER_INTERVAL(5);
+
+static long long pageCount(const Sample* sample)
+{
+    return (sample->frames() + SampleStore::PAGE_FRAMES - 1) / SampleStore::PAGE_FRAMES;
+}
+
+//---------------------------------------------------------
+//   Window
+//---------------------------------------------------------
+
+bool SampleStream::Window::contains(long long index) const
+{
+    return std::find(pages, pages + count, index) != pages + count;
+}
+
+//---------------------------------------------------------
+//   window
+//    the pages to keep while index is read, in the order
+//    they are needed; the resident head is left out
+//---------------------------------------------------------
+
+SampleStream::Window SampleStream::window(long long index, long long pages) const
+{
+    const long long loopEnd = _loopEndPage.load(std::memory_order_relaxed);
+    const long long loopStart = std::max(_loopStartPage.load(std::memory_order_relaxed), HEAD_PAGES);
+    const bool looping = _looping.load(std::memory_order_relaxed) && loopEnd >= loopStart;
+
+    Window w;
+    auto add = [&w, pages](long long p) {
+        if (p >= HEAD_PAGES && p < pages && !w.contains(p)) {
+            w.pages[w.count++] = p;
+        }
+    };
+
+    add(index);
+    add(looping && index == loopStart ? loopEnd : index - 1);
+    long long p = index;
+    for (int i = 2; i < SLOTS; ++i) {
+        p = looping && p == loopEnd ? loopStart : p + 1;
+        add(p);
+    }
+    return w;
+}
+
+//---------------------------------------------------------
+//   start
+//    frame is where the voice starts to read, loopStart
+//    and loopEnd are frames too, -1 if there is no loop
+//---------------------------------------------------------
+
+void SampleStream::start(const Sample* sample, long long frame, long long loopStart, long long loopEnd, bool looping)
+{
+    _loopStartPage.store(loopStart >= 0 ? loopStart / SampleStore::PAGE_FRAMES : -1, std::memory_order_relaxed);
+    _loopEndPage.store(loopEnd > 0 ? loopEnd / SampleStore::PAGE_FRAMES : -1, std::memory_order_relaxed);
+    _looping.store(looping, std::memory_order_relaxed);
+    _position.store(std::max(frame / SampleStore::PAGE_FRAMES, HEAD_PAGES), std::memory_order_relaxed);
+    _sample.store(sample, std::memory_order_relaxed);
+    _generation.fetch_add(1, std::memory_order_release);
+    _index = -1;
+    _missing = -1;
+
+    SampleStreamer::instance()->wakeup();
+}
+
+//---------------------------------------------------------
+//   stop
+//    the streamer drops the pages on its next round
+//---------------------------------------------------------
+
+void SampleStream::stop()
+{
+    if (!_sample.load(std::memory_order_relaxed)) {
+        return;
+    }
+    _sample.store(nullptr, std::memory_order_relaxed);
+    _generation.fetch_add(1, std::memory_order_release);
+}
+
+//---------------------------------------------------------
+//   data
+//---------------------------------------------------------
+
+const short* SampleStream::data(long long index)
+{
+    const Sample* sample = _sample.load(std::memory_order_relaxed);
+    if (!sample) {
+        return nullptr;
+    }
+    const unsigned generation = _generation.load(std::memory_order_relaxed);
+
+    if (index != _index) {
+        _index = index;
+        _position.store(index, std::memory_order_relaxed);
+
+        const Window w = window(index, pageCount(sample));
+        for (Slot& s : _slots) {
+            if (s.state.load(std::memory_order_acquire) == READY
+                && s.generation.load(std::memory_order_relaxed) == generation
+                && !w.contains(s.index.load(std::memory_order_relaxed))) {
+                s.state.store(STALE, std::memory_order_release);
+            }
+        }
+        SampleStreamer::instance()->wakeup();
+    }
+
+    for (Slot& s : _slots) {
+        if (s.state.load(std::memory_order_acquire) == READY
+            && s.generation.load(std::memory_order_relaxed) == generation
+            && s.index.load(std::memory_order_relaxed) == index) {
+            return s.page->data();
+        }
+    }
+
+    if (index != _missing) {
+        _missing = index;
+        SampleStreamer::instance()->addUnderrun();
+    }
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   fill
+//    streamer thread, with the streamer mutex held
+//---------------------------------------------------------
+
+void SampleStream::fill()
+{
+    const unsigned generation = _generation.load(std::memory_order_acquire);
+    const Sample* sample = _sample.load(std::memory_order_relaxed);
+
+    for (Slot& s : _slots) {
+        const int state = s.state.load(std::memory_order_acquire);
+        if (state == STALE || (state == READY && s.generation.load(std::memory_order_relaxed) != generation)) {
+            s.page.reset();
+            s.index.store(-1, std::memory_order_relaxed);
+            s.state.store(EMPTY, std::memory_order_release);
+        }
+    }
+
+    if (!sample || generation == _detached) {
+        return;
+    }
+
+    const Window w = window(_position.load(std::memory_order_relaxed), pageCount(sample));
+    for (int i = 0; i < w.count; ++i) {
+        const long long index = w.pages[i];
+        Slot* empty = nullptr;
+        bool present = false;
+        for (Slot& s : _slots) {
+            const int state = s.state.load(std::memory_order_acquire);
+            if (state == READY && s.index.load(std::memory_order_relaxed) == index) {
+                present = true;
+                break;
+            }
+            if (state == EMPTY && !empty) {
+                empty = &s;
+            }
+        }
+        if (present) {
+            continue;
+        }
+        if (!empty) {
+            break;
+        }
+
+        empty->page = SampleStore::instance()->page(sample->file(), index);
+        empty->index.store(index, std::memory_order_relaxed);
+        empty->generation.store(generation, std::memory_order_relaxed);
+        empty->state.store(READY, std::memory_order_release);
+    }
+}
+
+//---------------------------------------------------------
+//   detach
+//    with the streamer mutex held
+//---------------------------------------------------------
+
+void SampleStream::detach()
+{
+    _detached = _generation.load(std::memory_order_acquire);
+}
+
+//---------------------------------------------------------
+//   SampleStreamer
+//---------------------------------------------------------
+
+SampleStreamer* SampleStreamer::instance()
+{
+    static SampleStreamer streamer;
+    return &streamer;
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _cond.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void SampleStreamer::add(SampleStream* stream)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _streams.push_back(stream);
+    if (!_thread.joinable()) {
+        _thread = std::thread(&SampleStreamer::run, this);
+    }
+}
+
+//---------------------------------------------------------
+//   remove
+//---------------------------------------------------------
+
+void SampleStreamer::remove(SampleStream* stream)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _streams.erase(std::remove(_streams.begin(), _streams.end(), stream), _streams.end());
+}
+
+//---------------------------------------------------------
+//   detachAll
+//---------------------------------------------------------
+
+void SampleStreamer::detachAll()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (SampleStream* s : _streams) {
+        s->detach();
+    }
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SampleStreamer::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_quit) {
+        for (SampleStream* s : _streams) {
+            s->fill();
+        }
+        _cond.wait_for(lock, STREAMER_INTERVAL);
+    }
+}
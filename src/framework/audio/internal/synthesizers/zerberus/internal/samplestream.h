@@ -0,0 +1,130 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_SAMPLESTREAM_H
+#define MU_ZERBERUS_SAMPLESTREAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "samplestore.h"
+
+namespace mu::zerberus {
+class Sample;
+
+//---------------------------------------------------------
+//   SampleStream
+//    the pages of a paged sample around the one a voice
+//    reads: one behind, the current one and three ahead,
+//    following the loop. The SampleStreamer thread reads
+//    them into the slots, the audio thread only looks
+//    them up and never waits for the file.
+//
+//    A slot is EMPTY or STALE for the streamer, which
+//    makes it READY; the audio thread makes READY slots of
+//    its generation STALE once it has moved on. Slots of
+//    an older generation are never read again.
+//---------------------------------------------------------
+
+class SampleStream
+{
+public:
+    static constexpr int SLOTS = 5;
+
+    // audio thread
+    void start(const Sample* sample, long long frame, long long loopStart, long long loopEnd, bool looping);
+    void stop();
+    void setLooping(bool looping) { _looping.store(looping, std::memory_order_relaxed); }
+    const short* data(long long index);     // nullptr if the page is not read yet
+
+    // streamer thread
+    void fill();
+    void detach();
+
+private:
+    enum SlotState : int {
+        EMPTY, READY, STALE
+    };
+
+    struct Slot {
+        std::atomic<int> state { EMPTY };
+        std::atomic<unsigned> generation { 0 };
+        std::atomic<long long> index { -1 };
+        SampleStore::PagePtr page;
+    };
+
+    struct Window {
+        long long pages[SLOTS];
+        int count = 0;
+        bool contains(long long index) const;
+    };
+
+    Window window(long long index, long long pageCount) const;
+
+    Slot _slots[SLOTS];
+
+    // published by the audio thread
+    std::atomic<unsigned> _generation { 0 };
+    std::atomic<const Sample*> _sample { nullptr };
+    std::atomic<long long> _position { -1 };
+    std::atomic<long long> _loopStartPage { -1 };
+    std::atomic<long long> _loopEndPage { -1 };
+    std::atomic<bool> _looping { false };
+
+    // audio thread only
+    long long _index { -1 };
+    long long _missing { -1 };
+
+    // streamer thread only
+    unsigned _detached { 0 };
+};
+
+//---------------------------------------------------------
+//   SampleStreamer
+//    the thread that reads ahead for all sample streams
+//---------------------------------------------------------
+
+class SampleStreamer
+{
+public:
+    static SampleStreamer* instance();
+    ~SampleStreamer();
+
+    void add(SampleStream* stream);
+    void remove(SampleStream* stream);
+
+    //! makes the streams stop reading, before the samples they play are deleted
+    void detachAll();
+
+    void wakeup() { _cond.notify_one(); }
+
+    void addUnderrun() { _underruns.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t underruns() const { return _underruns.load(std::memory_order_relaxed); }
+
+private:
+    SampleStreamer() = default;
+    void run();
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::thread _thread;
+    bool _quit { false };
+    std::vector<SampleStream*> _streams;
+    std::atomic<uint64_t> _underruns { 0 };
+};
+}
+
+#endif // MU_ZERBERUS_SAMPLESTREAM_H
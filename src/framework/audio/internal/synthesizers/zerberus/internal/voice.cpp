@@ -11,6 +11,8 @@
 //=============================================================================
 
 #include <stdio.h>
+#include <algorithm>
+#include <limits>
 
 #include "voice.h"
 #include "instrument.h"
@@ -18,6 +20,7 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "voicekernels.h"
 
 //#include "midi/msynthesizer.h"
 
@@ -51,12 +54,27 @@ void Envelope::setTime(float ms, int sampleRate)
 Voice::Voice(Zerberus* z)
 {
     _zerberus = z;
+    SampleStreamer::instance()->add(&stream);
+}
+
+Voice::~Voice()
+{
+    SampleStreamer::instance()->remove(&stream);
 }
 
 //---------------------------------------------------------
 //   stop
 //---------------------------------------------------------
 
+void Voice::stop()
+{
+    envelopes[currentEnvelope].step();
+    envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val;
+    currentEnvelope = V1Envelopes::RELEASE;
+    _state = VoiceState::STOP;
+    stream.setLooping(_loopMode == LoopMode::CONTINUOUS);
+}
+
 void Voice::stop(float time)
 {
     _state = VoiceState::STOP;
@@ -64,6 +82,7 @@ void Voice::stop(float time)
     envelopes[currentEnvelope].step();
     envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val;
     currentEnvelope = V1Envelopes::RELEASE;
+    stream.setLooping(_loopMode == LoopMode::CONTINUOUS);
 }
 
 //---------------------------------------------------------
@@ -103,6 +122,13 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     data      = s->data() + z->offset * audioChan;
     //avoid processing sample if offset is bigger than sample length
     eidx      = std::max((s->frames() - z->offset - 1) * audioChan, 0ll);
+    sample    = s;
+    dataOffset = z->offset * audioChan;
+    residentSize = s->isPaged() ? s->residentFrames() * audioChan - dataOffset : std::numeric_limits<long long>::max();
+    streaming = s->isPaged() && _zerberus->sampleStreaming();
+    streamPage = nullptr;
+    page.reset();
+    pageIndex = -1;
     _loopMode = z->loopMode;
     _loopStart = z->loopStart;
     _loopEnd   = z->loopEnd;
@@ -193,6 +219,12 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     envelopes[V1Envelopes::RELEASE].max = envelopes[V1Envelopes::SUSTAIN].val;
 
     _looping = false;
+
+    if (streaming) {
+        const bool loops = _loopEnd > 0 && _loopStart >= 0 && _loopEnd <= (eidx / audioChan)
+                           && (_loopMode == LoopMode::CONTINUOUS || _loopMode == LoopMode::SUSTAIN);
+        stream.start(s, z->offset, loops ? z->offset + _loopStart : -1, loops ? z->offset + _loopEnd : -1, loops);
+    }
 }
 
 //---------------------------------------------------------
@@ -228,6 +260,10 @@ void Voice::updateEnvelopes()
 
 //---------------------------------------------------------
 //   process
+//    renders in blocks: the loop, envelope and phase state
+//    is advanced frame by frame and the interpolation points
+//    of each frame are gathered, then the block is
+//    interpolated, filtered and mixed into p at once
 //---------------------------------------------------------
 
 void Voice::process(int frames, float* p)
@@ -238,65 +274,55 @@ void Voice::process(int frames, float* p)
     const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
     const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
     const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
-    if (audioChan == 1) {
-        while (frames--) {
-            updateLoop();
 
-            long long idx = phase.index();
+    const VoiceKernels& kernels = voiceKernels();
+    const float* coeffTable = ZFilter::interpolationTable();
+    const bool stereo = audioChan != 1;
 
-            if (idx >= eidx) {
-                off();
-                break;
-            }
-
-            float interpVal = filter.interpolate(phase.fract(),
-                                                 getData(idx - 1), getData(idx), getData(idx + 1), getData(idx + 2));
-            float v = filter.apply(interpVal, true);
-
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
-                break;
-            }
-
-            *p++ = v * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = v * envelopes[currentEnvelope].val * rightChannelVol;
+    VoiceBlock block;
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
-            }
+    while (frames > 0) {
+        const int count = std::min(frames, VoiceBlock::FRAMES);
+        int filtered = 0;       // frames to interpolate and filter
+        int mixed = 0;          // frames to mix, the last filtered one is dropped if the voice ends on it
+        bool finished = false;
 
-            _samplesSinceStart++;
-        }
-    } else {
-        //
-        // handle interleaved stereo samples
-        //
-        while (frames--) {
+        for (; filtered < count; ++filtered) {
             updateLoop();
 
-            long long idx = phase.index() * 2;
+            long long idx = phase.index() * audioChan;
             if (idx >= eidx) {
                 off();
-
+                finished = true;
                 break;
             }
 
-            float interpValL = filter.interpolate(phase.fract(),
-                                                  getData(idx - 2), getData(idx), getData(idx + 2), getData(idx + 4));
-            float interpValR = filter.interpolate(phase.fract(),
-                                                  getData(idx - 1), getData(idx + 1), getData(idx + 3),
-                                                  getData(idx + 5));
-            float valueL = filter.apply(interpValL, true);
-            float valueR = filter.apply(interpValR, false);
+            block.coeffIndex[filtered] = phase.fract() * 4;
+            if (stereo) {
+                block.taps[0][0][filtered] = getData(idx - 2);
+                block.taps[0][1][filtered] = getData(idx);
+                block.taps[0][2][filtered] = getData(idx + 2);
+                block.taps[0][3][filtered] = getData(idx + 4);
+                block.taps[1][0][filtered] = getData(idx - 1);
+                block.taps[1][1][filtered] = getData(idx + 1);
+                block.taps[1][2][filtered] = getData(idx + 3);
+                block.taps[1][3][filtered] = getData(idx + 5);
+            } else {
+                block.taps[0][0][filtered] = getData(idx - 1);
+                block.taps[0][1][filtered] = getData(idx);
+                block.taps[0][2][filtered] = getData(idx + 1);
+                block.taps[0][3][filtered] = getData(idx + 2);
+            }
 
-            //apply volume
             updateEnvelopes();
             if (_state == VoiceState::OFF) {
+                ++filtered;
+                finished = true;
                 break;
             }
 
-            *p++ = valueL * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = valueR * envelopes[currentEnvelope].val * rightChannelVol;
+            block.envelope[filtered] = envelopes[currentEnvelope].val;
+            ++mixed;
 
             if (V1Envelopes::DELAY != currentEnvelope) {
                 phase += phaseIncr;
@@ -304,6 +330,22 @@ void Voice::process(int frames, float* p)
 
             _samplesSinceStart++;
         }
+
+        float* left = block.value[0];
+        float* right = stereo ? block.value[1] : nullptr;
+        kernels.interpolate(coeffTable, block.coeffIndex, block.taps[0], left, filtered);
+        if (right) {
+            kernels.interpolate(coeffTable, block.coeffIndex, block.taps[1], right, filtered);
+        }
+        filter.applyBlock(left, right, filtered);
+        kernels.mix(p, left, right ? right : left, block.envelope, leftChannelVol, rightChannelVol, mixed);
+
+        if (finished) {
+            break;
+        }
+
+        p += mixed * 2;
+        frames -= mixed;
     }
 }
 
@@ -339,19 +381,51 @@ short Voice::getData(long long pos)
     }
 
     if (!_looping) {
-        return data[pos];
+        return sampleData(pos);
     }
 
     long long loopEnd = _loopEnd * audioChan;
     long long loopStart = _loopStart * audioChan;
 
     if (pos < loopStart) {
-        return data[loopEnd + (pos - loopStart) + audioChan];
+        return sampleData(loopEnd + (pos - loopStart) + audioChan);
     } else if (pos > (loopEnd + audioChan - 1)) {
-        return data[loopStart + (pos - loopEnd) - audioChan];
+        return sampleData(loopStart + (pos - loopEnd) - audioChan);
     } else {
-        return data[pos];
+        return sampleData(pos);
+    }
+}
+
+//---------------------------------------------------------
+//   pagedData
+//    the part of a paged sample that is not resident,
+//    the voice holds on to the page it reads from
+//---------------------------------------------------------
+
+short Voice::pagedData(long long pos)
+{
+    const long long value = pos + dataOffset;
+    const long long frame = value / audioChan;
+    if (frame < 0 || frame >= sample->frames()) {
+        return 0;
+    }
+
+    const long long index = frame / SampleStore::PAGE_FRAMES;
+    const long long first = index * SampleStore::PAGE_FRAMES * audioChan;
+    if (streaming) {
+        if (index != pageIndex) {
+            streamPage = stream.data(index);
+            // not streamed in yet: silence, and look again on the next read
+            pageIndex = streamPage ? index : -1;
+        }
+        return streamPage ? streamPage[value - first] : 0;
+    }
+
+    if (index != pageIndex) {
+        page = SampleStore::instance()->page(sample->file(), index);
+        pageIndex = index;
     }
+    return (*page)[value - first];
 }
 
 //---------------------------------------------------------
@@ -16,6 +16,8 @@
 #include <cstdint>
 #include <math.h>
 #include "filter.h"
+#include "samplestore.h"
+#include "samplestream.h"
 
 // Disable warning C4201: nonstandard extension used: nameless struct/union in VS2017
 #if (defined (_MSCVER) || defined (_MSC_VER))
@@ -134,6 +136,18 @@ class Voice
 
     short* data;
     long long eidx;
+
+    // paged samples: data holds residentSize values, the others are streamed
+    // or, when rendering offline, come from the sample store
+    const Sample* sample;
+    long long dataOffset;
+    long long residentSize;
+    bool streaming;
+    SampleStream stream;
+    const short* streamPage;
+    SampleStore::PagePtr page;
+    long long pageIndex;
+
     LoopMode _loopMode;
     OffMode _offMode;
     int _offBy;
@@ -157,6 +171,7 @@ class Voice
 
 public:
     Voice(Zerberus*);
+    ~Voice();
     Voice* next() const { return _next; }
     void setNext(Voice* v) { _next = v; }
 
@@ -165,6 +180,12 @@ public:
     void process(int frames, float*);
     void updateLoop();
     short getData(long long pos);
+    short sampleData(long long pos)
+    {
+        return pos < residentSize ? data[pos] : pagedData(pos);
+    }
+
+    short pagedData(long long pos);
 
     Channel* channel() const { return _channel; }
     int key() const { return _key; }
@@ -174,21 +195,20 @@ public:
     bool isSustained() const { return _state == VoiceState::SUSTAINED; }
     bool isOff() const { return _state == VoiceState::OFF; }
     bool isStopped() const { return _state == VoiceState::STOP; }
-    void stop()
+    void stop();
+    void stop(float time);
+    void sustained() { _state = VoiceState::SUSTAINED; }
+    void off()
     {
-        envelopes[currentEnvelope].step();
-        envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val;
-        currentEnvelope = V1Envelopes::RELEASE;
-        _state = VoiceState::STOP;
+        _state = VoiceState::OFF;
+        stream.stop();
     }
 
-    void stop(float time);
-    void sustained() { _state = VoiceState::SUSTAINED; }
-    void off() { _state = VoiceState::OFF; }
     const char* state() const;
     LoopMode loopMode() const { return _loopMode; }
     int getSamplesSinceStart() { return _samplesSinceStart; }
     float getGain() { return gain; }
+    float level() const { return gain * envelopes[currentEnvelope].val; }
 
     OffMode offMode() const { return _offMode; }
     int offBy() const { return _offBy; }
@@ -0,0 +1,274 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "voicekernels.h"
+
+#if defined(__EMSCRIPTEN__) && defined(__SSE2__)
+//! NOTE -msimd128 -msse2, emscripten translates the SSE2 intrinsics to wasm SIMD
+#include <emmintrin.h>
+#define MU_ZERBERUS_SSE2
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define MU_ZERBERUS_SSE2
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define MU_ZERBERUS_AVX2
+#define MU_ZERBERUS_TARGET_AVX2
+#elif defined(__GNUC__)
+#define MU_ZERBERUS_AVX2
+#define MU_ZERBERUS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MU_ZERBERUS_NEON
+#endif
+
+using namespace mu::zerberus;
+
+using Taps = const short (*)[VoiceBlock::FRAMES];
+
+//---------------------------------------------------------
+//   scalar
+//    the order of the operations is the one of
+//    ZFilter::interpolate, the vector kernels keep it
+//    (no fused multiply-add) to give the same result
+//---------------------------------------------------------
+
+static void interpolateScalar(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int i, int frames)
+{
+    for (; i < frames; ++i) {
+        const float* c = coeffTable + coeffIndex[i];
+        value[i] = c[0] * taps[0][i] + c[1] * taps[1][i] + c[2] * taps[2][i] + c[3] * taps[3][i];
+    }
+}
+
+static void interpolateScalar(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int frames)
+{
+    interpolateScalar(coeffTable, coeffIndex, taps, value, 0, frames);
+}
+
+static void mixScalar(float* out, const float* left, const float* right, const float* envelope, float leftVol,
+                      float rightVol, int frames)
+{
+    for (int i = 0; i < frames; ++i) {
+        *out++ += left[i] * envelope[i] * leftVol;
+        *out++ += right[i] * envelope[i] * rightVol;
+    }
+}
+
+//---------------------------------------------------------
+//   SSE2
+//---------------------------------------------------------
+
+#if defined(MU_ZERBERUS_SSE2)
+static inline __m128 loadTapsSSE2(const short* taps)
+{
+    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(taps));
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+
+static void interpolateSSE2(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int i, int frames)
+{
+    for (; i + 4 <= frames; i += 4) {
+        // one table row per frame, transposed to one vector per tap
+        __m128 c0 = _mm_loadu_ps(coeffTable + coeffIndex[i]);
+        __m128 c1 = _mm_loadu_ps(coeffTable + coeffIndex[i + 1]);
+        __m128 c2 = _mm_loadu_ps(coeffTable + coeffIndex[i + 2]);
+        __m128 c3 = _mm_loadu_ps(coeffTable + coeffIndex[i + 3]);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        __m128 v = _mm_mul_ps(c0, loadTapsSSE2(taps[0] + i));
+        v = _mm_add_ps(v, _mm_mul_ps(c1, loadTapsSSE2(taps[1] + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(c2, loadTapsSSE2(taps[2] + i)));
+        v = _mm_add_ps(v, _mm_mul_ps(c3, loadTapsSSE2(taps[3] + i)));
+        _mm_storeu_ps(value + i, v);
+    }
+    interpolateScalar(coeffTable, coeffIndex, taps, value, i, frames);
+}
+
+static void interpolateSSE2(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int frames)
+{
+    interpolateSSE2(coeffTable, coeffIndex, taps, value, 0, frames);
+}
+
+static void mixSSE2(float* out, const float* left, const float* right, const float* envelope, float leftVol,
+                    float rightVol, int frames)
+{
+    const __m128 lv = _mm_set1_ps(leftVol);
+    const __m128 rv = _mm_set1_ps(rightVol);
+    int i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128 e = _mm_loadu_ps(envelope + i);
+        const __m128 l = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(left + i), e), lv);
+        const __m128 r = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(right + i), e), rv);
+        float* d = out + i * 2;
+        _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_unpackhi_ps(l, r)));
+    }
+    mixScalar(out + i * 2, left + i, right + i, envelope + i, leftVol, rightVol, frames - i);
+}
+
+#endif
+
+//---------------------------------------------------------
+//   AVX2
+//---------------------------------------------------------
+
+#if defined(MU_ZERBERUS_AVX2)
+MU_ZERBERUS_TARGET_AVX2
+static inline __m256 loadTapsAVX2(const short* taps)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(taps));
+    return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v));
+}
+
+MU_ZERBERUS_TARGET_AVX2
+static void interpolateAVX2(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int frames)
+{
+    int i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(coeffIndex + i));
+        __m256 v = _mm256_mul_ps(_mm256_i32gather_ps(coeffTable, idx, 4), loadTapsAVX2(taps[0] + i));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_i32gather_ps(coeffTable + 1, idx, 4), loadTapsAVX2(taps[1] + i)));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_i32gather_ps(coeffTable + 2, idx, 4), loadTapsAVX2(taps[2] + i)));
+        v = _mm256_add_ps(v, _mm256_mul_ps(_mm256_i32gather_ps(coeffTable + 3, idx, 4), loadTapsAVX2(taps[3] + i)));
+        _mm256_storeu_ps(value + i, v);
+    }
+    interpolateSSE2(coeffTable, coeffIndex, taps, value, i, frames);
+}
+
+MU_ZERBERUS_TARGET_AVX2
+static void mixAVX2(float* out, const float* left, const float* right, const float* envelope, float leftVol,
+                    float rightVol, int frames)
+{
+    const __m256 lv = _mm256_set1_ps(leftVol);
+    const __m256 rv = _mm256_set1_ps(rightVol);
+    int i = 0;
+    for (; i + 8 <= frames; i += 8) {
+        const __m256 e = _mm256_loadu_ps(envelope + i);
+        const __m256 l = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(left + i), e), lv);
+        const __m256 r = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(right + i), e), rv);
+        const __m256 lo = _mm256_unpacklo_ps(l, r);                 // l0 r0 l1 r1 | l4 r4 l5 r5
+        const __m256 hi = _mm256_unpackhi_ps(l, r);                 // l2 r2 l3 r3 | l6 r6 l7 r7
+        float* d = out + i * 2;
+        _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), _mm256_permute2f128_ps(lo, hi, 0x20)));
+        _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), _mm256_permute2f128_ps(lo, hi, 0x31)));
+    }
+    mixSSE2(out + i * 2, left + i, right + i, envelope + i, leftVol, rightVol, frames - i);
+}
+
+//---------------------------------------------------------
+//   hasAVX2
+//---------------------------------------------------------
+
+static bool hasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = info[2] & (1 << 27);
+    const bool avx = info[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+//---------------------------------------------------------
+//   NEON
+//---------------------------------------------------------
+
+#if defined(MU_ZERBERUS_NEON)
+static inline float32x4_t loadTapsNEON(const short* taps)
+{
+    return vcvtq_f32_s32(vmovl_s16(vld1_s16(taps)));
+}
+
+static void interpolateNEON(const float* coeffTable, const int* coeffIndex, Taps taps, float* value, int frames)
+{
+    int i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(coeffTable + coeffIndex[i]), vld1q_f32(coeffTable + coeffIndex[i + 1]));
+        const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(coeffTable + coeffIndex[i + 2]),
+                                            vld1q_f32(coeffTable + coeffIndex[i + 3]));
+        const float32x4_t c0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        const float32x4_t c1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        const float32x4_t c2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        const float32x4_t c3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+
+        float32x4_t v = vmulq_f32(c0, loadTapsNEON(taps[0] + i));
+        v = vaddq_f32(v, vmulq_f32(c1, loadTapsNEON(taps[1] + i)));
+        v = vaddq_f32(v, vmulq_f32(c2, loadTapsNEON(taps[2] + i)));
+        v = vaddq_f32(v, vmulq_f32(c3, loadTapsNEON(taps[3] + i)));
+        vst1q_f32(value + i, v);
+    }
+    interpolateScalar(coeffTable, coeffIndex, taps, value, i, frames);
+}
+
+static void mixNEON(float* out, const float* left, const float* right, const float* envelope, float leftVol,
+                    float rightVol, int frames)
+{
+    int i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const float32x4_t e = vld1q_f32(envelope + i);
+        float* d = out + i * 2;
+        float32x4x2_t v = vld2q_f32(d);
+        v.val[0] = vaddq_f32(v.val[0], vmulq_n_f32(vmulq_f32(vld1q_f32(left + i), e), leftVol));
+        v.val[1] = vaddq_f32(v.val[1], vmulq_n_f32(vmulq_f32(vld1q_f32(right + i), e), rightVol));
+        vst2q_f32(d, v);
+    }
+    mixScalar(out + i * 2, left + i, right + i, envelope + i, leftVol, rightVol, frames - i);
+}
+
+#endif
+
+//---------------------------------------------------------
+//   voiceKernels
+//---------------------------------------------------------
+
+static VoiceKernels selectKernels()
+{
+#if defined(MU_ZERBERUS_AVX2)
+    if (hasAVX2()) {
+        return { interpolateAVX2, mixAVX2, "avx2" };
+    }
+#endif
+#if defined(MU_ZERBERUS_SSE2)
+    return { interpolateSSE2, mixSSE2, "sse2" };
+#elif defined(MU_ZERBERUS_NEON)
+    return { interpolateNEON, mixNEON, "neon" };
+#else
+    return scalarVoiceKernels();
+#endif
+}
+
+const VoiceKernels& mu::zerberus::voiceKernels()
+{
+    static const VoiceKernels kernels = selectKernels();
+    return kernels;
+}
+
+const VoiceKernels& mu::zerberus::scalarVoiceKernels()
+{
+    static const VoiceKernels kernels = { interpolateScalar, mixScalar, "scalar" };
+    return kernels;
+}
@@ -0,0 +1,56 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_VOICEKERNELS_H
+#define MU_ZERBERUS_VOICEKERNELS_H
+
+namespace mu::zerberus {
+//---------------------------------------------------------
+//   VoiceBlock
+//    per frame data of one block of a voice, gathered by
+//    Voice::process and consumed by the kernels below
+//---------------------------------------------------------
+
+struct VoiceBlock {
+    static constexpr int FRAMES = 64;
+
+    alignas(32) short taps[2][4][FRAMES];        // [channel][tap][frame] the 4 interpolation points
+    alignas(32) int coeffIndex[FRAMES];          // 4 * phase fract, row of the interpolation table
+    alignas(32) float envelope[FRAMES];
+    alignas(32) float value[2][FRAMES];          // [channel][frame] interpolated, then filtered
+};
+
+//---------------------------------------------------------
+//   VoiceKernels
+//    the vectorized parts of Voice::process, selected once
+//    at runtime by the features of the CPU (AVX2, SSE2,
+//    NEON or scalar). All kernels give the same result as
+//    the scalar code, bit for bit.
+//---------------------------------------------------------
+
+struct VoiceKernels {
+    //! value[frame] = sum of interpCoeff[fract][tap] * taps[tap][frame]
+    void (* interpolate)(const float* coeffTable, const int* coeffIndex, const short (* taps)[VoiceBlock::FRAMES],
+                         float* value, int frames);
+
+    //! out (stereo) += { left, right }[frame] * envelope[frame] * { leftVol, rightVol }
+    void (* mix)(float* out, const float* left, const float* right, const float* envelope, float leftVol, float rightVol,
+                 int frames);
+
+    const char* name;
+};
+
+const VoiceKernels& voiceKernels();
+const VoiceKernels& scalarVoiceKernels();
+}
+
+#endif // MU_ZERBERUS_VOICEKERNELS_H
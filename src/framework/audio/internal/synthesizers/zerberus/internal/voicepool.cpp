@@ -0,0 +1,145 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "voicepool.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "voice.h"
+
+using namespace mu::zerberus;
+
+//---------------------------------------------------------
+//   ~VoicePool
+//---------------------------------------------------------
+
+VoicePool::~VoicePool()
+{
+    setThreadCount(1);
+}
+
+//---------------------------------------------------------
+//   setThreadCount
+//    count includes the calling thread
+//---------------------------------------------------------
+
+void VoicePool::setThreadCount(unsigned count)
+{
+    count = std::max(1u, count);
+    if (count == threadCount()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _started.notify_all();
+    for (Worker& w : _workers) {
+        w.thread.join();
+    }
+
+    _workers.clear();
+    _quit = false;
+
+    _workers.resize(count - 1);
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        _workers[i].thread = std::thread(&VoicePool::workerLoop, this, i, _generation);
+    }
+}
+
+//---------------------------------------------------------
+//   render
+//---------------------------------------------------------
+
+void VoicePool::render(const std::vector<Voice*>& voices, size_t begin, size_t end, unsigned frames, float* p)
+{
+    for (size_t i = begin; i < end; ++i) {
+        voices[i]->process(frames, p);
+    }
+}
+
+//---------------------------------------------------------
+//   workerLoop
+//---------------------------------------------------------
+
+void VoicePool::workerLoop(size_t index, unsigned generation)
+{
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _started.wait(lock, [this, generation]() { return _quit || _generation != generation; });
+            if (_quit) {
+                return;
+            }
+            generation = _generation;
+        }
+
+        Worker& w = _workers[index];
+        if (w.begin < w.end) {
+            std::memset(w.scratch.data(), 0, _frames * 2 * sizeof(float));
+            render(*_voices, w.begin, w.end, _frames, w.scratch.data());
+        }
+        _pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+//---------------------------------------------------------
+//   process
+//    realtime, voices are independent of each other
+//    while rendering, so slices can run concurrently
+//---------------------------------------------------------
+
+void VoicePool::process(const std::vector<Voice*>& voices, unsigned frames, float* p)
+{
+    size_t threads = std::min<size_t>(threadCount(), voices.size() / MIN_VOICES_PER_THREAD);
+    if (threads <= 1) {
+        render(voices, 0, voices.size(), frames, p);
+        return;
+    }
+
+    size_t perThread = (voices.size() + threads - 1) / threads;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        Worker& w = _workers[i];
+        w.begin = std::min(voices.size(), (i + 1) * perThread);
+        w.end = i + 1 < threads ? std::min(voices.size(), (i + 2) * perThread) : w.begin;
+        if (w.scratch.size() < frames * 2) {
+            w.scratch.resize(frames * 2);
+        }
+    }
+
+    _voices = &voices;
+    _frames = frames;
+    _pending.store(int(_workers.size()), std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_generation;
+    }
+    _started.notify_all();
+
+    render(voices, 0, std::min(voices.size(), perThread), frames, p);
+
+    while (_pending.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+
+    for (const Worker& w : _workers) {
+        if (w.begin >= w.end) {
+            continue;
+        }
+        const float* s = w.scratch.data();
+        for (unsigned i = 0; i < frames * 2; ++i) {
+            p[i] += s[i];
+        }
+    }
+}
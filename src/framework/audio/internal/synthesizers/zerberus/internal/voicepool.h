@@ -0,0 +1,69 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef MU_ZERBERUS_VOICEPOOL_H
+#define MU_ZERBERUS_VOICEPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::zerberus {
+class Voice;
+
+//---------------------------------------------------------
+//   VoicePool
+//    renders the active voices on several threads,
+//    each worker renders a slice of the voices into its
+//    own scratch buffer, the caller renders the first slice
+//    straight into the output and sums the scratch buffers
+//---------------------------------------------------------
+
+class VoicePool
+{
+    struct Worker {
+        std::thread thread;
+        std::vector<float> scratch;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    std::vector<Worker> _workers;
+    std::mutex _mutex;
+    std::condition_variable _started;
+    unsigned _generation = 0;
+    bool _quit = false;
+    std::atomic<int> _pending { 0 };
+
+    const std::vector<Voice*>* _voices = nullptr;
+    unsigned _frames = 0;
+
+    void workerLoop(size_t index, unsigned generation);
+    static void render(const std::vector<Voice*>& voices, size_t begin, size_t end, unsigned frames, float* p);
+
+public:
+    //! NOTE Fewer voices than this are rendered on the calling thread, waking workers costs more
+    static const size_t MIN_VOICES_PER_THREAD = 8;
+
+    VoicePool() = default;
+    ~VoicePool();
+
+    void setThreadCount(unsigned count);
+    unsigned threadCount() const { return unsigned(_workers.size()) + 1; }
+
+    void process(const std::vector<Voice*>& voices, unsigned frames, float* p);
+};
+}
+
+#endif // MU_ZERBERUS_VOICEPOOL_H
@@ -9,9 +9,17 @@ set(ZERBERUS_SRC
     ${CMAKE_CURRENT_LIST_DIR}/instrument.cpp
     ${CMAKE_CURRENT_LIST_DIR}/instrument.h
     ${CMAKE_CURRENT_LIST_DIR}/sample.h
+    ${CMAKE_CURRENT_LIST_DIR}/samplestore.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/samplestore.h
+    ${CMAKE_CURRENT_LIST_DIR}/samplestream.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/samplestream.h
     ${CMAKE_CURRENT_LIST_DIR}/sfz.cpp
     ${CMAKE_CURRENT_LIST_DIR}/voice.cpp
     ${CMAKE_CURRENT_LIST_DIR}/voice.h
+    ${CMAKE_CURRENT_LIST_DIR}/voicekernels.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/voicekernels.h
+    ${CMAKE_CURRENT_LIST_DIR}/voicepool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/voicepool.h
     ${CMAKE_CURRENT_LIST_DIR}/zerberus.cpp
     ${CMAKE_CURRENT_LIST_DIR}/zerberus.h
     ${CMAKE_CURRENT_LIST_DIR}/zone.cpp
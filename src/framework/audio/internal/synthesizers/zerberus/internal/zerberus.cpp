@@ -20,6 +20,7 @@
 #include "channel.h"
 #include "instrument.h"
 #include "zone.h"
+#include "samplestream.h"
 
 using namespace mu::zerberus;
 
@@ -39,6 +40,7 @@ Zerberus::Zerberus()
     }
 
     freeVoices.init(this);
+    renderVoices.reserve(MAX_VOICES);
     for (int i = 0; i < MAX_CHANNELS; ++i) {
         _channel[i] = new Channel(this, i);
     }
@@ -52,6 +54,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
 {
     busy = true;
+    SampleStreamer::instance()->detachAll();
     while (!instruments.empty()) {
         auto i  = instruments.front();
         auto it = instruments.begin();
@@ -213,21 +216,65 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
     if (busy) {
         return;
     }
+
+    if (_voiceLimit > 0) {
+        stealVoices();
+    }
+
+    renderVoices.clear();
+    for (Voice* v = activeVoices; v; v = v->next()) {
+        renderVoices.push_back(v);
+    }
+    voicePool.process(renderVoices, frames, p);
+
     Voice* v = activeVoices;
     Voice* pv = 0;
     while (v) {
-        v->process(frames, p);
+        Voice* next = v->next();
         if (v->isOff()) {
             if (pv) {
-                pv->setNext(v->next());
+                pv->setNext(next);
             } else {
-                activeVoices = v->next();
+                activeVoices = next;
             }
             freeVoices.push(v);
         } else {
             pv = v;
         }
-        v = v->next();
+        v = next;
+    }
+}
+
+//---------------------------------------------------------
+//   stealVoices
+//    the stopped voices are fading out already and are
+//    not counted, of the others the quietest are stopped,
+//    of equally loud ones the oldest
+//---------------------------------------------------------
+
+void Zerberus::stealVoices()
+{
+    static const float STEAL_RELEASE_MS = 5.0f;
+
+    int sounding = 0;
+    for (Voice* v = activeVoices; v; v = v->next()) {
+        if (!v->isStopped() && !v->isOff()) {
+            ++sounding;
+        }
+    }
+
+    for (; sounding > _voiceLimit; --sounding) {
+        Voice* victim = 0;
+        for (Voice* v = activeVoices; v; v = v->next()) {
+            if (v->isStopped() || v->isOff()) {
+                continue;
+            }
+            if (!victim || v->level() < victim->level()
+                || (v->level() == victim->level() && v->getSamplesSinceStart() > victim->getSamplesSinceStart())) {
+                victim = v;
+            }
+        }
+        victim->stop(STEAL_RELEASE_MS);
     }
 }
 
@@ -310,6 +357,7 @@ bool Zerberus::removeSoundFont(const QString& path)
                     return false;
                 }
                 globalInstruments.erase(it1);
+                SampleStreamer::instance()->detachAll();
                 delete i;
             }
 
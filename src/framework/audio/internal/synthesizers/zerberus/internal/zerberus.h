@@ -21,6 +21,7 @@
 #include <QString>
 
 #include "voice.h"
+#include "voicepool.h"
 
 namespace mu::zerberus {
 class Channel;
@@ -87,16 +88,21 @@ class Zerberus //: public Ms::Synthesizer
 
     VoiceFifo freeVoices;
     Voice* activeVoices = 0;
+    std::vector<Voice*> renderVoices;
+    VoicePool voicePool;
     int _loadProgress = 0;
     bool _loadWasCanceled = false;
 
     float _sampleRate = 0.0f;
+    bool _sampleStreaming = true;
+    int _voiceLimit = 0;
 
     bool loadInstrument(const QString& path);
 
     void trigger(Channel*, int key, int velo, Trigger, int cc, int ccVal, double durSinceNoteOn);
     void processNoteOff(Channel*, int pitch);
     void processNoteOn(Channel* cp, int key, int velo);
+    void stealVoices();
 
 public:
     Zerberus();
@@ -115,6 +121,17 @@ public:
 
     void process(unsigned frames, float*, float*, float*);
 
+    void setRenderThreads(unsigned count) { voicePool.setThreadCount(count); }
+    unsigned renderThreads() const { return voicePool.threadCount(); }
+
+    // paged samples are streamed ahead of the voices, else read when needed (offline rendering)
+    void setSampleStreaming(bool val) { _sampleStreaming = val; }
+    bool sampleStreaming() const { return _sampleStreaming; }
+
+    // voices sounding at once, over the limit the quietest are stopped fast; 0 - no limit
+    void setVoiceLimit(int val) { _voiceLimit = val; }
+    int voiceLimit() const { return _voiceLimit; }
+
     ZInstrument* instrument(int program) const;
     Voice* getActiveVoices() { return activeVoices; }
     Channel* channel(int n) { return _channel[n]; }
@@ -22,6 +22,7 @@
 #include "log.h"
 #include "io/path.h"
 #include "internal/zerberus.h"
+#include "internal/samplestore.h"
 #include "internal/controllers.h"
 #include "midi/miditypes.h"
 #include "midi/midierrors.h"
@@ -63,6 +64,13 @@ Ret ZerberusSynth::init()
         m_zerb = new zerberus::Zerberus();
         m_zerb->setSampleRate(m_sampleRate);
     }
+    m_zerb->setSampleStreaming(m_sampleStreaming);
+    m_zerb->setVoiceLimit(static_cast<int>(m_renderBudget.maxVoices));
+
+    if (configuration()) {
+        m_zerb->setRenderThreads(configuration()->zerberusRenderThreads());
+        zerberus::SampleStore::instance()->setCapacity(configuration()->zerberusSampleCacheSize());
+    }
     return true;
 }
 
@@ -237,6 +245,15 @@ bool ZerberusSynth::channelPitch(channel_t chan, int16_t pitch)
     return false;
 }
 
+void ZerberusSynth::setRenderBudget(const RenderBudget& budget)
+{
+    //! NOTE The interpolation of Zerberus is cheap already, only the voices are limited
+    m_renderBudget = budget;
+    if (m_zerb) {
+        m_zerb->setVoiceLimit(static_cast<int>(budget.maxVoices));
+    }
+}
+
 void ZerberusSynth::setIsActive(bool arg)
 {
     m_isActive = arg;
@@ -261,6 +278,8 @@ void ZerberusSynth::writeBuf(float* stream, unsigned int samples)
         return;
     }
 
+    //! NOTE Voices are added to the stream
+    std::fill(stream, stream + samples * AUDIO_CHANNELS, 0.f);
     m_zerb->process(samples, stream, nullptr, nullptr);
 }
 
@@ -269,9 +288,26 @@ unsigned int ZerberusSynth::streamCount() const
     return synth::AUDIO_CHANNELS;
 }
 
+void ZerberusSynth::scheduleEvent(const Event& e, unsigned int sampleOffset)
+{
+    //! NOTE More events than a block can hold, this one sounds at the start of the block then
+    if (!m_scheduledEvents.add(e, sampleOffset)) {
+        handleEvent(e);
+    }
+}
+
 void ZerberusSynth::forward(unsigned int sampleCount)
 {
-    writeBuf(m_buffer.data(), sampleCount);
+    if (m_scheduledEvents.empty()) {
+        writeBuf(m_buffer.data(), sampleCount);
+        return;
+    }
+
+    m_scheduledEvents.forward(sampleCount, [this](unsigned int from, unsigned int samples) {
+        writeBuf(m_buffer.data() + from * AUDIO_CHANNELS, samples);
+    }, [this](const Event& e) {
+        handleEvent(e);
+    });
 }
 
 async::Channel<unsigned int> ZerberusSynth::streamsCountChanged() const
@@ -292,3 +328,11 @@ void ZerberusSynth::setBufferSize(unsigned int samples)
         m_buffer.resize(samples * streamCount());
     }
 }
+
+void ZerberusSynth::setSampleStreaming(bool arg)
+{
+    m_sampleStreaming = arg;
+    if (m_zerb) {
+        m_zerb->setSampleStreaming(arg);
+    }
+}
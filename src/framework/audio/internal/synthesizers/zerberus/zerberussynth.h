@@ -20,6 +20,9 @@
 #define MU_AUDIO_ZERBERUSSYNTH_H
 
 #include "isynthesizer.h"
+#include "modularity/ioc.h"
+#include "iaudioconfiguration.h"
+#include "internal/synthesizers/scheduledevents.h"
 
 namespace mu::zerberus {
 class Zerberus;
@@ -28,6 +31,8 @@ class Zerberus;
 namespace mu::audio::synth {
 class ZerberusSynth : public ISynthesizer
 {
+    INJECT(audio, IAudioConfiguration, configuration)
+
 public:
 
     ZerberusSynth();
@@ -48,6 +53,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -57,6 +63,7 @@ public:
     bool channelVolume(midi::channel_t chan, float val) override;  // 0. - 1.
     bool channelBalance(midi::channel_t chan, float val) override; // -1. - 1.
     bool channelPitch(midi::channel_t chan, int16_t pitch) override; // -12 - 12
+    void setRenderBudget(const RenderBudget& budget) override;
 
     unsigned int streamCount() const override;
     void forward(unsigned int sampleCount) override;
@@ -64,15 +71,21 @@ public:
     const float* data() const override;
     void setBufferSize(unsigned int samples) override;
 
+    //! NOTE Off for offline rendering, which must not wait for samples nor play silence for them
+    void setSampleStreaming(bool arg);
+
 private:
 
     zerberus::Zerberus* m_zerb = nullptr;
     std::vector<float> m_preallocated;
     bool m_isLoggingSynthEvents = false;
     bool m_isActive = false;
+    bool m_sampleStreaming = true;
+    RenderBudget m_renderBudget;
 
     unsigned int m_sampleRate = 1;
     std::vector<float> m_buffer = {};
+    ScheduledEvents m_scheduledEvents;
     async::Channel<unsigned int> m_streamsCountChanged;
 };
 }
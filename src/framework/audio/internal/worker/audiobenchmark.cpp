@@ -0,0 +1,174 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audiobenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include "log.h"
+#include "audioengine.h"
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+using namespace mu::midi;
+
+static const ISequencer::TrackID BENCHMARK_TRACK = 1000;
+static const tick_t TICKS_PER_SECOND = 960; // 120 bpm, the tempo of a stream without a tempo map
+static const tick_t BEAT_TICKS = 480;
+static const tick_t NOTE_TICKS = 470;  // released before the next beat
+static const unsigned int HISTOGRAM_BUCKETS = 10;
+
+std::string AudioBenchmark::Result::toString() const
+{
+    std::stringstream ss;
+    ss << "{\"callbacks\": " << callbacks
+       << ", \"misses\": " << misses
+       << ", \"deadlineUs\": " << deadlineUs
+       << ", \"worstUs\": " << worstUs
+       << ", \"p50Us\": " << p50Us
+       << ", \"p99Us\": " << p99Us
+       << ", \"histogram\": [";
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        ss << (i ? ", " : "") << histogram[i];
+    }
+    ss << "], \"notesAtFirstMiss\": " << notesAtFirstMiss
+       << ", \"channelsAtFirstMiss\": " << channelsAtFirstMiss << "}";
+    return ss.str();
+}
+
+AudioBenchmark::AudioBenchmark(AudioEngine* engine)
+    : m_engine(engine)
+{
+}
+
+unsigned int AudioBenchmark::notesAtStep(const Options& options, unsigned int step) const
+{
+    return (step + 1) * options.notesPerStep;
+}
+
+std::shared_ptr<MidiStream> AudioBenchmark::makeStream(const Options& options) const
+{
+    auto stream = std::make_shared<MidiStream>();
+    MidiData& data = stream->initData;
+
+    Track track;
+    track.num = 0;
+    for (channel_t ch = 0; ch < options.channels; ++ch) {
+        track.channels.push_back(ch);
+
+        //! NOTE A different program on each channel, as the parts of an orchestra
+        Event program(Event::Opcode::ProgramChange);
+        program.setChannel(ch);
+        program.setProgram(static_cast<uint8_t>((ch * 8) % 128));
+        data.initEvents.push_back(program);
+    }
+    data.tracks.push_back(track);
+
+    for (unsigned int step = 0; step < options.seconds; ++step) {
+        Chunk chunk;
+        chunk.beginTick = step * TICKS_PER_SECOND;
+        chunk.endTick = chunk.beginTick + TICKS_PER_SECOND;
+
+        unsigned int notes = notesAtStep(options, step);
+        for (tick_t beat = chunk.beginTick; beat < chunk.endTick; beat += BEAT_TICKS) {
+            for (unsigned int i = 0; i < notes; ++i) {
+                Event noteOn(Event::Opcode::NoteOn);
+                noteOn.setChannel(static_cast<channel_t>(i % options.channels));
+                noteOn.setNote(static_cast<uint8_t>(24 + (i * 7) % 84));
+                noteOn.setVelocityFraction(0.7f);
+                chunk.events.insert({ beat, noteOn });
+
+                Event noteOff = noteOn;
+                noteOff.setOpcode(Event::Opcode::NoteOff);
+                chunk.events.insert({ beat + NOTE_TICKS, noteOff });
+            }
+        }
+
+        data.chunks.insert({ chunk.beginTick, std::move(chunk) });
+    }
+
+    stream->lastTick = options.seconds * TICKS_PER_SECOND;
+    stream->isStreamingAllowed = false;
+    return stream;
+}
+
+AudioBenchmark::Result AudioBenchmark::run(const Options& options)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    Result result;
+    result.histogram.assign(HISTOGRAM_BUCKETS + 1, 0);
+    IF_ASSERT_FAILED(m_engine && options.sampleRate > 0 && options.bufferSize > 0 && options.channels > 0) {
+        return result;
+    }
+
+    unsigned int oldSampleRate = m_engine->sampleRate();
+    m_engine->setSampleRate(options.sampleRate);
+
+    std::shared_ptr<ISequencer> sequencer = m_engine->sequencer();
+    sequencer->setMIDITrack(BENCHMARK_TRACK, makeStream(options));
+    sequencer->rewind();
+    sequencer->play();
+
+    //! NOTE The audio buffer sets its own size before each fill
+    IAudioSourcePtr source = m_engine->mixer()->mixedSource();
+    source->setBufferSize(options.bufferSize);
+
+    using Clock = std::chrono::steady_clock;
+    result.deadlineUs = 1e6 * options.bufferSize / options.sampleRate;
+    result.callbacks = static_cast<unsigned int>(uint64_t(options.seconds) * options.sampleRate / options.bufferSize);
+
+    std::vector<double> times;
+    times.reserve(result.callbacks);
+    for (unsigned int i = 0; i < result.callbacks; ++i) {
+        Clock::time_point start = Clock::now();
+        source->forward(options.bufferSize);
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        times.push_back(us);
+
+        if (us > result.deadlineUs) {
+            if (result.misses == 0) {
+                unsigned int step = static_cast<unsigned int>(uint64_t(i) * options.bufferSize / options.sampleRate);
+                result.notesAtFirstMiss = notesAtStep(options, step);
+                result.channelsAtFirstMiss = std::min<unsigned int>(result.notesAtFirstMiss, options.channels);
+            }
+            ++result.misses;
+        }
+
+        size_t bucket = std::min<size_t>(HISTOGRAM_BUCKETS, static_cast<size_t>(us * HISTOGRAM_BUCKETS / result.deadlineUs));
+        ++result.histogram[bucket];
+    }
+
+    //! NOTE The stop is applied by the next forward, which also releases the notes
+    sequencer->stop();
+    source->forward(options.bufferSize);
+    sequencer->setMIDITrack(BENCHMARK_TRACK, std::make_shared<MidiStream>());
+    m_engine->setSampleRate(oldSampleRate);
+
+    if (!times.empty()) {
+        std::sort(times.begin(), times.end());
+        result.worstUs = times.back();
+        result.p50Us = times[times.size() / 2];
+        result.p99Us = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    }
+
+    LOGI() << "audio benchmark: " << result.toString();
+    return result;
+}
@@ -0,0 +1,75 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_AUDIOBENCHMARK_H
+#define MU_AUDIO_AUDIOBENCHMARK_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+class AudioEngine;
+
+//! NOTE Renders a dense MIDI stream through the sequencer, the mixer and the synthesizers,
+//! calling the mixer the way the audio driver callback does and timing each call against its deadline.
+//! Runs on the worker thread, the audio buffer is not filled meanwhile.
+class AudioBenchmark
+{
+public:
+    struct Options {
+        unsigned int sampleRate = 48000;
+        unsigned int bufferSize = 256;
+        unsigned int seconds = 20;
+        midi::channel_t channels = 16;
+        unsigned int notesPerStep = 8;  //! NOTE The notes per beat grow by this count every second
+    };
+
+    struct Result {
+        unsigned int callbacks = 0;
+        unsigned int misses = 0;
+        double deadlineUs = 0.0;
+        double worstUs = 0.0;
+        double p50Us = 0.0;
+        double p99Us = 0.0;
+
+        //! NOTE Tenths of the deadline, the last bucket counts the misses
+        std::vector<unsigned int> histogram;
+
+        //! NOTE Of the step of the first miss, 0 if there was no miss
+        unsigned int notesAtFirstMiss = 0;
+        unsigned int channelsAtFirstMiss = 0;
+
+        std::string toString() const;
+    };
+
+    explicit AudioBenchmark(AudioEngine* engine);
+
+    Result run(const Options& options);
+
+private:
+    std::shared_ptr<midi::MidiStream> makeStream(const Options& options) const;
+    unsigned int notesAtStep(const Options& options, unsigned int step) const;
+
+    AudioEngine* m_engine = nullptr;
+};
+}
+
+#endif // MU_AUDIO_AUDIOBENCHMARK_H
@@ -23,10 +23,14 @@
 #include "ptrutils.h"
 #include "audioerrors.h"
 #include "internal/audiosanitizer.h"
+#include "audioprocessorchain.h"
+#include "limiter.h"
 
 using namespace mu::audio;
 using namespace mu::audio::synth;
 
+static constexpr unsigned int MASTER_CHAIN_INSERT = 0;
+
 AudioEngine* AudioEngine::instance()
 {
     static AudioEngine e;
@@ -65,12 +69,22 @@ mu::Ret AudioEngine::init()
     m_mixer = std::make_shared<Mixer>();
     m_mixer->setClock(m_sequencer->clock());
 
+    //! NOTE The master bus ends with a limiter, so that a loud passage does not clip in the device
+    auto masterChain = std::make_shared<AudioProcessorChain>(m_mixer->streamCount());
+    masterChain->append(std::make_shared<Limiter>(m_mixer->streamCount()));
+    m_mixer->setProcessor(MASTER_CHAIN_INSERT, masterChain);
+
     m_buffer->setSource(m_mixer->mixedSource());
 
     m_sequencer->audioTrackAdded().onReceive(this, [this](Sequencer::AudioTrack player) {
         m_mixer->addChannel(player->audioSource());
     });
 
+    m_sequencer->midiTrackAdded().onReceive(this, [this](Sequencer::MidiTrack player) {
+        m_mixer->addChannel(player->frozenAudioSource());
+        m_mixer->addChannel(player->metronomeAudioSource());
+    });
+
     m_synthesizerController = std::make_shared<SynthesizerController>(synthesizersRegister(), soundFontsProvider());
     m_synthesizerController->init();
 
@@ -0,0 +1,410 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audiofilestream.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "log.h"
+
+//! NOTE The implementations of the decoders are compiled with AudioStream
+#include "thirdparty/dr_libs/dr_wav.h"
+#include "thirdparty/dr_libs/dr_mp3.h"
+#define STB_VORBIS_HEADER_ONLY
+#include "thirdparty/stb/stb_vorbis.c"
+
+using namespace mu::audio;
+
+namespace {
+class WavDecoder : public AudioFileStream::Decoder
+{
+public:
+    ~WavDecoder() override
+    {
+        if (m_isOpen) {
+            drwav_uninit(&m_wav);
+        }
+    }
+
+    bool open(const mu::io::path& path)
+    {
+        m_isOpen = drwav_init_file(&m_wav, path.c_str(), NULL);
+        if (!m_isOpen) {
+            return false;
+        }
+        channels = m_wav.channels;
+        sampleRate = m_wav.sampleRate;
+        frames = m_wav.totalPCMFrameCount;
+        return true;
+    }
+
+    bool seek(uint64_t frame) override
+    {
+        return drwav_seek_to_pcm_frame(&m_wav, frame);
+    }
+
+    uint64_t read(float* buffer, uint64_t count) override
+    {
+        return drwav_read_pcm_frames_f32(&m_wav, count, buffer);
+    }
+
+private:
+    drwav m_wav;
+    bool m_isOpen = false;
+};
+
+class Mp3Decoder : public AudioFileStream::Decoder
+{
+public:
+    ~Mp3Decoder() override
+    {
+        if (m_isOpen) {
+            drmp3_uninit(&m_mp3);
+        }
+    }
+
+    bool open(const mu::io::path& path)
+    {
+        m_isOpen = drmp3_init_file(&m_mp3, path.c_str(), NULL);
+        if (!m_isOpen) {
+            return false;
+        }
+        channels = m_mp3.channels;
+        sampleRate = m_mp3.sampleRate;
+        frames = drmp3_get_pcm_frame_count(&m_mp3);
+
+        //! NOTE A seek point per second, otherwise a seek decodes from the start of the file
+        drmp3_uint32 count = static_cast<drmp3_uint32>(std::min<uint64_t>(frames / std::max(sampleRate, 1u) + 1, 4096));
+        m_seekPoints.resize(count);
+        if (drmp3_calculate_seek_points(&m_mp3, &count, m_seekPoints.data())) {
+            m_seekPoints.resize(count);
+            drmp3_bind_seek_table(&m_mp3, count, m_seekPoints.data());
+        }
+        return true;
+    }
+
+    bool seek(uint64_t frame) override
+    {
+        return drmp3_seek_to_pcm_frame(&m_mp3, frame);
+    }
+
+    uint64_t read(float* buffer, uint64_t count) override
+    {
+        return drmp3_read_pcm_frames_f32(&m_mp3, count, buffer);
+    }
+
+private:
+    drmp3 m_mp3;
+    std::vector<drmp3_seek_point> m_seekPoints;
+    bool m_isOpen = false;
+};
+
+class OggDecoder : public AudioFileStream::Decoder
+{
+public:
+    ~OggDecoder() override
+    {
+        if (m_vorbis) {
+            stb_vorbis_close(m_vorbis);
+        }
+    }
+
+    bool open(const mu::io::path& path)
+    {
+        int error = 0;
+        m_vorbis = stb_vorbis_open_filename(path.c_str(), &error, NULL);
+        if (!m_vorbis) {
+            return false;
+        }
+        stb_vorbis_info info = stb_vorbis_get_info(m_vorbis);
+        channels = info.channels;
+        sampleRate = info.sample_rate;
+        frames = stb_vorbis_stream_length_in_samples(m_vorbis);
+        return true;
+    }
+
+    bool seek(uint64_t frame) override
+    {
+        return stb_vorbis_seek(m_vorbis, static_cast<unsigned int>(frame));
+    }
+
+    uint64_t read(float* buffer, uint64_t count) override
+    {
+        uint64_t done = 0;
+        while (done < count) {
+            int n = stb_vorbis_get_samples_float_interleaved(m_vorbis, channels, buffer + done * channels,
+                                                             static_cast<int>((count - done) * channels));
+            if (n <= 0) {
+                break;
+            }
+            done += n;
+        }
+        return done;
+    }
+
+private:
+    stb_vorbis* m_vorbis = nullptr;
+};
+
+template<typename T>
+std::unique_ptr<AudioFileStream::Decoder> openDecoder(const mu::io::path& path)
+{
+    auto decoder = std::make_unique<T>();
+    if (!decoder->open(path) || decoder->channels == 0 || decoder->sampleRate == 0) {
+        return nullptr;
+    }
+    return decoder;
+}
+}
+
+AudioFileStream::AudioFileStream()
+    : m_src(m_window, 0, 1, 1)
+{
+}
+
+AudioFileStream::~AudioFileStream()
+{
+    close();
+}
+
+bool AudioFileStream::loadFile(const io::path& path)
+{
+    close();
+
+    std::unique_ptr<Decoder> decoder = openDecoder<WavDecoder>(path);
+    if (!decoder) {
+        decoder = openDecoder<Mp3Decoder>(path);
+    }
+    if (!decoder) {
+        decoder = openDecoder<OggDecoder>(path);
+    }
+    if (!decoder) {
+        return false;
+    }
+
+    m_decoder = std::move(decoder);
+    m_channels = m_decoder->channels;
+    m_sampleRate = m_decoder->sampleRate;
+
+    m_src.setChannelCount(m_channels);
+    m_src.setSampleRateIn(m_sampleRate);
+    m_srcSampleRate = 0;
+    m_window.clear();
+    m_decodedFrame = -1;
+
+    m_stopping = false;
+    m_wantedBlock = 0;
+    setOutputRate(m_sampleRate);
+    m_thread = std::thread([this]() { decodeLoop(); });
+
+    return true;
+}
+
+void AudioFileStream::close()
+{
+    if (m_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+    m_decoder.reset();
+    m_channels = 0;
+    m_sampleRate = 0;
+}
+
+unsigned int AudioFileStream::channelsCount() const
+{
+    return m_channels;
+}
+
+unsigned int AudioFileStream::sampleRate() const
+{
+    return m_sampleRate;
+}
+
+void AudioFileStream::convertSampleRate(unsigned int sampleRate)
+{
+    if (!m_decoder) {
+        return;
+    }
+    m_sampleRate = sampleRate;
+    setOutputRate(sampleRate);
+}
+
+void AudioFileStream::setOutputRate(unsigned int sampleRate)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_outputRate == sampleRate) {
+            return;
+        }
+        m_outputRate = sampleRate;
+        m_outputFrames = m_decoder->frames * sampleRate / m_decoder->sampleRate;
+        ++m_generation;
+        for (Block& block : m_blocks) {
+            block.index = -1;
+        }
+    }
+    m_condition.notify_one();
+}
+
+unsigned int AudioFileStream::copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount,
+                                                  unsigned int sampleRate)
+{
+    if (!m_decoder) {
+        return 0;
+    }
+    setOutputRate(sampleRate);
+
+    {
+        //! NOTE The decoder thread holds the lock only to swap a decoded block in
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (fromSample >= m_outputFrames) {
+            return 0;
+        }
+        sampleCount = static_cast<unsigned int>(std::min<uint64_t>(sampleCount, m_outputFrames - fromSample));
+
+        unsigned int done = 0;
+        while (done < sampleCount) {
+            const uint64_t frame = fromSample + done;
+            const int64_t index = static_cast<int64_t>(frame / BLOCK_FRAMES);
+            const unsigned int offset = static_cast<unsigned int>(frame - index * BLOCK_FRAMES);
+            const unsigned int count = std::min(sampleCount - done, BLOCK_FRAMES - offset);
+
+            const Block& block = m_blocks[index % RING_BLOCKS];
+            float* out = buffer + done * m_channels;
+            if (block.index == index) {
+                std::copy_n(block.samples.begin() + offset * m_channels, count * m_channels, out);
+            } else {
+                std::fill_n(out, count * m_channels, 0.f);
+            }
+            done += count;
+        }
+        m_wantedBlock = static_cast<int64_t>((fromSample + sampleCount) / BLOCK_FRAMES);
+    }
+    m_condition.notify_one();
+
+    return sampleCount;
+}
+
+int64_t AudioFileStream::nextMissingBlock() const
+{
+    for (int64_t index = m_wantedBlock; index < m_wantedBlock + RING_BLOCKS; ++index) {
+        if (static_cast<uint64_t>(index) * BLOCK_FRAMES >= m_outputFrames) {
+            break;
+        }
+        if (m_blocks[index % RING_BLOCKS].index != index) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void AudioFileStream::decodeLoop()
+{
+    std::vector<float> samples;
+    for (;;) {
+        int64_t index = -1;
+        unsigned int generation = 0;
+        unsigned int sampleRate = 0;
+        unsigned int frames = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || nextMissingBlock() >= 0; });
+            if (m_stopping) {
+                return;
+            }
+            index = nextMissingBlock();
+            generation = m_generation;
+            sampleRate = m_outputRate;
+            frames = static_cast<unsigned int>(std::min<uint64_t>(BLOCK_FRAMES, m_outputFrames - index * BLOCK_FRAMES));
+        }
+
+        samples.resize(frames * m_channels);
+        decodeBlock(index, frames, sampleRate, samples.data());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (generation == m_generation && index >= m_wantedBlock && index < m_wantedBlock + RING_BLOCKS) {
+            Block& block = m_blocks[index % RING_BLOCKS];
+            std::swap(block.samples, samples);
+            block.index = index;
+        }
+    }
+}
+
+void AudioFileStream::decodeBlock(int64_t block, unsigned int frames, unsigned int sampleRate, float* out)
+{
+    const uint64_t from = static_cast<uint64_t>(block) * BLOCK_FRAMES;
+
+    if (sampleRate == m_decoder->sampleRate) {
+        if (m_decodedFrame != static_cast<int64_t>(from)) {
+            m_decoder->seek(from);
+        }
+        uint64_t read = m_decoder->read(out, frames);
+        std::fill(out + read * m_channels, out + frames * m_channels, 0.f);
+        m_decodedFrame = static_cast<int64_t>(from + read);
+        m_window.clear();
+        m_windowFirstFrame = m_decodedFrame;
+        return;
+    }
+
+    if (m_srcSampleRate != sampleRate) {
+        m_src.setSampleRateOut(sampleRate);
+        m_srcSampleRate = sampleRate;
+    }
+
+    int64_t first = 0;
+    int64_t last = 0;
+    m_src.inputRange(from, frames, first, last);
+    decodeInput(first, last);
+
+    m_src.setInputWindow(m_windowFirstFrame, static_cast<int64_t>(m_decoder->frames));
+    unsigned int converted = m_src.convert(out, static_cast<unsigned int>(from), frames);
+    std::fill(out + converted * m_channels, out + frames * m_channels, 0.f);
+}
+
+//! NOTE Keeps the input frames of the window the next block still needs,
+//! so that only the new ones are decoded while playing on
+void AudioFileStream::decodeInput(int64_t first, int64_t last)
+{
+    first = std::max<int64_t>(first, 0);
+    last = std::min<int64_t>(last, static_cast<int64_t>(m_decoder->frames) - 1);
+
+    const int64_t windowEnd = m_windowFirstFrame + static_cast<int64_t>(m_window.size() / m_channels);
+    if (m_decodedFrame == windowEnd && first >= m_windowFirstFrame && first <= windowEnd) {
+        m_window.erase(m_window.begin(), m_window.begin() + (first - m_windowFirstFrame) * m_channels);
+    } else {
+        m_window.clear();
+        m_decoder->seek(first);
+        m_decodedFrame = first;
+    }
+    m_windowFirstFrame = first;
+
+    if (last < m_decodedFrame) {
+        return;
+    }
+    const size_t size = m_window.size();
+    m_window.resize(size + (last + 1 - m_decodedFrame) * m_channels);
+    uint64_t read = m_decoder->read(m_window.data() + size, last + 1 - m_decodedFrame);
+    m_window.resize(size + read * m_channels);
+    m_decodedFrame += read;
+}
@@ -0,0 +1,102 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_AUDIOFILESTREAM_H
+#define MU_AUDIO_AUDIOFILESTREAM_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio/iaudiostream.h"
+#include "samplerateconvertor.h"
+
+namespace mu::audio {
+//! NOTE Plays a wav, mp3 or ogg file without loading it: a decoder thread fills a ring of blocks
+//! ahead of the position played, in the sample rate of the output, converted block by block.
+//! The memory of a stream does not depend on the length of the file
+class AudioFileStream : public IAudioStream
+{
+public:
+    AudioFileStream();
+    ~AudioFileStream() override;
+
+    bool loadFile(const mu::io::path& path) override;
+
+    unsigned int channelsCount() const override;
+    unsigned int sampleRate() const override;
+
+    //! the blocks are decoded in the sample rate from now on
+    void convertSampleRate(unsigned int sampleRate) override;
+
+    //! the frames of a block not decoded yet, as right after a seek, are silent
+    unsigned int copySamplesToBuffer(float* buffer, unsigned int fromSample, unsigned int sampleCount, unsigned int sampleRate) override;
+
+    struct Decoder {
+        virtual ~Decoder() = default;
+        virtual bool seek(uint64_t frame) = 0;
+        virtual uint64_t read(float* buffer, uint64_t frames) = 0;
+
+        unsigned int channels = 0;
+        unsigned int sampleRate = 0;
+        uint64_t frames = 0;
+    };
+
+private:
+    struct Block {
+        int64_t index = -1;
+        std::vector<float> samples;
+    };
+
+    const static unsigned int BLOCK_FRAMES = 8192;
+    const static unsigned int RING_BLOCKS = 8;
+
+    void close();
+    void setOutputRate(unsigned int sampleRate);
+    int64_t nextMissingBlock() const;
+
+    void decodeLoop();
+    void decodeBlock(int64_t block, unsigned int frames, unsigned int sampleRate, float* out);
+    void decodeInput(int64_t first, int64_t last);
+
+    //! the decoder, the window and the convertor are used by the decoder thread only
+    std::unique_ptr<Decoder> m_decoder;
+    std::vector<float> m_window;
+    int64_t m_windowFirstFrame = 0;
+    int64_t m_decodedFrame = 0;
+    SampleRateConvertor m_src;
+    unsigned int m_srcSampleRate = 0;
+
+    unsigned int m_channels = 0;
+    unsigned int m_sampleRate = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    Block m_blocks[RING_BLOCKS];
+    int64_t m_wantedBlock = 0;
+    unsigned int m_outputRate = 0;
+    uint64_t m_outputFrames = 0;
+    unsigned int m_generation = 0;
+    bool m_stopping = false;
+};
+}
+
+#endif // MU_AUDIO_AUDIOFILESTREAM_H
@@ -60,6 +60,7 @@ mu::Ret AudioPlayer::load(const std::shared_ptr<IAudioStream>& stream)
     setStatus(Stoped);
     m_position = 0;
     m_stream = stream;
+    setupStretcher();
     m_streamsCountChanged.send(streamCount());
 
     return Ret(Ret::Code::Ok);
@@ -70,6 +71,28 @@ IAudioSourcePtr AudioPlayer::audioSource()
     return shared_from_this();
 }
 
+void AudioPlayer::setPlaybackSpeed(float speed)
+{
+    if (m_playSpeed == speed) {
+        return;
+    }
+    m_playSpeed = speed;
+    m_stretcher.setSpeed(speed);
+    m_stretcher.reset();
+}
+
+void AudioPlayer::setSampleRate(unsigned int sampleRate)
+{
+    AbstractAudioSource::setSampleRate(sampleRate);
+    setupStretcher();
+}
+
+void AudioPlayer::setupStretcher()
+{
+    m_stretcher.setup(m_stream ? m_stream->channelsCount() : 0, m_sampleRate);
+    m_stretcher.setSpeed(m_playSpeed);
+}
+
 void AudioPlayer::run()
 {
     if (m_stream && status() != Status::Error) {
@@ -81,6 +104,7 @@ void AudioPlayer::seek(unsigned long milliseconds)
 {
     if (m_stream) {
         m_position = milliseconds * m_stream->sampleRate() / 1000;
+        m_stretcher.reset();
     }
 }
 
@@ -135,10 +159,31 @@ void AudioPlayer::forward(unsigned int sampleCount)
         return;
     }
 
-    auto displacement = stream->copySamplesToBuffer(m_buffer.data(), m_position, sampleCount, m_sampleRate);
-    m_position += displacement;
+    unsigned int displacement = 0;
+    if (m_playSpeed == 1.f) {
+        displacement = stream->copySamplesToBuffer(m_buffer.data(), m_position, sampleCount, m_sampleRate);
+        m_position += displacement;
+    } else {
+        displacement = forwardStretched(*stream, sampleCount);
+    }
 
     if (!displacement) {
         setStatus(Stoped);
     }
 }
+
+//! NOTE The stretcher pulls the input it needs ahead of the output, so the position is a few ms ahead
+unsigned int AudioPlayer::forwardStretched(IAudioStream& stream, unsigned int sampleCount)
+{
+    while (m_stretcher.outputAvailable() < sampleCount) {
+        unsigned int needed = m_stretcher.inputNeeded();
+        m_stretchInput.resize(needed * stream.channelsCount());
+        unsigned int read = stream.copySamplesToBuffer(m_stretchInput.data(), m_position, needed, m_sampleRate);
+        if (!read) {
+            break;
+        }
+        m_position += read;
+        m_stretcher.putInput(m_stretchInput.data(), read);
+    }
+    return m_stretcher.takeOutput(m_buffer.data(), sampleCount);
+}
@@ -21,6 +21,7 @@
 
 #include "iaudioplayer.h"
 #include "abstractaudiosource.h"
+#include "timestretcher.h"
 
 namespace mu::audio {
 class AudioPlayer : public IAudioPlayer, public AbstractAudioSource, public std::enable_shared_from_this<AudioPlayer>
@@ -46,18 +47,26 @@ public:
     void unload() override;
     Ret load(const std::shared_ptr<audio::IAudioStream>& stream) override;
     IAudioSourcePtr audioSource() override;
+    void setPlaybackSpeed(float speed) override;
 
     // IAudioSource (AbstractAudioSource)
+    void setSampleRate(unsigned int sampleRate) override;
     unsigned int streamCount() const override;
     void forward(unsigned int sampleCount) override;
 
 private:
     void setStatus(const Status& status);
+    void setupStretcher();
+    unsigned int forwardStretched(IAudioStream& stream, unsigned int sampleCount);
 
     Status m_status = Status::Stoped;
     async::Channel<Status> m_statusChanged;
     std::shared_ptr<audio::IAudioStream> m_stream = nullptr;
     unsigned long m_position = 0;
+
+    float m_playSpeed = 1.f;
+    TimeStretcher m_stretcher;
+    std::vector<float> m_stretchInput;
 };
 }
 
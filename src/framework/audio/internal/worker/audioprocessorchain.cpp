@@ -0,0 +1,99 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audioprocessorchain.h"
+
+#include <cstring>
+
+#include "log.h"
+
+using namespace mu::audio;
+
+AudioProcessorChain::AudioProcessorChain(unsigned int streamCount)
+    : m_streamCount(streamCount)
+{
+}
+
+unsigned int AudioProcessorChain::streamCount() const
+{
+    return m_streamCount;
+}
+
+void AudioProcessorChain::setSampleRate(unsigned int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    for (IAudioProcessorPtr& processor : m_processors) {
+        processor->setSampleRate(sampleRate);
+    }
+}
+
+bool AudioProcessorChain::active() const
+{
+    return m_active;
+}
+
+void AudioProcessorChain::setActive(bool active)
+{
+    m_active = active;
+}
+
+size_t AudioProcessorChain::size() const
+{
+    return m_processors.size();
+}
+
+IAudioProcessorPtr AudioProcessorChain::processor(size_t index) const
+{
+    IF_ASSERT_FAILED(index < m_processors.size()) {
+        return nullptr;
+    }
+    return m_processors[index];
+}
+
+void AudioProcessorChain::append(IAudioProcessorPtr processor)
+{
+    IF_ASSERT_FAILED(processor && processor->streamCount() == m_streamCount) {
+        LOGE() << "Processor's stream count not equal to the chain";
+        return;
+    }
+    if (m_sampleRate) {
+        processor->setSampleRate(m_sampleRate);
+    }
+    m_processors.push_back(processor);
+}
+
+void AudioProcessorChain::remove(size_t index)
+{
+    IF_ASSERT_FAILED(index < m_processors.size()) {
+        return;
+    }
+    m_processors.erase(m_processors.begin() + index);
+}
+
+void AudioProcessorChain::process(float* input, float* output, unsigned int sampleCount)
+{
+    if (input != output) {
+        std::memcpy(output, input, sampleCount * m_streamCount * sizeof(float));
+    }
+
+    for (IAudioProcessorPtr& processor : m_processors) {
+        if (processor->active()) {
+            processor->process(output, output, sampleCount);
+        }
+    }
+}
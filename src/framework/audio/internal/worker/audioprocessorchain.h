@@ -0,0 +1,56 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_AUDIOPROCESSORCHAIN_H
+#define MU_AUDIO_AUDIOPROCESSORCHAIN_H
+
+#include <vector>
+
+#include "iaudioprocessor.h"
+
+namespace mu::audio {
+//! NOTE The processors of a bus one after another, as one insert of the mixer or a channel.
+//! They process the block in place, the chain is changed on the worker thread between the blocks
+class AudioProcessorChain : public IAudioProcessor
+{
+public:
+    explicit AudioProcessorChain(unsigned int streamCount);
+
+    unsigned int streamCount() const override;
+    void setSampleRate(unsigned int sampleRate) override;
+
+    bool active() const override;
+    void setActive(bool active) override;
+
+    size_t size() const;
+    IAudioProcessorPtr processor(size_t index) const;
+    void append(IAudioProcessorPtr processor);
+    void remove(size_t index);
+
+    void process(float* input, float* output, unsigned int sampleCount) override;
+
+private:
+    unsigned int m_streamCount = 0;
+    unsigned int m_sampleRate = 0;
+    bool m_active = true;
+
+    std::vector<IAudioProcessorPtr> m_processors;
+};
+}
+
+#endif // MU_AUDIO_AUDIOPROCESSORCHAIN_H
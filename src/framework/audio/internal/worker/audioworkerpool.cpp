@@ -0,0 +1,149 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "audioworkerpool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "log.h"
+#include "runtime.h"
+#include "internal/audiosanitizer.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif !defined(Q_OS_WASM)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace mu::audio;
+
+static void setRealtimePriority()
+{
+#if defined(Q_OS_WIN)
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+#elif !defined(Q_OS_WASM)
+    //! NOTE Usually not allowed without privileges, then the workers keep the normal priority
+    sched_param param;
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        LOGD() << "no realtime priority for the audio worker pool";
+    }
+#endif
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    setThreadCount(1);
+}
+
+void AudioWorkerPool::setThreadCount(unsigned int count)
+{
+#if defined(Q_OS_WASM) && !defined(__EMSCRIPTEN_PTHREADS__)
+    count = 1;
+#endif
+    count = std::max(1u, count);
+    if (count == threadCount()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_started.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+
+    m_workers.clear();
+    m_quit = false;
+
+    for (size_t i = 1; i < count; ++i) {
+        m_workers.emplace_back(&AudioWorkerPool::workerLoop, this, i, m_generation);
+    }
+}
+
+unsigned int AudioWorkerPool::threadCount() const
+{
+    return static_cast<unsigned int>(m_workers.size()) + 1;
+}
+
+void AudioWorkerPool::workerLoop(size_t index, unsigned int generation)
+{
+    mu::runtime::setThreadName("audio_pool_" + std::to_string(index));
+    AudioSanitizer::setupWorkerHelperThread();
+    setRealtimePriority();
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_started.wait(lock, [this, generation]() { return m_quit || m_generation != generation; });
+            if (m_quit) {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        {
+            AUDIO_REALTIME_SCOPE;
+            runJobs();
+        }
+        m_busyWorkers.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void AudioWorkerPool::runJobs()
+{
+    for (;;) {
+        size_t index = m_nextJob.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= m_jobCount) {
+            return;
+        }
+        m_job(m_context, index);
+    }
+}
+
+void AudioWorkerPool::run(size_t jobCount, Job job, void* context)
+{
+    if (m_workers.empty() || jobCount < 2) {
+        for (size_t i = 0; i < jobCount; ++i) {
+            job(context, i);
+        }
+        return;
+    }
+
+    m_job = job;
+    m_context = context;
+    m_jobCount = jobCount;
+    m_nextJob.store(0, std::memory_order_relaxed);
+    m_busyWorkers.store(static_cast<int>(m_workers.size()), std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_generation;
+    }
+    m_started.notify_all();
+
+    runJobs();
+
+    //! NOTE Also waits for the workers which come too late to take a job, so none of them is left in the jobs of this run
+    while (m_busyWorkers.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
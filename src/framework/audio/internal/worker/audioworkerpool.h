@@ -0,0 +1,64 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_AUDIOWORKERPOOL_H
+#define MU_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE Runs a number of independent jobs on the calling thread and the workers at once.
+//! There is no fixed share: each thread takes the next job nobody has taken, so the threads done
+//! with their jobs take over the rest of a busy one. run() returns when all jobs are done
+class AudioWorkerPool
+{
+public:
+    using Job = void (*)(void* context, size_t index);
+
+    AudioWorkerPool() = default;
+    ~AudioWorkerPool();
+
+    //! count includes the calling thread
+    void setThreadCount(unsigned int count);
+    unsigned int threadCount() const;
+
+    void run(size_t jobCount, Job job, void* context);
+
+private:
+    void workerLoop(size_t index, unsigned int generation);
+    void runJobs();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_started;
+    unsigned int m_generation = 0;
+    bool m_quit = false;
+    std::atomic<int> m_busyWorkers { 0 };
+
+    Job m_job = nullptr;
+    void* m_context = nullptr;
+    size_t m_jobCount = 0;
+    std::atomic<size_t> m_nextJob { 0 };
+};
+}
+
+#endif // MU_AUDIO_AUDIOWORKERPOOL_H
@@ -44,8 +44,15 @@ void Clock::setSampleRate(unsigned int sampleRate)
     m_sampleRate = sampleRate;
 }
 
+unsigned int Clock::sampleRate() const
+{
+    return m_sampleRate;
+}
+
 void Clock::forward(Clock::time_t samples)
 {
+    m_forwardedSamples = samples;
+    setForwardedSection(0, samples);
     auto deltaMiliseconds = samples * 1000 / m_sampleRate;
     runCallbacks(m_beforeCallbacks, deltaMiliseconds);
 
@@ -56,6 +63,27 @@ void Clock::forward(Clock::time_t samples)
     }
 }
 
+Clock::time_t Clock::forwardedSamples() const
+{
+    return m_forwardedSamples;
+}
+
+void Clock::setForwardedSection(time_t offset, time_t samples)
+{
+    m_sectionOffset = offset;
+    m_sectionSamples = samples;
+}
+
+Clock::time_t Clock::forwardedSectionOffset() const
+{
+    return m_sectionOffset;
+}
+
+Clock::time_t Clock::forwardedSectionSamples() const
+{
+    return m_sectionSamples;
+}
+
 void Clock::start()
 {
     m_status = Running;
@@ -53,6 +53,17 @@ public:
     void setSampleRate(unsigned int sampleRate);
     void forward(time_t samples);
 
+    //! return the samples of the block being forwarded, valid in the callbacks
+    time_t forwardedSamples() const;
+
+    //! the part of the forwarded block the players fill now, as the parts before and after
+    //! a loop jump; the whole block unless set in the callbacks
+    void setForwardedSection(time_t offset, time_t samples);
+    time_t forwardedSectionOffset() const;
+    time_t forwardedSectionSamples() const;
+
+    unsigned int sampleRate() const;
+
     void start();
     void reset();
     void stop();
@@ -70,6 +81,9 @@ private:
 
     std::atomic<Status> m_status = Stoped;
     time_t m_time = 0;
+    time_t m_forwardedSamples = 0;
+    time_t m_sectionOffset = 0;
+    time_t m_sectionSamples = 0;
     unsigned int m_sampleRate = 1;
 
     async::Channel<time_t> m_timeChanged;
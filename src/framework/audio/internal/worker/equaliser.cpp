@@ -18,22 +18,28 @@
 //=============================================================================
 #include "equaliser.h"
 #include "log.h"
+#include "mixkernels.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 using namespace mu::audio;
 
-Equaliser::Equaliser()
+Equaliser::Equaliser(unsigned int streamCount, unsigned int bandCount)
+    : m_streamCount(streamCount == 2 ? 2 : 1), m_bands(std::max(1u, bandCount))
 {
 }
 
 unsigned int Equaliser::streamCount() const
 {
-    return 1;
+    return m_streamCount;
 }
 
 void Equaliser::setSampleRate(unsigned int sampleRate)
 {
     m_sampleRate = sampleRate;
-    calculate();
+    for (Band& band : m_bands) {
+        calculate(band);
+    }
 }
 
 bool Equaliser::active() const
@@ -46,53 +52,72 @@ void Equaliser::setActive(bool active)
     m_active = active;
 }
 
-void Equaliser::process(float* input, float* output, unsigned int sampleCount)
+unsigned int Equaliser::bandCount() const
+{
+    return static_cast<unsigned int>(m_bands.size());
+}
+
+void Equaliser::setBand(unsigned int band, float frequency, float gain, float q)
 {
-    for (unsigned int i = 0; i < sampleCount; ++i) {
-        m_x[2] = m_x[1];
-        m_x[1] = m_x[0];
-        m_x[0] = input[i];
+    IF_ASSERT_FAILED(band < m_bands.size()) {
+        return;
+    }
+    m_bands[band].frequency = frequency;
+    m_bands[band].gain = gain;
+    m_bands[band].q = q;
+    calculate(m_bands[band]);
+}
 
-        m_y[2] = m_y[1];
-        m_y[1] = m_y[0];
-        m_y[0] = (m_b[2] * m_x[2] + m_b[1] * m_x[1] + m_b[0] * m_x[0] - m_a[1] * m_y[1] - m_a[2] * m_y[2]) / m_a[0];
+void Equaliser::process(float* input, float* output, unsigned int sampleCount)
+{
+    if (input != output) {
+        std::memcpy(output, input, sampleCount * m_streamCount * sizeof(float));
+    }
 
-        output[i] = m_y[0];
+    for (Band& band : m_bands) {
+        if (band.gain == 0.f) {
+            continue;
+        }
+        if (m_streamCount == 2) {
+            mixkernels::biquadStereo(output, sampleCount, band.coeffs, band.state);
+        } else {
+            mixkernels::biquadMono(output, sampleCount, band.coeffs, band.state);
+        }
     }
 }
 
-void Equaliser::calculate()
+void Equaliser::calculate(Band& band)
 {
     if (!m_sampleRate) {
         return;
     }
-    float a = std::pow(10.f, m_gain / 40.f);
-    float w0 = 2 * M_PI * m_frequency / m_sampleRate;
-    float alpha = std::sin(w0) * a / (2 * m_q);
-
-    m_b[0] = 1 + alpha * a;
-    m_b[1] = -2 * std::cos(w0);
-    m_b[2] = 1 - alpha * a;
+    float a = std::pow(10.f, band.gain / 40.f);
+    float w0 = 2 * M_PI * band.frequency / m_sampleRate;
+    float alpha = std::sin(w0) * a / (2 * band.q);
+    float cosw0 = std::cos(w0);
 
-    m_a[0] = 1 + alpha / a;
-    m_a[1] = -2 * std::cos(w0);
-    m_a[2] = 1 - alpha / a;
+    float a0 = 1 + alpha / a;
+    band.coeffs[0] = (1 + alpha * a) / a0;
+    band.coeffs[1] = -2 * cosw0 / a0;
+    band.coeffs[2] = (1 - alpha * a) / a0;
+    band.coeffs[3] = -2 * cosw0 / a0;
+    band.coeffs[4] = (1 - alpha / a) / a0;
 }
 
 void mu::audio::Equaliser::setFrequency(float value)
 {
-    m_frequency = value;
-    calculate();
+    m_bands.front().frequency = value;
+    calculate(m_bands.front());
 }
 
 void mu::audio::Equaliser::setGain(float value)
 {
-    m_gain = value;
-    calculate();
+    m_bands.front().gain = value;
+    calculate(m_bands.front());
 }
 
 void mu::audio::Equaliser::setQ(float value)
 {
-    m_q = value;
-    calculate();
+    m_bands.front().q = value;
+    calculate(m_bands.front());
 }
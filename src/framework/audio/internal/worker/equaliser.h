@@ -19,13 +19,17 @@
 #ifndef MU_AUDIO_EQUALISER_H
 #define MU_AUDIO_EQUALISER_H
 
+#include <vector>
+
 #include "iaudioprocessor.h"
 
 namespace mu::audio {
+//! NOTE A cascade of peaking filters on one stream or on interleaved stereo, the channels of which
+//! are filtered at the same time. The set functions without a band are about the first one
 class Equaliser : public IAudioProcessor
 {
 public:
-    Equaliser();
+    explicit Equaliser(unsigned int streamCount = 1, unsigned int bandCount = 1);
 
     unsigned int streamCount() const override;
     void setSampleRate(unsigned int sampleRate) override;
@@ -37,19 +41,27 @@ public:
     void setGain(float value);
     void setQ(float value);
 
+    unsigned int bandCount() const;
+    void setBand(unsigned int band, float frequency, float gain, float q);
+
     void process(float* input, float* output, unsigned int sampleCount) override;
 
 private:
-    void calculate();
+    struct Band {
+        float frequency = 1'000.f;
+        float gain = 0;
+        float q = 1.f;
+        float coeffs[5] = { 1, 0, 0, 0, 0 }; // b0, b1, b2, a1, a2 normalized by a0
+        float state[4] = { 0, 0, 0, 0 };
+    };
+
+    void calculate(Band& band);
 
+    unsigned int m_streamCount = 1;
     unsigned int m_sampleRate = 0;
     bool m_active = true;
 
-    float m_gain = 0, m_frequency = 1'000.f, m_q = 1.f;
-    float m_a[3] = { 0, 0, 0 };
-    float m_b[3] = { 0, 0, 0 };
-    float m_x[3] = { 0, 0, 0 };
-    float m_y[3] = { 0, 0, 0 };
+    std::vector<Band> m_bands;
 };
 }
 
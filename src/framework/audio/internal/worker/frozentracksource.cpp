@@ -0,0 +1,572 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "frozentracksource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+#include "log.h"
+#include "runtime.h"
+#include "internal/audiosanitizer.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+static const unsigned int FROZEN_TAIL_MSEC = 3000;          // rendered after the last event of a chunk, for releases and reverb
+static const size_t MAX_CACHE_BYTES = 256 * 1024 * 1024;
+static const float SILENCE_LEVEL = 1.0e-5f;                 // -100 dB, the tail below is not stored
+
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    //! NOTE FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template<typename T>
+static uint64_t hashValue(uint64_t hash, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "the value must be hashed as bytes");
+    return hashBytes(hash, &value, sizeof(T));
+}
+
+static uint64_t hashString(uint64_t hash, const std::string& str)
+{
+    hash = hashValue(hash, str.size());
+    return hashBytes(hash, str.data(), str.size());
+}
+
+static bool isNoteOn(const Event& event)
+{
+    return event.isChannelVoice() && event.opcode() == Event::Opcode::NoteOn;
+}
+
+FrozenTrackSource::FrozenTrackSource()
+{
+}
+
+FrozenTrackSource::~FrozenTrackSource()
+{
+    if (m_renderThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_jobsMutex);
+            m_stopping = true;
+        }
+        m_jobsCondition.notify_all();
+        m_renderThread.join();
+    }
+}
+
+void FrozenTrackSource::setMidiData(const MidiData& data)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_data = data;
+    m_data.chunks.clear();
+
+    m_channelTracks.clear();
+    for (const Track& t : m_data.tracks) {
+        for (channel_t ch : t.channels) {
+            m_channelTracks[ch] = t.num;
+        }
+    }
+
+    for (auto it = m_tracks.begin(); it != m_tracks.end();) {
+        auto found = std::find_if(m_data.tracks.cbegin(), m_data.tracks.cend(), [&it](const Track& t) {
+            return t.num == it->first;
+        });
+
+        if (found == m_data.tracks.cend()) {
+            it = m_tracks.erase(it);
+            continue;
+        }
+
+        it->second.channels = std::set<channel_t>(found->channels.cbegin(), found->channels.cend());
+        it->second.segments.clear();
+        for (const auto& chunk : data.chunks) {
+            updateSegment(it->second, chunk.second);
+        }
+        ++it;
+    }
+}
+
+void FrozenTrackSource::setIsTrackFrozen(track_t trackIndex, bool frozen, const Chunks& chunks)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (!frozen) {
+        m_tracks.erase(trackIndex);
+        return;
+    }
+
+    if (m_tracks.find(trackIndex) != m_tracks.end()) {
+        return;
+    }
+
+    auto found = std::find_if(m_data.tracks.cbegin(), m_data.tracks.cend(), [trackIndex](const Track& t) {
+        return t.num == trackIndex;
+    });
+
+    IF_ASSERT_FAILED(found != m_data.tracks.cend()) {
+        return;
+    }
+
+    FrozenTrack& track = m_tracks[trackIndex];
+    track.channels = std::set<channel_t>(found->channels.cbegin(), found->channels.cend());
+    for (const auto& chunk : chunks) {
+        updateSegment(track, chunk.second);
+    }
+}
+
+void FrozenTrackSource::setIsTrackMuted(track_t trackIndex, bool mute)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    auto it = m_tracks.find(trackIndex);
+    if (it != m_tracks.end()) {
+        it->second.muted = mute;
+    }
+}
+
+void FrozenTrackSource::updateChunk(const Chunk& chunk)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    for (auto& it : m_tracks) {
+        updateSegment(it.second, chunk);
+    }
+}
+
+bool FrozenTrackSource::isFrozen(channel_t ch, tick_t tick) const
+{
+    if (m_tracks.empty() || m_playSpeed != 1.f) {
+        return false;
+    }
+
+    auto trackIt = m_channelTracks.find(ch);
+    if (trackIt == m_channelTracks.end()) {
+        return false;
+    }
+
+    auto it = m_tracks.find(trackIt->second);
+    if (it == m_tracks.end()) {
+        return false;
+    }
+
+    const std::map<tick_t, Segment>& segments = it->second.segments;
+    auto segIt = segments.upper_bound(tick);
+    if (segIt == segments.begin()) {
+        return false;
+    }
+
+    --segIt;
+    const Segment& segment = segIt->second;
+    return tick < segment.endTick && segment.ready && !segment.deferred;
+}
+
+void FrozenTrackSource::setIsRunning(bool running)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_isRunning = running;
+    if (!running) {
+        resetSegments();
+    }
+}
+
+void FrozenTrackSource::setPlaybackSpeed(float speed)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    //! NOTE The audio is rendered at the normal speed, at any other speed the tracks are played by the synth
+    m_playSpeed = speed;
+}
+
+void FrozenTrackSource::seek(unsigned long milliseconds)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_position = uint64_t(milliseconds) * m_sampleRate / 1000;
+    resetSegments();
+}
+
+void FrozenTrackSource::setSampleRate(unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (m_sampleRate == sampleRate) {
+        return;
+    }
+
+    AbstractAudioSource::setSampleRate(sampleRate);
+
+    //! NOTE The sample rate is a part of the key, all audio must be rendered again
+    for (auto& it : m_tracks) {
+        std::vector<Chunk> chunks;
+        for (const auto& segment : it.second.segments) {
+            chunks.push_back(segment.second.chunk);
+        }
+
+        it.second.segments.clear();
+        for (const Chunk& chunk : chunks) {
+            updateSegment(it.second, chunk);
+        }
+    }
+}
+
+unsigned int FrozenTrackSource::streamCount() const
+{
+    return AUDIO_CHANNELS;
+}
+
+void FrozenTrackSource::forward(unsigned int sampleCount)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (m_hasResults) {
+        takeResults();
+    }
+
+    std::fill(m_buffer.begin(), m_buffer.begin() + std::min<size_t>(m_buffer.size(), sampleCount * AUDIO_CHANNELS), 0.f);
+
+    if (!m_isRunning) {
+        return;
+    }
+
+    if (m_playSpeed == 1.f) {
+        for (const auto& track : m_tracks) {
+            if (track.second.muted) {
+                continue;
+            }
+
+            for (const auto& it : track.second.segments) {
+                const Segment& segment = it.second;
+                if (segment.ready && !segment.deferred && segment.audio) {
+                    mixSegment(*segment.audio, m_position, sampleCount);
+                }
+            }
+        }
+    }
+
+    m_position += sampleCount;
+}
+
+void FrozenTrackSource::mixSegment(const Audio& audio, uint64_t from, unsigned int sampleCount)
+{
+    uint64_t begin = std::max(from, audio.startSample);
+    uint64_t end = std::min(from + sampleCount, audio.endSample());
+    if (begin >= end) {
+        return;
+    }
+
+    float* dst = m_buffer.data() + (begin - from) * AUDIO_CHANNELS;
+    const int16_t* src = audio.samples.data() + (begin - audio.startSample) * AUDIO_CHANNELS;
+    size_t count = (end - begin) * AUDIO_CHANNELS;
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i] * audio.scale;
+    }
+}
+
+uint64_t FrozenTrackSource::chunkKey(const FrozenTrack& track, const Chunk& chunk) const
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    hash = hashValue(hash, m_sampleRate);
+    hash = hashValue(hash, m_data.division);
+    for (const auto& tempo : m_data.tempoMap) {
+        hash = hashValue(hash, tempo.first);
+        hash = hashValue(hash, tempo.second);
+    }
+
+    hash = hashValue(hash, chunk.beginTick);
+    hash = hashValue(hash, chunk.endTick);
+    for (auto it = chunk.events.begin(); it != chunk.events.end(); ++it) {
+        if (track.channels.find(it->second.channel()) != track.channels.end()) {
+            hash = hashValue(hash, it->first);
+            hash = hashValue(hash, it->second);
+        }
+    }
+
+    //! NOTE The synth state: the channel setup, the synths and their sound fonts
+    for (const Event& e : m_data.initEventsForChannels(track.channels)) {
+        hash = hashValue(hash, e);
+    }
+
+    ISynthesizerPtr defaultSynth = synthesizersRegister()->defaultSynthesizer();
+    std::set<SynthName> synths;
+    for (channel_t ch : track.channels) {
+        auto it = m_data.synthMap.find(ch);
+        synths.insert(it != m_data.synthMap.end() ? it->second : (defaultSynth ? defaultSynth->name() : SynthName()));
+    }
+
+    for (const SynthName& name : synths) {
+        hash = hashString(hash, name);
+        for (const io::path& path : soundFontsProvider()->soundFontPathsForSynth(name)) {
+            hash = hashString(hash, path.toStdString());
+        }
+    }
+
+    return hash;
+}
+
+void FrozenTrackSource::updateSegment(FrozenTrack& track, const Chunk& chunk)
+{
+    if (chunk.endTick <= chunk.beginTick) {
+        return;
+    }
+
+    uint64_t key = chunkKey(track, chunk);
+
+    auto it = track.segments.find(chunk.beginTick);
+    if (it != track.segments.end() && it->second.key == key && it->second.endTick == chunk.endTick) {
+        return;
+    }
+
+    //! NOTE The chunks partition may have changed, so remove everything the new chunk overlaps
+    it = track.segments.upper_bound(chunk.beginTick);
+    if (it != track.segments.begin()) {
+        --it;
+    }
+    while (it != track.segments.end() && it->first < chunk.endTick) {
+        if (it->second.endTick > chunk.beginTick) {
+            it = track.segments.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    Segment& segment = track.segments[chunk.beginTick];
+    segment.key = key;
+    segment.endTick = chunk.endTick;
+    segment.chunk.beginTick = chunk.beginTick;
+    segment.chunk.endTick = chunk.endTick;
+
+    Job job;
+    job.key = key;
+    job.sampleRate = m_sampleRate;
+    job.toTick = chunk.beginTick;
+
+    bool hasNotes = false;
+    for (auto e = chunk.events.begin(); e != chunk.events.end(); ++e) {
+        if (track.channels.find(e->second.channel()) != track.channels.end()) {
+            segment.chunk.events.insert({ e->first, e->second });
+            job.toTick = std::max(job.toTick, e->first);
+            hasNotes = hasNotes || isNoteOn(e->second);
+        }
+    }
+
+    if (!hasNotes) {
+        makeReady(segment, nullptr);
+        return;
+    }
+
+    if (AudioPtr audio = cachedAudio(key)) {
+        makeReady(segment, audio);
+        return;
+    }
+
+    if (!m_pendingKeys.insert(key).second) {
+        return;
+    }
+
+    job.data.division = m_data.division;
+    job.data.tempoMap = m_data.tempoMap;
+    job.data.synthMap = m_data.synthMap;
+    job.data.initEvents = m_data.initEventsForChannels(track.channels);
+    job.data.tracks.push_back({ m_channelTracks[*track.channels.begin()], std::vector<channel_t>(track.channels.cbegin(),
+                                                                                                 track.channels.cend()) });
+    job.data.chunks.insert({ chunk.beginTick, segment.chunk });
+
+    queueJob(std::move(job));
+}
+
+void FrozenTrackSource::resetSegments()
+{
+    for (auto& track : m_tracks) {
+        for (auto& it : track.second.segments) {
+            it.second.deferred = false;
+        }
+    }
+}
+
+void FrozenTrackSource::makeReady(Segment& segment, const AudioPtr& audio)
+{
+    segment.ready = true;
+    segment.audio = audio;
+
+    //! NOTE If the playback has passed the start of the audio, the notes have been sent to the synth already
+    segment.deferred = audio && m_isRunning && m_position > audio->startSample;
+}
+
+void FrozenTrackSource::readyAudio(uint64_t key, const AudioPtr& audio)
+{
+    m_pendingKeys.erase(key);
+    if (!audio) {
+        return;
+    }
+
+    cacheAudio(key, audio);
+
+    for (auto& track : m_tracks) {
+        for (auto& it : track.second.segments) {
+            Segment& segment = it.second;
+            if (segment.key == key && !segment.ready) {
+                makeReady(segment, audio);
+            }
+        }
+    }
+}
+
+void FrozenTrackSource::cacheAudio(uint64_t key, const AudioPtr& audio)
+{
+    CacheItem& item = m_cache[key];
+    if (item.audio) {
+        m_cacheBytes -= item.audio->samples.size() * sizeof(int16_t);
+    }
+    item.audio = audio;
+    item.lastUse = ++m_useCounter;
+    m_cacheBytes += audio->samples.size() * sizeof(int16_t);
+
+    //! NOTE The least recently used audio is removed first, the segments playing it keep it alive
+    while (m_cacheBytes > MAX_CACHE_BYTES && m_cache.size() > 1) {
+        auto oldest = std::min_element(m_cache.begin(), m_cache.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUse < b.second.lastUse;
+        });
+        m_cacheBytes -= oldest->second.audio->samples.size() * sizeof(int16_t);
+        m_cache.erase(oldest);
+    }
+}
+
+FrozenTrackSource::AudioPtr FrozenTrackSource::cachedAudio(uint64_t key)
+{
+    auto it = m_cache.find(key);
+    if (it == m_cache.end()) {
+        return nullptr;
+    }
+
+    it->second.lastUse = ++m_useCounter;
+    return it->second.audio;
+}
+
+void FrozenTrackSource::takeResults()
+{
+    //! NOTE Called from the audio loop, it does not wait for the render thread
+    std::unique_lock<std::mutex> lock(m_jobsMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    std::vector<Result> results;
+    results.swap(m_results);
+    m_hasResults = false;
+    lock.unlock();
+
+    for (const Result& result : results) {
+        readyAudio(result.key, result.audio);
+    }
+}
+
+void FrozenTrackSource::queueJob(Job job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_jobs.push_back(std::move(job));
+    }
+
+    if (!m_renderThread.joinable()) {
+        m_renderThread = std::thread([this]() { renderLoop(); });
+    }
+
+    m_jobsCondition.notify_one();
+}
+
+void FrozenTrackSource::renderLoop()
+{
+    mu::runtime::setThreadName("audio_freeze");
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobsMutex);
+            m_jobsCondition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping) {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        AudioPtr audio = render(job);
+
+        {
+            std::lock_guard<std::mutex> lock(m_jobsMutex);
+            m_results.push_back({ job.key, audio });
+        }
+        m_hasResults = true;
+    }
+}
+
+FrozenTrackSource::AudioPtr FrozenTrackSource::render(const Job& job)
+{
+    IOfflineAudioRenderer::Options options;
+    options.sampleRate = job.sampleRate;
+    options.fromTick = job.data.chunks.cbegin()->first;
+    options.toTick = job.toTick;
+    options.preRollMsec = 0;
+    options.tailMsec = FROZEN_TAIL_MSEC;
+
+    uint64_t startSample = 0;
+    std::vector<float> rendered;
+    auto onBlock = [this, &startSample, &rendered](const IOfflineAudioRenderer::Block& block) {
+        startSample = block.startSample;
+        rendered.insert(rendered.end(), block.data, block.data + block.samples * AUDIO_CHANNELS);
+        return !m_stopping;
+    };
+
+    Ret ret = offlineRenderer()->render(job.data, job.toTick, nullptr, onBlock, options);
+    if (!ret) {
+        if (ret.code() != static_cast<int>(Ret::Code::Cancel)) {
+            LOGE() << "failed render frozen chunk at tick: " << options.fromTick << ", err: " << ret.code();
+        }
+        return nullptr;
+    }
+
+    size_t length = rendered.size();
+    while (length > 0 && std::fabs(rendered[length - 1]) < SILENCE_LEVEL) {
+        --length;
+    }
+    length += length % AUDIO_CHANNELS;
+
+    float peak = 0.f;
+    for (size_t i = 0; i < length; ++i) {
+        peak = std::max(peak, std::fabs(rendered[i]));
+    }
+
+    auto audio = std::make_shared<Audio>();
+    audio->startSample = startSample;
+    if (peak > 0.f) {
+        audio->scale = peak / 32767.f;
+        audio->samples.resize(length);
+        for (size_t i = 0; i < length; ++i) {
+            audio->samples[i] = static_cast<int16_t>(std::lrint(rendered[i] / audio->scale));
+        }
+    }
+
+    return audio;
+}
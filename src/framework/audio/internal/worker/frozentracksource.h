@@ -0,0 +1,153 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_FROZENTRACKSOURCE_H
+#define MU_AUDIO_FROZENTRACKSOURCE_H
+
+#include <map>
+#include <set>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+#include "abstractaudiosource.h"
+#include "modularity/ioc.h"
+#include "iofflineaudiorenderer.h"
+#include "isoundfontsprovider.h"
+#include "isynthesizersregister.h"
+#include "synthtypes.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+//! NOTE Plays the frozen tracks of a midi player: the audio of each chunk of a frozen track
+//! is rendered once in the background and streamed back, instead of being synthesized during playback.
+//! The audio is cached by the hash of the chunk events and the synth state, so only the chunks of
+//! a track changed by an edit are rendered again, and an undo finds the audio of the previous state.
+class FrozenTrackSource : public AbstractAudioSource
+{
+    INJECT(audio, IOfflineAudioRenderer, offlineRenderer)
+    INJECT(audio, synth::ISoundFontsProvider, soundFontsProvider)
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+
+public:
+    FrozenTrackSource();
+    ~FrozenTrackSource() override;
+
+    void setMidiData(const midi::MidiData& data);
+
+    void setIsTrackFrozen(midi::track_t trackIndex, bool frozen, const midi::Chunks& chunks);
+    void setIsTrackMuted(midi::track_t trackIndex, bool mute);
+    void updateChunk(const midi::Chunk& chunk);
+
+    //! NOTE The events of the channel at the tick are played by this source, so they must not be sent to the synth
+    bool isFrozen(midi::channel_t ch, midi::tick_t tick) const;
+
+    void setIsRunning(bool running);
+    void setPlaybackSpeed(float speed);
+    void seek(unsigned long milliseconds);
+
+    // IAudioSource
+    void setSampleRate(unsigned int sampleRate) override;
+    unsigned int streamCount() const override;
+    void forward(unsigned int sampleCount) override;
+
+private:
+    //! NOTE The audio is stored as 16 bit, with the scale of its peak, which halves the memory of float
+    struct Audio {
+        uint64_t startSample = 0;
+        float scale = 0.f;
+        std::vector<int16_t> samples;   // interleaved stereo
+
+        uint64_t endSample() const { return startSample + samples.size() / synth::AUDIO_CHANNELS; }
+    };
+    using AudioPtr = std::shared_ptr<const Audio>;
+
+    struct Segment {
+        uint64_t key = 0;
+        midi::tick_t endTick = 0;
+        bool ready = false;
+        bool deferred = false;  //! NOTE Became ready while it was played by the synth, it is used from the next seek
+        AudioPtr audio;
+        midi::Chunk chunk;      //! NOTE Only the events of the track
+    };
+
+    struct FrozenTrack {
+        std::set<midi::channel_t> channels;
+        bool muted = false;
+        std::map<midi::tick_t /*begin*/, Segment> segments;
+    };
+
+    struct Job {
+        uint64_t key = 0;
+        midi::MidiData data;
+        midi::tick_t toTick = 0;
+        unsigned int sampleRate = 0;
+    };
+
+    struct Result {
+        uint64_t key = 0;
+        AudioPtr audio;
+    };
+
+    struct CacheItem {
+        AudioPtr audio;
+        uint64_t lastUse = 0;
+    };
+
+    uint64_t chunkKey(const FrozenTrack& track, const midi::Chunk& chunk) const;
+    void updateSegment(FrozenTrack& track, const midi::Chunk& chunk);
+    void resetSegments();
+    void readyAudio(uint64_t key, const AudioPtr& audio);
+    void makeReady(Segment& segment, const AudioPtr& audio);
+    void cacheAudio(uint64_t key, const AudioPtr& audio);
+    AudioPtr cachedAudio(uint64_t key);
+    void takeResults();
+    void mixSegment(const Audio& audio, uint64_t from, unsigned int sampleCount);
+
+    void queueJob(Job job);
+    void renderLoop();
+    AudioPtr render(const Job& job);
+
+    midi::MidiData m_data;
+    std::map<midi::track_t, FrozenTrack> m_tracks;
+    std::map<midi::channel_t, midi::track_t> m_channelTracks;
+    std::set<uint64_t> m_pendingKeys;
+
+    std::map<uint64_t, CacheItem> m_cache;
+    size_t m_cacheBytes = 0;
+    uint64_t m_useCounter = 0;
+
+    bool m_isRunning = false;
+    float m_playSpeed = 1.f;
+    uint64_t m_position = 0;
+
+    std::thread m_renderThread;
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsCondition;
+    std::deque<Job> m_jobs;
+    std::vector<Result> m_results;
+    std::atomic<bool> m_hasResults = false;
+    std::atomic<bool> m_stopping = false;
+};
+}
+
+#endif // MU_AUDIO_FROZENTRACKSOURCE_H
@@ -36,6 +36,9 @@ public:
     virtual Ret load(const std::shared_ptr<audio::IAudioStream>& stream) = 0;
 
     virtual IAudioSourcePtr audioSource() = 0;
+
+    //! the pitch is kept at any speed
+    virtual void setPlaybackSpeed(float speed) = 0;
 };
 }
 #endif // MU_AUDIO_IAUDIOPLAYER_H
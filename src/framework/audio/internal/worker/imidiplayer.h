@@ -29,6 +29,7 @@
 #include "async/notification.h"
 #include "async/channel.h"
 #include "iplayer.h"
+#include "iaudiosource.h"
 
 namespace mu::audio {
 class IMIDIPlayer : public IPlayer
@@ -45,6 +46,14 @@ public:
     virtual void setIsTrackMuted(midi::track_t trackIndex, bool mute) = 0;
     virtual void setTrackVolume(midi::track_t trackIndex, float volume) = 0;
     virtual void setTrackBalance(midi::track_t trackIndex, float balance) = 0;
+
+    //! NOTE The audio of a frozen track is rendered in the background and played by the frozen audio source
+    virtual void setIsTrackFrozen(midi::track_t trackIndex, bool frozen) = 0;
+    virtual IAudioSourcePtr frozenAudioSource() const = 0;
+
+    //! NOTE The metronome is clicked by its own audio source, so it is turned on and off at once
+    virtual void setIsMetronomeEnabled(bool enabled) = 0;
+    virtual IAudioSourcePtr metronomeAudioSource() const = 0;
 };
 }
 
@@ -0,0 +1,96 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "limiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mu::audio;
+
+Limiter::Limiter(unsigned int streamCount)
+    : m_streamCount(streamCount)
+{
+}
+
+unsigned int Limiter::streamCount() const
+{
+    return m_streamCount;
+}
+
+void Limiter::setSampleRate(unsigned int sampleRate)
+{
+    m_sampleRate = sampleRate;
+    calculate();
+}
+
+bool Limiter::active() const
+{
+    return m_active;
+}
+
+void Limiter::setActive(bool active)
+{
+    m_active = active;
+    m_gain = 1.f;
+}
+
+void Limiter::setThreshold(float db)
+{
+    m_threshold = std::pow(10.f, db / 20.f);
+}
+
+void Limiter::setRelease(float ms)
+{
+    m_releaseMs = ms;
+    calculate();
+}
+
+void Limiter::calculate()
+{
+    if (!m_sampleRate) {
+        return;
+    }
+    //! NOTE The gain comes back by 1 - 1/e of the way over the release time
+    m_releaseCoeff = std::exp(-1000.f / (m_releaseMs * m_sampleRate));
+}
+
+void Limiter::process(float* input, float* output, unsigned int sampleCount)
+{
+    const unsigned int streams = m_streamCount;
+    float gain = m_gain;
+
+    for (unsigned int i = 0; i < sampleCount; ++i) {
+        const float* in = input + i * streams;
+        float* out = output + i * streams;
+
+        float peak = 0.f;
+        for (unsigned int s = 0; s < streams; ++s) {
+            peak = std::max(peak, std::fabs(in[s]));
+        }
+
+        const float target = peak > m_threshold ? m_threshold / peak : 1.f;
+        gain = target < gain ? target : target + (gain - target) * m_releaseCoeff;
+
+        for (unsigned int s = 0; s < streams; ++s) {
+            out[s] = in[s] * gain;
+        }
+    }
+
+    m_gain = gain;
+}
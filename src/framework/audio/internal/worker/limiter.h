@@ -0,0 +1,58 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_LIMITER_H
+#define MU_AUDIO_LIMITER_H
+
+#include "iaudioprocessor.h"
+
+namespace mu::audio {
+//! NOTE Keeps the peaks of the interleaved streams under the threshold, for the end of the master bus.
+//! Without a look ahead the gain falls at once on a peak above the threshold, so nothing gets through,
+//! and comes back over the release time. All the streams get the same gain, the image stays in place
+class Limiter : public IAudioProcessor
+{
+public:
+    explicit Limiter(unsigned int streamCount);
+
+    unsigned int streamCount() const override;
+    void setSampleRate(unsigned int sampleRate) override;
+
+    bool active() const override;
+    void setActive(bool active) override;
+
+    void setThreshold(float db);
+    void setRelease(float ms);
+
+    void process(float* input, float* output, unsigned int sampleCount) override;
+
+private:
+    void calculate();
+
+    unsigned int m_streamCount = 0;
+    unsigned int m_sampleRate = 0;
+    bool m_active = true;
+
+    float m_threshold = 0.98f;    // -0.2 dB
+    float m_releaseMs = 100.f;
+    float m_releaseCoeff = 0.f;
+    float m_gain = 1.f;
+};
+}
+
+#endif // MU_AUDIO_LIMITER_H
@@ -0,0 +1,96 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "metronomesource.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "synthtypes.h"
+
+using namespace mu::audio;
+
+static constexpr float ACCENT_FREQUENCY = 1'760.f;
+static constexpr float CLICK_FREQUENCY = 1'320.f;
+static constexpr float CLICK_LEVEL = 0.5f;
+static constexpr unsigned int CLICK_LENGTH_MS = 30;
+
+//! NOTE A sine burst which fades out exponentially over its length
+static std::vector<float> renderClick(unsigned int sampleRate, float frequency)
+{
+    size_t length = static_cast<size_t>(sampleRate) * CLICK_LENGTH_MS / 1000;
+    std::vector<float> click(length);
+    for (size_t i = 0; i < length; ++i) {
+        float t = static_cast<float>(i) / sampleRate;
+        float envelope = std::exp(-5.f * static_cast<float>(i) / length);
+        click[i] = CLICK_LEVEL * envelope * std::sin(2.f * static_cast<float>(M_PI) * frequency * t);
+    }
+    return click;
+}
+
+void MetronomeSource::setSampleRate(unsigned int sampleRate)
+{
+    if (m_sampleRate == sampleRate && !m_click.empty()) {
+        return;
+    }
+
+    AbstractAudioSource::setSampleRate(sampleRate);
+    m_voices.clear();
+    m_accentClick = renderClick(sampleRate, ACCENT_FREQUENCY);
+    m_click = renderClick(sampleRate, CLICK_FREQUENCY);
+}
+
+unsigned int MetronomeSource::streamCount() const
+{
+    return synth::AUDIO_CHANNELS;
+}
+
+void MetronomeSource::scheduleClick(unsigned int sampleOffset, bool accent, float volume)
+{
+    Voice voice;
+    voice.click = accent ? &m_accentClick : &m_click;
+    voice.sampleOffset = sampleOffset;
+    voice.volume = volume;
+    m_voices.push_back(voice);
+}
+
+void MetronomeSource::clear()
+{
+    m_voices.clear();
+}
+
+void MetronomeSource::forward(unsigned int sampleCount)
+{
+    const unsigned int streams = streamCount();
+    std::fill(m_buffer.begin(), m_buffer.begin() + std::min<size_t>(m_buffer.size(), sampleCount * streams), 0.f);
+
+    for (Voice& voice : m_voices) {
+        const std::vector<float>& click = *voice.click;
+        for (unsigned int i = voice.sampleOffset; i < sampleCount && voice.position < click.size(); ++i) {
+            float value = voice.volume * click[voice.position++];
+            for (unsigned int s = 0; s < streams; ++s) {
+                m_buffer[streams * i + s] += value;
+            }
+        }
+        voice.sampleOffset = 0;
+    }
+
+    m_voices.erase(std::remove_if(m_voices.begin(), m_voices.end(), [](const Voice& voice) {
+        return voice.position >= voice.click->size();
+    }), m_voices.end());
+}
@@ -0,0 +1,57 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_METRONOMESOURCE_H
+#define MU_AUDIO_METRONOMESOURCE_H
+
+#include <vector>
+
+#include "abstractaudiosource.h"
+
+namespace mu::audio {
+//! NOTE Plays the clicks of the metronome, scheduled by the midi player at their sample offsets
+//! in the block. The two clicks are rendered once for the sample rate and mixed in,
+//! so the metronome takes no synth voices and needs no midi events.
+class MetronomeSource : public AbstractAudioSource
+{
+public:
+    MetronomeSource() = default;
+
+    void scheduleClick(unsigned int sampleOffset, bool accent, float volume);
+    void clear();
+
+    // IAudioSource
+    void setSampleRate(unsigned int sampleRate) override;
+    unsigned int streamCount() const override;
+    void forward(unsigned int sampleCount) override;
+
+private:
+    struct Voice {
+        const std::vector<float>* click = nullptr;
+        size_t position = 0;
+        unsigned int sampleOffset = 0;  //! NOTE In the next forwarded block only
+        float volume = 1.f;
+    };
+
+    std::vector<float> m_accentClick;
+    std::vector<float> m_click;
+    std::vector<Voice> m_voices;
+};
+}
+
+#endif // MU_AUDIO_METRONOMESOURCE_H
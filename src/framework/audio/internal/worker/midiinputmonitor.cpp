@@ -0,0 +1,74 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "midiinputmonitor.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+using namespace mu::midi;
+
+void MidiInputMonitor::process()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    std::shared_ptr<IMidiInPort> port = midiInPort();
+    if (!port) {
+        return;
+    }
+
+    //! NOTE Monitoring was turned off, the note-offs of the held notes will not come
+    if (!port->isMonitoring()) {
+        if (m_soundingChannels) {
+            soundsOff();
+        }
+        return;
+    }
+
+    Event e;
+    if (!port->takeMonitoredEvent(e)) {
+        return;
+    }
+
+    synth::ISynthesizerPtr synth = synthesizersRegister()->defaultSynthesizer();
+    if (!synth) {
+        return;
+    }
+
+    do {
+        synth->handleEvent(e);
+        m_soundingChannels |= static_cast<uint16_t>(1 << (e.channel() & 0x0F));
+    } while (port->takeMonitoredEvent(e));
+
+    synth->setIsActive(true);
+}
+
+void MidiInputMonitor::soundsOff()
+{
+    synth::ISynthesizerPtr synth = synthesizersRegister()->defaultSynthesizer();
+    if (synth) {
+        for (channel_t ch = 0; ch < 16; ++ch) {
+            if (m_soundingChannels & (1 << ch)) {
+                synth->channelSoundsOff(ch);
+            }
+        }
+    }
+
+    m_soundingChannels = 0;
+}
@@ -0,0 +1,48 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_MIDIINPUTMONITOR_H
+#define MU_AUDIO_MIDIINPUTMONITOR_H
+
+#include <cstdint>
+
+#include "modularity/ioc.h"
+#include "midi/imidiinport.h"
+#include "isynthesizersregister.h"
+
+namespace mu::audio {
+//! NOTE Plays the events of the MIDI input on the default synthesizer.
+//! They are taken from the queue of the input port at the start of every block,
+//! so the latency does not depend on the main thread's event loop
+class MidiInputMonitor
+{
+    INJECT(audio, midi::IMidiInPort, midiInPort)
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+
+public:
+    void process();
+
+private:
+    void soundsOff();
+
+    uint16_t m_soundingChannels = 0;
+};
+}
+
+#endif // MU_AUDIO_MIDIINPUTMONITOR_H
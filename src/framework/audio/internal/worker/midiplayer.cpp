@@ -21,6 +21,8 @@
 
 #include <limits>
 #include <cstring>
+#include <iterator>
+#include <algorithm>
 
 #include "log.h"
 #include "realfn.h"
@@ -35,6 +37,8 @@ static tick_t REQUEST_BUFFER_SIZE = 480 * 4 * 10; // about 10 measures of 4/4 ti
 MIDIPlayer::MIDIPlayer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+    m_frozenSource = std::make_shared<FrozenTrackSource>();
+    m_metronomeSource = std::make_shared<MetronomeSource>();
 }
 
 MIDIPlayer::~MIDIPlayer()
@@ -45,6 +49,11 @@ MIDIPlayer::~MIDIPlayer()
     }
 }
 
+void MIDIPlayer::setClock(std::shared_ptr<const Clock> clock)
+{
+    m_clock = clock;
+}
+
 IPlayer::Status MIDIPlayer::status() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -80,9 +89,20 @@ void MIDIPlayer::loadMIDI(const std::shared_ptr<MidiStream>& stream)
     m_streamState.reset();
 
     m_midiData = stream->initData;
+    m_frozenSource->setMidiData(m_midiData);
+
+    m_stateSnapshots.clear();
+    ChannelState& initState = m_stateSnapshots[0];
+    for (const Event& event : m_midiData.initEvents) {
+        uint32_t key = 0;
+        if (stateEventKey(event, key)) {
+            initState[key] = event;
+        }
+    }
 
     if (m_midiStream->isStreamingAllowed) {
         m_midiStream->stream.onReceive(this, [this](const Chunk& chunk) { onChunkReceived(chunk); });
+        m_midiStream->replace.onReceive(this, [this](const Chunk& chunk) { onChunkReplaced(chunk); });
     }
 
     if (m_midiStream->isStreamingAllowed && validChunkTick(0, m_midiData.chunks, REQUEST_BUFFER_SIZE) == 0) {
@@ -143,6 +163,59 @@ void MIDIPlayer::onChunkReceived(const Chunk& chunk)
     std::lock_guard<std::mutex> lock(m_dataMutex);
     m_midiData.chunks.insert({ chunk.beginTick, chunk });
     m_streamState.requested = false;
+    m_frozenSource->updateChunk(chunk);
+}
+
+static Chunk sliceChunk(const Chunk& chunk, tick_t beginTick, tick_t endTick)
+{
+    Chunk slice;
+    slice.beginTick = beginTick;
+    slice.endTick = endTick;
+
+    auto it = chunk.events.lower_bound(beginTick);
+    auto end = chunk.events.lower_bound(endTick);
+    slice.events.reserve(end - it);
+    for (; it != end; ++it) {
+        slice.events.append(it->first, it->second);
+    }
+    return slice;
+}
+
+void MIDIPlayer::onChunkReplaced(const Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+
+    //! NOTE The chunks partition may have changed, so the old chunks the new one overlaps
+    //! are trimmed to the ticks outside of it, these are still valid and stay playable
+    std::vector<Chunk> remains;
+    auto it = m_midiData.chunks.upper_bound(chunk.beginTick);
+    if (it != m_midiData.chunks.begin()) {
+        --it;
+    }
+    while (it != m_midiData.chunks.end() && it->first < chunk.endTick) {
+        const Chunk& old = it->second;
+        if (old.endTick <= chunk.beginTick) {
+            ++it;
+            continue;
+        }
+
+        if (old.beginTick < chunk.beginTick) {
+            remains.push_back(sliceChunk(old, old.beginTick, chunk.beginTick));
+        }
+        if (old.endTick > chunk.endTick) {
+            remains.push_back(sliceChunk(old, chunk.endTick, old.endTick));
+        }
+        it = m_midiData.chunks.erase(it);
+    }
+
+    for (Chunk& remain : remains) {
+        m_midiData.chunks.insert({ remain.beginTick, std::move(remain) });
+    }
+    m_midiData.chunks.insert({ chunk.beginTick, chunk });
+    m_stateSnapshots.erase(m_stateSnapshots.upper_bound(chunk.beginTick), m_stateSnapshots.end());
+
+    //! NOTE Only the frozen chunks of the tracks changed by the edit are rendered again
+    m_frozenSource->updateChunk(chunk);
 }
 
 void MIDIPlayer::forwardTime(unsigned long milliseconds)
@@ -190,6 +263,8 @@ void MIDIPlayer::forwardTime(unsigned long milliseconds)
     //! -----
 
     m_curMSec = curMSec;
+    m_blockFromMSec = m_prevMSec;
+    m_blockToMSec = curMSec;
 
     sendEvents(prevTicks, toTick);
 
@@ -263,6 +338,8 @@ bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
 
     m_isPlayTickSet = false;
 
+    sendMetronomeClicks(fromTick, toTick);
+
     if (m_midiData.chunks.empty()) {
         return false;
     }
@@ -301,9 +378,11 @@ bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
         }
 
         ChanState& chState = m_chanStates[event.channel()];
-        if (event && !chState.muted) {
+        bool isFrozen = event.isChannelVoice() && event.opcode() == midi::Event::Opcode::NoteOn
+                        && m_frozenSource->isFrozen(event.channel(), pos->first);
+        if (event && !chState.muted && !isFrozen) {
             auto s = synth(event.channel());
-            s->handleEvent(event);
+            s->scheduleEvent(event, sampleOffset(pos->first));
             s->setIsActive(true);
 
             if (event.isChannelVoice() && event.opcode() == midi::Event::Opcode::NoteOn) {
@@ -318,17 +397,35 @@ bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
         ++pos;
     }
 
-    midiPortDataSender()->sendEvents(fromTick, toTick);
+    midiPortDataSender()->sendEvents(fromTick, toTick, [this](tick_t tick) { return delayUsec(tick); });
     return true;
 }
 
-void MIDIPlayer::sendClear()
+void MIDIPlayer::sendMetronomeClicks(tick_t fromTick, tick_t toTick)
+{
+    if (!m_isMetronomeEnabled) {
+        return;
+    }
+
+    const Metronome& metronome = m_midiData.metronome;
+    for (auto it = metronome.lower_bound(fromTick); it != metronome.end() && it->first < toTick; ++it) {
+        m_metronomeSource->scheduleClick(sampleOffset(it->first), it->second.accent, it->second.velocity / 127.f);
+    }
+}
+
+//! NOTE While playing, the notes are released at the offset in the block, so that a loop jump
+//! in the middle of the block keeps the sound before it and the release tails
+void MIDIPlayer::sendClear(unsigned int sampleOffset)
 {
     for (auto& cache: m_noteCache) {
         auto event = cache.second;
         if (event) {
             auto s = synth(event.channel());
-            s->handleEvent(event);
+            if (sampleOffset) {
+                s->scheduleEvent(event, sampleOffset);
+            } else {
+                s->handleEvent(event);
+            }
             midiPortDataSender()->sendSingleEvent(event);
         }
     }
@@ -340,6 +437,7 @@ void MIDIPlayer::run()
     ONLY_AUDIO_WORKER_THREAD;
     if (m_midiStream && status() != Status::Error) {
         setStatus(Status::Running);
+        m_frozenSource->setIsRunning(true);
     }
 }
 
@@ -349,6 +447,8 @@ void MIDIPlayer::stop()
     if (status() != Status::Error) {
         setStatus(Status::Stoped);
     }
+    m_frozenSource->setIsRunning(false);
+    m_metronomeSource->clear();
     sendClear();
 }
 
@@ -358,6 +458,8 @@ void MIDIPlayer::pause()
     if (status() != Status::Error) {
         setStatus(Status::Paused);
     }
+    m_frozenSource->setIsRunning(false);
+    m_metronomeSource->clear();
     sendClear();
 }
 
@@ -378,8 +480,26 @@ void MIDIPlayer::seek(unsigned long milliseconds)
     ONLY_AUDIO_WORKER_THREAD;
     m_curMSec = milliseconds;
     m_prevMSec = milliseconds;
+    m_frozenSource->seek(milliseconds);
 
-    if (m_midiStream && m_midiStream->isStreamingAllowed) {
+    if (!m_midiStream) {
+        return;
+    }
+
+    unsigned int sampleOffset = 0;
+    if (isRunning() && m_clock) {
+        sampleOffset = static_cast<unsigned int>(m_clock->forwardedSectionOffset());
+        sendClear(sampleOffset);
+    }
+
+    ChannelState state;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        state = channelState(tick(m_curMSec));
+    }
+    applyChannelState(state, sampleOffset);
+
+    if (m_midiStream->isStreamingAllowed) {
         tick_t curTick = tick(m_curMSec);
         tick_t maxValidTick = validChunkTick(curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
         tick_t bufSize = maxValidTick - curTick;
@@ -389,13 +509,99 @@ void MIDIPlayer::seek(unsigned long milliseconds)
     }
 }
 
+bool MIDIPlayer::stateEventKey(const Event& event, uint32_t& key)
+{
+    if (!event.isChannelVoice()) {
+        return false;
+    }
+    uint32_t index = 0;
+    switch (event.opcode()) {
+    case Event::Opcode::ControlChange:
+        index = event.index();
+        break;
+    case Event::Opcode::ProgramChange:
+    case Event::Opcode::ChannelPressure:
+    case Event::Opcode::PitchBend:
+        break;
+    default:
+        return false;
+    }
+    key = (static_cast<uint32_t>(event.group()) << 20) | (static_cast<uint32_t>(event.channel()) << 16)
+          | (static_cast<uint32_t>(event.opcode()) << 8) | index;
+    return true;
+}
+
+//! NOTE Starts from the snapshot before the tick and scans the chunks received up to it,
+//! keeping a snapshot at the begin of each of them. A gap in the chunks ends the scan
+MIDIPlayer::ChannelState MIDIPlayer::channelState(tick_t tick)
+{
+    auto snapshotIt = m_stateSnapshots.upper_bound(tick);
+    if (snapshotIt == m_stateSnapshots.begin()) {
+        return ChannelState();
+    }
+    --snapshotIt;
+
+    tick_t fromTick = snapshotIt->first;
+    ChannelState state = snapshotIt->second;
+
+    auto chunkIt = m_midiData.chunks.upper_bound(fromTick);
+    if (chunkIt == m_midiData.chunks.begin()) {
+        return state;
+    }
+    --chunkIt;
+
+    for (; chunkIt != m_midiData.chunks.end() && chunkIt->first <= tick; ++chunkIt) {
+        const Chunk& chunk = chunkIt->second;
+        if (chunk.endTick <= fromTick || chunk.beginTick > fromTick) {
+            break;
+        }
+        if (chunk.beginTick == fromTick) {
+            m_stateSnapshots[chunk.beginTick] = state;
+        }
+        for (auto pos = chunk.events.lower_bound(fromTick); pos != chunk.events.end() && pos->first < tick; ++pos) {
+            uint32_t key = 0;
+            if (stateEventKey(pos->second, key)) {
+                state[key] = pos->second;
+            }
+        }
+        fromTick = chunk.endTick;
+    }
+
+    return state;
+}
+
+void MIDIPlayer::applyChannelState(const ChannelState& state, unsigned int sampleOffset)
+{
+    for (const auto& item : state) {
+        const Event& event = item.second;
+        bool hasSynth = std::any_of(m_synthStates.cbegin(), m_synthStates.cend(), [&event](const SynthState& st) {
+            return st.channels.find(event.channel()) != st.channels.end();
+        });
+        if (!hasSynth) {
+            continue;
+        }
+        auto s = synth(event.channel());
+        if (sampleOffset) {
+            s->scheduleEvent(event, sampleOffset);
+        } else {
+            s->handleEvent(event);
+        }
+        midiPortDataSender()->sendSingleEvent(event);
+    }
+}
+
 tick_t MIDIPlayer::validChunkTick(tick_t fromTick, const Chunks& chunks, tick_t maxDistanceTick) const
 {
     if (chunks.empty()) {
-        return 0;
+        return fromTick;
     }
 
     auto it = chunks.upper_bound(fromTick);
+    if (it == chunks.begin() || std::prev(it)->second.endTick <= fromTick) {
+        //! NOTE Nothing at fromTick, it must be requested from there, not from the end of an earlier chunk
+        return fromTick;
+    }
+
     --it;
     for (; it != chunks.end(); ++it) {
         const Chunk& chunk = it->second;
@@ -422,6 +628,7 @@ tick_t MIDIPlayer::validChunkTick(tick_t fromTick, const Chunks& chunks, tick_t
 void MIDIPlayer::buildTempoMap()
 {
     m_tempoMap.clear();
+    m_tempoItems.clear();
 
     std::vector<std::pair<uint32_t, uint32_t> > tempos;
     for (const auto& it : m_midiData.tempoMap) {
@@ -447,6 +654,7 @@ void MIDIPlayer::buildTempoMap()
         uint32_t delta_ticks = end_ticks - t.startTicks;
         msec += static_cast<uint64_t>(delta_ticks * t.onetickMsec);
 
+        m_tempoItems.push_back(t);
         m_tempoMap.insert({ msec, std::move(t) });
     }
 }
@@ -462,6 +670,49 @@ tick_t MIDIPlayer::tick(uint64_t msec) const
     return t.startTicks + ticks;
 }
 
+double MIDIPlayer::msec(tick_t tick) const
+{
+    //! NOTE Called for every scheduled event on the audio thread, so a binary search
+    auto it = std::partition_point(m_tempoItems.cbegin(), m_tempoItems.cend(), [tick](const TempoItem& item) {
+        return item.startTicks <= tick;
+    });
+
+    if (it == m_tempoItems.cbegin()) {
+        return 0.0;
+    }
+
+    const TempoItem& item = *(it - 1);
+    return item.startMsec + (tick - item.startTicks) * item.onetickMsec;
+}
+
+unsigned int MIDIPlayer::sampleOffset(tick_t tick) const
+{
+    if (!m_clock) {
+        return 0;
+    }
+
+    //! NOTE The events are sent for a section of the block, all of it unless the block spans a loop jump
+    Clock::time_t offset = m_clock->forwardedSectionOffset();
+    Clock::time_t samples = m_clock->forwardedSectionSamples();
+    if (samples == 0 || m_blockToMSec <= m_blockFromMSec) {
+        return static_cast<unsigned int>(offset);
+    }
+
+    double pos = (msec(tick) - m_blockFromMSec) / static_cast<double>(m_blockToMSec - m_blockFromMSec);
+    pos = std::clamp(pos, 0.0, 1.0);
+    return static_cast<unsigned int>(offset + std::min<Clock::time_t>(static_cast<Clock::time_t>(pos * samples), samples - 1));
+}
+
+//! NOTE The MIDI port plays an event as late in the block as the synthesizers do
+uint32_t MIDIPlayer::delayUsec(tick_t tick) const
+{
+    if (!m_clock || m_clock->sampleRate() == 0) {
+        return 0;
+    }
+
+    return static_cast<uint32_t>(uint64_t(sampleOffset(tick)) * 1000000 / m_clock->sampleRate());
+}
+
 float MIDIPlayer::playbackSpeed() const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -472,6 +723,7 @@ void MIDIPlayer::setPlaybackSpeed(float speed)
 {
     ONLY_AUDIO_WORKER_THREAD;
     m_playSpeed = speed;
+    m_frozenSource->setPlaybackSpeed(speed);
 }
 
 bool MIDIPlayer::hasTrack(track_t ti) const
@@ -504,6 +756,7 @@ void MIDIPlayer::setIsTrackMuted(track_t trackIndex, bool mute)
     for (channel_t ch : track.channels) {
         setMuted(ch);
     }
+    m_frozenSource->setIsTrackMuted(track.num, mute);
 }
 
 void MIDIPlayer::setTrackVolume(track_t trackIndex, float volume)
@@ -531,3 +784,37 @@ void MIDIPlayer::setTrackBalance(track_t trackIndex, float balance)
         synth(ch)->channelBalance(ch, balance);
     }
 }
+
+void MIDIPlayer::setIsTrackFrozen(track_t trackIndex, bool frozen)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    IF_ASSERT_FAILED(hasTrack(trackIndex)) {
+        return;
+    }
+
+    const Track& track = m_midiData.tracks[trackIndex];
+    bool muted = !track.channels.empty() && m_chanStates[track.channels.front()].muted;
+
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    m_frozenSource->setIsTrackFrozen(track.num, frozen, m_midiData.chunks);
+    m_frozenSource->setIsTrackMuted(track.num, muted);
+}
+
+IAudioSourcePtr MIDIPlayer::frozenAudioSource() const
+{
+    return m_frozenSource;
+}
+
+void MIDIPlayer::setIsMetronomeEnabled(bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_isMetronomeEnabled = enabled;
+    if (!enabled) {
+        m_metronomeSource->clear();
+    }
+}
+
+IAudioSourcePtr MIDIPlayer::metronomeAudioSource() const
+{
+    return m_metronomeSource;
+}
@@ -32,6 +32,9 @@
 #include "async/asyncable.h"
 #include "isynthesizersregister.h"
 #include "midi/imidiportdatasender.h"
+#include "frozentracksource.h"
+#include "metronomesource.h"
+#include "clock.h"
 
 namespace mu::audio {
 class MIDIPlayer : public IMIDIPlayer, public async::Asyncable
@@ -43,6 +46,9 @@ public:
     MIDIPlayer();
     ~MIDIPlayer() override;
 
+    //! NOTE The events are scheduled at their sample offsets in the block forwarded by the clock
+    void setClock(std::shared_ptr<const Clock> clock);
+
     // IPlayer
     Status status() const override;
     async::Channel<Status> statusChanged() const override;
@@ -68,6 +74,12 @@ public:
     void setTrackVolume(midi::track_t trackIndex, float volume) override;
     void setTrackBalance(midi::track_t trackIndex, float balance) override;
 
+    void setIsTrackFrozen(midi::track_t trackIndex, bool frozen) override;
+    IAudioSourcePtr frozenAudioSource() const override;
+
+    void setIsMetronomeEnabled(bool enabled) override;
+    IAudioSourcePtr metronomeAudioSource() const override;
+
 private:
 
     void setStatus(const Status& status);
@@ -76,7 +88,8 @@ private:
 
     midi::tick_t validChunkTick(midi::tick_t fromTick, const midi::Chunks& chunks, midi::tick_t maxDistanceTick) const;
     bool sendEvents(midi::tick_t fromTick, midi::tick_t toTick);
-    void sendClear();
+    void sendMetronomeClicks(midi::tick_t fromTick, midi::tick_t toTick);
+    void sendClear(unsigned int sampleOffset = 0);
 
     synth::ISynthesizerPtr determineSynthesizer(midi::channel_t ch, const synth::SynthMap& synthmap) const;
     synth::ISynthesizerPtr synth(midi::channel_t ch) const;
@@ -86,11 +99,22 @@ private:
 
     void setCurrentMSec(uint64_t msec);
     midi::tick_t tick(uint64_t msec) const;
+    double msec(midi::tick_t tick) const;
+    unsigned int sampleOffset(midi::tick_t tick) const;
+    uint32_t delayUsec(midi::tick_t tick) const;
 
     bool hasTrack(midi::track_t num) const;
 
+    //! NOTE The last program, controllers and pitch bend of each channel
+    using ChannelState = std::map<uint32_t /*channel and message*/, midi::Event>;
+
+    static bool stateEventKey(const midi::Event& event, uint32_t& key);
+    ChannelState channelState(midi::tick_t tick);
+    void applyChannelState(const ChannelState& state, unsigned int sampleOffset);
+
     void requestData(midi::tick_t tick);
     void onChunkReceived(const midi::Chunk& chunk);
+    void onChunkReplaced(const midi::Chunk& chunk);
 
     Status m_status = Status::Stoped;
     async::Channel<Status> m_statusChanged;
@@ -100,11 +124,19 @@ private:
     std::shared_ptr<midi::MidiStream> m_midiStream = nullptr;
     std::map<uint8_t, midi::Event> m_noteCache = {};
 
+    //! NOTE The state of the channels at the begin of the chunks scanned by seeks, so that a seek
+    //! only scans the events from the chunk before it. Made again from a replaced chunk on
+    std::map<midi::tick_t, ChannelState> m_stateSnapshots;
+
     float m_playSpeed = 1.f;
 
     midi::msec_t m_prevMSec = 0;
     midi::msec_t m_curMSec = 0;
 
+    std::shared_ptr<const Clock> m_clock = nullptr;
+    midi::msec_t m_blockFromMSec = 0;   //! NOTE The time of the events sent for the block forwarded by the clock
+    midi::msec_t m_blockToMSec = 0;
+
     bool m_isPlayTickSet = false;
     midi::tick_t m_playTick = 0;    //! NOTE First event tick
 
@@ -115,6 +147,7 @@ private:
         double onetickMsec = 0.0;
     };
     std::map<uint64_t /*msec*/, TempoItem> m_tempoMap = {};
+    std::vector<TempoItem> m_tempoItems;    //! NOTE The items of m_tempoMap in the order of their ticks, for msec(tick)
 
     struct StreamState {
         std::atomic<bool> requested{ false };
@@ -133,6 +166,9 @@ private:
         std::vector<float> buf;
     };
     std::vector<SynthState> m_synthStates = {};
+    std::shared_ptr<FrozenTrackSource> m_frozenSource = nullptr;
+    std::shared_ptr<MetronomeSource> m_metronomeSource = nullptr;
+    bool m_isMetronomeEnabled = false;
     midi::tick_t m_lastSentTick = -1;
     async::Channel<midi::tick_t> m_onTickPlayed;
 };
@@ -17,7 +17,9 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 #include "mixer.h"
+#include <algorithm>
 #include "log.h"
+#include "mixkernels.h"
 #include "internal/audiosanitizer.h"
 
 using namespace mu::audio;
@@ -25,6 +27,7 @@ using namespace mu::audio;
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+    m_pool.setThreadCount(configuration() ? configuration()->mixerThreads() : 1);
 }
 
 Mixer::~Mixer()
@@ -60,8 +63,11 @@ void Mixer::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
     AbstractAudioSource::setSampleRate(sampleRate);
-    for (auto& input : m_inputList) {
-        input.second->setSampleRate(sampleRate);
+    for (Input& input : m_inputList) {
+        input.channel->setSampleRate(sampleRate);
+    }
+    for (auto& insert : m_insertList) {
+        insert.second->setSampleRate(sampleRate);
     }
     if (m_clock) {
         m_clock->setSampleRate(sampleRate);
@@ -102,78 +108,114 @@ void Mixer::setProcessor(unsigned int number, std::shared_ptr<IAudioProcessor> i
         LOGE() << "Insert's stream count not equal to the channel";
         return;
     }
+    insert->setSampleRate(m_sampleRate);
     m_insertList[number] = insert;
 }
 
 IMixer::ChannelID Mixer::addChannel(std::shared_ptr<IAudioSource> source)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    auto lastId = (m_inputList.size() > 0 ? m_inputList.rbegin()->first : -1);
-    auto newId = lastId + 1;
+    ChannelID newId = m_inputList.empty() ? 0 : m_inputList.back().id + 1;
 
     auto channel = std::make_shared<MixerChannel>();
     channel->setSource(source);
     channel->setBufferSize(m_buffer.size());
     channel->setSampleRate(m_sampleRate);
 
-    m_inputList[newId] = channel;
+    m_inputList.push_back({ newId, channel });
     return newId;
 }
 
+Mixer::InputList::iterator Mixer::findInput(ChannelID channelId)
+{
+    auto it = std::lower_bound(m_inputList.begin(), m_inputList.end(), channelId, [](const Input& input, ChannelID id) {
+        return input.id < id;
+    });
+    return (it != m_inputList.end() && it->id == channelId) ? it : m_inputList.end();
+}
+
+Mixer::InputList::const_iterator Mixer::findInput(ChannelID channelId) const
+{
+    auto it = std::lower_bound(m_inputList.cbegin(), m_inputList.cend(), channelId, [](const Input& input, ChannelID id) {
+        return input.id < id;
+    });
+    return (it != m_inputList.cend() && it->id == channelId) ? it : m_inputList.cend();
+}
+
 void Mixer::removeChannel(ChannelID channelId)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    m_inputList.erase(channelId);
+    auto it = findInput(channelId);
+    if (it != m_inputList.end()) {
+        m_inputList.erase(it);
+    }
 }
 
 void Mixer::setActive(ChannelID channelId, bool active)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    m_inputList[channelId]->setActive(active);
+    auto it = findInput(channelId);
+    IF_ASSERT_FAILED(it != m_inputList.end()) {
+        return;
+    }
+    it->channel->setActive(active);
 }
 
 void Mixer::setLevel(ChannelID channelId, unsigned int streamId, float level)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    m_inputList[channelId]->setLevel(streamId, level);
+    auto it = findInput(channelId);
+    IF_ASSERT_FAILED(it != m_inputList.end()) {
+        return;
+    }
+    it->channel->setLevel(streamId, level);
 }
 
 void Mixer::setBalance(ChannelID channelId, unsigned int streamId, std::complex<float> balance)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    m_inputList[channelId]->setBalance(streamId, balance);
+    auto it = findInput(channelId);
+    IF_ASSERT_FAILED(it != m_inputList.end()) {
+        return;
+    }
+    it->channel->setBalance(streamId, balance);
 }
 
 std::shared_ptr<IMixerChannel> Mixer::channel(unsigned int number) const
 {
     ONLY_AUDIO_WORKER_THREAD;
-    IF_ASSERT_FAILED(m_inputList.find(number) != m_inputList.end()) {
+    auto it = findInput(number);
+    IF_ASSERT_FAILED(it != m_inputList.end()) {
         return nullptr;
     }
-    return m_inputList.at(number);
+    return it->channel;
 }
 
 void Mixer::setBufferSize(unsigned int samples)
 {
     ONLY_AUDIO_WORKER_THREAD;
     AbstractAudioSource::setBufferSize(samples);
-    for (auto& input : m_inputList) {
-        input.second->setBufferSize(samples);
+    for (Input& input : m_inputList) {
+        input.channel->setBufferSize(samples);
     }
 }
 
 void Mixer::forward(unsigned int sampleCount)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    TRACE_SCOPE("Mixer::forward");
+    auto startTime = std::chrono::steady_clock::now();
     std::fill(m_buffer.begin(), m_buffer.end(), 0.f);
 
     if (m_clock) {
         m_clock->forward(sampleCount);
     }
 
-    for (auto& input : m_inputList) {
-        input.second->forward(sampleCount);
-        mixinChannel(input.second, sampleCount);
+    ForwardJob job { this, sampleCount };
+    m_pool.run(m_inputList.size(), &Mixer::forwardChannel, &job);
+
+    for (Input& input : m_inputList) {
+        mixinChannel(*input.channel, sampleCount);
     }
 
     for (auto& insert : m_insertList) {
@@ -181,45 +223,55 @@ void Mixer::forward(unsigned int sampleCount)
             insert.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
         }
     }
-    std::transform(m_buffer.begin(), m_buffer.end(), m_buffer.begin(),
-                   [this](float sample) -> float { return sample * m_masterLevel; });
+
+    if (m_masterLevel != 1.f) {
+        mixkernels::applyGain(m_buffer.data(), m_buffer.size(), m_masterLevel);
+    }
+
+    auto renderTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    m_governor.blockRendered(renderTime, sampleCount, m_sampleRate);
+}
+
+void Mixer::forwardChannel(void* context, size_t index)
+{
+    ForwardJob* job = static_cast<ForwardJob*>(context);
+    job->mixer->m_inputList[index].channel->forward(job->sampleCount);
 }
 
-void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount)
+void Mixer::mixinChannel(MixerChannel& channel, unsigned int samplesCount)
 {
-    if (!channel->active()) {
+    if (!channel.active()) {
         return;
     }
-    channel->checkStreams();
-    switch (m_mode) {
-    case MONO:
-    case STEREO:
-        for (unsigned int i = 0; i < channel->streamCount(); ++i) {
-            mixinChannelStream(channel, i, samplesCount);
-        }
-        break;
+    channel.checkStreams();
+
+    const float* channelBuffer = channel.data();
+    if (!channelBuffer) {
+        return;
     }
-}
 
-void Mixer::mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount)
-{
-    auto balance = channel->balance(streamId).real();
-    auto level = channel->level(streamId);
-    for (unsigned int i = 0; i < samplesCount; ++i) {
-        for (unsigned int j = 0; j < streamCount(); ++j) {
+    unsigned int dstStreams = streamCount();
+    unsigned int srcStreams = channel.streamCount();
+
+    m_gains.resize(srcStreams * dstStreams);
+    for (unsigned int s = 0; s < srcStreams; ++s) {
+        float balance = channel.balance(s).real();
+        float level = channel.level(s);
+        for (unsigned int j = 0; j < dstStreams; ++j) {
             //linear cross
-            float gain = 0.5f * balance * ((j * 2.f) - 1) + 0.5f;
-            if (gain < 0) {
-                gain = 0;
-            }
-            if (gain > 1) {
-                gain = 1;
-            }
-
-            auto channelBuffer = channel->data();
-            if (channelBuffer) {
-                m_buffer[i * streamCount() + j] += gain * level * channelBuffer[i * channel->streamCount() + streamId];
-            }
+            float gain = std::clamp(0.5f * balance * ((j * 2.f) - 1) + 0.5f, 0.f, 1.f);
+            m_gains[s * dstStreams + j] = gain * level;
+        }
+    }
+
+    float* buffer = m_buffer.data();
+    if (dstStreams == 2 && srcStreams == 1) {
+        mixkernels::mixMonoToStereo(buffer, channelBuffer, m_gains[0], m_gains[1], samplesCount);
+    } else if (dstStreams == 2 && srcStreams == 2) {
+        mixkernels::mixStereoToStereo(buffer, channelBuffer, m_gains.data(), samplesCount);
+    } else {
+        for (unsigned int s = 0; s < srcStreams; ++s) {
+            mixkernels::mixStream(buffer, dstStreams, channelBuffer, srcStreams, s, &m_gains[s * dstStreams], samplesCount);
         }
     }
 }
@@ -21,14 +21,21 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "imixer.h"
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
 #include "clock.h"
+#include "audioworkerpool.h"
+#include "rendergovernor.h"
+#include "modularity/ioc.h"
+#include "iaudioconfiguration.h"
 
 namespace mu::audio {
 class Mixer : public IMixer, public AbstractAudioSource, public std::enable_shared_from_this<Mixer>
 {
+    INJECT(audio, IAudioConfiguration, configuration)
+
 public:
     Mixer();
     ~Mixer();
@@ -66,15 +73,37 @@ public:
     void setClock(std::shared_ptr<Clock> clock);
 
 private:
+    struct Input {
+        ChannelID id = 0;
+        std::shared_ptr<MixerChannel> channel;
+    };
+    using InputList = std::vector<Input>;
+
+    InputList::iterator findInput(ChannelID channelId);
+    InputList::const_iterator findInput(ChannelID channelId) const;
+
     //! mix the channel in to the buffer
-    void mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount);
-    void mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount);
+    void mixinChannel(MixerChannel& channel, unsigned int samplesCount);
+
+    struct ForwardJob {
+        Mixer* mixer = nullptr;
+        unsigned int sampleCount = 0;
+    };
+    static void forwardChannel(void* context, size_t index);
 
     Mode m_mode = STEREO;
     float m_masterLevel = 1.f;
-    std::map<ChannelID, std::shared_ptr<MixerChannel> > m_inputList = {};
+
+    //! NOTE Sorted by id, a contiguous array is iterated on every forward
+    InputList m_inputList = {};
+    std::vector<float> m_gains = {}; // [srcStream * streamCount() + destStream]
     std::map<unsigned int, std::shared_ptr<IAudioProcessor> > m_insertList = {};
     std::shared_ptr<Clock> m_clock;
+
+    //! NOTE The channels do not depend on each other, they are forwarded in parallel and mixed after all are done
+    AudioWorkerPool m_pool;
+
+    RenderGovernor m_governor;
 };
 }
 
@@ -0,0 +1,259 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "mixkernels.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MU_MIX_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MU_MIX_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MU_MIX_NEON
+#endif
+
+void mu::audio::mixkernels::mixMonoToStereo(float* dest, const float* src, float gainL, float gainR, unsigned int samples)
+{
+    unsigned int i = 0;
+
+#if defined(MU_MIX_AVX)
+    const __m256 g = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+    for (; i + 8 <= samples; i += 8) {
+        __m256 s = _mm256_loadu_ps(src + i);                       // s0 .. s7
+        __m256 lo = _mm256_unpacklo_ps(s, s);                      // s0 s0 s1 s1 | s4 s4 s5 s5
+        __m256 hi = _mm256_unpackhi_ps(s, s);                      // s2 s2 s3 s3 | s6 s6 s7 s7
+        __m256 a = _mm256_permute2f128_ps(lo, hi, 0x20);           // s0 s0 s1 s1 s2 s2 s3 s3
+        __m256 b = _mm256_permute2f128_ps(lo, hi, 0x31);           // s4 s4 s5 s5 s6 s6 s7 s7
+        float* d = dest + i * 2;
+        _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), _mm256_mul_ps(a, g)));
+        _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), _mm256_mul_ps(b, g)));
+    }
+#elif defined(MU_MIX_SSE2)
+    const __m128 g = _mm_setr_ps(gainL, gainR, gainL, gainR);
+    for (; i + 4 <= samples; i += 4) {
+        __m128 s = _mm_loadu_ps(src + i);
+        float* d = dest + i * 2;
+        _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(_mm_unpacklo_ps(s, s), g)));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_mul_ps(_mm_unpackhi_ps(s, s), g)));
+    }
+#elif defined(MU_MIX_NEON)
+    for (; i + 4 <= samples; i += 4) {
+        float32x4_t s = vld1q_f32(src + i);
+        float* d = dest + i * 2;
+        float32x4x2_t v = vld2q_f32(d);                            // deinterleaved L and R
+        v.val[0] = vmlaq_n_f32(v.val[0], s, gainL);
+        v.val[1] = vmlaq_n_f32(v.val[1], s, gainR);
+        vst2q_f32(d, v);
+    }
+#endif
+
+    for (; i < samples; ++i) {
+        dest[i * 2] += src[i] * gainL;
+        dest[i * 2 + 1] += src[i] * gainR;
+    }
+}
+
+void mu::audio::mixkernels::mixStereoToStereo(float* dest, const float* src, const float gains[4], unsigned int samples)
+{
+    const float gLL = gains[0], gLR = gains[1], gRL = gains[2], gRR = gains[3];
+    unsigned int i = 0;
+
+#if defined(MU_MIX_AVX)
+    const __m256 gl = _mm256_setr_ps(gLL, gLR, gLL, gLR, gLL, gLR, gLL, gLR);
+    const __m256 gr = _mm256_setr_ps(gRL, gRR, gRL, gRR, gRL, gRR, gRL, gRR);
+    for (; i + 4 <= samples; i += 4) {
+        __m256 s = _mm256_loadu_ps(src + i * 2);                  // L0 R0 L1 R1 ...
+        __m256 l = _mm256_moveldup_ps(s);                          // L0 L0 L1 L1 ...
+        __m256 r = _mm256_movehdup_ps(s);                          // R0 R0 R1 R1 ...
+        float* d = dest + i * 2;
+        __m256 acc = _mm256_add_ps(_mm256_mul_ps(l, gl), _mm256_mul_ps(r, gr));
+        _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), acc));
+    }
+#elif defined(MU_MIX_SSE2)
+    const __m128 gl = _mm_setr_ps(gLL, gLR, gLL, gLR);
+    const __m128 gr = _mm_setr_ps(gRL, gRR, gRL, gRR);
+    for (; i + 2 <= samples; i += 2) {
+        __m128 s = _mm_loadu_ps(src + i * 2);                     // L0 R0 L1 R1
+        __m128 l = _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 0, 0)); // L0 L0 L1 L1
+        __m128 r = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 1, 1)); // R0 R0 R1 R1
+        float* d = dest + i * 2;
+        __m128 acc = _mm_add_ps(_mm_mul_ps(l, gl), _mm_mul_ps(r, gr));
+        _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), acc));
+    }
+#elif defined(MU_MIX_NEON)
+    for (; i + 4 <= samples; i += 4) {
+        float32x4x2_t s = vld2q_f32(src + i * 2);
+        float* d = dest + i * 2;
+        float32x4x2_t v = vld2q_f32(d);
+        v.val[0] = vmlaq_n_f32(vmlaq_n_f32(v.val[0], s.val[0], gLL), s.val[1], gRL);
+        v.val[1] = vmlaq_n_f32(vmlaq_n_f32(v.val[1], s.val[0], gLR), s.val[1], gRR);
+        vst2q_f32(d, v);
+    }
+#endif
+
+    for (; i < samples; ++i) {
+        float l = src[i * 2];
+        float r = src[i * 2 + 1];
+        dest[i * 2] += l * gLL + r * gRL;
+        dest[i * 2 + 1] += l * gLR + r * gRR;
+    }
+}
+
+void mu::audio::mixkernels::mixStream(float* dest, unsigned int destStreams, const float* src, unsigned int srcStreams,
+                                      unsigned int srcStream, const float* gains, unsigned int samples)
+{
+    for (unsigned int i = 0; i < samples; ++i) {
+        float s = src[i * srcStreams + srcStream];
+        for (unsigned int j = 0; j < destStreams; ++j) {
+            dest[i * destStreams + j] += gains[j] * s;
+        }
+    }
+}
+
+void mu::audio::mixkernels::applyGain(float* buf, size_t count, float gain)
+{
+    size_t i = 0;
+
+#if defined(MU_MIX_AVX)
+    const __m256 g = _mm256_set1_ps(gain);
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(buf + i, _mm256_mul_ps(_mm256_loadu_ps(buf + i), g));
+    }
+#elif defined(MU_MIX_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buf + i, _mm_mul_ps(_mm_loadu_ps(buf + i), g));
+    }
+#elif defined(MU_MIX_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(buf + i, vmulq_n_f32(vld1q_f32(buf + i), gain));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        buf[i] *= gain;
+    }
+}
+
+float mu::audio::mixkernels::dotProduct(const float* a, const float* b, size_t count)
+{
+    size_t i = 0;
+    float sum = 0.f;
+
+#if defined(MU_MIX_AVX)
+    __m256 acc = _mm256_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    __m128 s4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+    s4 = _mm_add_ss(s4, _mm_shuffle_ps(s4, s4, 1));
+    sum = _mm_cvtss_f32(s4);
+#elif defined(MU_MIX_SSE2)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum = _mm_cvtss_f32(acc);
+#elif defined(MU_MIX_NEON)
+    float32x4_t acc = vdupq_n_f32(0.f);
+    for (; i + 4 <= count; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float32x2_t s2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(s2, s2), 0);
+#endif
+
+    for (; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void mu::audio::mixkernels::biquadMono(float* buf, unsigned int samples, const float coeffs[5], float state[2])
+{
+    const float b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+    float z1 = state[0], z2 = state[1];
+    for (unsigned int i = 0; i < samples; ++i) {
+        const float x = buf[i];
+        const float y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        buf[i] = y;
+    }
+    state[0] = z1;
+    state[1] = z2;
+}
+
+void mu::audio::mixkernels::biquadStereo(float* buf, unsigned int samples, const float coeffs[5], float state[4])
+{
+#if defined(MU_MIX_AVX) || defined(MU_MIX_SSE2)
+    //! NOTE Each frame depends on the one before, so only the two channels are parallel: L and R in the low lanes
+    const __m128 b0 = _mm_set1_ps(coeffs[0]), b1 = _mm_set1_ps(coeffs[1]), b2 = _mm_set1_ps(coeffs[2]);
+    const __m128 a1 = _mm_set1_ps(coeffs[3]), a2 = _mm_set1_ps(coeffs[4]);
+    __m128 z1 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(state)));
+    __m128 z2 = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(state + 2)));
+    for (unsigned int i = 0; i < samples; ++i) {
+        double* frame = reinterpret_cast<double*>(buf + i * 2);
+        const __m128 x = _mm_castpd_ps(_mm_load_sd(frame));
+        const __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+        z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2);
+        z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+        _mm_store_sd(frame, _mm_castps_pd(y));
+    }
+    _mm_store_sd(reinterpret_cast<double*>(state), _mm_castps_pd(z1));
+    _mm_store_sd(reinterpret_cast<double*>(state + 2), _mm_castps_pd(z2));
+#elif defined(MU_MIX_NEON)
+    const float b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+    float32x2_t z1 = vld1_f32(state);
+    float32x2_t z2 = vld1_f32(state + 2);
+    for (unsigned int i = 0; i < samples; ++i) {
+        float* frame = buf + i * 2;
+        const float32x2_t x = vld1_f32(frame);
+        const float32x2_t y = vmla_n_f32(z1, x, b0);
+        z1 = vmls_n_f32(vmla_n_f32(z2, x, b1), y, a1);
+        z2 = vmls_n_f32(vmul_n_f32(x, b2), y, a2);
+        vst1_f32(frame, y);
+    }
+    vst1_f32(state, z1);
+    vst1_f32(state + 2, z2);
+#else
+    const float b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+    float z1L = state[0], z1R = state[1], z2L = state[2], z2R = state[3];
+    for (unsigned int i = 0; i < samples; ++i) {
+        float* frame = buf + i * 2;
+        const float xL = frame[0], xR = frame[1];
+        const float yL = b0 * xL + z1L;
+        const float yR = b0 * xR + z1R;
+        z1L = b1 * xL - a1 * yL + z2L;
+        z1R = b1 * xR - a1 * yR + z2R;
+        z2L = b2 * xL - a2 * yL;
+        z2R = b2 * xR - a2 * yR;
+        frame[0] = yL;
+        frame[1] = yR;
+    }
+    state[0] = z1L;
+    state[1] = z1R;
+    state[2] = z2L;
+    state[3] = z2R;
+#endif
+}
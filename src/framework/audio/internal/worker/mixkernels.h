@@ -0,0 +1,50 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_MIXKERNELS_H
+#define MU_AUDIO_MIXKERNELS_H
+
+#include <cstddef>
+
+//! NOTE Mixing kernels of the Mixer, vectorized with AVX, SSE2 or NEON when the target has them,
+//! otherwise scalar. Buffers are interleaved and may be unaligned.
+namespace mu::audio::mixkernels {
+//! dest (stereo) += src (mono) * { gainL, gainR }
+void mixMonoToStereo(float* dest, const float* src, float gainL, float gainR, unsigned int samples);
+
+//! dest (stereo) += src (stereo) * gain matrix: { L to L, L to R, R to L, R to R }
+void mixStereoToStereo(float* dest, const float* src, const float gains[4], unsigned int samples);
+
+//! dest (destStreams) += stream of src (srcStreams) * gains[destStream], for any other layout
+void mixStream(float* dest, unsigned int destStreams, const float* src, unsigned int srcStreams, unsigned int srcStream,
+               const float* gains, unsigned int samples);
+
+//! buf *= gain
+void applyGain(float* buf, size_t count, float gain);
+
+//! sum of a[i] * b[i]
+float dotProduct(const float* a, const float* b, size_t count);
+
+//! biquad in transposed direct form II, in place, coeffs: { b0, b1, b2, a1, a2 } normalized by a0
+//! state: { z1, z2 } of each stream, as { z1 L, z1 R, z2 L, z2 R } for stereo
+void biquadMono(float* buf, unsigned int samples, const float coeffs[5], float state[2]);
+//! the channels of the interleaved stereo buffer are filtered in the lanes of one vector
+void biquadStereo(float* buf, unsigned int samples, const float coeffs[5], float state[4]);
+}
+
+#endif // MU_AUDIO_MIXKERNELS_H
@@ -0,0 +1,105 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "rendergovernor.h"
+
+#include <algorithm>
+
+#include "log.h"
+
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+static constexpr int MAX_LEVEL = 3;
+static constexpr float AVERAGE_FACTOR = 0.1f;
+
+//! NOTE A stolen voice takes a few milliseconds to fade out, the next step is not taken before
+static constexpr unsigned int HOLD_MSEC = 100;
+static constexpr unsigned int CALM_MSEC = 3000;
+
+RenderGovernor::RenderGovernor()
+{
+    if (configuration()) {
+        m_highLoad = configuration()->renderHighLoad();
+        m_lowLoad = std::min(configuration()->renderLowLoad(), m_highLoad);
+        m_voiceLimit = configuration()->renderVoiceLimit();
+    }
+}
+
+int RenderGovernor::level() const
+{
+    return m_level;
+}
+
+void RenderGovernor::blockRendered(std::chrono::microseconds renderTime, unsigned int samples, unsigned int sampleRate)
+{
+    if (m_highLoad <= 0.f || samples == 0 || sampleRate == 0) {
+        return;
+    }
+
+    float blockTime = samples * 1000000.f / sampleRate;
+    float load = renderTime.count() / blockTime;
+    m_averageLoad += (load - m_averageLoad) * AVERAGE_FACTOR;
+
+    m_holdSamples += samples;
+    unsigned int holdSamples = sampleRate * HOLD_MSEC / 1000;
+
+    //! NOTE A single slow block raises the level, the xrun would come with the next one
+    if (load > m_highLoad) {
+        m_calmSamples = 0;
+        if (m_level < MAX_LEVEL && m_holdSamples >= holdSamples) {
+            LOGW() << "render load " << load << ", level " << m_level + 1;
+            setLevel(m_level + 1);
+        }
+        return;
+    }
+
+    if (m_level == 0 || m_averageLoad > m_lowLoad) {
+        m_calmSamples = 0;
+        return;
+    }
+
+    m_calmSamples += samples;
+    if (m_calmSamples >= sampleRate * CALM_MSEC / 1000) {
+        LOGI() << "render load " << m_averageLoad << ", level " << m_level - 1;
+        setLevel(m_level - 1);
+    }
+}
+
+void RenderGovernor::setLevel(int level)
+{
+    m_level = level;
+    m_holdSamples = 0;
+    m_calmSamples = 0;
+
+    RenderBudget b = budget(level);
+    for (const ISynthesizerPtr& synth : synthesizersRegister()->synthesizers()) {
+        synth->setRenderBudget(b);
+    }
+}
+
+RenderBudget RenderGovernor::budget(int level) const
+{
+    RenderBudget b;
+    if (level > 0) {
+        b.maxVoices = std::max(1u, m_voiceLimit >> (level - 1));
+        b.fastInterpolation = level > 1;
+    }
+    return b;
+}
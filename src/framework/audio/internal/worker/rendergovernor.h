@@ -0,0 +1,61 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_AUDIO_RENDERGOVERNOR_H
+#define MU_AUDIO_RENDERGOVERNOR_H
+
+#include <chrono>
+
+#include "modularity/ioc.h"
+#include "iaudioconfiguration.h"
+#include "isynthesizersregister.h"
+#include "synthtypes.h"
+
+namespace mu::audio {
+//! NOTE Watches the render time of the blocks. When it comes close to the block duration,
+//! the synths are made to render less, step by step, before the driver runs out of data.
+//! When the load stays low for a while, they are let back one step at a time
+class RenderGovernor
+{
+    INJECT(audio, IAudioConfiguration, configuration)
+    INJECT(audio, synth::ISynthesizersRegister, synthesizersRegister)
+
+public:
+    RenderGovernor();
+
+    void blockRendered(std::chrono::microseconds renderTime, unsigned int samples, unsigned int sampleRate);
+
+    int level() const;
+
+private:
+    void setLevel(int level);
+    synth::RenderBudget budget(int level) const;
+
+    float m_highLoad = 0.f;
+    float m_lowLoad = 0.f;
+    unsigned int m_voiceLimit = 0;
+
+    int m_level = 0;
+    float m_averageLoad = 0.f;
+    unsigned int m_holdSamples = 0;     // since the level was raised
+    unsigned int m_calmSamples = 0;     // of the low load
+};
+}
+
+#endif // MU_AUDIO_RENDERGOVERNOR_H
@@ -18,73 +18,86 @@
 //=============================================================================
 #include "samplerateconvertor.h"
 #include "log.h"
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 using namespace mu::audio;
 
+static double zeroBessel(double x)
+{
+    //return std::cyl_bessel_i(0, x);
+
+    double s = 1, term = 1;
+    double halfX = x / 2;
+    for (int k = 1; term > s * 1e-12; ++k) {
+        term *= (halfX / k) * (halfX / k);
+        s += term;
+    }
+
+    return s;
+}
+
 SampleRateConvertor::SampleRateConvertor(const std::vector<float>& data,
                                          unsigned int channelsCount,
                                          unsigned int sampleRateIn,
                                          unsigned int sampleRateOut)
-    : m_data(data), m_fir(), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
+    : m_data(data), m_channelsCount(channelsCount), m_sampleRateIn(sampleRateIn), m_sampleRateOut(sampleRateOut)
 {
-    m_fir.resize(FIR_LENGTH, 0);
-    m_y.resize(FIR_LENGTH, 0);
-    initWindow();
+    initFilters();
 }
 
 std::vector<float> SampleRateConvertor::convert()
 {
     std::vector<float> out;
-    auto resultSamples = m_data.size() * m_sampleRateOut / (m_channelsCount * m_sampleRateIn);
+    if (m_channelsCount == 0) {
+        return out;
+    }
+
+    uint64_t resultSamples = static_cast<uint64_t>(inputFrames()) * m_sampleRateOut / m_sampleRateIn;
 
     out.resize(resultSamples * m_channelsCount);
-    for (unsigned sample = 0; sample < resultSamples; ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            out[sample * m_channelsCount + channel] = y(sample, channel);
-        }
+    reset(0);
+    for (uint64_t sample = 0; sample < resultSamples; ++sample) {
+        frame(sample, &out[sample * m_channelsCount]);
     }
+    m_isHistoryValid = false;
 
     return out;
 }
 
 unsigned int SampleRateConvertor::convert(float* buffer, unsigned int from, unsigned int count)
 {
-    unsigned int sample = from;
-    unsigned int converted = 0;
+    if (m_channelsCount == 0) {
+        return 0;
+    }
 
-    for (converted = 0; converted < count; ++converted, ++sample) {
-        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
-            if (!availableSamples(sample)) {
-                return converted;
-            }
-            buffer[converted * m_channelsCount + channel] = y(sample, channel);
-        }
+    if (!m_isHistoryValid || from != m_nextOutputFrame) {
+        reset(from);
     }
-    return converted;
-}
 
-float SampleRateConvertor::y(unsigned int sample, unsigned int channel) const
-{
-    switch (m_method) {
-    case SINC:
-        return ySinc(sample, channel);
-    case FIR:
-        return yFIR(sample, channel);
+    unsigned int converted = 0;
+    for (; converted < count; ++converted) {
+        if (!frame(from + converted, &buffer[converted * m_channelsCount])) {
+            break;
+        }
     }
-    return 0.f;
+    return converted;
 }
 
 void SampleRateConvertor::setChannelCount(unsigned int count)
 {
-    m_channelsCount = count;
+    if (m_channelsCount != count) {
+        m_channelsCount = count;
+        m_isHistoryValid = false;
+    }
 }
 
 void SampleRateConvertor::setSampleRateIn(unsigned int sampleRate)
 {
     if (m_sampleRateIn != sampleRate) {
         m_sampleRateIn = sampleRate;
-        initWindow();
+        initFilters();
     }
 }
 
@@ -92,116 +105,151 @@ void SampleRateConvertor::setSampleRateOut(unsigned int sampleRate)
 {
     if (m_sampleRateOut != sampleRate) {
         m_sampleRateOut = sampleRate;
-        initWindow();
+        initFilters();
     }
 }
 
-float SampleRateConvertor::ySinc(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::setInputWindow(int64_t firstFrame, int64_t inputFrames)
 {
-    double currentOutputSampleTime = sample / static_cast<double>(m_sampleRateOut);
-    auto zeroInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn);
-
-    float out = 0.f;
-    for (unsigned int i = 0; i < USE_SAMPLES; ++i) {
-        int currentSample = zeroInputSample + i - USE_SAMPLES / 2;
-        double currentInputSampleTime = currentSample / static_cast<double>(m_sampleRateIn);
-
-        if (currentSample < 0 || currentSample * m_channelsCount + channel >= m_data.size()) {
-            continue;
-        }
-        out += m_data.at(currentSample * m_channelsCount + channel) * sinc(currentOutputSampleTime - currentInputSampleTime);
-    }
-    return out;
+    m_windowFirstFrame = firstFrame;
+    m_inputFrames = inputFrames;
 }
 
-float SampleRateConvertor::yFIR(unsigned int sample, unsigned int channel) const
+void SampleRateConvertor::inputRange(uint64_t from, unsigned int count, int64_t& first, int64_t& last) const
 {
-    auto x = [this, &channel](int m) -> float {
-        int pos = m * m_M / m_L * m_channelsCount + channel;
-        if (pos >= 0 && pos < static_cast<int>(m_data.size())) {
-            return m_data.at(pos);
-        }
-        return 0.f;
-    };
-
-    float y = 0.f;
-    for (unsigned int i = 0; i < FIR_LENGTH; ++i) {
-        int t = sample - static_cast<int>(i);
-        y += x(t) * m_fir[i];
+    if (m_isHistoryValid && from == m_nextOutputFrame) {
+        first = m_nextInputFrame;
+    } else {
+        first = static_cast<int64_t>(from * m_M / m_L) - static_cast<int64_t>(TAPS) / 2 + 1;
     }
-    return y;
+    //! NOTE The rounding to the nearest phase may move the last output frame to the next input frame
+    const uint64_t lastOutput = from + (count ? count - 1 : 0);
+    last = static_cast<int64_t>(lastOutput * m_M / m_L) + 1 + TAPS / 2;
 }
 
-bool SampleRateConvertor::availableSamples(unsigned int sample) const
+int64_t SampleRateConvertor::inputFrames() const
 {
-    float currentOutputSampleTime = sample / static_cast<float>(m_sampleRateOut);
-    auto firstInputSample = std::floor(currentOutputSampleTime * m_sampleRateIn) - USE_SAMPLES / 2;
-
-    // first sample for convertion points out of the input buffer
-    if (firstInputSample * m_channelsCount >= m_data.size()) {
-        return false;
+    if (m_inputFrames >= 0) {
+        return m_inputFrames;
     }
-    return true;
+    return m_channelsCount ? static_cast<int64_t>(m_data.size() / m_channelsCount) : 0;
 }
 
-inline double zeroBessel(double x)
+void SampleRateConvertor::reset(uint64_t outputFrame)
 {
-    //return std::cyl_bessel_i(0, x);
-
-    double s = 1, y = 1;
-    int m = 1;
+    m_history.assign(2 * TAPS * m_channelsCount, 0.f);
+    m_historyPos = 0;
+
+    //! NOTE The first frame the filter of the output frame needs
+    int64_t inputFrame = static_cast<int64_t>(outputFrame * m_M / m_L);
+    m_nextInputFrame = inputFrame - static_cast<int64_t>(TAPS) / 2 + 1;
+    m_nextOutputFrame = outputFrame;
+    m_isHistoryValid = true;
+}
 
-    while (y > std::numeric_limits<float>::min()) {
-        m += 2;
-        y *= x * x / (4 * m * m);
-        s += s * y;
+void SampleRateConvertor::pushFrames(int64_t frame)
+{
+    const int64_t frames = inputFrames();
+    const int64_t windowEnd = m_windowFirstFrame + static_cast<int64_t>(m_data.size() / m_channelsCount);
+    for (; m_nextInputFrame <= frame; ++m_nextInputFrame) {
+        const bool isInside = m_nextInputFrame >= 0 && m_nextInputFrame < frames
+                              && m_nextInputFrame >= m_windowFirstFrame && m_nextInputFrame < windowEnd;
+        const int64_t index = m_nextInputFrame - m_windowFirstFrame;
+        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+            float value = isInside ? m_data[index * m_channelsCount + channel] : 0.f;
+            float* history = &m_history[channel * 2 * TAPS];
+            history[m_historyPos] = value;
+            history[m_historyPos + TAPS] = value;
+        }
+        m_historyPos = (m_historyPos + 1) % TAPS;
     }
-
-    return s;
 }
 
-void SampleRateConvertor::initWindow()
+bool SampleRateConvertor::frame(uint64_t outputFrame, float* out)
 {
-    int max = std::max(m_sampleRateIn, m_sampleRateOut), min = std::min(m_sampleRateIn, m_sampleRateOut);
-    int maxCommonDivider = 1;
-    while (max % min != 0) {
-        maxCommonDivider = max % min;
-        max = min;
-        min = maxCommonDivider;
+    const uint64_t position = outputFrame * m_M;
+    int64_t inputFrame = static_cast<int64_t>(position / m_L);
+    if (inputFrame >= inputFrames()) {
+        return false;
     }
-    m_M = m_sampleRateIn / maxCommonDivider;
-    m_L = m_sampleRateOut / maxCommonDivider;
-    double fStop = std::min(m_sampleRateIn, m_sampleRateOut) / 2,
-           fIntermediateSampleRate = m_sampleRateIn * m_M,
-           attenuation = 96 /*dB*/;
-    int M = FIR_LENGTH;
-    int Np = (M - 1) / 2;
 
-    double alpha = 0.1102 * (attenuation - 8.7);
-    double A[FIR_LENGTH];
-
-    A[0] = 2 * fStop / fIntermediateSampleRate;
-    for (int j = 1; j <= Np; j++) {
-        A[j]  = std::sin(2 * j * M_PI * fStop / fIntermediateSampleRate) / j * M_PI;
+    uint64_t phase = position % m_L;
+    if (m_L > m_phases) {
+        phase = (phase * m_phases + m_L / 2) / m_L;
+        if (phase == m_phases) {
+            phase = 0;
+            ++inputFrame;
+        }
     }
 
-    for (int j = 0; j <= Np; j++) {
-        m_fir[Np + j]  = A[j];
-        m_fir[Np + j] *= zeroBessel(alpha * std::sqrt(1 - (j * j / (Np * Np))));
-        m_fir[Np + j] /= zeroBessel(alpha);
+    //! NOTE The filter of a phase covers the input frames (inputFrame - TAPS / 2, inputFrame + TAPS / 2]
+    pushFrames(inputFrame + TAPS / 2);
+
+    const float* filter = &m_filters[phase * TAPS];
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        const float* history = &m_history[channel * 2 * TAPS + m_historyPos];
+        out[channel] = dotProduct(history, filter, TAPS);
     }
 
-    for (int j = 0; j < Np; j++) {
-        m_fir[j] = m_fir[M - 1 - j];
+    m_nextOutputFrame = outputFrame + 1;
+    return true;
+}
+
+//! NOTE Four independent sums, so that the compiler can use vector registers
+float SampleRateConvertor::dotProduct(const float* a, const float* b, unsigned int count)
+{
+    float s0 = 0.f, s1 = 0.f, s2 = 0.f, s3 = 0.f;
+    unsigned int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < count; ++i) {
+        s0 += a[i] * b[i];
     }
+    return (s0 + s1) + (s2 + s3);
 }
 
-double SampleRateConvertor::sinc(double value) const
+void SampleRateConvertor::initFilters()
 {
-    if (value == 0) {
-        return 1.f;
+    const uint64_t gcd = std::gcd(m_sampleRateIn ? m_sampleRateIn : 1, m_sampleRateOut ? m_sampleRateOut : 1);
+    m_M = std::max(m_sampleRateIn, 1u) / gcd;
+    m_L = std::max(m_sampleRateOut, 1u) / gcd;
+    m_phases = static_cast<unsigned int>(std::min<uint64_t>(m_L, MAX_PHASES));
+    m_isHistoryValid = false;
+
+    //! NOTE Low pass at the lower of both Nyquist frequencies, relative to the input one
+    const double cutoff = std::min(1.0, static_cast<double>(m_L) / m_M);
+    const double attenuation = 96 /*dB*/;
+    const double beta = 0.1102 * (attenuation - 8.7);
+    const double halfLength = TAPS / 2;
+    const double betaBessel = zeroBessel(beta);
+
+    m_filters.resize(m_phases * TAPS);
+    for (unsigned int phase = 0; phase < m_phases; ++phase) {
+        float* filter = &m_filters[phase * TAPS];
+        const double fraction = static_cast<double>(phase) / m_phases;
+
+        double sum = 0;
+        for (unsigned int k = 0; k < TAPS; ++k) {
+            //! distance of the tap from the output position, in input frames
+            double distance = static_cast<double>(k) - (halfLength - 1) - fraction;
+            double x = M_PI * cutoff * distance;
+            double sinc = x == 0 ? 1.0 : std::sin(x) / x;
+
+            double r = distance / halfLength;
+            double window = std::abs(r) < 1 ? zeroBessel(beta * std::sqrt(1 - r * r)) / betaBessel : 0.0;
+
+            double value = cutoff * sinc * window;
+            filter[k] = static_cast<float>(value);
+            sum += value;
+        }
+
+        //! NOTE Unity gain at DC for each phase
+        for (unsigned int k = 0; k < TAPS; ++k) {
+            filter[k] = static_cast<float>(filter[k] / sum);
+        }
     }
-    double sincArg = M_PI * value * m_sampleRateIn;
-    double gain = std::min(1.0, m_sampleRateOut / static_cast<double>(m_sampleRateIn));
-    return gain * std::sin(sincArg) / sincArg;
 }
@@ -19,57 +19,77 @@
 #ifndef MU_AUDIO_SAMPLERATECONVERTOR_H
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
+#include <cstdint>
 #include <vector>
-#include <deque>
+
 namespace mu::audio {
+//! NOTE Polyphase resampler: the rates ratio is reduced to L/M, the output frame n lies
+//! at the input position n * M / L and is the dot product of the input around it with
+//! the filter of its phase, (n * M) % L. The filters of all phases are computed when
+//! the rates are set, so converting is only multiply-adds
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
-    };
     explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
                                  unsigned int sampleRateOut);
 
     //! offline convert full data set
     std::vector<float> convert();
 
-    //! online convert
+    //! online convert, from and count are in output frames
     unsigned int convert(float* buffer, unsigned int from, unsigned int count);
 
     void setChannelCount(unsigned int count);
     void setSampleRateIn(unsigned int sampleRate);
     void setSampleRateOut(unsigned int sampleRate);
 
+    //! the data holds the input frames from firstFrame on, of inputFrames in all,
+    //! so that a stream can be converted block by block
+    void setInputWindow(int64_t firstFrame, int64_t inputFrames);
+
+    //! the input frames [first, last] the online convert of the output frames reads
+    void inputRange(uint64_t from, unsigned int count, int64_t& first, int64_t& last) const;
+
 private:
+    //! calculate the filters of all phases
+    void initFilters();
+
+    //! start the history anew at the output frame
+    void reset(uint64_t outputFrame);
 
-    //! return value of sinc function (LPF) with considaration of used sampleRates
-    double sinc(double value) const;
+    //! push the input frames up to the frame into the history
+    void pushFrames(int64_t frame);
 
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
+    //! output frame into out, false if it is past the end of the input
+    bool frame(uint64_t outputFrame, float* out);
 
-    //! return true if there are samples in input buffer for convertion
-    bool availableSamples(unsigned int sample) const;
+    int64_t inputFrames() const;
 
-    //! calculate window function values
-    void initWindow();
+    static float dotProduct(const float* a, const float* b, unsigned int count);
+
+    const static unsigned int TAPS = 32;            //!< length of the filter of a phase, defines the quality and complexity of SRC
+    const static unsigned int MAX_PHASES = 1024;    //!< more phases are rounded to the nearest one
 
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
     const std::vector<float>& m_data;
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
+    uint64_t m_L = 1;
+    uint64_t m_M = 1;
+    unsigned int m_phases = 1;
+    std::vector<float> m_filters;                   //!< TAPS coefficients per phase
+
+    //! the last TAPS input frames of each channel, stored twice so that they are always contiguous
+    std::vector<float> m_history;
+    unsigned int m_historyPos = 0;
+    int64_t m_nextInputFrame = 0;
+    uint64_t m_nextOutputFrame = 0;
+    bool m_isHistoryValid = false;
+
+    int64_t m_windowFirstFrame = 0;
+    int64_t m_inputFrames = -1;                     //!< -1 if the data holds all input frames
 
     unsigned int m_channelsCount;
     unsigned int m_sampleRateIn;
     unsigned int m_sampleRateOut;
-    Method m_method = FIR;
 };
 }
 
@@ -21,6 +21,7 @@
 #include "log.h"
 
 #include "internal/audiosanitizer.h"
+#include "internal/playbackposition.h"
 #include "midiplayer.h"
 #include "audioplayer.h"
 
@@ -124,6 +125,12 @@ mu::async::Channel<Sequencer::AudioTrack> Sequencer::audioTrackAdded() const
     return m_audioTrackAdded;
 }
 
+mu::async::Channel<Sequencer::MidiTrack> Sequencer::midiTrackAdded() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    return m_midiTrackAdded;
+}
+
 void Sequencer::initAudioTrack(ISequencer::TrackID id)
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -165,6 +172,22 @@ void Sequencer::unsetLoop()
     m_loopEnd.reset();
 }
 
+void Sequencer::setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (MidiTrack track = midiTrack(id)) {
+        track->setIsTrackFrozen(trackIndex, frozen);
+    }
+}
+
+void Sequencer::setIsMetronomeEnabled(TrackID id, bool enabled)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (MidiTrack track = midiTrack(id)) {
+        track->setIsMetronomeEnabled(enabled);
+    }
+}
+
 std::shared_ptr<Clock> Sequencer::clock() const
 {
     return m_clock;
@@ -172,26 +195,75 @@ std::shared_ptr<Clock> Sequencer::clock() const
 
 void Sequencer::timeUpdate()
 {
-    if (m_loopStart.has_value() && m_loopEnd.has_value()) {
-        if (m_clock->timeInMiliSeconds() >= m_loopEnd) {
-            seek(m_loopStart.value_or(0));
+    bool willcontinue = false;
+    if (!forwardOverLoopEnd()) {
+        if (m_loopStart.has_value() && m_loopEnd.has_value()) {
+            if (m_clock->timeInMiliSeconds() >= m_loopEnd) {
+                seek(m_loopStart.value_or(0));
+            }
+        }
+
+        for (auto& val : m_tracks) {
+            Track& track = val.second;
+            track->forwardTime(m_clock->timeInMiliSeconds());
         }
     }
 
-    bool willcontinue = false;
     for (auto& val : m_tracks) {
-        Track& track = val.second;
-        track->forwardTime(m_clock->timeInMiliSeconds());
-        willcontinue |= track->isRunning();
+        willcontinue |= val.second->isRunning();
     }
+    publishPosition();
     m_positionChanged.notify();
     if (!willcontinue) {
         stop();
     }
 }
 
+//! NOTE If the block just forwarded spans the loop end, the tracks play up to the loop end in the
+//! first part of the block and from the loop start in the rest of it, so that the jump is gapless
+bool Sequencer::forwardOverLoopEnd()
+{
+    if (!m_loopStart.has_value() || !m_loopEnd.has_value() || m_loopEnd.value() <= m_loopStart.value()) {
+        return false;
+    }
+
+    const Clock::time_t rate = m_clock->sampleRate();
+    const Clock::time_t blockEnd = m_clock->time();
+    const Clock::time_t samples = m_clock->forwardedSamples();
+    const Clock::time_t loopStart = m_loopStart.value() * rate / 1000;
+    const Clock::time_t loopEnd = m_loopEnd.value() * rate / 1000;
+    if (samples > blockEnd || blockEnd - samples >= loopEnd || blockEnd < loopEnd) {
+        return false;
+    }
+
+    const Clock::time_t head = loopEnd - (blockEnd - samples);
+    const Clock::time_t tail = std::min(samples - head, loopEnd - loopStart);
+
+    m_clock->setForwardedSection(0, head);
+    for (auto& val : m_tracks) {
+        val.second->forwardTime(m_loopEnd.value());
+    }
+
+    m_clock->seek(loopStart + tail);
+    m_clock->setForwardedSection(head, samples - head);
+    for (auto& val : m_tracks) {
+        val.second->seek(m_loopStart.value());
+        val.second->forwardTime(m_clock->timeInMiliSeconds());
+    }
+    m_clock->setForwardedSection(0, samples);
+
+    return true;
+}
+
+void Sequencer::publishPosition()
+{
+    PlaybackPosition::instance()->publish(m_clock->timeInSeconds(), m_status == PLAYING);
+}
+
 void Sequencer::beforeTimeUpdate(Clock::time_t milliseconds)
 {
+    m_midiInputMonitor.process();
+
     if (m_nextStatus != m_status) {
         setStatus(m_nextStatus);
     }
@@ -204,6 +276,7 @@ void Sequencer::beforeTimeUpdate(Clock::time_t milliseconds)
         for (auto& track : m_tracks) {
             track.second->seek(millisecs);
         }
+        publishPosition();
         m_positionChanged.notify();
     }
 
@@ -241,6 +314,8 @@ void Sequencer::setStatus(Status status)
     for (auto& track : m_tracks) {
         applyStatus(track.second);
     }
+
+    publishPosition();
 }
 
 std::optional<Sequencer::Track> Sequencer::track(Sequencer::TrackID id) const
@@ -264,7 +339,9 @@ Sequencer::MidiTrack Sequencer::midiTrack(TrackID id) const
 Sequencer::MidiTrack Sequencer::createMIDITrack(TrackID id)
 {
     auto player = std::make_shared<MIDIPlayer>();
+    player->setClock(m_clock);
     m_tracks[id] = player;
+    m_midiTrackAdded.send(player);
     return player;
 }
 
@@ -293,6 +370,7 @@ void Sequencer::instantlyPlayMidi(const midi::MidiData& data)
         return;
     }
     auto player = std::make_shared<MIDIPlayer>();
+    player->setClock(m_clock);
     auto midiStream = std::make_shared<midi::MidiStream>();
 
     midiStream->initData = data;
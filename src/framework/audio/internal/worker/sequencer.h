@@ -27,6 +27,7 @@
 #include "isequencer.h"
 #include "imidiplayer.h"
 #include "iaudioplayer.h"
+#include "midiinputmonitor.h"
 
 namespace mu::audio {
 class Sequencer : public ISequencer, public async::Asyncable
@@ -49,6 +50,8 @@ public:
     void rewind() override;
     void setLoop(uint64_t fromMilliseconds, uint64_t toMilliseconds) override;
     void unsetLoop() override;
+    void setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen) override;
+    void setIsMetronomeEnabled(TrackID id, bool enabled) override;
 
     std::shared_ptr<Clock> clock() const;
 
@@ -57,6 +60,7 @@ public:
     void setAudioTrack(TrackID id, const std::shared_ptr<IAudioStream>& stream) override;
 
     async::Channel<AudioTrack> audioTrackAdded() const;
+    async::Channel<MidiTrack> midiTrackAdded() const;
     void initAudioTrack(TrackID id) override;
 
     async::Channel<mu::midi::tick_t> midiTickPlayed(TrackID id) const override;
@@ -69,6 +73,8 @@ private:
     void setStatus(Status status);
     void timeUpdate();
     void beforeTimeUpdate(Clock::time_t time);
+    bool forwardOverLoopEnd();
+    void publishPosition();
 
     std::optional<Track> track(TrackID id) const;
     MidiTrack midiTrack(TrackID id) const;
@@ -82,9 +88,11 @@ private:
     std::shared_ptr<Clock> m_clock = nullptr;
     std::map<TrackID, Track> m_tracks = {};
     std::list<std::pair<Clock::time_t, Track> > m_backgroudPlayers = {};
+    MidiInputMonitor m_midiInputMonitor;
 
     async::Channel<Status> m_statusChanged;
     async::Channel<AudioTrack> m_audioTrackAdded;
+    async::Channel<MidiTrack> m_midiTrackAdded;
     async::Notification m_positionChanged;
 
     std::optional<Clock::time_t> m_loopStart, m_loopEnd;
@@ -0,0 +1,192 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "timestretcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mixkernels.h"
+
+using namespace mu::audio;
+
+static constexpr float MIN_SPEED = 0.25f;
+static constexpr float MAX_SPEED = 4.f;
+
+//! NOTE The search for the most similar position is made every COARSE_STEP frames, then refined around the best
+static constexpr int64_t COARSE_STEP = 4;
+
+void TimeStretcher::setup(unsigned int channelsCount, unsigned int sampleRate)
+{
+    m_channels = channelsCount;
+    m_hop = std::max(sampleRate / 100, 16u);
+    m_frameSize = 2 * m_hop;
+    m_search = std::max(sampleRate / 200, 8u);
+
+    //! NOTE Hann window, the windows of frames half a frame apart add up to 1
+    m_window.resize(m_frameSize);
+    for (unsigned int i = 0; i < m_frameSize; ++i) {
+        m_window[i] = 0.5f - 0.5f * std::cos(2.0 * M_PI * i / m_frameSize);
+    }
+
+    reset();
+}
+
+void TimeStretcher::reset()
+{
+    m_input.clear();
+    m_inputFirst = 0;
+    m_position = 0.0;
+    m_previous = -1;
+    m_overlap.assign(m_frameSize * m_channels, 0.f);
+    m_output.clear();
+    m_outputRead = 0;
+}
+
+void TimeStretcher::setSpeed(float speed)
+{
+    m_speed = std::clamp(speed, MIN_SPEED, MAX_SPEED);
+}
+
+float TimeStretcher::speed() const
+{
+    return m_speed;
+}
+
+unsigned int TimeStretcher::inputNeeded() const
+{
+    if (!m_channels) {
+        return 0;
+    }
+    const int64_t nominal = std::llround(m_position);
+    int64_t end = nominal + m_frameSize + (m_previous < 0 ? 0 : m_search);
+    if (m_previous >= 0) {
+        end = std::max(end, m_previous + m_hop + m_hop);
+    }
+    return static_cast<unsigned int>(std::max<int64_t>(end - inputEnd(), 0));
+}
+
+void TimeStretcher::putInput(const float* input, unsigned int frames)
+{
+    if (!m_channels) {
+        return;
+    }
+    m_input.insert(m_input.end(), input, input + frames * m_channels);
+    while (inputNeeded() == 0) {
+        makeFrame();
+    }
+}
+
+unsigned int TimeStretcher::outputAvailable() const
+{
+    return m_channels ? static_cast<unsigned int>((m_output.size() - m_outputRead) / m_channels) : 0;
+}
+
+unsigned int TimeStretcher::takeOutput(float* output, unsigned int frames)
+{
+    frames = std::min(frames, outputAvailable());
+    std::copy_n(m_output.begin() + m_outputRead, frames * m_channels, output);
+    m_outputRead += frames * m_channels;
+
+    if (m_outputRead * 2 >= m_output.size()) {
+        m_output.erase(m_output.begin(), m_output.begin() + m_outputRead);
+        m_outputRead = 0;
+    }
+    return frames;
+}
+
+void TimeStretcher::makeFrame()
+{
+    const int64_t nominal = std::llround(m_position);
+    const int64_t position = m_previous < 0 ? nominal : bestPosition(nominal);
+
+    const float* frame = inputAt(position);
+    for (unsigned int i = 0; i < m_frameSize; ++i) {
+        const float w = m_window[i];
+        for (unsigned int c = 0; c < m_channels; ++c) {
+            m_overlap[i * m_channels + c] += frame[i * m_channels + c] * w;
+        }
+    }
+
+    //! NOTE The first half of the frame is complete, the second one is added up with the next frame
+    const size_t hopSamples = m_hop * m_channels;
+    m_output.insert(m_output.end(), m_overlap.begin(), m_overlap.begin() + hopSamples);
+    std::copy(m_overlap.begin() + hopSamples, m_overlap.end(), m_overlap.begin());
+    std::fill(m_overlap.end() - hopSamples, m_overlap.end(), 0.f);
+
+    m_previous = position;
+    m_position += m_speed * m_hop;
+
+    //! NOTE Keep the input the next search and its target need
+    int64_t keep = std::min<int64_t>(std::llround(m_position) - m_search, m_previous + m_hop);
+    keep = std::clamp<int64_t>(keep, m_inputFirst, inputEnd());
+    m_input.erase(m_input.begin(), m_input.begin() + (keep - m_inputFirst) * m_channels);
+    m_inputFirst = keep;
+}
+
+int64_t TimeStretcher::bestPosition(int64_t nominal) const
+{
+    //! NOTE The input that would follow the previous frame if the speed were 1
+    const float* target = inputAt(m_previous + m_hop);
+
+    const int64_t first = std::max(nominal - static_cast<int64_t>(m_search), m_inputFirst);
+    const int64_t last = std::min(nominal + static_cast<int64_t>(m_search), inputEnd() - m_frameSize);
+    if (first >= last) {
+        return std::clamp(nominal, m_inputFirst, std::max(m_inputFirst, inputEnd() - m_frameSize));
+    }
+
+    int64_t best = first;
+    float bestSimilarity = -1.f;
+    for (int64_t p = first; p <= last; p += COARSE_STEP) {
+        float s = similarity(target, p);
+        if (s > bestSimilarity) {
+            bestSimilarity = s;
+            best = p;
+        }
+    }
+
+    const int64_t coarse = best;
+    for (int64_t p = std::max(coarse - COARSE_STEP + 1, first); p <= std::min(coarse + COARSE_STEP - 1, last); ++p) {
+        float s = similarity(target, p);
+        if (s > bestSimilarity) {
+            bestSimilarity = s;
+            best = p;
+        }
+    }
+    return best;
+}
+
+//! NOTE The correlation of the overlapping halves, normalized by the energy of the candidate
+float TimeStretcher::similarity(const float* target, int64_t position) const
+{
+    const float* candidate = inputAt(position);
+    const size_t count = m_hop * m_channels;
+    const float correlation = mixkernels::dotProduct(target, candidate, count);
+    const float energy = mixkernels::dotProduct(candidate, candidate, count);
+    return correlation / std::sqrt(energy + 1e-9f);
+}
+
+int64_t TimeStretcher::inputEnd() const
+{
+    return m_inputFirst + static_cast<int64_t>(m_input.size() / std::max(m_channels, 1u));
+}
+
+const float* TimeStretcher::inputAt(int64_t frame) const
+{
+    return m_input.data() + (frame - m_inputFirst) * m_channels;
+}
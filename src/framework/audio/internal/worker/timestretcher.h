@@ -0,0 +1,72 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_TIMESTRETCHER_H
+#define MU_AUDIO_TIMESTRETCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE Changes the speed of audio without changing its pitch (WSOLA): frames of 20 ms of the input,
+//! taken at the speed times the output hop apart, are overlap-added at half a frame apart. Each frame
+//! is moved by up to 5 ms to where it is most similar to the continuation of the previous one, so that
+//! the overlaps add up in phase. The input is pulled by the caller, as much as inputNeeded() tells
+class TimeStretcher
+{
+public:
+    void setup(unsigned int channelsCount, unsigned int sampleRate);
+    void reset();
+
+    void setSpeed(float speed);
+    float speed() const;
+
+    //! input frames to put before the next output can be made
+    unsigned int inputNeeded() const;
+    void putInput(const float* input, unsigned int frames);
+
+    unsigned int outputAvailable() const;
+    unsigned int takeOutput(float* output, unsigned int frames);
+
+private:
+    void makeFrame();
+    int64_t bestPosition(int64_t nominal) const;
+    float similarity(const float* target, int64_t position) const;
+    int64_t inputEnd() const;
+    const float* inputAt(int64_t frame) const;
+
+    unsigned int m_channels = 0;
+    unsigned int m_frameSize = 0;
+    unsigned int m_hop = 0;
+    unsigned int m_search = 0;
+    std::vector<float> m_window;
+    float m_speed = 1.f;
+
+    std::vector<float> m_input;
+    int64_t m_inputFirst = 0;           //!< the input frame m_input starts with
+    double m_position = 0.0;            //!< the nominal input frame of the next frame
+    int64_t m_previous = -1;            //!< the input frame of the previous frame
+
+    std::vector<float> m_overlap;       //!< the frame being added up
+    std::vector<float> m_output;
+    size_t m_outputRead = 0;
+};
+}
+
+#endif // MU_AUDIO_TIMESTRETCHER_H
@@ -0,0 +1,82 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_AUDIO_IOFFLINEAUDIORENDERER_H
+#define MU_AUDIO_IOFFLINEAUDIORENDERER_H
+
+#include <functional>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "modularity/imoduleexport.h"
+#include "ret.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+struct OfflineRenderOptions {
+    unsigned int sampleRate = 44100;
+    unsigned int blockSize = 8192;      // samples per channel
+    unsigned int tailMsec = 2000;       // rendered after the last tick, for releases and reverb
+    unsigned int instancesPerSynth = 1; // channels are split between instances rendered in parallel
+
+    //! NOTE Only the ticks from fromTick to toTick (lastTick if 0) are output, so that an export can be split.
+    //! The synthesizers are run for preRollMsec before fromTick without output, for the notes still sounding there.
+    //! The events before the pre-roll are handled at its beginning, except for the notes
+    midi::tick_t fromTick = 0;
+    midi::tick_t toTick = 0;
+    unsigned int preRollMsec = 2000;
+
+    //! NOTE Each stem is also output alone, along with the mix of all channels. The channels of a stem
+    //! are rendered by synthesizer instances of their own; a channel belongs to the first stem it is in
+    std::vector<std::set<midi::channel_t> > stems;
+};
+
+struct OfflineRenderBlock {
+    const float* data = nullptr;        // interleaved stereo
+    unsigned int samples = 0;           // per channel
+    uint64_t renderedSamples = 0;       // including this block
+    uint64_t totalSamples = 0;
+    uint64_t startSample = 0;           // of fromTick, where the output begins on the timeline of the whole data
+    std::vector<const float*> stems;    // the same block of each of Options::stems, interleaved stereo
+};
+
+//! NOTE Renders midi data to PCM as fast as possible, without a driver and the realtime clock.
+//! Used by audio export, it has its own synthesizer instances, so it does not disturb playback.
+class IOfflineAudioRenderer : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IOfflineAudioRenderer)
+
+public:
+    virtual ~IOfflineAudioRenderer() = default;
+
+    using Options = OfflineRenderOptions;
+    using Block = OfflineRenderBlock;
+
+    //! NOTE Called for the chunk starting at fromTick, when the renderer gets close to it
+    using ChunkLoader = std::function<midi::Chunk (midi::tick_t fromTick)>;
+
+    //! NOTE Return false to cancel rendering
+    using BlockHandler = std::function<bool (const Block& block)>;
+
+    virtual Ret render(const midi::MidiData& data, midi::tick_t lastTick, const ChunkLoader& loadChunk, const BlockHandler& onBlock,
+                       const Options& options = Options()) = 0;
+};
+}
+
+#endif // MU_AUDIO_IOFFLINEAUDIORENDERER_H
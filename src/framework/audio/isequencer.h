@@ -58,6 +58,13 @@ public:
     virtual void setLoop(uint64_t fromMilliseconds, uint64_t toMilliseconds) = 0;
     virtual void unsetLoop() = 0;
 
+    //! NOTE The audio of a frozen track of a midi track is rendered in the background and streamed back,
+    //! only the chunks changed by an edit are rendered again
+    virtual void setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen) = 0;
+
+    //! NOTE The metronome clicks are mixed in by the audio engine, no midi is rendered again
+    virtual void setIsMetronomeEnabled(TrackID id, bool enabled) = 0;
+
     virtual async::Channel<midi::tick_t> midiTickPlayed(TrackID id) const = 0;
     virtual async::Notification positionChanged() const = 0;
 
@@ -46,6 +46,9 @@ public:
 
     virtual Ret setupChannels(const std::vector<midi::Event>& events) = 0;
     virtual bool handleEvent(const midi::Event& e) = 0;
+
+    //! NOTE Handles the event at the sample offset in the block of the next forward
+    virtual void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) = 0;
     virtual void writeBuf(float* stream, unsigned int samples) = 0;
 
     virtual void allSoundsOff() = 0; // all channels
@@ -54,6 +57,9 @@ public:
     virtual bool channelVolume(midi::channel_t chan, float val) = 0;  // 0. - 1.
     virtual bool channelBalance(midi::channel_t chan, float val) = 0; // -1. - 1.
     virtual bool channelPitch(midi::channel_t chan, int16_t val) = 0; // -12 - 12
+
+    //! NOTE Over the voice limit the quietest voices are stolen
+    virtual void setRenderBudget(const RenderBudget& budget) = 0;
 };
 
 using ISynthesizerPtr = std::shared_ptr<ISynthesizer>;
@@ -126,6 +126,41 @@ Rectangle {
             }
         }
 
+        Row {
+            anchors.left:  parent.left
+            anchors.right: parent.right
+            height:  40
+            Text {
+                text: devtools.rpcStats
+                anchors.left:  parent.left
+                anchors.right: parent.right
+            }
+        }
+
+        Row {
+            anchors.left:  parent.left
+            anchors.right: parent.right
+            height:  40
+            spacing: 8
+            FlatButton {
+                text: "Benchmark 48k/256"
+                width: 160
+                onClicked: devtools.runBenchmark(48000, 256)
+            }
+
+            FlatButton {
+                text: "Benchmark 44.1k/64"
+                width: 160
+                onClicked: devtools.runBenchmark(44100, 64)
+            }
+
+            Text {
+                text: devtools.benchmarkResult
+                wrapMode: Text.WrapAnywhere
+                width: parent.width - 336
+            }
+        }
+
         RowLayout {
             spacing: 2
             anchors.left:  parent.left
@@ -38,6 +38,19 @@ enum class SoundFontFormat {
 };
 using SoundFontFormats = std::set<SoundFontFormat>;
 
+//! NOTE What the synthesizers save on the rendering while the audio thread is short of time
+struct RenderBudget {
+    unsigned int maxVoices = 0; // 0 - no limit
+    bool fastInterpolation = false;
+
+    bool operator ==(const RenderBudget& other) const
+    {
+        return other.maxVoices == maxVoices && other.fastInterpolation == fastInterpolation;
+    }
+
+    bool operator !=(const RenderBudget& other) const { return !operator ==(other); }
+};
+
 struct SynthesizerState {
     enum class ValID {
         UndefinedID = -1,
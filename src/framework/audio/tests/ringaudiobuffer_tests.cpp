@@ -0,0 +1,80 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "internal/ringaudiobuffer.h"
+
+using namespace mu::audio;
+
+class RingAudioBufferTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(RingAudioBufferTests, RingAudioBuffer_NoDropout)
+{
+    //! GIVEN A stereo buffer with 256 samples in it
+
+    RingAudioBuffer buffer(2, 1024);
+    std::vector<float> source(256 * 2, 0.5f);
+    buffer.push(source.data(), 256);
+
+    //! DO Pop all of them
+
+    std::vector<float> dest(256 * 2, 0.f);
+    buffer.pop(dest.data(), 256);
+
+    //! CHECK Nothing was missing
+
+    EXPECT_EQ(buffer.dropoutCount(), 0u);
+    EXPECT_EQ(dest, source);
+}
+
+TEST_F(RingAudioBufferTests, RingAudioBuffer_Underrun)
+{
+    //! GIVEN A stereo buffer with 100 samples in it
+
+    RingAudioBuffer buffer(2, 1024);
+    std::vector<float> source(100 * 2, 0.5f);
+    buffer.push(source.data(), 100);
+
+    //! DO Pop more than there is
+
+    std::vector<float> dest(128 * 2, 1.f);
+    buffer.pop(dest.data(), 128);
+
+    //! CHECK The samples there were are played, the rest is silence, and one dropout is counted
+
+    EXPECT_EQ(buffer.dropoutCount(), 1u);
+    for (size_t i = 0; i < dest.size(); ++i) {
+        EXPECT_EQ(dest[i], i < source.size() ? 0.5f : 0.f);
+    }
+
+    //! DO Pop from the empty buffer, then refill it and pop again
+
+    buffer.pop(dest.data(), 128);
+    buffer.push(source.data(), 100);
+    buffer.pop(dest.data(), 100);
+
+    //! CHECK Only the pop from the empty buffer is counted
+
+    EXPECT_EQ(buffer.dropoutCount(), 2u);
+}
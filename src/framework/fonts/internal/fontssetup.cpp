@@ -35,30 +35,13 @@ void FontsSetup::setup()
     return;
 #endif
 
+    //! NOTE Only the fonts of the UI are loaded here, the text fonts of the scores
+    //! are loaded by libmscore the first time a score uses them (see MScore::loadFontFamily)
     static const QStringList fonts = {
-        ":/fonts/musejazz/MuseJazzText.otf",
-        ":/fonts/campania/Campania.otf",
-        ":/fonts/edwin/Edwin-Roman.otf",
-        ":/fonts/edwin/Edwin-Bold.otf",
-        ":/fonts/edwin/Edwin-Italic.otf",
-        ":/fonts/edwin/Edwin-BdIta.otf",
-        ":/fonts/FreeSans.ttf",
-        ":/fonts/FreeSerif.ttf",
-        ":/fonts/FreeSerifBold.ttf",
-        ":/fonts/FreeSerifItalic.ttf",
-        ":/fonts/FreeSerifBoldItalic.ttf",
         ":/fonts/firasans/FiraSansRegular.ttf",
         ":/fonts/firasans/FiraSansSemiBold.ttf",
-        ":/fonts/mscoreTab.ttf",
-        ":/fonts/mscore-BC.ttf",
-        ":/fonts/leland/LelandText.otf",
         ":/fonts/leland/Leland.otf",
         ":/fonts/mscore/MusescoreIcon.ttf",
-        ":/fonts/bravura/BravuraText.otf",
-        ":/fonts/gootville/GootvilleText.otf",
-        ":/fonts/mscore/MScoreText.ttf",
-        ":/fonts/petaluma/PetalumaText.otf",
-        ":/fonts/petaluma/PetalumaScript.otf",
     };
 
     for (const QString& font: fonts) {
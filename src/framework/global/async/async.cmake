@@ -8,4 +8,6 @@ set(ASYNC_SRC
     ${CMAKE_CURRENT_LIST_DIR}/channel.h
     ${CMAKE_CURRENT_LIST_DIR}/processevents.h
     ${CMAKE_CURRENT_LIST_DIR}/notifylist.h
+    ${CMAKE_CURRENT_LIST_DIR}/coalescedchannel.h
+    ${CMAKE_CURRENT_LIST_DIR}/coalescednotification.h
     )
@@ -0,0 +1,110 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_ASYNC_COALESCEDCHANNEL_H
+#define MU_ASYNC_COALESCEDCHANNEL_H
+
+#include <memory>
+
+#include <QTimer>
+
+#include "asyncable.h"
+#include "channel.h"
+
+namespace mu {
+namespace async {
+//! NOTE The values sent in a row are merged with T::unite(const T&) and received once,
+//! when the event loop of the sending thread gets back control, so a batch of changes
+//! is handled once. A copy shares the values and the receivers, as a Channel does.
+template<typename T>
+class CoalescedChannel
+{
+public:
+    CoalescedChannel()
+        : m_state(std::make_shared<State>()) {}
+
+    void send(const T& value)
+    {
+        if (m_state->pending) {
+            m_state->value.unite(value);
+            return;
+        }
+
+        m_state->value = value;
+        m_state->pending = true;
+
+        std::weak_ptr<State> state = m_state;
+        QTimer::singleShot(0, [state]() {
+            if (std::shared_ptr<State> s = state.lock()) {
+                flush(*s);
+            }
+        });
+    }
+
+    //! NOTE Sends the pending value now
+    void flush()
+    {
+        flush(*m_state);
+    }
+
+    bool isPending() const
+    {
+        return m_state->pending;
+    }
+
+    Channel<T> channel() const
+    {
+        return m_state->channel;
+    }
+
+    template<typename Func>
+    void onReceive(const Asyncable* receiver, Func f, Asyncable::AsyncMode mode = Asyncable::AsyncMode::AsyncSetOnce)
+    {
+        m_state->channel.onReceive(receiver, f, mode);
+    }
+
+    void resetOnReceive(const Asyncable* receiver)
+    {
+        m_state->channel.resetOnReceive(receiver);
+    }
+
+private:
+    struct State {
+        Channel<T> channel;
+        T value;
+        bool pending = false;
+    };
+
+    static void flush(State& s)
+    {
+        if (!s.pending) {
+            return;
+        }
+
+        T value = s.value;
+        s.value = T();
+        s.pending = false;
+        s.channel.send(value);
+    }
+
+    std::shared_ptr<State> m_state;
+};
+}
+}
+
+#endif // MU_ASYNC_COALESCEDCHANNEL_H
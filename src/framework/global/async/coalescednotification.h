@@ -0,0 +1,103 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_ASYNC_COALESCEDNOTIFICATION_H
+#define MU_ASYNC_COALESCEDNOTIFICATION_H
+
+#include <memory>
+
+#include <QTimer>
+
+#include "asyncable.h"
+#include "notification.h"
+
+namespace mu {
+namespace async {
+//! NOTE The notifications sent in a row are received once, when the event loop
+//! of the sending thread gets back control. A copy shares the receivers.
+class CoalescedNotification
+{
+public:
+    CoalescedNotification()
+        : m_state(std::make_shared<State>()) {}
+
+    void notify()
+    {
+        if (m_state->pending) {
+            return;
+        }
+
+        m_state->pending = true;
+
+        std::weak_ptr<State> state = m_state;
+        QTimer::singleShot(0, [state]() {
+            if (std::shared_ptr<State> s = state.lock()) {
+                flush(*s);
+            }
+        });
+    }
+
+    //! NOTE Sends the pending notification now
+    void flush()
+    {
+        flush(*m_state);
+    }
+
+    bool isPending() const
+    {
+        return m_state->pending;
+    }
+
+    Notification notification() const
+    {
+        return m_state->notification;
+    }
+
+    template<typename Func>
+    void onNotify(const Asyncable* receiver, Func f, Asyncable::AsyncMode mode = Asyncable::AsyncMode::AsyncSetOnce)
+    {
+        m_state->notification.onNotify(receiver, f, mode);
+    }
+
+    void resetOnNotify(const Asyncable* receiver)
+    {
+        m_state->notification.resetOnNotify(receiver);
+    }
+
+private:
+    struct State {
+        Notification notification;
+        bool pending = false;
+    };
+
+    static void flush(State& s)
+    {
+        if (!s.pending) {
+            return;
+        }
+
+        s.pending = false;
+        s.notification.notify();
+    }
+
+    std::shared_ptr<State> m_state;
+};
+}
+}
+
+#endif // MU_ASYNC_COALESCEDNOTIFICATION_H
@@ -0,0 +1,147 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "commandstats.h"
+
+#include <deque>
+#include <mutex>
+
+#include "perfcounters.h"
+
+using namespace mu;
+using namespace mu::commandstats;
+
+static const size_t MAX_HISTORY = 100;
+static const std::chrono::milliseconds FOLLOW_UP_TIME(2000); // the repaint and playback updates after the command
+
+namespace {
+struct State {
+    std::mutex mutex;
+    std::deque<Record> history;
+    int depth = 0;
+    bool hasCurrent = false;
+    std::chrono::steady_clock::time_point commandEnd;
+};
+
+State& state()
+{
+    static State s;
+    return s;
+}
+
+//! NOTE The record of the running command, or of the last one while its follow-up lasts
+Record* currentRecord(State& s)
+{
+    if (!s.hasCurrent || s.history.empty()) {
+        return nullptr;
+    }
+    if (s.depth == 0 && std::chrono::steady_clock::now() - s.commandEnd > FOLLOW_UP_TIME) {
+        s.hasCurrent = false;
+        return nullptr;
+    }
+    return &s.history.back();
+}
+}
+
+void commandstats::beginCommand(const std::string& command)
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.depth++ > 0) {
+        return;
+    }
+
+    Record record;
+    record.command = command;
+    record.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    s.history.push_back(std::move(record));
+    if (s.history.size() > MAX_HISTORY) {
+        s.history.pop_front();
+    }
+    s.hasCurrent = true;
+}
+
+void commandstats::endCommand()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (s.depth > 0 && --s.depth == 0) {
+        s.commandEnd = std::chrono::steady_clock::now();
+
+        double layoutMs = s.history.empty() ? 0.0 : s.history.back().ms(Phase::Layout);
+        if (layoutMs > 0.0) {
+            perfcounters::record(perfcounters::Histogram::LayoutPerEditMs, layoutMs);
+        }
+    }
+}
+
+void commandstats::addTime(Phase phase, double ms)
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (Record* record = currentRecord(s)) {
+        record->phaseMs[static_cast<int>(phase)] += ms;
+    }
+}
+
+void commandstats::addMeasures(int measures)
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (Record* record = currentRecord(s)) {
+        record->measures += measures;
+    }
+}
+
+std::vector<Record> commandstats::history()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return std::vector<Record>(s.history.begin(), s.history.end());
+}
+
+void commandstats::clear()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.history.clear();
+    s.hasCurrent = false;
+}
+
+static thread_local bool s_activePhases[static_cast<int>(Phase::Count)] = {};
+
+PhaseTimer::PhaseTimer(Phase phase)
+    : m_phase(phase)
+{
+    bool& active = s_activePhases[static_cast<int>(phase)];
+    if (!active) {
+        active = true;
+        m_isOuter = true;
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+PhaseTimer::~PhaseTimer()
+{
+    if (!m_isOuter) {
+        return;
+    }
+    s_activePhases[static_cast<int>(m_phase)] = false;
+    addTime(m_phase, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+}
@@ -0,0 +1,75 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_FRAMEWORK_COMMANDSTATS_H
+#define MU_FRAMEWORK_COMMANDSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! NOTE Where the time of the executed commands goes: the command itself, its undo commands,
+//! the layout and the repaint and playback updates which follow it.
+//! The phases after the command, until the next one, are added to it for a short while.
+
+namespace mu::commandstats {
+enum class Phase {
+    Command = 0,
+    Undo,
+    Layout,
+    Paint,
+    Playback,
+
+    Count
+};
+
+struct Record {
+    std::string command;
+    double phaseMs[static_cast<int>(Phase::Count)] = {};
+    int measures = 0;       // laid out
+    int64_t timestamp = 0;  // msecs since epoch
+
+    double ms(Phase phase) const { return phaseMs[static_cast<int>(phase)]; }
+};
+
+void beginCommand(const std::string& command);
+void endCommand();
+
+void addTime(Phase phase, double ms);
+void addMeasures(int measures);
+
+//! NOTE The last commands, the latest last
+std::vector<Record> history();
+void clear();
+
+//! NOTE The nested timers of the same phase on a thread count once
+class PhaseTimer
+{
+public:
+    explicit PhaseTimer(Phase phase);
+    ~PhaseTimer();
+
+private:
+    Phase m_phase;
+    bool m_isOuter = false;
+    std::chrono::steady_clock::time_point m_start;
+};
+}
+
+#endif // MU_FRAMEWORK_COMMANDSTATS_H
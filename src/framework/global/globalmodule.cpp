@@ -111,3 +111,8 @@ void GlobalModule::onInit(const IApplication::RunMode&)
         s_asyncInvoker.invoke(f);
     });
 }
+
+void GlobalModule::onDeinit()
+{
+    settings()->flush();
+}
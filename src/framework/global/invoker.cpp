@@ -39,18 +39,33 @@ void Invoker::invoke(const Call& func)
 
     if (std::this_thread::get_id() == m_mainThreadId) {
         func();
-    } else {
-        static const char* name = "doInvoke";
+        return;
+    }
 
-        Functor* f = new Functor(func);
-        void* ptr = reinterpret_cast<void*>(f);
-        QMetaObject::invokeMethod(this, name, Qt::QueuedConnection, Q_ARG(void*, ptr));
+    bool isFirst = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        isFirst = m_queue.empty();
+        m_queue.push_back(func);
+    }
+
+    //! NOTE The calls that come before the main thread gets to this one join it
+    if (isFirst) {
+        static const char* name = "doInvoke";
+        QMetaObject::invokeMethod(this, name, Qt::QueuedConnection);
     }
 }
 
-void Invoker::doInvoke(void* ptr)
+void Invoker::doInvoke()
 {
-    Functor* f = reinterpret_cast<Functor*>(ptr);
-    f->call();
-    delete f;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.swap(m_queue);
+    }
+
+    //! NOTE Both lists keep their capacity, there is no allocation for a list once it has grown
+    for (const Call& call : m_running) {
+        call();
+    }
+    m_running.clear();
 }
@@ -21,6 +21,8 @@
 
 #include <QObject>
 #include <thread>
+#include <mutex>
+#include <vector>
 #include <functional>
 
 namespace mu {
@@ -38,15 +40,15 @@ public:
     void invoke(const Call& func = nullptr);
 
 public slots:
-    void doInvoke(void* ptr);
+    void doInvoke();
 
 private:
 
-    struct Functor {
-        Call call;
-        Functor(const Call& c)
-            : call(c) {}
-    };
+    //! NOTE The calls from other threads wait here for the main thread,
+    //! which runs all of them in one queued invoke
+    std::mutex m_mutex;
+    std::vector<Call> m_queue;
+    std::vector<Call> m_running;
 
     static std::thread::id m_mainThreadId;
 };
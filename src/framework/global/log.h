@@ -20,6 +20,19 @@
 #ifndef MU_FRAMEWORK_LOG_H
 #define MU_FRAMEWORK_LOG_H
 
+#include "tracer.h"
+
+//! NOTE The function scopes are also recorded by the tracer, if it is started
+#define TRACEFUNC \
+    static std::string __func_info(haw::profiler::FuncMarker::formatSig(FUNC_INFO)); \
+    haw::profiler::FuncMarker __funcMarker(__func_info); \
+    mu::tracer::Scope __traceFuncScope(__func_info);
+
+#define TRACEFUNC_C(info) \
+    static std::string __func_info(info); \
+    haw::profiler::FuncMarker __funcMarkerInfo(__func_info); \
+    mu::tracer::Scope __traceFuncScope(__func_info);
+
 #include "thirdparty/haw_profiler/src/profiler.h"
 
 #ifndef HAW_LOGGER_QT_SUPPORT
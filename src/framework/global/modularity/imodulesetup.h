@@ -38,6 +38,10 @@ public:
     virtual void registerResources() {}
     virtual void registerUiTypes() {}
 
+    //! NOTE Return true if the module is not needed to start the application, then onInit
+    //! is called when one of its exports is first resolved, or else after the application has started
+    virtual bool isInitDeferred() const { return false; }
+
     virtual void onInit(const framework::IApplication::RunMode& mode) { (void)mode; }
     virtual void onDeinit() {}
 
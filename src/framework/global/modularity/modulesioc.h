@@ -20,8 +20,12 @@
 #ifndef MU_FRAMEWORK_MODULESIOC_H
 #define MU_FRAMEWORK_MODULESIOC_H
 
+#include <atomic>
 #include <memory>
 #include <map>
+#include <vector>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <cassert>
 #include <iostream>
@@ -84,7 +88,7 @@ public:
     template<class I>
     std::shared_ptr<I> resolve(const std::string& module)
     {
-        std::shared_ptr<IModuleExportInterface> p = doResolvePtrById(module, I::interfaceId());
+        std::shared_ptr<IModuleExportInterface> p = cachedResolve<I>(module);
 #ifdef DEBUG
         return std::dynamic_pointer_cast<I>(p);
 #else
@@ -95,7 +99,7 @@ public:
     template<class I>
     std::shared_ptr<I> resolveRequiredImport(const std::string& module)
     {
-        std::shared_ptr<IModuleExportInterface> p = doResolvePtrById(module, I::interfaceId());
+        std::shared_ptr<IModuleExportInterface> p = cachedResolve<I>(module);
         if (!p) {
             //LOGE() << "not found implementation for interface: " << I::interfaceId();
             assert(false);
@@ -107,18 +111,94 @@ public:
 #endif
     }
 
+    //! NOTE The init of a module which is not needed to start the application,
+    //! it is run before the first export of the module is resolved, or by initModule
+    void setModuleInit(const std::string& module, const std::function<void()>& init)
+    {
+        m_moduleInits[module] = init;
+    }
+
+    void initModule(const std::string& module)
+    {
+        auto it = m_moduleInits.find(module);
+        if (it == m_moduleInits.end()) {
+            return;
+        }
+
+        //! NOTE Removed before it runs, the init resolves the exports of its module too
+        std::function<void()> init = std::move(it->second);
+        m_moduleInits.erase(it);
+        init();
+    }
+
+    bool isModuleInitPending(const std::string& module) const
+    {
+        return m_moduleInits.find(module) != m_moduleInits.end();
+    }
+
     void reset()
     {
         m_map.clear();
+        m_moduleInits.clear();
+        ++m_generation;
+    }
+
+    //! NOTE How many times each interface was resolved, for profiling
+    std::map<std::string, uint64_t> resolveCounts() const
+    {
+        std::map<std::string, uint64_t> counts;
+        for (const auto& slot : m_slots) {
+            counts[slot.first] += slot.second->resolveCount.load(std::memory_order_relaxed);
+        }
+        return counts;
     }
 
 private:
 
+    //! NOTE The service of an interface, kept for the resolves after the first one, so that they
+    //! need no lookup by id. It is valid while nothing was registered or unregistered since it was filled.
+    //! Services made by a creator are not kept, each resolve creates one
+    struct ResolveSlot {
+        std::shared_ptr<IModuleExportInterface> p;
+        uint64_t generation = 0;
+        bool registered = false;
+        std::atomic<uint64_t> resolveCount { 0 };
+    };
+
+    template<class I>
+    static ResolveSlot& resolveSlot()
+    {
+        static ResolveSlot slot;
+        return slot;
+    }
+
+    template<class I>
+    std::shared_ptr<IModuleExportInterface> cachedResolve(const std::string& module)
+    {
+        ResolveSlot& slot = resolveSlot<I>();
+        slot.resolveCount.fetch_add(1, std::memory_order_relaxed);
+        if (slot.p && slot.generation == m_generation) {
+            return slot.p;
+        }
+
+        if (!slot.registered) {
+            m_slots.push_back({ I::interfaceId(), &slot });
+            slot.registered = true;
+        }
+
+        bool isShared = false;
+        std::shared_ptr<IModuleExportInterface> p = doResolvePtrById(module, I::interfaceId(), &isShared);
+        slot.p = isShared ? p : nullptr;
+        slot.generation = m_generation;
+        return p;
+    }
+
     ModulesIoC() = default;
 
     void unregisterService(const std::string& id)
     {
         m_map.erase(id);
+        ++m_generation;
     }
 
     void registerService(const std::string& module,
@@ -138,13 +218,27 @@ private:
         inj.c = c;
         inj.p = p;
         m_map[id] = inj;
+        ++m_generation;
     }
 
-    std::shared_ptr<IModuleExportInterface> doResolvePtrById(const std::string& resolveModule, const std::string& id)
+    std::shared_ptr<IModuleExportInterface> doResolvePtrById(const std::string& resolveModule, const std::string& id,
+                                                             bool* isShared = nullptr)
     {
-        (void)(resolveModule); //! TODO add statistics collection / monitoring, who resolves what
-        Service& inj = m_map[id];
+        (void)(resolveModule); //! NOTE The resolves are counted by interface, see resolveCounts
+        auto it = m_map.find(id);
+        if (it == m_map.end()) {
+            return nullptr;
+        }
+
+        Service& inj = it->second;
+        if (!m_moduleInits.empty()) {
+            initModule(inj.sourceModule);
+        }
+
         if (inj.p) {
+            if (isShared) {
+                *isShared = true;
+            }
             return inj.p;
         }
 
@@ -162,6 +256,9 @@ private:
     };
 
     std::map<std::string, Service > m_map;
+    std::map<std::string, std::function<void()> > m_moduleInits;
+    std::vector<std::pair<std::string, ResolveSlot*> > m_slots;
+    uint64_t m_generation = 1;
 };
 
 template<class T>
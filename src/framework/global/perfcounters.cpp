@@ -0,0 +1,102 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "perfcounters.h"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace mu;
+using namespace mu::perfcounters;
+
+static std::atomic<uint32_t> s_histograms[static_cast<size_t>(Histogram::Count)][BUCKET_COUNT] = {};
+static std::atomic<uint64_t> s_counters[static_cast<size_t>(Counter::Count)] = {};
+
+bool Snapshot::isEmpty() const
+{
+    for (const Buckets& buckets : histograms) {
+        for (uint32_t count : buckets) {
+            if (count) {
+                return false;
+            }
+        }
+    }
+    return std::all_of(counters.begin(), counters.end(), [](uint64_t count) { return count == 0; });
+}
+
+void perfcounters::record(Histogram histogram, double ms)
+{
+    auto it = std::lower_bound(BUCKET_BOUNDS_MS.begin(), BUCKET_BOUNDS_MS.end(), ms, [](int bound, double value) {
+        return bound < value;
+    });
+    size_t bucket = static_cast<size_t>(it - BUCKET_BOUNDS_MS.begin());
+    s_histograms[static_cast<size_t>(histogram)][bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void perfcounters::increment(Counter counter, uint64_t count)
+{
+    s_counters[static_cast<size_t>(counter)].fetch_add(count, std::memory_order_relaxed);
+}
+
+void perfcounters::recordScoreOpen(int measures, double ms)
+{
+    if (measures <= 100) {
+        record(Histogram::OpenSmallScoreMs, ms);
+    } else if (measures <= 1000) {
+        record(Histogram::OpenMediumScoreMs, ms);
+    } else {
+        record(Histogram::OpenLargeScoreMs, ms);
+    }
+}
+
+Snapshot perfcounters::take()
+{
+    Snapshot snapshot;
+    for (size_t h = 0; h < snapshot.histograms.size(); ++h) {
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+            snapshot.histograms[h][b] = s_histograms[h][b].exchange(0, std::memory_order_relaxed);
+        }
+    }
+    for (size_t c = 0; c < snapshot.counters.size(); ++c) {
+        snapshot.counters[c] = s_counters[c].exchange(0, std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+const char* perfcounters::name(Histogram histogram)
+{
+    switch (histogram) {
+    case Histogram::LayoutPerEditMs: return "layout_per_edit_ms";
+    case Histogram::OpenSmallScoreMs: return "open_small_score_ms";
+    case Histogram::OpenMediumScoreMs: return "open_medium_score_ms";
+    case Histogram::OpenLargeScoreMs: return "open_large_score_ms";
+    case Histogram::StartupInitMs: return "startup_init_ms";
+    case Histogram::StartupTotalMs: return "startup_total_ms";
+    case Histogram::Count: break;
+    }
+    return "";
+}
+
+const char* perfcounters::name(Counter counter)
+{
+    switch (counter) {
+    case Counter::AudioDropouts: return "audio_dropouts";
+    case Counter::Count: break;
+    }
+    return "";
+}
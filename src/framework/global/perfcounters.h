@@ -0,0 +1,72 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_FRAMEWORK_PERFCOUNTERS_H
+#define MU_FRAMEWORK_PERFCOUNTERS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+//! NOTE Aggregated performance counters of the session: fixed-bucket histograms of durations and plain counters.
+//! Recording is lock-free and may be done on any thread, the telemetry takes the counts in batches.
+
+namespace mu::perfcounters {
+enum class Histogram {
+    LayoutPerEditMs = 0,
+    OpenSmallScoreMs,   // up to 100 measures
+    OpenMediumScoreMs,  // up to 1000 measures
+    OpenLargeScoreMs,
+    StartupInitMs,      // until the modules are inited
+    StartupTotalMs,     // until the application is started
+
+    Count
+};
+
+enum class Counter {
+    AudioDropouts = 0,
+
+    Count
+};
+
+//! NOTE The upper bounds of the buckets, the last bucket takes the longer durations
+constexpr std::array<int, 13> BUCKET_BOUNDS_MS = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000 };
+constexpr size_t BUCKET_COUNT = BUCKET_BOUNDS_MS.size() + 1;
+
+using Buckets = std::array<uint32_t, BUCKET_COUNT>;
+
+struct Snapshot {
+    std::array<Buckets, static_cast<size_t>(Histogram::Count)> histograms = {};
+    std::array<uint64_t, static_cast<size_t>(Counter::Count)> counters = {};
+
+    bool isEmpty() const;
+};
+
+void record(Histogram histogram, double ms);
+void increment(Counter counter, uint64_t count = 1);
+
+void recordScoreOpen(int measures, double ms);
+
+//! NOTE Returns the counts since the last take and resets them
+Snapshot take();
+
+const char* name(Histogram histogram);
+const char* name(Counter counter);
+}
+
+#endif // MU_FRAMEWORK_PERFCOUNTERS_H
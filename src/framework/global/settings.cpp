@@ -24,11 +24,17 @@
 #include <QSettings>
 #include <QStandardPaths>
 #include <QDir>
+#include <QCoreApplication>
+#include <QTimer>
 
 using namespace mu;
 using namespace mu::framework;
 using namespace mu::async;
 
+//! NOTE Dragging a slider or zooming changes a value many times a second,
+//! QSettings would write the file after each event loop pass with a change
+static constexpr int WRITE_DELAY_MS = 1000;
+
 Settings* Settings::instance()
 {
     static Settings s;
@@ -51,6 +57,7 @@ Settings::Settings()
 
 Settings::~Settings()
 {
+    flush();
     delete m_settings;
 }
 
@@ -78,6 +85,7 @@ void Settings::load()
 
 void Settings::reset(bool keepDefaultSettings)
 {
+    m_pendingWrites.clear();
     m_settings->clear();
 
     if (!keepDefaultSettings) {
@@ -125,7 +133,7 @@ void Settings::setValue(const Key& key, const Val& value)
         return;
     }
 
-    writeValue(key, value);
+    scheduleWrite(key, value);
 
     if (item.isNull()) {
         m_items[key] = Item{ key, value, value };
@@ -140,6 +148,40 @@ void Settings::setValue(const Key& key, const Val& value)
     }
 }
 
+void Settings::scheduleWrite(const Key& key, const Val& value)
+{
+    //! NOTE Without an event loop, as in the tools and tests, the value is written at once
+    if (!QCoreApplication::instance()) {
+        writeValue(key, value);
+        return;
+    }
+
+    m_pendingWrites[key] = value;
+    if (m_writeScheduled) {
+        return;
+    }
+
+    m_writeScheduled = true;
+    QTimer::singleShot(WRITE_DELAY_MS, QCoreApplication::instance(), [this]() {
+        flush();
+    });
+}
+
+void Settings::flush()
+{
+    m_writeScheduled = false;
+    if (m_pendingWrites.empty()) {
+        return;
+    }
+
+    for (auto it = m_pendingWrites.cbegin(); it != m_pendingWrites.cend(); ++it) {
+        writeValue(it->first, it->second);
+    }
+    m_pendingWrites.clear();
+
+    m_settings->sync();
+}
+
 void Settings::writeValue(const Key& key, const Val& value)
 {
     // TODO: implement writing/reading first part of key (module name)
@@ -77,6 +77,10 @@ public:
 
     async::Channel<Val> valueChanged(const Key& key) const;
 
+    //! NOTE The changed values are written together, a while after the first change,
+    //! flush writes the waiting ones now
+    void flush();
+
 private:
     Settings();
     ~Settings();
@@ -86,12 +90,16 @@ private:
 
     Items readItems() const;
     void writeValue(const Key& key, const Val& value);
+    void scheduleWrite(const Key& key, const Val& value);
 
     QString dataPath() const;
 
     QSettings* m_settings = nullptr;
     mutable Items m_items;
     mutable std::map<Key, async::Channel<Val> > m_channels;
+
+    std::map<Key, Val> m_pendingWrites;
+    bool m_writeScheduled = false;
 };
 
 inline Settings* settings()
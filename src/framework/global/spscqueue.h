@@ -0,0 +1,89 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_GLOBAL_SPSCQUEUE_H
+#define MU_GLOBAL_SPSCQUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace mu {
+//! NOTE Bounded single producer / single consumer queue, for passing values to and from the audio thread.
+//! All slots are allocated in the constructor, push and pop never allocate or block, push fails if the queue is full.
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity + 1) {
+            size <<= 1;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    //! NOTE Called by the producer only
+    bool tryPush(const T& value)
+    {
+        size_t write = m_writePos.load(std::memory_order_relaxed);
+        size_t next = (write + 1) & m_mask;
+        if (next == m_readPos.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        m_slots[write] = value;
+        m_writePos.store(next, std::memory_order_release);
+        return true;
+    }
+
+    //! NOTE Called by the consumer only
+    bool tryPop(T& value)
+    {
+        size_t read = m_readPos.load(std::memory_order_relaxed);
+        if (read == m_writePos.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = m_slots[read];
+        m_readPos.store((read + 1) & m_mask, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const
+    {
+        return m_mask;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_writePos = { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_readPos = { 0 };
+};
+}
+
+#endif // MU_GLOBAL_SPSCQUEUE_H
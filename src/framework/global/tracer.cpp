@@ -0,0 +1,166 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "tracer.h"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "log.h"
+#include "runtime.h"
+
+using namespace mu;
+
+namespace {
+constexpr size_t THREAD_CAPACITY = 1 << 18; // 6 MB, about 20 minutes of the audio callbacks
+
+struct Event {
+    const std::string* name = nullptr;
+    uint64_t beginUs = 0;
+    uint64_t durationUs = 0;
+};
+
+struct ThreadBuffer {
+    int tid = 0;
+    std::string threadName;
+    std::vector<Event> events;
+    std::atomic<size_t> count { 0 };
+    std::atomic<size_t> dropped { 0 };
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer> > buffers;
+    std::string filePath;
+};
+
+//! NOTE Never destroyed, the threads may still trace during the static destruction
+Registry& registry()
+{
+    static Registry* r = new Registry();
+    return *r;
+}
+
+ThreadBuffer* threadBuffer()
+{
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto newBuffer = std::make_unique<ThreadBuffer>();
+        newBuffer->tid = static_cast<int>(r.buffers.size()) + 1;
+        newBuffer->threadName = runtime::threadName();
+        newBuffer->events.resize(THREAD_CAPACITY);
+        buffer = newBuffer.get();
+        r.buffers.push_back(std::move(newBuffer));
+    }
+    return buffer;
+}
+
+std::string escaped(const std::string& str)
+{
+    std::string result;
+    result.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+}
+
+uint64_t tracer::nowUs()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void tracer::addEvent(const std::string& name, uint64_t beginUs, uint64_t endUs)
+{
+    ThreadBuffer* buffer = threadBuffer();
+    size_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= buffer->events.size()) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[index] = { &name, beginUs, endUs - beginUs };
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void tracer::start(const std::string& filePath)
+{
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.filePath = filePath;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    detail::s_enabled.store(true, std::memory_order_relaxed);
+    LOGI() << "tracing to: " << filePath;
+}
+
+bool tracer::stop()
+{
+    if (!isEnabled()) {
+        return false;
+    }
+    detail::s_enabled.store(false, std::memory_order_relaxed);
+
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::ofstream file(r.filePath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        LOGE() << "failed open trace file: " << r.filePath;
+        return false;
+    }
+
+    size_t dropped = 0;
+    bool first = true;
+    file << "{\"traceEvents\": [\n";
+    for (const std::unique_ptr<ThreadBuffer>& buffer : r.buffers) {
+        file << (first ? "" : ",\n")
+             << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+             << ", \"args\": {\"name\": \"" << escaped(buffer->threadName) << "\"}}";
+        first = false;
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const Event& e = buffer->events[i];
+            file << ",\n{\"name\": \"" << escaped(*e.name) << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid
+                 << ", \"ts\": " << e.beginUs << ", \"dur\": " << e.durationUs << "}";
+        }
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    file << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"droppedEvents\": " << dropped << "}}\n";
+
+    if (dropped > 0) {
+        LOGW() << "trace dropped events: " << dropped;
+    }
+
+    return file.good();
+}
@@ -0,0 +1,80 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_FRAMEWORK_TRACER_H
+#define MU_FRAMEWORK_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//! NOTE Records the scopes of all threads while the tracing is started,
+//! and saves them as a Chrome trace (JSON), which the Chrome tracing and the Perfetto UI open.
+//! TRACEFUNC and TRACEFUNC_C record their scopes too, TRACE_SCOPE records a scope only for the trace,
+//! so it does not lock and may be used on the audio threads.
+
+#ifndef TRACE_SCOPE
+#define TRACE_SCOPE(name) \
+    static const std::string __trace_name(name); \
+    mu::tracer::Scope __traceScope(__trace_name);
+#endif
+
+namespace mu::tracer {
+namespace detail {
+inline std::atomic<bool> s_enabled { false };
+}
+
+inline bool isEnabled()
+{
+    return detail::s_enabled.load(std::memory_order_relaxed);
+}
+
+//! NOTE The trace is written to filePath by stop
+void start(const std::string& filePath);
+bool stop();
+
+uint64_t nowUs();
+
+//! NOTE Lock-free, each thread writes only to its own buffer. The events beyond its capacity are dropped
+void addEvent(const std::string& name, uint64_t beginUs, uint64_t endUs);
+
+struct Scope
+{
+    explicit Scope(const std::string& n)
+        : name(n)
+    {
+        if (isEnabled()) {
+            beginUs = nowUs();
+            enabled = true;
+        }
+    }
+
+    ~Scope()
+    {
+        if (enabled) {
+            addEvent(name, beginUs, nowUs());
+        }
+    }
+
+    const std::string& name;
+    uint64_t beginUs = 0;
+    bool enabled = false;
+};
+}
+
+#endif // MU_FRAMEWORK_TRACER_H
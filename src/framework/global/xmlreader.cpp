@@ -131,12 +131,12 @@ std::string XmlReader::attribute(std::string_view name) const
 
 QStringRef XmlReader::attributeValue(std::string_view name) const
 {
-    return m_reader->attributes().value(name.data());
+    return m_reader->attributes().value(QLatin1String(name.data(), int(name.size())));
 }
 
 bool XmlReader::hasAttribute(std::string_view name) const
 {
-    return m_reader->attributes().hasAttribute(name.data());
+    return m_reader->attributes().hasAttribute(QLatin1String(name.data(), int(name.size())));
 }
 
 int XmlReader::readInt()
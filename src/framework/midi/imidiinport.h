@@ -45,6 +45,12 @@ public:
     virtual void stop() = 0;
     virtual bool isRunning() const = 0;
     virtual async::Channel<std::pair<tick_t, Event> > eventReceived() const = 0;
+
+    //! NOTE While monitoring, the received events are also queued for the audio thread,
+    //! which takes them directly, so they sound without a trip through the main thread
+    virtual void setIsMonitoring(bool arg) = 0;
+    virtual bool isMonitoring() const = 0;
+    virtual bool takeMonitoredEvent(Event& e) = 0;
 };
 }
 
@@ -42,6 +42,11 @@ public:
     virtual MidiDeviceID deviceID() const = 0;
 
     virtual Ret sendEvent(const Event& e) = 0;
+
+    //! NOTE Queues the event to be played delayUsec from now; the queued events are written to the device
+    //! in one batch by flush, each with its time, so they play on time whenever the sending thread wakes up
+    virtual Ret scheduleEvent(const Event& e, uint32_t delayUsec) = 0;
+    virtual Ret flush() = 0;
 };
 }
 
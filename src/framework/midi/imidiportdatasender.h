@@ -19,6 +19,8 @@
 #ifndef MU_MIDI_IMIDIPORTDATASENDER_H
 #define MU_MIDI_IMIDIPORTDATASENDER_H
 
+#include <functional>
+
 #include "modularity/imoduleexport.h"
 #include "miditypes.h"
 
@@ -32,7 +34,9 @@ public:
 
     virtual void setMidiStream(std::shared_ptr<MidiStream> stream) = 0;
 
-    virtual bool sendEvents(tick_t from, tick_t toTick) = 0;
+    //! NOTE The events are scheduled on the port at delayUsec(tick) from now and written in one batch
+    using TickDelay = std::function<uint32_t(tick_t tick)>;
+    virtual bool sendEvents(tick_t from, tick_t toTick, const TickDelay& delayUsec) = 0;
     virtual bool sendSingleEvent(const midi::Event& event) = 0;
 };
 }
@@ -70,3 +70,18 @@ async::Channel<std::pair<tick_t, Event> > DummyMidiInPort::eventReceived() const
 {
     return m_eventReceived;
 }
+
+void DummyMidiInPort::setIsMonitoring(bool arg)
+{
+    m_monitorQueue.setIsEnabled(arg);
+}
+
+bool DummyMidiInPort::isMonitoring() const
+{
+    return m_monitorQueue.isEnabled();
+}
+
+bool DummyMidiInPort::takeMonitoredEvent(Event& e)
+{
+    return m_monitorQueue.pop(e);
+}
@@ -20,6 +20,7 @@
 #define MU_MIDI_DUMMYMIDIINPORT_H
 
 #include "imidiinport.h"
+#include "internal/midimonitorqueue.h"
 
 namespace mu::midi {
 class DummyMidiInPort : public IMidiInPort
@@ -37,11 +38,16 @@ public:
     bool isRunning() const override;
     async::Channel<std::pair<tick_t, Event> > eventReceived() const override;
 
+    void setIsMonitoring(bool arg) override;
+    bool isMonitoring() const override;
+    bool takeMonitoredEvent(Event& e) override;
+
 private:
 
     MidiDeviceID m_deviceID;
     bool m_running = false;
     async::Channel<std::pair<tick_t, Event> > m_eventReceived;
+    MidiMonitorQueue m_monitorQueue;
 };
 }
 
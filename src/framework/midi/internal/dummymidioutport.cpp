@@ -62,3 +62,17 @@ mu::Ret DummyMidiOutPort::sendEvent(const Event& e)
     LOGI() << e.to_string();
     return Ret(true);
 }
+
+mu::Ret DummyMidiOutPort::scheduleEvent(const Event& e, uint32_t delayUsec)
+{
+    if (!isConnected()) {
+        return make_ret(Err::MidiNotConnected);
+    }
+    LOGI() << "delay: " << delayUsec << " usec, " << e.to_string();
+    return Ret(true);
+}
+
+mu::Ret DummyMidiOutPort::flush()
+{
+    return Ret(true);
+}
@@ -0,0 +1,69 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_MIDI_MIDIMONITORQUEUE_H
+#define MU_MIDI_MIDIMONITORQUEUE_H
+
+#include <atomic>
+
+#include "spscqueue.h"
+#include "miditypes.h"
+
+namespace mu::midi {
+//! NOTE The received events on their way from the thread of the input port to the audio thread,
+//! which plays them on the synthesizer without waiting for the main thread
+class MidiMonitorQueue
+{
+public:
+    void setIsEnabled(bool arg)
+    {
+        m_enabled = arg;
+    }
+
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    //! NOTE Called by the thread of the input port only
+    void push(const Event& e)
+    {
+        if (!m_enabled) {
+            return;
+        }
+
+        //! NOTE If the audio thread does not read, the events are dropped
+        m_events.tryPush(e);
+    }
+
+    //! NOTE Called by the audio thread only
+    bool pop(Event& e)
+    {
+        return m_events.tryPop(e);
+    }
+
+private:
+    static constexpr size_t CAPACITY = 1024;
+
+    std::atomic<bool> m_enabled = { false };
+    SpscQueue<Event> m_events { CAPACITY };
+};
+}
+
+#endif // MU_MIDI_MIDIMONITORQUEUE_H
@@ -37,7 +37,7 @@ void MidiPortDataSender::onChunkReceived(const Chunk& chunk)
     m_midiData.chunks.insert({ chunk.beginTick, chunk });
 }
 
-bool MidiPortDataSender::sendEvents(tick_t fromTick, tick_t toTick)
+bool MidiPortDataSender::sendEvents(tick_t fromTick, tick_t toTick, const TickDelay& delayUsec)
 {
     //! NOTE Here we need to set up a callback to receive data in the same thread as reading,
     //! and accordingly, then the mutex is not needed
@@ -79,12 +79,13 @@ bool MidiPortDataSender::sendEvents(tick_t fromTick, tick_t toTick)
 
         const Event& event = pos->second;
         if (event) {
-            midiOutPort()->sendEvent(event);
+            midiOutPort()->scheduleEvent(event, delayUsec(pos->first));
         }
 
         ++pos;
     }
 
+    midiOutPort()->flush();
     return true;
 }
 
@@ -34,7 +34,7 @@ public:
 
     void setMidiStream(std::shared_ptr<MidiStream> stream) override;
 
-    bool sendEvents(tick_t from, tick_t toTick) override;
+    bool sendEvents(tick_t from, tick_t toTick, const TickDelay& delayUsec) override;
     bool sendSingleEvent(const midi::Event& event) override;
 
 private:
@@ -245,6 +245,7 @@ void AlsaMidiInPort::doProcess()
 
         e = e.toMIDI20();
         if (e) {
+            m_monitorQueue.push(e);
             m_eventReceived.send({ static_cast<tick_t>(ev->time.tick), e });
         }
 
@@ -276,3 +277,18 @@ mu::async::Channel<std::pair<tick_t, Event> > AlsaMidiInPort::eventReceived() co
 {
     return m_eventReceived;
 }
+
+void AlsaMidiInPort::setIsMonitoring(bool arg)
+{
+    m_monitorQueue.setIsEnabled(arg);
+}
+
+bool AlsaMidiInPort::isMonitoring() const
+{
+    return m_monitorQueue.isEnabled();
+}
+
+bool AlsaMidiInPort::takeMonitoredEvent(Event& e)
+{
+    return m_monitorQueue.pop(e);
+}
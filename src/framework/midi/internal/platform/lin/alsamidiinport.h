@@ -23,6 +23,7 @@
 #include <thread>
 
 #include "imidiinport.h"
+#include "internal/midimonitorqueue.h"
 
 namespace mu::midi {
 class AlsaMidiInPort : public IMidiInPort
@@ -43,6 +44,10 @@ public:
     bool isRunning() const override;
     async::Channel<std::pair<tick_t, Event> > eventReceived() const override;
 
+    void setIsMonitoring(bool arg) override;
+    bool isMonitoring() const override;
+    bool takeMonitoredEvent(Event& e) override;
+
 private:
 
     static void process(AlsaMidiInPort* self);
@@ -54,6 +59,7 @@ private:
     std::shared_ptr<std::thread> m_thread;
     std::atomic<bool> m_running{ false };
     async::Channel<std::pair<tick_t, Event> > m_eventReceived;
+    MidiMonitorQueue m_monitorQueue;
 };
 }
 
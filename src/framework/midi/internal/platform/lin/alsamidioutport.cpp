@@ -30,6 +30,7 @@ struct mu::midi::AlsaMidiOutPort::Alsa {
     snd_seq_t* midiOut = nullptr;
     int client = -1;
     int port = -1;
+    int queue = -1;
 };
 
 using namespace mu::midi;
@@ -121,6 +122,15 @@ mu::Ret AlsaMidiOutPort::connect(const MidiDeviceID& deviceID)
         return make_ret(Err::MidiFailedConnect,  "failed connect, err: " + std::string(snd_strerror(err)));
     }
 
+    //! NOTE The scheduled events are timed by a queue of the sequencer, which runs in the kernel
+    m_alsa->queue = snd_seq_alloc_queue(m_alsa->midiOut);
+    if (m_alsa->queue < 0) {
+        LOGW() << "failed alloc queue, the events are sent when they are scheduled";
+    } else {
+        snd_seq_start_queue(m_alsa->midiOut, m_alsa->queue, nullptr);
+        snd_seq_drain_output(m_alsa->midiOut);
+    }
+
     m_deviceID = deviceID;
 
     return Ret(true);
@@ -132,9 +142,13 @@ void AlsaMidiOutPort::disconnect()
         return;
     }
 
+    if (m_alsa->queue >= 0) {
+        snd_seq_free_queue(m_alsa->midiOut, m_alsa->queue);
+    }
     snd_seq_disconnect_from(m_alsa->midiOut, 0, m_alsa->client, m_alsa->port);
     snd_seq_close(m_alsa->midiOut);
 
+    m_alsa->queue = -1;
     m_alsa->client = -1;
     m_alsa->port = -1;
     m_alsa->midiOut = nullptr;
@@ -155,6 +169,32 @@ mu::Ret AlsaMidiOutPort::sendEvent(const Event& e)
 {
     // LOGI() << e.to_string();
 
+    return outputEvent(e, nullptr);
+}
+
+mu::Ret AlsaMidiOutPort::scheduleEvent(const Event& e, uint32_t delayUsec)
+{
+    return outputEvent(e, &delayUsec);
+}
+
+mu::Ret AlsaMidiOutPort::flush()
+{
+    if (!isConnected()) {
+        return make_ret(Err::MidiNotConnected);
+    }
+
+    int err = snd_seq_drain_output(m_alsa->midiOut);
+    if (err < 0) {
+        return make_ret(Err::MidiSendError, "failed drain output, err: " + std::string(snd_strerror(err)));
+    }
+
+    return Ret(true);
+}
+
+//! NOTE Without a delay the event is sent at once, bypassing the output buffer; with it, the event is
+//! put into the output buffer, scheduled on the queue relative to the time the buffer is drained
+mu::Ret AlsaMidiOutPort::outputEvent(const Event& e, const uint32_t* delayUsec)
+{
     if (!isConnected()) {
         return make_ret(Err::MidiNotConnected);
     }
@@ -162,7 +202,7 @@ mu::Ret AlsaMidiOutPort::sendEvent(const Event& e)
     if (e.isChannelVoice20()) {
         auto events = e.toMIDI10();
         for (auto& event : events) {
-            mu::Ret ret = sendEvent(event);
+            mu::Ret ret = outputEvent(event, delayUsec);
             if (!ret) {
                 return ret;
             }
@@ -172,7 +212,15 @@ mu::Ret AlsaMidiOutPort::sendEvent(const Event& e)
 
     snd_seq_event_t seqev;
     memset(&seqev, 0, sizeof(seqev));
-    snd_seq_ev_set_direct(&seqev);
+    bool isScheduled = delayUsec && m_alsa->queue >= 0;
+    if (isScheduled) {
+        snd_seq_real_time_t time;
+        time.tv_sec = *delayUsec / 1000000;
+        time.tv_nsec = (*delayUsec % 1000000) * 1000;
+        snd_seq_ev_schedule_real(&seqev, m_alsa->queue, 1, &time);
+    } else {
+        snd_seq_ev_set_direct(&seqev);
+    }
     snd_seq_ev_set_source(&seqev, 0);
     snd_seq_ev_set_dest(&seqev, SND_SEQ_ADDRESS_SUBSCRIBERS, 0);
 
@@ -197,7 +245,10 @@ mu::Ret AlsaMidiOutPort::sendEvent(const Event& e)
         return make_ret(Err::MidiNotSupported);
     }
 
-    snd_seq_event_output_direct(m_alsa->midiOut, &seqev);
+    int err = isScheduled ? snd_seq_event_output(m_alsa->midiOut, &seqev) : snd_seq_event_output_direct(m_alsa->midiOut, &seqev);
+    if (err < 0) {
+        return make_ret(Err::MidiSendError, "failed output event, err: " + std::string(snd_strerror(err)));
+    }
 
     return Ret(true);
 }
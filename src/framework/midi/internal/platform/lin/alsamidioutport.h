@@ -38,9 +38,13 @@ public:
     MidiDeviceID deviceID() const override;
 
     Ret sendEvent(const Event& e) override;
+    Ret scheduleEvent(const Event& e, uint32_t delayUsec) override;
+    Ret flush() override;
 
 private:
 
+    Ret outputEvent(const Event& e, const uint32_t* delayUsec);
+
     struct Alsa;
     std::unique_ptr<Alsa> m_alsa;
     MidiDeviceID m_deviceID;
@@ -133,6 +133,7 @@ void CoreMidiInPort::doProcess(uint32_t message, tick_t timing)
 {
     auto e = Event::fromMIDI10Package(message).toMIDI20();
     if (e) {
+        m_monitorQueue.push(e);
         m_eventReceived.send({ timing, e });
     }
 }
@@ -224,3 +225,18 @@ async::Channel<std::pair<tick_t, Event> > CoreMidiInPort::eventReceived() const
 {
     return m_eventReceived;
 }
+
+void CoreMidiInPort::setIsMonitoring(bool arg)
+{
+    m_monitorQueue.setIsEnabled(arg);
+}
+
+bool CoreMidiInPort::isMonitoring() const
+{
+    return m_monitorQueue.isEnabled();
+}
+
+bool CoreMidiInPort::takeMonitoredEvent(Event& e)
+{
+    return m_monitorQueue.pop(e);
+}
@@ -21,6 +21,7 @@
 
 #include <memory>
 #include "imidiinport.h"
+#include "internal/midimonitorqueue.h"
 
 namespace mu {
 namespace midi {
@@ -42,6 +43,10 @@ public:
     bool isRunning() const override;
     async::Channel<std::pair<tick_t, Event> > eventReceived() const override;
 
+    void setIsMonitoring(bool arg) override;
+    bool isMonitoring() const override;
+    bool takeMonitoredEvent(Event& e) override;
+
     //internal
     void doProcess(uint32_t message, tick_t timing);
 
@@ -53,6 +58,7 @@ private:
     std::string m_deviceID;
     bool m_running = false;
     async::Channel<std::pair<tick_t, Event> > m_eventReceived;
+    MidiMonitorQueue m_monitorQueue;
 };
 }
 }
@@ -18,6 +18,8 @@
 //=============================================================================
 #include "coremidioutport.h"
 
+#include <algorithm>
+
 #include <QString>
 
 #include <CoreAudio/HostTime.h>
@@ -34,6 +36,12 @@ struct mu::midi::CoreMidiOutPort::Core {
     MIDIPortRef outputPort = 0;
     MIDIEndpointRef destinationId = 0;
     int deviceID = -1;
+
+    //! NOTE The scheduled events, timestamped, until they are sent by flush
+    alignas(MIDIPacketList) Byte scheduledBuffer[4096];
+    MIDIPacketList* scheduled = reinterpret_cast<MIDIPacketList*>(scheduledBuffer);
+    MIDIPacket* lastScheduled = nullptr;
+    MIDITimeStamp lastTimeStamp = 0;
 };
 
 CoreMidiOutPort::CoreMidiOutPort()
@@ -180,3 +188,66 @@ mu::Ret CoreMidiOutPort::sendEvent(const Event& e)
 
     return Ret(true);
 }
+
+mu::Ret CoreMidiOutPort::scheduleEvent(const Event& e, uint32_t delayUsec)
+{
+    if (!isConnected()) {
+        return make_ret(Err::MidiNotConnected);
+    }
+
+    //! NOTE The timestamps of a packet list must not decrease
+    MIDITimeStamp timeStamp = AudioGetCurrentHostTime() + AudioConvertNanosToHostTime(UInt64(delayUsec) * 1000);
+    timeStamp = std::max(timeStamp, m_core->lastTimeStamp);
+
+    auto events = e.toMIDI10();
+    for (auto& event : events) {
+        uint32_t msg = event.to_MIDI10Package();
+        if (!msg) {
+            return make_ret(Err::MidiSendError, "message wasn't converted");
+        }
+
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (!m_core->lastScheduled) {
+                m_core->lastScheduled = MIDIPacketListInit(m_core->scheduled);
+            }
+
+            MIDIPacket* packet = MIDIPacketListAdd(m_core->scheduled, sizeof(m_core->scheduledBuffer), m_core->lastScheduled,
+                                                   timeStamp, sizeof(msg), reinterpret_cast<Byte*>(&msg));
+            if (packet) {
+                m_core->lastScheduled = packet;
+                break;
+            }
+
+            //! NOTE The list is full, it is sent and the event goes to a new one
+            Ret ret = flush();
+            if (!ret) {
+                return ret;
+            }
+        }
+    }
+
+    m_core->lastTimeStamp = timeStamp;
+    return Ret(true);
+}
+
+mu::Ret CoreMidiOutPort::flush()
+{
+    if (!m_core->lastScheduled) {
+        return Ret(true);
+    }
+
+    m_core->lastScheduled = nullptr;
+    m_core->lastTimeStamp = 0;
+
+    if (!isConnected()) {
+        return make_ret(Err::MidiNotConnected);
+    }
+
+    OSStatus result = MIDISend(m_core->outputPort, m_core->destinationId, m_core->scheduled);
+    if (result != noErr) {
+        LOGE() << "midi send error: " << result;
+        return make_ret(Err::MidiSendError, "failed send message. Core error: " + std::to_string(result));
+    }
+
+    return Ret(true);
+}
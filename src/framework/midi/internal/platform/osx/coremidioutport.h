@@ -38,6 +38,8 @@ public:
     std::string deviceID() const override;
 
     Ret sendEvent(const Event& e) override;
+    Ret scheduleEvent(const Event& e, uint32_t delayUsec) override;
+    Ret flush() override;
 
 private:
 
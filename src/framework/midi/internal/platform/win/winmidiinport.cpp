@@ -115,6 +115,7 @@ void WinMidiInPort::doProcess(uint32_t message, tick_t timing)
 {
     auto e = Event::fromMIDI10Package(message).toMIDI20();
     if (e) {
+        m_monitorQueue.push(e);
         m_eventReceived.send({ timing, e });
     }
 }
@@ -204,3 +205,18 @@ mu::async::Channel<std::pair<tick_t, Event> > WinMidiInPort::eventReceived() con
 {
     return m_eventReceived;
 }
+
+void WinMidiInPort::setIsMonitoring(bool arg)
+{
+    m_monitorQueue.setIsEnabled(arg);
+}
+
+bool WinMidiInPort::isMonitoring() const
+{
+    return m_monitorQueue.isEnabled();
+}
+
+bool WinMidiInPort::takeMonitoredEvent(Event& e)
+{
+    return m_monitorQueue.pop(e);
+}
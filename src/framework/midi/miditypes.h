@@ -30,6 +30,7 @@
 #include <cassert>
 #include "async/channel.h"
 #include "midievent.h"
+#include "sortedevents.h"
 
 namespace mu::midi {
 using track_t = unsigned int;
@@ -45,7 +46,7 @@ using SynthMap = std::map<midi::channel_t, SynthName>;
 
 using EventType = Ms::EventType;
 using CntrType = Ms::CntrType;
-using Events = std::multimap<tick_t, Event>;
+using Events = SortedEvents<tick_t>;
 
 struct Chunk {
     tick_t beginTick = 0;
@@ -54,6 +55,13 @@ struct Chunk {
 };
 using Chunks = std::map<tick_t /*begin*/, Chunk>;
 
+//! NOTE A beat of the metronome, clicked by the audio player rather than by a synth
+struct MetronomeClick {
+    bool accent = false;    //! NOTE The first beat of a measure
+    uint8_t velocity = 127;
+};
+using Metronome = std::map<tick_t, MetronomeClick>;
+
 struct Program {
     channel_t channel = 0;
     program_t program = 0;
@@ -73,6 +81,7 @@ struct MidiData {
     std::vector<Event> initEvents;  //! NOTE Set channels programs and others
     std::vector<Track> tracks;
     Chunks chunks;
+    Metronome metronome;
 
     bool isValid() const { return !tracks.empty(); }
 
@@ -131,6 +140,7 @@ struct MidiStream {
     bool isStreamingAllowed = false;
     tick_t lastTick = 0;
     async::Channel<Chunk> stream;
+    async::Channel<Chunk> replace;  //! NOTE Re-rendered after edit, replaces already sent chunks it overlaps
     async::Channel<tick_t> request;
 
     bool isValid() const { return initData.isValid(); }
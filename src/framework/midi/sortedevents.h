@@ -0,0 +1,163 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_MIDI_SORTEDEVENTS_H
+#define MU_MIDI_SORTEDEVENTS_H
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+
+#include "midievent.h"
+
+namespace mu::midi {
+//! NOTE Contiguous replacement of std::multimap<tick_t, Event>.
+//! Ticks and events are kept in separate arrays (struct of arrays),
+//! so seeking by binary search touches only the ticks.
+//! Appends don't keep the order, it is restored once (stable, like multimap) on the first read.
+//! If a container is shared between threads, call sort() before handing it over.
+template<typename Tick>
+class SortedEvents
+{
+public:
+    using tick_type = Tick;
+
+    struct Ref {
+        Tick first;
+        const Event& second;
+
+        const Ref* operator->() const { return this; }
+    };
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ref;
+        using reference = Ref;
+
+        const_iterator() = default;
+        const_iterator(const SortedEvents* c, size_t i)
+            : m_c(c), m_i(i) {}
+
+        Ref operator*() const { return Ref { m_c->m_ticks[m_i], m_c->m_events[m_i] }; }
+        Ref operator->() const { return operator*(); }
+
+        const_iterator& operator++() { ++m_i; return *this; }
+        const_iterator operator++(int) { const_iterator it = *this; ++m_i; return it; }
+        const_iterator& operator--() { --m_i; return *this; }
+        const_iterator& operator+=(difference_type d) { m_i += d; return *this; }
+        const_iterator operator+(difference_type d) const { return const_iterator(m_c, m_i + d); }
+        difference_type operator-(const const_iterator& o) const { return difference_type(m_i) - difference_type(o.m_i); }
+
+        bool operator==(const const_iterator& o) const { return m_i == o.m_i && m_c == o.m_c; }
+        bool operator!=(const const_iterator& o) const { return !operator==(o); }
+        bool operator<(const const_iterator& o) const { return m_i < o.m_i; }
+
+        size_t index() const { return m_i; }
+
+    private:
+        const SortedEvents* m_c = nullptr;
+        size_t m_i = 0;
+    };
+
+    void reserve(size_t size)
+    {
+        m_ticks.reserve(size);
+        m_events.reserve(size);
+    }
+
+    void insert(const std::pair<Tick, Event>& p) { append(p.first, p.second); }
+
+    void append(Tick tick, const Event& e)
+    {
+        if (!m_ticks.empty() && tick < m_ticks.back()) {
+            m_sorted = false;
+        }
+        m_ticks.push_back(tick);
+        m_events.push_back(e);
+    }
+
+    void clear()
+    {
+        m_ticks.clear();
+        m_events.clear();
+        m_sorted = true;
+    }
+
+    size_t size() const { return m_ticks.size(); }
+    bool empty() const { return m_ticks.empty(); }
+
+    const_iterator begin() const { sort(); return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_ticks.size()); }
+
+    //! NOTE First event with tick >= given
+    const_iterator lower_bound(Tick tick) const
+    {
+        sort();
+        auto it = std::lower_bound(m_ticks.cbegin(), m_ticks.cend(), tick);
+        return const_iterator(this, size_t(it - m_ticks.cbegin()));
+    }
+
+    //! NOTE First event with tick > given
+    const_iterator upper_bound(Tick tick) const
+    {
+        sort();
+        auto it = std::upper_bound(m_ticks.cbegin(), m_ticks.cend(), tick);
+        return const_iterator(this, size_t(it - m_ticks.cbegin()));
+    }
+
+    const std::vector<Tick>& ticks() const { sort(); return m_ticks; }
+    const std::vector<Event>& events() const { sort(); return m_events; }
+
+    void sort() const
+    {
+        if (m_sorted) {
+            return;
+        }
+
+        std::vector<size_t> order(m_ticks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            return m_ticks[a] < m_ticks[b];
+        });
+
+        std::vector<Tick> ticks;
+        std::vector<Event> events;
+        ticks.reserve(order.size());
+        events.reserve(order.size());
+        for (size_t i : order) {
+            ticks.push_back(m_ticks[i]);
+            events.push_back(m_events[i]);
+        }
+        m_ticks.swap(ticks);
+        m_events.swap(events);
+        m_sorted = true;
+    }
+
+private:
+    mutable std::vector<Tick> m_ticks;
+    mutable std::vector<Event> m_events;
+    mutable bool m_sorted = true;
+};
+}
+
+#endif // MU_MIDI_SORTEDEVENTS_H
@@ -42,6 +42,19 @@ void ShortcutsRegister::load()
     if (ok) {
         expandStandardKeys(m_shortcuts);
     }
+
+    makeIndexes();
+}
+
+void ShortcutsRegister::makeIndexes()
+{
+    m_sequenceIndex.clear();
+    m_actionIndex.clear();
+
+    for (const Shortcut& shortcut : m_shortcuts) {
+        m_sequenceIndex[shortcut.sequence].push_back(&shortcut);
+        m_actionIndex[shortcut.action].push_back(&shortcut);
+    }
 }
 
 void ShortcutsRegister::expandStandardKeys(ShortcutList& shortcuts) const
@@ -146,10 +159,9 @@ const ShortcutList& ShortcutsRegister::shortcuts() const
 
 Shortcut ShortcutsRegister::shortcut(const std::string& actionCode) const
 {
-    for (const Shortcut& shortcut: m_shortcuts) {
-        if (shortcut.action == actionCode) {
-            return shortcut;
-        }
+    auto it = m_actionIndex.find(actionCode);
+    if (it != m_actionIndex.end()) {
+        return *it->second.front();
     }
 
     return Shortcut();
@@ -158,9 +170,10 @@ Shortcut ShortcutsRegister::shortcut(const std::string& actionCode) const
 ShortcutList ShortcutsRegister::shortcutsForSequence(const std::string& sequence) const
 {
     ShortcutList list;
-    for (const Shortcut& sh : m_shortcuts) {
-        if (sh.sequence == sequence) {
-            list.push_back(sh);
+    auto it = m_sequenceIndex.find(sequence);
+    if (it != m_sequenceIndex.end()) {
+        for (const Shortcut* sh : it->second) {
+            list.push_back(*sh);
         }
     }
     return list;
@@ -19,6 +19,9 @@
 #ifndef MU_SHORTCUTS_SHORTCUTSREGISTER_H
 #define MU_SHORTCUTS_SHORTCUTSREGISTER_H
 
+#include <unordered_map>
+#include <vector>
+
 #include "../ishortcutsregister.h"
 #include "modularity/ioc.h"
 #include "ishortcutsconfiguration.h"
@@ -46,8 +49,14 @@ private:
     Shortcut readShortcut(framework::XmlReader& reader) const;
 
     void expandStandardKeys(ShortcutList& shortcuts) const;
+    void makeIndexes();
 
     ShortcutList m_shortcuts;
+
+    //! NOTE The shortcuts by sequence and by action, rebuilt when the shortcuts are loaded
+    using ShortcutIndex = std::unordered_map<std::string, std::vector<const Shortcut*> >;
+    ShortcutIndex m_sequenceIndex;
+    ShortcutIndex m_actionIndex;
 };
 }
 
@@ -0,0 +1,78 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "performancetelemetry.h"
+
+#include <QStringList>
+
+#include "perfcounters.h"
+
+using namespace mu::telemetry;
+using namespace mu::perfcounters;
+
+static const int BATCH_INTERVAL_MS = 60 * 60 * 1000;
+static const QString CATEGORY("performance");
+
+void PerformanceTelemetry::init()
+{
+    m_batchTimer.setInterval(BATCH_INTERVAL_MS);
+    QObject::connect(&m_batchTimer, &QTimer::timeout, [this]() {
+        sendBatch();
+    });
+    m_batchTimer.start();
+}
+
+void PerformanceTelemetry::deinit()
+{
+    m_batchTimer.stop();
+    sendBatch();
+}
+
+void PerformanceTelemetry::sendBatch()
+{
+    //! NOTE The counts are taken anyway, so that a batch covers only the time since the last one
+    Snapshot snapshot = take();
+    if (!configuration()->isPerformanceTelemetryAllowed() || snapshot.isEmpty()) {
+        return;
+    }
+
+    //! NOTE The label lists the buckets with counts as "upper bound:count", the value is the count of all
+    for (size_t h = 0; h < snapshot.histograms.size(); ++h) {
+        const Buckets& buckets = snapshot.histograms[h];
+        QStringList label;
+        uint64_t total = 0;
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            if (!buckets[b]) {
+                continue;
+            }
+            QString bound = b < BUCKET_BOUNDS_MS.size() ? QString::number(BUCKET_BOUNDS_MS[b]) : QString("inf");
+            label << QString("%1:%2").arg(bound).arg(buckets[b]);
+            total += buckets[b];
+        }
+
+        if (total > 0) {
+            telemetryService()->sendEvent(CATEGORY, name(static_cast<Histogram>(h)), label.join(";"), QVariant::fromValue(total));
+        }
+    }
+
+    for (size_t c = 0; c < snapshot.counters.size(); ++c) {
+        if (snapshot.counters[c] > 0) {
+            telemetryService()->sendEvent(CATEGORY, name(static_cast<Counter>(c)), QString(), QVariant::fromValue(snapshot.counters[c]));
+        }
+    }
+}
@@ -0,0 +1,48 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_TELEMETRY_PERFORMANCETELEMETRY_H
+#define MU_TELEMETRY_PERFORMANCETELEMETRY_H
+
+#include <QTimer>
+
+#include "modularity/ioc.h"
+#include "itelemetryservice.h"
+#include "itelemetryconfiguration.h"
+
+namespace mu::telemetry {
+//! NOTE Sends the performance counters of the session in batches, one event per histogram or counter
+class PerformanceTelemetry
+{
+    INJECT(telemetry, ITelemetryService, telemetryService)
+    INJECT(telemetry, ITelemetryConfiguration, configuration)
+
+public:
+    PerformanceTelemetry() = default;
+
+    void init();
+    void deinit();
+
+    void sendBatch();
+
+private:
+    QTimer m_batchTimer;
+};
+}
+
+#endif // MU_TELEMETRY_PERFORMANCETELEMETRY_H
@@ -27,12 +27,14 @@ using namespace mu::framework;
 static const Settings::Key REQUEST_TELEMETRY_PERMISSION("telemetry", "telemetry/telemetry_access_requested");
 static const Settings::Key IS_TELEMETRY_ALLOWED("telemetry", "telemetry/allowed");
 static const Settings::Key IS_DUMP_UPLOAD_ALLOWED("telemetry", "telemetry/is_dump_upload_allowed");
+static const Settings::Key IS_PERFORMANCE_TELEMETRY_ALLOWED("telemetry", "telemetry/is_performance_telemetry_allowed");
 
 void TelemetryConfiguration::init()
 {
     settings()->setDefaultValue(REQUEST_TELEMETRY_PERMISSION, Val(true));
     settings()->setDefaultValue(IS_TELEMETRY_ALLOWED, Val(false));
     settings()->setDefaultValue(IS_DUMP_UPLOAD_ALLOWED, Val(true));
+    settings()->setDefaultValue(IS_PERFORMANCE_TELEMETRY_ALLOWED, Val(false));
 }
 
 bool TelemetryConfiguration::needRequestTelemetryPermission() const
@@ -60,3 +62,13 @@ void TelemetryConfiguration::setIsDumpUploadAllowed(bool val)
 {
     settings()->setValue(IS_DUMP_UPLOAD_ALLOWED, Val(val));
 }
+
+bool TelemetryConfiguration::isPerformanceTelemetryAllowed() const
+{
+    return isTelemetryAllowed() && settings()->value(IS_PERFORMANCE_TELEMETRY_ALLOWED).toBool();
+}
+
+void TelemetryConfiguration::setIsPerformanceTelemetryAllowed(bool val)
+{
+    settings()->setValue(IS_PERFORMANCE_TELEMETRY_ALLOWED, Val(val));
+}
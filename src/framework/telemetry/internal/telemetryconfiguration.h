@@ -36,6 +36,9 @@ public:
 
     bool isDumpUploadAllowed() const override;
     void setIsDumpUploadAllowed(bool val) override;
+
+    bool isPerformanceTelemetryAllowed() const override;
+    void setIsPerformanceTelemetryAllowed(bool val) override;
 };
 }
 
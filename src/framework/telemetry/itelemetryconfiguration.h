@@ -36,6 +36,10 @@ public:
 
     virtual bool isDumpUploadAllowed() const = 0;
     virtual void setIsDumpUploadAllowed(bool val) = 0;
+
+    //! NOTE Opt-in, the aggregated performance counters are sent only if the telemetry is allowed too
+    virtual bool isPerformanceTelemetryAllowed() const = 0;
+    virtual void setIsPerformanceTelemetryAllowed(bool val) = 0;
 };
 }
 
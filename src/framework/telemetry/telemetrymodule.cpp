@@ -25,6 +25,7 @@
 
 #include "internal/telemetryconfiguration.h"
 #include "internal/telemetryservice.h"
+#include "internal/performancetelemetry.h"
 #include "view/telemetrypermissionmodel.h"
 
 #include "global/iglobalconfiguration.h"
@@ -42,6 +43,7 @@ using namespace mu::framework;
 using namespace mu::ui;
 
 static std::shared_ptr<TelemetryConfiguration> s_configuration = std::make_shared<TelemetryConfiguration>();
+static std::shared_ptr<PerformanceTelemetry> s_performanceTelemetry = std::make_shared<PerformanceTelemetry>();
 
 static void telemetry_init_qrc()
 {
@@ -82,6 +84,7 @@ void TelemetryModule::registerUiTypes()
 void TelemetryModule::onInit(const framework::IApplication::RunMode&)
 {
     s_configuration->init();
+    s_performanceTelemetry->init();
 
     auto globalConf = framework::ioc()->resolve<framework::IGlobalConfiguration>(moduleName());
     IF_ASSERT_FAILED(globalConf) {
@@ -120,3 +123,8 @@ void TelemetryModule::onInit(const framework::IApplication::RunMode&)
     LOGW() << "crash handling disabled";
 #endif
 }
+
+void TelemetryModule::onDeinit()
+{
+    s_performanceTelemetry->deinit();
+}
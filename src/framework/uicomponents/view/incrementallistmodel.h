@@ -0,0 +1,125 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FIT-0NESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_UICOMPONENTS_INCREMENTALLISTMODEL_H
+#define MU_UICOMPONENTS_INCREMENTALLISTMODEL_H
+
+#include <algorithm>
+#include <type_traits>
+#include <unordered_set>
+
+#include <QAbstractListModel>
+#include <QList>
+
+namespace mu::uicomponents {
+//! NOTE A list model which takes a new list of its items as the row removes, moves,
+//! inserts and changes turning the current list into it, instead of a model reset.
+//! The views keep their delegates, scroll position and selection, and only the rows
+//! which did change ask for their data again.
+class IncrementalListModel : public QAbstractListModel
+{
+public:
+    explicit IncrementalListModel(QObject* parent = nullptr)
+        : QAbstractListModel(parent) {}
+
+protected:
+    //! NOTE keyOf(item) identifies an item in both lists and must be unique in each;
+    //! an item whose key is kept is reported as changed if !isEqual(oldItem, newItem)
+    template<typename T, typename KeyOf, typename IsEqual>
+    void updateItems(QList<T>& items, const QList<T>& newItems, KeyOf keyOf, IsEqual isEqual);
+
+    template<typename T, typename KeyOf>
+    void updateItems(QList<T>& items, const QList<T>& newItems, KeyOf keyOf)
+    {
+        updateItems(items, newItems, keyOf, [](const T& item1, const T& item2) { return item1 == item2; });
+    }
+};
+
+template<typename T, typename KeyOf, typename IsEqual>
+void IncrementalListModel::updateItems(QList<T>& items, const QList<T>& newItems, KeyOf keyOf, IsEqual isEqual)
+{
+    using Key = std::decay_t<decltype(keyOf(std::declval<const T&>()))>;
+
+    std::unordered_set<Key> newKeys;
+    for (const T& item : newItems) {
+        newKeys.insert(keyOf(item));
+    }
+
+    //! NOTE The rows which are gone are removed by runs, from the last one
+    for (int row = items.size() - 1; row >= 0; --row) {
+        if (newKeys.count(keyOf(items[row]))) {
+            continue;
+        }
+
+        int last = row;
+        while (row > 0 && !newKeys.count(keyOf(items[row - 1]))) {
+            --row;
+        }
+
+        beginRemoveRows(QModelIndex(), row, last);
+        items.erase(items.begin() + row, items.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    std::unordered_set<Key> oldKeys;
+    for (const T& item : items) {
+        oldKeys.insert(keyOf(item));
+    }
+
+    //! NOTE The rows before row are the new ones from here on
+    for (int row = 0; row < newItems.size();) {
+        const Key key = keyOf(newItems[row]);
+        auto found = std::find_if(items.begin() + row, items.end(), [&keyOf, &key](const T& item) {
+            return keyOf(item) == key;
+        });
+
+        if (!oldKeys.count(key) || found == items.end()) {
+            int last = row;
+            while (last + 1 < newItems.size() && !oldKeys.count(keyOf(newItems[last + 1]))) {
+                ++last;
+            }
+
+            beginInsertRows(QModelIndex(), row, last);
+            for (int i = row; i <= last; ++i) {
+                items.insert(i, newItems[i]);
+            }
+            endInsertRows();
+
+            row = last + 1;
+            continue;
+        }
+
+        int from = int(found - items.begin());
+        if (from != row) {
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+            items.move(from, row);
+            endMoveRows();
+        }
+
+        if (!isEqual(items[row], newItems[row])) {
+            items[row] = newItems[row];
+            QModelIndex changedIndex = index(row);
+            emit dataChanged(changedIndex, changedIndex);
+        }
+
+        ++row;
+    }
+}
+}
+
+#endif // MU_UICOMPONENTS_INCREMENTALLISTMODEL_H
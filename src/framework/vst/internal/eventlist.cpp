@@ -27,11 +27,15 @@ IMPLEMENT_FUNKNOWN_METHODS(EventList, IEventList, IEventList::iid)
 
 EventList::EventList()
 {
+    m_events.reserve(MAX_EVENTS);
 }
 
-void EventList::addMidiEvent(const midi::Event& e)
+void EventList::addMidiEvent(const midi::Event& e, int32 sampleOffset)
 {
-    m_events.push_back(e);
+    if (m_events.size() == MAX_EVENTS) {
+        return;
+    }
+    m_events.push_back({ e, sampleOffset });
 }
 
 void EventList::clear()
@@ -50,12 +54,12 @@ tresult EventList::getEvent(int32 index, Event& e)
         return kOutOfMemory;
     }
 
-    auto& midiEvent = m_events[index];
+    auto& midiEvent = m_events[index].event;
     if (!midiEvent.isChannelVoice()) {
         return kResultFalse;
     }
     e.busIndex = midiEvent.group();
-    e.sampleOffset = 0;//NOTE ???
+    e.sampleOffset = m_events[index].sampleOffset;
     e.ppqPosition = 0; //NOTE ???
     e.flags = Event::kIsLive;
 
@@ -33,7 +33,8 @@ public:
 
     DECLARE_FUNKNOWN_METHODS
 
-    void addMidiEvent(const midi::Event& e);
+    //! NOTE The events are kept in a preallocated list, they are dropped if it's full
+    void addMidiEvent(const midi::Event& e, Steinberg::int32 sampleOffset = 0);
     void clear();
 
     //methods for VST SDK:
@@ -42,7 +43,14 @@ public:
     Steinberg::tresult addEvent(Steinberg::Vst::Event& e) override;
 
 private:
-    std::vector<midi::Event> m_events = {};
+    static const size_t MAX_EVENTS = 1024;
+
+    struct TimedEvent {
+        midi::Event event;
+        Steinberg::int32 sampleOffset = 0;
+    };
+
+    std::vector<TimedEvent> m_events = {};
 };
 } // namespace vst
 } // namespace mu
@@ -0,0 +1,152 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "parameterchanges.h"
+
+using namespace mu::vst;
+using namespace Steinberg;
+using namespace Vst;
+
+DEF_CLASS_IID(IParamValueQueue)
+IMPLEMENT_FUNKNOWN_METHODS(ParameterValueQueue, IParamValueQueue, IParamValueQueue::iid)
+
+ParameterValueQueue::ParameterValueQueue()
+{
+    FUNKNOWN_CTOR
+    m_points.resize(MAX_POINTS);
+}
+
+void ParameterValueQueue::setParameterId(ParamID id)
+{
+    m_id = id;
+}
+
+void ParameterValueQueue::clear()
+{
+    m_count = 0;
+}
+
+ParamID ParameterValueQueue::getParameterId()
+{
+    return m_id;
+}
+
+int32 ParameterValueQueue::getPointCount()
+{
+    return m_count;
+}
+
+tresult ParameterValueQueue::getPoint(int32 index, int32& sampleOffset, ParamValue& value)
+{
+    if (index < 0 || index >= m_count) {
+        return kResultFalse;
+    }
+
+    sampleOffset = m_points[index].sampleOffset;
+    value = m_points[index].value;
+    return kResultOk;
+}
+
+tresult ParameterValueQueue::addPoint(int32 sampleOffset, ParamValue value, int32& index)
+{
+    //! NOTE A point at the same offset replaces the value, when there is no room the last point takes the value
+    index = m_count;
+    while (index > 0 && m_points[index - 1].sampleOffset > sampleOffset) {
+        --index;
+    }
+
+    if (index > 0 && m_points[index - 1].sampleOffset == sampleOffset) {
+        m_points[--index].value = value;
+        return kResultOk;
+    }
+
+    if (m_count == MAX_POINTS) {
+        index = m_count - 1;
+        m_points[index].value = value;
+        return kResultOk;
+    }
+
+    for (int32 i = m_count; i > index; --i) {
+        m_points[i] = m_points[i - 1];
+    }
+    m_points[index] = { sampleOffset, value };
+    ++m_count;
+    return kResultOk;
+}
+
+DEF_CLASS_IID(IParameterChanges)
+IMPLEMENT_FUNKNOWN_METHODS(ParameterChanges, IParameterChanges, IParameterChanges::iid)
+
+ParameterChanges::ParameterChanges()
+{
+    FUNKNOWN_CTOR
+}
+
+void ParameterChanges::setParameterCount(int32 count)
+{
+    m_queues.resize(count);
+    m_count = 0;
+}
+
+void ParameterChanges::addChange(ParamID id, int32 sampleOffset, ParamValue value)
+{
+    int32 index = 0;
+    IParamValueQueue* queue = addParameterData(id, index);
+    if (queue) {
+        queue->addPoint(sampleOffset, value, index);
+    }
+}
+
+void ParameterChanges::clear()
+{
+    for (int32 i = 0; i < m_count; ++i) {
+        m_queues[i].clear();
+    }
+    m_count = 0;
+}
+
+int32 ParameterChanges::getParameterCount()
+{
+    return m_count;
+}
+
+IParamValueQueue* ParameterChanges::getParameterData(int32 index)
+{
+    if (index < 0 || index >= m_count) {
+        return nullptr;
+    }
+    return &m_queues[index];
+}
+
+IParamValueQueue* ParameterChanges::addParameterData(const ParamID& id, int32& index)
+{
+    for (index = 0; index < m_count; ++index) {
+        if (m_queues[index].getParameterId() == id) {
+            return &m_queues[index];
+        }
+    }
+
+    if (m_count == static_cast<int32>(m_queues.size())) {
+        return nullptr;
+    }
+
+    index = m_count++;
+    m_queues[index].setParameterId(id);
+    m_queues[index].clear();
+    return &m_queues[index];
+}
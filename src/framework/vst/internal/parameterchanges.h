@@ -0,0 +1,86 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_VST_PARAMETERCHANGES_H
+#define MU_VST_PARAMETERCHANGES_H
+
+#include <vector>
+
+#include "pluginterfaces/base/ftypes.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+namespace mu {
+namespace vst {
+//! NOTE The changes of one parameter in a process block, the points are sorted by the sample offset
+class ParameterValueQueue : public Steinberg::Vst::IParamValueQueue
+{
+public:
+    ParameterValueQueue();
+    virtual ~ParameterValueQueue() = default;
+
+    DECLARE_FUNKNOWN_METHODS
+
+    void setParameterId(Steinberg::Vst::ParamID id);
+    void clear();
+
+    //methods for VST SDK:
+    Steinberg::Vst::ParamID getParameterId() override;
+    Steinberg::int32 getPointCount() override;
+    Steinberg::tresult getPoint(Steinberg::int32 index, Steinberg::int32& sampleOffset, Steinberg::Vst::ParamValue& value) override;
+    Steinberg::tresult addPoint(Steinberg::int32 sampleOffset, Steinberg::Vst::ParamValue value, Steinberg::int32& index) override;
+
+private:
+    static const Steinberg::int32 MAX_POINTS = 64;
+
+    struct Point {
+        Steinberg::int32 sampleOffset = 0;
+        Steinberg::Vst::ParamValue value = 0.0;
+    };
+
+    Steinberg::Vst::ParamID m_id = 0;
+    std::vector<Point> m_points;
+    Steinberg::int32 m_count = 0;
+};
+
+//! NOTE The parameter changes passed to the processor with a process block.
+//! The queues are allocated by setParameterCount, adding changes on the audio thread does not allocate.
+class ParameterChanges : public Steinberg::Vst::IParameterChanges
+{
+public:
+    ParameterChanges();
+    virtual ~ParameterChanges() = default;
+
+    DECLARE_FUNKNOWN_METHODS
+
+    void setParameterCount(Steinberg::int32 count);
+    void addChange(Steinberg::Vst::ParamID id, Steinberg::int32 sampleOffset, Steinberg::Vst::ParamValue value);
+    void clear();
+
+    //methods for VST SDK:
+    Steinberg::int32 getParameterCount() override;
+    Steinberg::Vst::IParamValueQueue* getParameterData(Steinberg::int32 index) override;
+    Steinberg::Vst::IParamValueQueue* addParameterData(const Steinberg::Vst::ParamID& id, Steinberg::int32& index) override;
+
+private:
+    std::vector<ParameterValueQueue> m_queues;
+    Steinberg::int32 m_count = 0;
+};
+} // namespace vst
+} // namespace mu
+
+#endif // MU_VST_PARAMETERCHANGES_H
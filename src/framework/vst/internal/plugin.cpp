@@ -18,6 +18,7 @@
 //=============================================================================
 #include "plugin.h"
 #include "plugininstance.h"
+#include "pluginloader.h"
 #include "pluginterfaces/vst/ivstaudioprocessor.h"
 
 using namespace mu::vst;
@@ -34,8 +35,13 @@ Plugin::Plugin(Steinberg::PClassInfo2 effectClass, Steinberg::IPluginFactory3* f
 {
 }
 
+Plugin::Plugin(Steinberg::PClassInfo2 effectClass, const std::string& folder, const std::string& filename)
+    : m_effectClass(effectClass), m_folder(folder), m_filename(filename)
+{
+}
+
 Plugin::Plugin(const Plugin& second)
-    : m_effectClass(second.m_effectClass), m_factory(second.m_factory)
+    : m_effectClass(second.m_effectClass), m_factory(second.m_factory), m_folder(second.m_folder), m_filename(second.m_filename)
 {
 }
 
@@ -62,9 +68,28 @@ Plugin::Type Plugin::getType() const
 
 std::shared_ptr<PluginInstance> Plugin::createInstance()
 {
+    if (!m_factory && !loadFactory()) {
+        return nullptr;
+    }
     return PluginInstance::create(this);
 }
 
+bool Plugin::loadFactory()
+{
+    PluginLoader loader(m_folder, m_filename);
+    if (!loader.load()) {
+        return false;
+    }
+
+    for (const Plugin& p : loader.getPlugins()) {
+        if (p.getId() == getId()) {
+            m_factory = p.m_factory;
+            return true;
+        }
+    }
+    return false;
+}
+
 const std::map<std::string, Plugin::Type> Plugin::subCategoriesMap =
 {
     { PlugType::kFxInstrument, Instrument },
@@ -27,6 +27,7 @@ namespace mu {
 namespace vst {
 class PluginLoader;
 class PluginInstance;
+class VSTScanner;
 class Plugin
 {
 public:
@@ -40,6 +41,7 @@ public:
     Plugin(const Plugin& second);
     friend PluginInstance;
     friend PluginLoader;
+    friend VSTScanner;
 
     INJECT(vst, IVSTInstanceRegister, vstInstanceRegister)
 
@@ -57,6 +59,10 @@ public:
 
 private:
     Plugin(Steinberg::PClassInfo2 effectClass, Steinberg::IPluginFactory3* factory);
+    Plugin(Steinberg::PClassInfo2 effectClass, const std::string& folder, const std::string& filename);
+
+    //! load the library of a plugin known from the scan cache
+    bool loadFactory();
 
     //! static map of supported plugin's types
     static const std::map<std::string, Type> subCategoriesMap;
@@ -64,8 +70,12 @@ private:
     //! information about AudioEffectClass of plugin
     Steinberg::PClassInfo2 m_effectClass;
 
-    //! pointer to the factory function of plugin
+    //! pointer to the factory function of plugin, nullptr until the library is loaded
     Steinberg::IPluginFactory3* m_factory = nullptr;
+
+    //! the library of the plugin
+    std::string m_folder;
+    std::string m_filename;
 };
 }
 }
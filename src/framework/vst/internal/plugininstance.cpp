@@ -33,7 +33,7 @@ using namespace Steinberg::Vst;
 
 PluginInstance::PluginInstance(const Plugin* plugin)
     : m_plugin(*plugin),
-    m_parameters(), m_events(), m_host(),
+    m_parameters(), m_events(), m_parameterChanges(), m_host(),
     m_effectClass(plugin->m_effectClass),
     m_factory(plugin->m_factory)
 {
@@ -108,9 +108,11 @@ bool PluginInstance::isActive() const
     return m_active;
 }
 
-void PluginInstance::addMidiEvent(const mu::midi::Event& e)
+void PluginInstance::addMidiEvent(const mu::midi::Event& e, int sampleOffset)
 {
-    m_events.addMidiEvent(e);
+    if (!m_eventQueue.tryPush({ e, sampleOffset })) {
+        LOGW() << "event queue is full, the event is dropped";
+    }
 }
 
 Ret PluginInstance::setSampleRate(int sampleRate)
@@ -128,60 +130,89 @@ Ret PluginInstance::setSampleRate(int sampleRate)
 
 void PluginInstance::process(float* input, float* output, unsigned int samples)
 {
+    UNUSED(input) //TODO: fill input buffers from stream if given (for audio plugins)
+
     if (!isActive()) {
         return;
     }
-    AudioBusBuffers out[m_busInfo.audioOutput.size()], in[m_busInfo.audioInput.size()];
-    auto initBuffers = [&samples](AudioBusBuffers* buffers, std::vector<unsigned int>& busInfo, float* stream) {
-        for (unsigned int i = 0; i < busInfo.size(); ++i) {
-            auto channels = busInfo[i];
-            buffers[i].numChannels = channels;
-            buffers[i].silenceFlags = 0;
-            buffers[i].channelBuffers32 = new Sample32*[channels];
-            for (unsigned int j = 0; j < channels; ++j) {
-                buffers[i].channelBuffers32[j] = new Sample32[samples];
-                if (stream) {
-                    //TODO: fill buffer from stream if given (for audio plugins)
-                }
-            }
+
+    //! NOTE The queued changes go with the first block, the longer buffers are split
+    takeQueued(std::min<unsigned int>(samples, MAX_SAMPLES_PERBLOCK));
+
+    unsigned int done = 0;
+    while (done < samples) {
+        unsigned int count = std::min<unsigned int>(samples - done, MAX_SAMPLES_PERBLOCK);
+        processBlock(output ? output + done * audio::synth::AUDIO_CHANNELS : nullptr, count);
+        done += count;
+    }
+}
+
+void PluginInstance::processBlock(float* output, unsigned int samples)
+{
+    for (AudioBusBuffers& bus : m_inputBuffers) {
+        for (int32 j = 0; j < bus.numChannels; ++j) {
+            std::fill(bus.channelBuffers32[j], bus.channelBuffers32[j] + samples, 0.f);
         }
-    };
-    initBuffers(in, m_busInfo.audioInput, input);
-    initBuffers(out, m_busInfo.audioOutput, nullptr);
+    }
 
     ProcessData data;
-    data.numOutputs = m_busInfo.audioOutput.size();
-    data.numInputs = m_busInfo.audioInput.size();
-    data.outputs = out;
-    data.inputs = in;
+    data.numOutputs = m_outputBuffers.size();
+    data.numInputs = m_inputBuffers.size();
+    data.outputs = m_outputBuffers.data();
+    data.inputs = m_inputBuffers.data();
     data.processMode = kRealtime;
     data.symbolicSampleSize = kSample32;
     data.numSamples = samples;
     //data.processContext
     data.inputEvents = &m_events;
+    data.inputParameterChanges = &m_parameterChanges;
     //data.outputEvents
 
     if (m_audioProcessor->process(data) != kResultOk) {
         LOGE() << "VST plugin processing error";
     }
     m_events.clear();
+    m_parameterChanges.clear();
 
-    if (output && m_busInfo.audioOutput.size()) {
+    if (output && !m_outputBuffers.empty() && m_outputBuffers[0].numChannels > 0) {
+        const AudioBusBuffers& out = m_outputBuffers[0];
         for (unsigned int i = 0; i < samples; ++i) {
             for (unsigned int s = 0; s < audio::synth::AUDIO_CHANNELS; ++s) {
-                auto getFromChannel = std::min<unsigned int>(s, out[0].numChannels - 1);
-                output[i * audio::synth::AUDIO_CHANNELS + s] = out[0].channelBuffers32[getFromChannel][i];
+                auto getFromChannel = std::min<unsigned int>(s, out.numChannels - 1);
+                output[i * audio::synth::AUDIO_CHANNELS + s] = out.channelBuffers32[getFromChannel][i];
             }
         }
     }
 }
 
+void PluginInstance::takeQueued(unsigned int samples)
+{
+    int32 lastOffset = samples > 0 ? static_cast<int32>(samples) - 1 : 0;
+    auto offset = [lastOffset](int32 sampleOffset) {
+        return std::max<int32>(0, std::min<int32>(sampleOffset, lastOffset));
+    };
+
+    QueuedEvent e;
+    while (m_eventQueue.tryPop(e)) {
+        m_events.addMidiEvent(e.event, offset(e.sampleOffset));
+    }
+
+    QueuedParameter p;
+    while (m_parameterQueue.tryPop(p)) {
+        m_parameterChanges.addChange(p.id, offset(p.sampleOffset), p.value);
+    }
+}
+
 void PluginInstance::flush()
 {
     if (!isActive()) {
         return;
     }
+
+    //! NOTE The events are dropped, a process call without samples only passes the parameter changes
+    takeQueued(0);
     m_events.clear();
+
     ProcessData data;
     data.numOutputs = 0;
     data.numInputs = 0;
@@ -190,10 +221,12 @@ void PluginInstance::flush()
     data.processMode = kRealtime;
     data.symbolicSampleSize = kSample32;
     data.numSamples = 0;
+    data.inputParameterChanges = &m_parameterChanges;
 
     if (m_audioProcessor->process(data) != kResultOk) {
         LOGE() << "VST plugin flush error";
     }
+    m_parameterChanges.clear();
 }
 
 std::vector<PluginParameter> PluginInstance::getParameters() const
@@ -298,6 +331,8 @@ void PluginInstance::initParameters()
         m_controller->getParameterInfo(i, info);
         m_parameters[i] = info;
     }
+
+    m_parameterChanges.setParameterCount(count);
 }
 
 DEF_CLASS_IID(IAudioProcessor)
@@ -319,6 +354,37 @@ void PluginInstance::initAudioProcessor()
     initBuses(m_busInfo.audioOutput, kAudio, kOutput);
     initBuses(m_busInfo.eventInput, kEvent, kInput);
     initBuses(m_busInfo.eventOutput, kEvent, kOutput);
+    initAudioBuffers();
+}
+
+void PluginInstance::initAudioBuffers()
+{
+    size_t channels = 0;
+    for (unsigned int count : m_busInfo.audioInput) {
+        channels += count;
+    }
+    for (unsigned int count : m_busInfo.audioOutput) {
+        channels += count;
+    }
+
+    m_channelBuffers.assign(channels, std::vector<Sample32>(MAX_SAMPLES_PERBLOCK, 0.f));
+    m_channelPointers.resize(channels);
+    for (size_t i = 0; i < channels; ++i) {
+        m_channelPointers[i] = m_channelBuffers[i].data();
+    }
+
+    size_t first = 0;
+    auto setupBuffers = [this, &first](std::vector<AudioBusBuffers>& buffers, const std::vector<unsigned int>& busInfo) {
+        buffers.resize(busInfo.size());
+        for (size_t i = 0; i < busInfo.size(); ++i) {
+            buffers[i].numChannels = busInfo[i];
+            buffers[i].silenceFlags = 0;
+            buffers[i].channelBuffers32 = m_channelPointers.data() + first;
+            first += busInfo[i];
+        }
+    };
+    setupBuffers(m_inputBuffers, m_busInfo.audioInput);
+    setupBuffers(m_outputBuffers, m_busInfo.audioOutput);
 }
 
 void PluginInstance::initBuses(std::vector<unsigned int>& target, MediaType type, BusDirection direction)
@@ -381,7 +447,7 @@ void PluginInstance::setParameterValue(const PluginParameter& parameter, double
     setParameterValue(parameter.id(), value);
 }
 
-void PluginInstance::setParameterValue(const uint id, double value)
+void PluginInstance::setParameterValue(const uint id, double value, int sampleOffset)
 {
     IF_ASSERT_FAILED(id < m_parameters.size()) {
         LOGE() << "paremeter is not exists";
@@ -390,6 +456,11 @@ void PluginInstance::setParameterValue(const uint id, double value)
     IF_ASSERT_FAILED(m_controller->setParamNormalized(id, value) == kResultOk) {
         LOGE() << "can't apply parameter's value";
     }
+
+    //! NOTE The processor has its own state of the parameters, it gets the change with the next process block
+    if (!m_parameterQueue.tryPush({ id, value, sampleOffset })) {
+        LOGW() << "parameter queue is full, the change is dropped";
+    }
 }
 
 unsigned int PluginInstance::getLatency() const
@@ -26,6 +26,8 @@
 #include "connectionproxy.h"
 #include "pluginparameter.h"
 #include "eventlist.h"
+#include "parameterchanges.h"
+#include "spscqueue.h"
 #include "plugin.h"
 #include "pluginterfaces/vst/ivstcomponent.h"
 #include "pluginterfaces/vst/ivsteditcontroller.h"
@@ -42,6 +44,7 @@ class PluginInstance
 {
     INJECT_STATIC(vst, IVSTInstanceRegister, vstInstanceRegister)
     const static Steinberg::int32 MAX_SAMPLES_PERBLOCK = 8192;
+    const static size_t QUEUE_CAPACITY = 1024;
 
 public:
     PluginInstance(const Plugin* plugin);
@@ -65,8 +68,9 @@ public:
     //! true if processing is active
     bool isActive() const;
 
-    //! add event for future processing
-    void addMidiEvent(const midi::Event& e);
+    //! add event for future processing, at the sample offset in the next process block.
+    //! Called by the sequencer, the events are passed to the audio thread without locking
+    void addMidiEvent(const midi::Event& e, int sampleOffset = 0);
 
     Ret setSampleRate(int sampleRate);
 
@@ -92,8 +96,9 @@ public:
     //! set value for parameter
     void setParameterValue(const PluginParameter& parameter, double value);
 
-    //! set value for parameter
-    void setParameterValue(const uint id, double value);
+    //! set value for parameter, called from the UI thread. The controller gets it at once,
+    //! the processor at the sample offset of the next process block, without locking
+    void setParameterValue(const uint id, double value, int sampleOffset = 0);
 
     //! latency of the plugin in samples, should be used in latency compensation of a mixer
     unsigned int getLatency() const;
@@ -114,6 +119,14 @@ private:
     //! recieve information about plugin's busses
     void initBuses(std::vector<unsigned int>& target, Steinberg::Vst::MediaType type, Steinberg::Vst::BusDirection direction);
 
+    //! allocate the channel buffers of the busses, so that processing does not allocate
+    void initAudioBuffers();
+
+    //! move the queued events and parameter changes to the lists of the process block
+    void takeQueued(unsigned int samples);
+
+    void processBlock(float* output, unsigned int samples);
+
     //! registered instance id
     instanceId m_id = IVSTInstanceRegister::ID_NOT_SETTED;
 
@@ -132,6 +145,29 @@ private:
     //! interface for midi events
     EventList m_events;
 
+    //! interface for parameter changes
+    ParameterChanges m_parameterChanges;
+
+    struct QueuedEvent {
+        midi::Event event;
+        Steinberg::int32 sampleOffset = 0;
+    };
+
+    struct QueuedParameter {
+        Steinberg::Vst::ParamID id = 0;
+        Steinberg::Vst::ParamValue value = 0.0;
+        Steinberg::int32 sampleOffset = 0;
+    };
+
+    //! filled by the sequencer and the UI, taken at the start of each process block
+    SpscQueue<QueuedEvent> m_eventQueue { QUEUE_CAPACITY };
+    SpscQueue<QueuedParameter> m_parameterQueue { QUEUE_CAPACITY };
+
+    //! channel buffers of the busses
+    std::vector<Steinberg::Vst::AudioBusBuffers> m_inputBuffers, m_outputBuffers;
+    std::vector<std::vector<Steinberg::Vst::Sample32> > m_channelBuffers;
+    std::vector<Steinberg::Vst::Sample32*> m_channelPointers;
+
     struct
     {
         std::vector<unsigned int> audioInput;
@@ -95,7 +95,10 @@ void PluginLoader::initPlugins()
         m_factory->getClassInfo2(i, &classInfo);
 
         if (std::string(classInfo.category).compare(kVstAudioEffectClass) == 0) {
-            m_plugins.push_back(Plugin(classInfo, m_factory));
+            Plugin plugin(classInfo, m_factory);
+            plugin.m_folder = m_folder;
+            plugin.m_filename = m_filename;
+            m_plugins.push_back(plugin);
         }
     }
 }
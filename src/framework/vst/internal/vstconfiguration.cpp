@@ -41,3 +41,8 @@ std::string VSTConfiguration::searchPaths() const
 {
     return settings()->value(SEARCH_PATHS).toString();
 }
+
+mu::io::path VSTConfiguration::scanCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/vst_scan.json";
+}
@@ -21,15 +21,21 @@
 
 #include <string>
 #include "settings.h"
+#include "modularity/ioc.h"
+#include "iglobalconfiguration.h"
+#include "io/path.h"
 
 namespace mu {
 namespace vst {
 class VSTConfiguration
 {
+    INJECT(vst, framework::IGlobalConfiguration, globalConfiguration)
+
 public:
     void init();
 
     std::string searchPaths() const;
+    io::path scanCachePath() const;
 
     //! default paths in system for plugin scanning
     static const std::string DEFAULT_PATHS;
@@ -18,10 +18,19 @@
 //=============================================================================
 
 #include "vstscanner.h"
+#include <cstring>
 #include <string>
+#include <QCoreApplication>
 #include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
 #include <QString>
+#include <QtConcurrent>
 #include "pluginloader.h"
+#include "log.h"
 
 using namespace mu::vst;
 
@@ -34,29 +43,177 @@ VSTScanner::VSTScanner()
 {
 }
 
-//TODO: rewrite with FsOperations when it will have needed functionality
+static const QString STATE_OK("ok");
+static const QString STATE_SCANNING("scanning");
+static const QString STATE_FAILED("failed");
+
+static QJsonObject readCache(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonObject();
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+static void writeCache(const QString& path, const QJsonObject& cache)
+{
+    if (path.isEmpty()) {
+        return;
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed to write the VST scan cache: " << path;
+        return;
+    }
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+static QString classToHex(const Steinberg::PClassInfo2& info)
+{
+    return QString::fromLatin1(QByteArray(reinterpret_cast<const char*>(&info), sizeof(info)).toHex());
+}
+
+static bool classFromHex(const QString& hex, Steinberg::PClassInfo2& info)
+{
+    QByteArray bytes = QByteArray::fromHex(hex.toLatin1());
+    if (bytes.size() != int(sizeof(info))) {
+        return false;
+    }
+    memcpy(&info, bytes.constData(), sizeof(info));
+    return true;
+}
+
+void VSTScanner::setCachePath(const io::path& path)
+{
+    m_cachePath = path;
+}
+
 void VSTScanner::scan()
 {
-    for (auto&& dirPath : m_paths) {
+    std::map<std::string, Plugin> plugins = scanPaths(m_paths, m_cachePath);
+
+    std::lock_guard<std::mutex> lock(m_pluginsMutex);
+    m_plugins = plugins;
+}
+
+void VSTScanner::scanAsync()
+{
+    QtConcurrent::run(this, &VSTScanner::th_scan, m_paths, m_cachePath);
+}
+
+void VSTScanner::th_scan(const std::vector<std::string>& paths, const io::path& cachePath)
+{
+    std::map<std::string, Plugin> plugins = scanPaths(paths, cachePath);
+
+    QMetaObject::invokeMethod(qApp, [this, plugins]() {
+        {
+            std::lock_guard<std::mutex> lock(m_pluginsMutex);
+            m_plugins = plugins;
+        }
+        m_pluginsChanged.notify();
+    }, Qt::QueuedConnection);
+}
+
+mu::async::Notification VSTScanner::pluginsChanged() const
+{
+    return m_pluginsChanged;
+}
+
+//! NOTE A plugin file is loaded only if it is new or changed since the last scan, the others are
+//! taken from the cache and loaded on the first createInstance. The file is marked as being scanned
+//! in the cache before it is loaded, so a plugin which crashes the scan is skipped the next times.
+//TODO: rewrite with FsOperations when it will have needed functionality
+std::map<std::string, Plugin> VSTScanner::scanPaths(const std::vector<std::string>& paths, const io::path& cachePath)
+{
+    static std::mutex scanMutex;
+    std::lock_guard<std::mutex> lock(scanMutex);
+
+    const QString cacheFile = cachePath.toQString();
+    QJsonObject oldCache = cacheFile.isEmpty() ? QJsonObject() : readCache(cacheFile);
+    QJsonObject cache;
+    std::map<std::string, Plugin> plugins;
+
+    auto addPlugin = [&plugins](const Plugin& p) {
+        if (p.getType() == Plugin::Instrument) {
+            plugins[p.getId()] = p;
+        }
+    };
+
+    for (auto&& dirPath : paths) {
         QDir directory(QString::fromStdString(dirPath));
-        if (directory.exists()) {
-            for (auto&& pluginName : directory.entryList(QStringList({ "*.vst3" }))) {
-                PluginLoader loader(dirPath, pluginName.toStdString());
-                loader.load();
-                auto plugins = loader.getPlugins();
-
-                for (auto&& p : plugins) {
-                    if (p.getType() == Plugin::Instrument) {
-                        m_plugins[p.getId()] = p;
+        if (!directory.exists()) {
+            continue;
+        }
+
+        for (auto&& pluginName : directory.entryList(QStringList({ "*.vst3" }))) {
+            QFileInfo fileInfo(directory, pluginName);
+            const QString key = fileInfo.absoluteFilePath();
+            const qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+            const qint64 size = fileInfo.size();
+
+            QJsonObject entry = oldCache.value(key).toObject();
+            bool unchanged = !entry.isEmpty()
+                             && qint64(entry.value("modified").toDouble()) == modified
+                             && qint64(entry.value("size").toDouble()) == size;
+
+            if (unchanged) {
+                QString state = entry.value("state").toString();
+                if (state == STATE_SCANNING) {
+                    LOGE() << "VST plugin has crashed the last scan, skipped: " << key;
+                    entry["state"] = STATE_FAILED;
+                    state = STATE_FAILED;
+                }
+
+                if (state == STATE_OK) {
+                    for (const QJsonValue& hex : entry.value("classes").toArray()) {
+                        Steinberg::PClassInfo2 info;
+                        if (classFromHex(hex.toString(), info)) {
+                            addPlugin(Plugin(info, dirPath, pluginName.toStdString()));
+                        }
                     }
                 }
+
+                cache[key] = entry;
+                continue;
+            }
+
+            entry = QJsonObject();
+            entry["modified"] = double(modified);
+            entry["size"] = double(size);
+            entry["state"] = STATE_SCANNING;
+            cache[key] = entry;
+
+            QJsonObject pending = oldCache;
+            for (auto it = cache.constBegin(); it != cache.constEnd(); ++it) {
+                pending[it.key()] = it.value();
+            }
+            writeCache(cacheFile, pending);
+
+            PluginLoader loader(dirPath, pluginName.toStdString());
+            bool ok = loader.load();
+
+            QJsonArray classes;
+            for (auto&& p : loader.getPlugins()) {
+                classes.append(classToHex(p.m_effectClass));
+                addPlugin(p);
             }
+
+            entry["state"] = ok ? STATE_OK : STATE_FAILED;
+            entry["classes"] = classes;
+            cache[key] = entry;
         }
     }
+
+    writeCache(cacheFile, cache);
+
+    return plugins;
 }
 
-const std::map<std::string, Plugin>& VSTScanner::getPlugins() const
+std::map<std::string, Plugin> VSTScanner::getPlugins() const
 {
+    std::lock_guard<std::mutex> lock(m_pluginsMutex);
     return m_plugins;
 }
 
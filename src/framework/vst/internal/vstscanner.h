@@ -19,10 +19,14 @@
 #ifndef MU_VST_VSTSCANNER_H
 #define MU_VST_VSTSCANNER_H
 
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "plugin.h"
 #include "modularity/imoduleexport.h"
+#include "async/notification.h"
+#include "io/path.h"
 
 namespace mu {
 namespace vst {
@@ -39,18 +43,31 @@ public:
     std::string paths() const;
     void setPaths(const std::string& path);
 
+    //! file of the scan results, the plugin files which did not change since are not loaded again
+    void setCachePath(const io::path& path);
+
     //! scnan for installed VST3 plugins
     void scan();
 
+    //! scan on a background thread, pluginsChanged is notified on the main thread when it is done
+    void scanAsync();
+    async::Notification pluginsChanged() const;
+
     //! return all available plugins as a map: [std::string UID] : Plugin
-    const std::map<std::string, Plugin>& getPlugins() const;
+    std::map<std::string, Plugin> getPlugins() const;
 
 private:
+    void th_scan(const std::vector<std::string>& paths, const io::path& cachePath);
+    static std::map<std::string, Plugin> scanPaths(const std::vector<std::string>& paths, const io::path& cachePath);
+
     //! paths to search installed plugins
     std::vector<std::string> m_paths = {};
+    io::path m_cachePath;
 
     //! all loaded plugins m_plugins[UID] = Plugin
     std::map<std::string, Plugin> m_plugins = {};
+    mutable std::mutex m_pluginsMutex;
+    async::Notification m_pluginsChanged;
 };
 }
 }
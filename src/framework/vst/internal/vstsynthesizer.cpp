@@ -114,6 +114,12 @@ bool VSTSynthesizer::handleEvent(const midi::Event& e)
     return true;
 }
 
+void VSTSynthesizer::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    //! NOTE The plugin gets the offset with the event and handles it inside the block itself
+    m_instance->addMidiEvent(e, sampleOffset);
+}
+
 void VSTSynthesizer::writeBuf(float* stream, unsigned int samples)
 {
     m_instance->process(/*input stream*/ nullptr, stream, samples);
@@ -159,6 +165,12 @@ bool VSTSynthesizer::channelPitch(midi::channel_t chan, int16_t val)
     return true;
 }
 
+void VSTSynthesizer::setRenderBudget(const audio::synth::RenderBudget& budget)
+{
+    //! NOTE The plugins manage their voices themselves
+    UNUSED(budget);
+}
+
 unsigned int VSTSynthesizer::streamCount() const
 {
     return audio::synth::AUDIO_CHANNELS;
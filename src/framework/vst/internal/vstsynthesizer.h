@@ -48,6 +48,7 @@ public:
 
     Ret setupChannels(const std::vector<mu::midi::Event>& events) override;
     bool handleEvent(const mu::midi::Event& e) override;
+    void scheduleEvent(const mu::midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override;
@@ -56,6 +57,7 @@ public:
     bool channelVolume(mu::midi::channel_t chan, float val) override;  // 0. - 1.
     bool channelBalance(mu::midi::channel_t chan, float val) override; // -1. - 1.
     bool channelPitch(mu::midi::channel_t chan, int16_t val) override; // -12 - 12
+    void setRenderBudget(const audio::synth::RenderBudget& budget) override;
 
     unsigned int streamCount() const override;
     void forward(unsigned int sampleCount) override;
@@ -29,7 +29,10 @@ PluginListModel::PluginListModel(QObject* parent)
 PluginListModel::PluginListModel(std::shared_ptr<VSTScanner> scaner, QObject* parent)
     : QAbstractListModel(parent), m_scanner(scaner)
 {
-    update();
+    updatePlugins();
+    m_scanner->pluginsChanged().onNotify(this, [this]() {
+        updatePlugins();
+    });
 }
 
 Qt::ItemFlags PluginListModel::flags(const QModelIndex& index) const
@@ -47,7 +50,7 @@ int PluginListModel::rowCount(const QModelIndex& parent) const
         return 0;
     }
 
-    return m_scanner->getPlugins().size();
+    return m_plugins.size();
 }
 
 QHash<int, QByteArray> PluginListModel::roleNames() const
@@ -85,11 +88,17 @@ QVariant PluginListModel::data(const QModelIndex& index, int role) const
 
 void PluginListModel::update()
 {
+    m_scanner->scanAsync();
+}
+
+void PluginListModel::updatePlugins()
+{
+    beginResetModel();
     m_plugins.clear();
-    m_scanner->scan();
     for (auto&& p : m_scanner->getPlugins()) {
         m_plugins.push_back(p.second);
     }
+    endResetModel();
 }
 
 const Plugin PluginListModel::nullPlugin = Plugin();
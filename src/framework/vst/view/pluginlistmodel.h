@@ -22,10 +22,11 @@
 #include <QAbstractListModel>
 
 #include "internal/vstscanner.h"
+#include "async/asyncable.h"
 
 namespace mu {
 namespace vst {
-class PluginListModel : public QAbstractListModel
+class PluginListModel : public QAbstractListModel, public async::Asyncable
 {
     Q_OBJECT
 
@@ -47,6 +48,8 @@ public:
     const Plugin& item(unsigned int index);
 
 private:
+    void updatePlugins();
+
     std::shared_ptr<VSTScanner> m_scanner = nullptr;
     QList<Plugin> m_plugins = {};
     static const Plugin nullPlugin;
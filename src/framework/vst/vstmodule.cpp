@@ -76,6 +76,11 @@ void VSTModule::registerUiTypes()
     qRegisterMetaType<PluginEditorView>("PluginEditorView");
 }
 
+bool VSTModule::isInitDeferred() const
+{
+    return true;
+}
+
 void VSTModule::onInit(const IApplication::RunMode& mode)
 {
     if (framework::IApplication::RunMode::Editor != mode) {
@@ -84,4 +89,11 @@ void VSTModule::onInit(const IApplication::RunMode& mode)
 
     m_configuration.init();
     s_vstScanner->setPaths(m_configuration.searchPaths());
+    s_vstScanner->setCachePath(m_configuration.scanCachePath());
+}
+
+void VSTModule::onStartApp()
+{
+    //! NOTE Only the plugins added or changed since the last scan are loaded
+    s_vstScanner->scanAsync();
 }
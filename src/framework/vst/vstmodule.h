@@ -33,7 +33,9 @@ public:
     void resolveImports() override;
     void registerResources() override;
     void registerUiTypes() override;
+    bool isInitDeferred() const override;
     void onInit(const framework::IApplication::RunMode& mode) override;
+    void onStartApp() override;
 
 private:
     static VSTConfiguration m_configuration;
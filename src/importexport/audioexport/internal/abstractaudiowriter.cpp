@@ -0,0 +1,187 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "abstractaudiowriter.h"
+
+#include "log.h"
+
+#include "libmscore/measure.h"
+#include "libmscore/repeatlist.h"
+#include "libmscore/score.h"
+
+using namespace mu::iex::audioexport;
+using namespace mu::audio;
+using namespace mu::notation;
+
+mu::Ret AbstractAudioWriter::write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+{
+    return doWrite(notation, { &destinationDevice }, options, false);
+}
+
+mu::Ret AbstractAudioWriter::writeStems(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                                        const Options& options)
+{
+    return doWrite(notation, destinationDevices, options, true);
+}
+
+mu::Ret AbstractAudioWriter::doWrite(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                                     const Options& options, bool isStems)
+{
+    INotationPlaybackPtr playback = notation ? notation->playback() : nullptr;
+    IF_ASSERT_FAILED(playback) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    m_aborted = false;
+
+    IOfflineAudioRenderer::Options renderOptions;
+    if (options.contains(OptionKey::FIRST_MEASURE_INDEX) || options.contains(OptionKey::LAST_MEASURE_INDEX)) {
+        Ret ret = setMeasureRange(notation, options, renderOptions);
+        if (!ret) {
+            return ret;
+        }
+    }
+
+    //! NOTE The score is rendered once: the mix goes to the first device and the channels of part i,
+    //! rendered by synthesizer instances of their own, to device i + 1
+    midi::MidiData data = playback->exportMidiData();
+    std::vector<AbstractAudioWriter*> encoders = { this };
+    std::vector<std::shared_ptr<AbstractAudioWriter> > stemWriters;
+    if (isStems) {
+        if (destinationDevices.size() != data.tracks.size() + 1) {
+            LOGE() << "expected " << data.tracks.size() + 1 << " devices, got: " << destinationDevices.size();
+            return make_ret(Ret::Code::InternalError);
+        }
+
+        for (const midi::Track& track : data.tracks) {
+            renderOptions.stems.emplace_back(track.channels.begin(), track.channels.end());
+            stemWriters.push_back(makeStemWriter());
+            encoders.push_back(stemWriters.back().get());
+        }
+    }
+
+    IF_ASSERT_FAILED(destinationDevices.size() == encoders.size()) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    Ret encodeRet = make_ret(Ret::Code::Ok);
+    size_t begunEncoders = 0;
+
+    auto loadChunk = [playback](midi::tick_t fromTick) {
+        return playback->exportMidiChunk(fromTick);
+    };
+
+    auto onBlock = [&](const IOfflineAudioRenderer::Block& block) {
+        if (m_aborted) {
+            return false;
+        }
+
+        while (begunEncoders < encoders.size()) {
+            size_t i = begunEncoders++;
+            encodeRet = encoders[i]->beginEncoding(*destinationDevices[i], renderOptions.sampleRate, block.totalSamples);
+            if (!encodeRet) {
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < encoders.size(); ++i) {
+            const float* blockData = i == 0 ? block.data : block.stems[i - 1];
+            encodeRet = encoders[i]->encodeBlock(*destinationDevices[i], blockData, block.samples);
+            if (!encodeRet) {
+                return false;
+            }
+        }
+
+        sendProgress(block.renderedSamples, block.totalSamples);
+        return true;
+    };
+
+    m_lastProgressPercent = -1;
+    Ret ret = offlineRenderer()->render(data, playback->exportLastTick(), loadChunk, onBlock, renderOptions);
+
+    //! NOTE The encoders are finished even on failure, so they release their state
+    Ret endRet = make_ret(Ret::Code::Ok);
+    for (size_t i = 0; i < begunEncoders; ++i) {
+        Ret r = encoders[i]->endEncoding(*destinationDevices[i]);
+        if (!r && endRet) {
+            endRet = r;
+        }
+    }
+
+    if (!encodeRet) {
+        LOGE() << "failed encode audio, err: " << encodeRet.toString();
+        return encodeRet;
+    }
+
+    if (!ret) {
+        return ret;
+    }
+
+    return endRet;
+}
+
+mu::Ret AbstractAudioWriter::setMeasureRange(const INotationPtr notation, const Options& options,
+                                             IOfflineAudioRenderer::Options& renderOptions) const
+{
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    const int FIRST_MEASURE_INDEX = options.value(OptionKey::FIRST_MEASURE_INDEX, Val(0)).toInt();
+    const int LAST_MEASURE_INDEX = options.value(OptionKey::LAST_MEASURE_INDEX, Val(score->nmeasures() - 1)).toInt();
+    Ms::Measure* first = score->crMeasure(FIRST_MEASURE_INDEX);
+    Ms::Measure* last = score->crMeasure(LAST_MEASURE_INDEX);
+    if (!first || !last || first->tick() > last->tick()) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const Ms::RepeatList& repeats = score->repeatList();
+    renderOptions.fromTick = repeats.tick2utick(first->tick().ticks());
+
+    //! NOTE The tail is rendered once, after the last part, the next part renders the notes
+    //! still sounding at its beginning in its pre-roll
+    if (Ms::Measure* next = last->nextMeasure()) {
+        renderOptions.toTick = repeats.tick2utick(next->tick().ticks());
+        renderOptions.tailMsec = 0;
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void AbstractAudioWriter::sendProgress(uint64_t current, uint64_t total)
+{
+    if (total == 0) {
+        return;
+    }
+
+    //! NOTE Blocks are small, so progress is sent only when the percent changes
+    int percent = static_cast<int>(current * 100 / total);
+    if (percent == m_lastProgressPercent) {
+        return;
+    }
+
+    m_lastProgressPercent = percent;
+    m_progress.send(framework::Progress(static_cast<int64_t>(current), static_cast<int64_t>(total)));
+}
+
+void AbstractAudioWriter::abort()
+{
+    m_aborted = true;
+}
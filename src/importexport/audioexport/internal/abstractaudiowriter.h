@@ -0,0 +1,66 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+#define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "notation/abstractnotationwriter.h"
+#include "modularity/ioc.h"
+#include "audio/iofflineaudiorenderer.h"
+
+namespace mu::iex::audioexport {
+//! NOTE Renders the score offline block by block and passes each block to the encoder,
+//! so nothing but the current block is kept in memory
+class AbstractAudioWriter : public notation::AbstractNotationWriter
+{
+    INJECT(iex_audioexport, audio::IOfflineAudioRenderer, offlineRenderer)
+
+public:
+    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writeStems(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
+    void abort() override;
+
+protected:
+    //! NOTE Called before the first block, the total length is already known at this point.
+    //! If it was called, endEncoding is called too, also when rendering fails
+    virtual Ret beginEncoding(system::IODevice& device, unsigned int sampleRate, uint64_t totalSamples) = 0;
+    virtual Ret encodeBlock(system::IODevice& device, const float* data, unsigned int samples) = 0;
+    virtual Ret endEncoding(system::IODevice& device) = 0;
+
+    //! NOTE The encoder state is per writer, so each stem is encoded by a writer of its own
+    virtual std::shared_ptr<AbstractAudioWriter> makeStemWriter() const = 0;
+
+private:
+    Ret doWrite(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                const Options& options, bool isStems);
+    Ret setMeasureRange(const notation::INotationPtr notation, const Options& options,
+                        audio::IOfflineAudioRenderer::Options& renderOptions) const;
+    void sendProgress(uint64_t current, uint64_t total);
+
+    std::atomic<bool> m_aborted = { false };
+    int m_lastProgressPercent = -1;
+};
+}
+
+#endif // MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
@@ -19,18 +19,16 @@
 
 #include "flacwriter.h"
 
-#include "log.h"
+#include <sndfile.h>
 
 using namespace mu::iex::audioexport;
-using namespace mu::system;
 
-mu::Ret FlacWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+int FlacWriter::format() const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
+    return SF_FORMAT_FLAC | SF_FORMAT_PCM_16;
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+std::shared_ptr<AbstractAudioWriter> FlacWriter::makeStemWriter() const
+{
+    return std::make_shared<FlacWriter>();
 }
@@ -20,13 +20,14 @@
 #ifndef MU_IMPORTEXPORT_FLACWRITER_H
 #define MU_IMPORTEXPORT_FLACWRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "sndfilewriter.h"
 
 namespace mu::iex::audioexport {
-class FlacWriter : public notation::AbstractNotationWriter
+class FlacWriter : public SndFileWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    int format() const override;
+    std::shared_ptr<AbstractAudioWriter> makeStemWriter() const override;
 };
 }
 
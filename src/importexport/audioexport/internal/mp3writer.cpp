@@ -19,18 +19,25 @@
 
 #include "mp3writer.h"
 
-#include "log.h"
+#include <sndfile.h>
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret Mp3Writer::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+//! NOTE SF_FORMAT_MPEG and SF_FORMAT_MPEG_LAYER_III, added in libsndfile 1.1.0, older versions and builds without lame reject it in sf_format_check
+static constexpr int FORMAT_MPEG = 0x230000;
+static constexpr int FORMAT_MPEG_LAYER_III = 0x0082;
+
+int Mp3Writer::format() const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+    return FORMAT_MPEG | FORMAT_MPEG_LAYER_III;
+}
 
-    NOT_IMPLEMENTED;
+bool Mp3Writer::isEncodingInBackground() const
+{
+    return true;
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+std::shared_ptr<AbstractAudioWriter> Mp3Writer::makeStemWriter() const
+{
+    return std::make_shared<Mp3Writer>();
 }
@@ -20,13 +20,15 @@
 #ifndef MU_IMPORTEXPORT_MP3WRITER_H
 #define MU_IMPORTEXPORT_MP3WRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "sndfilewriter.h"
 
 namespace mu::iex::audioexport {
-class Mp3Writer : public notation::AbstractNotationWriter
+class Mp3Writer : public SndFileWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    int format() const override;
+    std::shared_ptr<AbstractAudioWriter> makeStemWriter() const override;
+    bool isEncodingInBackground() const override;
 };
 }
 
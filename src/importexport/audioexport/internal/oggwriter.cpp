@@ -19,18 +19,16 @@
 
 #include "oggwriter.h"
 
-#include "log.h"
+#include <sndfile.h>
 
 using namespace mu::iex::audioexport;
-using namespace mu::system;
 
-mu::Ret OggWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
+int OggWriter::format() const
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
-
-    NOT_IMPLEMENTED;
+    return SF_FORMAT_OGG | SF_FORMAT_VORBIS;
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+std::shared_ptr<AbstractAudioWriter> OggWriter::makeStemWriter() const
+{
+    return std::make_shared<OggWriter>();
 }
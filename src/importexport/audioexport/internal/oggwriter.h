@@ -20,13 +20,14 @@
 #ifndef MU_IMPORTEXPORT_OGGWRITER_H
 #define MU_IMPORTEXPORT_OGGWRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "sndfilewriter.h"
 
 namespace mu::iex::audioexport {
-class OggWriter : public notation::AbstractNotationWriter
+class OggWriter : public SndFileWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    int format() const override;
+    std::shared_ptr<AbstractAudioWriter> makeStemWriter() const override;
 };
 }
 
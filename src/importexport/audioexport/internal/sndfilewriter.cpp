@@ -0,0 +1,200 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "sndfilewriter.h"
+
+#include <cstdio>
+#include <sndfile.h>
+
+#include "log.h"
+#include "audio/synthtypes.h"
+
+using namespace mu::iex::audioexport;
+
+static constexpr size_t MAX_QUEUED_BLOCKS = 32;
+
+static QIODevice* toDevice(void* userData)
+{
+    return static_cast<QIODevice*>(userData);
+}
+
+static sf_count_t deviceLength(void* userData)
+{
+    return toDevice(userData)->size();
+}
+
+static sf_count_t deviceSeek(sf_count_t offset, int whence, void* userData)
+{
+    QIODevice* dev = toDevice(userData);
+    qint64 pos = offset;
+    if (whence == SEEK_CUR) {
+        pos += dev->pos();
+    } else if (whence == SEEK_END) {
+        pos += dev->size();
+    }
+
+    //! NOTE Sequential devices can't seek, encoders only do that to update headers
+    if (!dev->seek(pos)) {
+        return -1;
+    }
+
+    return pos;
+}
+
+static sf_count_t deviceRead(void* ptr, sf_count_t count, void* userData)
+{
+    return toDevice(userData)->read(static_cast<char*>(ptr), count);
+}
+
+static sf_count_t deviceWrite(const void* ptr, sf_count_t count, void* userData)
+{
+    return toDevice(userData)->write(static_cast<const char*>(ptr), count);
+}
+
+static sf_count_t deviceTell(void* userData)
+{
+    return toDevice(userData)->pos();
+}
+
+mu::Ret SndFileWriter::beginEncoding(system::IODevice& device, unsigned int sampleRate, uint64_t totalSamples)
+{
+    UNUSED(totalSamples)
+
+    SF_INFO info = {};
+    info.samplerate = static_cast<int>(sampleRate);
+    info.channels = audio::synth::AUDIO_CHANNELS;
+    info.format = format();
+
+    if (!sf_format_check(&info)) {
+        LOGE() << "format is not supported by libsndfile: " << info.format;
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    static SF_VIRTUAL_IO io = { deviceLength, deviceSeek, deviceRead, deviceWrite, deviceTell };
+
+    m_sndFile = sf_open_virtual(&io, SFM_WRITE, &info, &device);
+    if (!m_sndFile) {
+        LOGE() << "failed open encoder: " << sf_strerror(nullptr);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (isEncodingInBackground()) {
+        m_queue.clear();
+        m_isQueueClosed = false;
+        m_encoderRet = make_ret(Ret::Code::Ok);
+        m_encoder = std::thread(&SndFileWriter::encodeQueue, this);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret SndFileWriter::encodeBlock(system::IODevice&, const float* data, unsigned int samples)
+{
+    IF_ASSERT_FAILED(m_sndFile) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    if (!m_encoder.joinable()) {
+        return writeBlock(data, samples);
+    }
+
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_queueChanged.wait(lock, [this]() {
+        return m_queue.size() < MAX_QUEUED_BLOCKS || !m_encoderRet;
+    });
+
+    if (!m_encoderRet) {
+        return m_encoderRet;
+    }
+
+    m_queue.emplace_back(data, data + samples * audio::synth::AUDIO_CHANNELS);
+    m_queueChanged.notify_all();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void SndFileWriter::encodeQueue()
+{
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    for (;;) {
+        m_queueChanged.wait(lock, [this]() {
+            return !m_queue.empty() || m_isQueueClosed;
+        });
+
+        if (m_queue.empty()) {
+            return;
+        }
+
+        std::vector<float> block = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_queueChanged.notify_all();
+
+        lock.unlock();
+        Ret ret = writeBlock(block.data(), static_cast<unsigned int>(block.size() / audio::synth::AUDIO_CHANNELS));
+        lock.lock();
+
+        if (!ret) {
+            m_encoderRet = ret;
+            m_queue.clear();
+            m_queueChanged.notify_all();
+            return;
+        }
+    }
+}
+
+mu::Ret SndFileWriter::stopEncoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_isQueueClosed = true;
+    }
+    m_queueChanged.notify_all();
+    m_encoder.join();
+
+    return m_encoderRet;
+}
+
+mu::Ret SndFileWriter::writeBlock(const float* data, unsigned int samples)
+{
+    sf_count_t written = sf_writef_float(m_sndFile, data, samples);
+    if (written != static_cast<sf_count_t>(samples)) {
+        LOGE() << "failed encode block: " << sf_strerror(m_sndFile);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret SndFileWriter::endEncoding(system::IODevice&)
+{
+    if (!m_sndFile) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    Ret encoderRet = m_encoder.joinable() ? stopEncoder() : make_ret(Ret::Code::Ok);
+
+    int err = sf_close(m_sndFile);
+    m_sndFile = nullptr;
+    if (err != 0) {
+        LOGE() << "failed close encoder: " << sf_error_number(err);
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return encoderRet;
+}
@@ -0,0 +1,65 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_IMPORTEXPORT_SNDFILEWRITER_H
+#define MU_IMPORTEXPORT_SNDFILEWRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "abstractaudiowriter.h"
+
+struct SNDFILE_tag;
+
+namespace mu::iex::audioexport {
+//! NOTE Encodes through libsndfile virtual io, the encoder writes each block straight to the device
+class SndFileWriter : public AbstractAudioWriter
+{
+protected:
+    //! NOTE SF_FORMAT_* major and subtype
+    virtual int format() const = 0;
+
+    //! NOTE A slow encoder encodes on its own thread while the next blocks are rendered,
+    //! the blocks wait for it in a bounded queue
+    virtual bool isEncodingInBackground() const { return false; }
+
+    Ret beginEncoding(system::IODevice& device, unsigned int sampleRate, uint64_t totalSamples) override;
+    Ret encodeBlock(system::IODevice& device, const float* data, unsigned int samples) override;
+    Ret endEncoding(system::IODevice& device) override;
+
+private:
+    Ret writeBlock(const float* data, unsigned int samples);
+    void encodeQueue();
+    Ret stopEncoder();
+
+    SNDFILE_tag* m_sndFile = nullptr;
+
+    std::thread m_encoder;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueChanged;
+    std::deque<std::vector<float> > m_queue;
+    bool m_isQueueClosed = false;
+    Ret m_encoderRet;
+};
+}
+
+#endif // MU_IMPORTEXPORT_SNDFILEWRITER_H
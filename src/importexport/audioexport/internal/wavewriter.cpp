@@ -19,18 +19,82 @@
 
 #include "wavewriter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <QtEndian>
+
 #include "log.h"
+#include "audio/synthtypes.h"
 
 using namespace mu::iex::audioexport;
-using namespace mu::framework;
 
-mu::Ret WaveWriter::write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options)
+static constexpr uint16_t BITS_PER_SAMPLE = 16;
+static constexpr uint16_t BYTES_PER_SAMPLE = BITS_PER_SAMPLE / 8;
+static constexpr uint16_t CHANNELS = mu::audio::synth::AUDIO_CHANNELS;
+
+template<typename T>
+static char* putLE(char* p, T value)
+{
+    qToLittleEndian(value, p);
+    return p + sizeof(T);
+}
+
+mu::Ret WaveWriter::beginEncoding(system::IODevice& device, unsigned int sampleRate, uint64_t totalSamples)
+{
+    //! NOTE The length is known before rendering, so the header is final and the device may be sequential
+    uint32_t dataSize = static_cast<uint32_t>(std::min<uint64_t>(totalSamples * CHANNELS * BYTES_PER_SAMPLE, UINT32_MAX - 36));
+
+    char header[44];
+    char* p = header;
+    p = std::copy_n("RIFF", 4, p);
+    p = putLE<uint32_t>(p, 36 + dataSize);
+    p = std::copy_n("WAVE", 4, p);
+    p = std::copy_n("fmt ", 4, p);
+    p = putLE<uint32_t>(p, 16);
+    p = putLE<uint16_t>(p, 1); // PCM
+    p = putLE<uint16_t>(p, CHANNELS);
+    p = putLE<uint32_t>(p, sampleRate);
+    p = putLE<uint32_t>(p, sampleRate * CHANNELS * BYTES_PER_SAMPLE);
+    p = putLE<uint16_t>(p, CHANNELS * BYTES_PER_SAMPLE);
+    p = putLE<uint16_t>(p, BITS_PER_SAMPLE);
+    p = std::copy_n("data", 4, p);
+    putLE<uint32_t>(p, dataSize);
+
+    if (device.write(header, sizeof(header)) != sizeof(header)) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret WaveWriter::encodeBlock(system::IODevice& device, const float* data, unsigned int samples)
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
-    UNUSED(options)
+    size_t count = samples * CHANNELS;
+    m_buffer.resize(count * BYTES_PER_SAMPLE);
+
+    char* p = m_buffer.data();
+    for (size_t i = 0; i < count; ++i) {
+        float v = std::max(-1.f, std::min(1.f, data[i]));
+        p = putLE<int16_t>(p, static_cast<int16_t>(std::lrint(v * 32767.f)));
+    }
 
-    NOT_IMPLEMENTED;
+    qint64 size = static_cast<qint64>(m_buffer.size());
+    if (device.write(m_buffer.data(), size) != size) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
 
-    return make_ret(Ret::Code::NotImplemented);
+mu::Ret WaveWriter::endEncoding(system::IODevice&)
+{
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    return make_ret(Ret::Code::Ok);
+}
+
+std::shared_ptr<AbstractAudioWriter> WaveWriter::makeStemWriter() const
+{
+    return std::make_shared<WaveWriter>();
 }
@@ -20,13 +20,21 @@
 #ifndef MU_IMPORTEXPORT_WAVEWRITER_H
 #define MU_IMPORTEXPORT_WAVEWRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include <vector>
+
+#include "abstractaudiowriter.h"
 
 namespace mu::iex::audioexport {
-class WaveWriter : public notation::AbstractNotationWriter
+class WaveWriter : public AbstractAudioWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    Ret beginEncoding(system::IODevice& device, unsigned int sampleRate, uint64_t totalSamples) override;
+    Ret encodeBlock(system::IODevice& device, const float* data, unsigned int samples) override;
+    Ret endEncoding(system::IODevice& device) override;
+    std::shared_ptr<AbstractAudioWriter> makeStemWriter() const override;
+
+private:
+    std::vector<char> m_buffer;
 };
 }
 
@@ -450,8 +450,15 @@ public:
         textToBrailleASCII[QChar(0xE526)] = "n";
     }
 
-    QString braille(QChar c);
-    QString braille(QString text);
+    // the table is built once and shared by all exports
+    static const TextToUEBBraille& instance()
+    {
+        static const TextToUEBBraille textToBraille;
+        return textToBraille;
+    }
+
+    QString braille(QChar c) const;
+    QString braille(const QString& text) const;
 };
 
 // Braille export is implemented according to Music Braille Code 2015
@@ -537,6 +544,7 @@ public:
     }
 
     void write(QIODevice* dev);
+    void write(QIODevice* dev, MeasureBase* first, MeasureBase* last);
 };
 
 //---------------------------------------------------------
@@ -557,6 +565,22 @@ bool saveBraille(Score* score, QIODevice* device)
     return true;
 }
 
+//---------------------------------------------------------
+//   saveBraille
+//    the measures from first to last, without the credits
+//    and the instruments, e.g. for the selection
+//---------------------------------------------------------
+
+bool saveBraille(Score* score, QIODevice* device, Measure* first, Measure* last)
+{
+    if (!first || !last || first->tick() > last->tick()) {
+        return false;
+    }
+    ExportBraille eb(score);
+    eb.write(device, first, last);
+    return true;
+}
+
 bool saveBraille(Score* score, const QString& name)
 {
     QFile f(name);
@@ -592,7 +616,7 @@ void ExportBraille::credits(QIODevice* dev)
                     for (const Element* element : mb->el()) {
                         if (element->isText()) {
                             const Text* text = toText(element);
-                            out << TextToUEBBraille().braille(text->plainText()).toUtf8() << Qt::endl;
+                            out << TextToUEBBraille::instance().braille(text->plainText()).toUtf8() << Qt::endl;
                         }
                     }
                 }
@@ -606,11 +630,11 @@ void ExportBraille::credits(QIODevice* dev)
     for (QString type : creators) {
         QString creator = score->metaTag(type);
         if (!creator.isEmpty()) {
-            out << TextToUEBBraille().braille(QString("%1 %2").arg(type).arg(creator)).toUtf8() << Qt::endl;
+            out << TextToUEBBraille::instance().braille(QString("%1 %2").arg(type).arg(creator)).toUtf8() << Qt::endl;
         }
     }
     if (!score->metaTag("copyright").isEmpty()) {
-        out << TextToUEBBraille().braille(QString("© %2").arg(score->metaTag("copyright"))).toUtf8() << Qt::endl;
+        out << TextToUEBBraille::instance().braille(QString("© %2").arg(score->metaTag("copyright"))).toUtf8() << Qt::endl;
     }
     out << Qt::endl;
     out.flush();
@@ -621,7 +645,7 @@ void ExportBraille::instruments(QIODevice* dev)
     //Print staff number to instrument mapping.
     QTextStream out(dev);
     for (int i = 0; i < score->staves().size(); ++i) {
-        out << TextToUEBBraille().braille(QString("%1 %2").arg(i + 1).arg(score->staves()[i]->part()->instrumentName())) << Qt::endl;
+        out << TextToUEBBraille::instance().braille(QString("%1 %2").arg(i + 1).arg(score->staves()[i]->part()->instrumentName())) << Qt::endl;
     }
     out << Qt::endl;
     out.flush();
@@ -631,14 +655,30 @@ void ExportBraille::write(QIODevice* dev)
 {
     credits(dev);
     instruments(dev);
+    write(dev, score->measures()->first(), score->measures()->last());
+}
+
+//---------------------------------------------------------
+//   write
+//    the measures from first to last
+//---------------------------------------------------------
+
+void ExportBraille::write(QIODevice* dev, MeasureBase* first, MeasureBase* last)
+{
     int nrStaves = score->staves().size();
     std::vector<QString> measureBraille(nrStaves);
     std::vector<QString> line(nrStaves + 1);
+    for (QString& l : line) {
+        l.reserve(2 * MAX_CHARS_PER_LINE);
+    }
     int currentLineLenght = 0;
     int currentMeasureMaxLength = 0;
     bool measureAboveMax = false;
+    // a multimeasure rest may end after last
+    const Fraction endTick = last ? last->endTick() : score->endTick();
+    QTextStream out(dev);
 
-    for (MeasureBase* mb = score->measures()->first(); mb != nullptr; mb = mb->next()) {
+    for (MeasureBase* mb = first; mb && mb->tick() < endTick; mb = mb->next()) {
         if (!mb->isMeasure()) {
             continue;
         }
@@ -647,8 +687,7 @@ void ExportBraille::write(QIODevice* dev)
         // if we are at the beginning of the line
         // we write the measure number
         if (currentLineLenght == 0) {
-            TextToUEBBraille textToBraille;
-            QString measureNumber = textToBraille.braille(QString::number(m->no() + 1)).remove(0, 1) + " ";
+            QString measureNumber = TextToUEBBraille::instance().braille(QString::number(m->no() + 1)).remove(0, 1) + " ";
             int measureNumberLen = measureNumber.size();
             line[0] += measureNumber;
             for (int i = 1; i < nrStaves; i++) {
@@ -662,26 +701,21 @@ void ExportBraille::write(QIODevice* dev)
         }
 
         for (int i = 0; i < nrStaves; ++i) {
-            qDebug() << "Measure " << mb->no() + 1 << " Staff " << i;
-
-            measureBraille[i] = brailleMeasure(m, i).toUtf8();
+            measureBraille[i] = brailleMeasure(m, i);
 
             if (measureBraille[i].size() > currentMeasureMaxLength) {
                 currentMeasureMaxLength = measureBraille[i].size();
             }
         }
 
-        qDebug() << "Current measure max len: " << currentMeasureMaxLength;
         // TODO handle better the case when the size of the current measure
         // by itself is larger than the MAX_CHARS_PER_LINE. The measure will
         // have to be split on multiple lines based on specific rules
         if ((currentMeasureMaxLength + currentLineLenght > MAX_CHARS_PER_LINE) && !measureAboveMax) {
-            QTextStream out(dev);
             for (int i = 0; i < nrStaves; ++i) {
-                out << line[i].toUtf8() << Qt::endl;
-                line[i] = QString();
+                out << line[i] << '\n';
+                line[i].clear();
             }
-            out.flush();
             currentLineLenght = 0;
             // We need to re-render the current measure
             // as it will be on a new line.
@@ -698,14 +732,12 @@ void ExportBraille::write(QIODevice* dev)
         currentLineLenght += currentMeasureMaxLength;
         for (int i = 0; i < nrStaves; ++i) {
             line[i] += measureBraille[i].leftJustified(currentMeasureMaxLength);
-            measureBraille[i] = QString();
         }
 
         if (measureAboveMax || m->sectionBreak()) {
-            QTextStream out(dev);
             for (int i = 0; i < nrStaves; ++i) {
-                out << line[i].toUtf8() << Qt::endl;
-                line[i] = QString();
+                out << line[i] << '\n';
+                line[i].clear();
             }
             currentLineLenght = 0;
             // 3.2.1. Page 53. Music Braille Code 2015.
@@ -713,17 +745,14 @@ void ExportBraille::write(QIODevice* dev)
             resetOctaves();
             measureAboveMax = false;
             if (m->sectionBreak()) {
-                out << Qt::endl;
+                out << '\n';
             }
-            out.flush();
         }
     }
 
     // Write the last measures
-    QTextStream out(dev);
     for (int i = 0; i < nrStaves; ++i) {
-        out << line[i].toUtf8() << Qt::endl;
-        line[i] = QString();
+        out << line[i] << '\n';
     }
     out.flush();
 }
@@ -922,7 +951,7 @@ QString ExportBraille::brailleMMRest(MMRest* mmRest)
     }
 
     resetOctave(mmRest->staffIdx());
-    return TextToUEBBraille().braille(QString::number(mmRest->measure()->mmRestCount())) + BRAILLE_REST_MEASURE;
+    return TextToUEBBraille::instance().braille(QString::number(mmRest->measure()->mmRestCount())) + BRAILLE_REST_MEASURE;
 }
 
 QString ExportBraille::brailleRest(Rest* rest)
@@ -1748,7 +1777,7 @@ QString ExportBraille::brailleDynamic(Dynamic* dynamic)
 
     resetOctave(dynamic->staffIdx());
     // Table 22C. Page 19. Music Braille Code 2015
-    return ">" + TextToUEBBraille().braille(dynamic->plainText());
+    return ">" + TextToUEBBraille::instance().braille(dynamic->plainText());
 }
 
 QString ExportBraille::brailleTempoText(TempoText* tempoText, int staffIdx)
@@ -1778,13 +1807,13 @@ QString ExportBraille::brailleTempoText(TempoText* tempoText, int staffIdx)
             result += " ";
             return result;
         } else {
-            QString result = BRAILLE_MUSIC_PARENTHESES + dots1 + BRAILLE_EQUALS_METRONOME + TextToUEBBraille().braille(secondPart)
+            QString result = BRAILLE_MUSIC_PARENTHESES + dots1 + BRAILLE_EQUALS_METRONOME + TextToUEBBraille::instance().braille(secondPart)
                              + BRAILLE_MUSIC_PARENTHESES;
             result += " ";
             return result;
         }
     } else {
-        return ">" + TextToUEBBraille().braille(text.toLower()) + "'";
+        return ">" + TextToUEBBraille::instance().braille(text.toLower()) + "'";
     }
 }
 
@@ -1808,13 +1837,13 @@ QString ExportBraille::brailleKeySig(KeySig* keySig)
         //Section 6.5. Page 61. Music Braille Code 2015.
         //Table 6. Page 5. Music Braille Code 2015.
         switch (keySig->key()) {
-        case Key::C_B: brailleKeySig = QString(TextToUEBBraille().braille("7") + brailleAccidentalType(AccidentalType::FLAT));
+        case Key::C_B: brailleKeySig = QString(TextToUEBBraille::instance().braille("7") + brailleAccidentalType(AccidentalType::FLAT));
             break;
-        case Key::G_B: brailleKeySig = QString(TextToUEBBraille().braille("6") + brailleAccidentalType(AccidentalType::FLAT));
+        case Key::G_B: brailleKeySig = QString(TextToUEBBraille::instance().braille("6") + brailleAccidentalType(AccidentalType::FLAT));
             break;
-        case Key::D_B: brailleKeySig = QString(TextToUEBBraille().braille("5") + brailleAccidentalType(AccidentalType::FLAT));
+        case Key::D_B: brailleKeySig = QString(TextToUEBBraille::instance().braille("5") + brailleAccidentalType(AccidentalType::FLAT));
             break;
-        case Key::A_B: brailleKeySig = QString(TextToUEBBraille().braille("4") + brailleAccidentalType(AccidentalType::FLAT));
+        case Key::A_B: brailleKeySig = QString(TextToUEBBraille::instance().braille("4") + brailleAccidentalType(AccidentalType::FLAT));
             break;
         case Key::E_B: brailleKeySig = QString(brailleAccidentalType(AccidentalType::FLAT) + brailleAccidentalType(
                                                    AccidentalType::FLAT) + brailleAccidentalType(AccidentalType::FLAT));
@@ -1831,13 +1860,13 @@ QString ExportBraille::brailleKeySig(KeySig* keySig)
         case Key::A:   brailleKeySig = QString(brailleAccidentalType(AccidentalType::SHARP) + brailleAccidentalType(
                                                    AccidentalType::SHARP) + brailleAccidentalType(AccidentalType::SHARP));
             break;
-        case Key::E:   brailleKeySig = QString(TextToUEBBraille().braille("4") + brailleAccidentalType(AccidentalType::SHARP));
+        case Key::E:   brailleKeySig = QString(TextToUEBBraille::instance().braille("4") + brailleAccidentalType(AccidentalType::SHARP));
             break;
-        case Key::B:   brailleKeySig = QString(TextToUEBBraille().braille("5") + brailleAccidentalType(AccidentalType::SHARP));
+        case Key::B:   brailleKeySig = QString(TextToUEBBraille::instance().braille("5") + brailleAccidentalType(AccidentalType::SHARP));
             break;
-        case Key::F_S: brailleKeySig = QString(TextToUEBBraille().braille("6") + brailleAccidentalType(AccidentalType::SHARP));
+        case Key::F_S: brailleKeySig = QString(TextToUEBBraille::instance().braille("6") + brailleAccidentalType(AccidentalType::SHARP));
             break;
-        case Key::C_S: brailleKeySig = QString(TextToUEBBraille().braille("7") + brailleAccidentalType(AccidentalType::SHARP));
+        case Key::C_S: brailleKeySig = QString(TextToUEBBraille::instance().braille("7") + brailleAccidentalType(AccidentalType::SHARP));
             break;
         case Key::INVALID: return QString();
         case Key::NUM_OF:  return QString();     //TODO What is this?
@@ -2383,7 +2412,7 @@ QString ExportBraille::brailleHairpinBefore(ChordRest* chordRest, std::vector<Ha
             if (beginText.endsWith("'")) {
                 beginText = beginText.left(beginText.lastIndexOf("'"));
             }
-            beginTextBraille = QString(">") + TextToUEBBraille().braille(beginText);
+            beginTextBraille = QString(">") + TextToUEBBraille::instance().braille(beginText);
             resetOctave(hairpin->staffIdx());
         }
 
@@ -2494,7 +2523,7 @@ QString ExportBraille::brailleMarker(Marker* marker)
     case Marker::Type::TOCODASYM:
         return BRAILLE_TOCODA;
     case Marker::Type::USER:
-        return QString(">") + TextToUEBBraille().braille(marker->plainText().toLower()) + QString("> ");
+        return QString(">") + TextToUEBBraille::instance().braille(marker->plainText().toLower()) + QString("> ");
     }
     return QString();
 }
@@ -2515,33 +2544,34 @@ QString ExportBraille::brailleJump(Jump* jump)
     case Jump::Type::DS:
         return BRAILLE_DAL_SEGNO;
     case Jump::Type::USER:
-        return QString(">") + TextToUEBBraille().braille(jump->plainText().toLower()) + QString("> ");
+        return QString(">") + TextToUEBBraille::instance().braille(jump->plainText().toLower()) + QString("> ");
     }
     return QString();
 }
 
-QString TextToUEBBraille::braille(QChar c)
+QString TextToUEBBraille::braille(QChar c) const
 {
-    if (textToBrailleASCII[c] != nullptr) {
-        return QString(textToBrailleASCII[c]);
+    const auto it = textToBrailleASCII.constFind(c);
+    if (it != textToBrailleASCII.cend()) {
+        return it.value();
     }
     return QString(c);
 }
 
-QString TextToUEBBraille::braille(QString text)
+QString TextToUEBBraille::braille(const QString& text) const
 {
-    QString buffer, t, p;
-    QTextStream rez(&buffer), tmp(&t);
+    QString rez, t, p;
     QChar prev;
+    rez.reserve(2 * text.size());
 
     for (QChar c : text) {
         if (prev.isNumber() && c.isLetter()) {
-            rez << ASCII_END_OF_NUMBER;
+            rez += ASCII_END_OF_NUMBER;
         }
 
         if (prev.isLetter() && prev.isUpper() && (!c.isLetter() || (c.isLetter() && c.isLower()))) {
-            tmp.flush();
-            rez << p << t;
+            rez += p;
+            rez += t;
             t.clear();
             p.clear();
         }
@@ -2553,26 +2583,24 @@ QString TextToUEBBraille::braille(QString text)
                 } else {
                     p = ASCII_PREFIX_CAPITAL_LETTER;
                 }
-                tmp << braille(c);
+                t += braille(c);
             } else {
-                rez << braille(c);
+                rez += braille(c);
             }
         } else if (c.isNumber()) {
             if (!prev.isNumber()) {
-                rez << ASCII_PREFIX_NUMBER;
+                rez += ASCII_PREFIX_NUMBER;
             }
-            rez << braille(c);
+            rez += braille(c);
         } else {
-            rez << braille(c);
+            rez += braille(c);
         }
         prev = c;
     }
 
-    tmp.flush();
-    rez << p << t;
-    t.clear();
-    p.clear();
+    rez += p;
+    rez += t;
 
-    return rez.readAll();
+    return rez;
 }
 }
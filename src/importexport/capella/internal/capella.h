@@ -769,14 +769,14 @@ public:
 private:
     void readCapxVoice(XmlReader& e, CapStaff*, int);
     void readCapxStaff(XmlReader& e, CapSystem*);
-    void readCapxSystem(XmlReader& e);
-    void capxSystems(XmlReader& e);
+    CapSystem* readCapxSystem(XmlReader& e);
+    void capxSystems(XmlReader& e, const QString& document);
     void readCapxStaveLayout(XmlReader& e, CapStaffLayout*, int);
     void capxLayoutStaves(XmlReader& e);
     void capxLayout(XmlReader& e);
     void initCapxLayout();
 public:
-    void readCapx(XmlReader& e);
+    void readCapx(XmlReader& e, const QString& document);
     QList<BasicDrawObj*> readCapxDrawObjectArray(XmlReader& e);
 };
 } // namespace Ms
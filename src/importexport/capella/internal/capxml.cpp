@@ -26,6 +26,8 @@
 #include <assert.h>
 #include <cmath>
 
+#include <QtConcurrent>
+
 #include "libmscore/score.h"
 #include "thirdparty/qzip/qzipreader_p.h"
 #include "capella.h"
@@ -893,7 +895,7 @@ static void initUnreadStaves(QList<CapStaff*>& staves)
 //   readCapxSystem -- capx equivalent of readSystem()
 //---------------------------------------------------------
 
-void Capella::readCapxSystem(XmlReader& e)
+CapSystem* Capella::readCapxSystem(XmlReader& e)
 {
     CapSystem* s = new CapSystem;
     s->nAddBarCount   = 0;
@@ -936,23 +938,43 @@ void Capella::readCapxSystem(XmlReader& e)
     // initializes staves not read
     initUnreadStaves(s->staves);
 
-    systems.append(s);
+    return s;
 }
 
 //---------------------------------------------------------
 //   capxSystems -- read the capx <systems> element
+//    the systems do not depend on each other: e only finds
+//    where they are in document, the text e reads, and they
+//    are read concurrently, each one by its own reader
 //---------------------------------------------------------
 
-void Capella::capxSystems(XmlReader& e)
+void Capella::capxSystems(XmlReader& e, const QString& document)
 {
+    std::vector<std::pair<QString, CapSystem*> > systemsXml;
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
         if (tag == "system") {
-            readCapxSystem(e);
+            const qint64 begin = e.characterOffset();       // after the start tag
+            e.skipCurrentElement();
+            const qint64 end = e.characterOffset();         // after the end tag
+            if (begin == end) {
+                systemsXml.push_back({ QString("<system/>"), nullptr });
+            } else {
+                systemsXml.push_back({ QString("<system>") + document.midRef(begin, end - begin), nullptr });
+            }
         } else {
             e.unknown();
         }
     }
+
+    QtConcurrent::blockingMap(systemsXml, [this](std::pair<QString, CapSystem*>& system) {
+        XmlReader se(system.first);
+        se.readNextStartElement();
+        system.second = readCapxSystem(se);
+    });
+    for (const auto& system : systemsXml) {
+        systems.append(system.second);
+    }
 }
 
 //---------------------------------------------------------
@@ -1210,7 +1232,7 @@ void Capella::initCapxLayout()
 //   readCapx -- capx equivalent of read(QFile* fp)
 //---------------------------------------------------------
 
-void Capella::readCapx(XmlReader& e)
+void Capella::readCapx(XmlReader& e, const QString& document)
 {
     // initialize same variables as read(QFile* fp)
 
@@ -1272,7 +1294,7 @@ void Capella::readCapx(XmlReader& e)
             qDebug("importCapXml: found barCount (skipping)");
             e.skipCurrentElement();
         } else if (tag == "systems") {
-            capxSystems(e);
+            capxSystems(e, document);
         } else {
             e.unknown();
         }
@@ -1294,8 +1316,9 @@ Score::FileError importCapXml(MasterScore* score, const QString& name)
         return Score::FileError::FILE_NOT_FOUND;
     }
 
-    QByteArray dbuf = uz.fileData("score.xml");
-    XmlReader e(dbuf);
+    // read from the decoded document, in which the systems are found by their offsets
+    const QString document = QString::fromUtf8(uz.fileData("score.xml"));
+    XmlReader e(document);
     e.setDocName(name);
     Capella cf;
 
@@ -1303,7 +1326,7 @@ Score::FileError importCapXml(MasterScore* score, const QString& name)
         if (e.name() == "score") {
             const QString& xmlns = e.attribute("xmlns", "<none>");       // doesn't work ???
             qDebug("importCapXml: found score, namespace '%s'", qPrintable(xmlns));
-            cf.readCapx(e);
+            cf.readCapx(e, document);
         } else {
             e.unknown();
         }
@@ -620,7 +620,7 @@ int GuitarPro4::convertGP4SlideNum(int sl)
 
 bool GuitarPro4::read(QFile* fp)
 {
-    f      = fp;
+    setFile(fp);
     curPos = 30;
 
     readInfo();
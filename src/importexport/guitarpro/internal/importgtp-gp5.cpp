@@ -198,7 +198,7 @@ Fraction GuitarPro5::readBeat(const Fraction& tick, int voice, Measure* measure,
             /*auto len =*/
             readUChar();
             char c[21];
-            f->read(c, 21);
+            read(c, 21);
             // if (len > 20)
             //      skip(len - 20);
             //skip(len - 20);
@@ -792,7 +792,7 @@ void GuitarPro5::readMeasures(int /*startingTempo*/)
 
 bool GuitarPro5::read(QFile* fp)
 {
-    f = fp;
+    setFile(fp);
 
     readInfo();
     readLyrics();
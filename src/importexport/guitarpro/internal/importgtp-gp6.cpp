@@ -2656,8 +2656,10 @@ void GuitarPro6::readGPX(QByteArray* buffer)
     if (fileHeader == GPX_HEADER_COMPRESSED) {
         // this is  a compressed file.
         int length             = readInteger(buffer, position / BITS_IN_BYTE);
+        // the decompressed bytes are only appended, a back reference
+        // copies bytes which are already there
         QByteArray* bcfsBuffer = new QByteArray();
-        int positionCounter    = 0;
+        bcfsBuffer->reserve(length);
         while (!f->error() && (position / BITS_IN_BYTE) < length) {
             // read the bit indicating compression information
             int flag = readBits(buffer, 1);
@@ -2667,17 +2669,14 @@ void GuitarPro6::readGPX(QByteArray* buffer)
                 int offs = readBitsReversed(buffer, bits);
                 int size = readBitsReversed(buffer, bits);
 
-                QByteArray bcfsBufferCopy = *bcfsBuffer;
-                int pos                   = (bcfsBufferCopy.length() - offs);
+                int pos = (bcfsBuffer->length() - offs);
                 for (int i = 0; i < (size > offs ? offs : size); i++) {
-                    bcfsBuffer->insert(positionCounter, bcfsBufferCopy[pos + i]);
-                    positionCounter++;
+                    bcfsBuffer->append(bcfsBuffer->at(pos + i));
                 }
             } else {
                 int size = readBitsReversed(buffer, 2);
                 for (int i = 0; i < size; i++) {
-                    bcfsBuffer->insert(positionCounter, readBits(buffer, 8));
-                    positionCounter++;
+                    bcfsBuffer->append(char(readBits(buffer, 8)));
                 }
             }
         }
@@ -13,6 +13,7 @@
 #include "importgtp.h"
 
 #include <cmath>
+#include <cstring>
 #include <QTextCodec>
 #include <QDebug>
 
@@ -117,12 +118,29 @@ GuitarPro::~GuitarPro()
 //   skip
 //---------------------------------------------------------
 
+//---------------------------------------------------------
+//   setFile
+//    maps the file to memory, or reads it if it can't be
+//    mapped; reading continues at the current position
+//---------------------------------------------------------
+
+void GuitarPro::setFile(QFile* fp)
+{
+    f        = fp;
+    fileSize = fp->size();
+    filePos  = fp->pos();
+    fileData = fp->map(0, fileSize);
+    if (!fileData) {
+        fp->seek(0);
+        fileBuffer = fp->readAll();
+        fileData   = reinterpret_cast<const uchar*>(fileBuffer.constData());
+        fileSize   = fileBuffer.size();
+    }
+}
+
 void GuitarPro::skip(qint64 len)
 {
-    f->seek(f->pos() + len);
-    /*char c;
-    while (len--)
-          read(&c, 1);*/
+    filePos = qMin(filePos + len, fileSize);
 }
 
 //---------------------------------------------------------
@@ -155,10 +173,13 @@ void GuitarPro::read(void* p, qint64 len)
     if (len == 0) {
         return;
     }
-    qint64 rv = f->read((char*)p, len);
+    const qint64 rv = qBound(qint64(0), fileSize - filePos, len);
+    memcpy(p, fileData + filePos, rv);
     if (rv != len) {
         Q_ASSERT(rv == len);     //to have assert in debug and no warnings from AppVeyor in release
+        memset(static_cast<char*>(p) + rv, 0, len - rv);
     }
+    filePos += rv;
     curPos += len;
 }
 
@@ -168,9 +189,12 @@ void GuitarPro::read(void* p, qint64 len)
 
 int GuitarPro::readChar()
 {
-    signed char c;
-    read(&c, 1);
-    return c;
+    if (filePos >= fileSize) {
+        Q_ASSERT(filePos < fileSize);
+        return 0;
+    }
+    ++curPos;
+    return static_cast<signed char>(fileData[filePos++]);
 }
 
 //---------------------------------------------------------
@@ -179,9 +203,12 @@ int GuitarPro::readChar()
 
 int GuitarPro::readUChar()
 {
-    uchar c;
-    read(&c, 1);
-    return c;
+    if (filePos >= fileSize) {
+        Q_ASSERT(filePos < fileSize);
+        return 0;
+    }
+    ++curPos;
+    return fileData[filePos++];
 }
 
 //---------------------------------------------------------
@@ -274,16 +301,9 @@ QString GuitarPro::readDelphiString()
 
 int GuitarPro::readInt()
 {
-    uchar x;
-    read(&x, 1);
-    int r = x;
-    read(&x, 1);
-    r += x << 8;
-    read(&x, 1);
-    r += x << 16;
-    read(&x, 1);
-    r += x << 24;
-    return r;
+    uchar x[4];
+    read(x, 4);
+    return int(quint32(x[0]) | quint32(x[1]) << 8 | quint32(x[2]) << 16 | quint32(x[3]) << 24);
 }
 
 //---------------------------------------------------------
@@ -1101,7 +1121,7 @@ void GuitarPro::applyBeatEffects(Chord* chord, int beatEffect)
 
 bool GuitarPro1::read(QFile* fp)
 {
-    f      = fp;
+    setFile(fp);
     curPos = 30;
 
     title  = readDelphiString();
@@ -1481,7 +1501,7 @@ void GuitarPro::createOttava(bool hasOttava, int track, ChordRest* cr, QString v
 
 bool GuitarPro2::read(QFile* fp)
 {
-    f      = fp;
+    setFile(fp);
     curPos = 30;
 
     title        = readDelphiString();
@@ -2157,7 +2177,7 @@ int GuitarPro1::readBeatEffects(int, Segment*)
 
 bool GuitarPro3::read(QFile* fp)
 {
-    f      = fp;
+    setFile(fp);
     curPos = 30;
 
     title        = readDelphiString();
@@ -207,6 +207,12 @@ protected:
     MasterScore* score;
     QFile* f;
     int curPos;
+    // the file is read through memory, mapped or in fileBuffer;
+    // fileData + filePos is the next unread byte
+    const uchar* fileData { nullptr };
+    qint64 fileSize       { 0 };
+    qint64 filePos        { 0 };
+    QByteArray fileBuffer;
     int previousTempo;
     int previousDynamic;
     std::vector<int> ottavaFound;
@@ -221,6 +227,7 @@ protected:
     QTextCodec* _codec { 0 };
     Slur** slurs       { nullptr };
 
+    void setFile(QFile* fp);
     void skip(qint64 len);
     void read(void* p, qint64 len);
     int readUChar();
@@ -38,6 +38,9 @@ public:
     virtual float exportPngDpiResolution() const = 0;
     virtual bool exportPngWithTransparentBackground() const = 0;
 
+    // Svg
+    virtual bool exportSvgWithReusedGlyphs() const = 0;
+
     //! NOTE Maybe set from command line
     virtual void setExportPngDpiResolution(std::optional<float> dpi) = 0;
 };
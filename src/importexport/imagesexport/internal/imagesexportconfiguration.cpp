@@ -28,12 +28,14 @@ using namespace mu::iex::imagesexport;
 static const Settings::Key EXPORT_PDF_DPI_RESOLUTION_KEY("iex_imagesexport", "export/pdf/dpi");
 static const Settings::Key EXPORT_PNG_DPI_RESOLUTION_KEY("iex_imagesexport", "export/png/resolution");
 static const Settings::Key EXPORT_PNG_USE_TRASNPARENCY_KEY("iex_imagesexport", "export/png/useTransparency");
+static const Settings::Key EXPORT_SVG_REUSE_GLYPHS_KEY("iex_imagesexport", "export/svg/reuseGlyphs");
 
 void ImagesExportConfiguration::init()
 {
     settings()->setDefaultValue(EXPORT_PNG_DPI_RESOLUTION_KEY, Val(Ms::DPI));
     settings()->setDefaultValue(EXPORT_PNG_USE_TRASNPARENCY_KEY, Val(true));
     settings()->setDefaultValue(EXPORT_PDF_DPI_RESOLUTION_KEY, Val(Ms::DPI));
+    settings()->setDefaultValue(EXPORT_SVG_REUSE_GLYPHS_KEY, Val(false));
 }
 
 int ImagesExportConfiguration::exportPdfDpiResolution() const
@@ -59,3 +61,8 @@ bool ImagesExportConfiguration::exportPngWithTransparentBackground() const
 {
     return settings()->value(EXPORT_PNG_USE_TRASNPARENCY_KEY).toBool();
 }
+
+bool ImagesExportConfiguration::exportSvgWithReusedGlyphs() const
+{
+    return settings()->value(EXPORT_SVG_REUSE_GLYPHS_KEY).toBool();
+}
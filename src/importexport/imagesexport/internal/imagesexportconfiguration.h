@@ -34,6 +34,8 @@ public:
 
     bool exportPngWithTransparentBackground() const override;
 
+    bool exportSvgWithReusedGlyphs() const override;
+
 private:
 
     std::optional<float> m_customExportPngDpi;
@@ -24,13 +24,14 @@
 #include "libmscore/score.h"
 #include "libmscore/draw/qpainterprovider.h"
 
+#include <QFileDevice>
 #include <QPdfWriter>
 
 using namespace mu::iex::imagesexport;
 using namespace mu::system;
 using namespace Ms;
 
-mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options&)
+mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
 {
     IF_ASSERT_FAILED(notation) {
         return make_ret(Ret::Code::UnknownError);
@@ -40,6 +41,12 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
+    const int FIRST_PAGE_NUMBER = options.value(OptionKey::FIRST_PAGE_NUMBER, Val(0)).toInt();
+    const int LAST_PAGE_NUMBER = options.value(OptionKey::LAST_PAGE_NUMBER, Val(score->npages() - 1)).toInt();
+    if (FIRST_PAGE_NUMBER < 0 || LAST_PAGE_NUMBER >= score->npages() || FIRST_PAGE_NUMBER > LAST_PAGE_NUMBER) {
+        return false;
+    }
+
     score->setPrinting(true);
     MScore::pdfPrinting = true;
 
@@ -63,12 +70,18 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
     double pixelRationBackup = MScore::pixelRatio;
     MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
 
-    for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
-        if (pageNumber > 0) {
+    for (int pageNumber = FIRST_PAGE_NUMBER; pageNumber <= LAST_PAGE_NUMBER; ++pageNumber) {
+        if (pageNumber > FIRST_PAGE_NUMBER) {
             pdfWriter.newPage();
         }
 
         score->print(&painter, pageNumber);
+
+        //! NOTE QPdfWriter writes the content of a page when the next one begins,
+        //! don't keep the pages written so far in the buffers of the device
+        if (QFileDevice* file = qobject_cast<QFileDevice*>(&destinationDevice)) {
+            file->flush();
+        }
     }
 
     painter.end();
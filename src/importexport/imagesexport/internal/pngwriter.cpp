@@ -28,7 +28,9 @@
 
 #include "libmscore/draw/qpainterprovider.h"
 
+#include <QBuffer>
 #include <QImage>
+#include <QtConcurrent>
 
 using namespace mu::iex::imagesexport;
 using namespace mu::system;
@@ -43,19 +45,80 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
+    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    const QList<Ms::Page*>& pages = score->pages();
+
+    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+        return false;
+    }
+
     score->setPrinting(true); // don’t print page break symbols etc.
 
     double pixelRatioBackup = Ms::MScore::pixelRatio;
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    Ms::MScore::pixelRatio = Ms::DPI / CANVAS_DPI;
 
-    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    const QList<Ms::Page*>& pages = score->pages();
+    QImage image = renderPage(pages[PAGE_NUMBER], CANVAS_DPI, options);
+    image.save(&destinationDevice, "png");
 
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+    score->setPrinting(false);
+    Ms::MScore::pixelRatio = pixelRatioBackup;
+
+    return true;
+}
+
+mu::Ret PngWriter::writePages(const notation::INotationPtr notation, const std::vector<IODevice*>& destinationDevices,
+                              const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const int FIRST_PAGE_NUMBER = options.value(OptionKey::FIRST_PAGE_NUMBER, Val(0)).toInt();
+    const QList<Ms::Page*>& pages = score->pages();
+    if (FIRST_PAGE_NUMBER < 0 || FIRST_PAGE_NUMBER + int(destinationDevices.size()) > pages.size()) {
         return false;
     }
 
-    Ms::Page* page = pages[PAGE_NUMBER];
+    score->setPrinting(true);
+
+    double pixelRatioBackup = Ms::MScore::pixelRatio;
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    Ms::MScore::pixelRatio = Ms::DPI / CANVAS_DPI;
+
+    //! NOTE Once laid out, the pages are only read while they are drawn,
+    //! so they are rendered and compressed on the thread pool, each into its own image.
+    //! The devices are written here, in page order, as the pages get ready.
+    std::vector<QFuture<QByteArray> > encodedPages;
+    for (size_t i = 0; i < destinationDevices.size(); ++i) {
+        Ms::Page* page = pages[FIRST_PAGE_NUMBER + int(i)];
+        encodedPages.push_back(QtConcurrent::run([page, CANVAS_DPI, options]() {
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::WriteOnly);
+            renderPage(page, CANVAS_DPI, options).save(&buffer, "png");
+            return data;
+        }));
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < encodedPages.size(); ++i) {
+        const QByteArray data = encodedPages[i].result();
+        ok = ok && !data.isEmpty() && destinationDevices[i]->write(data) == data.size();
+    }
 
+    score->setPrinting(false);
+    Ms::MScore::pixelRatio = pixelRatioBackup;
+
+    return ok;
+}
+
+QImage PngWriter::renderPage(Ms::Page* page, float canvasDpi, const Options& options)
+{
     const int TRIM_MARGIN_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
     QRectF pageRect = page->abbox();
 
@@ -64,19 +127,17 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         pageRect = page->tbbox() + margins;
     }
 
-    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
-    int width = std::lrint(pageRect.width() * CANVAS_DPI / Ms::DPI);
-    int height = std::lrint(pageRect.height() * CANVAS_DPI / Ms::DPI);
+    int width = std::lrint(pageRect.width() * canvasDpi / Ms::DPI);
+    int height = std::lrint(pageRect.height() * canvasDpi / Ms::DPI);
 
     QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
-    image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+    image.setDotsPerMeterX(std::lrint((canvasDpi * 1000) / Ms::INCH));
+    image.setDotsPerMeterY(std::lrint((canvasDpi * 1000) / Ms::INCH));
 
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
     image.fill(TRANSPARENT_BACKGROUND ? 0 : Qt::white);
 
-    double scaling = CANVAS_DPI / Ms::DPI;
-    Ms::MScore::pixelRatio = 1.0 / scaling;
+    double scaling = canvasDpi / Ms::DPI;
 
     mu::draw::Painter painter(mu::draw::QPainterProvider::make(&image));
     painter.setAntialiasing(true);
@@ -85,14 +146,10 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         painter.translate(-pageRect.topLeft());
     }
 
-    QList<Ms::Element*> elements = page->elements();
-    std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
+    QList<Ms::Element*> elements = page->sortedElements();
 
     Ms::paintElements(painter, elements);
-    image.save(&destinationDevice, "png");
+    painter.end();
 
-    score->setPrinting(false);
-    Ms::MScore::pixelRatio = pixelRatioBackup;
-
-    return true;
+    return image;
 }
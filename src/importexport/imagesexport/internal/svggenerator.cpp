@@ -42,6 +42,7 @@
 #include <QTextStream>
 #include <QBuffer>
 #include <QTextCodec>
+#include <QHash>
 #include <QPainterPath>
 #include <QMimeType>
 #include <QMimeDatabase>
@@ -193,6 +194,11 @@ public:
 //    QString defs; // NEEDED FOR GRADIENTS
     QString body;
 
+    // Text items drawn once in <defs> and referenced by <use>, see drawTextItem()
+    bool reuseGlyphs { false };
+    QString glyphDefs;
+    QHash<QString, int> glyphIds;
+
     QBrush brush;
     QPen pen;
     QMatrix matrix;
@@ -241,6 +247,7 @@ class SvgPaintEngine : public QPaintEngine
 private:
     QString stateString;
     QTextStream stateStream;
+    QString textStateString;      // for glyphs, filled with the pen color
     SvgPaintEnginePrivate* d_ptr;
 
 // Qt translates everything. These help avoid SVG transform="translate()".
@@ -297,6 +304,10 @@ protected:
 
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
+#define SVG_USE         "<use"
+#define SVG_ID          " id=\""
+#define SVG_HREF        " xlink:href=\"#"
+#define SVG_GLYPH_ID    'g'
 #define SVG_POLYLINE    "<polyline"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
@@ -337,6 +348,7 @@ public:
     void popGroup();
 
     void drawPath(const QPainterPath& path);
+    void drawTextItem(const QPointF& p, const QTextItem& textItem);
     void drawPixmap(const QRectF& r, const QPixmap& pm, const QRectF& sr);
     void drawPolygon(const QPoint* points, int pointCount, PolygonDrawMode mode) { QPaintEngine::drawPolygon(points,pointCount,mode); }
     void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode);
@@ -377,6 +389,13 @@ public:
         d_func()->outputDevice = device;
     }
 
+    bool reuseGlyphs() const { return d_func()->reuseGlyphs; }
+    void setReuseGlyphs(bool reuse)
+    {
+        Q_ASSERT(!isActive());
+        d_func()->reuseGlyphs = reuse;
+    }
+
     int resolution() { return d_func()->resolution; }
     void setResolution(int resolution)
     {
@@ -968,6 +987,31 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::reuseGlyphs
+    \brief whether text items are written once and then referenced
+
+    When set, the outline of each distinct text item is written once
+    in the <defs> of the SVG document, and every item drawn is a <use>
+    referencing it. Scores repeat the same few music symbols thousands
+    of times, so this makes the documents much smaller.
+*/
+bool SvgGenerator::reuseGlyphs() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->reuseGlyphs();
+}
+
+void SvgGenerator::setReuseGlyphs(bool reuse)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setReuseGlyphs(), cannot set while SVG is being generated");
+        return;
+    }
+    d->engine->setReuseGlyphs(reuse);
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -1100,6 +1144,9 @@ bool SvgPaintEngine::end()
     // Stream our strings out to the device, in order
     stream() << d->header;
 //    stream() << d->defs;
+    if (!d->glyphDefs.isEmpty()) {
+        stream() << "<defs>" << Qt::endl << d->glyphDefs << "</defs>" << Qt::endl;
+    }
     stream() << d->body;
     stream() << SVG_END << Qt::endl;
 
@@ -1173,10 +1220,14 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
 
     // SVG class attribute, based on Ms::ElementType
     stateStream << SVG_CLASS << getClass(_element) << SVG_QUOTE;
+    stateStream.flush();
+    const int classLength = stateString.size();
 
     // Brush and Pen attributes
     stateStream << qbrushToSvg(s.brush());
     stateStream << qpenToSvg(s.pen());
+    stateStream.flush();
+    const int paintLength = stateString.size() - classLength;
 
 // TBD:  "opacity" attribute: Is it ever used?
 //       Or is opacity determined by fill-opacity & stroke-opacity instead?
@@ -1214,6 +1265,16 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
                     << t.m31() << SVG_COMMA
                     << t.m32() << SVG_RPAREN_QUOTE;
     }
+    stateStream.flush();
+
+    // Text is filled with the pen color, as QPaintEngine::drawTextItem() does
+    QString color, colorOpacity;
+    translate_color(s.pen().color(), &color, &colorOpacity);
+    textStateString = stateString.left(classLength) + SVG_FILL + color + SVG_QUOTE;
+    if (colorOpacity != SVG_ONE) {
+        textStateString += SVG_FILL_OPACITY + colorOpacity + SVG_QUOTE;
+    }
+    textStateString += stateString.mid(classLength + paintLength);
 }
 
 void SvgPaintEngine::drawPath(const QPainterPath& p)
@@ -1264,6 +1325,63 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
     stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
 }
 
+//---------------------------------------------------------
+//   drawTextItem
+//    With reuseGlyphs, the outline of each distinct text
+//    item, mostly single music symbols, is written once in
+//    <defs>, and each occurrence is a <use> of it, with
+//    its position rounded to what DPI 72 can show.
+//---------------------------------------------------------
+
+void SvgPaintEngine::drawTextItem(const QPointF& p, const QTextItem& textItem)
+{
+    Q_D(SvgPaintEngine);
+    if (!d->reuseGlyphs) {
+        QPaintEngine::drawTextItem(p, textItem);
+        return;
+    }
+
+    const QFont font = textItem.font();
+    const QString key = font.key() + QLatin1Char('\n') + textItem.text();
+    auto it = d->glyphIds.constFind(key);
+    if (it == d->glyphIds.constEnd()) {
+        QPainterPath path;
+        path.addText(QPointF(), font, textItem.text());
+        it = d->glyphIds.insert(key, d->glyphIds.size());
+
+        QTextStream defs(&d->glyphDefs);
+        defs << SVG_PATH << SVG_ID << SVG_GLYPH_ID << it.value() << SVG_QUOTE;
+        if (path.fillRule() == Qt::OddEvenFill) {
+            defs << SVG_FILL_RULE;
+        }
+        defs << SVG_D;
+        for (int i = 0; i < path.elementCount(); ++i) {
+            const QPainterPath::Element& e = path.elementAt(i);
+            switch (e.type) {
+            case QPainterPath::MoveToElement:
+                defs << SVG_MOVE;
+                break;
+            case QPainterPath::LineToElement:
+                defs << SVG_LINE;
+                break;
+            case QPainterPath::CurveToElement:
+                defs << SVG_CURVE;
+                break;
+            default:
+                defs << SVG_SPACE;
+                break;
+            }
+            defs << QString::number(e.x, 'f', 3) << SVG_COMMA << QString::number(e.y, 'f', 3);
+        }
+        defs << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+    }
+
+    stream() << SVG_USE << textStateString << SVG_HREF << SVG_GLYPH_ID << it.value() << SVG_QUOTE
+             << SVG_X << SVG_QUOTE << QString::number(p.x() + _dx, 'f', 2) << SVG_QUOTE
+             << SVG_Y << SVG_QUOTE << QString::number(p.y() + _dy, 'f', 2) << SVG_QUOTE
+             << SVG_ELEMENT_END << Qt::endl;
+}
+
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
                                  PolygonDrawMode mode)
 {
@@ -64,6 +64,7 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     QString title(score->title());
     printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
     printer.setOutputDevice(&destinationDevice);
+    printer.setReuseGlyphs(configuration()->exportSvgWithReusedGlyphs());
 
     const int TRIM_MARGINS_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
 
@@ -155,8 +156,7 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     }
 
     // 2nd pass: the rest of the elements
-    QList<Ms::Element*> elements = page->elements();
-    std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
+    QList<Ms::Element*> elements = page->sortedElements();
 
     int lastNoteIndex = -1;
     for (int i = 0; i < PAGE_NUMBER; ++i) {
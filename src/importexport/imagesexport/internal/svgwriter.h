@@ -22,9 +22,14 @@
 
 #include "notation/abstractnotationwriter.h"
 
+#include "../iimagesexportconfiguration.h"
+#include "modularity/ioc.h"
+
 namespace mu::iex::imagesexport {
 class SvgWriter : public notation::AbstractNotationWriter
 {
+    INJECT(iex_imagesexport, IImagesExportConfiguration, configuration)
+
 public:
     Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
 
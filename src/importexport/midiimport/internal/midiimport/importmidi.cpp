@@ -11,6 +11,7 @@
 //=============================================================================
 
 #include <QMessageBox>
+#include <QtConcurrent>
 
 #include "framework/midi_old/midifile.h"
 #include "libmscore/score.h"
@@ -211,58 +212,74 @@ void findAllTupletsForDrums(
     // note: temporary local tuplets and chords are deleted here
 }
 
+void quantizeTrack(MTrack& mtrack, const TimeSigMap* sigmap, const ReducedFraction& lastTick)
+{
+    auto& opers = midiImportOperations;
+    // pass current track index through MidiImportOperations
+    // for further usage
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+
+    const auto basicQuant = Quantize::quantValueToFraction(
+        opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
+               "quantizeAllTracks", "Last tick is less than max note off time");
+#endif
+    MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
+
+    if (mtrack.mtrack->drumTrack()) {
+        findAllTupletsForDrums(mtrack, sigmap, basicQuant);
+    } else {
+        MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
+    }
+#ifdef QT_DEBUG
+    Q_ASSERT_X(!doNotesOverlap(mtrack),
+               "quantizeAllTracks",
+               "There are overlapping notes of the same voice that is incorrect");
+#endif
+    // (4/3 of the smallest duration) tol is less sensitive
+    // to on time inaccuracies than 1/2 earlier
+    MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
+    Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
+    MidiTuplet::removeEmptyTuplets(mtrack);
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
+               "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
+                                    "or non-tuplet chord/note is inside tuplet");
+#endif
+}
+
+// tracks are independent of each other, so they are quantized in parallel;
+// each track only changes its own chords and tuplets, the result doesn't depend
+// on the order in which the tracks finish
+
 void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
                        TimeSigMap* sigmap,
                        const ReducedFraction& lastTick)
 {
     auto& opers = midiImportOperations;
+    std::vector<MTrack*> quantTracks;
 
     for (auto& track: tracks) {
         MTrack& mtrack = track.second;
         if (mtrack.chords.empty()) {
             continue;
         }
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
+        // track operations are changed here, before the parallel part
         if (opers.data()->processingsOfOpenedFile == 0) {
             opers.data()->trackOpers.isDrumTrack.setValue(
-                opers.currentTrack(), mtrack.mtrack->drumTrack());
+                mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
             if (mtrack.mtrack->drumTrack()) {
                 opers.data()->trackOpers.maxVoiceCount.setValue(
-                    opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                    mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
             }
         }
-        const auto basicQuant = Quantize::quantValueToFraction(
-            opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
-                   "quantizeAllTracks", "Last tick is less than max note off time");
-#endif
-        MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
-
-        if (mtrack.mtrack->drumTrack()) {
-            findAllTupletsForDrums(mtrack, sigmap, basicQuant);
-        } else {
-            MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
-        }
-#ifdef QT_DEBUG
-        Q_ASSERT_X(!doNotesOverlap(track.second),
-                   "quantizeAllTracks",
-                   "There are overlapping notes of the same voice that is incorrect");
-#endif
-        // (4/3 of the smallest duration) tol is less sensitive
-        // to on time inaccuracies than 1/2 earlier
-        MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
-        Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
-        MidiTuplet::removeEmptyTuplets(mtrack);
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
-                   "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
-                                        "or non-tuplet chord/note is inside tuplet");
-#endif
+        quantTracks.push_back(&mtrack);
     }
+
+    QtConcurrent::blockingMap(quantTracks, [sigmap, &lastTick](MTrack* mtrack) {
+        quantizeTrack(*mtrack, sigmap, lastTick);
+    });
 }
 
 //---------------------------------------------------------
@@ -658,13 +675,17 @@ Fraction metaTimeSignature(const MidiEvent& e)
     return Fraction(z, n);
 }
 
-QList<MTrack> prepareTrackList(const std::multimap<int, MTrack>& tracks)
+// chords and tuplets are moved to the track list, not copied;
+// the tracks keep only the information that is needed for the tempo
+
+QList<MTrack> prepareTrackList(std::multimap<int, MTrack>& tracks)
 {
     QList<MTrack> trackList;
-    for (const auto& track: tracks) {
+    for (auto& track: tracks) {
         // show track even if all initial notes were cleaned up
         if (track.second.hadInitialNotes) {
-            trackList.push_back(track.second);
+            trackList.push_back(MTrack());
+            trackList.back() = std::move(track.second);
         }
     }
     return trackList;
@@ -728,15 +749,15 @@ std::multimap<int, MTrack> createMTrackList(TimeSigMap* sigmap, const MidiFile*
                     track.indexOfOperation = trackIndex;
                     const int reorderedIndex
                         = data->trackOpers.trackIndexAfterReorder.value(trackIndex);
-                    tracks.insert({ reorderedIndex, track });
+                    tracks.insert({ reorderedIndex, std::move(track) });
                 }
             } else {                // if it is an initial track-list query from MIDI import panel
                 track.indexOfOperation = trackIndex;
-                tracks.insert({ trackIndex, track });
+                tracks.insert({ trackIndex, std::move(track) });
             }
         } else {
             track.hadInitialNotes = false;             // it's a tempo track or something else
-            tracks.insert({ -1, track });
+            tracks.insert({ -1, std::move(track) });
         }
     }
 
@@ -424,7 +424,7 @@ void adjustChordsToBeats(std::multimap<int, MTrack>& tracks)
 
                 const auto scale = newBeatLen / (beatEnd - beatStart);
 
-                for (; chordIt != chords.end() && chordIt->first < beatEnd; ++chordIt) {
+                while (chordIt != chords.end() && chordIt->first < beatEnd) {
                     auto newOnTimeInBeat = (chordIt->first - beatStart) * scale;
                     // quantize to prevent ReducedFraction overflow
                     newOnTimeInBeat = Quantize::quantizeValue(
@@ -437,7 +437,10 @@ void adjustChordsToBeats(std::multimap<int, MTrack>& tracks)
                             note.offTime = newOnTime + MChord::minAllowedDuration();
                         }
                     }
-                    newChords.insert({ newOnTime, chordIt->second });
+                    // move the chord node, not copy the chord
+                    auto chordNode = chords.extract(chordIt++);
+                    chordNode.key() = newOnTime;
+                    newChords.insert(std::move(chordNode));
                 }
 
                 if (chordIt == chords.end()) {
@@ -107,12 +107,8 @@ MTrack& getNewTrack(std::map<int, MTrack>& newTracks,
 {
     auto newTrackIt = newTracks.find(pitch);
     if (newTrackIt == newTracks.end()) {
-        newTrackIt = newTracks.insert({ pitch, drumTrack }).first;
+        newTrackIt = newTracks.insert({ pitch, MTrack(drumTrack, {}) }).first;
         MTrack& newTrack = newTrackIt->second;
-        // chords are copied and then cleared -
-        // not very efficient way but it's more safe for possible
-        // future additions of new fields in MTrack
-        newTrack.chords.clear();
         newTrack.name = smDrumset->name(pitch);
 
         Q_ASSERT(newTrack.tuplets.empty());
@@ -153,11 +149,11 @@ void splitDrumTracks(std::multimap<int, MTrack>& tracks)
         if (!opers.doStaffSplit.value(it->second.indexOfOperation)) {
             continue;
         }
-        const std::map<int, MTrack> newTracks = splitDrumTrack(it->second);
+        std::map<int, MTrack> newTracks = splitDrumTrack(it->second);
         const int trackIndex = it->first;
         it = tracks.erase(it);
         for (auto i = newTracks.rbegin(); i != newTracks.rend(); ++i) {
-            it = tracks.insert({ trackIndex, i->second });
+            it = tracks.insert({ trackIndex, std::move(i->second) });
         }
     }
 }
@@ -21,6 +21,13 @@ MTrack::MTrack()
 }
 
 MTrack::MTrack(const MTrack& other)
+    : MTrack(other, other.chords)
+{
+}
+
+// copy of the other track with the given chords instead of its chords
+
+MTrack::MTrack(const MTrack& other, std::multimap<ReducedFraction, MidiChord> otherChords)
     : program(other.program)
     , staff(other.staff)
     , mtrack(other.mtrack)
@@ -31,7 +38,7 @@ MTrack::MTrack(const MTrack& other)
     , isDivisionInTps(other.isDivisionInTps)
     , hadInitialNotes(other.hadInitialNotes)
     , volumes(other.volumes)
-    , chords(other.chords)
+    , chords(std::move(otherChords))
 {
     updateTupletsFromChords();
 }
@@ -49,7 +56,7 @@ MTrack& MTrack::operator=(MTrack other)
     std::swap(hadInitialNotes, other.hadInitialNotes);
     std::swap(volumes, other.volumes);
     std::swap(chords, other.chords);
-    updateTupletsFromChords();
+    std::swap(tuplets, other.tuplets);        // the tuplets of other chords
 
     return *this;
 }
@@ -68,6 +68,8 @@ class MTrack
 public:                 // chords store tuplet iterators, so we need to copy class explicitly
     MTrack();
     MTrack(const MTrack& other);
+    MTrack(MTrack&& other) = default;         // tuplet iterators stay valid
+    MTrack(const MTrack& other, std::multimap<ReducedFraction, MidiChord> otherChords);
     MTrack& operator=(MTrack other);
 
     int program;
@@ -365,11 +365,9 @@ std::vector<ChordSplitData> findSplits(std::multimap<ReducedFraction, MidiChord>
 
 void insertNewLeftHandTrack(std::multimap<int, MTrack>& tracks,
                             std::multimap<int, MTrack>::iterator& it,
-                            const std::multimap<ReducedFraction, MidiChord>& leftHandChords)
+                            std::multimap<ReducedFraction, MidiChord> leftHandChords)
 {
-    auto leftHandTrack = it->second;
-    leftHandTrack.chords = leftHandChords;
-    it = tracks.insert({ it->first, leftHandTrack });
+    it = tracks.insert({ it->first, MTrack(it->second, std::move(leftHandChords)) });
 }
 
 // maybe todo later: if range of right-hand chords > OCTAVE
@@ -390,7 +388,7 @@ void splitStaff(std::multimap<int, MTrack>& tracks, std::multimap<int, MTrack>::
     splitChords(splits, leftHandChords, chords);
 
     if (!leftHandChords.empty()) {
-        insertNewLeftHandTrack(tracks, it, leftHandChords);
+        insertNewLeftHandTrack(tracks, it, std::move(leftHandChords));
     }
 }
 
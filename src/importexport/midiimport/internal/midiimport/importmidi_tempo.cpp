@@ -22,7 +22,7 @@ double findBasicTempo(const std::multimap<int, MTrack>& tracks, bool isHumanPerf
     for (const auto& track: tracks) {
         // don't read tempo from tempo track for human performed files
         // because very often the tempo in such track is completely erroneous
-        if (isHumanPerformance && track.second.chords.empty()) {
+        if (isHumanPerformance && !track.second.hadInitialNotes) {
             continue;
         }
         for (const auto& ie : track.second.mtrack->events()) {
@@ -6,6 +6,8 @@
 #include "importmidi_inner.h"
 #include "libmscore/mscore.h"
 
+#include <QDeadlineTimer>
+
 #include <set>
 
 namespace Ms {
@@ -561,9 +563,13 @@ void findNextTuplet(
     const std::vector<TupletInfo>& tuplets,
     const std::vector<std::pair<ReducedFraction, ReducedFraction> >& tupletIntervals,
     size_t commonsSize,
-    const ReducedFraction& basicQuant)
+    const ReducedFraction& basicQuant,
+    const QDeadlineTimer& deadline)
 {
     while (!validTuplets.empty()) {
+        if (deadline.hasExpired()) {
+            return;
+        }
         size_t index = validTuplets.first();
 
         bool isCommonGroupBegins = (selectedTuplets.empty() && index == commonsSize);
@@ -641,7 +647,8 @@ void findNextTuplet(
             }
         } else {
             findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                           tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                           tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant,
+                           deadline);
         }
 
         selectedTuplets.pop_back();
@@ -667,22 +674,35 @@ void moveUncommonTupletsToEnd(std::vector<TupletInfo>& tuplets, std::set<int>& u
                "Untested uncommon tuplets remaining");
 }
 
+// the search is stopped when it takes too long for the bar,
+// then the best tuplets found so far are taken;
+// if there are none - the greedy choice is taken
+
 std::vector<int> findBestTuplets(
     const std::vector<TupletCommon>& tupletCommons,
     const std::vector<TupletInfo>& tuplets,
     size_t commonsSize,
-    const ReducedFraction& basicQuant)
+    const ReducedFraction& basicQuant,
+    const std::vector<int>& greedyTupletIndexes)
 {
+    const int MAX_SEARCH_TIME = 1000;        // ms per bar
+
     std::vector<int> bestTupletIndexes;
     std::vector<int> selectedTuplets;
     TupletErrorResult minCurrentError;
     const auto tupletIntervals = findTupletIntervals(tuplets, basicQuant);
 
     ValidTuplets validTuplets(int(tuplets.size()));
+    const QDeadlineTimer deadline(MAX_SEARCH_TIME);
 
     findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                   tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                   tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant,
+                   deadline);
 
+    if (bestTupletIndexes.empty() && deadline.hasExpired()) {
+        qDebug("MIDI tuplets: search time is exceeded, greedy choice of tuplets is taken");
+        return greedyTupletIndexes;
+    }
     return bestTupletIndexes;
 }
 
@@ -742,15 +762,22 @@ void filterTuplets(std::vector<TupletInfo>& tuplets,
                "MIDI tuplets: filterTuplets",
                "Uncommon tuplets have common chords but they shouldn't");
 #endif
+    // the longest uncommon group is the greedy choice of tuplets
+    std::vector<int> greedyIndexes;
     size_t commonsSize = tuplets.size();
     if (uncommons.size() > 1) {
         commonsSize -= uncommons.size();
         moveUncommonTupletsToEnd(tuplets, uncommons);
+        for (size_t i = commonsSize; i != tuplets.size(); ++i) {
+            greedyIndexes.push_back(int(i));
+        }
+    } else {
+        greedyIndexes.assign(uncommons.begin(), uncommons.end());
     }
     const auto tupletCommons = findTupletCommons(tuplets);
 
     const std::vector<int> bestIndexes = findBestTuplets(tupletCommons, tuplets,
-                                                         commonsSize, basicQuant);
+                                                         commonsSize, basicQuant, greedyIndexes);
 #ifdef QT_DEBUG
     Q_ASSERT_X(validateSelectedTuplets(bestIndexes.begin(), bestIndexes.end(), tuplets),
                "MIDI tuplets: filterTuplets", "Tuplets have common chords but they shouldn't");
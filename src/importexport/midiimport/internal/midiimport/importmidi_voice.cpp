@@ -1,6 +1,7 @@
 #include "importmidi_voice.h"
 
 #include <QSet>
+#include <QtConcurrent>
 
 #include "importmidi_tuplet.h"
 #include "importmidi_inner.h"
@@ -1039,61 +1040,73 @@ void sortVoices(
     }
 }
 
-bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
+bool separateTrackVoices(MTrack& mtrack, const TimeSigMap* sigmap)
 {
     auto& opers = midiImportOperations;
-    bool changed = false;
-
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
-        if (mtrack.mtrack->drumTrack()) {
-            continue;
-        }
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
-        }
-        const int userVoiceCount = toIntVoiceCount(
-            opers.data()->trackOpers.maxVoiceCount.value(mtrack.indexOfOperation));
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+    const int userVoiceCount = toIntVoiceCount(
+        opers.data()->trackOpers.maxVoiceCount.value(mtrack.indexOfOperation));
+    // pass current track index through MidiImportOperations
+    // for further usage
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
 
-        if (userVoiceCount > 1 && userVoiceCount <= voiceLimit()) {
+    if (userVoiceCount <= 1 || userVoiceCount > voiceLimit()) {
+        return false;
+    }
 #ifdef QT_DEBUG
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "before voice separation");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "before voice separation");
+    Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+               "MidiVoice::separateVoices",
+               "Not all tuplets are referenced in chords or notes "
+               "before voice separation");
+    Q_ASSERT_X(areVoicesSame(mtrack.chords),
+               "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                            "before voice separation");
 #endif
-            if (doVoiceSeparation(mtrack.chords, sigmap, mtrack.tuplets)) {
-                changed = true;
-            }
+    const bool changed = doVoiceSeparation(mtrack.chords, sigmap, mtrack.tuplets);
 #ifdef QT_DEBUG
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "after voice separation, before voice sort");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "after voice separation, before voice sort");
+    Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+               "MidiVoice::separateVoices",
+               "Not all tuplets are referenced in chords or notes "
+               "after voice separation, before voice sort");
+    Q_ASSERT_X(areVoicesSame(mtrack.chords),
+               "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                            "after voice separation, before voice sort");
 #endif
-            sortVoices(mtrack.chords, sigmap);
+    sortVoices(mtrack.chords, sigmap);
 #ifdef QT_DEBUG
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "after voice sort");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "after voice sort");
+    Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+               "MidiVoice::separateVoices",
+               "Not all tuplets are referenced in chords or notes "
+               "after voice sort");
+    Q_ASSERT_X(areVoicesSame(mtrack.chords),
+               "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                            "after voice sort");
 #endif
+    return changed;
+}
+
+// voices of different tracks are separated in parallel
+
+bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
+{
+    // <track, are voices changed>
+    std::vector<std::pair<MTrack*, bool> > voiceTracks;
+    for (auto& track: tracks) {
+        MTrack& mtrack = track.second;
+        if (!mtrack.mtrack->drumTrack() && !mtrack.chords.empty()) {
+            voiceTracks.push_back({ &mtrack, false });
         }
     }
 
+    QtConcurrent::blockingMap(voiceTracks, [sigmap](std::pair<MTrack*, bool>& track) {
+        track.second = separateTrackVoices(*track.first, sigmap);
+    });
+
+    bool changed = false;
+    for (const auto& track: voiceTracks) {
+        if (track.second) {
+            changed = true;
+        }
+    }
     return changed;
 }
 } // namespace MidiVoice
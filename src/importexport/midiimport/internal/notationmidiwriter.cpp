@@ -19,18 +19,206 @@
 
 #include "notationmidiwriter.h"
 
+#include <algorithm>
+
+#include <QByteArray>
+
 #include "log.h"
 
 using namespace mu::iex::midiimport;
 using namespace mu::system;
+using namespace mu::midi;
+
+namespace {
+//! NOTE A chunk is buffered and written at once, the buffer is reused for the next one
+constexpr int CHUNK_BUFFER_RESERVE = 64 * 1024;
+
+void putInt(QByteArray& buf, uint32_t value, int bytes)
+{
+    for (int i = bytes - 1; i >= 0; --i) {
+        buf.append(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+//! NOTE Variable length quantity, as the delta times of the events
+void putVarLength(QByteArray& buf, uint32_t value)
+{
+    uint32_t bytes = value & 0x7F;
+    while ((value >>= 7)) {
+        bytes <<= 8;
+        bytes |= (value & 0x7F) | 0x80;
+    }
+    for (;;) {
+        buf.append(static_cast<char>(bytes & 0xFF));
+        if (!(bytes & 0x80)) {
+            break;
+        }
+        bytes >>= 8;
+    }
+}
+
+class TrackWriter
+{
+public:
+    explicit TrackWriter(QByteArray& buf)
+        : m_buf(buf) {}
+
+    void tempo(tick_t tick, tempo_t tempo)
+    {
+        delta(tick);
+        m_buf.append(static_cast<char>(0xFF));
+        m_buf.append(static_cast<char>(0x51));
+        m_buf.append(static_cast<char>(0x03));
+        putInt(m_buf, tempo, 3);
+        m_status = 0;
+    }
+
+    void event(tick_t tick, const Event& event)
+    {
+        for (const Event& e : event.toMIDI10()) {
+            uint32_t package = e.to_MIDI10Package();
+            uint8_t status = package & 0xFF;
+            if (!(status & 0x80)) {
+                continue;
+            }
+
+            delta(tick);
+            //! NOTE Running status, the status byte is left out while it doesn't change
+            if (status != m_status) {
+                m_buf.append(static_cast<char>(status));
+                m_status = status;
+            }
+            m_buf.append(static_cast<char>((package >> 8) & 0x7F));
+            uint8_t type = status & 0xF0;
+            if (type != 0xC0 && type != 0xD0) {
+                m_buf.append(static_cast<char>((package >> 16) & 0x7F));
+            }
+        }
+    }
+
+    void endOfTrack(tick_t tick)
+    {
+        delta(tick);
+        m_buf.append(static_cast<char>(0xFF));
+        m_buf.append(static_cast<char>(0x2F));
+        m_buf.append(static_cast<char>(0x00));
+    }
+
+private:
+    void delta(tick_t tick)
+    {
+        tick = std::max(tick, m_tick);
+        putVarLength(m_buf, static_cast<uint32_t>(tick - m_tick));
+        m_tick = tick;
+    }
+
+    QByteArray& m_buf;
+    tick_t m_tick = 0;
+    uint8_t m_status = 0;
+};
+
+bool flush(IODevice& device, QByteArray& buf, qint64& trackLength)
+{
+    if (buf.isEmpty()) {
+        return true;
+    }
+
+    qint64 written = device.write(buf);
+    if (written != buf.size()) {
+        return false;
+    }
+
+    trackLength += written;
+    buf.resize(0);
+    return true;
+}
+}
 
+//! NOTE The file is written as format 0, one track in one pass over the chunks of the renderer.
+//! Only the events of the chunk being written are in memory, the track length is patched in the end.
 mu::Ret NotationMidiWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
 {
-    UNUSED(notation)
-    UNUSED(destinationDevice)
     UNUSED(options)
 
-    NOT_IMPLEMENTED;
+    notation::INotationPlaybackPtr playback = notation ? notation->playback() : nullptr;
+    IF_ASSERT_FAILED(playback) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    //! NOTE Sequential devices can't seek, the track length is written after the track
+    if (destinationDevice.isSequential()) {
+        LOGE() << "midi export needs a device with random access";
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    MidiData data = playback->exportMidiData();
+    tick_t lastTick = playback->exportLastTick();
+
+    QByteArray buf;
+    buf.reserve(CHUNK_BUFFER_RESERVE);
+
+    buf.append("MThd", 4);
+    putInt(buf, 6, 4);
+    putInt(buf, 0, 2);      // format
+    putInt(buf, 1, 2);      // tracks
+    putInt(buf, static_cast<uint32_t>(data.division), 2);
+    buf.append("MTrk", 4);
+    qint64 lengthPos = destinationDevice.pos() + buf.size();
+    putInt(buf, 0, 4);
+
+    qint64 headerLength = 0;
+    if (!flush(destinationDevice, buf, headerLength)) {
+        LOGE() << "failed write midi header, err: " << destinationDevice.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    TrackWriter track(buf);
+    qint64 trackLength = 0;
+
+    auto tempoIt = data.tempoMap.cbegin();
+    auto writeTemposUntil = [&](tick_t tick) {
+        for (; tempoIt != data.tempoMap.cend() && tempoIt->first <= tick; ++tempoIt) {
+            track.tempo(tempoIt->first, tempoIt->second);
+        }
+    };
+
+    writeTemposUntil(0);
+    for (const Event& e : data.initEvents) {
+        track.event(0, e);
+    }
+
+    tick_t tick = 0;
+    while (tick < lastTick) {
+        Chunk chunk = playback->exportMidiChunk(tick);
+        if (chunk.endTick <= tick) {
+            break;
+        }
+
+        for (auto it = chunk.events.begin(); it != chunk.events.end(); ++it) {
+            writeTemposUntil(it->first);
+            track.event(it->first, it->second);
+        }
+
+        if (!flush(destinationDevice, buf, trackLength)) {
+            LOGE() << "failed write midi track, err: " << destinationDevice.errorString();
+            return make_ret(Ret::Code::UnknownError);
+        }
+        tick = chunk.endTick;
+    }
+
+    writeTemposUntil(tick);
+    track.endOfTrack(tick);
+    if (!flush(destinationDevice, buf, trackLength)) {
+        LOGE() << "failed write midi track, err: " << destinationDevice.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    qint64 endPos = destinationDevice.pos();
+    putInt(buf, static_cast<uint32_t>(trackLength), 4);
+    if (!destinationDevice.seek(lengthPos) || destinationDevice.write(buf) != buf.size() || !destinationDevice.seek(endPos)) {
+        LOGE() << "failed write midi track length, err: " << destinationDevice.errorString();
+        return make_ret(Ret::Code::UnknownError);
+    }
 
-    return make_ret(Ret::Code::NotImplemented);
+    return make_ret(Ret::Code::Ok);
 }
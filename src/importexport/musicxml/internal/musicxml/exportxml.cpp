@@ -39,6 +39,7 @@
 #include <math.h>
 #include <QBuffer>
 #include <QDate>
+#include <QtConcurrent>
 
 #include "config.h"
 
@@ -382,6 +383,7 @@ class ExportMusicXml
                             FigBassMap& fbMap);
     void writeMeasure(const Measure* const m, const int idx, const int staffCount, MeasureNumberStateHandler& mnsh, FigBassMap& fbMap,
                       const MeasurePrintContext& mpc);
+    void writePart(const int partIndex, const int staffCount);
     void writeParts();
 
     static QString fermataPosition(const Fermata* const fermata);
@@ -399,6 +401,13 @@ public:
         div = 1;
         tenths = 40;
         millimeters = _score->spatium() * tenths / (10 * DPMM);
+        for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
+            brackets[i] = nullptr;
+            dashes[i] = nullptr;
+            hairpins[i] = nullptr;
+            ottavas[i] = nullptr;
+            trills[i] = nullptr;
+        }
     }
 
     void write(QIODevice* dev);
@@ -1629,8 +1638,9 @@ static Volta* findVolta(const Measure* const m, bool left)
 {
     Fraction stick = m->tick();
     Fraction etick = m->tick() + m->ticks();
-    auto spanners = m->score()->spannerMap().findOverlapping(stick.ticks(), etick.ticks());
-    for (auto i : spanners) {
+    std::vector<interval_tree::Interval<Spanner*> > spanners;
+    m->score()->spannerMap().findOverlapping(stick.ticks(), etick.ticks(), spanners);
+    for (const auto& i : spanners) {
         Spanner* el = i.value;
         if (el->type() != ElementType::VOLTA) {
             continue;
@@ -6835,70 +6845,130 @@ void MeasurePrintContext::measureWritten(const Measure* m)
 }
 
 //---------------------------------------------------------
-//  writeParts
+//  writePart
 //---------------------------------------------------------
 
 /**
- Write all parts.
+ Write the part with index \a partIndex, \a staffCount is the number of staves in the parts before it.
  */
 
-void ExportMusicXml::writeParts()
+void ExportMusicXml::writePart(const int partIndex, const int staffCount)
 {
-    int staffCount = 0;
-    const auto& parts = _score->parts();
-
-    for (int partIndex = 0; partIndex < parts.size(); ++partIndex) {
-        const auto part = parts.at(partIndex);
-        _tick = { 0,1 };
-        _xml.stag(QString("part id=\"P%1\"").arg(partIndex + 1));
+    const auto part = _score->parts().at(partIndex);
+    _tick = { 0,1 };
+    _xml.stag(QString("part id=\"P%1\"").arg(partIndex + 1));
 
-        _trillStart.clear();
-        _trillStop.clear();
-        initInstrMap(instrMap, part->instruments(), _score);
+    _trillStart.clear();
+    _trillStop.clear();
+    initInstrMap(instrMap, part->instruments(), _score);
 
-        MeasureNumberStateHandler mnsh;
-        FigBassMap fbMap;                     // pending figured bass extends
+    MeasureNumberStateHandler mnsh;
+    FigBassMap fbMap;                     // pending figured bass extends
 
-        const auto& pages = _score->pages();
-        MeasurePrintContext mpc;
+    const auto& pages = _score->pages();
+    MeasurePrintContext mpc;
 
-        for (int pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
-            const auto page = pages.at(pageIndex);
-            mpc.pageStart = true;
-            const auto& systems = page->systems();
+    for (int pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        const auto page = pages.at(pageIndex);
+        mpc.pageStart = true;
+        const auto& systems = page->systems();
 
-            for (int systemIndex = 0; systemIndex < systems.size(); ++systemIndex) {
-                const auto system = systems.at(systemIndex);
-                mpc.systemStart = true;
+        for (int systemIndex = 0; systemIndex < systems.size(); ++systemIndex) {
+            const auto system = systems.at(systemIndex);
+            mpc.systemStart = true;
 
-                for (const auto mb : system->measures()) {
-                    if (!mb->isMeasure()) {
-                        continue;
-                    }
-                    const auto m = toMeasure(mb);
-
-                    if (m->isMMRest()) {
-                        // in case of a multimeasure rest (which is a single measure in MuseScore), write the measure range it replaces
-                        const auto m2 = m->mmRestLast()->nextMeasure();
-                        for (auto m1 = m->mmRestFirst(); m1 != m2; m1 = m1->nextMeasure()) {
-                            if (m1->isMeasure()) {
-                                writeMeasure(m1, partIndex, staffCount, mnsh, fbMap, mpc);
-                                mpc.measureWritten(m1);
-                            }
+            for (const auto mb : system->measures()) {
+                if (!mb->isMeasure()) {
+                    continue;
+                }
+                const auto m = toMeasure(mb);
+
+                if (m->isMMRest()) {
+                    // in case of a multimeasure rest (which is a single measure in MuseScore), write the measure range it replaces
+                    const auto m2 = m->mmRestLast()->nextMeasure();
+                    for (auto m1 = m->mmRestFirst(); m1 != m2; m1 = m1->nextMeasure()) {
+                        if (m1->isMeasure()) {
+                            writeMeasure(m1, partIndex, staffCount, mnsh, fbMap, mpc);
+                            mpc.measureWritten(m1);
                         }
-                    } else {
-                        // write the measure (or, if measure repeat, the "underlying" measure that it indicates for the musician to play)
-                        writeMeasure(m, partIndex, staffCount, mnsh, fbMap, mpc);
-                        mpc.measureWritten(m);
                     }
+                } else {
+                    // write the measure (or, if measure repeat, the "underlying" measure that it indicates for the musician to play)
+                    writeMeasure(m, partIndex, staffCount, mnsh, fbMap, mpc);
+                    mpc.measureWritten(m);
                 }
-                mpc.prevSystem = system;
             }
-            mpc.lastSystemPrevPage = mpc.prevSystem;
+            mpc.prevSystem = system;
         }
+        mpc.lastSystemPrevPage = mpc.prevSystem;
+    }
+
+    _xml.etag();
+}
+
+//---------------------------------------------------------
+//  writeParts
+//---------------------------------------------------------
 
+/**
+ Write all parts.
+ The parts only read the score and do not depend on each other, so each one
+ is written by an exporter of its own into a buffer of its own, concurrently.
+ The buffers are then appended in part order.
+ */
+
+void ExportMusicXml::writeParts()
+{
+    const auto& parts = _score->parts();
+
+    QVector<int> staffCounts;
+    int staffCount = 0;
+    for (const Part* part : parts) {
+        staffCounts.append(staffCount);
         staffCount += part->nstaves();
-        _xml.etag();
+    }
+
+    if (parts.size() < 2) {
+        for (int partIndex = 0; partIndex < parts.size(); ++partIndex) {
+            writePart(partIndex, staffCounts.at(partIndex));
+        }
+        return;
+    }
+
+    // resolve the injected configuration before it is used by the threads
+    configuration();
+
+    struct PartBuffer {
+        QByteArray data;
+        int start = 0;          // where the part starts, after the enclosing tag
+    };
+    QVector<PartBuffer> buffers(parts.size());
+    QVector<int> partIndexes;
+    for (int partIndex = 0; partIndex < parts.size(); ++partIndex) {
+        partIndexes.append(partIndex);
+    }
+
+    QtConcurrent::blockingMap(partIndexes, [this, &buffers, &staffCounts](int partIndex) {
+        PartBuffer& pb = buffers[partIndex];
+        QBuffer buffer(&pb.data);
+        buffer.open(QIODevice::WriteOnly);
+
+        ExportMusicXml em(_score);
+        em.div = div;
+        em._xml.setDevice(&buffer);
+        em._xml.setCodec("UTF-8");
+        // the enclosing tag gives the part the same indentation it has in the document
+        em._xml.stag("score-partwise version=\"3.1\"");
+        em._xml.flush();
+        pb.start = pb.data.size();
+
+        em.writePart(partIndex, staffCounts.at(partIndex));
+        em._xml.flush();
+    });
+
+    _xml.flush();
+    for (const PartBuffer& pb : buffers) {
+        _xml.device()->write(pb.data.constData() + pb.start, pb.data.size() - pb.start);
     }
 }
 
@@ -6925,14 +6995,6 @@ void ExportMusicXml::write(QIODevice* dev)
 
     calcDivisions();
 
-    for (int i = 0; i < MAX_NUMBER_LEVEL; ++i) {
-        brackets[i] = nullptr;
-        dashes[i] = nullptr;
-        hairpins[i] = nullptr;
-        ottavas[i] = nullptr;
-        trills[i] = nullptr;
-    }
-
     _xml.setDevice(dev);
     _xml.setCodec("UTF-8");
     _xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
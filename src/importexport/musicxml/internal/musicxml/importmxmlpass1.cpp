@@ -17,6 +17,12 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include <cstring>
+#include <memory>
+
+#include <QBuffer>
+#include <QtConcurrent>
+
 #include "libmscore/box.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/instrtemplate.h"
@@ -202,7 +208,7 @@ static void copyOverlapData(VoiceOverlapDetector& vod, VoiceList& vcLst)
 //---------------------------------------------------------
 
 MusicXMLParserPass1::MusicXMLParserPass1(Score* score, MxmlLogger* logger)
-    : _divs(0), _score(score), _logger(logger), _hasBeamingInfo(false)
+    : _divs(0), _score(score), _logger(logger), _hasBeamingInfo(false), _deferScoreChanges(false)
 {
     // nothing
 }
@@ -956,8 +962,21 @@ Score::FileError MusicXMLParserPass1::parse(QIODevice* device)
 {
     _logger->logDebugTrace("MusicXMLParserPass1::parse device");
     _parts.clear();
-    _e.setDevice(device);
+    _data = device->readAll();
+    device->seek(0);
+    QBuffer header;
+    if (findPartRanges(_data)) {
+        // only the header is read here, the parts are read by parseParts()
+        header.setData(_data.left(_partRanges.first().first) + "</score-partwise>");
+        header.open(QIODevice::ReadOnly);
+        _e.setDevice(&header);
+    } else {
+        _e.setDevice(device);
+    }
     auto res = parse();
+    _e.setDevice(nullptr);
+    _partRanges.clear();
+    _data.clear();
     if (res != Score::FileError::FILE_NO_ERROR) {
         return res;
     }
@@ -1072,6 +1091,10 @@ void MusicXMLParserPass1::scorePartwise()
         }
     }
 
+    if (!_partRanges.isEmpty()) {
+        parseParts();
+    }
+
     // add brackets where required
 
     /*
@@ -2090,6 +2113,175 @@ static void setNumberOfStavesForPart(Part* const part, const int staves)
     }
 }
 
+//---------------------------------------------------------
+//   setNumberOfStaves
+//---------------------------------------------------------
+
+/**
+ Make sure the part with id \a partId has at least \a staves staves.
+ */
+
+void MusicXMLParserPass1::setNumberOfStaves(const QString& partId, const int staves)
+{
+    if (_deferScoreChanges) {
+        _pendingStaves[partId] = qMax(staves, numberOfStaves(partId));
+    } else {
+        setNumberOfStavesForPart(_partMap.value(partId), staves);
+    }
+}
+
+//---------------------------------------------------------
+//   numberOfStaves
+//---------------------------------------------------------
+
+/**
+ Return the number of staves of the part with id \a partId, including pending changes.
+ */
+
+int MusicXMLParserPass1::numberOfStaves(const QString& partId) const
+{
+    const Part* const part = _partMap.value(partId);
+    return qMax(part ? part->nstaves() : 0, _pendingStaves.value(partId, 0));
+}
+
+//---------------------------------------------------------
+//   addTimeSig
+//---------------------------------------------------------
+
+void MusicXMLParserPass1::addTimeSig(const Fraction& tick, const Fraction& timeSig)
+{
+    if (_deferScoreChanges) {
+        _pendingTimeSigs.append({ tick, timeSig });
+    } else {
+        _score->sigmap()->add(tick.ticks(), timeSig);
+    }
+}
+
+//---------------------------------------------------------
+//   findPartRanges
+//---------------------------------------------------------
+
+/**
+ Find the start and end offset of each part in \a data without parsing it.
+ Only succeeds if there are at least two parts, they follow the part list
+ and nothing but white space is between and after them.
+ */
+
+bool MusicXMLParserPass1::findPartRanges(const QByteArray& data)
+{
+    _partRanges.clear();
+
+    const auto isSpace = [](const char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    const auto onlySpace = [&data, &isSpace](int from, const int to) {
+        for (; from < to; ++from) {
+            if (!isSpace(data.at(from))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const int partListEnd = data.indexOf("</part-list>");
+    if (partListEnd < 0) {
+        return false;
+    }
+
+    int from = partListEnd + int(strlen("</part-list>"));
+    QVector<QPair<int, int> > ranges;
+    for (;;) {
+        const int start = data.indexOf("<part", from);
+        if (start < 0 || start + 5 >= data.size()) {
+            break;
+        }
+        const char c = data.at(start + 5);
+        if (!(isSpace(c) || c == '>')) {
+            return false;     // another element between the parts
+        }
+        if (!ranges.isEmpty() && !onlySpace(from, start)) {
+            return false;
+        }
+        const int end = data.indexOf("</part>", start);
+        if (end < 0) {
+            return false;
+        }
+        from = end + int(strlen("</part>"));
+        ranges.append({ start, from });
+    }
+
+    const int scoreEnd = data.indexOf("</score-partwise>", from);
+    if (ranges.size() < 2 || scoreEnd < 0 || !onlySpace(from, scoreEnd)) {
+        return false;
+    }
+
+    _partRanges = ranges;
+    return true;
+}
+
+//---------------------------------------------------------
+//   parseParts
+//---------------------------------------------------------
+
+/**
+ Parse the parts found by findPartRanges(), each one by a parser of its own,
+ in parallel. The score is only read while the parts are parsed; the staves
+ and time signatures found are added afterwards, in part order.
+ */
+
+void MusicXMLParserPass1::parseParts()
+{
+    std::vector<std::unique_ptr<MusicXMLParserPass1> > parsers;
+    for (int i = 0; i < _partRanges.size(); ++i) {
+        auto parser = std::make_unique<MusicXMLParserPass1>(_score, _logger);
+        parser->_divs = _divs;
+        parser->_parts = _parts;
+        parser->_partMap = _partMap;
+        parser->_instruments = _instruments;
+        parser->_deferScoreChanges = true;
+        parsers.push_back(std::move(parser));
+    }
+
+    QVector<QString> partIds(int(parsers.size()));
+    QVector<int> indexes;
+    for (int i = 0; i < int(parsers.size()); ++i) {
+        indexes.append(i);
+    }
+
+    QtConcurrent::blockingMap(indexes, [this, &parsers, &partIds](int i) {
+        MusicXMLParserPass1* parser = parsers[i].get();
+        const auto& range = _partRanges.at(i);
+        QBuffer buffer;
+        buffer.setData(QByteArray::fromRawData(_data.constData() + range.first, range.second - range.first));
+        buffer.open(QIODevice::ReadOnly);
+        parser->_e.setDevice(&buffer);
+        while (parser->_e.readNextStartElement()) {
+            if (parser->_e.name() == "part") {
+                partIds[i] = parser->_e.attributes().value("id").toString().trimmed();
+                parser->part();
+            } else {
+                parser->skipLogCurrElem();
+            }
+        }
+        parser->_e.setDevice(nullptr);
+    });
+
+    for (size_t i = 0; i < parsers.size(); ++i) {
+        const auto& parser = parsers[i];
+        if (_parts.contains(partIds[i])) {
+            _parts[partIds[i]] = parser->_parts.value(partIds[i]);
+        }
+        for (auto it = parser->_pendingStaves.cbegin(); it != parser->_pendingStaves.cend(); ++it) {
+            setNumberOfStaves(it.key(), it.value());
+        }
+        for (const auto& timeSig : parser->_pendingTimeSigs) {
+            addTimeSig(timeSig.first, timeSig.second);
+        }
+        _systemStartMeasureNrs.insert(parser->_systemStartMeasureNrs.cbegin(), parser->_systemStartMeasureNrs.cend());
+        _pageStartMeasureNrs.insert(parser->_pageStartMeasureNrs.cbegin(), parser->_pageStartMeasureNrs.cend());
+        _hasBeamingInfo = _hasBeamingInfo || parser->_hasBeamingInfo;
+        _divs = parser->_divs;
+    }
+}
+
 //---------------------------------------------------------
 //   part
 //---------------------------------------------------------
@@ -2129,7 +2321,7 @@ void MusicXMLParserPass1::part()
     }
 
     // Bug fix for Cubase 6.5.5..9.5.10 which generate <staff>2</staff> in a single staff part
-    setNumberOfStavesForPart(_partMap.value(id), _parts[id].maxStaff());
+    setNumberOfStaves(id, _parts[id].maxStaff());
     // allocate MuseScore staff to MusicXML voices
     allocateStaves(_parts[id].voicelist);
     // allocate MuseScore voice to MusicXML voices
@@ -2553,7 +2745,7 @@ void MusicXMLParserPass1::time(const Fraction cTime)
         int btp = 0;           // beat-type as integer
         if (determineTimeSig(_logger, &_e, beats, beatType, timeSymbol, st, bts, btp)) {
             _timeSigDura = Fraction(bts, btp);
-            _score->sigmap()->add(cTime.ticks(), _timeSigDura);
+            addTimeSig(cTime, _timeSigDura);
         }
     }
 }
@@ -2629,7 +2821,7 @@ void MusicXMLParserPass1::staves(const QString& partId)
         return;
     }
 
-    setNumberOfStavesForPart(_partMap.value(partId), staves);
+    setNumberOfStaves(partId, staves);
 }
 
 //---------------------------------------------------------
@@ -3252,9 +3444,8 @@ void MusicXMLParserPass1::note(const QString& partId,
             auto strStaff = _e.readElementText();
             staff = strStaff.toInt(&ok);
             _parts[partId].setMaxStaff(staff);
-            Part* part = _partMap.value(partId);
-            Q_ASSERT(part);
-            if (!ok || staff <= 0 || staff > part->nstaves()) {
+            Q_ASSERT(_partMap.value(partId));
+            if (!ok || staff <= 0 || staff > numberOfStaves(partId)) {
                 _logger->logError(QString("illegal staff '%1'").arg(strStaff), &_e);
             }
         } else if (_e.name() == "stem") {
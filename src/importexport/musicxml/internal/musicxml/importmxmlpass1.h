@@ -167,7 +167,11 @@ public:
 
 private:
     // functions
-    // none
+    bool findPartRanges(const QByteArray& data);
+    void parseParts();
+    void setNumberOfStaves(const QString& partId, const int staves);
+    int numberOfStaves(const QString& partId) const;
+    void addTimeSig(const Fraction& tick, const Fraction& timeSig);
 
     // generic pass 1 data
     QXmlStreamReader _e;
@@ -188,6 +192,13 @@ private:
     Fraction _timeSigDura;                      ///< Measure duration according to last timesig read
     QMap<int, MxmlOctaveShiftDesc> _octaveShifts;   ///< Pending octave-shifts
     QSize _pageSize;                            ///< Page width read from defaults
+
+    // parts parsed in parallel
+    QByteArray _data;                           ///< The whole file
+    QVector<QPair<int, int> > _partRanges;      ///< Start and end offset in _data of each part
+    bool _deferScoreChanges;                    ///< Score changes are kept pending, merged after all parts are parsed
+    QMap<QString, int> _pendingStaves;          ///< Number of staves for each part
+    QVector<QPair<Fraction, Fraction> > _pendingTimeSigs;    ///< Time signatures in the order read
 };
 } // namespace Ms
 #endif
@@ -1493,10 +1493,10 @@ bool isRestDefaultLine(ovebase::Note* rest, ovebase::NoteType noteType)
     return isDefault;
 }
 
-Drumset* getDrumset(Score* score, int part)
+const Drumset* getDrumset(Score* score, int part)
 {
     Part* p = score->parts().at(part);
-    return const_cast<Drumset*>(p->instrument()->drumset()); // TODO: remove cast
+    return p->instrument()->drumset();
 }
 
 void OveToMScore::convertNotes(Measure* measure, int part, int staff, int track)
@@ -1625,7 +1625,7 @@ void OveToMScore::convertNotes(Measure* measure, int part, int staff, int track)
                 bool setDirection = false;
                 ovebase::ClefType clefType = getClefType(measureData, container->getTick());
                 if (clefType == ovebase::ClefType::Percussion1 || clefType == ovebase::ClefType::Percussion2) {
-                    Drumset* drumset = getDrumset(m_score, part);
+                    const Drumset* drumset = getDrumset(m_score, part);
                     if (drumset != 0) {
                         if (!drumset->isValid(pitch) || pitch == -1) {
                             qDebug("unmapped drum note 0x%02x %d", note->pitch(), note->pitch());
@@ -2528,15 +2528,19 @@ Score::FileError importOve(MasterScore* score, const QString& name)
         return Score::FileError::FILE_OPEN_ERROR;
     }
 
-    QByteArray buffer = oveFile.readAll();
+    bool result = false;
+    {
+        // the file is not needed anymore once loaded
+        QByteArray buffer = oveFile.readAll();
 
-    oveFile.close();
+        oveFile.close();
 
-    oveSong.setTextCodecName(QString::fromStdString(ove::configuration()->importOvertuneCharset()));
-    oveLoader->setOve(&oveSong);
-    oveLoader->setFileStream((unsigned char*)buffer.data(), buffer.size());
-    bool result = oveLoader->load();
-    oveLoader->release();
+        oveSong.setTextCodecName(QString::fromStdString(ove::configuration()->importOvertuneCharset()));
+        oveLoader->setOve(&oveSong);
+        oveLoader->setFileStream((unsigned char*)buffer.data(), buffer.size());
+        result = oveLoader->load();
+        oveLoader->release();
+    }
 
     if (result) {
         OveToMScore otm;
@@ -4794,8 +4794,11 @@ PageGroupParse::PageGroupParse(OveSong* ove)
 {
 }
 
+// the added chunks are owned by the parse
+
 PageGroupParse::~PageGroupParse()
 {
+    qDeleteAll(m_pageChunks);
     m_pageChunks.clear();
 }
 
@@ -4945,10 +4948,14 @@ LineGroupParse::LineGroupParse(OveSong* ove)
 {
 }
 
+// the added chunks are owned by the parse
+
 LineGroupParse::~LineGroupParse()
 {
     m_chunk = NULL;
+    qDeleteAll(m_lineChunks);
     m_lineChunks.clear();
+    qDeleteAll(m_staffChunks);
     m_staffChunks.clear();
 }
 
@@ -5132,10 +5139,15 @@ BarsParse::BarsParse(OveSong* ove)
 {
 }
 
+// the added chunks are owned by the parse
+
 BarsParse::~BarsParse()
 {
+    qDeleteAll(m_measureChunks);
     m_measureChunks.clear();
+    qDeleteAll(m_conductChunks);
     m_conductChunks.clear();
+    qDeleteAll(m_bdatChunks);
     m_bdatChunks.clear();
 }
 
@@ -5227,6 +5239,10 @@ bool BarsParse::parse()
 
             m_notify->loadPosition(measureID, trackMeasureCount, trackID, trackCount);
         }
+
+        // the bar data take most of the file, free them as they are parsed
+        delete m_bdatChunks[i];
+        m_bdatChunks[i] = NULL;
     }
 
     return true;
@@ -10459,17 +10475,17 @@ bool OveSerialize::readTracksData()
     unsigned short trackCount = trackGroupChunk.getCountBlock()->toCount();
 
     for (i = 0; i < trackCount; ++i) {
-        SizeChunk* trackChunk = new SizeChunk();
+        SizeChunk trackChunk;
 
         if (m_ove->getIsVersion4()) {
-            if (!readChunkName(trackChunk, Chunk::TrackName)) {
+            if (!readChunkName(&trackChunk, Chunk::TrackName)) {
                 return false;
             }
-            if (!readSizeChunk(trackChunk)) {
+            if (!readSizeChunk(&trackChunk)) {
                 return false;
             }
         } else {
-            if (!readDataChunk(trackChunk->getDataBlock(),
+            if (!readDataChunk(trackChunk.getDataBlock(),
                                SizeChunk::version3TrackSize)) {
                 return false;
             }
@@ -10477,7 +10493,7 @@ bool OveSerialize::readTracksData()
 
         TrackParse trackParse(m_ove);
 
-        trackParse.setTrack(trackChunk);
+        trackParse.setTrack(&trackChunk);
         trackParse.parse();
     }
 
@@ -10498,6 +10514,7 @@ bool OveSerialize::readPagesData()
 
     for (i = 0; i < pageCount; ++i) {
         SizeChunk* pageChunk = new SizeChunk();
+        parse.addPage(pageChunk);
 
         if (!readChunkName(pageChunk, Chunk::PageName)) {
             return false;
@@ -10505,8 +10522,6 @@ bool OveSerialize::readPagesData()
         if (!readSizeChunk(pageChunk)) {
             return false;
         }
-
-        parse.addPage(pageChunk);
     }
 
     if (!parse.parse()) {
@@ -10526,11 +10541,13 @@ bool OveSerialize::readLinesData()
     unsigned short lineCount = lineGroupChunk.getCountBlock()->toCount();
     int i;
     unsigned int j;
-    QList<SizeChunk*> lineChunks;
-    QList<SizeChunk*> staffChunks;
+    LineGroupParse parse(m_ove);
+
+    parse.setLineGroup(&lineGroupChunk);
 
     for (i = 0; i < lineCount; ++i) {
         SizeChunk* lineChunk = new SizeChunk();
+        parse.addLine(lineChunk);
 
         if (!readChunkName(lineChunk, Chunk::LineName)) {
             return false;
@@ -10539,13 +10556,12 @@ bool OveSerialize::readLinesData()
             return false;
         }
 
-        lineChunks.push_back(lineChunk);
-
         StaffCountGetter getter(m_ove);
         unsigned int staffCount = getter.getStaffCount(lineChunk);
 
         for (j = 0; j < staffCount; ++j) {
             SizeChunk* staffChunk = new SizeChunk();
+            parse.addStaff(staffChunk);
 
             if (!readChunkName(staffChunk, Chunk::StaffName)) {
                 return false;
@@ -10553,23 +10569,9 @@ bool OveSerialize::readLinesData()
             if (!readSizeChunk(staffChunk)) {
                 return false;
             }
-
-            staffChunks.push_back(staffChunk);
         }
     }
 
-    LineGroupParse parse(m_ove);
-
-    parse.setLineGroup(&lineGroupChunk);
-
-    for (i = 0; i < lineChunks.size(); ++i) {
-        parse.addLine(lineChunks[i]);
-    }
-
-    for (i = 0; i < staffChunks.size(); ++i) {
-        parse.addStaff(staffChunks[i]);
-    }
-
     if (!parse.parse()) {
         return false;
     }
@@ -10586,16 +10588,14 @@ bool OveSerialize::readBarsData()
 
     unsigned short measCount = barGroupChunk.getCountBlock()->toCount();
     int i;
-
-    QList<SizeChunk*> measureChunks;
-    QList<SizeChunk*> conductChunks;
-    QList<SizeChunk*> bdatChunks;
+    BarsParse barsParse(m_ove);
 
     m_ove->setTrackBarCount(measCount);
 
     // read chunks
     for (i = 0; i < measCount; ++i) {
         SizeChunk* measureChunkPtr = new SizeChunk();
+        barsParse.addMeasure(measureChunkPtr);
 
         if (!readChunkName(measureChunkPtr, Chunk::MeasureName)) {
             return false;
@@ -10603,12 +10603,11 @@ bool OveSerialize::readBarsData()
         if (!readSizeChunk(measureChunkPtr)) {
             return false;
         }
-
-        measureChunks.push_back(measureChunkPtr);
     }
 
     for (i = 0; i < measCount; ++i) {
         SizeChunk* conductChunkPtr = new SizeChunk();
+        barsParse.addConduct(conductChunkPtr);
 
         if (!readChunkName(conductChunkPtr, Chunk::ConductName)) {
             return false;
@@ -10617,13 +10616,12 @@ bool OveSerialize::readBarsData()
         if (!readSizeChunk(conductChunkPtr)) {
             return false;
         }
-
-        conductChunks.push_back(conductChunkPtr);
     }
 
     int bdatCount = m_ove->getTrackCount() * measCount;
     for (i = 0; i < bdatCount; ++i) {
         SizeChunk* batChunkPtr = new SizeChunk();
+        barsParse.addBdat(batChunkPtr);
 
         if (!readChunkName(batChunkPtr, Chunk::BdatName)) {
             return false;
@@ -10631,25 +10629,9 @@ bool OveSerialize::readBarsData()
         if (!readSizeChunk(batChunkPtr)) {
             return false;
         }
-
-        bdatChunks.push_back(batChunkPtr);
     }
 
     // parse bars
-    BarsParse barsParse(m_ove);
-
-    for (i = 0; i < measureChunks.size(); ++i) {
-        barsParse.addMeasure(measureChunks[i]);
-    }
-
-    for (i = 0; i < conductChunks.size(); ++i) {
-        barsParse.addConduct(conductChunks[i]);
-    }
-
-    for (i = 0; i < bdatChunks.size(); ++i) {
-        barsParse.addBdat(bdatChunks[i]);
-    }
-
     barsParse.setNotify(m_notify);
     if (!barsParse.parse()) {
         return false;
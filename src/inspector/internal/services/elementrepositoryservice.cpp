@@ -1,5 +1,7 @@
 #include "elementrepositoryservice.h"
 
+#include <QSet>
+
 #include "chord.h"
 #include "stem.h"
 #include "hook.h"
@@ -32,11 +34,25 @@ QObject* ElementRepositoryService::getQObject()
 void ElementRepositoryService::updateElementList(const QList<Ms::Element*>& newRawElementList)
 {
     m_elementList = exposeRawElements(newRawElementList);
+    m_elementsByType.clear();
 
     emit elementsUpdated();
 }
 
 QList<Ms::Element*> ElementRepositoryService::findElementsByType(const Ms::ElementType elementType) const
+{
+    auto it = m_elementsByType.constFind(static_cast<int>(elementType));
+    if (it != m_elementsByType.constEnd()) {
+        return it.value();
+    }
+
+    QList<Ms::Element*> resultList = doFindElementsByType(elementType);
+    m_elementsByType.insert(static_cast<int>(elementType), resultList);
+
+    return resultList;
+}
+
+QList<Ms::Element*> ElementRepositoryService::doFindElementsByType(const Ms::ElementType elementType) const
 {
     switch (elementType) {
     case Ms::ElementType::CHORD: return findChords();
@@ -89,16 +105,22 @@ QList<Ms::Element*> ElementRepositoryService::takeAllElements() const
 QList<Ms::Element*> ElementRepositoryService::exposeRawElements(const QList<Ms::Element*>& rawElementList) const
 {
     QList<Ms::Element*> resultList;
+    QSet<const Ms::Element*> resultSet;
+    resultList.reserve(rawElementList.size());
+    resultSet.reserve(rawElementList.size());
 
     for (const Ms::Element* element : rawElementList) {
-        if (!resultList.contains(element->elementBase())) {
-            resultList << element->elementBase();
+        Ms::Element* elementBase = element->elementBase();
+        if (!resultSet.contains(elementBase)) {
+            resultSet.insert(elementBase);
+            resultList << elementBase;
         }
 
         if (element->type() == Ms::ElementType::BEAM) {
             const Ms::Beam* beam = Ms::toBeam(element);
 
             for (Ms::ChordRest* chordRest : beam->elements()) {
+                resultSet.insert(chordRest);
                 resultList << chordRest;
             }
         }
@@ -172,6 +194,7 @@ QList<Ms::Element*> ElementRepositoryService::findHooks() const
 QList<Ms::Element*> ElementRepositoryService::findBeams() const
 {
     QList<Ms::Element*> resultList;
+    QSet<const Ms::Element*> resultSet;
 
     for (const Ms::Element* element : findChords()) {
         Ms::Element* beam = nullptr;
@@ -188,10 +211,11 @@ QList<Ms::Element*> ElementRepositoryService::findBeams() const
             beam = const_cast<Ms::Element*>(element);
         }
 
-        if (!beam || resultList.contains(beam)) {
+        if (!beam || resultSet.contains(beam)) {
             continue;
         }
 
+        resultSet.insert(beam);
         resultList << beam;
     }
 
@@ -243,12 +267,15 @@ QList<Ms::Element*> ElementRepositoryService::findHairpins() const
 QList<Ms::Element*> ElementRepositoryService::findStaffs() const
 {
     QList<Ms::Element*> resultList;
+    QSet<const Ms::Element*> resultSet;
 
+    //! NOTE A large selection has thousands of elements on the same few staves
     for (const Ms::Element* element : m_elementList) {
-        if (!element->staff()) {
+        if (!element->staff() || resultSet.contains(element->staff())) {
             continue;
         }
 
+        resultSet.insert(element->staff());
         resultList << element->staff();
     }
 
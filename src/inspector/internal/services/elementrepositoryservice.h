@@ -4,6 +4,7 @@
 #include "internal/interfaces/ielementrepositoryservice.h"
 
 #include <QObject>
+#include <QHash>
 
 namespace mu::inspector {
 class ElementRepositoryService : public QObject, public IElementRepositoryService
@@ -26,7 +27,11 @@ signals:
 private:
     QList<Ms::Element*> m_elementList;
 
+    //! NOTE The models ask for the same types on each update, the lists are kept until the next one
+    mutable QHash<int, QList<Ms::Element*> > m_elementsByType;
+
     QList<Ms::Element*> exposeRawElements(const QList<Ms::Element*>& rawElementList) const;
+    QList<Ms::Element*> doFindElementsByType(const Ms::ElementType elementType) const;
 
     QList<Ms::Element*> findChords() const;
     QList<Ms::Element*> findNotes() const;
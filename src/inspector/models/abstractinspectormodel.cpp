@@ -392,7 +392,6 @@ void AbstractInspectorModel::loadPropertyItem(PropertyItem* propertyItem, std::f
         }
 
         QVariant elementCurrentValue = valueFromElementUnits(pid, element->getProperty(pid), element);
-        QVariant elementDefaultValue = valueFromElementUnits(pid, element->propertyDefault(pid), element);
 
         bool isPropertySupportedByElement = elementCurrentValue.isValid();
 
@@ -402,10 +401,16 @@ void AbstractInspectorModel::loadPropertyItem(PropertyItem* propertyItem, std::f
 
         if (convertElementPropertyValueFunc) {
             elementCurrentValue = convertElementPropertyValueFunc(elementCurrentValue);
-            elementDefaultValue = convertElementPropertyValueFunc(elementDefaultValue);
         }
 
+        //! NOTE The default value is only taken from the first elements, it is not needed for the others
         if (!(propertyValue.isValid() && defaultPropertyValue.isValid())) {
+            QVariant elementDefaultValue = valueFromElementUnits(pid, element->propertyDefault(pid), element);
+
+            if (convertElementPropertyValueFunc) {
+                elementDefaultValue = convertElementPropertyValueFunc(elementDefaultValue);
+            }
+
             propertyValue = elementCurrentValue;
             defaultPropertyValue = elementDefaultValue;
         }
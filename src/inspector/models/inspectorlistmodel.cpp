@@ -202,11 +202,20 @@ bool InspectorListModel::isModelAlreadyExists(const AbstractInspectorModel::Insp
 
 void InspectorListModel::subscribeOnSelectionChanges()
 {
+    //! NOTE The selection may change many times in a row, as while extending it with the keyboard,
+    //! the models are only rebuilt for the last one
+    static constexpr int SELECTION_CHANGED_DELAY_MS = 50;
+
+    m_selectionChangedTimer.setSingleShot(true);
+    m_selectionChangedTimer.setInterval(SELECTION_CHANGED_DELAY_MS);
+    connect(&m_selectionChangedTimer, &QTimer::timeout, this, &InspectorListModel::updateElementListFromSelection);
+
     if (!context() || !context()->currentNotation()) {
         setElementList(QList<Ms::Element*>());
     }
 
     context()->currentNotationChanged().onNotify(this, [this]() {
+        m_selectionChangedTimer.stop();
         m_notation = context()->currentNotation();
 
         if (!m_notation) {
@@ -215,13 +224,25 @@ void InspectorListModel::subscribeOnSelectionChanges()
         }
 
         m_notation->interaction()->selectionChanged().onNotify(this, [this]() {
-            QList<Ms::Element*> elements;
-
-            for (Ms::Element* element: m_notation->interaction()->selection()->elements()) {
-                elements << element;
-            }
-
-            setElementList(elements);
+            m_selectionChangedTimer.start();
         });
     });
 }
+
+void InspectorListModel::updateElementListFromSelection()
+{
+    if (!m_notation) {
+        return;
+    }
+
+    std::vector<Ms::Element*> selectedElements = m_notation->interaction()->selection()->elements();
+
+    QList<Ms::Element*> elements;
+    elements.reserve(static_cast<int>(selectedElements.size()));
+
+    for (Ms::Element* element: selectedElements) {
+        elements << element;
+    }
+
+    setElementList(elements);
+}
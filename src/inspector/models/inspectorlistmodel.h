@@ -2,6 +2,7 @@
 #define MU_INSPECTOR_INSPECTORLISTMODEL_H
 
 #include <QAbstractListModel>
+#include <QTimer>
 #include "libmscore/element.h"
 #include "models/abstractinspectormodel.h"
 #include "internal/services/elementrepositoryservice.h"
@@ -46,12 +47,14 @@ private:
     bool isModelAlreadyExists(const AbstractInspectorModel::InspectorSectionType modelType) const;
 
     void subscribeOnSelectionChanges();
+    void updateElementListFromSelection();
 
     QHash<int, QByteArray> m_roleNames;
     QList<AbstractInspectorModel*> m_modelList;
 
     IElementRepositoryService* m_repository = nullptr;
     notation::INotationPtr m_notation;
+    QTimer m_selectionChangedTimer;
 };
 }
 
@@ -3,6 +3,7 @@
 #include <QFont>
 
 #include "types/texttypes.h"
+#include "libmscore/mscore.h"
 #include "libmscore/textbase.h"
 #include "dataformatter.h"
 
@@ -13,6 +14,8 @@ TextSettingsModel::TextSettingsModel(QObject* parent, IElementRepositoryService*
 {
     setSectionType(InspectorSectionType::SECTION_TEXT);
     setTitle(qtrc("inspector", "Text"));
+    // for the list of the font families
+    Ms::MScore::loadAllFontFamilies();
     createProperties();
 
     adapter()->isTextEditingChanged().onNotify(this, [this]() {
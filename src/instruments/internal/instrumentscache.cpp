@@ -0,0 +1,498 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "instrumentscache.h"
+
+#include <type_traits>
+
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::instruments;
+
+static const quint32 CACHE_MAGIC = 0x4d534943; // MSIC
+static const quint32 CACHE_VERSION = 1;
+
+static_assert(std::is_trivially_copyable<midi::Event>::value, "midi::Event is written as bytes");
+
+template<typename E>
+static void writeEnum(QDataStream& out, E value)
+{
+    out << qint32(value);
+}
+
+template<typename E>
+static void readEnum(QDataStream& in, E& value)
+{
+    qint32 i = 0;
+    in >> i;
+    value = static_cast<E>(i);
+}
+
+static void writeStaffNames(QDataStream& out, const StaffNameList& names)
+{
+    out << qint32(names.size());
+    for (const StaffName& name : names) {
+        out << name.name() << qint32(name.pos());
+    }
+}
+
+static void readStaffNames(QDataStream& in, StaffNameList& names)
+{
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        qint32 pos = 0;
+        in >> name >> pos;
+        names << StaffName(name, pos);
+    }
+}
+
+static void writeArticulation(QDataStream& out, const MidiArticulation& articulation)
+{
+    out << articulation.name << articulation.descr << qint32(articulation.velocity) << qint32(articulation.gateTime);
+}
+
+static void readArticulation(QDataStream& in, MidiArticulation& articulation)
+{
+    qint32 velocity = 0;
+    qint32 gateTime = 0;
+    in >> articulation.name >> articulation.descr >> velocity >> gateTime;
+    articulation.velocity = velocity;
+    articulation.gateTime = gateTime;
+}
+
+static void writeArticulations(QDataStream& out, const QList<MidiArticulation>& articulations)
+{
+    out << qint32(articulations.size());
+    for (const MidiArticulation& articulation : articulations) {
+        writeArticulation(out, articulation);
+    }
+}
+
+static void readArticulations(QDataStream& in, QList<MidiArticulation>& articulations)
+{
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        MidiArticulation articulation;
+        readArticulation(in, articulation);
+        articulations << articulation;
+    }
+}
+
+static void writeChannel(QDataStream& out, const Channel& channel)
+{
+    out << channel.name() << channel.descr() << channel.synti() << qint32(channel.color());
+    out << qint8(channel.volume()) << qint8(channel.pan()) << qint8(channel.chorus()) << qint8(channel.reverb());
+    out << qint32(channel.program()) << qint32(channel.bank());
+    out << channel.mute() << channel.solo() << channel.userBankController();
+
+    out << qint32(channel.midiActions.size());
+    for (const Ms::NamedEventList& action : channel.midiActions) {
+        out << action.name << action.descr << qint32(action.events.size());
+        for (const Ms::MidiCoreEvent& event : action.events) {
+            out << quint8(event.type()) << quint8(event.channel()) << quint8(event.dataA()) << quint8(event.dataB());
+        }
+    }
+
+    writeArticulations(out, channel.articulation);
+}
+
+static void readChannel(QDataStream& in, Channel& channel)
+{
+    QString name, descr, synti;
+    qint32 color = 0, program = 0, bank = 0;
+    qint8 volume = 0, pan = 0, chorus = 0, reverb = 0;
+    bool mute = false, solo = false, userBankController = false;
+
+    in >> name >> descr >> synti >> color;
+    in >> volume >> pan >> chorus >> reverb;
+    in >> program >> bank;
+    in >> mute >> solo >> userBankController;
+
+    channel.setName(name);
+    channel.setDescr(descr);
+    channel.setSynti(synti);
+    channel.setColor(color);
+    channel.setVolume(volume);
+    channel.setPan(pan);
+    channel.setChorus(chorus);
+    channel.setReverb(reverb);
+    channel.setProgram(program);
+    channel.setBank(bank);
+    channel.setMute(mute);
+    channel.setSolo(solo);
+    channel.setUserBankController(userBankController);
+
+    qint32 actionCount = 0;
+    in >> actionCount;
+    for (qint32 i = 0; i < actionCount && in.status() == QDataStream::Ok; ++i) {
+        Ms::NamedEventList action;
+        qint32 eventCount = 0;
+        in >> action.name >> action.descr >> eventCount;
+        for (qint32 j = 0; j < eventCount && in.status() == QDataStream::Ok; ++j) {
+            quint8 type = 0, ch = 0, a = 0, b = 0;
+            in >> type >> ch >> a >> b;
+            action.events.push_back(Ms::MidiCoreEvent(type, ch, a, b));
+        }
+        channel.midiActions << action;
+    }
+
+    readArticulations(in, channel.articulation);
+}
+
+static void writeDrumset(QDataStream& out, const Drumset* drumset)
+{
+    out << bool(drumset);
+    if (!drumset) {
+        return;
+    }
+
+    for (int pitch = 0; pitch < Ms::DRUM_INSTRUMENTS; ++pitch) {
+        if (!drumset->isValid(pitch)) {
+            continue;
+        }
+
+        const Ms::DrumInstrument& drum = drumset->drum(pitch);
+        out << qint32(pitch) << drum.name;
+        writeEnum(out, drum.notehead);
+        for (Ms::SymId symbol : drum.noteheads) {
+            writeEnum(out, symbol);
+        }
+        out << qint32(drum.line);
+        writeEnum(out, drum.stemDirection);
+        out << qint32(drum.voice) << qint8(drum.shortcut);
+
+        out << qint32(drum.variants.size());
+        for (const Ms::DrumInstrumentVariant& variant : drum.variants) {
+            out << qint32(variant.pitch) << variant.articulationName;
+            writeEnum(out, variant.tremolo);
+        }
+    }
+    out << qint32(-1);
+}
+
+static const Drumset* readDrumset(QDataStream& in)
+{
+    bool hasDrumset = false;
+    in >> hasDrumset;
+    if (!hasDrumset) {
+        return nullptr;
+    }
+
+    Drumset* drumset = new Drumset();
+    drumset->clear();
+
+    qint32 pitch = -1;
+    in >> pitch;
+    while (pitch >= 0 && pitch < Ms::DRUM_INSTRUMENTS && in.status() == QDataStream::Ok) {
+        Ms::DrumInstrument& drum = drumset->drum(pitch);
+        qint32 line = 0, voice = 0, variantCount = 0;
+        qint8 shortcut = 0;
+
+        in >> drum.name;
+        readEnum(in, drum.notehead);
+        for (Ms::SymId& symbol : drum.noteheads) {
+            readEnum(in, symbol);
+        }
+        in >> line;
+        readEnum(in, drum.stemDirection);
+        in >> voice >> shortcut;
+        drum.line = line;
+        drum.voice = voice;
+        drum.shortcut = shortcut;
+
+        in >> variantCount;
+        for (qint32 i = 0; i < variantCount && in.status() == QDataStream::Ok; ++i) {
+            Ms::DrumInstrumentVariant variant;
+            qint32 variantPitch = 0;
+            in >> variantPitch >> variant.articulationName;
+            readEnum(in, variant.tremolo);
+            variant.pitch = variantPitch;
+            drum.addVariant(variant);
+        }
+
+        in >> pitch;
+    }
+
+    return drumset;
+}
+
+static void writeStaffTypePreset(QDataStream& out, const StaffType* preset)
+{
+    const std::vector<StaffType>& presets = StaffType::presets();
+    qint32 index = -1;
+    for (size_t i = 0; i < presets.size(); ++i) {
+        if (&presets[i] == preset) {
+            index = qint32(i);
+            break;
+        }
+    }
+    out << index;
+}
+
+static const StaffType* readStaffTypePreset(QDataStream& in)
+{
+    const std::vector<StaffType>& presets = StaffType::presets();
+    qint32 index = -1;
+    in >> index;
+    if (index < 0 || index >= qint32(presets.size())) {
+        return nullptr;
+    }
+    return &presets[index];
+}
+
+static void writeInstrument(QDataStream& out, const Instrument& instrument)
+{
+    out << instrument.id;
+    writeStaffNames(out, instrument.longNames);
+    writeStaffNames(out, instrument.shortNames);
+    out << instrument.name << instrument.description << instrument.extended << qint32(instrument.staves);
+    out << instrument.groupId << instrument.genreIds;
+
+    out << qint32(instrument.amateurPitchRange.min) << qint32(instrument.amateurPitchRange.max);
+    out << qint32(instrument.professionalPitchRange.min) << qint32(instrument.professionalPitchRange.max);
+
+    for (int i = 0; i < MAX_STAVES; ++i) {
+        writeEnum(out, instrument.clefs[i]._concertClef);
+        writeEnum(out, instrument.clefs[i]._transposingClef);
+        out << qint32(instrument.staffLines[i]);
+        writeEnum(out, instrument.bracket[i]);
+        out << qint32(instrument.bracketSpan[i]) << qint32(instrument.barlineSpan[i]) << instrument.smallStaff[i];
+    }
+
+    out << qint8(instrument.transpose.diatonic) << qint8(instrument.transpose.chromatic);
+    writeEnum(out, instrument.staffGroup);
+    writeStaffTypePreset(out, instrument.staffTypePreset);
+
+    out << instrument.useDrumset;
+    writeDrumset(out, instrument.drumset);
+
+    out << qint32(instrument.stringData.frets()) << qint32(instrument.stringData.stringList().size());
+    for (const Ms::instrString& string : instrument.stringData.stringList()) {
+        out << qint32(string.pitch) << string.open << qint32(string.startFret);
+    }
+
+    out << instrument.singleNoteDynamics;
+
+    out << qint32(instrument.midiActions.size());
+    for (const MidiAction& action : instrument.midiActions) {
+        out << action.name << action.description << qint32(action.events.size());
+        for (const midi::Event& event : action.events) {
+            out.writeRawData(reinterpret_cast<const char*>(&event), sizeof(event));
+        }
+    }
+
+    writeArticulations(out, instrument.midiArticulations);
+
+    out << qint32(instrument.channels.size());
+    for (const Channel& channel : instrument.channels) {
+        writeChannel(out, channel);
+    }
+}
+
+static void readInstrument(QDataStream& in, Instrument& instrument)
+{
+    qint32 staves = 0;
+
+    in >> instrument.id;
+    readStaffNames(in, instrument.longNames);
+    readStaffNames(in, instrument.shortNames);
+    in >> instrument.name >> instrument.description >> instrument.extended >> staves;
+    in >> instrument.groupId >> instrument.genreIds;
+    instrument.staves = staves;
+
+    qint32 amateurMin = 0, amateurMax = 0, professionalMin = 0, professionalMax = 0;
+    in >> amateurMin >> amateurMax >> professionalMin >> professionalMax;
+    instrument.amateurPitchRange = PitchRange(amateurMin, amateurMax);
+    instrument.professionalPitchRange = PitchRange(professionalMin, professionalMax);
+
+    for (int i = 0; i < MAX_STAVES; ++i) {
+        qint32 staffLines = 0, bracketSpan = 0, barlineSpan = 0;
+        readEnum(in, instrument.clefs[i]._concertClef);
+        readEnum(in, instrument.clefs[i]._transposingClef);
+        in >> staffLines;
+        readEnum(in, instrument.bracket[i]);
+        in >> bracketSpan >> barlineSpan >> instrument.smallStaff[i];
+        instrument.staffLines[i] = staffLines;
+        instrument.bracketSpan[i] = bracketSpan;
+        instrument.barlineSpan[i] = barlineSpan;
+    }
+
+    qint8 diatonic = 0, chromatic = 0;
+    in >> diatonic >> chromatic;
+    instrument.transpose = Interval(diatonic, chromatic);
+    readEnum(in, instrument.staffGroup);
+    instrument.staffTypePreset = readStaffTypePreset(in);
+
+    in >> instrument.useDrumset;
+    instrument.drumset = readDrumset(in);
+
+    qint32 frets = 0, stringCount = 0;
+    in >> frets >> stringCount;
+    QList<Ms::instrString> strings;
+    for (qint32 i = 0; i < stringCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 pitch = 0, startFret = 0;
+        bool open = false;
+        in >> pitch >> open >> startFret;
+        strings << Ms::instrString(pitch, open, startFret);
+    }
+    instrument.stringData = StringData(frets, strings);
+
+    in >> instrument.singleNoteDynamics;
+
+    qint32 actionCount = 0;
+    in >> actionCount;
+    for (qint32 i = 0; i < actionCount && in.status() == QDataStream::Ok; ++i) {
+        MidiAction action;
+        qint32 eventCount = 0;
+        in >> action.name >> action.description >> eventCount;
+        for (qint32 j = 0; j < eventCount && in.status() == QDataStream::Ok; ++j) {
+            midi::Event event;
+            if (in.readRawData(reinterpret_cast<char*>(&event), sizeof(event)) != sizeof(event)) {
+                in.setStatus(QDataStream::ReadPastEnd);
+                break;
+            }
+            action.events.push_back(event);
+        }
+        instrument.midiActions << action;
+    }
+
+    readArticulations(in, instrument.midiArticulations);
+
+    qint32 channelCount = 0;
+    in >> channelCount;
+    for (qint32 i = 0; i < channelCount && in.status() == QDataStream::Ok; ++i) {
+        Channel channel;
+        readChannel(in, channel);
+        instrument.channels << channel;
+    }
+}
+
+bool InstrumentsCache::read(const io::path& cachePath, const QByteArray& sourceHash, InstrumentsMeta& meta)
+{
+    QFile file(cachePath.toQString());
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+
+    //! NOTE The strings are copied out of the mapped file, so it is unmapped when the file is closed
+    uchar* data = file.map(0, file.size());
+    if (!data) {
+        return false;
+    }
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(file.size()));
+
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0, version = 0;
+    QByteArray hash;
+    in >> magic >> version >> hash;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || hash != sourceHash) {
+        return false;
+    }
+
+    InstrumentsMeta result;
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentTemplate instrumentTemplate;
+        in >> instrumentTemplate.id;
+        readInstrument(in, instrumentTemplate.instrument);
+        result.instrumentTemplates.insert(instrumentTemplate.id, instrumentTemplate);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentGroup group;
+        qint32 sequenceOrder = 0;
+        in >> group.id >> group.name >> group.extended >> sequenceOrder;
+        group.sequenceOrder = sequenceOrder;
+        result.groups.insert(group.id, group);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentGenre genre;
+        in >> genre.id >> genre.name;
+        result.genres.insert(genre.id, genre);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        MidiArticulation articulation;
+        in >> key;
+        readArticulation(in, articulation);
+        result.articulations.insert(key, articulation);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        LOGE() << "broken instruments cache: " << cachePath;
+        return false;
+    }
+
+    meta = result;
+    return true;
+}
+
+bool InstrumentsCache::write(const io::path& cachePath, const QByteArray& sourceHash, const InstrumentsMeta& meta)
+{
+    QSaveFile file(cachePath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed to write the instruments cache: " << cachePath;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+
+    out << CACHE_MAGIC << CACHE_VERSION << sourceHash;
+
+    out << qint32(meta.instrumentTemplates.size());
+    for (const InstrumentTemplate& instrumentTemplate : meta.instrumentTemplates) {
+        out << instrumentTemplate.id;
+        writeInstrument(out, instrumentTemplate.instrument);
+    }
+
+    out << qint32(meta.groups.size());
+    for (const InstrumentGroup& group : meta.groups) {
+        out << group.id << group.name << group.extended << qint32(group.sequenceOrder);
+    }
+
+    out << qint32(meta.genres.size());
+    for (const InstrumentGenre& genre : meta.genres) {
+        out << genre.id << genre.name;
+    }
+
+    out << qint32(meta.articulations.size());
+    for (auto it = meta.articulations.cbegin(); it != meta.articulations.cend(); ++it) {
+        out << it.key();
+        writeArticulation(out, it.value());
+    }
+
+    return file.commit();
+}
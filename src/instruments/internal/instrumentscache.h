@@ -0,0 +1,40 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_INSTRUMENTS_INSTRUMENTSCACHE_H
+#define MU_INSTRUMENTS_INSTRUMENTSCACHE_H
+
+#include <QByteArray>
+
+#include "io/path.h"
+
+#include "instrumentstypes.h"
+
+namespace mu::instruments {
+//! NOTE The instruments read from the instruments files, in a binary form which is loaded
+//! much faster than the files are parsed. The cache is valid as long as the hash of the
+//! files it was written from, see InstrumentsRepository, stays the same.
+class InstrumentsCache
+{
+public:
+    static bool read(const io::path& cachePath, const QByteArray& sourceHash, InstrumentsMeta& meta);
+    static bool write(const io::path& cachePath, const QByteArray& sourceHash, const InstrumentsMeta& meta);
+};
+}
+
+#endif // MU_INSTRUMENTS_INSTRUMENTSCACHE_H
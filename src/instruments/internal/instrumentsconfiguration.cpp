@@ -38,6 +38,11 @@ mu::io::paths InstrumentsConfiguration::instrumentPaths() const
     return paths;
 }
 
+mu::io::path InstrumentsConfiguration::instrumentsCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/instruments.cache";
+}
+
 mu::io::paths InstrumentsConfiguration::extensionsPaths() const
 {
     if (extensionsConfigurator()) {
@@ -23,6 +23,10 @@
 
 #include "libmscore/instrtemplate.h"
 
+#include "instrumentscache.h"
+
+#include <QCryptographicHash>
+
 using namespace mu;
 using namespace mu::instruments;
 using namespace mu::extensions;
@@ -76,6 +80,31 @@ void InstrumentsRepository::load()
         }
     }
 
+    //! NOTE libmscore keeps its own list of the templates, which is still read from the files
+    for (const io::path& filePath: instrumentsFiles) {
+        Ms::loadInstrumentTemplates(filePath.toQString());
+    }
+
+    io::path cachePath = configuration()->instrumentsCachePath();
+    QByteArray filesHash = instrumentsFilesHash(instrumentsFiles);
+
+    if (cachePath.empty() || !InstrumentsCache::read(cachePath, filesHash, m_instrumentsMeta)) {
+        readInstrumentsFiles(instrumentsFiles);
+
+        if (!cachePath.empty()) {
+            InstrumentsCache::write(cachePath, filesHash, m_instrumentsMeta);
+        }
+    }
+
+    for (InstrumentTemplate& instrumentTemplate: m_instrumentsMeta.instrumentTemplates) {
+        instrumentTemplate.transposition = transposition(instrumentTemplate.id);
+    }
+
+    m_instrumentsMetaChannel.send(m_instrumentsMeta);
+}
+
+void InstrumentsRepository::readInstrumentsFiles(const io::paths& instrumentsFiles)
+{
     int globalGroupsSequenceOrder = 0;
     auto correctGroupSequenceOrder = [&globalGroupsSequenceOrder](const InstrumentGroup& group) {
         InstrumentGroup correctedGroup = group;
@@ -112,15 +141,25 @@ void InstrumentsRepository::load()
             m_instrumentsMeta.groups.insert(it.key(), group);
         }
         globalGroupsSequenceOrder += groups.size();
+    }
+}
 
-        Ms::loadInstrumentTemplates(filePath.toQString());
+//! NOTE The names are translated while the files are read, so the language is a part of the hash
+QByteArray InstrumentsRepository::instrumentsFilesHash(const io::paths& instrumentsFiles) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    if (languagesConfiguration()) {
+        hash.addData(languagesConfiguration()->currentLanguageCode().val.toUtf8());
     }
 
-    for (InstrumentTemplate& instrumentTemplate: m_instrumentsMeta.instrumentTemplates) {
-        instrumentTemplate.transposition = transposition(instrumentTemplate.id);
+    for (const io::path& filePath: instrumentsFiles) {
+        RetVal<QByteArray> fileBytes = fileSystem()->readFile(filePath);
+        hash.addData(filePath.toQString().toUtf8());
+        hash.addData(fileBytes.val);
     }
 
-    m_instrumentsMetaChannel.send(m_instrumentsMeta);
+    return hash.result();
 }
 
 void InstrumentsRepository::clear()
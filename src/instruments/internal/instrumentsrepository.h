@@ -28,6 +28,7 @@
 #include "async/asyncable.h"
 #include "framework/system/ifilesystem.h"
 #include "extensions/iextensionsservice.h"
+#include "languages/ilanguagesconfiguration.h"
 
 #include "instrumentstypes.h"
 #include "iinstrumentsrepository.h"
@@ -41,6 +42,7 @@ class InstrumentsRepository : public IInstrumentsRepository, public async::Async
     INJECT(instruments, system::IFileSystem, fileSystem)
     INJECT(instruments, IInstrumentsReader, reader)
     INJECT(instruments, extensions::IExtensionsService, extensionsService)
+    INJECT(instruments, languages::ILanguagesConfiguration, languagesConfiguration)
 
 public:
     void init();
@@ -49,6 +51,8 @@ public:
 
 private:
     void load();
+    void readInstrumentsFiles(const io::paths& instrumentsFiles);
+    QByteArray instrumentsFilesHash(const io::paths& instrumentsFiles) const;
     void clear();
 
     Transposition transposition(const QString& instrumentTemplateId) const;
@@ -18,6 +18,8 @@
 //=============================================================================
 #include "instrumentlistmodel.h"
 
+#include <vector>
+
 #include "log.h"
 #include "translation.h"
 
@@ -114,7 +116,7 @@ QVariantList InstrumentListModel::groups() const
         const Instrument& instrument = templ.instrument;
 
         constexpr bool compareWithSelectedGroup = false;
-        if (!isInstrumentAccepted(instrument, compareWithSelectedGroup)) {
+        if (!isInstrumentAccepted(templ, compareWithSelectedGroup)) {
             continue;
         }
 
@@ -147,7 +149,7 @@ QVariantList InstrumentListModel::instruments() const
     for (const InstrumentTemplate& templ: m_instrumentsMeta.instrumentTemplates) {
         const Instrument& instrument = templ.instrument;
 
-        if (!isInstrumentAccepted(instrument)) {
+        if (!isInstrumentAccepted(templ)) {
             continue;
         }
 
@@ -191,20 +193,32 @@ QVariantList InstrumentListModel::instruments() const
 
 void InstrumentListModel::sortInstruments(QVariantList& instruments) const
 {
-    std::sort(instruments.begin(), instruments.end(), [this](const QVariant& instrument1, const QVariant& instrument2) {
-        QString instrumentName1 = instrument1.toMap()[NAME_KEY].toString().toLower();
-        QString instrumentName2 = instrument2.toMap()[NAME_KEY].toString().toLower();
-        QString searchText = m_searchText.toLower();
+    //! NOTE The keys are taken once for each instrument, not for each comparison
+    struct SortItem {
+        int searchTextPosition = 0;
+        QString name;
+        QVariant instrument;
+    };
 
-        int searchTextPosition1 = instrumentName1.indexOf(searchText);
-        int searchTextPosition2 = instrumentName2.indexOf(searchText);
+    std::vector<SortItem> items;
+    items.reserve(instruments.size());
+    for (const QVariant& instrument: instruments) {
+        QString name = instrument.toMap()[NAME_KEY].toString().toLower();
+        int searchTextPosition = name.indexOf(m_lowerSearchText);
+        items.push_back({ searchTextPosition, std::move(name), instrument });
+    }
 
-        if (searchTextPosition1 == searchTextPosition2) {
-            return instrumentName1 < instrumentName2;
+    std::sort(items.begin(), items.end(), [](const SortItem& item1, const SortItem& item2) {
+        if (item1.searchTextPosition == item2.searchTextPosition) {
+            return item1.name < item2.name;
         }
 
-        return searchTextPosition1 < searchTextPosition2;
+        return item1.searchTextPosition < item2.searchTextPosition;
     });
+
+    for (int i = 0; i < instruments.size(); ++i) {
+        instruments[i] = std::move(items[i].instrument);
+    }
 }
 
 void InstrumentListModel::selectFamily(const QString& familyId)
@@ -285,6 +299,7 @@ void InstrumentListModel::setSearchText(const QString& text)
     }
 
     m_searchText = text;
+    m_lowerSearchText = text.toLower();
     emit dataChanged();
 
     updateFamilyStateBySearch();
@@ -349,6 +364,16 @@ bool InstrumentListModel::isSearching() const
 void InstrumentListModel::setInstrumentsMeta(const InstrumentsMeta& meta)
 {
     m_instrumentsMeta = meta;
+
+    m_lowerNames.clear();
+    m_templateIds.clear();
+    for (const InstrumentTemplate& templ: m_instrumentsMeta.instrumentTemplates) {
+        m_lowerNames.insert(templ.id, templ.instrument.name.toLower());
+        if (!m_templateIds.contains(templ.instrument.id)) {
+            m_templateIds.insert(templ.instrument.id, templ.id);
+        }
+    }
+
     emit dataChanged();
 }
 
@@ -394,12 +419,14 @@ void InstrumentListModel::updateFamilyStateBySearch()
     }
 }
 
-bool InstrumentListModel::isInstrumentAccepted(const Instrument& instrument, bool compareWithSelectedGroup) const
+bool InstrumentListModel::isInstrumentAccepted(const InstrumentTemplate& instrumentTemplate, bool compareWithSelectedGroup) const
 {
     if (isSearching()) {
-        return instrument.name.contains(m_searchText, Qt::CaseInsensitive);
+        return m_lowerNames.value(instrumentTemplate.id).contains(m_lowerSearchText);
     }
 
+    const Instrument& instrument = instrumentTemplate.instrument;
+
     if (instrument.groupId != m_selectedGroupId && compareWithSelectedGroup) {
         return false;
     }
@@ -417,11 +444,10 @@ bool InstrumentListModel::isInstrumentAccepted(const Instrument& instrument, boo
 
 InstrumentTemplate InstrumentListModel::instrumentTemplate(const QString& instrumentId) const
 {
-    for (const InstrumentTemplate& instrumentTemplate: m_instrumentsMeta.instrumentTemplates) {
-        if (instrumentTemplate.instrument.id == instrumentId) {
-            return instrumentTemplate;
-        }
+    auto it = m_templateIds.constFind(instrumentId);
+    if (it == m_templateIds.constEnd()) {
+        return InstrumentTemplate();
     }
 
-    return InstrumentTemplate();
+    return m_instrumentsMeta.instrumentTemplates.value(it.value());
 }
@@ -20,6 +20,7 @@
 #define MU_INSTRUMENTS_INSTRUMENTLISTMODEL_H
 
 #include <QObject>
+#include <QHash>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -90,7 +91,7 @@ private:
 
     void updateFamilyStateBySearch();
 
-    bool isInstrumentAccepted(const Instrument& instrument, bool compareWithSelectedGroup = true) const;
+    bool isInstrumentAccepted(const InstrumentTemplate& instrumentTemplate, bool compareWithSelectedGroup = true) const;
 
     InstrumentTemplate instrumentTemplate(const QString& instrumentId) const;
 
@@ -102,6 +103,11 @@ private:
 
     InstrumentsMeta m_instrumentsMeta;
     QString m_searchText;
+    QString m_lowerSearchText;
+
+    //! NOTE Taken once for the instruments meta, not on each keystroke
+    QHash<QString /*template id*/, QString> m_lowerNames;
+    QHash<QString /*instrument id*/, QString /*template id*/> m_templateIds;
 
     struct SelectedInstrumentInfo
     {
@@ -399,7 +399,8 @@ RetVal<QString> LanguagesService::downloadLanguage(const QString& languageCode,
 
     QString languageArchivePath = configuration()->languageArchivePath(languageCode).toQString();
 
-    QBuffer buff;
+    //! NOTE The archive goes to the file as it is received, it is not kept in memory
+    QFile file(languageArchivePath);
     INetworkManagerPtr networkManagerPtr = networkManagerCreator()->makeNetworkManager();
 
     async::Channel<Progress> downloadChannel = networkManagerPtr->progressChannel();
@@ -407,18 +408,14 @@ RetVal<QString> LanguagesService::downloadLanguage(const QString& languageCode,
         progressChannel->send(LanguageProgress(DOWNLOADING_STATUS, progress.current, progress.total));
     });
 
-    Ret getLanguage = networkManagerPtr->get(configuration()->languageFileServerUrl(languageCode), &buff);
+    Ret getLanguage = networkManagerPtr->get(configuration()->languageFileServerUrl(languageCode), &file);
     if (!getLanguage) {
         LOGE() << "Error save file";
+        file.remove();
         result.ret = make_ret(Err::ErrorDownloadLanguage);
         return result;
     }
 
-    QFile file(languageArchivePath);
-    file.open(QIODevice::WriteOnly);
-    file.write(buff.data());
-    file.close();
-
     result.ret = make_ret(Err::NoError);
     result.val = languageArchivePath;
     return result;
@@ -548,6 +545,7 @@ void LanguagesService::th_update(const QString& languageCode, async::Channel<Lan
     RetVal<QString> download = downloadLanguage(languageCode, progressChannel);
     if (!download.ret) {
         finishChannel->send(download.ret);
+        return;
     }
 
     progressChannel->send(LanguageProgress(ANALYSING_STATUS, true));
@@ -556,13 +554,17 @@ void LanguagesService::th_update(const QString& languageCode, async::Channel<Lan
 
     Ret remove = removeLanguage(languageCode);
     if (!remove) {
+        fileSystem()->remove(languageArchivePath);
         finishChannel->send(remove);
+        return;
     }
 
     Ret unpack = languageUnpacker()->unpack(languageCode, languageArchivePath, configuration()->languagesSharePath().toQString());
     if (!unpack) {
         LOGE() << "Error unpack" << unpack.toString();
+        fileSystem()->remove(languageArchivePath);
         finishChannel->send(unpack);
+        return;
     }
 
     fileSystem()->remove(languageArchivePath);
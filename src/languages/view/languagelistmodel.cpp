@@ -24,7 +24,7 @@
 using namespace mu::languages;
 
 LanguageListModel::LanguageListModel(QObject* parent)
-    : QAbstractListModel(parent)
+    : IncrementalListModel(parent)
 {
     m_roles.insert(rCode, "code");
     m_roles.insert(rName, "name");
@@ -103,15 +103,18 @@ void LanguageListModel::init()
 
 void LanguageListModel::load()
 {
-    m_list.clear();
-
     ValCh<LanguagesHash> languages = languagesService()->languages();
 
-    beginResetModel();
     QList<Language> languageList = languages.val.values();
     std::sort(languageList.begin(), languageList.end(), defaultSort);
-    m_list = languageList;
-    endResetModel();
+
+    auto keyOf = [](const Language& language) {
+        return language.code;
+    };
+
+    updateItems(m_list, languageList, keyOf, [](const Language& language1, const Language& language2) {
+        return language1.isCurrent == language2.isCurrent && language1.toJson() == language2.toJson();
+    });
 }
 
 void LanguageListModel::setupConnections()
@@ -19,15 +19,14 @@
 #ifndef MU_LANGUAGES_LANGUAGELISTMODEL_H
 #define MU_LANGUAGES_LANGUAGELISTMODEL_H
 
-#include <QAbstractListModel>
-
 #include "modularity/ioc.h"
 #include "../ilanguagesservice.h"
 #include "iinteractive.h"
 #include "async/asyncable.h"
+#include "uicomponents/view/incrementallistmodel.h"
 
 namespace mu::languages {
-class LanguageListModel : public QAbstractListModel, async::Asyncable
+class LanguageListModel : public uicomponents::IncrementalListModel, async::Asyncable
 {
     Q_OBJECT
 
@@ -228,7 +228,7 @@ Accidental::Accidental(Score* s)
 void Accidental::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "bracket") {
             int i = e.readInt();
             if (i == 0 || i == 1 || i == 2) {
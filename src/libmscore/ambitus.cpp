@@ -242,7 +242,7 @@ void Ambitus::read(XmlReader& e)
 
 bool Ambitus::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "head") {
         readProperty(e, Pid::HEAD_GROUP);
     } else if (tag == "headType") {
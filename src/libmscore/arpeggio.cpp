@@ -93,7 +93,7 @@ void Arpeggio::write(XmlWriter& xml) const
 void Arpeggio::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             _arpeggioType = ArpeggioType(e.readInt());
         } else if (tag == "userLen1") {
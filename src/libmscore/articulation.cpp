@@ -127,7 +127,7 @@ extern SymId oldArticulationNames2SymId(const QString&);
 
 bool Articulation::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "subtype") {
         QString s = e.readElementText();
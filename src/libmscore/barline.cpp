@@ -88,7 +88,10 @@ static void undoChangeBarLineType(BarLine* bl, BarLineType barType, bool allStav
                 }
                 segment = m2->undoGetSegment(segment->segmentType(), segment->tick());
             }
-            const std::vector<Element*>& elist = allStaves ? segment->elist() : std::vector<Element*> { bl };
+            std::vector<Element*> elist { bl };
+            if (allStaves) {
+                elist.assign(segment->elist().begin(), segment->elist().end());
+            }
             for (Element* e : elist) {
                 if (!e || !e->staff() || !e->isBarLine()) {
                     continue;
@@ -840,7 +843,7 @@ void BarLine::read(XmlReader& e)
     resetProperty(Pid::BARLINE_SPAN_TO);
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             setBarLineType(e.readElementText());
         } else if (tag == "span") {
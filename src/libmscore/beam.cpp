@@ -51,6 +51,11 @@ static const ElementStyle beamStyle {
 struct BeamFragment {
     qreal py1[2];
     qreal py2[2];
+
+    // the last result of Beam::computeStemLen() and what it depends on
+    std::vector<qreal> stemLenKey;
+    int stemLenSlant { 0 };
+    qreal stemLenDy  { 0.0 };
 };
 
 //---------------------------------------------------------
@@ -1259,11 +1264,60 @@ static int* slantTable(uint interval)
     return &t[interval][0];
 }
 
+//---------------------------------------------------------
+//   stemLenKey
+//    all computeStemLen() depends on. The x distances of
+//    the stems are relative to the distance of the first
+//    and the last chord, as the slant and the stem length
+//    in quarter spaces do not change if the segments only
+//    move apart or together; empty if the chords are at
+//    the same x.
+//---------------------------------------------------------
+
+std::vector<qreal> Beam::stemLenKey(const std::vector<ChordRest*>& cl, int beamLevels, qreal dx)
+{
+    std::vector<qreal> key;
+    if (dx == 0.0) {
+        return key;
+    }
+    const qreal spatium4 = spatium() * .25;
+    const bool tab = staff()->isTabStaff(Fraction(0,1));
+    const ChordRest* c1 = cl.front();
+    key.reserve(12 + cl.size() * 9);
+    key.push_back(_up);
+    key.push_back(beamLevels);
+    key.push_back(_isGrace ? (toChord(c1)->underBeam() ? 2 : 1) : 0);
+    key.push_back(hasNoSlope());
+    key.push_back(elements().size());
+    key.push_back(cl.size());
+    key.push_back(spatium4);
+    key.push_back(tab);
+    key.push_back(tab ? staff()->lineDistance(Fraction(0,1)) : 1.0);
+    key.push_back(_beamDist);
+    key.push_back(score()->styleP(Sid::beamWidth));
+
+    const QPointF p1 = c1->stemPosBeam();
+    for (const ChordRest* cr : cl) {
+        const QPointF p = cr->stemPosBeam();
+        key.push_back(cr->isChord());
+        key.push_back(cr->up());
+        key.push_back(cr->line(true));
+        key.push_back(cr->line(false));
+        key.push_back(cr->small());
+        key.push_back(cr->isChord() ? toChord(cr)->minAbsStemLength() : 0.0);
+        key.push_back(qRound64((p.x() - p1.x()) / dx * (1 << 24)));
+        key.push_back(p.y() - p1.y());
+    }
+    return key;
+}
+
 //---------------------------------------------------------
 //   computeStemLen
+//    the result is kept in the fragment and reused while
+//    the stemLenKey() is the same
 //---------------------------------------------------------
 
-void Beam::computeStemLen(const std::vector<ChordRest*>& cl, qreal& py1, int beamLevels)
+void Beam::computeStemLen(BeamFragment* f, const std::vector<ChordRest*>& cl, qreal& py1, int beamLevels)
 {
     qreal _spatium      = spatium();
     qreal _spatium4     = _spatium * .25;
@@ -1272,6 +1326,14 @@ void Beam::computeStemLen(const std::vector<ChordRest*>& cl, qreal& py1, int bea
     const ChordRest* c1 = cl.front();
     const ChordRest* c2 = cl.back();
     qreal dx            = c2->pagePos().x() - c1->pagePos().x();
+
+    std::vector<qreal> key = stemLenKey(cl, beamLevels, dx);
+    if (!key.empty() && key == f->stemLenKey) {
+        slope = (f->stemLenSlant * _spatium4) / dx;
+        py1  += f->stemLenDy;
+        return;
+    }
+    const qreal py1Start = py1;
     bool zeroSlant      = slopeZero(cl);
 
     int l1 = c1->line() * 2;
@@ -1610,6 +1672,10 @@ void Beam::computeStemLen(const std::vector<ChordRest*>& cl, qreal& py1, int bea
             py1 += _spatium - score()->styleP(Sid::beamWidth) / 4.0 - offset;
         }
     }
+
+    f->stemLenKey   = std::move(key);
+    f->stemLenSlant = bm.s;
+    f->stemLenDy    = py1 - py1Start;
 }
 
 //---------------------------------------------------------
@@ -1783,7 +1849,7 @@ void Beam::layout2(std::vector<ChordRest*> crl, SpannerSegmentType, int frag)
         } else {
             py1 = c1->stemPos().y();
             py2 = c2->stemPos().y();            // for debug
-            computeStemLen(crl, py1, beamLevels);
+            computeStemLen(f, crl, py1, beamLevels);
         }
         py2  = (px2 - px1) * slope + py1;       // for debug
         py2 -= _pagePos.y();
@@ -2173,7 +2239,7 @@ void Beam::read(XmlReader& e)
         _id = e.intAttribute("id");
     }
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "StemDirection") {
             readProperty(e, Pid::STEM_DIRECTION);
             e.readNext();
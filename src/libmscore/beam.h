@@ -16,6 +16,7 @@
 #include "element.h"
 #include "durationtype.h"
 #include "property.h"
+#include "elementpool.h"
 
 namespace Ms {
 class ChordRest;
@@ -36,6 +37,8 @@ struct BeamFragment;
 class Beam final : public Element
 {
     Q_GADGET
+    ELEMENT_POOL_ALLOCATION
+
     QVector<ChordRest*> _elements;          // must be sorted by tick
     QVector<QLineF*> beamSegments;
     Direction _direction;
@@ -63,7 +66,8 @@ class Beam final : public Element
 
     void layout2(std::vector<ChordRest*>, SpannerSegmentType, int frag);
     bool twoBeamedNotes();
-    void computeStemLen(const std::vector<ChordRest*>& crl, qreal& py1, int beamLevels);
+    std::vector<qreal> stemLenKey(const std::vector<ChordRest*>& crl, int beamLevels, qreal dx);
+    void computeStemLen(BeamFragment* f, const std::vector<ChordRest*>& crl, qreal& py1, int beamLevels);
     bool slopeZero(const std::vector<ChordRest*>& crl);
     bool hasNoSlope();
     void addChordRest(ChordRest* a);
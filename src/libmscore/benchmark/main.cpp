@@ -0,0 +1,300 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "config.h"
+#include "framework/global/runtime.h"
+#include "framework/testing/environment.h"
+#include "framework/fonts/fontsmodule.h"
+#include "framework/uicomponents/uicomponentsmodule.h"
+#include "framework/midi_old/event.h"
+#include "instruments/instrumentsmodule.h"
+
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/musescoreCore.h"
+#include "libmscore/instrtemplate.h"
+#include "libmscore/synthesizerstate.h"
+
+//---------------------------------------------------------
+//   libmscore_benchmark
+//    loads the scores of a corpus and times, for each of
+//    them, the loading, a full layout, the layout of the
+//    range of a single measure edit, the saving and the
+//    MIDI rendering. The statistics of the runs and the
+//    peak resident set size are written as JSON, to be
+//    compared from a commit to the next.
+//---------------------------------------------------------
+
+using namespace Ms;
+
+namespace {
+//---------------------------------------------------------
+//   peakRss
+//    the peak resident set size of the process, in bytes
+//---------------------------------------------------------
+
+qint64 peakRss()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return qint64(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MACOS
+    return qint64(usage.ru_maxrss);               // bytes
+#else
+    return qint64(usage.ru_maxrss) * 1024;        // kilobytes
+#endif
+#endif
+}
+
+//---------------------------------------------------------
+//   percentile
+//    nearest rank of the sorted samples
+//---------------------------------------------------------
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t rank = size_t(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+//---------------------------------------------------------
+//   statistics
+//    of the durations of the runs, in milliseconds
+//---------------------------------------------------------
+
+QJsonObject statistics(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+    }
+
+    QJsonObject o;
+    o["runs"] = int(samples.size());
+    o["min"]  = samples.empty() ? 0.0 : samples.front();
+    o["p50"]  = percentile(samples, 50);
+    o["p90"]  = percentile(samples, 90);
+    o["p99"]  = percentile(samples, 99);
+    o["max"]  = samples.empty() ? 0.0 : samples.back();
+    o["mean"] = samples.empty() ? 0.0 : sum / samples.size();
+    return o;
+}
+
+//---------------------------------------------------------
+//   measure
+//    runs f iterations times, f gets the run number
+//---------------------------------------------------------
+
+std::vector<double> measure(int iterations, const std::function<void(int)>& f)
+{
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        f(i);
+        samples.push_back(timer.nsecsElapsed() / 1e6);
+    }
+    return samples;
+}
+
+//---------------------------------------------------------
+//   loadScore
+//---------------------------------------------------------
+
+MasterScore* loadScore(const QString& path)
+{
+    MasterScore* score = new MasterScore(MScore::baseStyle());
+    score->setName(QFileInfo(path).completeBaseName());
+    if (score->loadMsc(path, false) != Score::FileError::FILE_NO_ERROR) {
+        delete score;
+        return nullptr;
+    }
+    return score;
+}
+
+//---------------------------------------------------------
+//   benchmarkScore
+//---------------------------------------------------------
+
+QJsonObject benchmarkScore(const QString& name, const QString& path, int iterations)
+{
+    QJsonObject result;
+    result["name"] = name;
+    result["path"] = path;
+
+    MasterScore* score = loadScore(path);
+    if (!score) {
+        result["error"] = QString("cannot load the score");
+        return result;
+    }
+    score->doLayout();
+
+    std::vector<Measure*> measures;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        measures.push_back(m);
+    }
+    result["measures"] = int(measures.size());
+    result["staves"] = score->nstaves();
+
+    QJsonObject operations;
+
+    operations["load"] = statistics(measure(iterations, [&path](int) {
+        delete loadScore(path);
+    }));
+
+    operations["doLayout"] = statistics(measure(iterations, [score](int) {
+        score->doLayout();
+    }));
+
+    // the edits are spread over the score, as the layout of a range depends on where it is
+    operations["doLayoutRange"] = statistics(measure(iterations, [score, &measures, iterations](int i) {
+        const Measure* m = measures[size_t(i) * measures.size() / iterations];
+        score->startCmd();
+        score->setLayout(m->tick(), -1);
+        score->endCmd();
+    }));
+
+    qint64 savedBytes = 0;
+    operations["save"] = statistics(measure(iterations, [score, &savedBytes](int) {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        score->Score::saveFile(&buffer, false);
+        savedBytes = buffer.size();
+    }));
+    result["savedBytes"] = savedBytes;
+
+    operations["renderMidi"] = statistics(measure(iterations, [score](int) {
+        EventMap events;
+        score->renderMidi(&events, SynthesizerState());
+    }));
+
+    result["operations"] = operations;
+    delete score;
+
+    result["peakRss"] = peakRss();
+    return result;
+}
+}
+
+//---------------------------------------------------------
+//   main
+//---------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    QGuiApplication app(argc, argv);
+
+    mu::runtime::mainThreadId(); //! NOTE Needs only call
+    mu::runtime::setThreadName("main");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the layout, saving, loading and MIDI rendering of a corpus of scores");
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("corpus", "The JSON list of the scores, paths are relative to the source tree",
+                                        "file", BENCHMARK_CORPUS));
+    parser.addOption(QCommandLineOption("iterations", "The number of runs of each operation", "count", "10"));
+    parser.addOption(QCommandLineOption("score", "Only run the score of this name, may be repeated", "name"));
+    parser.addOption(QCommandLineOption("output", "Write the results to this file instead of stdout", "file"));
+    parser.process(app);
+
+    const int iterations = std::max(parser.value("iterations").toInt(), 1);
+    const QStringList only = parser.values("score");
+
+    QFile corpusFile(parser.value("corpus"));
+    if (!corpusFile.open(QIODevice::ReadOnly)) {
+        qCritical("cannot read the corpus <%s>", qPrintable(corpusFile.fileName()));
+        return 1;
+    }
+    const QJsonArray corpus = QJsonDocument::fromJson(corpusFile.readAll()).object().value("scores").toArray();
+
+    mu::testing::Environment::setDependency({
+        new mu::fonts::FontsModule(),
+        new mu::instruments::InstrumentsModule(),
+        new mu::uicomponents::UiComponentsModule()
+    });
+    mu::testing::Environment::setPreInit([]() {
+        MScore::noGui = true;
+        new MuseScoreCore();
+        MScore::init();
+    });
+    mu::testing::Environment::setup();
+    loadInstrumentTemplates(":/data/instruments.xml");
+
+    const QDir sourceRoot(BENCHMARK_SOURCE_ROOT);
+    QJsonArray scores;
+    bool failed = false;
+    for (const QJsonValue& entry : corpus) {
+        const QString name = entry.toObject().value("name").toString();
+        if (!only.isEmpty() && !only.contains(name)) {
+            continue;
+        }
+        const QString path = sourceRoot.absoluteFilePath(entry.toObject().value("path").toString());
+        QJsonObject result = benchmarkScore(name, path, iterations);
+        failed |= result.contains("error");
+        scores.append(result);
+    }
+
+    QJsonObject report;
+    report["version"] = QString(VERSION);
+    report["iterations"] = iterations;
+    report["scores"] = scores;
+    report["peakRss"] = peakRss();
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet("output")) {
+        QFile out(parser.value("output"));
+        if (!out.open(QIODevice::WriteOnly) || out.write(json) != json.size()) {
+            qCritical("cannot write <%s>", qPrintable(out.fileName()));
+            return 1;
+        }
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -366,7 +366,7 @@ void Bend::write(XmlWriter& xml) const
 void Bend::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (readStyledProperty(e, tag)) {
         } else if (tag == "point") {
@@ -91,6 +91,7 @@ public:
 
     virtual QVariant getProperty(Pid propertyId) const override;
     virtual bool setProperty(Pid propertyId, const QVariant&) override;
+    virtual bool setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     virtual QVariant propertyDefault(Pid) const override;
     virtual QString accessibleExtraInfo() const override;
 
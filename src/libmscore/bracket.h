@@ -98,6 +98,7 @@ public:
 
     QVariant getProperty(Pid propertyId) const override;
     bool setProperty(Pid propertyId, const QVariant&) override;
+    bool setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     QVariant propertyDefault(Pid) const override;
 
     void undoChangeProperty(Pid id, const QVariant& v, PropertyFlags ps) override;
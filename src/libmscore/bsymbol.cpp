@@ -61,7 +61,7 @@ void BSymbol::writeProperties(XmlWriter& xml) const
 
 bool BSymbol::readProperties(XmlReader& e)
 {
-    const QStringRef& tag = e.name();
+    const XmlTag& tag = e.name();
 
     if (Element::readProperties(e)) {
         return true;
@@ -13,6 +13,7 @@
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QtConcurrent>
 
 #include "score.h"
 #include "slur.h"
@@ -27,6 +28,9 @@
 #include "utils.h"
 
 namespace Ms {
+// below this the thread pool costs more than it saves
+static constexpr int PARALLEL_CHECK_MIN_MEASURES = 64;
+
 //---------------------------------------------------------
 //   checkSlurs
 //    helper routine to check for sanity slurs
@@ -174,72 +178,123 @@ void Score::checkScore()
 }
 
 //---------------------------------------------------------
-//   sanityCheck - Simple check for score
-///    Check that voice 1 is complete
-///    Check that voices > 1 contains less than measure duration
+//   sanityCheckMeasure
+//    the checks of sanityCheck() for one measure, which
+//    touch nothing but the measure; the messages are
+//    appended to error
 //---------------------------------------------------------
 
-bool Score::sanityCheck(const QString& name)
+static bool sanityCheckMeasure(Measure* m, int mNumber, int endStaff, QString& error)
 {
     bool result = true;
-    int mNumber = 1;
-    QString error;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        Fraction mLen = m->ticks();
-        int endStaff  = staves().size();
-        for (int staffIdx = 0; staffIdx < endStaff; ++staffIdx) {
-            Rest* fmrest0 = 0;            // full measure rest in voice 0
-            Fraction voices[VOICES];
+    Fraction mLen = m->ticks();
+    for (int staffIdx = 0; staffIdx < endStaff; ++staffIdx) {
+        Rest* fmrest0 = 0;                // full measure rest in voice 0
+        Fraction voices[VOICES];
 #ifndef NDEBUG
-            m->setCorrupted(staffIdx, false);
+        m->setCorrupted(staffIdx, false);
 #endif
-            for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-                for (int v = 0; v < VOICES; ++v) {
-                    ChordRest* cr = toChordRest(s->element(staffIdx * VOICES + v));
-                    if (cr == 0) {
-                        continue;
-                    }
-                    voices[v] += cr->actualTicks();
-                    if (v == 0 && cr->isRest()) {
-                        Rest* r = toRest(cr);
-                        if (r->durationType().isMeasure()) {
-                            fmrest0 = r;
-                        }
+        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (int v = 0; v < VOICES; ++v) {
+                ChordRest* cr = toChordRest(s->element(staffIdx * VOICES + v));
+                if (cr == 0) {
+                    continue;
+                }
+                voices[v] += cr->actualTicks();
+                if (v == 0 && cr->isRest()) {
+                    Rest* r = toRest(cr);
+                    if (r->durationType().isMeasure()) {
+                        fmrest0 = r;
                     }
                 }
             }
-            if (voices[0] != mLen) {
-                QString msg = QObject::tr("Measure %1, staff %2 incomplete. Expected: %3; Found: %4").arg(mNumber).arg(staffIdx + 1).arg(
-                    mLen.print(), voices[0].print());
-                qDebug() << msg;
-                error += QString("%1\n").arg(msg);
+        }
+        if (voices[0] != mLen) {
+            QString msg = QObject::tr("Measure %1, staff %2 incomplete. Expected: %3; Found: %4").arg(mNumber).arg(staffIdx + 1).arg(
+                mLen.print(), voices[0].print());
+            qDebug() << msg;
+            error += QString("%1\n").arg(msg);
 #ifndef NDEBUG
-                m->setCorrupted(staffIdx, true);
+            m->setCorrupted(staffIdx, true);
 #endif
-                result = false;
-                // try to fix a bad full measure rest
-                if (fmrest0) {
-                    // fmrest0->setDuration(mLen * fmrest0->staff()->timeStretch(fmrest0->tick()));
-                    fmrest0->setTicks(mLen);
-                    if (fmrest0->actualTicks() != mLen) {
-                        fprintf(stderr,"whoo???\n");
-                    }
+            result = false;
+            // try to fix a bad full measure rest
+            if (fmrest0) {
+                // fmrest0->setDuration(mLen * fmrest0->staff()->timeStretch(fmrest0->tick()));
+                fmrest0->setTicks(mLen);
+                if (fmrest0->actualTicks() != mLen) {
+                    fprintf(stderr,"whoo???\n");
                 }
             }
-            for (int v = 1; v < VOICES; ++v) {
-                if (voices[v] > mLen) {
-                    QString msg = QObject::tr("Measure %1, staff %2, voice %3 too long. Expected: %4; Found: %5").arg(mNumber).arg(
-                        staffIdx + 1).arg(v + 1).arg(mLen.print(), voices[v].print());
-                    qDebug() << msg;
-                    error += QString("%1\n").arg(msg);
+        }
+        for (int v = 1; v < VOICES; ++v) {
+            if (voices[v] > mLen) {
+                QString msg = QObject::tr("Measure %1, staff %2, voice %3 too long. Expected: %4; Found: %5").arg(mNumber).arg(
+                    staffIdx + 1).arg(v + 1).arg(mLen.print(), voices[v].print());
+                qDebug() << msg;
+                error += QString("%1\n").arg(msg);
 #ifndef NDEBUG
-                    m->setCorrupted(staffIdx, true);
+                m->setCorrupted(staffIdx, true);
 #endif
-                    result = false;
-                }
+                result = false;
             }
         }
-        mNumber++;
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   sanityCheckMeasures
+//---------------------------------------------------------
+
+static void sanityCheckMeasures(const std::vector<Measure*>& measures, int endStaff, std::vector<QString>& errors,
+                                std::vector<char>& results)
+{
+    const int n = int(measures.size());
+    auto check = [&measures, &errors, &results, endStaff](int i) {
+        results[i] = sanityCheckMeasure(measures[i], i + 1, endStaff, errors[i]);
+    };
+#ifndef Q_OS_WASM
+    if (MScore::parallelLayout && n >= PARALLEL_CHECK_MIN_MEASURES) {
+        std::vector<int> indexes(n);
+        for (int i = 0; i < n; ++i) {
+            indexes[i] = i;
+        }
+        QtConcurrent::blockingMap(indexes, check);
+        return;
+    }
+#endif
+    for (int i = 0; i < n; ++i) {
+        check(i);
+    }
+}
+
+//---------------------------------------------------------
+//   sanityCheck - Simple check for score
+///    Check that voice 1 is complete
+///    Check that voices > 1 contains less than measure duration
+///    The measures are checked at the same time, the
+///    messages are collected in measure order.
+//---------------------------------------------------------
+
+bool Score::sanityCheck(const QString& name)
+{
+    std::vector<Measure*> measures;
+    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
+        measures.push_back(m);
+    }
+    const int n        = int(measures.size());
+    const int endStaff = nstaves();
+
+    std::vector<QString> errors(n);
+    std::vector<char> results(n, true);
+    sanityCheckMeasures(measures, endStaff, errors, results);
+
+    bool result = true;
+    QString error;
+    for (int i = 0; i < n; ++i) {
+        result = result && results[i];
+        error += errors[i];
     }
     if (!name.isEmpty()) {
         QJsonObject json;
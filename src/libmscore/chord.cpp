@@ -1117,7 +1117,7 @@ void Chord::read(XmlReader& e)
 
 bool Chord::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "Note") {
         Note* note = new Note(score());
@@ -3551,24 +3551,24 @@ Shape Chord::shape() const
 {
     Shape shape;
     if (_hook && _hook->addToSkyline()) {
-        shape.add(_hook->shape().translated(_hook->pos()));
+        shape.add(_hook->shape(), _hook->pos());
     }
     if (_stem && _stem->addToSkyline()) {
         // stem direction is not known soon enough for cross staff beamed notes
         if (!(beam() && (staffMove() || beam()->cross()))) {
-            shape.add(_stem->shape().translated(_stem->pos()));
+            shape.add(_stem->shape(), _stem->pos());
         }
     }
     if (_stemSlash && _stemSlash->addToSkyline()) {
-        shape.add(_stemSlash->shape().translated(_stemSlash->pos()));
+        shape.add(_stemSlash->shape(), _stemSlash->pos());
     }
     if (_arpeggio && _arpeggio->addToSkyline()) {
-        shape.add(_arpeggio->shape().translated(_arpeggio->pos()));
+        shape.add(_arpeggio->shape(), _arpeggio->pos());
     }
 //      if (_tremolo)
 //            shape.add(_tremolo->shape().translated(_tremolo->pos()));
     for (Note* note : _notes) {
-        shape.add(note->shape().translated(note->pos()));
+        shape.add(note->shape(), note->pos());
         for (Element* e : note->el()) {
             if (!e->addToSkyline()) {
                 continue;
@@ -3580,15 +3580,15 @@ Shape Chord::shape() const
     }
     for (Element* e : el()) {
         if (e->addToSkyline()) {
-            shape.add(e->shape().translated(e->pos()));
+            shape.add(e->shape(), e->pos());
         }
     }
     for (Chord* chord : _graceNotes) {    // process grace notes last, needed for correct shape calculation
-        shape.add(chord->shape().translated(chord->pos()));
+        shape.add(chord->shape(), chord->pos());
     }
     shape.add(ChordRest::shape());      // add lyrics
     for (LedgerLine* l = _ledgerLines; l; l = l->next()) {
-        shape.add(l->shape().translated(l->pos()));
+        shape.add(l->shape(), l->pos());
     }
     if (_spaceLw || _spaceRw) {
         shape.addHorizontalSpacing(Shape::SPACING_GENERAL, -_spaceLw, _spaceRw);
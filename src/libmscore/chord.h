@@ -23,6 +23,7 @@
 #include <functional>
 #include "chordrest.h"
 #include "articulation.h"
+#include "elementpool.h"
 
 namespace Ms {
 class Note;
@@ -58,6 +59,8 @@ enum class TremoloChordType : char {
 
 class Chord final : public ChordRest
 {
+    ELEMENT_POOL_ALLOCATION
+
     std::vector<Note*> _notes;           // sorted to decreasing line step
     LedgerLine* _ledgerLines;            // single linked list
 
@@ -79,6 +82,8 @@ class Chord final : public ChordRest
     qreal _spaceLw;
     qreal _spaceRw;
 
+    uint _frettingKey { 0 };             ///< pitches, frets and tuning of the last fretting of a TAB chord, 0 if none
+
     QVector<Articulation*> _articulations;
 
     qreal upPos()   const override;
@@ -205,6 +210,9 @@ public:
 
     PlayEventType playEventType() const { return _playEventType; }
     void setPlayEventType(PlayEventType v) { _playEventType = v; }
+
+    uint frettingKey() const { return _frettingKey; }
+    void setFrettingKey(uint val) { _frettingKey = val; }
     QList<NoteEventList> getNoteEventLists();
     void setNoteEventLists(QList<NoteEventList>& nel);
 
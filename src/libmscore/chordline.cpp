@@ -147,7 +147,7 @@ void ChordLine::read(XmlReader& e)
 {
     path = QPainterPath();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Path") {
             path = QPainterPath();
             QPointF curveTo;
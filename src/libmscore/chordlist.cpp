@@ -313,7 +313,7 @@ void HChord::add(const QList<HDegree>& degreeList)
 //   readRenderList
 //---------------------------------------------------------
 
-static void readRenderList(QString val, QList<RenderAction>& renderList)
+static void readRenderList(QString val, RenderActionList& renderList)
 {
     renderList.clear();
     QStringList sl = val.split(" ", Qt::SkipEmptyParts);
@@ -356,7 +356,7 @@ static void readRenderList(QString val, QList<RenderAction>& renderList)
 //   writeRenderList
 //---------------------------------------------------------
 
-static void writeRenderList(XmlWriter& xml, const QList<RenderAction>* al, const QString& name)
+static void writeRenderList(XmlWriter& xml, const RenderActionList* al, const QString& name)
 {
     QString s;
 
@@ -409,7 +409,7 @@ void ChordToken::read(XmlReader& e)
         tokenClass = ChordTokenClass::ALL;
     }
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "name") {
             names += e.readElementText();
         } else if (tag == "render") {
@@ -1492,7 +1492,7 @@ qreal ChordList::position(const QStringList& names, ChordTokenClass ctc) const
 //   renderList
 //---------------------------------------------------------
 
-const QList<RenderAction>& ParsedChord::renderList(const ChordList* cl)
+const RenderActionList& ParsedChord::renderList(const ChordList* cl)
 {
     // generate anew on each call,
     // in case chord list has changed since last time
@@ -1502,7 +1502,7 @@ const QList<RenderAction>& ParsedChord::renderList(const ChordList* cl)
     bool adjust = cl ? cl->autoAdjust() : false;
     for (const ChordToken& tok : qAsConst(_tokenList)) {
         QString n = tok.names.first();
-        QList<RenderAction> rl;
+        RenderActionList rl;
         QList<ChordToken> definedTokens;
         bool found = false;
         // potential definitions for token
@@ -1653,7 +1653,7 @@ void ChordDescription::read(XmlReader& e)
     int ni = 0;
     id = e.attribute("id").toInt();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "name") {
             QString n = e.readElementText();
             // stack names for this file on top of the list
@@ -1705,6 +1705,8 @@ void ChordDescription::write(XmlWriter& xml) const
 
 int ChordList::privateID = -1000;
 
+static const int MAX_PARSED_CHORDS = 4096;
+
 //---------------------------------------------------------
 //   configureAutoAdjust
 //---------------------------------------------------------
@@ -1736,10 +1738,11 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 
 void ChordList::read(XmlReader& e)
 {
+    clearCaches();
     int fontIdx = fonts.size();
     _autoAdjust = false;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "font") {
             ChordFont f;
             f.family = e.attribute("family", "default");
@@ -1993,6 +1996,7 @@ bool ChordList::loaded() const
 
 void ChordList::unload()
 {
+    clearCaches();
     clear();
     symbols.clear();
     fonts.clear();
@@ -2002,6 +2006,101 @@ void ChordList::unload()
     _autoAdjust = false;
 }
 
+//---------------------------------------------------------
+//   clearCaches
+//---------------------------------------------------------
+
+void ChordList::clearCaches()
+{
+    _nameIndex.clear();
+    _handleIndex.clear();
+    _indexedSize = -1;
+    for (auto& parsedChords : _parsedChords) {
+        parsedChords.clear();
+    }
+    _parsedChordCount = 0;
+}
+
+//---------------------------------------------------------
+//   updateIndex
+//    the descriptions are replaced only by read(), which
+//    clears the index, and are added by Harmony, so a
+//    change of the size means new descriptions
+//---------------------------------------------------------
+
+void ChordList::updateIndex() const
+{
+    if (_indexedSize == size()) {
+        return;
+    }
+    _nameIndex.clear();
+    _handleIndex.clear();
+    for (auto i = cbegin(); i != cend(); ++i) {
+        const ChordDescription& cd = i.value();
+        // the parsed forms of a description without names are never matched
+        if (cd.names.empty()) {
+            continue;
+        }
+        for (const QString& name : cd.names) {
+            if (!_nameIndex.contains(name)) {
+                _nameIndex.insert(name, i.key());
+            }
+        }
+        for (const ParsedChord& pc : cd.parsedChords) {
+            _handleIndex.insert(pc.handle(), i.key());          // the last one matches
+        }
+    }
+    _indexedSize = size();
+}
+
+//---------------------------------------------------------
+//   description
+//    look up name in chord list
+//    optionally look up by parsed chord as fallback
+//    return chord description if found, or null
+//---------------------------------------------------------
+
+const ChordDescription* ChordList::description(const QString& name, const ParsedChord* pc) const
+{
+    updateIndex();
+    auto i = _nameIndex.constFind(name);
+    if (i == _nameIndex.cend() && pc) {
+        i = _handleIndex.constFind(pc->handle());
+        if (i == _handleIndex.cend()) {
+            return nullptr;
+        }
+    } else if (i == _nameIndex.cend()) {
+        return nullptr;
+    }
+    auto cd = constFind(i.value());
+    return cd == cend() ? nullptr : &cd.value();
+}
+
+//---------------------------------------------------------
+//   parsedChord
+//    the chord parsed against this chord list, the same
+//    text is parsed only once
+//---------------------------------------------------------
+
+const ParsedChord& ChordList::parsedChord(const QString& s, bool syntaxOnly, bool preferMinor) const
+{
+    QHash<QString, ParsedChord>& parsedChords = _parsedChords[(syntaxOnly ? 2 : 0) + (preferMinor ? 1 : 0)];
+    auto i = parsedChords.find(s);
+    if (i != parsedChords.end()) {
+        return i.value();
+    }
+    if (_parsedChordCount >= MAX_PARSED_CHORDS) {
+        for (auto& pcs : _parsedChords) {
+            pcs.clear();
+        }
+        _parsedChordCount = 0;
+    }
+    ParsedChord pc;
+    pc.parse(s, this, syntaxOnly, preferMinor);
+    ++_parsedChordCount;
+    return parsedChords.insert(s, pc).value();
+}
+
 //---------------------------------------------------------
 //   print
 //    only for debugging
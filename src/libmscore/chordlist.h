@@ -13,7 +13,9 @@
 #ifndef __CHORDLIST_H__
 #define __CHORDLIST_H__
 
+#include <QHash>
 #include <QMap>
+#include <QVector>
 
 namespace Ms {
 class XmlWriter;
@@ -109,6 +111,13 @@ struct RenderAction {
         : type(t) {}
     void print() const;
 };
+}     // namespace Ms
+
+Q_DECLARE_TYPEINFO(Ms::RenderAction, Q_MOVABLE_TYPE);
+
+namespace Ms {
+// the actions in one block, not one allocation each as in a QList
+using RenderActionList = QVector<RenderAction>;
 
 //---------------------------------------------------------
 //   ChordToken
@@ -123,7 +132,7 @@ class ChordToken
 public:
     ChordTokenClass tokenClass;
     QStringList names;
-    QList<RenderAction> renderList;
+    RenderActionList renderList;
     void read(XmlReader&);
     void write(XmlWriter&) const;
 };
@@ -137,7 +146,7 @@ class ParsedChord
 public:
     bool parse(const QString&, const ChordList*, bool syntaxOnly = false, bool preferMinor = false);
     QString fromXml(const QString&, const QString&, const QString&, const QString&, const QList<HDegree>&,const ChordList*);
-    const QList<RenderAction>& renderList(const ChordList*);
+    const RenderActionList& renderList(const ChordList*);
     bool parseable() const { return _parseable; }
     bool understandable() const { return _understandable; }
     const QString& name() const { return _name; }
@@ -166,7 +175,7 @@ private:
     QString _modifiers;
     QStringList _modifierList;
     QList<ChordToken> _tokenList;
-    QList<RenderAction> _renderList;
+    RenderActionList _renderList;
     QString _xmlKind;
     QString _xmlText;
     QString _xmlSymbols;
@@ -197,7 +206,7 @@ struct ChordDescription {
     QString xmlParens;        // MusicXml: kind parentheses-degrees=
     QStringList xmlDegrees;   // MusicXml: list of degrees (if any)
     HChord chord;             // C based chord
-    QList<RenderAction> renderList;
+    RenderActionList renderList;
     bool generated = false;
     bool renderListGenerated = false;
     bool exportOk = false;
@@ -249,11 +258,22 @@ class ChordList : public QMap<int, ChordDescription>
     qreal _emag = 1.0, _eadjust = 0.0;
     qreal _mmag = 1.0, _madjust = 0.0;
 
+    // the descriptions by name and by parsed form, rebuilt when descriptions were added
+    mutable QHash<QString, int> _nameIndex;
+    mutable QHash<QString, int> _handleIndex;
+    mutable int _indexedSize = -1;
+    // the parsed chords by text, for each combination of syntaxOnly and preferMinor
+    mutable QHash<QString, ParsedChord> _parsedChords[4];
+    mutable int _parsedChordCount = 0;
+
+    void updateIndex() const;
+    void clearCaches();
+
 public:
     QList<ChordFont> fonts;
-    QList<RenderAction> renderListRoot;
-    QList<RenderAction> renderListFunction;
-    QList<RenderAction> renderListBase;
+    RenderActionList renderListRoot;
+    RenderActionList renderListFunction;
+    RenderActionList renderListBase;
     QList<ChordToken> chordTokenList;
     static int privateID;
 
@@ -270,6 +290,9 @@ public:
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    const ChordDescription* description(const QString& name, const ParsedChord* pc = nullptr) const;
+    const ParsedChord& parsedChord(const QString& s, bool syntaxOnly = false, bool preferMinor = false) const;
 };
 }     // namespace Ms
 #endif
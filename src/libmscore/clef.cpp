@@ -324,7 +324,7 @@ void Clef::setSmall(bool val)
 void Clef::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "concertClefType") {
             _clefTypes._concertClef = Clef::clefType(e.readElementText());
         } else if (tag == "transposingClefType") {
@@ -318,6 +318,7 @@ void Score::update(bool resetCmdState)
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
         if (cs.layoutRange()) {
+            ms->addPlaybackDirtyRange(cs.startTick(), cs.endTick());
             for (Score* s : ms->scoreList()) {
                 s->doLayoutRange(cs.startTick(), cs.endTick());
             }
@@ -327,8 +328,18 @@ void Score::update(bool resetCmdState)
 
     for (MasterScore* ms : *movements()) {
         CmdState& cs = ms->cmdState();
+        if (cs.updateAll() && !cs.layoutRange()) {
+            for (Score* s : ms->scoreList()) {
+                s->setAllChanged();
+            }
+        }
         if (updateAll || cs.updateAll()) {
             for (Score* s : scoreList()) {
+                // the areas elements were at before the command
+                if (!s->_updateState.refresh.isNull()) {
+                    s->addChangedArea(s->_updateState.refresh);
+                    s->_updateState.refresh = QRectF();
+                }
                 for (MuseScoreView* v : qAsConst(s->viewer)) {
                     v->updateAll();
                 }
@@ -337,6 +348,7 @@ void Score::update(bool resetCmdState)
             // updateRange updates only current score
             qreal d = spatium() * .5;
             _updateState.refresh.adjust(-d, -d, 2 * d, 2 * d);
+            addChangedArea(_updateState.refresh);
             for (MuseScoreView* v : qAsConst(viewer)) {
                 v->dataChanged(_updateState.refresh);
             }
@@ -753,6 +765,7 @@ Segment* Score::setNoteRest(Segment* segment, int track, NoteVal nval, Fraction
 
     bool isRest   = nval.pitch == -1;
     Fraction tick = segment->tick();
+    const Fraction stick = tick;
     Element* nr   = nullptr;
     Tie* tie      = nullptr;
     ChordRest* cr = toChordRest(segment->element(track));
@@ -873,7 +886,7 @@ Segment* Score::setNoteRest(Segment* segment, int track, NoteVal nval, Fraction
         }
     }
     if (tie) {
-        connectTies();
+        connectTies(stick, tick);
     }
     if (nr) {
         if (is.slur() && nr->type() == ElementType::NOTE) {
@@ -1386,6 +1399,7 @@ void Score::changeCRlen(ChordRest* cr, const Fraction& dstF, bool fillWithRest)
     deselectAll();
 
     Fraction tick  = cr->tick();
+    const Fraction stick = tick;
     Fraction f     = dstF;
     ChordRest* cr1 = cr;
     Chord* oc      = 0;
@@ -1474,7 +1488,7 @@ void Score::changeCRlen(ChordRest* cr, const Fraction& dstF, bool fillWithRest)
         expandVoice(s, track);
         cr1 = toChordRest(s->element(track));
     }
-    connectTies();
+    connectTies(stick, tick);
 }
 
 //---------------------------------------------------------
@@ -3147,7 +3161,28 @@ void Score::cmdExplode()
         }
         int full = 0;
 
-        for (Segment* seg = startSegment; seg && seg->tick() < lTick; seg = seg->next1()) {
+        // find once which tracks have notes in which measures:
+        // a destination track is free from a measure on if it
+        // has no notes after it
+        std::vector<Measure*> measures;
+        for (Measure* m = startMeasure; m && m->tick() < lTick; m = m->nextMeasure()) {
+            measures.push_back(m);
+        }
+        const int nTracks = lastStaff * VOICES - srcTrack;
+        std::vector<int> lastUsed(nTracks, -1);
+        std::vector<bool> used(measures.size() * VOICES, false);      // of the source tracks
+        for (int k = 0; k < int(measures.size()); ++k) {
+            for (int track = srcTrack; track < srcTrack + nTracks; ++track) {
+                if (measures[k]->hasVoice(track) && !measures[k]->isOnlyRests(track)) {
+                    lastUsed[track - srcTrack] = k;
+                    if (track < srcTrack + VOICES) {
+                        used[k * VOICES + track - srcTrack] = true;
+                    }
+                }
+            }
+        }
+
+        for (int k = 0; k < int(measures.size()) && full != VOICES; ++k) {
             for (int i = srcTrack; i < srcTrack + VOICES && full != VOICES; i++) {
                 bool t = true;
                 for (int j = 0; j < VOICES; j++) {
@@ -3157,27 +3192,16 @@ void Score::cmdExplode()
                     }
                 }
 
-                if (!seg->measure()->hasVoice(i) || seg->measure()->isOnlyRests(i) || !t) {
+                if (!used[k * VOICES + i - srcTrack] || !t) {
                     continue;
                 }
                 sTracks[full] = i;
 
                 for (int j = srcTrack + full * VOICES; j < lastStaff * VOICES; j++) {
-                    if (i == j) {
+                    if (i == j || lastUsed[j - srcTrack] < k) {
                         dTracks[full] = j;
                         break;
                     }
-                    for (Measure* m = seg->measure(); m && m->tick() < lTick; m = m->nextMeasure()) {
-                        if (!m->hasVoice(j) || (m->hasVoice(j) && m->isOnlyRests(j))) {
-                            dTracks[full] = j;
-                        } else {
-                            dTracks[full] = -1;
-                            break;
-                        }
-                    }
-                    if (dTracks[full] != -1) {
-                        break;
-                    }
                 }
                 full++;
             }
@@ -3585,6 +3609,7 @@ Segment* Score::setChord(Segment* segment, int track, Chord* chordTemplate, Frac
     Q_ASSERT(segment->segmentType() == SegmentType::ChordRest);
 
     Fraction tick = segment->tick();
+    const Fraction stick = tick;
     Chord* nr     = nullptr;   //current added chord used so we can select the last added chord and so we can apply ties
     std::vector<Tie*> tie(chordTemplate->notes().size());   //keep pointer to a tie for each note in the chord in case we need to tie notes
     ChordRest* cr = toChordRest(segment->element(track));   //chord rest under the segment for the specified track
@@ -3724,7 +3749,7 @@ Segment* Score::setChord(Segment* segment, int track, Chord* chordTemplate, Frac
         }
     }
     if (!tie.empty()) {
-        connectTies();
+        connectTies(stick, tick);
     }
     if (nr) {
         select(nr, SelectType::SINGLE, 0);
@@ -371,7 +371,7 @@ bool ConnectorInfoReader::read()
     e.fillLocation(_currentLoc);
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "prev") {
             readEndpointLocation(_prevLoc);
@@ -404,7 +404,7 @@ void ConnectorInfoReader::readEndpointLocation(Location& l)
 {
     XmlReader& e = *_reader;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "location") {
             l = Location::relative();
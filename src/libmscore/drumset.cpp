@@ -10,6 +10,9 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <mutex>
+#include <vector>
+
 #include "drumset.h"
 #include "xml.h"
 #include "note.h"
@@ -91,7 +94,7 @@ bool Drumset::readProperties(XmlReader& e, int pitch)
         return false;
     }
 
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "head") {
         _drum[pitch].notehead = NoteHead::name2group(e.readElementText());
     } else if (tag == "noteheads") {
@@ -238,6 +241,68 @@ DrumInstrumentVariant Drumset::findVariant(int p, const QVector<Articulation*> a
     return div;
 }
 
+//---------------------------------------------------------
+//   DrumInstrument::operator==
+//---------------------------------------------------------
+
+bool DrumInstrument::operator==(const DrumInstrument& d) const
+{
+    if (name != d.name || notehead != d.notehead || line != d.line || stemDirection != d.stemDirection
+        || voice != d.voice || shortcut != d.shortcut || variants != d.variants) {
+        return false;
+    }
+    for (int i = 0; i < int(NoteHead::Type::HEAD_TYPES); ++i) {
+        if (noteheads[i] != d.noteheads[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   operator==
+//---------------------------------------------------------
+
+bool Drumset::operator==(const Drumset& d) const
+{
+    for (int i = 0; i < DRUM_INSTRUMENTS; ++i) {
+        if (_drum[i] != d._drum[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   shared
+//    a drumset equal to ds from the pool the instruments
+//    of all scores share; most scores only use the few
+//    drumsets of the instrument templates. The shared
+//    drumsets are not to be modified: an instrument
+//    copies its drumset before an edit.
+//---------------------------------------------------------
+
+std::shared_ptr<Drumset> Drumset::shared(const Drumset& ds)
+{
+    static std::mutex mutex;
+    static std::vector<std::weak_ptr<Drumset> > pool;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto i = pool.begin(); i != pool.end();) {
+        std::shared_ptr<Drumset> d = i->lock();
+        if (!d) {
+            i = pool.erase(i);
+        } else if (*d == ds) {
+            return d;
+        } else {
+            ++i;
+        }
+    }
+    std::shared_ptr<Drumset> d = std::make_shared<Drumset>(ds);
+    pool.push_back(d);
+    return d;
+}
+
 //---------------------------------------------------------
 //   initDrumset
 //    initialize standard midi drumset
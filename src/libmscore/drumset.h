@@ -13,6 +13,8 @@
 #ifndef __DRUMSET_H__
 #define __DRUMSET_H__
 
+#include <memory>
+
 #include "mscore.h"
 #include "tremolo.h"
 #include "note.h"
@@ -31,6 +33,11 @@ struct DrumInstrumentVariant {
         tremolo = TremoloType::INVALID_TREMOLO;
         articulationName = "";
     }
+
+    bool operator==(const DrumInstrumentVariant& v) const
+    {
+        return pitch == v.pitch && articulationName == v.articulationName && tremolo == v.tremolo;
+    }
 };
 
 //---------------------------------------------------------
@@ -56,6 +63,8 @@ struct DrumInstrument {
                    int v = 0, char sc = 0)
         : name(s), notehead(nh), line(l), stemDirection(d), voice(v), shortcut(sc) {}
     void addVariant(DrumInstrumentVariant v) { variants.append(v); }
+    bool operator==(const DrumInstrument&) const;
+    bool operator!=(const DrumInstrument& d) const { return !(*this == d); }
 };
 
 static const int DRUM_INSTRUMENTS = 128;
@@ -90,6 +99,11 @@ public:
     DrumInstrument& drum(int i) { return _drum[i]; }
     const DrumInstrument& drum(int i) const { return _drum[i]; }
     DrumInstrumentVariant findVariant(int pitch, const QVector<Articulation*> articulations, Tremolo* tremolo) const;
+
+    bool operator==(const Drumset&) const;
+    bool operator!=(const Drumset& d) const { return !(*this == d); }
+
+    static std::shared_ptr<Drumset> shared(const Drumset&);
 };
 
 extern Drumset* smDrumset;
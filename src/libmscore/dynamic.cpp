@@ -279,7 +279,7 @@ void Dynamic::write(XmlWriter& xml) const
 void Dynamic::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag = e.name();
+        const XmlTag& tag = e.name();
         if (tag == "subtype") {
             setDynamicType(e.readElementText());
         } else if (tag == "velocity") {
@@ -880,6 +880,11 @@ bool Score::rewriteMeasures(Measure* fm, Measure* lm, const Fraction& ns, int st
         }
     }
 
+    if (fmr && rebarEmptyMeasures(fm, lm, ns)) {
+        resetInputSegment();
+        return true;
+    }
+
     ScoreRange range;
     range.read(fm->first(), lm->last());
 
@@ -955,25 +960,191 @@ bool Score::rewriteMeasures(Measure* fm, Measure* lm, const Fraction& ns, int st
         undo(new MoveTremolo(trem->score(), chord1Tick, chord2Tick, trem, track));
     }
 
-    if (noteEntryMode()) {
-        // set input cursor to possibly re-written segment
-        Fraction icTick = inputPos();
-        Segment* icSegment = tick2segment(icTick, false, SegmentType::ChordRest);
-        if (!icSegment) {
-            // this can happen if cursor was on a rest
-            // and in the rewriting it got subsumed into a full measure rest
-            Measure* icMeasure = tick2measure(icTick);
-            if (!icMeasure) {                         // shouldn't happen, but just in case
-                icMeasure = firstMeasure();
+    resetInputSegment();
+    return true;
+}
+
+//---------------------------------------------------------
+//   rebarEmptyMeasures
+//    rewrite the measures fm to lm (including) in place if
+//    they hold nothing but full measure rests: the kept
+//    measures and their rests are set to the new length
+//    and measures are removed or appended at the end, the
+//    same result rewriteMeasures() gets by copying the
+//    range and replacing all measures. Returns false
+//    without any change if there is anything else.
+//---------------------------------------------------------
+
+bool Score::rebarEmptyMeasures(Measure* fm, Measure* lm, const Fraction& ns)
+{
+    const Fraction tick1 = fm->tick();
+    const Fraction tick2 = lm->endTick();
+
+    std::vector<std::vector<Measure*> > scoreMeasures;
+    for (Score* s : scoreList()) {
+        auto spanners = s->spannerMap().findOverlapping(tick1.ticks(), tick2.ticks());
+        for (auto i : spanners) {
+            if (i.value->tick() >= tick1 && i.value->tick() < tick2) {
+                return false;
+            }
+        }
+        std::vector<Measure*> ml;
+        for (Measure* m = s->tick2measure(tick1); m; m = m->nextMeasure()) {
+            if (!m->el().empty()) {
+                return false;
+            }
+            for (Segment* seg = m->first(); seg; seg = seg->next()) {
+                if (!seg->annotations().empty()) {
+                    return false;
+                }
+                if (seg->isChordRestType()) {
+                    if (!seg->rtick().isZero()) {
+                        return false;
+                    }
+                    for (int track = 0; track < s->ntracks(); ++track) {
+                        Element* e = seg->element(track);
+                        if (!e) {
+                            continue;
+                        }
+                        if ((track % VOICES) || !e->isRest() || toRest(e)->durationType() != TDuration::DurationType::V_MEASURE
+                            || toRest(e)->ticks() != m->ticks()) {
+                            return false;
+                        }
+                    }
+                } else if (m != fm || !seg->rtick().isZero()) {
+                    // the header of the first measure stays where it is,
+                    // anything else the user placed would be lost by the rewrite
+                    for (Element* e : seg->elist()) {
+                        if (e && !e->generated()) {
+                            return false;
+                        }
+                    }
+                }
+            }
+            ml.push_back(m);
+            if (m->tick() == lm->tick()) {
+                break;
             }
-            icSegment = icMeasure->first(SegmentType::ChordRest);
         }
-        inputState().setSegment(icSegment);
+        if (!scoreMeasures.empty() && ml.size() != scoreMeasures.front().size()) {
+            return false;
+        }
+        scoreMeasures.push_back(ml);
     }
 
+    //
+    // calculate number of required measures = nm
+    //
+    Fraction k = (tick2 - tick1) / ns;
+    int nm     = (k.numerator() + k.denominator() - 1) / k.denominator();
+    int measures = int(scoreMeasures.front().size());
+    int kept   = qMin(nm, measures);
+    Fraction fill = ns * Fraction(nm, 1) - (tick2 - tick1);
+
+    undoInsertTime(tick2, fill);
+
+    int idx = 0;
+    for (Score* s : scoreList()) {
+        const std::vector<Measure*>& ml = scoreMeasures[idx++];
+
+        // the measures kept
+        Fraction keptEnd = ml[kept - 1]->endTick();
+        Fraction diff    = ns * Fraction(kept, 1) - (keptEnd - tick1);
+        for (int i = 0; i < kept; ++i) {
+            Measure* m = ml[i];
+            if (!m->timesig().identical(ns)) {
+                m->undoChangeProperty(Pid::TIMESIG_NOMINAL, QVariant::fromValue(ns));
+            }
+            if (m->ticks() != ns) {
+                s->undo(new ChangeMeasureLen(m, ns));
+            }
+        }
+        if (!diff.isZero()) {
+            s->undo(new InsertTime(s, keptEnd, diff));
+        }
+
+        // the measures no longer needed
+        if (nm < measures) {
+            s->undoRemoveMeasures(ml[nm], ml.back(), true);
+        }
+
+        // the measures missing
+        Measure* nfm = 0;
+        Measure* nlm = 0;
+        Fraction tick = ml[kept - 1]->endTick();
+        for (int i = measures; i < nm; ++i) {
+            Measure* m = new Measure(s);
+            m->setPrev(nlm);
+            if (nlm) {
+                nlm->setNext(m);
+            }
+            m->setTimesig(ns);
+            m->setTicks(ns);
+            m->setTick(tick);
+            tick += m->ticks();
+            nlm = m;
+            if (nfm == 0) {
+                nfm = m;
+            }
+        }
+        if (nfm) {
+            Measure* pm = ml[kept - 1];
+            nfm->setPrev(pm);
+            nlm->setNext(pm->next());
+            s->undo(new InsertMeasures(nfm, nlm));
+        }
+    }
+
+    //
+    // the rests of the master score, changes and additions
+    // go to the linked staves
+    //
+    Fraction tick = tick1;
+    for (int i = 0; i < nm; ++i) {
+        Measure* m = tick2measure(tick);
+        for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+            int track = staffIdx * VOICES;
+            Rest* rest = toRest(m->findChordRest(m->tick(), track));
+            if (i < kept && rest) {
+                if (rest->ticks() != ns) {
+                    rest->undoChangeProperty(Pid::DURATION, QVariant::fromValue(ns));
+                }
+            } else if (i >= kept) {
+                rest = new Rest(this, TDuration(TDuration::DurationType::V_MEASURE));
+                rest->setTicks(ns);
+                rest->setTrack(track);
+                undoAddCR(rest, m, m->tick());
+            }
+        }
+        tick += ns;
+    }
     return true;
 }
 
+//---------------------------------------------------------
+//   resetInputSegment
+//    set input cursor to possibly re-written segment
+//---------------------------------------------------------
+
+void Score::resetInputSegment()
+{
+    if (!noteEntryMode()) {
+        return;
+    }
+    Fraction icTick = inputPos();
+    Segment* icSegment = tick2segment(icTick, false, SegmentType::ChordRest);
+    if (!icSegment) {
+        // this can happen if cursor was on a rest
+        // and in the rewriting it got subsumed into a full measure rest
+        Measure* icMeasure = tick2measure(icTick);
+        if (!icMeasure) {                         // shouldn't happen, but just in case
+            icMeasure = firstMeasure();
+        }
+        icSegment = icMeasure->first(SegmentType::ChordRest);
+    }
+    inputState().setSegment(icSegment);
+}
+
 //---------------------------------------------------------
 //   rewriteMeasures
 //    rewrite all measures up to the next time signature or section break
@@ -1631,7 +1802,7 @@ void Score::regroupNotesAndRests(const Fraction& startTick, const Fraction& endT
                         }
                     }
                     if (tie) {         // at least one tie was created
-                        connectTies();
+                        connectTies(startTick, endTick);
                     }
                 }
             }
@@ -3437,13 +3608,12 @@ void Score::cmdExchangeVoice(int s, int d)
         m2 = m2->nextMeasure();
     }
 
-    for (;;) {
-        undoExchangeVoice(m1, s, d, selection().staffStart(), selection().staffEnd());
-        m1 = m1->nextMeasure();
-        if ((m1 == 0) || (m2 && (m1->tick() == m2->tick()))) {
-            break;
-        }
+    // the measures are exchanged as one range
+    Measure* last = m1;
+    for (Measure* m = m1->nextMeasure(); m && !(m2 && m->tick() == m2->tick()); m = m->nextMeasure()) {
+        last = m;
     }
+    undoExchangeVoice(m1, last, s, d, selection().staffStart(), selection().staffEnd());
 }
 
 //---------------------------------------------------------
@@ -3575,6 +3745,24 @@ void Score::nextInputPos(ChordRest* cr, bool doSelect)
 
 void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmptyMeasures, bool moveSignaturesClef, bool needDeselectAll)
 {
+    insertMeasures(1, type, measure, createEmptyMeasures, moveSignaturesClef, needDeselectAll);
+}
+
+//---------------------------------------------------------
+//   insertMeasures
+//    Create count new MeasureBases of type type and insert
+//    them before measure, as one insertion: the ticks,
+//    spanners and signatures are moved once for all of
+//    them.
+//    If measure is zero, append the new MeasureBases.
+//---------------------------------------------------------
+
+void Score::insertMeasures(int count, ElementType type, MeasureBase* measure, bool createEmptyMeasures, bool moveSignaturesClef,
+                           bool needDeselectAll)
+{
+    if (count < 1) {
+        return;
+    }
     Fraction tick;
     if (measure) {
         if (measure->isMeasure()) {
@@ -3596,8 +3784,8 @@ void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmp
     }
 
     Fraction f       = sigmap()->timesig(tick.ticks()).nominal();   // use nominal time signature of current measure
-    Measure* om      = 0;                                         // measure base in "this" score
-    MeasureBase* rmb = 0;                                         // measure base in root score (for linking)
+    Measure* om      = 0;                                         // first measure in "this" score
+    std::vector<MeasureBase*> rmbs;                               // measure bases in root score (for linking)
     Fraction ticks   = { 0, 1 };
 
     for (Score* score : scoreList()) {
@@ -3625,24 +3813,35 @@ void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmp
                 qDebug("measure not found");
             }
         }
-        MeasureBase* mb = toMeasureBase(Element::create(type, score));
-        mb->setTick(tick);
+        std::vector<MeasureBase*> mbs;
+        Fraction mtick = tick;
+        for (int i = 0; i < count; ++i) {
+            MeasureBase* mb = toMeasureBase(Element::create(type, score));
+            mb->setTick(mtick);
+            if (mb->isMeasure()) {
+                Measure* m = toMeasure(mb);
+                m->setTimesig(f);
+                m->setTicks(f);
+                mtick += f;
+            }
+            if (!mbs.empty()) {
+                mbs.back()->setNext(mb);
+                mb->setPrev(mbs.back());
+            }
+            mbs.push_back(mb);
+        }
+        MeasureBase* mb = mbs.front();
 
         if (im) {
             im = im->top();       // don't try to insert in front of nested frame
         }
-        mb->setNext(im);
+        mbs.back()->setNext(im);
         mb->setPrev(im ? im->prev() : score->last());
-        if (mb->isMeasure()) {
-            Measure* m = toMeasure(mb);
-            m->setTimesig(f);
-            m->setTicks(f);
-        }
-        undo(new InsertMeasures(mb, mb));
+        undo(new InsertMeasures(mb, mbs.back()));
 
         if (type == ElementType::MEASURE) {
-            Measure* m  = toMeasure(mb);        // new measure
-            ticks       = m->ticks();
+            Measure* m  = toMeasure(mb);        // first new measure
+            ticks       = mtick - tick;
             Measure* mi = nullptr;              // insert before
             if (im) {
                 if (im->isMeasure()) {
@@ -3742,13 +3941,16 @@ void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmp
                 undoAddElement(nClef);
             }
         } else {
-            // a frame, not a measure
+            // frames, not measures
             if (score->isMaster()) {
-                rmb = mb;
-            } else if (rmb && mb != rmb) {
-                mb->linkTo(rmb);
-                if (rmb->isTBox()) {
-                    toTBox(mb)->text()->linkTo(toTBox(rmb)->text());
+                rmbs = mbs;
+            } else if (rmbs.size() == mbs.size()) {
+                for (size_t i = 0; i < mbs.size(); ++i) {
+                    MeasureBase* rmb = rmbs[i];
+                    mbs[i]->linkTo(rmb);
+                    if (rmb->isTBox()) {
+                        toTBox(mbs[i])->text()->linkTo(toTBox(rmb)->text());
+                    }
                 }
             }
         }
@@ -3758,18 +3960,21 @@ void Score::insertMeasure(ElementType type, MeasureBase* measure, bool createEmp
 
     if (om && !createEmptyMeasures) {
         //
-        // fill measure with rest
+        // fill measures with rests
         //
         Score* score = om->score();
 
-        // add rest to all staves and to all the staves linked to it
-        for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
-            int track = staffIdx * VOICES;
-            Rest* rest = new Rest(score, TDuration(TDuration::DurationType::V_MEASURE));
-            Fraction timeStretch(score->staff(staffIdx)->timeStretch(om->tick()));
-            rest->setTicks(om->ticks() * timeStretch);
-            rest->setTrack(track);
-            score->undoAddCR(rest, om, tick);
+        Measure* m = om;
+        for (int i = 0; i < count; ++i, m = m->nextMeasure()) {
+            // add rest to all staves and to all the staves linked to it
+            for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                int track = staffIdx * VOICES;
+                Rest* rest = new Rest(score, TDuration(TDuration::DurationType::V_MEASURE));
+                Fraction timeStretch(score->staff(staffIdx)->timeStretch(m->tick()));
+                rest->setTicks(m->ticks() * timeStretch);
+                rest->setTrack(track);
+                score->undoAddCR(rest, m, m->tick());
+            }
         }
     }
 
@@ -4136,6 +4341,44 @@ void Score::timeDelete(Measure* m, Segment* startSegment, const Fraction& f)
     }
 }
 
+//---------------------------------------------------------
+//   exchangeVoice
+//    exchanges the tracks in the measures first to last;
+//    the slurs starting or ending in the range are fixed
+//    in one pass at the end
+//---------------------------------------------------------
+
+void Score::exchangeVoice(Measure* first, Measure* last, int strack, int dtrack, int staffIdx)
+{
+    for (Measure* m = first; m; m = m->nextMeasure()) {
+        m->exchangeVoice(strack, dtrack, staffIdx);
+        if (m == last) {
+            break;
+        }
+    }
+
+    Fraction start = first->tick();
+    Fraction end   = last->endTick();
+    auto spanners = spannerMap().findOverlapping(start.ticks(), end.ticks() - 1);
+    for (auto i = spanners.begin(); i < spanners.end(); i++) {
+        Spanner* sp = i->value;
+        Fraction spStart = sp->tick();
+        Fraction spEnd = spStart + sp->ticks();
+        if (sp->isSlur() && (spStart >= start || spEnd < end)) {
+            if (sp->track() == strack && spStart >= start) {
+                sp->setTrack(dtrack);
+            } else if (sp->track() == dtrack && spStart >= start) {
+                sp->setTrack(strack);
+            }
+            if (sp->track2() == strack && spEnd < end) {
+                sp->setTrack2(dtrack);
+            } else if (sp->track2() == dtrack && spEnd < end) {
+                sp->setTrack2(strack);
+            }
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   cloneVoice
 //---------------------------------------------------------
@@ -4859,11 +5102,13 @@ void Score::undoTransposeHarmony(Harmony* h, int rootTpc, int baseTpc)
 
 //---------------------------------------------------------
 //   undoExchangeVoice
+//    for the measures first to last, with one undo command
+//    per staff
 //---------------------------------------------------------
 
-void Score::undoExchangeVoice(Measure* measure, int srcVoice, int dstVoice, int srcStaff, int dstStaff)
+void Score::undoExchangeVoice(Measure* first, Measure* last, int srcVoice, int dstVoice, int srcStaff, int dstStaff)
 {
-    Fraction tick = measure->tick();
+    Fraction tick = first->tick();
 
     for (int staffIdx = srcStaff; staffIdx < dstStaff; ++staffIdx) {
         QSet<Staff*> staffList;
@@ -4877,11 +5122,12 @@ void Score::undoExchangeVoice(Measure* measure, int srcVoice, int dstVoice, int
         int trackDiff = dstVoice - srcVoice;
 
         //handle score and complete measures first
-        undo(new ExchangeVoice(measure, srcTrack, dstTrack, staffIdx));
+        undo(new ExchangeVoice(first, last, srcTrack, dstTrack, staffIdx));
 
         for (Staff* st : staffList) {
             int staffTrack = st->idx() * VOICES;
-            Measure* measure2 = st->score()->tick2measure(tick);
+            Measure* first2 = st->score()->tick2measure(tick);
+            Measure* last2  = st->score()->tick2measure(last->tick());
             Excerpt* ex = st->score()->excerpt();
 
             if (ex) {
@@ -4902,13 +5148,13 @@ void Score::undoExchangeVoice(Measure* measure, int srcVoice, int dstVoice, int
                         if (staffTrack <= testTrack && testTrack < staffTrack + VOICES && dstTrackList.contains(testTrack)) {
                             hasVoice = true;
                             // voice is simply exchangeable now (deal directly)
-                            undo(new ExchangeVoice(measure2, srcTrack2, testTrack, staffTrack / 4));
+                            undo(new ExchangeVoice(first2, last2, srcTrack2, testTrack, staffTrack / 4));
                         }
                     }
 
                     // only source voice is in this staff
                     if (!hasVoice) {
-                        undo(new CloneVoice(measure->first(), measure2->endTick(), measure2->first(), tempTrack, srcTrack2,
+                        undo(new CloneVoice(first->first(), last2->endTick(), first2->first(), tempTrack, srcTrack2,
                                             tempTrack + trackDiff));
                         srcTrackList.removeOne(srcTrack2);
                     }
@@ -4932,14 +5178,14 @@ void Score::undoExchangeVoice(Measure* measure, int srcVoice, int dstVoice, int
 
                     // only destination voice is in this staff
                     if (!hasVoice) {
-                        undo(new CloneVoice(measure->first(), measure2->endTick(), measure2->first(), tempTrack, dstTrack2,
+                        undo(new CloneVoice(first->first(), last2->endTick(), first2->first(), tempTrack, dstTrack2,
                                             tempTrack - trackDiff));
                         dstTrackList.removeOne(dstTrack2);
                     }
                 }
             } else if (srcStaffTrack != staffTrack) {
                 // linked staff in same score (all voices present can be assumed)
-                undo(new ExchangeVoice(measure2, staffTrack + srcVoice, staffTrack + dstVoice, st->idx()));
+                undo(new ExchangeVoice(first2, last2, staffTrack + srcVoice, staffTrack + dstVoice, st->idx()));
             }
         }
     }
@@ -4947,29 +5193,34 @@ void Score::undoExchangeVoice(Measure* measure, int srcVoice, int dstVoice, int
     // make sure voice 0 is complete
 
     if (srcVoice == 0 || dstVoice == 0) {
-        for (int staffIdx = srcStaff; staffIdx < dstStaff; ++staffIdx) {
-            // check for complete timeline of voice 0
-            Fraction ctick  = measure->tick();
-            int track = staffIdx * VOICES;
-            for (Segment* s = measure->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-                ChordRest* cr = toChordRest(s->element(track));
-                if (cr == 0) {
-                    continue;
-                }
-                if (cr->isRest()) {
-                    Rest* r = toRest(cr);
-                    if (r->isGap()) {
-                        r->undoChangeProperty(Pid::GAP, false);
+        for (Measure* measure = first; measure; measure = measure->nextMeasure()) {
+            for (int staffIdx = srcStaff; staffIdx < dstStaff; ++staffIdx) {
+                // check for complete timeline of voice 0
+                Fraction ctick  = measure->tick();
+                int track = staffIdx * VOICES;
+                for (Segment* s = measure->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+                    ChordRest* cr = toChordRest(s->element(track));
+                    if (cr == 0) {
+                        continue;
                     }
+                    if (cr->isRest()) {
+                        Rest* r = toRest(cr);
+                        if (r->isGap()) {
+                            r->undoChangeProperty(Pid::GAP, false);
+                        }
+                    }
+                    if (ctick < s->tick()) {
+                        setRest(ctick, track, s->tick() - ctick, false, 0);             // fill gap
+                    }
+                    ctick = s->tick() + cr->actualTicks();
                 }
-                if (ctick < s->tick()) {
-                    setRest(ctick, track, s->tick() - ctick, false, 0);             // fill gap
+                Fraction etick = measure->endTick();
+                if (ctick < etick) {
+                    setRest(ctick, track, etick - ctick, false, 0);               // fill gap
                 }
-                ctick = s->tick() + cr->actualTicks();
             }
-            Fraction etick = measure->endTick();
-            if (ctick < etick) {
-                setRest(ctick, track, etick - ctick, false, 0);               // fill gap
+            if (measure == last) {
+                break;
             }
         }
     }
@@ -743,7 +743,7 @@ void Element::writeProperties(XmlWriter& xml) const
 
 bool Element::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (readProperty(tag, e, Pid::SIZE_SPATIUM_DEPENDENT)) {
     } else if (readProperty(tag, e, Pid::OFFSET)) {
@@ -1084,7 +1084,7 @@ ElementType Element::readType(XmlReader& e, QPointF* dragOffset,
     while (e.readNextStartElement()) {
         if (e.name() == "Element") {
             while (e.readNextStartElement()) {
-                const QStringRef& tag = e.name();
+                const XmlTag& tag = e.name();
                 if (tag == "dragOffset") {
                     *dragOffset = e.readPoint();
                 } else if (tag == "duration") {
@@ -1325,29 +1325,45 @@ void paintElement(mu::draw::Painter& painter, const Element* element)
     painter.translate(-elementPosition);
 }
 
+static bool paintOrder(Ms::Element* e1, Ms::Element* e2)
+{
+    if (e1->z() == e2->z()) {
+        if (e1->selected()) {
+            return false;
+        } else if (e2->selected()) {
+            return true;
+        } else if (!e1->visible()) {
+            return true;
+        } else if (!e2->visible()) {
+            return false;
+        }
+
+        return e1->track() > e2->track();
+    }
+
+    return e1->z() <= e2->z();
+}
+
 void paintElements(mu::draw::Painter& painter, const QList<Element*>& elements)
 {
     QList<Ms::Element*> sortedElements = elements;
 
-    std::sort(sortedElements.begin(), sortedElements.end(), [](Ms::Element* e1, Ms::Element* e2) {
-        if (e1->z() == e2->z()) {
-            if (e1->selected()) {
-                return false;
-            } else if (e2->selected()) {
-                return true;
-            } else if (!e1->visible()) {
-                return true;
-            } else if (!e2->visible()) {
-                return false;
-            }
+    std::sort(sortedElements.begin(), sortedElements.end(), paintOrder);
 
-            return e1->track() > e2->track();
+    for (const Element* element : sortedElements) {
+        if (!element->isInteractionAvailable()) {
+            continue;
         }
 
-        return e1->z() <= e2->z();
-    });
+        paintElement(painter, element);
+    }
+}
 
-    for (const Element* element : sortedElements) {
+void paintElements(mu::draw::Painter& painter, std::vector<Element*>& elements)
+{
+    std::sort(elements.begin(), elements.end(), paintOrder);
+
+    for (const Element* element : elements) {
         if (!element->isInteractionAvailable()) {
             continue;
         }
@@ -1472,6 +1488,52 @@ bool Element::setProperty(Pid propertyId, const QVariant& v)
     return true;
 }
 
+//---------------------------------------------------------
+//   getPropertyValue
+//---------------------------------------------------------
+
+PropertyValue Element::getPropertyValue(Pid propertyId) const
+{
+    switch (propertyId) {
+    case Pid::OFFSET:
+        return PropertyValue(_offset);
+    case Pid::MIN_DISTANCE:
+        return PropertyValue(_minDistance);
+    case Pid::AUTOPLACE:
+        return PropertyValue(autoplace());
+    case Pid::Z:
+        return PropertyValue(z());
+    default:
+        return getProperty(propertyId);
+    }
+}
+
+//---------------------------------------------------------
+//   setPropertyValue
+//    the properties of Element which no class handles in
+//    its setProperty() are set here without a QVariant.
+//    A class which handles one of them, or does more for
+//    every property it sets, goes through setProperty().
+//---------------------------------------------------------
+
+bool Element::setPropertyValue(Pid propertyId, const PropertyValue& v)
+{
+    using Type = PropertyValue::Type;
+    if (propertyId == Pid::OFFSET && v.type() == Type::POINT) {
+        _offset = v.toPointF();
+    } else if (propertyId == Pid::MIN_DISTANCE && v.type() == Type::SPATIUM) {
+        setMinDistance(v.toSpatium());
+    } else if (propertyId == Pid::AUTOPLACE && v.type() == Type::BOOL) {
+        setAutoplace(v.toBool());
+    } else if (propertyId == Pid::Z && v.type() == Type::INT) {
+        setZ(v.toInt());
+    } else {
+        return setProperty(propertyId, v.toVariant());
+    }
+    triggerLayout();
+    return true;
+}
+
 //---------------------------------------------------------
 //   undoChangeProperty
 //---------------------------------------------------------
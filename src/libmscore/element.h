@@ -502,6 +502,8 @@ public:
 
     virtual QVariant getProperty(Pid) const override;
     virtual bool setProperty(Pid, const QVariant&) override;
+    virtual PropertyValue getPropertyValue(Pid) const override;
+    virtual bool setPropertyValue(Pid, const PropertyValue&) override;
     virtual void undoChangeProperty(Pid id, const QVariant&, PropertyFlags ps) override;
     using ScoreElement::undoChangeProperty;
     virtual QVariant propertyDefault(Pid) const override;
@@ -643,6 +645,7 @@ extern void collectElements(void* data, Element* e);
 
 extern void paintElement(mu::draw::Painter& painter, const Element* element);
 extern void paintElements(mu::draw::Painter& painter, const QList<Element*>& elements);
+extern void paintElements(mu::draw::Painter& painter, std::vector<Element*>& elements);       // sorts elements
 }     // namespace Ms
 
 Q_DECLARE_METATYPE(Ms::ElementType);
@@ -0,0 +1,188 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "elementpool.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace Ms {
+namespace {
+constexpr std::size_t BLOCK_SIZE      = 64 * 1024;
+constexpr std::size_t ALIGNMENT       = alignof(std::max_align_t);
+constexpr std::size_t MAX_POOLED_SIZE = 2048;       // larger objects go to operator new
+constexpr std::size_t SIZE_CLASSES    = MAX_POOLED_SIZE / ALIGNMENT;
+
+struct SizeClass;
+
+//---------------------------------------------------------
+//   Block
+//    followed by its chunks. A chunk is the pointer to
+//    its block, padded to ALIGNMENT, and the object; a
+//    free chunk links to the next free one in the place
+//    of the object.
+//---------------------------------------------------------
+
+struct Block {
+    SizeClass* sizeClass;
+    Block* prev;
+    Block* next;
+    void* freeObjects;
+    int used;
+    bool available;           // in the list of blocks with free chunks
+};
+
+static_assert(sizeof(Block*) <= ALIGNMENT, "the block pointer must fit in front of the object");
+
+constexpr std::size_t FIRST_CHUNK = (sizeof(Block) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+//---------------------------------------------------------
+//   SizeClass
+//---------------------------------------------------------
+
+struct SizeClass {
+    std::mutex mutex;
+    std::size_t chunkSize { 0 };
+    Block* available { nullptr };
+};
+
+//---------------------------------------------------------
+//   sizeClass
+//    never destroyed, elements may still be deleted
+//    during static destruction
+//---------------------------------------------------------
+
+static SizeClass& sizeClass(std::size_t size)
+{
+    static SizeClass* sizeClasses = []() {
+        SizeClass* sc = new SizeClass[SIZE_CLASSES];
+        for (std::size_t i = 0; i < SIZE_CLASSES; ++i) {
+            sc[i].chunkSize = ALIGNMENT + (i + 1) * ALIGNMENT;
+        }
+        return sc;
+    }();
+    return sizeClasses[size ? (size - 1) / ALIGNMENT : 0];
+}
+
+//---------------------------------------------------------
+//   link
+//---------------------------------------------------------
+
+static void link(SizeClass& sc, Block* b)
+{
+    b->prev = nullptr;
+    b->next = sc.available;
+    if (sc.available) {
+        sc.available->prev = b;
+    }
+    sc.available = b;
+    b->available = true;
+}
+
+//---------------------------------------------------------
+//   unlink
+//---------------------------------------------------------
+
+static void unlink(SizeClass& sc, Block* b)
+{
+    if (b->prev) {
+        b->prev->next = b->next;
+    } else {
+        sc.available = b->next;
+    }
+    if (b->next) {
+        b->next->prev = b->prev;
+    }
+    b->available = false;
+}
+
+//---------------------------------------------------------
+//   newBlock
+//---------------------------------------------------------
+
+static Block* newBlock(SizeClass& sc)
+{
+    char* base = static_cast<char*>(std::malloc(BLOCK_SIZE));
+    if (!base) {
+        throw std::bad_alloc();
+    }
+    Block* b = new (base) Block { &sc, nullptr, nullptr, nullptr, 0, false };
+
+    const std::size_t chunks = (BLOCK_SIZE - FIRST_CHUNK) / sc.chunkSize;
+    for (std::size_t i = chunks; i > 0; --i) {
+        char* chunk = base + FIRST_CHUNK + (i - 1) * sc.chunkSize;
+        *reinterpret_cast<Block**>(chunk) = b;
+        void* object = chunk + ALIGNMENT;
+        *static_cast<void**>(object) = b->freeObjects;
+        b->freeObjects = object;
+    }
+    link(sc, b);
+    return b;
+}
+}     // namespace
+
+//---------------------------------------------------------
+//   allocate
+//---------------------------------------------------------
+
+void* ElementPool::allocate(std::size_t size)
+{
+    if (size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+    SizeClass& sc = sizeClass(size);
+    std::lock_guard<std::mutex> lock(sc.mutex);
+
+    Block* b = sc.available ? sc.available : newBlock(sc);
+    void* object = b->freeObjects;
+    b->freeObjects = *static_cast<void**>(object);
+    ++b->used;
+    if (!b->freeObjects) {
+        unlink(sc, b);
+    }
+    return object;
+}
+
+//---------------------------------------------------------
+//   deallocate
+//    a block without objects is freed unless it is the
+//    last one with free chunks, which is kept to not
+//    allocate and free a block over and over
+//---------------------------------------------------------
+
+void ElementPool::deallocate(void* p, std::size_t size)
+{
+    if (!p) {
+        return;
+    }
+    if (size > MAX_POOLED_SIZE) {
+        ::operator delete(p);
+        return;
+    }
+    Block* b = *reinterpret_cast<Block**>(static_cast<char*>(p) - ALIGNMENT);
+    SizeClass& sc = *b->sizeClass;
+    std::lock_guard<std::mutex> lock(sc.mutex);
+
+    *static_cast<void**>(p) = b->freeObjects;
+    b->freeObjects = p;
+    --b->used;
+    if (!b->available) {
+        link(sc, b);
+    }
+    if (b->used == 0 && (sc.available != b || b->next)) {
+        unlink(sc, b);
+        b->~Block();
+        std::free(b);
+    }
+}
+}     // namespace Ms
@@ -0,0 +1,51 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __ELEMENTPOOL_H__
+#define __ELEMENTPOOL_H__
+
+#include <cstddef>
+
+namespace Ms {
+//---------------------------------------------------------
+//   ElementPool
+//    allocator for the element types a score holds by
+//    the thousands. Objects of the same size are packed
+//    into 64 KB blocks, and a block is given back as soon
+//    as all of its objects are deleted, so that closing a
+//    score frees its memory in whole blocks. Thread safe,
+//    an object may be deleted by another thread than the
+//    one which created it.
+//---------------------------------------------------------
+
+class ElementPool
+{
+public:
+    static void* allocate(std::size_t size);
+    static void deallocate(void* p, std::size_t size);
+};
+
+//---------------------------------------------------------
+//   ELEMENT_POOL_ALLOCATION
+//    makes a class and the classes derived from it
+//    allocated from the ElementPool. The sized delete
+//    gets the size of the most derived class through the
+//    virtual destructor.
+//---------------------------------------------------------
+
+#define ELEMENT_POOL_ALLOCATION                                                                  \
+public:                                                                                         \
+    static void* operator new(std::size_t size) { return Ms::ElementPool::allocate(size); }     \
+    static void operator delete(void* p, std::size_t size) { Ms::ElementPool::deallocate(p, size); } \
+private:
+}     // namespace Ms
+#endif
@@ -106,7 +106,7 @@ void Excerpt::read(XmlReader& e)
     const QList<Part*>& pl = _oscore->parts();
     QString name;
     while (e.readNextStartElement()) {
-        const QStringRef& tag = e.name();
+        const XmlTag& tag = e.name();
         if (tag == "name") {
             name = e.readElementText();
         } else if (tag == "title") {
@@ -172,6 +172,43 @@ bool Excerpt::operator==(const Excerpt& e) const
 //---------------------------------------------------------
 
 void Excerpt::createExcerpt(Excerpt* excerpt)
+{
+    cloneExcerpt(excerpt);
+    finishExcerpts({ excerpt });
+}
+
+//---------------------------------------------------------
+//   finishExcerpts
+//    rebuilds the midi mapping once for the cloned
+//    excerpts of a score and lays them out
+//---------------------------------------------------------
+
+void Excerpt::finishExcerpts(const QList<Excerpt*>& excerpts)
+{
+    if (excerpts.isEmpty()) {
+        return;
+    }
+    MasterScore* oscore = excerpts.front()->oscore();
+    oscore->rebuildMidiMapping();
+    oscore->updateChannel();
+
+    for (Excerpt* excerpt : excerpts) {
+        Score* score = excerpt->partScore();
+        score->setPlaylistDirty();
+        score->setLayoutAll();
+        score->doLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   cloneExcerpt
+//    fills the part score of excerpt, without layout.
+//    The multimeasure rests of the part are only created
+//    by its first layout, as linked clones of the
+//    transposed elements.
+//---------------------------------------------------------
+
+void Excerpt::cloneExcerpt(Excerpt* excerpt)
 {
     MasterScore* oscore = excerpt->oscore();
     Score* score        = excerpt->partScore();
@@ -263,9 +300,7 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         score->setMetaTag("partName", partLabel);
     }
 
-    // initial layout of score
     score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
-    score->doLayout();
 
     // handle transposing instruments
     if (oscore->styleB(Sid::concertPitch) != score->styleB(Sid::concertPitch)) {
@@ -312,9 +347,6 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
                     Harmony* h  = toHarmony(e);
                     int rootTpc = Ms::transposeTpc(h->rootTpc(), interval, true);
                     int baseTpc = Ms::transposeTpc(h->baseTpc(), interval, true);
-                    // mmrests are on by default in part
-                    // if this harmony is attached to an mmrest,
-                    // be sure to transpose harmony in underlying measure as well
                     for (ScoreElement* se : h->linkList()) {
                         Harmony* hh = static_cast<Harmony*>(se);
                         // skip links to other staves (including in other scores)
@@ -333,14 +365,6 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
         //score->spatiumChanged(oscore->spatium(), score->spatium());
         score->styleChanged();
     }
-
-    // second layout of score
-    score->setPlaylistDirty();
-    oscore->rebuildMidiMapping();
-    oscore->updateChannel();
-
-    score->setLayoutAll();
-    score->doLayout();
 }
 
 //---------------------------------------------------------
@@ -402,12 +426,24 @@ void MasterScore::deleteExcerpt(Excerpt* excerpt)
 
 void MasterScore::initExcerpt(Excerpt* excerpt)
 {
-    Score* score = new Score(masterScore());
-    excerpt->setPartScore(score);
-    score->style().set(Sid::createMultiMeasureRests, true);
-    auto excerptCmdFake = new AddExcerpt(excerpt);
-    excerptCmdFake->redo(nullptr);
-    Excerpt::createExcerpt(excerpt);
+    initExcerpts({ excerpt });
+}
+
+//---------------------------------------------------------
+//   initExcerpts
+//---------------------------------------------------------
+
+void MasterScore::initExcerpts(const QList<Excerpt*>& excerpts)
+{
+    for (Excerpt* excerpt : excerpts) {
+        Score* score = new Score(masterScore());
+        excerpt->setPartScore(score);
+        score->style().set(Sid::createMultiMeasureRests, true);
+        auto excerptCmdFake = new AddExcerpt(excerpt);
+        excerptCmdFake->redo(nullptr);
+        Excerpt::cloneExcerpt(excerpt);
+    }
+    Excerpt::finishExcerpts(excerpts);
 }
 
 //---------------------------------------------------------
@@ -72,7 +72,7 @@ void Fermata::read(XmlReader& e)
 
 bool Fermata::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "subtype") {
         QString s = e.readElementText();
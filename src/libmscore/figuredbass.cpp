@@ -452,7 +452,7 @@ void FiguredBassItem::write(XmlWriter& xml) const
 void FiguredBassItem::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "brackets") {
             parenth[0] = (Parenthesis)e.intAttribute("b0");
@@ -487,6 +487,7 @@ void FiguredBassItem::layout()
 
     // construct font metrics
     int fontIdx = 0;
+    MScore::loadFontFamily(g_FBFonts.at(fontIdx).family);
     QFont f(g_FBFonts.at(fontIdx).family);
 
     // font size in pixels, scaled according to spatium()
@@ -606,6 +607,7 @@ void FiguredBassItem::draw(mu::draw::Painter* painter) const
     int font = 0;
     qreal _spatium = spatium();
     // set font from general style
+    MScore::loadFontFamily(g_FBFonts.at(font).family);
     QFont f(g_FBFonts.at(font).family);
 #ifdef USE_GLYPHS
     f.setHintingPreference(QFont::PreferVerticalHinting);
@@ -913,7 +915,7 @@ void FiguredBassItem::readMusicXML(XmlReader& e, bool paren)
 {
     // read the <figure> node de
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "figure-number") {
             // MusicXML spec states figure-number is a number
             // MuseScore can only handle single digit
@@ -1149,7 +1151,7 @@ void FiguredBass::read(XmlReader& e)
     QString normalizedText;
     int idx = 0;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "ticks") {
             setTicks(e.readFraction());
         } else if (tag == "onNote") {
@@ -1636,7 +1638,7 @@ FiguredBass* FiguredBass::addFiguredBassToSegment(Segment* seg, int track, const
 bool FiguredBassFont::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "family") {
             family = e.readElementText();
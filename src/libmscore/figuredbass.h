@@ -202,6 +202,7 @@ public:
 
     QVariant  getProperty(Pid propertyId) const override;
     bool      setProperty(Pid propertyId, const QVariant&) override;
+    bool      setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     QVariant  propertyDefault(Pid) const override;
 };
 
@@ -305,6 +306,7 @@ public:
 
     QVariant  getProperty(Pid propertyId) const override;
     bool      setProperty(Pid propertyId, const QVariant&) override;
+    bool      setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     QVariant  propertyDefault(Pid) const override;
 
     void appendItem(FiguredBassItem* item) { items.push_back(item); }
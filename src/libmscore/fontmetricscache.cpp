@@ -0,0 +1,141 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "fontmetricscache.h"
+
+#include <memory>
+#include <mutex>
+
+#include <QFontMetricsF>
+#include <QHash>
+
+#include "mscore.h"
+
+namespace Ms {
+static const int MAX_RUNS = 64 * 1024;       // strings of all fonts, more are dropped all at once
+
+namespace {
+struct Run {
+    qreal width      { -1.0 };
+    QRectF tightRect;
+    bool hasTightRect { false };
+};
+
+struct FontEntry {
+    QFontMetricsF fm;
+    FontMetricsCache::Metrics metrics;
+    QHash<QString, Run> runs;
+
+    FontEntry(const QFont& font)
+        : fm(font, MScore::paintDevice())
+    {
+        metrics.ascent      = fm.ascent();
+        metrics.descent     = fm.descent();
+        metrics.height      = fm.height();
+        metrics.lineSpacing = fm.lineSpacing();
+        metrics.xHeight     = fm.xHeight();
+    }
+};
+
+struct Cache {
+    std::mutex mutex;
+    QHash<QFont, std::shared_ptr<FontEntry> > fonts;
+    int runCount { 0 };
+
+    FontEntry& entry(const QFont& font)
+    {
+        auto i = fonts.find(font);
+        if (i == fonts.end()) {
+            i = fonts.insert(font, std::make_shared<FontEntry>(font));
+        }
+        return *i.value();
+    }
+
+    Run& run(FontEntry& e, const QString& text)
+    {
+        auto i = e.runs.find(text);
+        if (i != e.runs.end()) {
+            return i.value();
+        }
+        if (runCount >= MAX_RUNS) {
+            for (auto& f : fonts) {
+                f->runs.clear();
+            }
+            runCount = 0;
+        }
+        ++runCount;
+        return e.runs[text];
+    }
+};
+}
+
+static Cache& cache()
+{
+    static Cache c;
+    return c;
+}
+
+//---------------------------------------------------------
+//   metrics
+//---------------------------------------------------------
+
+FontMetricsCache::Metrics FontMetricsCache::metrics(const QFont& font)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.entry(font).metrics;
+}
+
+//---------------------------------------------------------
+//   width
+//---------------------------------------------------------
+
+qreal FontMetricsCache::width(const QFont& font, const QString& text)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    FontEntry& e = c.entry(font);
+    Run& r = c.run(e, text);
+    if (r.width < 0.0) {
+        r.width = e.fm.width(text);
+    }
+    return r.width;
+}
+
+//---------------------------------------------------------
+//   tightBoundingRect
+//---------------------------------------------------------
+
+QRectF FontMetricsCache::tightBoundingRect(const QFont& font, const QString& text)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    FontEntry& e = c.entry(font);
+    Run& r = c.run(e, text);
+    if (!r.hasTightRect) {
+        r.tightRect = e.fm.tightBoundingRect(text);
+        r.hasTightRect = true;
+    }
+    return r.tightRect;
+}
+
+//---------------------------------------------------------
+//   inFont
+//---------------------------------------------------------
+
+bool FontMetricsCache::inFont(const QFont& font, uint ucs4)
+{
+    Cache& c = cache();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.entry(font).fm.inFontUcs4(ucs4);
+}
+}     // namespace Ms
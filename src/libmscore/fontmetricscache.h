@@ -0,0 +1,47 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __FONTMETRICSCACHE_H__
+#define __FONTMETRICSCACHE_H__
+
+#include <QFont>
+#include <QRectF>
+#include <QString>
+
+namespace Ms {
+//---------------------------------------------------------
+//   FontMetricsCache
+//    the metrics of the fonts on MScore::paintDevice(),
+//    and the width and tight bounding rect of the strings
+//    laid out in them, as QFontMetricsF computes them.
+//    Shared by the whole process, the fonts are keyed by
+//    family, size and style, as QFont compares them.
+//---------------------------------------------------------
+
+class FontMetricsCache
+{
+public:
+    struct Metrics {
+        qreal ascent      { 0.0 };
+        qreal descent     { 0.0 };
+        qreal height      { 0.0 };
+        qreal lineSpacing { 0.0 };
+        qreal xHeight     { 0.0 };
+    };
+
+    static Metrics metrics(const QFont& font);
+    static qreal width(const QFont& font, const QString& text);
+    static QRectF tightBoundingRect(const QFont& font, const QString& text);
+    static bool inFont(const QFont& font, uint ucs4);
+};
+}     // namespace Ms
+#endif
@@ -19,28 +19,57 @@
 #include "mscore.h"
 
 namespace Ms {
+//---------------------------------------------------------
+//   countTrailingZeros
+//    v must not be 0
+//---------------------------------------------------------
+
+static constexpr int countTrailingZeros(uint_least64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1)) {
+        v >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
 //---------------------------------------------------------
 //   gcd
 //    greatest common divisor. always returns a positive val
 //    however, since int / uint = uint by C++ rules,
-//    return int to avoid accidental implicit unsigned cast
+//    return a signed value to avoid accidental implicit unsigned cast.
+//    Binary (Stein) algorithm: shifts and subtractions
+//    instead of the divisions of Euclid's algorithm
 //---------------------------------------------------------
 
-static int_least64_t gcd(int_least64_t a, int_least64_t b)
+static constexpr int_least64_t gcd(int_least64_t a, int_least64_t b)
 {
-    int bp;
-    if (b > a) {
-        bp = b;
-        b = a;
-        a = bp;
-    }                                       // Saves one % if true
-    while (b != 0) {
-        bp = b;
-        b = a % b;
-        a = bp;
+    uint_least64_t u = a < 0 ? -static_cast<uint_least64_t>(a) : static_cast<uint_least64_t>(a);
+    uint_least64_t v = b < 0 ? -static_cast<uint_least64_t>(b) : static_cast<uint_least64_t>(b);
+    if (u == 0) {
+        return static_cast<int_least64_t>(v);
     }
+    if (v == 0) {
+        return static_cast<int_least64_t>(u);
+    }
+    const int shift = countTrailingZeros(u | v);
+    u >>= countTrailingZeros(u);
+    do {
+        v >>= countTrailingZeros(v);
+        if (u > v) {
+            const uint_least64_t t = u;
+            u = v;
+            v = t;
+        }
+        v -= u;
+    } while (v != 0);
 
-    return a >= 0 ? a : -a;
+    return static_cast<int_least64_t>(u << shift);
 }
 
 //---------------------------------------------------------
@@ -65,13 +94,13 @@ public:
     constexpr Fraction(int z, int n)
         : _numerator{n < 0 ? -z : z}, _denominator{n < 0 ? -n : n} { }
 #endif
-    int numerator() const { return _numerator; }
-    int denominator() const { return _denominator; }
+    constexpr int numerator() const { return _numerator; }
+    constexpr int denominator() const { return _denominator; }
     int_least64_t& rnumerator() { return _numerator; }
     int_least64_t& rdenominator() { return _denominator; }
 
-    void setNumerator(int v) { _numerator = v; }
-    void setDenominator(int v)
+    constexpr void setNumerator(int v) { _numerator = v; }
+    constexpr void setDenominator(int v)
     {
         if (v < 0) {
             _numerator = -_numerator;
@@ -81,7 +110,7 @@ public:
         }
     }
 
-    void set(int z, int n)
+    constexpr void set(int z, int n)
     {
         if (n < 0) {
             _numerator = -z;
@@ -92,106 +121,124 @@ public:
         }
     }
 
-    bool isZero() const { return _numerator == 0; }
-    bool isNotZero() const { return _numerator != 0; }
-    bool negative() const { return _numerator < 0; }
+    constexpr bool isZero() const { return _numerator == 0; }
+    constexpr bool isNotZero() const { return _numerator != 0; }
+    constexpr bool negative() const { return _numerator < 0; }
 
-    bool isValid() const { return _denominator != 0; }
+    constexpr bool isValid() const { return _denominator != 0; }
 
     // check if two fractions are identical (numerator & denominator)
     // == operator checks for equal value:
-    bool identical(const Fraction& v) const
+    constexpr bool identical(const Fraction& v) const
     {
         return (_numerator == v._numerator)
                && (_denominator == v._denominator);
     }
 
-    Fraction absValue() const
+    constexpr Fraction absValue() const
     {
-        return Fraction(qAbs(_numerator), _denominator);
+        return Fraction(_numerator < 0 ? -_numerator : _numerator, _denominator);
     }
 
-    Fraction inverse() const
+    constexpr Fraction inverse() const
     {
         return Fraction(_denominator, _numerator);
     }
 
     // --- reduction --- //
 
-    void reduce()
+    constexpr void reduce()
     {
-        const int g = gcd(_numerator, _denominator);
+        const int_least64_t g = gcd(_numerator, _denominator);
         _numerator /= g;
         _denominator /= g;
     }
 
-    Fraction reduced() const
+    constexpr Fraction reduced() const
     {
-        const int g = gcd(_numerator, _denominator);
+        const int_least64_t g = gcd(_numerator, _denominator);
         return Fraction(_numerator / g, _denominator / g);
     }
 
     // --- comparison --- //
 
-    bool operator<(const Fraction& val) const
+    constexpr bool operator<(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator < val._numerator;
+        }
         return _numerator * val._denominator < val._numerator * _denominator;
     }
 
-    bool operator<=(const Fraction& val) const
+    constexpr bool operator<=(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator <= val._numerator;
+        }
         return _numerator * val._denominator <= val._numerator * _denominator;
     }
 
-    bool operator>=(const Fraction& val) const
+    constexpr bool operator>=(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator >= val._numerator;
+        }
         return _numerator * val._denominator >= val._numerator * _denominator;
     }
 
-    bool operator>(const Fraction& val) const
+    constexpr bool operator>(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator > val._numerator;
+        }
         return _numerator * val._denominator > val._numerator * _denominator;
     }
 
-    bool operator==(const Fraction& val) const
+    constexpr bool operator==(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator == val._numerator;
+        }
         return _numerator * val._denominator == val._numerator * _denominator;
     }
 
-    bool operator!=(const Fraction& val) const
+    constexpr bool operator!=(const Fraction& val) const
     {
+        if (_denominator == val._denominator) {
+            return _numerator != val._numerator;
+        }
         return _numerator * val._denominator != val._numerator * _denominator;
     }
 
     // --- arithmetic --- //
 
-    Fraction& operator+=(const Fraction& val)
+    constexpr Fraction& operator+=(const Fraction& val)
     {
         if (_denominator == val._denominator) {
             _numerator += val._numerator;        // Common enough use case to be handled separately for efficiency
         } else {
-            const int g = gcd(_denominator, val._denominator);
-            const int m1 = val._denominator / g;       // This saves one division over straight lcm
+            const int_least64_t g = gcd(_denominator, val._denominator);
+            const int_least64_t m1 = val._denominator / g;       // This saves one division over straight lcm
             _numerator = _numerator * m1 + val._numerator * (_denominator / g);
             _denominator = m1 * _denominator;
         }
         return *this;
     }
 
-    Fraction& operator-=(const Fraction& val)
+    constexpr Fraction& operator-=(const Fraction& val)
     {
         if (_denominator == val._denominator) {
             _numerator -= val._numerator;       // Common enough use case to be handled separately for efficiency
         } else {
-            const int g = gcd(_denominator, val._denominator);
-            const int m1 = val._denominator / g;       // This saves one division over straight lcm
+            const int_least64_t g = gcd(_denominator, val._denominator);
+            const int_least64_t m1 = val._denominator / g;       // This saves one division over straight lcm
             _numerator = _numerator * m1 - val._numerator * (_denominator / g);
             _denominator = m1 * _denominator;
         }
         return *this;
     }
 
-    Fraction& operator*=(const Fraction& val)
+    constexpr Fraction& operator*=(const Fraction& val)
     {
         _numerator *= val._numerator;
         _denominator *= val._denominator;
@@ -201,15 +248,15 @@ public:
         return *this;
     }
 
-    Fraction& operator*=(int val)
+    constexpr Fraction& operator*=(int val)
     {
         _numerator *= val;
         return *this;
     }
 
-    Fraction& operator/=(const Fraction& val)
+    constexpr Fraction& operator/=(const Fraction& val)
     {
-        const int sign = (val._numerator >= 0 ? 1 : -1);
+        const int_least64_t sign = (val._numerator >= 0 ? 1 : -1);
         _numerator   *= (sign * val._denominator);
         _denominator *= (sign * val._numerator);
         if (val._numerator != sign) {
@@ -218,7 +265,7 @@ public:
         return *this;
     }
 
-    Fraction& operator/=(int val)
+    constexpr Fraction& operator/=(int val)
     {
         _denominator *= val;
         if (_denominator < 0) {
@@ -229,12 +276,12 @@ public:
         return *this;
     }
 
-    Fraction operator+(const Fraction& v) const { return Fraction(*this) += v; }
-    Fraction operator-(const Fraction& v) const { return Fraction(*this) -= v; }
-    Fraction operator-() const { return Fraction(-_numerator, _denominator); }
-    Fraction operator*(const Fraction& v) const { return Fraction(*this) *= v; }
-    Fraction operator/(const Fraction& v) const { return Fraction(*this) /= v; }
-    Fraction operator/(int v)             const { return Fraction(*this) /= v; }
+    constexpr Fraction operator+(const Fraction& v) const { return Fraction(*this) += v; }
+    constexpr Fraction operator-(const Fraction& v) const { return Fraction(*this) -= v; }
+    constexpr Fraction operator-() const { return Fraction(-_numerator, _denominator); }
+    constexpr Fraction operator*(const Fraction& v) const { return Fraction(*this) *= v; }
+    constexpr Fraction operator/(const Fraction& v) const { return Fraction(*this) /= v; }
+    constexpr Fraction operator/(int v)             const { return Fraction(*this) /= v; }
 
     //---------------------------------------------------------
     //   fromTicks
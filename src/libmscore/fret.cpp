@@ -49,6 +49,7 @@ static const ElementStyle fretStyle {
 FretDiagram::FretDiagram(Score* score)
     : Element(score, ElementFlag::MOVABLE | ElementFlag::ON_STAFF)
 {
+    MScore::loadFontFamily("FreeSans");
     font.setFamily("FreeSans");
     font.setPointSize(4.0 * mag());
     initElementStyle(&fretStyle);
@@ -788,7 +789,7 @@ void FretDiagram::read(XmlReader& e)
     bool haveReadNew = false;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         // Check for new format fret diagram
         if (haveReadNew) {
@@ -861,7 +862,7 @@ void FretDiagram::read(XmlReader& e)
 void FretDiagram::readNew(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "string") {
             int no = e.intAttribute("no");
@@ -418,7 +418,7 @@ void Glissando::read(XmlReader& e)
 
     _showText = false;
     while (e.readNextStartElement()) {
-        const QStringRef& tag = e.name();
+        const XmlTag& tag = e.name();
         if (tag == "text") {
             _showText = true;
             readProperty(e, Pid::GLISS_TEXT);
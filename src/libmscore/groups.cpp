@@ -214,7 +214,7 @@ void Groups::write(XmlWriter& xml) const
 void Groups::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Node") {
             GroupNode n;
             n.pos    = e.intAttribute("pos");
@@ -713,7 +713,7 @@ void Hairpin::read(XmlReader& e)
     eraseSpannerSegments();
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             setHairpinType(HairpinType(e.readInt()));
         } else if (readStyledProperty(e, tag)) {
@@ -330,7 +330,7 @@ void Harmony::write(XmlWriter& xml) const
 void Harmony::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "base") {
             setBaseTpc(e.readInt());
         } else if (tag == "baseCase") {
@@ -771,8 +771,7 @@ const ChordDescription* Harmony::parseHarmony(const QString& ss, int* root, int*
     if (useLiteral) {
         cd = descr(s);
     } else {
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(s, cl, syntaxOnly, preferMinor);
+        _parsedForm = new ParsedChord(cl->parsedChord(s, syntaxOnly, preferMinor));
         // parser prepends "=" to name of implied minor chords
         // use this here as well
         if (preferMinor) {
@@ -1238,24 +1237,7 @@ const ChordDescription* Harmony::descr() const
 const ChordDescription* Harmony::descr(const QString& name, const ParsedChord* pc) const
 {
     const ChordList* cl = score()->style().chordList();
-    const ChordDescription* match = 0;
-    if (cl) {
-        for (const ChordDescription& cd : *cl) {
-            for (const QString& s : cd.names) {
-                if (s == name) {
-                    return &cd;
-                } else if (pc) {
-                    for (const ParsedChord& sParsed : cd.parsedChords) {
-                        if (sParsed == *pc) {
-                            match = &cd;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    // exact match failed, so fall back on parsed match if one was found
-    return match;
+    return cl ? cl->description(name, pc) : nullptr;
 }
 
 //---------------------------------------------------------
@@ -1662,7 +1644,7 @@ void Harmony::render(const QString& s, qreal& x, qreal& y)
 //   render
 //---------------------------------------------------------
 
-void Harmony::render(const QList<RenderAction>& renderList, qreal& x, qreal& y, int tpc, NoteSpellingType noteSpelling,
+void Harmony::render(const RenderActionList& renderList, qreal& x, qreal& y, int tpc, NoteSpellingType noteSpelling,
                      NoteCaseType noteCase)
 {
     ChordList* chordList = score()->style().chordList();
@@ -1776,6 +1758,7 @@ void Harmony::render()
         QFont ff(font());
         ff.setPointSizeF(ff.pointSizeF() * cf.mag);
         if (!(cf.family.isEmpty() || cf.family == "default")) {
+            MScore::loadFontFamily(cf.family);
             ff.setFamily(cf.family);
         }
         fontList.append(ff);
@@ -2000,8 +1983,7 @@ const ParsedChord* Harmony::parsedForm()
 {
     if (!_parsedForm) {
         ChordList* cl = score()->style().chordList();
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(_textName, cl, false);
+        _parsedForm = new ParsedChord(cl->parsedChord(_textName));
     }
     return _parsedForm;
 }
@@ -14,6 +14,7 @@
 #define __HOOK_H__
 
 #include "symbol.h"
+#include "elementpool.h"
 
 namespace Ms {
 class Chord;
@@ -24,6 +25,8 @@ class Chord;
 
 class Hook final : public Symbol
 {
+    ELEMENT_POOL_ALLOCATION
+
     int _hookType { 0 };
 
 public:
@@ -34,10 +34,8 @@ Image::Image(Score* s)
     : BSymbol(s, ElementFlag::MOVABLE)
 {
     imageType        = ImageType::NONE;
-    rasterDoc        = 0;
     _size            = QSizeF(0, 0);
     _storeItem       = 0;
-    _dirty           = false;
     _lockAspectRatio = defaultLockAspectRatio;
     _autoScale       = defaultAutoScale;
     _sizeIsSpatium   = defaultSizeIsSpatium;
@@ -48,11 +46,9 @@ Image::Image(const Image& img)
     : BSymbol(img)
 {
     imageType        = img.imageType;
-    buffer           = img.buffer;
     _size            = img._size;
     _lockAspectRatio = img._lockAspectRatio;
     _autoScale       = img._autoScale;
-    _dirty           = img._dirty;
     _storeItem       = img._storeItem;
     _sizeIsSpatium   = img._sizeIsSpatium;
     if (_storeItem) {
@@ -60,11 +56,6 @@ Image::Image(const Image& img)
     }
     _linkPath        = img._linkPath;
     _linkIsValid     = img._linkIsValid;
-    if (imageType == ImageType::RASTER) {
-        rasterDoc = img.rasterDoc ? new QImage(*img.rasterDoc) : 0;
-    } else if (imageType == ImageType::SVG) {
-        svgDoc = img.svgDoc ? new QSvgRenderer(_storeItem->buffer()) : 0;
-    }
     setZ(img.z());
 }
 
@@ -77,11 +68,6 @@ Image::~Image()
     if (_storeItem) {
         _storeItem->dereference(this);
     }
-    if (imageType == ImageType::SVG) {
-        delete svgDoc;
-    } else if (imageType == ImageType::RASTER) {
-        delete rasterDoc;
-    }
 }
 
 //---------------------------------------------------------
@@ -91,11 +77,7 @@ Image::~Image()
 void Image::setImageType(ImageType t)
 {
     imageType = t;
-    if (imageType == ImageType::SVG) {
-        svgDoc = 0;
-    } else if (imageType == ImageType::RASTER) {
-        rasterDoc = 0;
-    } else {
+    if (imageType == ImageType::NONE) {
         qDebug("illegal image type");
     }
 }
@@ -109,7 +91,7 @@ QSizeF Image::imageSize() const
     if (!isValid()) {
         return QSizeF();
     }
-    return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
+    return imageType == ImageType::RASTER ? _storeItem->rasterSize() : _storeItem->svgRenderer()->defaultSize();
 }
 
 //---------------------------------------------------------
@@ -120,13 +102,14 @@ void Image::draw(mu::draw::Painter* painter) const
 {
     bool emptyImage = false;
     if (imageType == ImageType::SVG) {
-        if (!svgDoc) {
+        if (!_storeItem) {
             emptyImage = true;
         } else {
-            svgDoc->render(painter->qpainter(), bbox());
+            _storeItem->svgRenderer()->render(painter->qpainter(), bbox());
         }
     } else if (imageType == ImageType::RASTER) {
-        if (rasterDoc == nullptr) {
+        const QSize rasterSize = _storeItem ? _storeItem->rasterSize() : QSize();
+        if (rasterSize.isEmpty()) {
             emptyImage = true;
         } else {
             painter->save();
@@ -138,17 +121,15 @@ void Image::draw(mu::draw::Painter* painter) const
             }
             if (score() && score()->printing() && !MScore::svgPrinting) {
                 // use original image size for printing, but not for svg for reasonable file size.
-                painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                painter->scale(s.width() / rasterSize.width(), s.height() / rasterSize.height());
+                painter->drawPixmap(QPointF(0, 0), _storeItem->rasterPixmap(QSize()));
             } else {
                 QTransform t = painter->transform();
                 QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
                 t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
                 painter->setWorldTransform(t);
-                if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
-                    buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                    _dirty = false;
-                }
+                // decoded at the size drawn, shared with the other images of the item
+                const QPixmap buffer = _storeItem->rasterPixmap(ss);
                 if (buffer.isNull()) {
                     emptyImage = true;
                 } else {
@@ -319,7 +300,7 @@ void Image::read(XmlReader& e)
     }
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "autoScale") {
             readProperty(e, Pid::AUTOSCALE);
         } else if (tag == "size") {
@@ -519,19 +500,6 @@ QSizeF Image::size2pixel(const QSizeF& s) const
 void Image::layout()
 {
     setPos(0.0, 0.0);
-    if (imageType == ImageType::SVG && !svgDoc) {
-        if (_storeItem) {
-            svgDoc = new QSvgRenderer(_storeItem->buffer());
-        }
-    } else if (imageType == ImageType::RASTER && !rasterDoc) {
-        if (_storeItem) {
-            rasterDoc = new QImage;
-            rasterDoc->loadFromData(_storeItem->buffer());
-            if (!rasterDoc->isNull()) {
-                _dirty = true;
-            }
-        }
-    }
     if (_size.isNull()) {
         _size = pixel2size(imageSize());
     }
@@ -623,7 +591,6 @@ bool Image::setProperty(Pid propertyId, const QVariant& v)
         break;
     }
     setGenerated(false);
-    _dirty = true;
     triggerLayout();
     return rv;
 }
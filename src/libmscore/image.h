@@ -30,10 +30,6 @@ enum class ImageType : char {
 
 class Image final : public BSymbol
 {
-    union {
-        QImage* rasterDoc;
-        QSvgRenderer* svgDoc;
-    };
     ImageType imageType;
 
     QSizeF pixel2size(const QSizeF& s) const;
@@ -44,12 +40,10 @@ protected:
     QString _storePath;             // the path of the img in the ImageStore
     QString _linkPath;              // the path of an external linked img
     bool _linkIsValid;              // whether _linkPath file exists or not
-    mutable QPixmap buffer;         ///< cached rendering
     QSizeF _size;                   // in mm or spatium units
     bool _lockAspectRatio;
     bool _autoScale;                ///< fill parent frame
     bool _sizeIsSpatium;
-    mutable bool _dirty;
 
     bool isEditable() const override { return true; }
     void startEditDrag(EditData&) override;
@@ -88,13 +82,14 @@ public:
 
     QVariant getProperty(Pid) const override;
     bool setProperty(Pid propertyId, const QVariant&) override;
+    bool setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     QVariant propertyDefault(Pid id) const override;
 
     QSizeF imageSize() const;
 
     void setImageType(ImageType);
     ImageType getImageType() const { return imageType; }
-    bool isValid() const { return rasterDoc || svgDoc; }
+    bool isValid() const { return _storeItem && imageType != ImageType::NONE; }
 
     Element::EditBehavior normalModeEditBehavior() const override { return Element::EditBehavior::Edit; }
     int gripsCount() const override { return 2; }
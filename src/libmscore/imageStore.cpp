@@ -10,7 +10,14 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <mutex>
+
 #include <QtCore/QCryptographicHash>
+#include <QBuffer>
+#include <QCache>
+#include <QImageReader>
+#include <QSvgRenderer>
+
 #include "imageStore.h"
 #include "score.h"
 #include "image.h"
@@ -27,6 +34,105 @@ ImageStoreItem::ImageStoreItem(const QString& p)
     setPath(p);
 }
 
+ImageStoreItem::~ImageStoreItem()
+{
+}
+
+//---------------------------------------------------------
+//   decodedImages
+//    the pixmaps of all items by hash and size, the least
+//    recently used are dropped first; the cost is in KB
+//---------------------------------------------------------
+
+static const int DECODED_IMAGES_MAX_KB = 64 * 1024;
+
+static QCache<QByteArray, QPixmap>& decodedImages()
+{
+    static QCache<QByteArray, QPixmap> cache(DECODED_IMAGES_MAX_KB);
+    return cache;
+}
+
+static std::mutex decodedImagesMutex;
+
+//---------------------------------------------------------
+//   set
+//---------------------------------------------------------
+
+void ImageStoreItem::set(const QByteArray& b, const QByteArray& h)
+{
+    _buffer = b;
+    _hash = h;
+    _rasterSize = QSize();
+    _svgRenderer.reset();
+}
+
+//---------------------------------------------------------
+//   rasterSize
+//    the size in pixels of a raster image, without
+//    decoding it
+//---------------------------------------------------------
+
+QSize ImageStoreItem::rasterSize() const
+{
+    if (!_rasterSize.isValid()) {
+        QBuffer b;
+        b.setData(_buffer);
+        QImageReader reader(&b);
+        _rasterSize = reader.size();
+        if (!_rasterSize.isValid()) {
+            // the format does not tell the size in its header
+            _rasterSize = reader.read().size();
+        }
+    }
+    return _rasterSize;
+}
+
+//---------------------------------------------------------
+//   rasterPixmap
+//    the raster image decoded and scaled to size, of its
+//    own size if size is empty
+//---------------------------------------------------------
+
+QPixmap ImageStoreItem::rasterPixmap(const QSize& size) const
+{
+    const QSize s = size.isEmpty() ? rasterSize() : size;
+    if (s.isEmpty()) {
+        return QPixmap();
+    }
+    QByteArray key = _hash;
+    key += QByteArray::number(s.width()) + 'x' + QByteArray::number(s.height());
+
+    std::lock_guard<std::mutex> lock(decodedImagesMutex);
+    if (const QPixmap* pm = decodedImages().object(key)) {
+        return *pm;
+    }
+    QBuffer b;
+    b.setData(_buffer);
+    QImageReader reader(&b);
+    if (s != rasterSize()) {
+        reader.setScaledSize(s);        // formats which cannot decode at that size are scaled smoothly
+    }
+    QPixmap pm = QPixmap::fromImage(reader.read());
+    if (!pm.isNull()) {
+        const int cost = qMax(1, int(qint64(pm.width()) * pm.height() * pm.depth() / (8 * 1024)));
+        decodedImages().insert(key, new QPixmap(pm), cost);
+    }
+    return pm;
+}
+
+//---------------------------------------------------------
+//   svgRenderer
+//    shared by the images of the item
+//---------------------------------------------------------
+
+QSvgRenderer* ImageStoreItem::svgRenderer() const
+{
+    if (!_svgRenderer) {
+        _svgRenderer.reset(new QSvgRenderer(_buffer));
+    }
+    return _svgRenderer.get();
+}
+
 //---------------------------------------------------------
 //   dereference
 //    decrement usage count of image in score
@@ -202,7 +308,8 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
         }
     }
     ImageStoreItem* item = new ImageStoreItem(path);
-    item->set(ba, hash);
+    // ba may be a view into a mapped score file, keep bytes of our own
+    item->set(QByteArray(ba.constData(), ba.size()), hash);
     _items.push_back(item);
     return item;
 }
@@ -13,9 +13,15 @@
 #ifndef __IMAGE_CACHE_H__
 #define __IMAGE_CACHE_H__
 
+#include <memory>
+
 #include <QList>
 #include <QString>
 #include <QByteArray>
+#include <QPixmap>
+#include <QSize>
+
+class QSvgRenderer;
 
 namespace Ms {
 class Image;
@@ -23,6 +29,9 @@ class Score;
 
 //---------------------------------------------------------
 //   ImageStoreItem
+//    the images are decoded when they are drawn, at the
+//    size they are drawn; the decoded pixmaps are kept in
+//    a cache shared by all items
 //---------------------------------------------------------
 
 class ImageStoreItem
@@ -32,9 +41,12 @@ class ImageStoreItem
     QString _type;                  // image type (file extension)
     QByteArray _buffer;
     QByteArray _hash;               // 16 byte md4 hash of _buffer
+    mutable QSize _rasterSize;      // read from the header of the image, invalid if not yet
+    mutable std::unique_ptr<QSvgRenderer> _svgRenderer;
 
 public:
     ImageStoreItem(const QString& p);
+    ~ImageStoreItem();
     void dereference(Image*);
     void reference(Image*);
 
@@ -48,7 +60,11 @@ public:
     void load();
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
-    void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+    void set(const QByteArray& b, const QByteArray& h);
+
+    QSize rasterSize() const;
+    QPixmap rasterPixmap(const QSize& size) const;
+    QSvgRenderer* svgRenderer() const;
 };
 
 //---------------------------------------------------------
@@ -37,7 +37,8 @@ const Drumset* InputState::drumset() const
     if (_segment == 0 || _track == -1) {
         return 0;
     }
-    return _segment->score()->staff(_track / VOICES)->part()->instrument(_segment->tick())->drumset();
+    const Part* part = _segment->score()->staff(_track / VOICES)->part();
+    return part->instrument(_segment->tick())->drumset();
 }
 
 //---------------------------------------------------------
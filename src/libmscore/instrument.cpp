@@ -101,7 +101,7 @@ void NamedEventList::read(XmlReader& e)
 {
     name = e.attribute("name");
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "program") {
             MidiCoreEvent ev(ME_CONTROLLER, 0, CTRL_PROGRAM, e.intAttribute("value", 0));
             events.push_back(ev);
@@ -146,7 +146,7 @@ Instrument::Instrument(QString id)
     _minPitchP   = 0;
     _maxPitchP   = 127;
     _useDrumset  = false;
-    _drumset     = 0;
+    _drumsetShared = false;
     _singleNoteDynamics = true;
 }
 
@@ -163,8 +163,8 @@ Instrument::Instrument(const Instrument& i)
     _transpose    = i._transpose;
     _instrumentId = i._instrumentId;
     _stringData   = i._stringData;
-    _drumset      = 0;
-    setDrumset(i._drumset);
+    _drumset      = i._drumset;
+    _drumsetShared = i._drumsetShared;
     _useDrumset   = i._useDrumset;
     _stringData   = i._stringData;
     _midiActions  = i._midiActions;
@@ -180,7 +180,6 @@ void Instrument::operator=(const Instrument& i)
 {
     qDeleteAll(_channel);
     _channel.clear();
-    delete _drumset;
 
     _id           = i._id;
     _longNames    = i._longNames;
@@ -193,8 +192,8 @@ void Instrument::operator=(const Instrument& i)
     _transpose    = i._transpose;
     _instrumentId = i._instrumentId;
     _stringData   = i._stringData;
-    _drumset      = 0;
-    setDrumset(i._drumset);
+    _drumset      = i._drumset;
+    _drumsetShared = i._drumsetShared;
     _useDrumset   = i._useDrumset;
     _stringData   = i._stringData;
     _midiActions  = i._midiActions;
@@ -213,7 +212,6 @@ void Instrument::operator=(const Instrument& i)
 Instrument::~Instrument()
 {
     qDeleteAll(_channel);
-    delete _drumset;
 }
 
 //---------------------------------------------------------
@@ -414,7 +412,7 @@ void Instrument::read(XmlReader& e, Part* part)
     _channel.clear();         // remove default channel
     _id = e.attribute("id");
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "singleNoteDynamics") {
             _singleNoteDynamics = e.readBool();
             readSingleNoteDynamics = true;
@@ -440,6 +438,12 @@ void Instrument::read(XmlReader& e, Part* part)
             _channel[0]->setBank(128);
         }
     }
+    if (customDrumset) {
+        // the same custom drumset is read for each excerpt
+        // and each score with the instrument
+        _drumset = Drumset::shared(*_drumset);
+        _drumsetShared = true;
+    }
 }
 
 //---------------------------------------------------------
@@ -448,7 +452,7 @@ void Instrument::read(XmlReader& e, Part* part)
 
 bool Instrument::readProperties(XmlReader& e, Part* part, bool* customDrumset)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "longName") {
         StaffName name;
         name.read(e);
@@ -483,20 +487,21 @@ bool Instrument::readProperties(XmlReader& e, Part* part, bool* customDrumset)
     } else if (tag == "useDrumset") {
         _useDrumset = e.readInt();
         if (_useDrumset) {
-            delete _drumset;
-            _drumset = new Drumset(*smDrumset);
+            _drumset = Drumset::shared(*smDrumset);
+            _drumsetShared = true;
         }
     } else if (tag == "Drum") {
         // if we see on of this tags, a custom drumset will
         // be created
         if (!_drumset) {
-            _drumset = new Drumset(*smDrumset);
+            _drumset = Drumset::shared(*smDrumset);
+            _drumsetShared = true;
         }
         if (!(*customDrumset)) {
-            const_cast<Drumset*>(_drumset)->clear();
+            editDrumset()->clear();
             *customDrumset = true;
         }
-        const_cast<Drumset*>(_drumset)->load(e);
+        editDrumset()->load(e);
     }
     // support tag "Tablature" for a while for compatibility with existent 2.0 scores
     else if (tag == "Tablature" || tag == "StringData") {
@@ -866,7 +871,7 @@ void Channel::read(XmlReader& e, Part* part)
     int midiChannel = -1;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "program") {
             _program = e.intAttribute("value", -1);
             if (_program == -1) {
@@ -1241,7 +1246,7 @@ void MidiArticulation::read(XmlReader& e)
 {
     name = e.attribute("name");
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "velocity") {
             QString text(e.readElementText());
             if (text.endsWith("%")) {
@@ -1429,7 +1434,8 @@ void Instrument::setUseDrumset(bool val)
 {
     _useDrumset = val;
     if (val && !_drumset) {
-        _drumset = new Drumset(*smDrumset);
+        _drumset = Drumset::shared(*smDrumset);
+        _drumsetShared = true;
     }
 }
 
@@ -1439,14 +1445,30 @@ void Instrument::setUseDrumset(bool val)
 
 void Instrument::setDrumset(const Drumset* ds)
 {
-    delete _drumset;
     if (ds) {
         _useDrumset = true;
-        _drumset = new Drumset(*ds);
+        _drumset = Drumset::shared(*ds);
+        _drumsetShared = true;
     } else {
         _useDrumset = false;
-        _drumset = 0;
+        _drumset.reset();
+        _drumsetShared = false;
+    }
+}
+
+//---------------------------------------------------------
+//   editDrumset
+//    for an edit of the drumset: a shared drumset is
+//    copied first. Use drumset() to read it.
+//---------------------------------------------------------
+
+Drumset* Instrument::editDrumset()
+{
+    if (_drumset && (_drumsetShared || _drumset.use_count() > 1)) {
+        _drumset = std::make_shared<Drumset>(*_drumset);
+        _drumsetShared = false;
     }
+    return _drumset.get();
 }
 
 //---------------------------------------------------------
@@ -13,6 +13,8 @@
 #ifndef __INSTRUMENT_H__
 #define __INSTRUMENT_H__
 
+#include <memory>
+
 #include <QtGlobal>
 #include <QString>
 
@@ -282,7 +284,8 @@ class Instrument
     QString _instrumentId;
 
     bool _useDrumset;
-    Drumset* _drumset;
+    std::shared_ptr<Drumset> _drumset;    // shared by the copies of the instrument until one of them edits it
+    bool _drumsetShared;                  // _drumset is from the pool of Drumset::shared()
     StringData _stringData;
 
     QList<NamedEventList> _midiActions;
@@ -324,8 +327,8 @@ public:
     void setInstrumentId(const QString& instrumentId) { _instrumentId = instrumentId; }
 
     void setDrumset(const Drumset* ds);
-    const Drumset* drumset() const { return _drumset; }
-    Drumset* drumset() { return _drumset; }
+    const Drumset* drumset() const { return _drumset.get(); }
+    Drumset* editDrumset();
     bool useDrumset() const { return _useDrumset; }
     void setUseDrumset(bool val);
     void setAmateurPitchRange(int a, int b) { _minPitchA = a; _maxPitchA = b; }
@@ -434,7 +434,7 @@ void KeySig::read(XmlReader& e)
     int subtype = 0;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "KeySym") {
             KeySym ks;
             while (e.readNextStartElement()) {
@@ -10,8 +10,15 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <QElapsedTimer>
 #include <QtMath>
+#include <QtConcurrent>
+
+#include "log.h"
+#include "commandstats.h"
 
 #include "accidental.h"
 #include "barline.h"
@@ -80,6 +87,20 @@ namespace Ms {
 #define PAGEDBG(...)  ;
 #endif
 
+// below this the thread pool costs more than it saves
+static constexpr int PARALLEL_SKYLINE_MIN_STAVES = 4;
+static constexpr int PARALLEL_SLURS_MIN = 16;
+
+//---------------------------------------------------------
+//   sameExtent
+//    a system that was never laid out has no extent
+//---------------------------------------------------------
+
+static bool sameExtent(qreal extent, qreal oldExtent)
+{
+    return oldExtent >= 0.0 && qAbs(extent - oldExtent) < 0.001;
+}
+
 //---------------------------------------------------------
 //   rebuildBspTree
 //---------------------------------------------------------
@@ -91,6 +112,19 @@ void Score::rebuildBspTree()
     }
 }
 
+//---------------------------------------------------------
+//   releaseBspTree
+//    frees the spatial indexes of the pages while the
+//    score is not shown, the next search rebuilds them
+//---------------------------------------------------------
+
+void Score::releaseBspTree()
+{
+    for (Page* page : pages()) {
+        page->releaseBspTree();
+    }
+}
+
 //---------------------------------------------------------
 //   layoutSegmentElements
 //---------------------------------------------------------
@@ -781,8 +815,8 @@ static bool resolveAccidentals(AcEl* left, AcEl* right, qreal& lx, qreal pd, qre
 //   layoutAccidental
 //---------------------------------------------------------
 
-static QPair<qreal, qreal> layoutAccidental(AcEl* me, AcEl* above, AcEl* below, qreal colOffset, QVector<Note*>& leftNotes, qreal pnd,
-                                            qreal pd, qreal sp)
+static QPair<qreal, qreal> layoutAccidental(AcEl* me, AcEl* above, AcEl* below, qreal colOffset, QVector<Note*>& leftNotes,
+                                            bool leftNotesSorted, qreal pnd, qreal pd, qreal sp)
 {
     qreal lx = colOffset;
     Accidental* acc = me->note->accidental();
@@ -793,19 +827,20 @@ static QPair<qreal, qreal> layoutAccidental(AcEl* me, AcEl* above, AcEl* below,
     Chord* chord = me->note->chord();
     Staff* staff = chord->staff();
     Fraction tick = chord->tick();
+    const int lines = staff->lines(tick);
 
     // extra space for ledger lines
     qreal ledgerAdjust = 0.0;
     qreal ledgerVerticalClear = 0.0;
     bool ledgerAbove = chord->upNote()->line() <= -2;
-    bool ledgerBelow = chord->downNote()->line() >= staff->lines(tick) * 2;
+    bool ledgerBelow = chord->downNote()->line() >= lines * 2;
     if (ledgerAbove || ledgerBelow) {
         // ledger lines are present
         // check for collision with lines above & below staff
         // note that on 1-line staff, both collisions are possible at once
         // TODO: account for cutouts in accidental
         qreal lds = staff->lineDistance(tick) * sp;
-        if ((ledgerAbove && me->top + lds <= pnd) || (ledgerBelow && staff->lines(tick) * lds - me->bottom <= pnd)) {
+        if ((ledgerAbove && me->top + lds <= pnd) || (ledgerBelow && lines * lds - me->bottom <= pnd)) {
             ledgerAdjust = -acc->score()->styleS(Sid::ledgerLineLength).val() * sp;
             ledgerVerticalClear = acc->score()->styleS(Sid::ledgerLineWidth).val() * 0.5 * sp;
             lx = qMin(lx, ledgerAdjust);
@@ -813,15 +848,24 @@ static QPair<qreal, qreal> layoutAccidental(AcEl* me, AcEl* above, AcEl* below,
     }
 
     // clear left notes
+    // the notes which end above the accidental are skipped; when the
+    // notes are sorted by line, these are found by a binary search
     int lns = leftNotes.size();
-    for (int i = 0; i < lns; ++i) {
+    int first = 0;
+    if (leftNotesSorted && pnd >= 0.0) {
+        first = int(std::partition_point(leftNotes.begin(), leftNotes.end(), [me, pnd, sp](const Note* ln) {
+            qreal lnBottom = (ln->line() - 1) * 0.5 * sp + sp;
+            return me->top - lnBottom > pnd;
+        }) - leftNotes.begin());
+    }
+    for (int i = first; i < lns; ++i) {
         Note* ln = leftNotes[i];
         int lnLine = ln->line();
         qreal lnTop = (lnLine - 1) * 0.5 * sp;
         qreal lnBottom = lnTop + sp;
         if (me->top - lnBottom <= pnd && lnTop - me->bottom <= pnd) {
             qreal lnLedgerAdjust = 0.0;
-            if (lnLine <= -2 || lnLine >= staff->lines(tick) * 2) {
+            if (lnLine <= -2 || lnLine >= lines * 2) {
                 // left note has a ledger line we probably need to clear horizontally as well
                 // except for accidentals that clear the last extended ledger line vertically
                 // in these cases, the accidental may tuck closer
@@ -913,8 +957,9 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
                 acel.top    = line * 0.5 * sp + ac->bbox().top();
                 acel.bottom = line * 0.5 * sp + ac->bbox().bottom();
                 acel.width  = ac->width();
-                QPointF bboxNE = ac->symBbox(ac->symbol()).topRight();
-                QPointF bboxSW = ac->symBbox(ac->symbol()).bottomLeft();
+                const QRectF symBbox = ac->symBbox(ac->symbol());
+                QPointF bboxNE = symBbox.topRight();
+                QPointF bboxSW = symBbox.bottomLeft();
                 QPointF cutOutNE = ac->symSmuflAnchor(ac->symbol(), SmuflAnchorId::cutOutNE);
                 QPointF cutOutSW = ac->symSmuflAnchor(ac->symbol(), SmuflAnchorId::cutOutSW);
                 if (!cutOutNE.isNull()) {
@@ -1065,6 +1110,12 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
         return;
     }
 
+    // the left notes are appended from top to bottom, in order of
+    // their lines but for some enharmonic spellings
+    const bool leftNotesSorted = std::is_sorted(leftNotes.begin(), leftNotes.end(), [](const Note* n1, const Note* n2) {
+        return n1->line() < n2->line();
+    });
+
     QVector<int> umi;
     qreal pd  = styleP(Sid::accidentalDistance);
     qreal pnd = styleP(Sid::accidentalNoteDistance);
@@ -1182,7 +1233,7 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
             AcEl* below = 0;
             // through accidentals in this column
             for (int j = columnBottom[pc]; j != -1; j = aclist[j].next) {
-                QPair<qreal, qreal> x = layoutAccidental(&aclist[j], 0, below, colOffset, leftNotes, pnd, pd, sp);
+                QPair<qreal, qreal> x = layoutAccidental(&aclist[j], 0, below, colOffset, leftNotes, leftNotesSorted, pnd, pd, sp);
                 minX = qMin(minX, x.first);
                 maxX = qMin(maxX, x.second);
                 below = &aclist[j];
@@ -1220,14 +1271,14 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
         AcEl* below = 0;
 
         // layout top accidental
-        layoutAccidental(me, above, below, colOffset, leftNotes, pnd, pd, sp);
+        layoutAccidental(me, above, below, colOffset, leftNotes, leftNotesSorted, pnd, pd, sp);
 
         // layout bottom accidental
         int n = nAcc - 1;
         if (n > 0) {
             above = me;
             me = &aclist[umi[n]];
-            layoutAccidental(me, above, below, colOffset, leftNotes, pnd, pd, sp);
+            layoutAccidental(me, above, below, colOffset, leftNotes, leftNotesSorted, pnd, pd, sp);
         }
 
         // layout middle accidentals
@@ -1236,14 +1287,14 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
                 // next highest
                 below = me;
                 me = &aclist[umi[i]];
-                layoutAccidental(me, above, below, colOffset, leftNotes, pnd, pd, sp);
+                layoutAccidental(me, above, below, colOffset, leftNotes, leftNotesSorted, pnd, pd, sp);
                 if (i == n - 1) {
                     break;
                 }
                 // next lowest
                 above = me;
                 me = &aclist[umi[n - 1]];
-                layoutAccidental(me, above, below, colOffset, leftNotes, pnd, pd, sp);
+                layoutAccidental(me, above, below, colOffset, leftNotes, leftNotesSorted, pnd, pd, sp);
             }
         }
     }
@@ -1405,38 +1456,26 @@ void Score::hideEmptyStaves(System* system, bool isFirstSystem)
             int n = part->nstaves();
             if (hideStaff && (n > 1)) {
                 int idx = part->staves()->front()->idx();
-                for (int i = 0; i < part->nstaves(); ++i) {
-                    int st = idx + i;
-
-                    for (MeasureBase* mb : system->measures()) {
-                        if (!mb->isMeasure()) {
-                            continue;
-                        }
-                        Measure* m = toMeasure(mb);
-                        if (staff->hideWhenEmpty() == Staff::HideMode::INSTRUMENT && !m->isEmpty(st)) {
-                            hideStaff = false;
-                            break;
-                        }
-                        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-                            for (int voice = 0; voice < VOICES; ++voice) {
-                                ChordRest* cr = s->cr(st * VOICES + voice);
-                                if (cr == 0 || cr->isRest()) {
-                                    continue;
-                                }
-                                int staffMove = cr->staffMove();
-                                if (staffIdx == st + staffMove) {
-                                    hideStaff = false;
-                                    break;
-                                }
+                for (MeasureBase* mb : system->measures()) {
+                    if (!mb->isMeasure()) {
+                        continue;
+                    }
+                    Measure* m = toMeasure(mb);
+                    if (m->hasChordsIn(staffIdx)) {
+                        hideStaff = false;
+                        break;
+                    }
+                    if (staff->hideWhenEmpty() == Staff::HideMode::INSTRUMENT) {
+                        for (int st = idx; st < idx + n; ++st) {
+                            if (!m->isEmpty(st)) {
+                                hideStaff = false;
+                                break;
                             }
                         }
                         if (!hideStaff) {
                             break;
                         }
                     }
-                    if (!hideStaff) {
-                        break;
-                    }
                 }
             }
             ss->setShow(hideStaff ? false : staff->show());
@@ -1479,15 +1518,39 @@ void Score::hideEmptyStaves(System* system, bool isFirstSystem)
 //---------------------------------------------------------
 
 void Score::connectTies(bool silent)
+{
+    connectTies(Fraction(0,1), Fraction(-1,1), silent);
+}
+
+//---------------------------------------------------------
+//   connectTies
+///   Rebuild the tie connections of the notes from stick
+///   up to etick, or to the end of the score if etick is
+///   negative. An edit only leaves ties without end note
+///   in the range it changed.
+//---------------------------------------------------------
+
+void Score::connectTies(const Fraction& stick, const Fraction& etick, bool silent)
 {
     int tracks = nstaves() * VOICES;
-    Measure* m = firstMeasure();
+    Measure* m = stick > Fraction(0,1) ? tick2measure(stick) : nullptr;
+    if (m) {
+        // start a measure earlier for the notes tied into the range
+        if (m->prevMeasure()) {
+            m = m->prevMeasure();
+        }
+    } else {
+        m = firstMeasure();
+    }
     if (!m) {
         return;
     }
 
     SegmentType st = SegmentType::ChordRest;
     for (Segment* s = m->first(st); s; s = s->next1(st)) {
+        if (etick >= Fraction(0,1) && s->tick() >= etick) {
+            break;
+        }
         for (int i = 0; i < tracks; ++i) {
             Element* e = s->element(i);
             if (e == 0 || !e->isChord()) {
@@ -2157,9 +2220,13 @@ System* Score::getNextSystem(LayoutContext& lc)
     if (lc.systemList.empty()) {
         system = new System(this);
         lc.systemOldMeasure = 0;
+        lc.systemOldWidth   = -1.0;
+        lc.systemOldHeight  = -1.0;
     } else {
         system = lc.systemList.takeFirst();
         lc.systemOldMeasure = system->measures().empty() ? 0 : system->measures().back();
+        lc.systemOldWidth   = system->width();
+        lc.systemOldHeight  = system->height();
         system->clear();       // remove measures from system
     }
     _systems.append(system);
@@ -2170,6 +2237,28 @@ System* Score::getNextSystem(LayoutContext& lc)
     return system;
 }
 
+//---------------------------------------------------------
+//   mmRestSourceKey
+//    of the measures a multimeasure rest is made of, as
+//    they are now
+//---------------------------------------------------------
+
+static quint64 mmRestSourceKey(const Measure* firstMeasure, const Measure* lastMeasure, const Fraction& len, int staves)
+{
+    quint64 h = 14695981039346656037ull;
+    auto mix = [&h](quint64 v) { h = (h ^ v) * 1099511628211ull; };
+    mix(quint64(len.numerator()) << 32 | quint32(len.denominator()));
+    mix(staves);
+    for (const Measure* m = firstMeasure; m; m = m->nextMeasure()) {
+        mix(quintptr(m));
+        mix(m->contentRevision());
+        if (m == lastMeasure) {
+            break;
+        }
+    }
+    return h;
+}
+
 //---------------------------------------------------------
 //   createMMRest
 //    create a multimeasure rest
@@ -2194,6 +2283,11 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
 
     // mmrMeasure coexists with n undisplayed measures of rests
     Measure* mmrMeasure = firstMeasure->mmRest();
+
+    // the elements copied from the underlying measures are kept
+    // as they are if none of these measures changed since
+    const quint64 sourceKey = mmRestSourceKey(firstMeasure, lastMeasure, len, nstaves());
+    const bool unchanged = mmrMeasure && mmrMeasure->mmRestSourceKey() == sourceKey;
     if (mmrMeasure) {
         // reuse existing mmrest
         if (mmrMeasure->ticks() != len) {
@@ -2222,7 +2316,7 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
     // set mmrMeasure with same barline as last underlying measure
     //
     Segment* lastMeasureEndBarlineSeg = lastMeasure->findSegmentR(SegmentType::EndBarLine, lastMeasure->ticks());
-    if (lastMeasureEndBarlineSeg) {
+    if (lastMeasureEndBarlineSeg && !unchanged) {
         Segment* mmrEndBarlineSeg = mmrMeasure->undoGetSegmentR(SegmentType::EndBarLine, mmrMeasure->ticks());
         for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
             Element* e = lastMeasureEndBarlineSeg->element(staffIdx * VOICES);
@@ -2256,7 +2350,7 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
     //
     Segment* lastMeasureClefSeg = lastMeasure->findSegmentR(SegmentType::Clef | SegmentType::HeaderClef,
                                                             lastMeasure->ticks());
-    if (lastMeasureClefSeg) {
+    if (lastMeasureClefSeg && !unchanged) {
         Segment* mmrClefSeg = mmrMeasure->undoGetSegment(lastMeasureClefSeg->segmentType(), lastMeasure->endTick());
         for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
             const int track = staff2track(staffIdx);
@@ -2284,33 +2378,35 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
     //
     // copy markers to mmrMeasure
     //
-    ElementList oldList = mmrMeasure->takeElements();
-    ElementList newList = lastMeasure->el();
-    for (Element* e : firstMeasure->el()) {
-        if (e->isMarker()) {
-            newList.push_back(e);
+    if (!unchanged) {
+        ElementList oldList = mmrMeasure->takeElements();
+        ElementList newList = lastMeasure->el();
+        for (Element* e : firstMeasure->el()) {
+            if (e->isMarker()) {
+                newList.push_back(e);
+            }
         }
-    }
-    for (Element* e : newList) {
-        bool found = false;
-        for (Element* ee : oldList) {
-            if (ee->type() == e->type() && ee->subtype() == e->subtype()) {
-                mmrMeasure->add(ee);
-                auto i = std::find(oldList.begin(), oldList.end(), ee);
-                if (i != oldList.end()) {
-                    oldList.erase(i);
+        for (Element* e : newList) {
+            bool found = false;
+            for (Element* ee : oldList) {
+                if (ee->type() == e->type() && ee->subtype() == e->subtype()) {
+                    mmrMeasure->add(ee);
+                    auto i = std::find(oldList.begin(), oldList.end(), ee);
+                    if (i != oldList.end()) {
+                        oldList.erase(i);
+                    }
+                    found = true;
+                    break;
                 }
-                found = true;
-                break;
+            }
+            if (!found) {
+                mmrMeasure->add(e->clone());
             }
         }
-        if (!found) {
-            mmrMeasure->add(e->clone());
+        for (Element* e : oldList) {
+            delete e;
         }
     }
-    for (Element* e : oldList) {
-        delete e;
-    }
     Segment* s = mmrMeasure->undoGetSegmentR(SegmentType::ChordRest, Fraction(0,1));
     for (int staffIdx = 0; staffIdx < _staves.size(); ++staffIdx) {
         int track = staffIdx * VOICES;
@@ -2372,7 +2468,7 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
                         underlyingTimeSig->linkedClone());
                     mmrTimeSig->setParent(mmrSeg);
                     undo(new AddElement(mmrTimeSig));
-                } else {
+                } else if (!unchanged) {
                     mmrTimeSig->setSig(underlyingTimeSig->sig(), underlyingTimeSig->timeSigType());
                     mmrTimeSig->layout();
                 }
@@ -2458,7 +2554,7 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
     // check for rehearsal mark etc.
     //
     underlyingSeg = firstMeasure->findSegmentR(SegmentType::ChordRest, Fraction(0,1));
-    if (underlyingSeg) {
+    if (underlyingSeg && !unchanged) {
         // clone elements from underlying measure to mmr
         for (Element* e : underlyingSeg->annotations()) {
             // look at elements in underlying measure
@@ -2508,6 +2604,7 @@ void Score::createMMRest(Measure* firstMeasure, Measure* lastMeasure, const Frac
     MeasureBase* nm = _showVBox ? lastMeasure->next() : lastMeasure->nextMeasure();
     mmrMeasure->setNext(nm);
     mmrMeasure->setPrev(firstMeasure->prev());
+    mmrMeasure->setMMRestSourceKey(sourceKey);
 }
 
 //---------------------------------------------------------
@@ -3052,6 +3149,57 @@ std::pair<qreal, qreal> extendedStemLenWithTwoNoteTremolo(Tremolo* tremolo, qrea
     return { stemLen1, stemLen2 };
 }
 
+//---------------------------------------------------------
+//   layoutStaffChords
+//---------------------------------------------------------
+
+static void layoutStaffChords(Score* score, Measure* measure, int staffIdx)
+{
+    for (Segment& segment : measure->segments()) {
+        if (segment.isChordRestType()) {
+            score->layoutChords1(&segment, staffIdx);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   layoutStaffLyrics
+//---------------------------------------------------------
+
+static void layoutStaffLyrics(Measure* measure, int staffIdx)
+{
+    for (Segment& segment : measure->segments()) {
+        if (!segment.isChordRestType()) {
+            continue;
+        }
+        for (int voice = 0; voice < VOICES; ++voice) {
+            ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
+            if (cr) {
+                for (Lyrics* l : cr->lyrics()) {
+                    if (l) {
+                        l->layout();
+                    }
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   layoutMeasureChords
+//    chord layout adds and removes stems and hooks through
+//    the undo stack and must stay serial. The lyrics only
+//    depend on the chords of their own staff and follow them.
+//---------------------------------------------------------
+
+static void layoutMeasureChords(Score* score, Measure* measure)
+{
+    for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+        layoutStaffChords(score, measure, staffIdx);
+        layoutStaffLyrics(measure, staffIdx);
+    }
+}
+
 //---------------------------------------------------------
 //   getNextMeasure
 //---------------------------------------------------------
@@ -3139,8 +3287,8 @@ void Score::getNextMeasure(LayoutContext& lc)
     //
     for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
         const Staff* staff     = Score::staff(staffIdx);
-        const Drumset* drumset
-            = staff->part()->instrument(measure->tick())->useDrumset() ? staff->part()->instrument(measure->tick())->drumset() : 0;
+        const Instrument* instrument = static_cast<const Part*>(staff->part())->instrument(measure->tick());
+        const Drumset* drumset = instrument->useDrumset() ? instrument->drumset() : 0;
         AccidentalState as;          // list of already set accidentals for this measure
         as.init(staff->keySigEvent(measure->tick()), staff->clef(measure->tick()));
 
@@ -3229,24 +3377,7 @@ void Score::getNextMeasure(LayoutContext& lc)
     }
 
     createBeams(lc, measure);
-
-    for (int staffIdx = 0; staffIdx < score()->nstaves(); ++staffIdx) {
-        for (Segment& segment : measure->segments()) {
-            if (segment.isChordRestType()) {
-                layoutChords1(&segment, staffIdx);
-                for (int voice = 0; voice < VOICES; ++voice) {
-                    ChordRest* cr = segment.cr(staffIdx * VOICES + voice);
-                    if (cr) {
-                        for (Lyrics* l : cr->lyrics()) {
-                            if (l) {
-                                l->layout();
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    layoutMeasureChords(score(), measure);
 
     measure->computeTicks();
 
@@ -3583,6 +3714,58 @@ static void applyLyricsMin(Measure* m, int staffIdx, qreal yMin)
     }
 }
 
+//---------------------------------------------------------
+//   alignLyrics
+//    of a staff of the system
+//---------------------------------------------------------
+
+static void alignLyrics(System* system, int staffIdx, VerticalAlignRange ar)
+{
+    switch (ar) {
+    case VerticalAlignRange::MEASURE:
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            Measure* m = toMeasure(mb);
+            qreal yMax = findLyricsMaxY(m, staffIdx);
+            applyLyricsMax(m, staffIdx, yMax);
+        }
+        break;
+    case VerticalAlignRange::SYSTEM:
+    {
+        qreal yMax = 0.0;
+        qreal yMin = 0.0;
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            yMax = qMax<qreal>(yMax, findLyricsMaxY(toMeasure(mb), staffIdx));
+            yMin = qMin(yMin, findLyricsMinY(toMeasure(mb), staffIdx));
+        }
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            applyLyricsMax(toMeasure(mb), staffIdx, yMax);
+            applyLyricsMin(toMeasure(mb), staffIdx, yMin);
+        }
+    }
+    break;
+    case VerticalAlignRange::SEGMENT:
+        for (MeasureBase* mb : system->measures()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            for (Segment& s : toMeasure(mb)->segments()) {
+                qreal yMax = findLyricsMaxY(s, staffIdx);
+                applyLyricsMax(s, staffIdx, yMax);
+            }
+        }
+        break;
+    }
+}
+
 //---------------------------------------------------------
 //   restoreBeams
 //---------------------------------------------------------
@@ -3678,55 +3861,18 @@ void Score::layoutLyrics(System* system)
         }
     }
 
+    // the lyrics of a staff are aligned against its own skyline only
     VerticalAlignRange ar = VerticalAlignRange(styleI(Sid::autoplaceVerticalAlignRange));
-
-    switch (ar) {
-    case VerticalAlignRange::MEASURE:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                qreal yMax = findLyricsMaxY(m, staffIdx);
-                applyLyricsMax(m, staffIdx, yMax);
-            }
-        }
-        break;
-    case VerticalAlignRange::SYSTEM:
-        for (int staffIdx : visibleStaves) {
-            qreal yMax = 0.0;
-            qreal yMin = 0.0;
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
-                }
-                yMax = qMax<qreal>(yMax, findLyricsMaxY(toMeasure(mb), staffIdx));
-                yMin = qMin(yMin, findLyricsMinY(toMeasure(mb), staffIdx));
-            }
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
-                }
-                applyLyricsMax(toMeasure(mb), staffIdx, yMax);
-                applyLyricsMin(toMeasure(mb), staffIdx, yMin);
-            }
-        }
-        break;
-    case VerticalAlignRange::SEGMENT:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                for (Segment& s : m->segments()) {
-                    qreal yMax = findLyricsMaxY(s, staffIdx);
-                    applyLyricsMax(s, staffIdx, yMax);
-                }
-            }
-        }
-        break;
+#ifndef Q_OS_WASM
+    if (MScore::parallelLayout && int(visibleStaves.size()) >= PARALLEL_SKYLINE_MIN_STAVES) {
+        QtConcurrent::blockingMap(visibleStaves, [system, ar](int staffIdx) {
+            alignLyrics(system, staffIdx, ar);
+        });
+        return;
+    }
+#endif
+    for (int staffIdx : visibleStaves) {
+        alignLyrics(system, staffIdx, ar);
     }
 }
 
@@ -3745,7 +3891,7 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
         if (t) {
             TieSegment* ts = t->layoutFor(system);
             if (ts && ts->addToSkyline()) {
-                staff->skyline().add(ts->shape().translated(ts->pos()));
+                staff->skyline().add(ts->shape(), ts->pos());
             }
         }
         t = note->tieBack();
@@ -3753,7 +3899,7 @@ void layoutTies(Chord* ch, System* system, const Fraction& stick)
             if (t->startNote()->tick() < stick) {
                 TieSegment* ts = t->layoutBack(system);
                 if (ts && ts->addToSkyline()) {
-                    staff->skyline().add(ts->shape().translated(ts->pos()));
+                    staff->skyline().add(ts->shape(), ts->pos());
                 }
             }
         }
@@ -3903,14 +4049,14 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
             for (Element* e : qAsConst(modified)) {
                 const Segment* s = toSegment(e->parent());
                 const MeasureBase* m = toMeasureBase(s->parent());
-                system->staff(e->staffIdx())->skyline().add(e->shape().translated(e->pos() + s->pos() + m->pos()));
+                system->staff(e->staffIdx())->skyline().add(e->shape(), e->pos() + s->pos() + m->pos());
                 if (e->isFretDiagram()) {
                     FretDiagram* fd = toFretDiagram(e);
                     Harmony* h = fd->harmony();
                     if (h) {
-                        system->staff(e->staffIdx())->skyline().add(h->shape().translated(h->pos() + fd->pos() + s->pos() + m->pos()));
+                        system->staff(e->staffIdx())->skyline().add(h->shape(), h->pos() + fd->pos() + s->pos() + m->pos());
                     } else {
-                        system->staff(e->staffIdx())->skyline().add(fd->shape().translated(fd->pos() + s->pos() + m->pos()));
+                        system->staff(e->staffIdx())->skyline().add(fd->shape(), fd->pos() + s->pos() + m->pos());
                     }
                 }
             }
@@ -3995,11 +4141,135 @@ static void processLines(System* system, std::vector<Spanner*> lines, bool align
     //
     for (SpannerSegment* ss : segments) {
         if (ss->addToSkyline()) {
-            system->staff(ss->staffIdx())->skyline().add(ss->shape().translated(ss->pos()));
+            system->staff(ss->staffIdx())->skyline().add(ss->shape(), ss->pos());
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   layoutSlurSegments
+//    a slur segment looks at the segment shapes, but not
+//    at the skyline, so the slurs are laid out at the
+//    same time
+//---------------------------------------------------------
+
+static void layoutSlurSegments(System* system, const std::vector<Spanner*>& slurs, const std::vector<SlurSegment*>& segments)
+{
+    const int n = int(slurs.size());
+#ifndef Q_OS_WASM
+    if (MScore::parallelLayout && n >= PARALLEL_SLURS_MIN) {
+        std::vector<int> indexes(n);
+        for (int i = 0; i < n; ++i) {
+            indexes[i] = i;
+        }
+        QtConcurrent::blockingMap(indexes, [&slurs, &segments, system](int i) {
+            toSlur(slurs[i])->layoutSystemSegment(segments[i], system);
+        });
+        return;
+    }
+#endif
+    for (int i = 0; i < n; ++i) {
+        toSlur(slurs[i])->layoutSystemSegment(segments[i], system);
+    }
+}
+
+//---------------------------------------------------------
+//   layoutSlurs
+//    as processLines() without alignment, the segments
+//    are set up one after the other and then laid out
+//---------------------------------------------------------
+
+static void layoutSlurs(System* system, const std::vector<Spanner*>& slurs)
+{
+    std::vector<SlurSegment*> segments;
+    segments.reserve(slurs.size());
+    for (Spanner* sp : slurs) {
+        segments.push_back(toSlur(sp)->setupSystemSegment(system));
+    }
+    layoutSlurSegments(system, slurs, segments);
+
+    for (SlurSegment* ss : segments) {
+        if (ss->autoplace() && ss->addToSkyline()) {
+            system->staff(ss->staffIdx())->skyline().add(ss->shape(), ss->pos());
         }
     }
 }
 
+//---------------------------------------------------------
+//   plannedSystemBreak
+//    the measure to start the system after the one starting
+//    with mb when the systems are filled evenly: the systems
+//    up to the next forced break, within breakWindow
+//    measures, are chosen to minimize the sum of the
+//    demerits of their stretch as in the line breaking of
+//    Knuth and Plass. The widths are those of the last
+//    layout of the measures; nullptr if a measure was not
+//    laid out yet or if the measures fit into one system,
+//    then the system takes as many measures as fit.
+//---------------------------------------------------------
+
+static MeasureBase* plannedSystemBreak(Score* score, MeasureBase* mb, qreal width)
+{
+    static constexpr int breakWindow = 64;
+
+    std::vector<MeasureBase*> measures;
+    std::vector<qreal> widths;
+    qreal headerWidth = 0.0;
+    for (MeasureBase* m = mb; m && int(measures.size()) < breakWindow; m = m->nextMM()) {
+        if (m->isMeasure()) {
+            const qreal w = toMeasure(m)->savedBodyWidth();
+            if (w < 0.0) {
+                return nullptr;
+            }
+            headerWidth = qMax(headerWidth, toMeasure(m)->savedHeaderWidth());
+            widths.push_back(w);
+        } else if (!score->showVBox()) {
+            continue;
+        } else if (m->isHBox()) {
+            widths.push_back(m->width());
+        } else {
+            break;
+        }
+        measures.push_back(m);
+        if (m->pageBreak() || m->lineBreak() || m->sectionBreak()) {
+            break;
+        }
+    }
+    const int n = int(measures.size());
+    if (n < 2) {
+        return nullptr;
+    }
+
+    // cost[i]: least demerits of the systems from measure i on, next[i]: the start of the next of them
+    const qreal infinity = std::numeric_limits<qreal>::max();
+    std::vector<qreal> cost(n + 1, infinity);
+    std::vector<int> next(n + 1, n);
+    cost[n] = 0.0;
+    for (int i = n - 1; i >= 0; --i) {
+        qreal w = headerWidth;
+        for (int j = i; j < n; ++j) {
+            w += widths[j];
+            if (w > width && j > i) {
+                break;                  // only a single measure may be wider than the system
+            }
+            if ((measures[j]->noBreak() && j < n - 1) || cost[j + 1] == infinity) {
+                continue;
+            }
+            qreal demerits = 0.0;       // the last system is not stretched
+            if (j < n - 1) {
+                const qreal r = qMax(width - w, 0.0) / width;
+                const qreal badness = 100.0 * r * r * r;
+                demerits = (1.0 + badness) * (1.0 + badness);
+            }
+            if (cost[j + 1] + demerits < cost[i]) {
+                cost[i] = cost[j + 1] + demerits;
+                next[i] = j + 1;
+            }
+        }
+    }
+    return cost[0] != infinity && next[0] < n ? measures[next[0]] : nullptr;
+}
+
 //---------------------------------------------------------
 //   collectSystem
 //---------------------------------------------------------
@@ -4020,6 +4290,7 @@ System* Score::collectSystem(LayoutContext& lc)
         lc.startWithLongNames = lc.firstSystem && measure->sectionBreakElement()->startWithLongNames();
     }
     System* system = getNextSystem(lc);
+    ++lc.statistics.systems;
     Fraction lcmTick = lc.curMeasure->tick();
     system->setInstrumentNames(lc.startWithLongNames, lcmTick);
 
@@ -4034,6 +4305,12 @@ System* Score::collectSystem(LayoutContext& lc)
     bool curHeader = lc.curMeasure->header();
     bool curTrailer = lc.curMeasure->trailer();
     MeasureBase* breakMeasure = nullptr;
+    bool sameEnd = false;
+
+    // with optimalSystemBreaks the system may end before it is full
+    const bool planBreaks = styleB(Sid::optimalSystemBreaks)
+                            && (_layoutMode == LayoutMode::PAGE || _layoutMode == LayoutMode::SYSTEM);
+    MeasureBase* plannedBreak = nullptr;
 
     while (lc.curMeasure) {      // collect measure for system
         System* oldSystem = lc.curMeasure->system();
@@ -4043,6 +4320,7 @@ System* Score::collectSystem(LayoutContext& lc)
 
         if (lc.curMeasure->isMeasure()) {
             Measure* m = toMeasure(lc.curMeasure);
+            ++lc.statistics.measures;
             if (firstMeasure) {
                 layoutSystemMinWidth = minWidth;
                 system->layoutSystem(minWidth, lc.firstSystem, lc.firstSystemIndent);
@@ -4075,6 +4353,9 @@ System* Score::collectSystem(LayoutContext& lc)
             }
             m->computeMinWidth();
             ww = m->width();
+            if (planBreaks && system->measures().size() == 1) {
+                plannedBreak = plannedSystemBreak(this, m, systemWidth - system->leftMargin());
+            }
         } else if (lc.curMeasure->isHBox()) {
             lc.curMeasure->computeMinWidth();
             ww = lc.curMeasure->width();
@@ -4088,7 +4369,7 @@ System* Score::collectSystem(LayoutContext& lc)
         // check if lc.curMeasure fits, remove if not
         // collect at least one measure and the break
 
-        bool doBreak = (system->measures().size() > 1) && ((minWidth + ww) > systemWidth);
+        bool doBreak = (system->measures().size() > 1) && ((minWidth + ww) > systemWidth || lc.curMeasure == plannedBreak);
         if (doBreak) {
             breakMeasure = lc.curMeasure;
             system->removeLastMeasure();
@@ -4237,7 +4518,7 @@ System* Score::collectSystem(LayoutContext& lc)
                     m = m->nextMeasure();
                 }
             }
-            lc.rangeDone = true;
+            sameEnd = true;
         }
     }
 
@@ -4350,6 +4631,14 @@ System* Score::collectSystem(LayoutContext& lc)
 
     layoutSystemElements(system, lc);
     system->layout2();     // compute staff distances
+
+    // the following systems can be taken over unchanged only if this one
+    // still has the width and vertical extent they were placed against,
+    // unless a system local layout was asked for
+    if (sameEnd && (lc.systemLocal
+                    || (sameExtent(system->width(), lc.systemOldWidth) && sameExtent(system->height(), lc.systemOldHeight)))) {
+        lc.rangeDone = true;
+    }
     // TODO: now that the code at the top of this function does this same backwards search,
     // we might be able to eliminate this block
     // but, lc might be used elsewhere so we need to be careful
@@ -4368,6 +4657,135 @@ System* Score::collectSystem(LayoutContext& lc)
     return system;
 }
 
+//---------------------------------------------------------
+//   createSkyline
+///   Builds the skyline of one staff of a system. It only
+///   writes the skyline of that staff and the chord based
+///   fingerings of the elements laid out on it, so the
+///   staves of a system can be done in parallel.
+//---------------------------------------------------------
+
+static void createSkyline(const Score* score, System* system, int staffIdx, const LayoutContext& lc)
+{
+    SysStaff* ss = system->staff(staffIdx);
+    Skyline& skyline = ss->skyline();
+    skyline.clear();
+    for (MeasureBase* mb : system->measures()) {
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        Measure* m = toMeasure(mb);
+        MeasureNumber* mno = m->noText(staffIdx);
+        MMRestRange* mmrr  = m->mmRangeText(staffIdx);
+        // no need to build skyline outside of range in continuous view
+        if (score->lineMode() && (m->tick() < lc.startTick || m->tick() > lc.endTick)) {
+            continue;
+        }
+        if (mno && mno->addToSkyline()) {
+            ss->skyline().add(mno->bbox().translated(m->pos() + mno->pos()));
+        }
+        if (mmrr && mmrr->addToSkyline()) {
+            ss->skyline().add(mmrr->bbox().translated(m->pos() + mmrr->pos()));
+        }
+        if (m->staffLines(staffIdx)->addToSkyline()) {
+            ss->skyline().add(m->staffLines(staffIdx)->bbox().translated(m->pos()));
+        }
+        for (Segment& s : m->segments()) {
+            if (!s.enabled() || s.isTimeSigType()) {             // hack: ignore time signatures
+                continue;
+            }
+            QPointF p(s.pos() + m->pos());
+            if (s.segmentType()
+                & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
+                BarLine* bl = toBarLine(s.element(staffIdx * VOICES));
+                if (bl && bl->addToSkyline()) {
+                    QRectF r = bl->layoutRect();
+                    skyline.add(r.translated(bl->pos() + p));
+                }
+            } else {
+                int strack = staffIdx * VOICES;
+                int etrack = strack + VOICES;
+                for (Element* e : s.elist()) {
+                    if (!e) {
+                        continue;
+                    }
+                    int effectiveTrack = e->vStaffIdx() * VOICES + e->voice();
+                    if (effectiveTrack < strack || effectiveTrack >= etrack) {
+                        continue;
+                    }
+
+                    // clear layout for chord-based fingerings
+                    // do this before adding chord to skyline
+                    if (e->isChord()) {
+                        Chord* c = toChord(e);
+                        std::list<Note*> notes;
+                        for (auto gc : c->graceNotes()) {
+                            for (auto n : gc->notes()) {
+                                notes.push_back(n);
+                            }
+                        }
+                        for (auto n : c->notes()) {
+                            notes.push_back(n);
+                        }
+                        for (Note* note : notes) {
+                            for (Element* en : note->el()) {
+                                if (en->isFingering()) {
+                                    Fingering* f = toFingering(en);
+                                    if (f->layoutType() == ElementType::CHORD) {
+                                        f->setPos(QPointF());
+                                        f->setbbox(QRectF());
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    // add element to skyline
+                    if (e->addToSkyline()) {
+                        skyline.add(e->shape(), e->pos() + p);
+                    }
+
+                    // add tremolo to skyline
+                    if (e->isChord() && toChord(e)->tremolo()) {
+                        Tremolo* t = toChord(e)->tremolo();
+                        Chord* c1 = t->chord1();
+                        Chord* c2 = t->chord2();
+                        if (!t->twoNotes() || (c1 && !c1->staffMove() && c2 && !c2->staffMove())) {
+                            if (t->chord() == e && t->addToSkyline()) {
+                                skyline.add(t->shape(), t->pos() + e->pos() + p);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   createSkylines
+//---------------------------------------------------------
+
+static void createSkylines(const Score* score, System* system, const LayoutContext& lc)
+{
+    const int nstaves = score->nstaves();
+#ifndef Q_OS_WASM
+    if (MScore::parallelLayout && nstaves >= PARALLEL_SKYLINE_MIN_STAVES) {
+        std::vector<int> indexes(nstaves);
+        for (int i = 0; i < nstaves; ++i) {
+            indexes[i] = i;
+        }
+        QtConcurrent::blockingMap(indexes, [score, system, &lc](int staffIdx) {
+            createSkyline(score, system, staffIdx, lc);
+        });
+        return;
+    }
+#endif
+    for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+        createSkyline(score, system, staffIdx, lc);
+    }
+}
+
 //---------------------------------------------------------
 //   layoutSystemElements
 //---------------------------------------------------------
@@ -4429,101 +4847,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
     //    create skylines
     //-------------------------------------------------------------
 
-    for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
-        SysStaff* ss = system->staff(staffIdx);
-        Skyline& skyline = ss->skyline();
-        skyline.clear();
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            MeasureNumber* mno = m->noText(staffIdx);
-            MMRestRange* mmrr  = m->mmRangeText(staffIdx);
-            // no need to build skyline outside of range in continuous view
-            if (lineMode() && (m->tick() < lc.startTick || m->tick() > lc.endTick)) {
-                continue;
-            }
-            if (mno && mno->addToSkyline()) {
-                ss->skyline().add(mno->bbox().translated(m->pos() + mno->pos()));
-            }
-            if (mmrr && mmrr->addToSkyline()) {
-                ss->skyline().add(mmrr->bbox().translated(m->pos() + mmrr->pos()));
-            }
-            if (m->staffLines(staffIdx)->addToSkyline()) {
-                ss->skyline().add(m->staffLines(staffIdx)->bbox().translated(m->pos()));
-            }
-            for (Segment& s : m->segments()) {
-                if (!s.enabled() || s.isTimeSigType()) {             // hack: ignore time signatures
-                    continue;
-                }
-                QPointF p(s.pos() + m->pos());
-                if (s.segmentType()
-                    & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
-                    BarLine* bl = toBarLine(s.element(staffIdx * VOICES));
-                    if (bl && bl->addToSkyline()) {
-                        QRectF r = bl->layoutRect();
-                        skyline.add(r.translated(bl->pos() + p));
-                    }
-                } else {
-                    int strack = staffIdx * VOICES;
-                    int etrack = strack + VOICES;
-                    for (Element* e : s.elist()) {
-                        if (!e) {
-                            continue;
-                        }
-                        int effectiveTrack = e->vStaffIdx() * VOICES + e->voice();
-                        if (effectiveTrack < strack || effectiveTrack >= etrack) {
-                            continue;
-                        }
-
-                        // clear layout for chord-based fingerings
-                        // do this before adding chord to skyline
-                        if (e->isChord()) {
-                            Chord* c = toChord(e);
-                            std::list<Note*> notes;
-                            for (auto gc : c->graceNotes()) {
-                                for (auto n : gc->notes()) {
-                                    notes.push_back(n);
-                                }
-                            }
-                            for (auto n : c->notes()) {
-                                notes.push_back(n);
-                            }
-                            for (Note* note : notes) {
-                                for (Element* en : note->el()) {
-                                    if (en->isFingering()) {
-                                        Fingering* f = toFingering(en);
-                                        if (f->layoutType() == ElementType::CHORD) {
-                                            f->setPos(QPointF());
-                                            f->setbbox(QRectF());
-                                        }
-                                    }
-                                }
-                            }
-                        }
-
-                        // add element to skyline
-                        if (e->addToSkyline()) {
-                            skyline.add(e->shape().translated(e->pos() + p));
-                        }
-
-                        // add tremolo to skyline
-                        if (e->isChord() && toChord(e)->tremolo()) {
-                            Tremolo* t = toChord(e)->tremolo();
-                            Chord* c1 = t->chord1();
-                            Chord* c2 = t->chord2();
-                            if (!t->twoNotes() || (c1 && !c1->staffMove() && c2 && !c2->staffMove())) {
-                                if (t->chord() == e && t->addToSkyline()) {
-                                    skyline.add(t->shape().translated(t->pos() + e->pos() + p));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    createSkylines(this, system, lc);
 
     //-------------------------------------------------------------
     // layout fingerings, add beams to skylines
@@ -4667,7 +4991,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
             }
         }
     }
-    processLines(system, spanner, false);
+    layoutSlurs(system, spanner);
     for (auto s : spanner) {
         Slur* slur = toSlur(s);
         ChordRest* scr = s->startCR();
@@ -4719,7 +5043,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
         int si = d->staffIdx();
         Segment* s = d->segment();
         Measure* m = s->measure();
-        system->staff(si)->skyline().add(d->shape().translated(d->pos() + s->pos() + m->pos()));
+        system->staff(si)->skyline().add(d->shape(), d->pos() + s->pos() + m->pos());
     }
 
     //-------------------------------------------------------------
@@ -4894,7 +5218,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
                     ss->rypos() = y;
                 }
                 if (ss->addToSkyline()) {
-                    system->staff(staffIdx)->skyline().add(ss->shape().translated(ss->pos()));
+                    system->staff(staffIdx)->skyline().add(ss->shape(), ss->pos());
                 }
             }
 
@@ -5034,6 +5358,7 @@ void LayoutContext::collectPage()
         bool collected = false;
         if (rangeDone) {
             // take next system unchanged
+            ++statistics.reusedSystems;
             if (systemIdx > 0) {
                 nextSystem = score->systems().value(systemIdx++);
                 if (!nextSystem) {
@@ -5215,14 +5540,173 @@ public:
     ~CmdStateLocker() { score->cmdState().unlock(); }
 };
 
+//---------------------------------------------------------
+//   mixFingerprint
+//---------------------------------------------------------
+
+static void mixFingerprint(quint64& h, qreal v)
+{
+    quint64 bits;
+    memcpy(&bits, &v, sizeof(bits));
+    h = (h ^ bits) * 1099511628211ull;
+}
+
+static void mixFingerprint(quint64& h, const QRectF& r)
+{
+    mixFingerprint(h, r.x());
+    mixFingerprint(h, r.y());
+    mixFingerprint(h, r.width());
+    mixFingerprint(h, r.height());
+}
+
+//---------------------------------------------------------
+//   systemFingerprint
+//    of the positions and shapes of the measures and the
+//    segments of a system and of its spanner segments,
+//    to tell if a layout left the system as it was
+//---------------------------------------------------------
+
+static quint64 systemFingerprint(const Score* score, const System* system)
+{
+    quint64 h = 14695981039346656037ull;
+    for (const MeasureBase* mb : system->measures()) {
+        mixFingerprint(h, mb->bbox().translated(mb->pos()));
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        for (const Segment* s = toMeasure(mb)->first(); s; s = s->next()) {
+            mixFingerprint(h, s->x());
+            mixFingerprint(h, s->width());
+            for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+                for (const ShapeElement& r : s->staffShape(staffIdx)) {
+                    mixFingerprint(h, r);
+                }
+            }
+        }
+    }
+    for (const SpannerSegment* ss : system->spannerSegments()) {
+        mixFingerprint(h, ss->bbox().translated(ss->pos()));
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   systemArea
+//    the area a system paints, in canvas coordinates: the
+//    width of the page, as for the names and the brackets,
+//    and the height of the system with the elements above
+//    and below the staves
+//---------------------------------------------------------
+
+static QRectF systemArea(const System* system)
+{
+    const Page* page = system->page();
+    if (!page) {
+        return QRectF();
+    }
+    const QRectF r = system->canvasBoundingRect();
+    const qreal top = qMax(system->minTop(), 0.0);
+    const qreal bottom = qMax(system->minBottom(), 0.0);
+    return QRectF(page->canvasPos().x(), r.y() - top, page->width(), r.height() + top + bottom);
+}
+
+//---------------------------------------------------------
+//   LayoutContext::saveSystemAreas
+//    of the systems from the start of the layout range up
+//    to the end of the page after it, before the layout.
+//    Systems further on count as changed if the layout
+//    reaches them.
+//---------------------------------------------------------
+
+void LayoutContext::saveSystemAreas()
+{
+    const int lastPage = curPage + 1;
+    for (const System* system : qAsConst(systemList)) {
+        if (system->measures().empty()) {
+            continue;
+        }
+        if (system->page() && score->pageIdx(system->page()) > lastPage) {
+            break;
+        }
+        const MeasureBase* first = system->measures().front();
+        oldSystems.push_back({ first, system->measures().back(), first->no(), systemArea(system),
+                               systemFingerprint(score, system) });
+    }
+}
+
+//---------------------------------------------------------
+//   LayoutContext::addChangedSystems
+//    adds the old and the new areas of the systems of the
+//    layout range and of the systems the layout changed
+//    after it to changedArea. A system after the range is
+//    unchanged if it holds the same measures at the same
+//    place, looks the same and no spanner of the range
+//    reaches into it.
+//---------------------------------------------------------
+
+void LayoutContext::addChangedSystems(int firstSystem)
+{
+    std::vector<bool> matched(oldSystems.size(), false);
+    const QList<System*>& systems = score->systems();
+    for (int i = firstSystem; i < systems.size(); ++i) {
+        const System* system = systems[i];
+        if (system->measures().empty()) {
+            continue;
+        }
+        const MeasureBase* first = system->measures().front();
+        const MeasureBase* last  = system->measures().back();
+        const QRectF area = systemArea(system);
+        auto old = std::find_if(oldSystems.begin(), oldSystems.end(), [first](const SystemArea& a) {
+            return a.first == first;
+        });
+        if (old != oldSystems.end()) {
+            matched[old - oldSystems.begin()] = true;
+        }
+        bool changed = old == oldSystems.end() || old->last != last || old->no != first->no() || old->area != area
+                       || (first->tick() <= endTick && last->endTick() > startTick);
+        if (!changed) {
+            for (const SpannerSegment* ss : system->spannerSegments()) {
+                const Spanner* sp = ss->spanner();
+                if (sp->tick() <= endTick && sp->tick2() >= startTick) {
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        if (!changed) {
+            changed = old->fingerprint != systemFingerprint(score, system);
+        }
+        if (changed) {
+            changedArea |= area;
+            if (old != oldSystems.end()) {
+                changedArea |= old->area;
+            }
+        }
+    }
+    for (size_t i = 0; i < oldSystems.size(); ++i) {
+        if (!matched[i]) {
+            changedArea |= oldSystems[i].area;
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   doLayoutRange
 //---------------------------------------------------------
 
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
+    TRACEFUNC;
+    mu::commandstats::PhaseTimer statsTimer(mu::commandstats::Phase::Layout);
+
+    finishLayout();
+
+    QElapsedTimer layoutTimer;
+    layoutTimer.start();
+
     CmdStateLocker cmdStateLocker(this);
-    LayoutContext lc(this);
+    std::unique_ptr<LayoutContext> context(new LayoutContext(this));
+    LayoutContext& lc = *context;
 
     Fraction stick(st);
     Fraction etick(et);
@@ -5235,6 +5719,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         qDeleteAll(pages());
         pages().clear();
         lc.getNextPage();
+        setAllChanged();
         return;
     }
 //      if (!_systems.isEmpty())
@@ -5248,6 +5733,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
     }
 
     lc.endTick     = etick;
+    lc.systemLocal = cmdState().layoutFlags & LayoutFlag::SYSTEM_LOCAL;
     _scoreFont     = ScoreFont::fontFactory(style().value(Sid::MusicalSymbolFont).toString());
     _noteHeadWidth = _scoreFont->width(SymId::noteheadBlack, spatium() / SPATIUM20);
 
@@ -5299,8 +5785,12 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         lc.nextMeasure = m;         //_showVBox ? first() : firstMeasure();
         lc.startTick   = m->tick();
         layoutLinear(layoutAll, lc);
+        lc.statistics.timeMs += layoutTimer.nsecsElapsed() / 1e6;
+        setLayoutStatistics(lc.statistics);
+        setAllChanged();
         return;
     }
+    int firstChangedSystem = 0;
     if (!layoutAll && m->system()) {
         System* system  = m->system();
         int systemIndex = _systems.indexOf(system);
@@ -5311,6 +5801,9 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         }
         lc.curSystem   = system;
         lc.systemList  = _systems.mid(systemIndex);
+        lc.startTick   = m->tick();
+        lc.saveSystemAreas();
+        firstChangedSystem = systemIndex;
 
         if (systemIndex == 0) {
             lc.nextMeasure = _showVBox ? first() : firstMeasure();
@@ -5374,24 +5867,131 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
         lc.nextMeasure = _showVBox ? first() : firstMeasure();
     }
 
+    const int pageCount = npages();
+    const int maxPages = layoutAll && _lazyLayoutPages > 0 ? _lazyLayoutPages : std::numeric_limits<int>::max();
+    if (layoutAll && _lazyLayoutPages > 0) {
+        // empty pages where the last layout of the score had
+        // pages, so that the canvas keeps its size while the
+        // pages are filled
+        for (int i = 0; i < _pageCountHint; ++i) {
+            lc.getNextPage();
+        }
+        if (!pages().isEmpty()) {
+            lc.page    = pages().front();
+            lc.curPage = 0;
+        }
+        _lazyLayoutPages = 0;
+    }
+
     lc.prevMeasure = 0;
 
     getNextMeasure(lc);
     lc.curSystem = collectSystem(lc);
 
-    lc.layout();
+    const bool done = lc.layout(maxPages);
+    lc.statistics.timeMs += layoutTimer.nsecsElapsed() / 1e6;
+    if (!done) {
+        _pendingLayout = context.release();
+        return;
+    }
+    setLayoutStatistics(lc.statistics);
+    if (layoutAll || npages() != pageCount) {
+        // a page count in the headers and footers may change with the pages
+        setAllChanged();
+    } else {
+        lc.addChangedSystems(firstChangedSystem);
+        addChangedArea(lc.changedArea);
+    }
+}
+
+//---------------------------------------------------------
+//   setLazyLayout
+//    the next complete layout only lays out the first
+//    pages, continueLayout() adds the others
+//---------------------------------------------------------
+
+void Score::setLazyLayout(int firstPages, int pageCountHint)
+{
+    _lazyLayoutPages = firstPages;
+    _pageCountHint   = pageCountHint;
+}
+
+//---------------------------------------------------------
+//   continueLayout
+//    lays out up to the given number of pages more of a
+//    lazy layout, returns true if it is done
+//---------------------------------------------------------
+
+bool Score::continueLayout(int pages)
+{
+    if (!_pendingLayout) {
+        return true;
+    }
+    CmdStateLocker cmdStateLocker(this);
+    std::unique_ptr<LayoutContext> lc(_pendingLayout);
+    _pendingLayout = nullptr;
+    QElapsedTimer layoutTimer;
+    layoutTimer.start();
+    const bool done = lc->layout(pages);
+    lc->statistics.timeMs += layoutTimer.nsecsElapsed() / 1e6;
+    if (!done) {
+        _pendingLayout = lc.release();
+        return false;
+    }
+    setLayoutStatistics(lc->statistics);
+    setAllChanged();
+    lc.reset();
+
+    if (masterScore()) {
+        masterScore()->layoutFinished();
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   setLayoutStatistics
+//---------------------------------------------------------
+
+void Score::setLayoutStatistics(const LayoutStatistics& st)
+{
+    _layoutStatistics = st;
+    _layoutStatistics.layouts = 1;
+    _layoutTotals.add(_layoutStatistics);
+    mu::commandstats::addMeasures(st.measures);
+}
+
+//---------------------------------------------------------
+//   LayoutStatistics::add
+//---------------------------------------------------------
+
+void LayoutStatistics::add(const LayoutStatistics& st)
+{
+    layouts       += st.layouts;
+    measures      += st.measures;
+    systems       += st.systems;
+    reusedSystems += st.reusedSystems;
+    pages         += st.pages;
+    cutOffs       += st.cutOffs;
+    timeMs        += st.timeMs;
 }
 
 //---------------------------------------------------------
 //   layout
+//    returns false if it stopped after maxPages pages while
+//    there is more to lay out; it can be called again to
+//    go on from there
 //---------------------------------------------------------
 
-void LayoutContext::layout()
+bool LayoutContext::layout(int maxPages)
 {
     MeasureBase* lmb;
     do {
+        if (maxPages-- <= 0) {
+            return false;
+        }
         getNextPage();
         collectPage();
+        ++statistics.pages;
 
         if (page && !page->systems().isEmpty()) {
             lmb = page->systems().back()->measures().back();
@@ -5411,12 +6011,17 @@ void LayoutContext::layout()
     } while (curSystem && !(rangeDone && lmb == pageOldMeasure));
     // && page->system(0)->measures().back()->tick() > endTick // FIXME: perhaps the first measure was meant? Or last system?
 
+    if (curSystem) {
+        ++statistics.cutOffs;
+    }
+
     if (!curSystem) {
         // The end of the score. The remaining systems are not needed...
         qDeleteAll(systemList);
         systemList.clear();
         // ...and the remaining pages too
         while (score->npages() > curPage) {
+            changedArea |= score->pages().back()->canvasBoundingRect();
             delete score->pages().takeLast();
         }
     } else {
@@ -5426,6 +6031,7 @@ void LayoutContext::layout()
         }
     }
     score->systems().append(systemList);       // TODO
+    return true;
 }
 
 //---------------------------------------------------------
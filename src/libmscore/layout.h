@@ -13,9 +13,11 @@
 #ifndef __LAYOUT_H__
 #define __LAYOUT_H__
 
+#include <limits>
 #include <set>
 #include <QList>
 
+#include "score.h"
 #include "system.h"
 
 namespace Ms {
@@ -98,8 +100,11 @@ struct LayoutContext {
     System* curSystem        { 0 };
 
     MeasureBase* systemOldMeasure { 0 };
+    qreal systemOldWidth          { -1.0 };
+    qreal systemOldHeight         { -1.0 };
     MeasureBase* pageOldMeasure   { 0 };
     bool rangeDone           { false };
+    bool systemLocal         { false };
 
     MeasureBase* prevMeasure { 0 };
     MeasureBase* curMeasure  { 0 };
@@ -108,6 +113,18 @@ struct LayoutContext {
     Fraction startTick;
     Fraction endTick;
 
+    LayoutStatistics statistics;
+    QRectF changedArea;                   // in canvas coordinates
+
+    struct SystemArea {
+        const MeasureBase* first;
+        const MeasureBase* last;
+        int no;                           // of the first measure, as shown by the measure numbers
+        QRectF area;
+        quint64 fingerprint;
+    };
+    std::vector<SystemArea> oldSystems;   // before the layout, to find the systems it did not change
+
     LayoutContext(Score* s);
     LayoutContext(const LayoutContext&) = delete;
     LayoutContext& operator=(const LayoutContext&) = delete;
@@ -115,10 +132,12 @@ struct LayoutContext {
 
     void layoutLinear();
 
-    void layout();
+    bool layout(int maxPages = std::numeric_limits<int>::max());
     int adjustMeasureNo(MeasureBase*);
     void getNextPage();
     void collectPage();
+    void saveSystemAreas();
+    void addChangedSystems(int firstSystem);
 };
 
 //---------------------------------------------------------
@@ -82,7 +82,7 @@ void LayoutBreak::write(XmlWriter& xml) const
 void LayoutBreak::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             readProperty(e, Pid::LAYOUT_BREAK);
         } else if (tag == "pause") {
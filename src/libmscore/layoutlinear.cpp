@@ -98,6 +98,7 @@ void Score::collectLinearSystem(LayoutContext& lc)
 {
     System* system = systems().front();
     system->setInstrumentNames(/* longNames */ true);
+    ++lc.statistics.systems;
 
     QPointF pos;
     bool firstMeasure = true;       //lc.startTick.isZero();
@@ -140,6 +141,7 @@ void Score::collectLinearSystem(LayoutContext& lc)
             }
             if (m->tick() >= lc.startTick && m->tick() <= lc.endTick) {
                 // for measures in range, do full layout
+                ++lc.statistics.measures;
                 m->createEndBarLines(false);
                 m->computeMinWidth();
                 ww = m->width();
@@ -216,16 +218,18 @@ void LayoutContext::layoutLinear()
         }
         Measure* m = toMeasure(mb);
 
+        // the chords and rests of the measures out of range keep their layout,
+        // there only the bar lines have to follow the staff distances
+        const bool inRange = m->tick() >= startTick && m->tick() <= endTick;
+        const SegmentType segmentTypes = inRange ? SegmentType::All : SegmentType::BarLineType;
+
         for (int track = 0; track < score->ntracks(); ++track) {
-            for (Segment* segment = m->first(); segment; segment = segment->next()) {
+            for (Segment* segment = m->first(segmentTypes); segment; segment = segment->next(segmentTypes)) {
                 Element* e = segment->element(track);
                 if (!e) {
                     continue;
                 }
                 if (e->isChordRest()) {
-                    if (m->tick() < startTick || m->tick() > endTick) {
-                        continue;
-                    }
                     if (!score->staff(track2staff(track))->show()) {
                         continue;
                     }
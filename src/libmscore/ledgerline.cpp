@@ -126,7 +126,7 @@ void LedgerLine::writeProperties(XmlWriter& xml) const
 
 bool LedgerLine::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "lineWidth") {
         _width = e.readDouble() * spatium();
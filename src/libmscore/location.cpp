@@ -69,7 +69,7 @@ void Location::write(XmlWriter& xml) const
 void Location::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "staves") {
             _staff = e.readInt();
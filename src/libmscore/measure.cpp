@@ -15,7 +15,9 @@
  Implementation of most part of class Measure.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
 
 #include "log.h"
 
@@ -115,6 +117,16 @@ MStaff::MStaff(const MStaff& m)
     m_corrupted = m.m_corrupted;
 #endif
     m_measureRepeatCount = 0;
+    m_contentHash = m.m_contentHash;
+}
+
+//---------------------------------------------------------
+//   rollContentHash
+//---------------------------------------------------------
+
+void MStaff::rollContentHash(quint64 revision)
+{
+    m_contentHash ^= revision + 0x9e3779b97f4a7c15ULL + (m_contentHash << 6) + (m_contentHash >> 2);
 }
 
 //---------------------------------------------------------
@@ -789,14 +801,9 @@ ChordRest* Measure::findChordRest(Fraction t, int track)
 Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 {
     Fraction t = _t - tick();
-    for (Segment& s : m_segments) {
-        if (s.rtick() == t) {
-            if (s.segmentType() & st) {
-                return &s;
-            }
-        }
-        if (s.rtick() > t) {
-            break;
+    for (Segment* s = m_segments.firstAt(t); s && s->rtick() == t; s = s->next()) {
+        if (s->segmentType() & st) {
+            return s;
         }
     }
     return 0;
@@ -810,20 +817,7 @@ Segment* Measure::tick2segment(const Fraction& _t, SegmentType st)
 
 Segment* Measure::findSegmentR(SegmentType st, const Fraction& t) const
 {
-    Segment* s;
-    if (t > (ticks() * Fraction(1,2))) {
-        // search backwards
-        for (s = last(); s && s->rtick() > t; s = s->prev()) {
-        }
-        while (s && s->prev() && s->prev()->rtick() == t) {
-            s = s->prev();
-        }
-    } else {
-        // search forwards
-        for (s = first(); s && s->rtick() < t; s = s->next()) {
-        }
-    }
-    for (; s && s->rtick() == t; s = s->next()) {
+    for (Segment* s = m_segments.firstAt(t); s && s->rtick() == t; s = s->next()) {
         if (s->segmentType() & st) {
             return s;
         }
@@ -887,6 +881,7 @@ Segment* Measure::getSegmentR(SegmentType st, const Fraction& t)
 void Measure::add(Element* e)
 {
     e->setParent(this);
+    contentChanged();
     ElementType type = e->type();
 
     switch (type) {
@@ -911,6 +906,7 @@ void Measure::add(Element* e)
         }
         seg->setParent(this);
         m_segments.insert(seg, s);
+        invalidateMinWidth();
         //
         // update measure flags
         //
@@ -1017,12 +1013,14 @@ void Measure::remove(Element* e)
 {
     Q_ASSERT(e->parent() == this);
     Q_ASSERT(e->score() == score());
+    contentChanged();
 
     switch (e->type()) {
     case ElementType::SEGMENT:
     {
         Segment* s = toSegment(e);
         m_segments.remove(s);
+        invalidateMinWidth();
         //
         // update measure flags
         //
@@ -1175,9 +1173,7 @@ void Measure::moveTicks(const Fraction& diff)
 void Measure::removeStaves(int sStaff, int eStaff)
 {
     for (Segment* s = first(); s; s = s->next()) {
-        for (int staff = eStaff - 1; staff >= sStaff; --staff) {
-            s->removeStaff(staff);
-        }
+        s->removeStaves(sStaff, eStaff);
     }
     for (Element* e : el()) {
         if (e->track() == -1) {
@@ -1210,9 +1206,7 @@ void Measure::insertStaves(int sStaff, int eStaff)
         }
     }
     for (Segment* s = first(); s; s = s->next()) {
-        for (int staff = sStaff; staff < eStaff; ++staff) {
-            s->insertStaff(staff);
-        }
+        s->insertStaves(sStaff, eStaff);
     }
 }
 
@@ -1370,6 +1364,7 @@ void Measure::cmdAddStaves(int sStaff, int eStaff, bool createRest)
 void Measure::insertMStaff(MStaff* staff, int idx)
 {
     m_mstaves.insert(m_mstaves.begin() + idx, staff);
+    contentChanged();
     for (unsigned staffIdx = 0; staffIdx < m_mstaves.size(); ++staffIdx) {
         m_mstaves[staffIdx]->setTrack(staffIdx * VOICES);
     }
@@ -1382,6 +1377,7 @@ void Measure::insertMStaff(MStaff* staff, int idx)
 void Measure::removeMStaff(MStaff* /*staff*/, int idx)
 {
     m_mstaves.erase(m_mstaves.begin() + idx);
+    contentChanged();
     for (unsigned staffIdx = 0; staffIdx < m_mstaves.size(); ++staffIdx) {
         m_mstaves[staffIdx]->setTrack(staffIdx * VOICES);
     }
@@ -1394,7 +1390,7 @@ void Measure::removeMStaff(MStaff* /*staff*/, int idx)
 void Measure::insertStaff(Staff* staff, int staffIdx)
 {
     for (Segment* s = first(); s; s = s->next()) {
-        s->insertStaff(staffIdx);
+        s->insertStaves(staffIdx, staffIdx + 1);
     }
 
     MStaff* ms = new MStaff;
@@ -2094,7 +2090,7 @@ void Measure::read(XmlReader& e, int staffIdx)
     }
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "voice") {
             e.setTrack(nextTrack++);
@@ -2205,7 +2201,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
     Fraction timeStretch(staff->timeStretch(tick()));
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "location") {
             Location loc = Location::relative();
@@ -2759,6 +2755,7 @@ void Measure::sortStaves(QList<int>& dst)
 
 //---------------------------------------------------------
 //   exchangeVoice
+//    the slurs are fixed by Score::exchangeVoice()
 //---------------------------------------------------------
 
 void Measure::exchangeVoice(int strack, int dtrack, int staffIdx)
@@ -2766,29 +2763,6 @@ void Measure::exchangeVoice(int strack, int dtrack, int staffIdx)
     for (Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
         s->swapElements(strack, dtrack);
     }
-
-    auto spanners = score()->spannerMap().findOverlapping(tick().ticks(), endTick().ticks() - 1);
-    Fraction start = tick();
-    Fraction end = start + ticks();
-    for (auto i = spanners.begin(); i < spanners.end(); i++) {
-        Spanner* sp = i->value;
-        Fraction spStart = sp->tick();
-        Fraction spEnd = spStart + sp->ticks();
-        qDebug("Start %d End %d Diff %d \n Measure Start %d End %d", spStart.ticks(), spEnd.ticks(), (spEnd - spStart).ticks(),
-               start.ticks(), end.ticks());
-        if (sp->isSlur() && (spStart >= start || spEnd < end)) {
-            if (sp->track() == strack && spStart >= start) {
-                sp->setTrack(dtrack);
-            } else if (sp->track() == dtrack && spStart >= start) {
-                sp->setTrack(strack);
-            }
-            if (sp->track2() == strack && spEnd < end) {
-                sp->setTrack2(dtrack);
-            } else if (sp->track2() == dtrack && spEnd < end) {
-                sp->setTrack2(strack);
-            }
-        }
-    }
     checkMultiVoices(staffIdx);     // probably true, but check for invisible notes & rests
 }
 
@@ -2881,44 +2855,84 @@ bool Measure::hasVoice(int track) const
     return false;
 }
 
-//-------------------------------------------------------------------
-//   isEmpty
-///   Check if the measure is filled by a full-measure rest, or is
-///   full of rests on this staff, that may have fermatas on them.
-///   If staff is -1, then check for all staves.
-//-------------------------------------------------------------------
+//---------------------------------------------------------
+//   contentChanged
+//    an element of the measure was added, removed or
+//    changed
+//---------------------------------------------------------
 
-bool Measure::isEmpty(int staffIdx) const
+void Measure::contentChanged()
 {
-    int strack;
-    int etrack;
-    bool hasStaves = score()->staff(staffIdx)->part()->staves()->size() > 1;
-    if (staffIdx < 0) {
-        strack = 0;
-        etrack = score()->nstaves() * VOICES;
-    } else {
-        strack = staffIdx * VOICES;
-        etrack = strack + VOICES;
+    static std::atomic<unsigned> revisions { 0 };
+    m_contentRevision = ++revisions;
+    m_staffContentValid.store(false, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+//   staffContentChanged
+//    an element of the staff, of all staves if staffIdx is
+//    out of range, got the revision
+//---------------------------------------------------------
+
+void Measure::staffContentChanged(int staffIdx, quint64 revision)
+{
+    if (staffIdx >= 0 && staffIdx < int(m_mstaves.size())) {
+        m_mstaves[staffIdx]->rollContentHash(revision);
+        return;
+    }
+    for (MStaff* ms : m_mstaves) {
+        ms->rollContentHash(revision);
     }
+}
+
+//---------------------------------------------------------
+//   contentHash
+//    of all staves; the same as long as nothing of the
+//    measure is changed
+//---------------------------------------------------------
+
+quint64 Measure::contentHash() const
+{
+    quint64 hash = 0;
+    for (const MStaff* ms : m_mstaves) {
+        hash ^= ms->contentHash() + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+//---------------------------------------------------------
+//   staffContent
+//    which staves have content, in a single pass over the
+//    segments for all of them. Measure::visible() may ask
+//    from several threads of the layout at once.
+//---------------------------------------------------------
+
+const std::vector<char>& Measure::staffContent() const
+{
+    if (m_staffContentValid.load(std::memory_order_acquire)) {
+        return m_staffContent;
+    }
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (m_staffContentValid.load(std::memory_order_relaxed)) {
+        return m_staffContent;
+    }
+    const int nstaves = score()->nstaves();
+    m_staffContent.assign(nstaves, 0);
     for (Segment* s = first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
-        for (int track = strack; track < etrack; ++track) {
-            Element* e = s->element(track);
-            if (e && !e->isRest()) {
-                return false;
+        for (int track = 0; track < nstaves * VOICES; ++track) {
+            const Element* e = s->element(track);
+            if (!e || e->isRest()) {
+                continue;
             }
-            // Check for cross-staff chords
-            if (hasStaves) {
-                if (strack >= VOICES) {
-                    e = s->element(track - VOICES);
-                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
-                        return false;
-                    }
-                }
-                if (etrack < score()->nstaves() * VOICES) {
-                    e = s->element(track + VOICES);
-                    if (e && !e->isRest() && e->vStaffIdx() == staffIdx) {
-                        return false;
-                    }
+            const int staffIdx  = track / VOICES;
+            const int vStaffIdx = e->vStaffIdx();
+            m_staffContent[staffIdx] |= STAFF_NOT_EMPTY;
+            if (vStaffIdx >= 0 && vStaffIdx < nstaves) {
+                m_staffContent[vStaffIdx] |= STAFF_CHORDS_IN;
+                // a cross-staff chord of the staff next to it
+                if (qAbs(vStaffIdx - staffIdx) == 1) {
+                    m_staffContent[vStaffIdx] |= STAFF_NOT_EMPTY;
                 }
             }
         }
@@ -2926,13 +2940,41 @@ bool Measure::isEmpty(int staffIdx) const
             if (!a || a->systemFlag() || !a->visible() || a->isFermata()) {
                 continue;
             }
-            int atrack = a->track();
-            if (atrack >= strack && atrack < etrack) {
-                return false;
+            const int staffIdx = a->track() / VOICES;
+            if (a->track() >= 0 && staffIdx < nstaves) {
+                m_staffContent[staffIdx] |= STAFF_NOT_EMPTY;
             }
         }
     }
-    return true;
+    m_staffContentValid.store(true, std::memory_order_release);
+    return m_staffContent;
+}
+
+//-------------------------------------------------------------------
+//   isEmpty
+///   Check if the measure is filled by a full-measure rest, or is
+///   full of rests on this staff, that may have fermatas on them.
+///   If staff is -1, then check for all staves.
+//-------------------------------------------------------------------
+
+bool Measure::isEmpty(int staffIdx) const
+{
+    const std::vector<char>& content = staffContent();
+    if (staffIdx < 0) {
+        return std::none_of(content.begin(), content.end(), [](char c) { return c & STAFF_NOT_EMPTY; });
+    }
+    return !(content[staffIdx] & STAFF_NOT_EMPTY);
+}
+
+//---------------------------------------------------------
+//   hasChordsIn
+//    if chords of this staff or chords moved from another
+//    staff of the part are shown in the staff
+//---------------------------------------------------------
+
+bool Measure::hasChordsIn(int staffIdx) const
+{
+    return staffContent()[staffIdx] & STAFF_CHORDS_IN;
 }
 
 //---------------------------------------------------------
@@ -4754,6 +4796,61 @@ void Measure::computeMinWidth(Segment* s, qreal x, bool isSystemHeader)
     setStretchedWidth(x);
 }
 
+//---------------------------------------------------------
+//   restoreMinWidth
+//    sets the segment positions and the width saved by the
+//    last computeMinWidth() if the segments and their
+//    shapes did not change since and the measure starts
+//    the same way
+//---------------------------------------------------------
+
+bool Measure::restoreMinWidth(qreal x, bool isFirst)
+{
+    if (!m_minWidthValid || x != m_minWidthX || isFirst != m_minWidthFirst) {
+        return false;
+    }
+    auto i = m_minWidthSegments.cbegin();
+    for (Segment* s = first(); s; s = s->next(), ++i) {
+        if (i == m_minWidthSegments.cend() || i->segment != s || i->enabled != s->enabled()
+            || i->visible != s->visible() || i->header != s->header()) {
+            return false;
+        }
+    }
+    if (i != m_minWidthSegments.cend()) {
+        return false;
+    }
+    i = m_minWidthSegments.cbegin();
+    for (Segment* s = first(); s; s = s->next(), ++i) {
+        s->rxpos() = i->x;
+        s->setWidth(i->width);
+    }
+    setWidth(m_minWidth);
+    return true;
+}
+
+//---------------------------------------------------------
+//   saveMinWidth
+//---------------------------------------------------------
+
+void Measure::saveMinWidth(qreal x, bool isFirst)
+{
+    m_minWidthSegments.clear();
+    m_minWidthHeader  = 0.0;
+    m_minWidthTrailer = 0.0;
+    for (Segment* s = first(); s; s = s->next()) {
+        m_minWidthSegments.push_back({ s, s->enabled(), s->visible(), s->header(), s->rxpos(), s->width() });
+        if (s->header()) {
+            m_minWidthHeader += s->width();
+        } else if (s->trailer()) {
+            m_minWidthTrailer += s->width();
+        }
+    }
+    m_minWidthX     = x;
+    m_minWidth      = width();
+    m_minWidthFirst = isFirst;
+    m_minWidthValid = true;
+}
+
 void Measure::computeMinWidth()
 {
     Segment* s;
@@ -4806,6 +4903,14 @@ void Measure::computeMinWidth()
     x += s->extraLeadingSpace().val() * spatium();
     bool isSystemHeader = s->header();
 
+    if (restoreMinWidth(x, first)) {
+        return;
+    }
     computeMinWidth(s, x, isSystemHeader);
+    saveMinWidth(x, first);
+    // a multimeasure rest resets its shapes in computeMinWidth(), only the widths are kept
+    if (isMMRest()) {
+        invalidateMinWidth();
+    }
 }
 }
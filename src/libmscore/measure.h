@@ -18,6 +18,8 @@
  Definition of class Measure.
 */
 
+#include <atomic>
+
 #include "measurebase.h"
 #include "fraction.h"
 #include "segmentlist.h"
@@ -98,6 +100,9 @@ public:
     int measureRepeatCount() const { return m_measureRepeatCount; }
     void setMeasureRepeatCount(int n) { m_measureRepeatCount = n; }
 
+    quint64 contentHash() const { return m_contentHash; }
+    void rollContentHash(quint64 revision);
+
 private:
     MeasureNumber* m_noText { nullptr };      ///< Measure number text object
     MMRestRange* m_mmRangeText { nullptr };    ///< Multi measure rest range text object
@@ -112,6 +117,7 @@ private:
     bool m_corrupted        { false };
 #endif
     int m_measureRepeatCount { 0 };
+    quint64 m_contentHash   { 0 };      ///< rolled by each change of an element of the staff
 };
 
 //---------------------------------------------------------
@@ -263,6 +269,14 @@ public:
     void checkMultiVoices(int staffIdx);
     bool hasVoice(int track) const;
     bool isEmpty(int staffIdx) const;
+    bool hasChordsIn(int staffIdx) const;
+    void contentChanged();
+    unsigned contentRevision() const { return m_contentRevision; }
+    quint64 contentHash(int staffIdx) const { return m_mstaves[staffIdx]->contentHash(); }
+    quint64 contentHash() const;
+    void staffContentChanged(int staffIdx, quint64 revision);
+    quint64 mmRestSourceKey() const { return m_mmRestSourceKey; }
+    void setMMRestSourceKey(quint64 k) { m_mmRestSourceKey = k; }
     bool isCutawayClef(int staffIdx) const;
     bool isFullMeasureRest() const;
     bool visible(int staffIdx) const;
@@ -328,6 +342,10 @@ public:
     void checkHeader();
     void checkTrailer();
     void setStretchedWidth(qreal);
+    void invalidateMinWidth() { m_minWidthValid = false; }
+    // from the last computeMinWidth(), even if invalid since; -1.0 if there was none yet
+    qreal savedBodyWidth() const { return m_minWidthSegments.empty() ? -1.0 : m_minWidth - m_minWidthHeader - m_minWidthTrailer; }
+    qreal savedHeaderWidth() const { return m_minWidthHeader; }
     void layoutStaffLines();
 
 private:
@@ -336,6 +354,8 @@ private:
 
     void fillGap(const Fraction& pos, const Fraction& len, int track, const Fraction& stretch);
     void computeMinWidth(Segment* s, qreal x, bool isSystemHeader);
+    bool restoreMinWidth(qreal x, bool isFirst);
+    void saveMinWidth(qreal x, bool isFirst);
 
     void readVoice(XmlReader& e, int staffIdx, bool irregular);
 
@@ -358,6 +378,34 @@ private:
 
     int m_repeatCount;          ///< end repeat marker and repeat count
 
+    struct MinWidthSegment {
+        Segment* segment;
+        bool enabled;
+        bool visible;
+        bool header;
+        qreal x;
+        qreal width;
+    };
+    // the segment positions computed by computeMinWidth(), valid until a shape changes
+    std::vector<MinWidthSegment> m_minWidthSegments;
+    qreal m_minWidthX       { 0.0 };      // x of the first enabled segment
+    qreal m_minWidth        { 0.0 };      // the stretched width
+    qreal m_minWidthHeader  { 0.0 };      // of the header segments
+    qreal m_minWidthTrailer { 0.0 };      // of the trailer segments
+    bool m_minWidthFirst    { false };
+    bool m_minWidthValid    { false };
+
+    enum StaffContent : char {
+        STAFF_NOT_EMPTY = 1,               // as told by isEmpty()
+        STAFF_CHORDS_IN = 2                // chords of this or another staff are shown in the staff
+    };
+    // per staff, computed on demand and kept until an element is added, removed or changed
+    mutable std::vector<char> m_staffContent;
+    mutable std::atomic<bool> m_staffContentValid { false };
+    unsigned m_contentRevision { 0 };         // changed by contentChanged(), unique among all measures
+    quint64 m_mmRestSourceKey { 0 };          // of the measures a multimeasure rest was made of, see createMMRest()
+    const std::vector<char>& staffContent() const;
+
     MeasureNumberMode m_noMode;
     bool m_breakMultiMeasureRest;
 };
@@ -323,6 +323,18 @@ Fraction MeasureBase::tick() const
     return mb ? mb->_tick : Fraction(-1, 1);
 }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(const Fraction& f)
+{
+    _tick = f;
+    if (score()) {
+        score()->measures()->invalidateTickIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   triggerLayout
 //---------------------------------------------------------
@@ -572,7 +584,7 @@ void MeasureBase::writeProperties(XmlWriter& xml) const
 
 bool MeasureBase::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "LayoutBreak") {
         LayoutBreak* lb = new LayoutBreak(score());
         lb->read(e);
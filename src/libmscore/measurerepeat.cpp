@@ -180,7 +180,7 @@ void MeasureRepeat::write(XmlWriter& xml) const
 void MeasureRepeat::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             setNumMeasures(e.readInt());
         } else if (!Rest::readProperties(e)) {
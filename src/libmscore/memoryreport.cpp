@@ -0,0 +1,359 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "memoryreport.h"
+
+#include <iterator>
+
+#include "accidental.h"
+#include "ambitus.h"
+#include "arpeggio.h"
+#include "articulation.h"
+#include "audio.h"
+#include "bagpembell.h"
+#include "barline.h"
+#include "beam.h"
+#include "bend.h"
+#include "box.h"
+#include "bracket.h"
+#include "breath.h"
+#include "chord.h"
+#include "chordline.h"
+#include "clef.h"
+#include "dynamic.h"
+#include "excerpt.h"
+#include "fermata.h"
+#include "figuredbass.h"
+#include "fingering.h"
+#include "fret.h"
+#include "glissando.h"
+#include "hairpin.h"
+#include "harmony.h"
+#include "hook.h"
+#include "icon.h"
+#include "image.h"
+#include "imageStore.h"
+#include "iname.h"
+#include "instrchange.h"
+#include "jump.h"
+#include "keysig.h"
+#include "layoutbreak.h"
+#include "ledgerline.h"
+#include "letring.h"
+#include "lyrics.h"
+#include "marker.h"
+#include "measure.h"
+#include "measurenumber.h"
+#include "measurerepeat.h"
+#include "mmrest.h"
+#include "mmrestrange.h"
+#include "note.h"
+#include "notedot.h"
+#include "noteline.h"
+#include "ossia.h"
+#include "ottava.h"
+#include "page.h"
+#include "palmmute.h"
+#include "pedal.h"
+#include "rehearsalmark.h"
+#include "rest.h"
+#include "score.h"
+#include "segment.h"
+#include "shape.h"
+#include "skyline.h"
+#include "slur.h"
+#include "spacer.h"
+#include "stafflines.h"
+#include "staffstate.h"
+#include "stafftext.h"
+#include "stafftype.h"
+#include "stafftypechange.h"
+#include "stem.h"
+#include "stemslash.h"
+#include "sticking.h"
+#include "style.h"
+#include "symbol.h"
+#include "system.h"
+#include "systemdivider.h"
+#include "systemtext.h"
+#include "tempotext.h"
+#include "text.h"
+#include "textframe.h"
+#include "textline.h"
+#include "tie.h"
+#include "timesig.h"
+#include "tremolo.h"
+#include "tremolobar.h"
+#include "trill.h"
+#include "tuplet.h"
+#include "undo.h"
+#include "vibrato.h"
+#include "volta.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   elementSize
+//    the size of the class of an element of the type
+//---------------------------------------------------------
+
+static size_t elementSize(ElementType type)
+{
+    switch (type) {
+    case ElementType::VOLTA:                 return sizeof(Volta);
+    case ElementType::VOLTA_SEGMENT:         return sizeof(VoltaSegment);
+    case ElementType::OTTAVA:                return sizeof(Ottava);
+    case ElementType::OTTAVA_SEGMENT:        return sizeof(OttavaSegment);
+    case ElementType::TEXTLINE:              return sizeof(TextLine);
+    case ElementType::TEXTLINE_SEGMENT:      return sizeof(TextLineSegment);
+    case ElementType::NOTELINE:              return sizeof(NoteLine);
+    case ElementType::TRILL:                 return sizeof(Trill);
+    case ElementType::TRILL_SEGMENT:         return sizeof(TrillSegment);
+    case ElementType::LET_RING:              return sizeof(LetRing);
+    case ElementType::LET_RING_SEGMENT:      return sizeof(LetRingSegment);
+    case ElementType::VIBRATO:               return sizeof(Vibrato);
+    case ElementType::VIBRATO_SEGMENT:       return sizeof(VibratoSegment);
+    case ElementType::PALM_MUTE:             return sizeof(PalmMute);
+    case ElementType::PALM_MUTE_SEGMENT:     return sizeof(PalmMuteSegment);
+    case ElementType::PEDAL:                 return sizeof(Pedal);
+    case ElementType::PEDAL_SEGMENT:         return sizeof(PedalSegment);
+    case ElementType::HAIRPIN:               return sizeof(Hairpin);
+    case ElementType::HAIRPIN_SEGMENT:       return sizeof(HairpinSegment);
+    case ElementType::GLISSANDO:             return sizeof(Glissando);
+    case ElementType::GLISSANDO_SEGMENT:     return sizeof(GlissandoSegment);
+    case ElementType::SLUR:                  return sizeof(Slur);
+    case ElementType::SLUR_SEGMENT:          return sizeof(SlurSegment);
+    case ElementType::TIE:                   return sizeof(Tie);
+    case ElementType::TIE_SEGMENT:           return sizeof(TieSegment);
+    case ElementType::LYRICSLINE:            return sizeof(LyricsLine);
+    case ElementType::LYRICSLINE_SEGMENT:    return sizeof(LyricsLineSegment);
+    case ElementType::CLEF:                  return sizeof(Clef);
+    case ElementType::KEYSIG:                return sizeof(KeySig);
+    case ElementType::TIMESIG:               return sizeof(TimeSig);
+    case ElementType::BAR_LINE:              return sizeof(BarLine);
+    case ElementType::SYSTEM_DIVIDER:        return sizeof(SystemDivider);
+    case ElementType::ARPEGGIO:              return sizeof(Arpeggio);
+    case ElementType::BREATH:                return sizeof(Breath);
+    case ElementType::BRACKET:               return sizeof(Bracket);
+    case ElementType::ARTICULATION:          return sizeof(Articulation);
+    case ElementType::FERMATA:               return sizeof(Fermata);
+    case ElementType::CHORDLINE:             return sizeof(ChordLine);
+    case ElementType::ACCIDENTAL:            return sizeof(Accidental);
+    case ElementType::DYNAMIC:               return sizeof(Dynamic);
+    case ElementType::TEXT:                  return sizeof(Text);
+    case ElementType::MEASURE_NUMBER:        return sizeof(MeasureNumber);
+    case ElementType::MMREST_RANGE:          return sizeof(MMRestRange);
+    case ElementType::INSTRUMENT_NAME:       return sizeof(InstrumentName);
+    case ElementType::STAFF_TEXT:            return sizeof(StaffText);
+    case ElementType::SYSTEM_TEXT:           return sizeof(SystemText);
+    case ElementType::REHEARSAL_MARK:        return sizeof(RehearsalMark);
+    case ElementType::INSTRUMENT_CHANGE:     return sizeof(InstrumentChange);
+    case ElementType::STAFFTYPE_CHANGE:      return sizeof(StaffTypeChange);
+    case ElementType::NOTEHEAD:              return sizeof(NoteHead);
+    case ElementType::NOTEDOT:               return sizeof(NoteDot);
+    case ElementType::TREMOLO:               return sizeof(Tremolo);
+    case ElementType::LAYOUT_BREAK:          return sizeof(LayoutBreak);
+    case ElementType::MARKER:                return sizeof(Marker);
+    case ElementType::JUMP:                  return sizeof(Jump);
+    case ElementType::MEASURE_REPEAT:        return sizeof(MeasureRepeat);
+    case ElementType::ICON:                  return sizeof(Icon);
+    case ElementType::NOTE:                  return sizeof(Note);
+    case ElementType::SYMBOL:                return sizeof(Symbol);
+    case ElementType::FSYMBOL:               return sizeof(FSymbol);
+    case ElementType::CHORD:                 return sizeof(Chord);
+    case ElementType::REST:                  return sizeof(Rest);
+    case ElementType::MMREST:                return sizeof(MMRest);
+    case ElementType::SPACER:                return sizeof(Spacer);
+    case ElementType::STAFF_STATE:           return sizeof(StaffState);
+    case ElementType::TEMPO_TEXT:            return sizeof(TempoText);
+    case ElementType::HARMONY:               return sizeof(Harmony);
+    case ElementType::FRET_DIAGRAM:          return sizeof(FretDiagram);
+    case ElementType::BEND:                  return sizeof(Bend);
+    case ElementType::TREMOLOBAR:            return sizeof(TremoloBar);
+    case ElementType::LYRICS:                return sizeof(Lyrics);
+    case ElementType::FIGURED_BASS:          return sizeof(FiguredBass);
+    case ElementType::STEM:                  return sizeof(Stem);
+    case ElementType::STEM_SLASH:            return sizeof(StemSlash);
+    case ElementType::HOOK:                  return sizeof(Hook);
+    case ElementType::BEAM:                  return sizeof(Beam);
+    case ElementType::TUPLET:                return sizeof(Tuplet);
+    case ElementType::LEDGER_LINE:           return sizeof(LedgerLine);
+    case ElementType::STAFF_LINES:           return sizeof(StaffLines);
+    case ElementType::FINGERING:             return sizeof(Fingering);
+    case ElementType::HBOX:                  return sizeof(HBox);
+    case ElementType::VBOX:                  return sizeof(VBox);
+    case ElementType::TBOX:                  return sizeof(TBox);
+    case ElementType::FBOX:                  return sizeof(FBox);
+    case ElementType::MEASURE:               return sizeof(Measure);
+    case ElementType::SEGMENT:               return sizeof(Segment);
+    case ElementType::SYSTEM:                return sizeof(System);
+    case ElementType::PAGE:                  return sizeof(Page);
+    case ElementType::TAB_DURATION_SYMBOL:   return sizeof(TabDurationSymbol);
+    case ElementType::OSSIA:                 return sizeof(Ossia);
+    case ElementType::IMAGE:                 return sizeof(Image);
+    case ElementType::BAGPIPE_EMBELLISHMENT: return sizeof(BagpipeEmbellishment);
+    case ElementType::AMBITUS:               return sizeof(Ambitus);
+    case ElementType::STICKING:              return sizeof(Sticking);
+    default:
+        break;
+    }
+    return sizeof(Element);
+}
+
+//---------------------------------------------------------
+//   undoCommands
+//    the command and all its children
+//---------------------------------------------------------
+
+static int undoCommands(const UndoCommand* cmd)
+{
+    int n = 1;
+    for (const UndoCommand* child : cmd->commands()) {
+        n += undoCommands(child);
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   Entry::toJson
+//---------------------------------------------------------
+
+QJsonObject MemoryReport::Entry::toJson() const
+{
+    QJsonObject obj;
+    obj["count"] = count;
+    obj["bytes"] = double(bytes);
+    return obj;
+}
+
+//---------------------------------------------------------
+//   collect
+//---------------------------------------------------------
+
+MemoryReport MemoryReport::collect(Score* score)
+{
+    MemoryReport report;
+    report.addScore(score);
+
+    for (Excerpt* excerpt : score->excerpts()) {
+        Score* partScore = excerpt->partScore();
+        if (!partScore || partScore == score) {
+            continue;
+        }
+        MemoryReport part;
+        part.addScore(partScore);
+        report.excerpts.add(1, sizeof(Excerpt) + part.totalBytes());
+    }
+
+    if (score->isMaster() && score->undoStack()) {
+        for (const UndoMacro* macro : score->undoStack()->macros()) {
+            const int n = undoCommands(macro);
+            report.undo.add(n, n * sizeof(UndoCommand));
+        }
+    }
+
+    for (const ImageStoreItem* item : imageStore) {
+        if (item->isUsed(score)) {
+            report.images.add(1, item->buffer().size());
+        }
+    }
+
+    if (score->audio()) {
+        report.audio.add(1, sizeof(Audio) + score->audio()->data().size());
+    }
+
+    return report;
+}
+
+//---------------------------------------------------------
+//   addScore
+//    the elements, shapes, skylines and style of a score
+//---------------------------------------------------------
+
+void MemoryReport::addScore(Score* score)
+{
+    score->scanElements(this, [](void* data, Element* e) {
+        static_cast<MemoryReport*>(data)->elements[e->type()].add(1, elementSize(e->type()));
+    }, true);
+
+    auto addMeasure = [this](const Measure* m) {
+        elements[ElementType::MEASURE].add(1, sizeof(Measure));
+        for (const Segment* s = m->first(); s; s = s->next()) {
+            elements[ElementType::SEGMENT].add(1, sizeof(Segment));
+            for (const Shape& shape : s->shapes()) {
+                if (!shape.empty()) {
+                    shapes.add(int(shape.size()), sizeof(Shape) + shape.capacity() * sizeof(ShapeElement));
+                }
+            }
+        }
+    };
+    for (const MeasureBase* mb = score->first(); mb; mb = mb->next()) {
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        const Measure* m = toMeasure(mb);
+        addMeasure(m);
+        if (m->mmRest()) {
+            addMeasure(m->mmRest());
+        }
+    }
+
+    for (const System* system : score->systems()) {
+        elements[ElementType::SYSTEM].add(1, sizeof(System));
+        for (const SysStaff* staff : *system->staves()) {
+            const Skyline& sk = staff->skyline();
+            const int n = int(std::distance(sk.north().begin(), sk.north().end())
+                              + std::distance(sk.south().begin(), sk.south().end()));
+            skylines.add(n, n * sizeof(SkylineSegment));
+        }
+    }
+    elements[ElementType::PAGE].add(int(score->pages().size()), score->pages().size() * sizeof(Page));
+
+    style.add(1, sizeof(MStyle) + int(Sid::STYLES) * (sizeof(QVariant) + 2 * sizeof(qreal)));
+}
+
+//---------------------------------------------------------
+//   totalBytes
+//---------------------------------------------------------
+
+size_t MemoryReport::totalBytes() const
+{
+    size_t bytes = shapes.bytes + skylines.bytes + undo.bytes + style.bytes + excerpts.bytes + images.bytes + audio.bytes;
+    for (const auto& e : elements) {
+        bytes += e.second.bytes;
+    }
+    return bytes;
+}
+
+//---------------------------------------------------------
+//   toJson
+//---------------------------------------------------------
+
+QJsonObject MemoryReport::toJson() const
+{
+    QJsonObject elementsObj;
+    for (const auto& e : elements) {
+        elementsObj[Element::name(e.first)] = e.second.toJson();
+    }
+
+    QJsonObject obj;
+    obj["totalBytes"] = double(totalBytes());
+    obj["elements"] = elementsObj;
+    obj["shapes"] = shapes.toJson();
+    obj["skylines"] = skylines.toJson();
+    obj["undo"] = undo.toJson();
+    obj["style"] = style.toJson();
+    obj["excerpts"] = excerpts.toJson();
+    obj["images"] = images.toJson();
+    obj["audio"] = audio.toJson();
+    return obj;
+}
+}     // namespace Ms
@@ -0,0 +1,64 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __MEMORYREPORT_H__
+#define __MEMORYREPORT_H__
+
+#include <cstddef>
+#include <map>
+
+#include <QJsonObject>
+
+#include "types.h"
+
+namespace Ms {
+class Score;
+
+//---------------------------------------------------------
+//   MemoryReport
+//    instance counts and approximate bytes of what a score
+//    holds. An element counts with the size of its class,
+//    what it allocates besides is not counted unless it is
+//    listed on its own, as the shapes of the segments and
+//    the skylines of the systems. The elements are those
+//    laid out on the pages. The excerpts are counted as a
+//    whole, with all their score holds.
+//---------------------------------------------------------
+
+struct MemoryReport {
+    struct Entry {
+        int count { 0 };
+        size_t bytes { 0 };
+
+        void add(int c, size_t b) { count += c; bytes += b; }
+        QJsonObject toJson() const;
+    };
+
+    std::map<ElementType, Entry> elements;
+    Entry shapes;           // shape elements of the segments
+    Entry skylines;         // skyline segments of the staves of the systems
+    Entry undo;             // commands on the undo stack, with the size of the base class
+    Entry style;            // the values may be shared with other scores
+    Entry excerpts;
+    Entry images;           // images of the store used by the score
+    Entry audio;
+
+    size_t totalBytes() const;
+    QJsonObject toJson() const;
+
+    static MemoryReport collect(Score* score);
+
+private:
+    void addScore(Score* score);
+};
+}     // namespace Ms
+#endif
@@ -13,6 +13,11 @@
 #include <QDir>
 #include <QSettings>
 #include <QFontDatabase>
+#include <QFileInfo>
+#include <QSet>
+
+#include <atomic>
+#include <mutex>
 
 #include "config.h"
 #include "musescoreCore.h"
@@ -64,6 +69,7 @@
 namespace Ms {
 bool MScore::debugMode = false;
 bool MScore::testMode = false;
+bool MScore::parallelLayout = true;
 
 // #ifndef NDEBUG
 bool MScore::showSegmentShapes   = false;
@@ -117,6 +123,9 @@ int MScore::mtcType;
 bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
 bool MScore::pdfPrinting = false;
+QString MScore::fontMetricsCachePath;
+QString MScore::scoreTokensCachePath;
+int MScore::undoLimit = 0;
 bool MScore::svgPrinting = false;
 
 double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
@@ -461,6 +470,110 @@ const char* MScore::errorGroup()
     return "";
 }
 
+//---------------------------------------------------------
+//   textFontFiles
+//    the text fonts which come with MuseScore by family, as
+//    paths in the fonts directory. They are registered the
+//    first time a score uses them, not at startup.
+//---------------------------------------------------------
+
+static const QHash<QString, QStringList>& textFontFiles()
+{
+    static const QHash<QString, QStringList> files {
+        { "Edwin",           { "edwin/Edwin-Roman.otf", "edwin/Edwin-Bold.otf",
+                               "edwin/Edwin-Italic.otf", "edwin/Edwin-BdIta.otf" } },
+        { "FreeSerif",       { "FreeSerif.ttf", "FreeSerifBold.ttf",
+                               "FreeSerifItalic.ttf", "FreeSerifBoldItalic.ttf" } },
+        { "FreeSans",        { "FreeSans.ttf" } },
+        { "Campania",        { "campania/Campania.otf" } },
+        { "MuseJazz Text",   { "musejazz/MuseJazzText.otf" } },
+        { "Leland Text",     { "leland/LelandText.otf" } },
+        { "Bravura Text",    { "bravura/BravuraText.otf" } },
+        { "Gootville Text",  { "gootville/GootvilleText.otf" } },
+        { "MScore Text",     { "mscore/MScoreText.ttf" } },
+        { "Petaluma Text",   { "petaluma/PetalumaText.otf" } },
+        { "Petaluma Script", { "petaluma/PetalumaScript.otf" } },
+        { "MScoreTabulature", { "mscoreTab.ttf" } },
+        { "MScoreBC",        { "mscore-BC.ttf" } },
+    };
+    return files;
+}
+
+static std::mutex fontFamiliesMutex;
+static QSet<QString> loadedFontFamilies;
+static std::atomic<int> fontFamiliesToLoad { int(textFontFiles().size()) };
+
+//---------------------------------------------------------
+//   addApplicationFont
+//    path is relative to the fonts directory. The installed
+//    copy is preferred: Qt leaves a font file to the font
+//    engine, which maps it, but reads a font of the
+//    resources into memory. Returns false if neither the
+//    file nor the resource can be loaded.
+//---------------------------------------------------------
+
+bool MScore::addApplicationFont(const QString& path)
+{
+    static QSet<QString> added;
+    static std::mutex addedMutex;
+    std::lock_guard<std::mutex> lock(addedMutex);
+    if (added.contains(path)) {
+        return true;
+    }
+    const QString installed = _globalShare + "fonts/" + path;
+    if ((QFileInfo::exists(installed) && QFontDatabase::addApplicationFont(installed) != -1)
+        || QFontDatabase::addApplicationFont(":/fonts/" + path) != -1) {
+        added.insert(path);
+        return true;
+    }
+    qDebug("Mscore: cannot load internal font <%s>", qPrintable(path));
+    return false;
+}
+
+//---------------------------------------------------------
+//   loadFontFamily
+//    registers a text font which comes with MuseScore the
+//    first time family is used; is called before family is
+//    set to a QFont, possibly from several layout threads
+//---------------------------------------------------------
+
+void MScore::loadFontFamily(const QString& family)
+{
+    // on macOS the fonts are in Resources/fonts and known to the system
+#if !defined(Q_OS_MAC) && !defined(Q_OS_IOS)
+    if (fontFamiliesToLoad.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    const auto files = textFontFiles().constFind(family);
+    if (files == textFontFiles().constEnd()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(fontFamiliesMutex);
+    if (loadedFontFamilies.contains(family)) {
+        return;
+    }
+    for (const QString& path : files.value()) {
+        addApplicationFont(path);
+    }
+    loadedFontFamilies.insert(family);
+    fontFamiliesToLoad.fetch_sub(1, std::memory_order_release);
+#else
+    Q_UNUSED(family);
+#endif
+}
+
+//---------------------------------------------------------
+//   loadAllFontFamilies
+//    for the lists of the font families to choose from
+//---------------------------------------------------------
+
+void MScore::loadAllFontFamilies()
+{
+    for (auto i = textFontFiles().cbegin(); i != textFontFiles().cend(); ++i) {
+        loadFontFamily(i.key());
+    }
+}
+
 //---------------------------------------------------------
 //   paintDevice
 //---------------------------------------------------------
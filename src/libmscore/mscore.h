@@ -396,6 +396,7 @@ public:
 // #endif
     static bool debugMode;
     static bool testMode;
+    static bool parallelLayout;
 
     static int division;
     static int sampleRate;
@@ -409,6 +410,9 @@ public:
     static bool noImages;
 
     static bool pdfPrinting;
+    static QString fontMetricsCachePath;      // where measured score fonts are kept, empty for no cache
+    static QString scoreTokensCachePath;      // where the tokens and page counts of read score files are kept, empty for no cache
+    static int undoLimit;                     // number of undo steps kept, 0 for no limit
     static bool svgPrinting;
     static double pixelRatio;
 
@@ -418,6 +422,10 @@ public:
 
     static MPaintDevice* paintDevice();
 
+    static bool addApplicationFont(const QString& path);
+    static void loadFontFamily(const QString& family);
+    static void loadAllFontFamilies();
+
     static void setError(MsError e) { _error = e; }
     static const char* errorMessage();
     static const char* errorGroup();
@@ -0,0 +1,105 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "msczsnapshot.h"
+
+#include <cmath>
+
+#include <QBuffer>
+#include <QFileDevice>
+#include <QPainter>
+#include <QtConcurrent>
+
+#include "thirdparty/qzip/qzipwriter_p.h"
+
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   renderThumbnail
+//---------------------------------------------------------
+
+QImage MsczSnapshot::renderThumbnail(const QPicture& picture)
+{
+    QImage pm(picture.boundingRect().size(), QImage::Format_ARGB32_Premultiplied);
+
+    int dpm = lrint(DPMM * 1000.0);
+    pm.setDotsPerMeterX(dpm);
+    pm.setDotsPerMeterY(dpm);
+    pm.fill(0xffffffff);
+
+    QPainter p(&pm);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.drawPicture(0, 0, picture);
+    p.end();
+    return pm;
+}
+
+//---------------------------------------------------------
+//   thumbnailPng
+//---------------------------------------------------------
+
+static QByteArray thumbnailPng(const QPicture& picture)
+{
+    QByteArray ba;
+    QBuffer b(&ba);
+    if (!b.open(QIODevice::WriteOnly)) {
+        qDebug("open buffer failed");
+    }
+    if (!MsczSnapshot::renderThumbnail(picture).save(&b, "PNG")) {
+        qDebug("save failed");
+    }
+    return ba;
+}
+
+//---------------------------------------------------------
+//   write
+//    return false on error
+//---------------------------------------------------------
+
+bool MsczSnapshot::write(QIODevice* device) const
+{
+    const bool hasThumbnail = !thumbnail.isNull();
+#ifndef Q_OS_WASM
+    QFuture<QByteArray> png;
+    if (hasThumbnail) {
+        png = QtConcurrent::run(thumbnailPng, thumbnail);
+    }
+#endif
+
+    MQZipWriter uz(device);
+
+    uz.addFile("META-INF/container.xml", container);
+    uz.addFile(rootFile, score);
+
+    QFileDevice* fd = qobject_cast<QFileDevice*>(device);
+    if (fd) {   // if is file (may be buffer)
+        fd->flush();     // flush to preserve score data in case of
+    }
+    // any failures on the further operations.
+
+    for (const auto& file : files) {
+        uz.addFile(file.first, file.second);
+    }
+
+    if (hasThumbnail) {
+#ifndef Q_OS_WASM
+        uz.addFile("Thumbnails/thumbnail.png", png.result());
+#else
+        uz.addFile("Thumbnails/thumbnail.png", thumbnailPng(thumbnail));
+#endif
+    }
+
+    uz.close();
+    return uz.status() == MQZipWriter::NoError;
+}
+}     // namespace Ms
@@ -0,0 +1,48 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __MSCZSNAPSHOT_H__
+#define __MSCZSNAPSHOT_H__
+
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QImage>
+#include <QPicture>
+#include <QString>
+
+class QIODevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   MsczSnapshot
+//    the files of a .mscz, taken from the score on the
+//    main thread. It does not refer to the score, so it
+//    can be compressed and written from any thread. The
+//    thumbnail is only recorded on the main thread, it is
+//    rendered to PNG while the score is compressed.
+//---------------------------------------------------------
+
+struct MsczSnapshot {
+    QString rootFile;
+    QByteArray container;                                 // META-INF/container.xml
+    QByteArray score;                                     // the .mscx
+    std::vector<std::pair<QString, QByteArray> > files;   // pictures and audio
+    QPicture thumbnail;                                   // the first page at the thumbnail size
+
+    bool write(QIODevice* device) const;
+
+    static QImage renderThumbnail(const QPicture& picture);
+};
+}     // namespace Ms
+#endif
@@ -917,7 +917,7 @@ QString Note::tpcUserName(const bool explicitAccidental) const
         // see Note::accessibleInfo(), but we return what we have
         return pitchName;
     }
-    if (staff()->isDrumStaff(tick()) && part()->instrument()->drumset()) {
+    if (staff()->isDrumStaff(tick()) && static_cast<const Part*>(part())->instrument()->drumset()) {
         // see Note::accessibleInfo(), but we return what we have
         return pitchName;
     }
@@ -985,8 +985,8 @@ SymId Note::noteHead() const
         if (st) {
             if (st->staffTypeForElement(chord())->isDrumStaff()) {
                 Fraction t = chord()->tick();
-                Instrument* inst = st->part()->instrument(t);
-                Drumset* d = inst->drumset();
+                const Instrument* inst = static_cast<const Part*>(st->part())->instrument(t);
+                const Drumset* d = inst->drumset();
                 if (d) {
                     return d->noteHeads(_pitch, ht);
                 } else {
@@ -1111,10 +1111,7 @@ qreal Note::tabHeadWidth(const StaffType* tab) const
 {
     qreal val;
     if (tab && _fret != FRET_NONE && _string != STRING_NONE) {
-        QFont f    = tab->fretFont();
-        f.setPointSizeF(tab->fretFontSize());
-        QFontMetricsF fm(f, MScore::paintDevice());
-        val  = fm.width(_fretString) * magS();
+        val  = tab->fretStringWidth(_fretString) * magS();
     } else {
         val = headWidth();
     }
@@ -1554,7 +1551,7 @@ void Note::read(XmlReader& e)
 
 bool Note::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "pitch") {
         _pitch = e.readInt();
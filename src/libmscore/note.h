@@ -27,6 +27,7 @@
 #include "shape.h"
 #include "key.h"
 #include "sym.h"
+#include "elementpool.h"
 
 namespace Ms {
 class Tie;
@@ -239,6 +240,8 @@ static const int INVALID_LINE = -10000;
 class Note final : public Element
 {
     Q_GADGET
+    ELEMENT_POOL_ALLOCATION
+
 public:
     enum class ValueType : char {
         OFFSET_VAL, USER_VAL
@@ -14,6 +14,7 @@
 #define __NOTEDOT_H__
 
 #include "element.h"
+#include "elementpool.h"
 
 namespace Ms {
 class Note;
@@ -25,6 +26,8 @@ class Rest;
 
 class NoteDot final : public Element
 {
+    ELEMENT_POOL_ALLOCATION
+
 public:
     NoteDot(Score* = 0);
 
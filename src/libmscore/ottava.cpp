@@ -299,7 +299,7 @@ void Ottava::read(XmlReader& e)
 
 bool Ottava::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "subtype") {
         QString s = e.readElementText();
         bool ok;
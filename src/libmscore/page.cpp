@@ -12,6 +12,8 @@
 
 #include "page.h"
 
+#include <algorithm>
+
 #include <QDateTime>
 
 #include "score.h"
@@ -58,28 +60,64 @@ Page::~Page()
 
 QList<Element*> Page::items(const QRectF& r)
 {
+    QList<Element*> el;
+    visitItems(r, [&el](Element* e) { el.append(e); });
+    return el;
+}
+
+QList<Element*> Page::items(const QPointF& p)
+{
+    QList<Element*> el;
+    visitItems(p, [&el](Element* e) { el.append(e); });
+    return el;
+}
+
+//---------------------------------------------------------
+//   addItem
+//    an index that is out of date is rebuilt on the next
+//    query anyway
+//---------------------------------------------------------
+
+void Page::addItem(Element* e)
+{
+    _elementsValid = false;
 #ifdef USE_BSP
-    if (!bspTreeValid) {
-        doRebuildBspTree();
+    if (bspTreeValid) {
+        _index.insert(e);
     }
-    QList<Element*> el = bspTree.items(r);
-    return el;
 #else
-    Q_UNUSED(r)
-    return QList<Element*>();
+    Q_UNUSED(e)
 #endif
 }
 
-QList<Element*> Page::items(const QPointF& p)
+//---------------------------------------------------------
+//   removeItem
+//---------------------------------------------------------
+
+void Page::removeItem(Element* e)
 {
+    _elementsValid = false;
 #ifdef USE_BSP
-    if (!bspTreeValid) {
-        doRebuildBspTree();
+    if (bspTreeValid) {
+        _index.remove(e);
     }
-    return bspTree.items(p);
 #else
-    Q_UNUSED(p)
-    return QList<Element*>();
+    Q_UNUSED(e)
+#endif
+}
+
+//---------------------------------------------------------
+//   moveItem
+//---------------------------------------------------------
+
+void Page::moveItem(Element* e)
+{
+#ifdef USE_BSP
+    if (bspTreeValid) {
+        _index.move(e);
+    }
+#else
+    Q_UNUSED(e)
 #endif
 }
 
@@ -234,29 +272,28 @@ void Page::scanElements(void* data, void (* func)(void*, Element*), bool all)
     }
 }
 
-#ifdef USE_BSP
 //---------------------------------------------------------
-//   bspInsert
+//   releaseBspTree
 //---------------------------------------------------------
 
-static void bspInsert(void* bspTree, Element* e)
+void Page::releaseBspTree()
 {
-    ((BspTree*)bspTree)->insert(e);
-}
-
-static void countElements(void* data, Element* /*e*/)
-{
-    ++(*(int*)data);
+#ifdef USE_BSP
+    _index.release();
+#endif
+    _elements = QList<Element*>();
+    bspTreeValid = false;
+    _elementsValid = false;
 }
 
+#ifdef USE_BSP
 //---------------------------------------------------------
 //   doRebuildBspTree
 //---------------------------------------------------------
 
 void Page::doRebuildBspTree()
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    const QList<Element*> el = elements();
 
     QRectF r;
     if (score()->layoutMode() == LayoutMode::LINE) {
@@ -274,8 +311,10 @@ void Page::doRebuildBspTree()
         r = abbox();
     }
 
-    bspTree.initialize(r, n);
-    scanElements(&bspTree, &bspInsert, false);
+    _index.initialize(r, el.size());
+    for (Element* e : el) {
+        _index.insert(e);
+    }
     bspTreeValid = true;
 }
 
@@ -567,13 +606,34 @@ void Page::read(XmlReader& e)
 
 //---------------------------------------------------------
 //   elements
+//    the list is kept until the next layout of the page,
+//    so that painting, exporting and the spatial index do
+//    not walk the element tree each time
 //---------------------------------------------------------
 
 QList<Element*> Page::elements() const
 {
-    QList<Element*> el;
-    const_cast<Page*>(this)->scanElements(&el, collectElements, false);
-    return el;
+    if (!_elementsValid) {
+        _elements.clear();
+        const_cast<Page*>(this)->scanElements(&_elements, collectElements, false);
+        _elementsValid = true;
+    }
+    return _elements;
+}
+
+//---------------------------------------------------------
+//   sortedElements
+//    the kept list is sorted in place, and sorted again
+//    only if z values or the selection changed the order
+//---------------------------------------------------------
+
+QList<Element*> Page::sortedElements() const
+{
+    elements();
+    if (!std::is_sorted(_elements.begin(), _elements.end(), elementLessThan)) {
+        std::stable_sort(_elements.begin(), _elements.end(), elementLessThan);
+    }
+    return _elements;
 }
 
 //---------------------------------------------------------
@@ -15,7 +15,7 @@
 
 #include "config.h"
 #include "element.h"
-#include "bsp.h"
+#include "spatialgrid.h"
 
 namespace Ms {
 class System;
@@ -35,10 +35,12 @@ class Page final : public Element
     QList<System*> _systems;
     int _no;                        // page number
 #ifdef USE_BSP
-    BspTree bspTree;
+    SpatialGrid _index;
     void doRebuildBspTree();
 #endif
     bool bspTreeValid;
+    mutable QList<Element*> _elements;      // visible elements, rebuilt with the spatial index
+    mutable bool _elementsValid { false };
 
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(mu::draw::Painter*, int area, const QString&) const;
@@ -76,11 +78,55 @@ public:
 
     QList<Element*> items(const QRectF& r);
     QList<Element*> items(const QPointF& p);
-    void rebuildBspTree() { bspTreeValid = false; }
+    template<typename Visitor> void visitItems(const QRectF& r, Visitor visitor);
+    template<typename Visitor> void visitItems(const QPointF& p, Visitor visitor);
+
+    // keep the spatial index up to date without rebuilding it
+    void addItem(Element* e);
+    void removeItem(Element* e);
+    void moveItem(Element* e);
+
+    void rebuildBspTree() { bspTreeValid = false; _elementsValid = false; }
+    void releaseBspTree();                      // frees the spatial index, rebuilt by the next search
     QPointF pagePos() const override { return QPointF(); }       ///< position in page coordinates
     QList<Element*> elements() const;           ///< list of visible elements
+    QList<Element*> sortedElements() const;     ///< list of visible elements in draw order
     QRectF tbbox();                             // tight bounding box, excluding white space
     Fraction endTick() const;
 };
+
+//---------------------------------------------------------
+//   visitItems
+//    calls visitor(Element*) for the elements intersecting
+//    r, without building a list
+//---------------------------------------------------------
+
+template<typename Visitor>
+void Page::visitItems(const QRectF& r, Visitor visitor)
+{
+#ifdef USE_BSP
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    _index.visit(r, visitor);
+#else
+    Q_UNUSED(r)
+    Q_UNUSED(visitor)
+#endif
+}
+
+template<typename Visitor>
+void Page::visitItems(const QPointF& p, Visitor visitor)
+{
+#ifdef USE_BSP
+    if (!bspTreeValid) {
+        doRebuildBspTree();
+    }
+    _index.visit(p, visitor);
+#else
+    Q_UNUSED(p)
+    Q_UNUSED(visitor)
+#endif
+}
 }     // namespace Ms
 #endif
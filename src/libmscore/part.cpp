@@ -107,7 +107,7 @@ Part* Part::masterPart()
 
 bool Part::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "Staff") {
         Staff* staff = new Staff(score());
         staff->setPart(this);
@@ -148,7 +148,7 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
 
             while (e.readNextStartElement()) {
                 pasted = true;
-                const QStringRef& tag(e.name());
+                const XmlTag& tag(e.name());
 
                 if (tag == "transposeChromatic") {
                     e.setTransposeChromatic(e.readInt());
@@ -485,7 +485,7 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
     }
 
     for (Score* s : scoreList()) {     // for all parts
-        s->connectTies();
+        s->connectTies(dstTick, dstTick + tickLen);
     }
 
     if (pasted) {                         //select only if we pasted something
@@ -783,7 +783,7 @@ void Score::pasteSymbols(XmlReader& e, ChordRest* dst)
             if (done) {
                 break;
             }
-            const QStringRef& tag(e.name());
+            const XmlTag& tag(e.name());
 
             if (tag == "trackOffset") {
                 destTrack = startTrack + e.readInt();
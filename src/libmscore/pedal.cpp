@@ -110,7 +110,7 @@ void Pedal::read(XmlReader& e)
         e.addSpanner(e.intAttribute("id", -1), this);
     }
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (readStyledProperty(e, tag)) {
         } else if (!TextLineBase::readProperties(e)) {
             e.unknown();
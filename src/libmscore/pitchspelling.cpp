@@ -23,6 +23,8 @@
 #include "part.h"
 #include "utils.h"
 
+#include <QtConcurrent>
+
 #include "framework/midi_old/event.h"
 
 namespace Ms {
@@ -598,79 +600,99 @@ int tpc(int idx, int pitch, int opt)
     return tab[i];
 }
 
+//---------------------------------------------------------
+//   bestSpelling
+//    The penalty of a spelling is the sum of the penalties
+//    of the neighbouring notes, so the best one is found by
+//    dynamic programming over the two choices per note. Of
+//    several best spellings the one with the lowest bit
+//    pattern is taken, as by trying the patterns in order:
+//    the backtracking prefers the first choice from the
+//    last note on. Bit WINDOW is never set.
+//---------------------------------------------------------
+
+static int bestSpelling(const int* tab, const int* pitch, const int* key, int* bits)
+{
+    int cost[WINDOW + 1][2];
+    cost[0][0] = 0;
+    cost[0][1] = 0;
+    for (int k = 1; k <= WINDOW; ++k) {
+        for (int s = 0; s < 2; ++s) {
+            const int lof2 = tab[pitch[k] * 2 + s];
+            const int p0   = cost[k - 1][0] + penalty(tab[pitch[k - 1] * 2], lof2, key[k]);
+            const int p1   = cost[k - 1][1] + penalty(tab[pitch[k - 1] * 2 + 1], lof2, key[k]);
+            cost[k][s] = qMin(p0, p1);
+        }
+    }
+    int s = 0;
+    *bits = 0;
+    for (int k = WINDOW; k > 0; --k) {
+        const int lof2 = tab[pitch[k] * 2 + s];
+        const int p0   = cost[k - 1][0] + penalty(tab[pitch[k - 1] * 2], lof2, key[k]);
+        s = (p0 == cost[k][s]) ? 0 : 1;
+        *bits |= s << (k - 1);
+    }
+    return cost[WINDOW][0];
+}
+
 //---------------------------------------------------------
 //   computeWindow
+//    pitch and key of WINDOW + 1 notes, the key + 7;
+//    returns the spelling as the bits of the choices in
+//    tab1, or negated in tab2
 //---------------------------------------------------------
 
-int computeWindow(const std::vector<Note*>& notes, int start, int end)
+static int computeWindow(const int* pitch, const int* key)
 {
-    int p   = 10000;
-    int idx = -1;
-    int pitch[10];
-    int key[10];
+    int bitsA;
+    int bitsB;
+    const int pa = bestSpelling(tab1, pitch, key, &bitsA);
+    const int pb = bestSpelling(tab2, pitch, key, &bitsB);
+    // tab2 wins ties, and so does the lower pattern
+    if (pb < pa || (pb == pa && bitsB <= bitsA)) {
+        return -bitsB;
+    }
+    return bitsA;
+}
+
+//---------------------------------------------------------
+//   windowKeys
+//    pitch and key of the notes [start, end), repeating the
+//    last note up to WINDOW + 1; false on an illegal key
+//---------------------------------------------------------
 
-    int i = start;
+static bool windowKeys(const std::vector<Note*>& notes, int start, int end, int* pitch, int* key)
+{
     int k = 0;
-    while (i < end) {
+    for (int i = start; i < end; ++i, ++k) {
         pitch[k] = notes[i]->pitch() % 12;
         Fraction tick = notes[i]->chord()->tick();
         key[k]   = int(notes[i]->staff()->key(tick)) + 7;
         if (key[k] < 0 || key[k] > 14) {
             qDebug("illegal key at tick %d: %d, window %d-%d",
                    tick.ticks(), key[k] - 7, start, end);
-            return 0;
-            // abort();
+            return false;
         }
-        ++k;
-        ++i;
     }
-
-    for (; k < 10; ++k) {
+    for (; k <= WINDOW; ++k) {
         pitch[k] = pitch[k - 1];
         key[k]   = key[k - 1];
     }
+    return true;
+}
 
-    for (i = 0; i < 512; ++i) {
-        int pa    = 0;
-        int pb    = 0;
-        int l     = pitch[0] * 2 + (i & 1);
-        Q_ASSERT(l >= 0 && l <= static_cast<int>(sizeof(tab1) / sizeof(*tab1)));
-        int lof1a = tab1[l];
-        int lof1b = tab2[l];
-
-        for (k = 1; k < 10; ++k) {
-            int l1 = pitch[k] * 2 + ((i & (1 << k)) >> k);
-            Q_ASSERT(l1 >= 0 && l1 <= static_cast<int>(sizeof(tab1) / sizeof(*tab1)));
-            int lof2a = tab1[l1];
-            int lof2b = tab2[l1];
-            pa += penalty(lof1a, lof2a, key[k]);
-            pb += penalty(lof1b, lof2b, key[k]);
-            lof1a = lof2a;
-            lof1b = lof2b;
-        }
-        if (pa < pb) {
-            if (pa < p) {
-                p   = pa;
-                idx = i;
-            }
-        } else {
-            if (pb < p) {
-                p   = pb;
-                idx = i * -1;
-            }
-        }
+//---------------------------------------------------------
+//   computeWindow
+//---------------------------------------------------------
+
+int computeWindow(const std::vector<Note*>& notes, int start, int end)
+{
+    int pitch[WINDOW + 1];
+    int key[WINDOW + 1];
+    if (!windowKeys(notes, start, end, pitch, key)) {
+        return 0;
     }
-/*      qDebug("compute window\n   ");
-      for (int i = 0; i < 10; ++i)
-            qDebug("%2d ", pitch[i]);
-      qDebug("\n   ");
-      for (int i = 0; i < 10; ++i)
-            qDebug("%2d ", key[i]);
-      qDebug("\n   ");
-      for (int i = 0; i < 10; ++i)
-            qDebug("%2d ", tpc(i, pitch[i], idx));
-*/
-    return idx;
+    return computeWindow(pitch, key);
 }
 
 //---------------------------------------------------------
@@ -694,12 +716,29 @@ void changeAllTpcs(Note* n, int tpc1)
 }
 
 //---------------------------------------------------------
-//   spell
+//   spellTpcs
+//    tpc1 of the notes, Tpc::TPC_INVALID for the ones the
+//    windows leave alone. The windows of WINDOW notes move
+//    by 3 notes and spell the three notes in their middle.
+//    Nothing is changed, so that the staves can be spelled
+//    at the same time.
 //---------------------------------------------------------
 
-void Score::spellNotelist(std::vector<Note*>& notes)
+static std::vector<int> spellTpcs(const std::vector<Note*>& notes)
 {
-    int n = int(notes.size());
+    const int n = int(notes.size());
+    std::vector<int> tpcs(n, Tpc::TPC_INVALID);
+
+    // pitch and key of each note once, and the number of
+    // illegal keys before it
+    std::vector<int> pitch(n);
+    std::vector<int> key(n);
+    std::vector<int> illegal(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        pitch[i] = notes[i]->pitch() % 12;
+        key[i]   = int(notes[i]->staff()->key(notes[i]->chord()->tick())) + 7;
+        illegal[i + 1] = illegal[i] + ((key[i] < 0 || key[i] > 14) ? 1 : 0);
+    }
 
     int start = 0;
     while (start < n) {
@@ -707,7 +746,19 @@ void Score::spellNotelist(std::vector<Note*>& notes)
         if (end > n) {
             end = n;
         }
-        int opt = computeWindow(notes, start, end);
+        int opt = 0;
+        int wpitch[WINDOW + 1];
+        int wkey[WINDOW + 1];
+        if (illegal[end] > illegal[start]) {
+            windowKeys(notes, start, end, wpitch, wkey);     // reports the key
+        } else {
+            for (int k = 0; k <= WINDOW; ++k) {
+                const int i = qMin(start + k, end - 1);
+                wpitch[k] = pitch[i];
+                wkey[k]   = key[i];
+            }
+            opt = computeWindow(wpitch, wkey);
+        }
         const int* tab;
         if (opt < 0) {
             tab = tab2;
@@ -715,42 +766,75 @@ void Score::spellNotelist(std::vector<Note*>& notes)
         } else {
             tab = tab1;
         }
+        auto spell = [&](int k) {
+            tpcs[start + k] = tab[pitch[start + k] * 2 + ((opt & (1 << k)) >> k)];
+        };
 
         if (start == 0) {
-            changeAllTpcs(notes[0], tab[(notes[0]->pitch() % 12) * 2 + (opt & 1)]);
-            if (n > 1) {
-                changeAllTpcs(notes[1], tab[(notes[1]->pitch() % 12) * 2 + ((opt & 2) >> 1)]);
-            }
-            if (n > 2) {
-                changeAllTpcs(notes[2], tab[(notes[2]->pitch() % 12) * 2 + ((opt & 4) >> 2)]);
+            for (int k = 0; k < qMin(n, 3); ++k) {
+                spell(k);
             }
         }
         if ((end - start) >= 6) {
-            changeAllTpcs(notes[start + 3], tab[(notes[start + 3]->pitch() % 12) * 2 + ((opt & 8) >> 3)]);
-            changeAllTpcs(notes[start + 4], tab[(notes[start + 4]->pitch() % 12) * 2 + ((opt & 16) >> 4)]);
-            changeAllTpcs(notes[start + 5], tab[(notes[start + 5]->pitch() % 12) * 2 + ((opt & 32) >> 5)]);
+            spell(3);
+            spell(4);
+            spell(5);
         }
         if (end == n) {
-            int n1 = end - start;
-            int k;
-            switch (n1 - 6) {
-            case 3:
-                k = end - start - 3;
-                changeAllTpcs(notes[end - 3], tab[(notes[end - 3]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
-                Q_FALLTHROUGH();
-            case 2:
-                k = end - start - 2;
-                changeAllTpcs(notes[end - 2], tab[(notes[end - 2]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
-                Q_FALLTHROUGH();
-            case 1:
-                k = end - start - 1;
-                changeAllTpcs(notes[end - 1], tab[(notes[end - 1]->pitch() % 12) * 2 + ((opt & (1 << k)) >> k)]);
+            for (int k = 6; k < end - start; ++k) {
+                spell(k);
             }
             break;
         }
         // advance to next window
         start += 3;
     }
+    return tpcs;
+}
+
+//---------------------------------------------------------
+//   spell
+//---------------------------------------------------------
+
+void Score::spellNotelist(std::vector<Note*>& notes)
+{
+    const std::vector<int> tpcs = spellTpcs(notes);
+    for (size_t i = 0; i < notes.size(); ++i) {
+        if (tpcs[i] != Tpc::TPC_INVALID) {
+            changeAllTpcs(notes[i], tpcs[i]);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   spellNotelists
+//    the tpcs of the lists are computed in parallel and
+//    changed in list order
+//---------------------------------------------------------
+
+void Score::spellNotelists(std::vector<std::vector<Note*> >& lists)
+{
+    std::vector<std::vector<int> > tpcs(lists.size());
+#ifndef Q_OS_WASM
+    std::vector<int> indexes(lists.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i] = int(i);
+    }
+    QtConcurrent::blockingMap(indexes, [&lists, &tpcs](int i) {
+        tpcs[i] = spellTpcs(lists[i]);
+    });
+#else
+    for (size_t i = 0; i < lists.size(); ++i) {
+        tpcs[i] = spellTpcs(lists[i]);
+    }
+#endif
+    for (size_t i = 0; i < lists.size(); ++i) {
+        for (size_t k = 0; k < lists[i].size(); ++k) {
+            if (tpcs[i][k] != Tpc::TPC_INVALID) {
+                changeAllTpcs(lists[i][k], tpcs[i][k]);
+            }
+        }
+    }
 }
 
 //---------------------------------------------------------
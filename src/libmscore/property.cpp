@@ -10,6 +10,10 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "property.h"
 #include "accidental.h"
 #include "bracket.h"
@@ -377,14 +381,29 @@ static constexpr PropertyMetaData propertyList[] = {
 
 //---------------------------------------------------------
 //   propertyId
+//    binary search in the property names, sorted once;
+//    the first of several properties with the same name
+//    is found
 //---------------------------------------------------------
 
 Pid propertyId(const QStringRef& s)
 {
-    for (const PropertyMetaData& pd : propertyList) {
-        if (pd.name == s) {
-            return pd.id;
-        }
+    static const std::vector<const PropertyMetaData*> byName = []() {
+        std::vector<const PropertyMetaData*> v;
+        for (const PropertyMetaData& pd : propertyList) {
+            v.push_back(&pd);
+        }
+        std::stable_sort(v.begin(), v.end(), [](const PropertyMetaData* a, const PropertyMetaData* b) {
+            return strcmp(a->name, b->name) < 0;
+        });
+        return v;
+    }();
+
+    auto i = std::lower_bound(byName.begin(), byName.end(), s, [](const PropertyMetaData* pd, const QStringRef& name) {
+        return name.compare(QLatin1String(pd->name)) > 0;
+    });
+    if (i != byName.end() && s == QLatin1String((*i)->name)) {
+        return (*i)->id;
     }
     return Pid::END;
 }
@@ -0,0 +1,176 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __PROPERTYVALUE_H__
+#define __PROPERTYVALUE_H__
+
+#include <new>
+#include <type_traits>
+
+#include <QPointF>
+#include <QVariant>
+
+#include "fraction.h"
+#include "spatium.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   PropertyValue
+//    a property value kept for later, as by the undo
+//    commands. The types most properties have are stored
+//    in place, where a QVariant allocates for QPointF and
+//    Fraction; the other types are kept in a QVariant.
+//---------------------------------------------------------
+
+class PropertyValue
+{
+public:
+    enum class Type : char {
+        INVALID, BOOL, INT, REAL, SPATIUM, POINT, FRACTION, VARIANT
+    };
+
+private:
+    union Data {
+        bool b;
+        int i;
+        qreal r;
+        Spatium s;
+        QPointF p;
+        Fraction f;
+        Data() : r(0.0) {}
+    };
+    static_assert(std::is_trivially_copyable<Spatium>::value && std::is_trivially_copyable<QPointF>::value
+                  && std::is_trivially_copyable<Fraction>::value, "the values must be copyable as bytes");
+
+    union {
+        Data _data;
+        alignas(QVariant) char _variant[sizeof(QVariant)];
+    };
+    Type _type { Type::INVALID };
+
+    QVariant* variant() { return reinterpret_cast<QVariant*>(_variant); }
+    const QVariant* variant() const { return reinterpret_cast<const QVariant*>(_variant); }
+
+    void assign(const QVariant& v);
+    void assign(const PropertyValue& v);
+    void clear()
+    {
+        if (_type == Type::VARIANT) {
+            variant()->~QVariant();
+        }
+        _type = Type::INVALID;
+    }
+
+public:
+    PropertyValue() : _data() {}
+    PropertyValue(const QVariant& v) : _data() { assign(v); }
+    PropertyValue(const PropertyValue& v) : _data() { assign(v); }
+    explicit PropertyValue(bool v) : _data() { _data.b = v; _type = Type::BOOL; }
+    explicit PropertyValue(int v) : _data() { _data.i = v; _type = Type::INT; }
+    explicit PropertyValue(const Spatium& v) : _data() { new (&_data.s) Spatium(v); _type = Type::SPATIUM; }
+    explicit PropertyValue(const QPointF& v) : _data() { new (&_data.p) QPointF(v); _type = Type::POINT; }
+    ~PropertyValue() { clear(); }
+
+    PropertyValue& operator=(const QVariant& v) { clear(); assign(v); return *this; }
+    PropertyValue& operator=(const PropertyValue& v)
+    {
+        if (this != &v) {
+            clear();
+            assign(v);
+        }
+        return *this;
+    }
+
+    Type type() const { return _type; }
+    bool isValid() const { return _type != Type::INVALID; }
+
+    // only for a value of the matching type
+    bool toBool() const { Q_ASSERT(_type == Type::BOOL); return _data.b; }
+    int toInt() const { Q_ASSERT(_type == Type::INT); return _data.i; }
+    Spatium toSpatium() const { Q_ASSERT(_type == Type::SPATIUM); return _data.s; }
+    QPointF toPointF() const { Q_ASSERT(_type == Type::POINT); return _data.p; }
+
+    QVariant toVariant() const;
+    operator QVariant() const { return toVariant(); }
+};
+
+//---------------------------------------------------------
+//   assign
+//---------------------------------------------------------
+
+inline void PropertyValue::assign(const QVariant& v)
+{
+    const int t = v.userType();
+    if (t == QMetaType::UnknownType) {
+        _type = Type::INVALID;
+    } else if (t == QMetaType::Bool) {
+        _data.b = v.toBool();
+        _type = Type::BOOL;
+    } else if (t == QMetaType::Int) {
+        _data.i = v.toInt();
+        _type = Type::INT;
+    } else if (t == QMetaType::Double) {
+        _data.r = v.toDouble();
+        _type = Type::REAL;
+    } else if (t == QMetaType::QPointF) {
+        new (&_data.p) QPointF(v.toPointF());
+        _type = Type::POINT;
+    } else if (t == qMetaTypeId<Spatium>()) {
+        new (&_data.s) Spatium(v.value<Spatium>());
+        _type = Type::SPATIUM;
+    } else if (t == qMetaTypeId<Fraction>()) {
+        new (&_data.f) Fraction(v.value<Fraction>());
+        _type = Type::FRACTION;
+    } else {
+        new (_variant) QVariant(v);
+        _type = Type::VARIANT;
+    }
+}
+
+inline void PropertyValue::assign(const PropertyValue& v)
+{
+    if (v._type == Type::VARIANT) {
+        new (_variant) QVariant(*v.variant());
+    } else {
+        _data = v._data;
+    }
+    _type = v._type;
+}
+
+//---------------------------------------------------------
+//   toVariant
+//---------------------------------------------------------
+
+inline QVariant PropertyValue::toVariant() const
+{
+    switch (_type) {
+    case Type::INVALID:
+        break;
+    case Type::BOOL:
+        return QVariant(_data.b);
+    case Type::INT:
+        return QVariant(_data.i);
+    case Type::REAL:
+        return QVariant(_data.r);
+    case Type::SPATIUM:
+        return QVariant::fromValue(_data.s);
+    case Type::POINT:
+        return QVariant(_data.p);
+    case Type::FRACTION:
+        return QVariant::fromValue(_data.f);
+    case Type::VARIANT:
+        return *variant();
+    }
+    return QVariant();
+}
+}     // namespace Ms
+#endif
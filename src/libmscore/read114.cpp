@@ -216,7 +216,7 @@ QString convertFromHtml(TextBase* t, const QString& ss)
 
 static bool readTextProperties(XmlReader& e, TextBase* t, Element*)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "style") {
         int i = e.readInt();
         Tid ss = Tid::DEFAULT;
@@ -376,7 +376,7 @@ static void readText114(XmlReader& e, TextBase* t, Element* be)
 static void readAccidental(Accidental* a, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "bracket") {
             int i = e.readInt();
             if (i == 0 || i == 1) {
@@ -590,7 +590,7 @@ static void readFingering114(XmlReader& e, Fingering* fing)
 {
     bool isStringNumber = false;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "html-data") {
             auto htmlDdata = QTextDocumentFragment::fromHtml(e.readXml()).toPlainText();
@@ -646,7 +646,7 @@ static void readNote(Note* note, XmlReader& e)
     }
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Accidental") {
             // on older scores, a note could have both a <userAccidental> tag and an <Accidental> tag
             // if a userAccidental has some other property set (like for instance offset)
@@ -938,7 +938,7 @@ static ClefType readClefType(const QString& s)
 static void readClef(Clef* clef, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             clef->setClefType(readClefType(e.readElementText()));
         } else if (!clef->readProperties(e)) {
@@ -960,7 +960,7 @@ static void readTuplet(Tuplet* tuplet, XmlReader& e)
     tuplet->setId(e.intAttribute("id", 0));
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {      // obsolete
             e.skipCurrentElement();
         } else if (tag == "hasNumber") {  // obsolete even in 1.3
@@ -1037,7 +1037,7 @@ static void readTremolo(Tremolo* tremolo, XmlReader& e)
 static void readChord(Measure* m, Chord* chord, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Note") {
             Note* note = new Note(chord->score());
             // the note needs to know the properties of the track it belongs to
@@ -1076,7 +1076,7 @@ static void readChord(Measure* m, Chord* chord, XmlReader& e)
 static void readRest(Measure* m, Rest* rest, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Attribute" || tag == "Articulation") {
             Element* el = readArticulation(rest, e);
             if (el->isFermata()) {
@@ -1101,7 +1101,7 @@ static void readRest(Measure* m, Rest* rest, XmlReader& e)
 void readTempoText(TempoText* t, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "tempo") {
             t->setTempo(e.readDouble());
         } else if (!readTextProperties(e, t, t)) {
@@ -1130,7 +1130,7 @@ void readStaffText(StaffText* t, XmlReader& e)
 static void readLineSegment114(XmlReader& e, LineSegment* ls)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "off1") {
             ls->setOffset(e.readPoint() * ls->spatium());
         } else {
@@ -1145,7 +1145,7 @@ static void readLineSegment114(XmlReader& e, LineSegment* ls)
 
 static bool readTextLineProperties114(XmlReader& e, TextLineBase* tl)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "beginText") {
         Text* text = new Text(tl->score());
@@ -1198,7 +1198,7 @@ static bool readTextLineProperties114(XmlReader& e, TextLineBase* tl)
 static void readVolta114(XmlReader& e, Volta* volta)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "endings") {
             QString s = e.readElementText();
             QStringList sl = s.split(",", Qt::SkipEmptyParts);
@@ -1227,7 +1227,7 @@ static void readVolta114(XmlReader& e, Volta* volta)
 static void readOttava114(XmlReader& e, Ottava* ottava)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             QString s = e.readElementText();
             bool ok;
@@ -1294,7 +1294,7 @@ static QString resolveSymCompatibility(SymId i, QString programVersion)
 static void readTextLine114(XmlReader& e, TextLine* textLine)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "lineVisible") {
             textLine->setLineVisible(e.readBool());
@@ -1348,7 +1348,7 @@ static void readTextLine114(XmlReader& e, TextLine* textLine)
 static void readPedal114(XmlReader& e, Pedal* pedal)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "beginSymbol"
             || tag == "beginSymbolOffset"
             || tag == "endSymbol"
@@ -1384,7 +1384,7 @@ static void readHarmony114(XmlReader& e, Harmony* h)
     };
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "base") {
             if (h->score()->mscVersion() >= 106) {
                 h->setBaseTpc(e.readInt());
@@ -1527,7 +1527,7 @@ static void readMeasure(Measure* m, int staffIdx, XmlReader& e)
     Fraction lastTick = e.tick();
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "move") {
             e.setTick(e.readFraction() + m->tick());
@@ -2160,7 +2160,7 @@ static void readBox(XmlReader& e, Box* b);
 
 static bool readBoxProperties(XmlReader& e, Box* b)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "height") {
         b->setBoxHeight(Spatium(e.readDouble()));
     } else if (tag == "width") {
@@ -2240,7 +2240,7 @@ static void readBox(XmlReader& e, Box* b)
     b->setAutoSizeEnabled(false);
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "HBox") {
             HBox* hb = new HBox(b->score());
             readBox(e, hb);
@@ -2267,7 +2267,7 @@ static void readStaffContent(Score* score, XmlReader& e)
 
     Measure* measure = score->firstMeasure();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "Measure") {
             if (staff == 0) {
@@ -2338,7 +2338,7 @@ static void readStaff(Staff* staff, XmlReader& e)
 {
     Score* _score = staff->score();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "lines") {
             int lines = e.readInt();
             staff->setLines(Fraction(0,1), lines);
@@ -2395,7 +2395,7 @@ static void readDrumset(Drumset* ds, XmlReader& e)
         return;
     }
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "head") {
             ds->drum(pitch).notehead = convertHeadGroup(e.readInt());
         } else if (ds->readProperties(e, pitch)) {
@@ -2420,7 +2420,7 @@ static void readInstrument(Instrument* i, Part* p, XmlReader& e)
     bool customDrumset = false;
     i->clearChannels();         // remove default channel
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "chorus") {
             chorus = e.readInt();
         } else if (tag == "reverb") {
@@ -2440,10 +2440,10 @@ static void readInstrument(Instrument* i, Part* p, XmlReader& e)
                 i->setDrumset(new Drumset(*smDrumset));
             }
             if (!customDrumset) {
-                i->drumset()->clear();
+                i->editDrumset()->clear();
                 customDrumset = true;
             }
-            readDrumset(i->drumset(), e);
+            readDrumset(i->editDrumset(), e);
         } else if (i->readProperties(e, p, &customDrumset)) {
         } else {
             e.unknown();
@@ -2496,7 +2496,7 @@ static void readPart(Part* part, XmlReader& e)
 {
     Score* _score = part->score();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Staff") {
             Staff* staff = new Staff(_score);
             staff->setPart(part);
@@ -2524,9 +2524,9 @@ static void readPart(Part* part, XmlReader& e)
                     i->setStringData(StringData(24, 4, g_celloStrings));
                 }
             }
-            Drumset* d = i->drumset();
             Staff* st = part->staff(0);
-            if (d && st && st->lines(Fraction(0,1)) != 5) {
+            if (i->drumset() && st && st->lines(Fraction(0,1)) != 5) {
+                Drumset* d = i->editDrumset();
                 int n = 0;
                 if (st->lines(Fraction(0,1)) == 1) {
                     n = 4;
@@ -2596,7 +2596,7 @@ static void readPageFormat(PageFormat* pf, XmlReader& e)
     QString type;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "landscape") {
             landscape = e.readInt();
         } else if (tag == "page-margins") {
@@ -2833,7 +2833,7 @@ Score::FileError MasterScore::read114(XmlReader& e)
     TempoMap tm;
     while (e.readNextStartElement()) {
         e.setTrack(-1);
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Staff") {
             readStaffContent(this, e);
         } else if (tag == "KeySig") {                 // not supported
@@ -3260,7 +3260,8 @@ Score::FileError MasterScore::read114(XmlReader& e)
             nscore->setEnableVerticalSpread(false);
             excerpt->setPartScore(nscore);
             nscore->style().set(Sid::createMultiMeasureRests, true);
-            Excerpt::createExcerpt(excerpt);
+            // the part scores are laid out with the score after reading
+            Excerpt::cloneExcerpt(excerpt);
         }
     }
 
@@ -163,7 +163,7 @@ void readTextStyle206(MStyle* style, XmlReader& e, std::map<QString, std::map<Si
     qreal lineWidth = -1.0;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "name") {
             name = e.readElementText();
@@ -479,7 +479,7 @@ void readTextStyle206(MStyle* style, XmlReader& e, std::map<QString, std::map<Si
 void readAccidental206(Accidental* a, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "bracket") {
             int i = e.readInt();
             if (i == 0 || i == 1) {
@@ -684,7 +684,7 @@ static void readDrumset(Drumset* ds, XmlReader& e)
         return;
     }
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "head") {
             ds->drum(pitch).notehead = convertHeadGroup(e.readInt());
         } else if (tag == "variants") {
@@ -727,7 +727,7 @@ static void readInstrument(Instrument* i, Part* p, XmlReader& e)
     bool customDrumset = false;
     i->clearChannels();         // remove default channel
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Drum") {
             // if we see one of this tags, a custom drumset will
             // be created
@@ -735,10 +735,10 @@ static void readInstrument(Instrument* i, Part* p, XmlReader& e)
                 i->setDrumset(new Drumset(*smDrumset));
             }
             if (!customDrumset) {
-                i->drumset()->clear();
+                i->editDrumset()->clear();
                 customDrumset = true;
             }
-            readDrumset(i->drumset(), e);
+            readDrumset(i->editDrumset(), e);
         } else if (i->readProperties(e, p, &customDrumset)) {
         } else {
             e.unknown();
@@ -779,7 +779,7 @@ static void readInstrument(Instrument* i, Part* p, XmlReader& e)
 static void readStaff(Staff* staff, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "type") {        // obsolete
             int staffTypeIdx = e.readInt();
             qDebug("obsolete: Staff::read staffTypeIdx %d", staffTypeIdx);
@@ -807,14 +807,14 @@ static void readStaff(Staff* staff, XmlReader& e)
 void readPart206(Part* part, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Instrument") {
             Instrument* i = part->_instruments.instrument(/* tick */ -1);
             readInstrument(i, part, e);
-            Drumset* ds = i->drumset();
             Staff* s = part->staff(0);
             int lld = s ? qRound(s->lineDistance(Fraction(0,1))) : 1;
-            if (ds && s && lld > 1) {
+            if (i->drumset() && s && lld > 1) {
+                Drumset* ds = i->editDrumset();
                 for (int j = 0; j < DRUM_INSTRUMENTS; ++j) {
                     ds->drum(j).line /= lld;
                 }
@@ -839,7 +839,7 @@ void readPart206(Part* part, XmlReader& e)
 static void readAmbitus(Ambitus* ambitus, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "head") {
             ambitus->setNoteHeadGroup(convertHeadGroup(e.readInt()));
         } else if (tag == "headType") {
@@ -861,7 +861,7 @@ static void readNote(Note* note, XmlReader& e)
     note->setTpc2(Tpc::TPC_INVALID);
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Accidental") {
             Accidental* a = new Accidental(note->score());
             a->setTrack(note->track());
@@ -1055,7 +1055,7 @@ static void adjustPlacement(Element* e)
 
 bool readNoteProperties206(Note* note, XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "pitch") {
         note->setPitch(e.readInt());
@@ -1299,7 +1299,7 @@ static bool readTextPropertyStyle206(QString xmlTag, const XmlReader& e, TextBas
 
 static bool readTextProperties206(XmlReader& e, TextBase* t)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     if (tag == "style") {
         e.skipCurrentElement();     // read in readTextPropertyStyle206
     } else if (tag == "foregroundColor") { // same as "color" ?
@@ -1473,7 +1473,7 @@ static void readTempoText(TempoText* t, XmlReader& e)
     TextReaderContext206 ctx(e);
     readTextPropertyStyle206(ctx.tag(), e, t, t);
     while (ctx.reader().readNextStartElement()) {
-        const QStringRef& tag(ctx.reader().name());
+        const XmlTag& tag(ctx.reader().name());
         if (tag == "tempo") {
             t->setTempo(ctx.reader().readDouble());
         } else if (tag == "followText") {
@@ -1502,7 +1502,7 @@ static void readMarker(Marker* m, XmlReader& e)
     Marker::Type mt = Marker::Type::SEGNO;
 
     while (ctx.reader().readNextStartElement()) {
-        const QStringRef& tag(ctx.reader().name());
+        const XmlTag& tag(ctx.reader().name());
         if (tag == "label") {
             QString s(ctx.reader().readElementText());
             m->setLabel(s);
@@ -1523,7 +1523,7 @@ static void readDynamic(Dynamic* d, XmlReader& e)
     TextReaderContext206 ctx(e);
     readTextPropertyStyle206(ctx.tag(), e, d, d);
     while (ctx.reader().readNextStartElement()) {
-        const QStringRef& tag = ctx.reader().name();
+        const XmlTag& tag = ctx.reader().name();
         if (tag == "subtype") {
             d->setDynamicType(ctx.reader().readElementText());
         } else if (tag == "velocity") {
@@ -1544,7 +1544,7 @@ static void readTuplet(Tuplet* tuplet, XmlReader& e)
 {
     tuplet->setId(e.intAttribute("id", 0));
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Number") {
             Text* _number = new Text(tuplet->score());
             _number->setParent(tuplet);
@@ -1578,7 +1578,7 @@ static void readLyrics(Lyrics* lyrics, XmlReader& e)
     Text* _verseNumber = 0;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "endTick") {
             // store <endTick> tag value until a <ticks> tag has been read
             // which positions this lyrics element in the score
@@ -1651,7 +1651,7 @@ bool readDurationProperties206(XmlReader& e, DurationElement* de)
 
 bool readTupletProperties206(XmlReader& e, Tuplet* de)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (de->readStyledProperty(e, tag)) {
     } else if (tag == "normalNotes") {
@@ -1693,7 +1693,7 @@ bool readTupletProperties206(XmlReader& e, Tuplet* de)
 
 bool readChordRestProperties206(XmlReader& e, ChordRest* ch)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "durationType") {
         ch->setDurationType(e.readElementText());
@@ -1891,7 +1891,7 @@ bool readChordRestProperties206(XmlReader& e, ChordRest* ch)
 
 bool readChordProperties206(XmlReader& e, Chord* ch)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "Note") {
         Note* note = new Note(ch->score());
@@ -2080,7 +2080,7 @@ static void fixTies(Chord* chord)
 static void readChord(Chord* chord, XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Note") {
             Note* note = new Note(chord->score());
             // the note needs to know the properties of the track it belongs to
@@ -2132,7 +2132,7 @@ static void readRest(Rest* rest, XmlReader& e)
 
 static bool readTextLineProperties(XmlReader& e, TextLineBase* tl)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "beginText") {
         Text* text = new Text(tl->score());
@@ -2170,7 +2170,7 @@ static bool readTextLineProperties(XmlReader& e, TextLineBase* tl)
 static void readVolta206(XmlReader& e, Volta* volta)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "endings") {
             QString s = e.readElementText();
             QStringList sl = s.split(",", Qt::SkipEmptyParts);
@@ -2210,7 +2210,7 @@ static void readPedal(XmlReader& e, Pedal* pedal)
 static void readOttava(XmlReader& e, Ottava* ottava)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             QString s = e.readElementText();
             bool ok;
@@ -2246,7 +2246,7 @@ void readHairpin206(XmlReader& e, Hairpin* h)
 {
     bool useText = false;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             h->setHairpinType(HairpinType(e.readInt()));
         } else if (tag == "lineWidth") {
@@ -2291,7 +2291,7 @@ void readHairpin206(XmlReader& e, Hairpin* h)
 void readTrill206(XmlReader& e, Trill* t)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             t->setTrillType(e.readElementText());
         } else if (tag == "Accidental") {
@@ -2372,7 +2372,7 @@ Element* readArticulation(Element* parent, XmlReader& e)
     bool useDefaultPlacement = true;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             QString s = e.readElementText();
             if (s[0].isDigit()) {
@@ -2497,7 +2497,7 @@ Element* readArticulation(Element* parent, XmlReader& e)
 
 static bool readSlurTieProperties(XmlReader& e, SlurTie* st)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (st->readProperty(tag, e, Pid::SLUR_DIRECTION)) {
     } else if (tag == "lineType") {
@@ -2521,7 +2521,7 @@ void readSlur206(XmlReader& e, Slur* s)
     s->setTrack(e.track());        // set staff
     e.addSpanner(e.intAttribute("id"), s);
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "track2") {
             s->setTrack2(e.readInt());
         } else if (tag == "startTrack") {       // obsolete
@@ -2608,7 +2608,7 @@ static void readMeasure(Measure* m, int staffIdx, XmlReader& e)
     Fraction lastTick = e.tick();
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "move") {
             e.setTick(e.readFraction() + m->tick());
@@ -3015,7 +3015,7 @@ static void readMeasure(Measure* m, int staffIdx, XmlReader& e)
             el->setTrack(e.track());
 
             while (e.readNextStartElement()) {
-                const QStringRef& tag(e.name());
+                const XmlTag& tag(e.name());
                 if (tag == "foregroundColor") {
                     e.skipCurrentElement();
                 } else if (!el->readProperties(e)) {
@@ -3196,7 +3196,7 @@ static void readBox(Box* b, XmlReader& e)
     bool keepMargins = false;          // whether original margins have to be kept when reading old file
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "HBox") {
             HBox* hb = new HBox(b->score());
             hb->read(e);
@@ -3251,7 +3251,7 @@ static void readStaffContent(Score* score, XmlReader& e)
 
     if (staff == 0) {
         while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const XmlTag& tag(e.name());
 
             if (tag == "Measure") {
                 if (lastReadBox) {
@@ -3313,7 +3313,7 @@ static void readStaffContent(Score* score, XmlReader& e)
     } else {
         Measure* measure = score->firstMeasure();
         while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const XmlTag& tag(e.name());
 
             if (tag == "Measure") {
                 if (measure == 0) {
@@ -3448,7 +3448,7 @@ static bool readScore(Score* score, XmlReader& e)
 {
     while (e.readNextStartElement()) {
         e.setTrack(-1);
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Staff") {
             readStaffContent(score, e);
         } else if (tag == "siglist") {
@@ -3716,7 +3716,7 @@ void PageFormat::read(XmlReader& e)
     QString type;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "page-margins") {
             type = e.attribute("type","both");
             qreal lm = 0.0, rm = 0.0, tm = 0.0, bm = 0.0;
@@ -3769,7 +3769,7 @@ void PageFormat::read(XmlReader& e)
 Score::FileError MasterScore::read206(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "programVersion") {
             setMscoreVersion(e.readElementText());
             parseVersion(mscoreVersion());
@@ -3836,9 +3836,13 @@ Score::FileError MasterScore::read206(XmlReader& e)
 
     // fix positions
     //    offset = saved offset - layout position
-    doLayout();
-    for (auto i : e.fixOffsets()) {
-        i.first->setOffset(i.second - i.first->pos());
+    //    without offsets to fix the score is laid out
+    //    only after reading
+    if (!e.fixOffsets().empty()) {
+        doLayout();
+        for (auto i : e.fixOffsets()) {
+            i.first->setOffset(i.second - i.first->pos());
+        }
     }
 
     // treat reading a 2.06 file as import
@@ -49,7 +49,7 @@ bool Score::read(XmlReader& e)
     ScoreOrder* order { nullptr };
     while (e.readNextStartElement()) {
         e.setTrack(-1);
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Staff") {
             readStaff(e);
         } else if (tag == "Omr") {
@@ -386,7 +386,7 @@ Score::FileError MasterScore::read302(XmlReader& e)
 {
     bool top = true;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "programVersion") {
             setMscoreVersion(e.readElementText());
             parseVersion(mscoreVersion());
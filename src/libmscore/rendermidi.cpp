@@ -17,6 +17,11 @@
 
 #include <set>
 #include <cmath>
+#include <queue>
+
+#ifndef Q_OS_WASM
+#include <QtConcurrent>
+#endif
 
 #include "rendermidi.h"
 #include "score.h"
@@ -964,9 +969,6 @@ void Score::updateHairpin(Hairpin* h)
 
 void Score::updateVelo()
 {
-    //
-    //    collect Dynamics
-    //
     if (!firstMeasure()) {
         return;
     }
@@ -975,118 +977,121 @@ void Score::updateVelo()
         st->velocities().clear();
         st->velocityMultiplications().clear();
     }
-    for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
-        Staff* st      = staff(staffIdx);
-        ChangeMap& velo = st->velocities();
-        ChangeMap& mult = st->velocityMultiplications();
-        Part* prt      = st->part();
-        int partStaves = prt->nstaves();
-        int partStaff  = Score::staffIdx(prt);
 
-        for (Segment* s = firstMeasure()->first(); s; s = s->next1()) {
-            Fraction tick = s->tick();
-            for (const Element* e : s->annotations()) {
-                if (e->staffIdx() != staffIdx) {
-                    continue;
-                }
-                if (e->type() != ElementType::DYNAMIC) {
-                    continue;
-                }
-                const Dynamic* d = toDynamic(e);
-                int v            = d->velocity();
+    //
+    //    collect the dynamics and hairpins by staff in one pass over
+    //    the score, the articulations only change the velocity of
+    //    their own staff
+    //
+    std::vector<std::vector<std::pair<Fraction, const Dynamic*> > > dynamics(nstaves());
+    std::vector<std::vector<Hairpin*> > hairpins(nstaves());
 
-                // treat an invalid dynamic as no change, i.e. a dynamic set to 0
-                if (v < 1) {
-                    continue;
-                }
+    for (Segment* s = firstMeasure()->first(); s; s = s->next1()) {
+        Fraction tick = s->tick();
+        for (const Element* e : s->annotations()) {
+            if (e->type() != ElementType::DYNAMIC) {
+                continue;
+            }
+            int staffIdx = e->staffIdx();
+            if (staffIdx >= 0 && staffIdx < nstaves()) {
+                dynamics[staffIdx].push_back({ tick, toDynamic(e) });
+            }
+        }
 
-                v = qBound(1, v, 127);             //  illegal values
+        if (!s->isChordRestType()) {
+            continue;
+        }
+        for (int i = 0; i < ntracks(); ++i) {
+            Element* el = s->element(i);
+            if (!el || !el->isChord()) {
+                continue;
+            }
 
-                // If a dynamic has 'velocity change' update its ending
-                int change = d->changeInVelocity();
-                ChangeDirection direction = ChangeDirection::INCREASING;
-                if (change < 0) {
-                    direction = ChangeDirection::DECREASING;
-                }
+            Chord* chord = toChord(el);
+            Instrument* instr = chord->part()->instrument();
 
-                int dStaffIdx = d->staffIdx();
-                switch (d->dynRange()) {
-                case Dynamic::Range::STAFF:
-                    if (dStaffIdx == staffIdx) {
-                        velo.addFixed(tick, v);
-                        if (change != 0) {
-                            Fraction etick = tick + d->velocityChangeLength();
-                            ChangeMethod method = ChangeMethod::NORMAL;
-                            velo.addRamp(tick, etick, change, method, direction);
-                        }
-                    }
-                    break;
-                case Dynamic::Range::PART:
-                    if (dStaffIdx >= partStaff && dStaffIdx < partStaff + partStaves) {
-                        for (int i = partStaff; i < partStaff + partStaves; ++i) {
-                            ChangeMap& stVelo = staff(i)->velocities();
-                            stVelo.addFixed(tick, v);
-                            if (change != 0) {
-                                Fraction etick = tick + d->velocityChangeLength();
-                                ChangeMethod method = ChangeMethod::NORMAL;
-                                stVelo.addRamp(tick, etick, change, method, direction);
-                            }
-                        }
-                    }
-                    break;
-                case Dynamic::Range::SYSTEM:
-                    for (int i = 0; i < nstaves(); ++i) {
-                        ChangeMap& stVelo = staff(i)->velocities();
-                        stVelo.addFixed(tick, v);
-                        if (change != 0) {
-                            Fraction etick = tick + d->velocityChangeLength();
-                            ChangeMethod method = ChangeMethod::NORMAL;
-                            stVelo.addRamp(tick, etick, change, method, direction);
-                        }
-                    }
-                    break;
+            qreal veloMultiplier = 1;
+            for (Articulation* a : chord->articulations()) {
+                if (a->playArticulation()) {
+                    veloMultiplier *= instr->getVelocityMultiplier(a->articulationName());
                 }
             }
 
-            if (s->isChordRestType()) {
-                for (int i = staffIdx * VOICES; i < (staffIdx + 1) * VOICES; ++i) {
-                    Element* el = s->element(i);
-                    if (!el || !el->isChord()) {
-                        continue;
-                    }
+            if (veloMultiplier == 1.0) {
+                continue;
+            }
 
-                    Chord* chord = toChord(el);
-                    Instrument* instr = chord->part()->instrument();
+            // TODO this should be a (configurable?) constant somewhere
+            static Fraction ARTICULATION_CHANGE_TIME_MAX = Fraction(1, 16);
+            Fraction ARTICULATION_CHANGE_TIME = qMin(s->ticks(), ARTICULATION_CHANGE_TIME_MAX);
+            int start = veloMultiplier * MidiRenderer::ARTICULATION_CONV_FACTOR;
+            int change = (veloMultiplier - 1) * MidiRenderer::ARTICULATION_CONV_FACTOR;
+            ChangeMap& mult = staff(i / VOICES)->velocityMultiplications();
+            mult.addFixed(chord->tick(), start);
+            mult.addRamp(chord->tick(),
+                         chord->tick() + ARTICULATION_CHANGE_TIME, change, ChangeMethod::NORMAL, ChangeDirection::DECREASING);
+        }
+    }
 
-                    qreal veloMultiplier = 1;
-                    for (Articulation* a : chord->articulations()) {
-                        if (a->playArticulation()) {
-                            veloMultiplier *= instr->getVelocityMultiplier(a->articulationName());
-                        }
-                    }
+    for (const auto& sp : _spanner.map()) {
+        Spanner* s = sp.second;
+        if (s->type() == ElementType::HAIRPIN && s->staffIdx() >= 0 && s->staffIdx() < nstaves()) {
+            hairpins[s->staffIdx()].push_back(toHairpin(s));
+        }
+    }
 
-                    if (veloMultiplier == 1.0) {
-                        continue;
-                    }
+    //
+    //    apply them staff by staff, in the order the changes
+    //    were always added to the maps
+    //
+    auto addDynamic = [](ChangeMap& velo, const Fraction& tick, const Dynamic* d, int v) {
+        velo.addFixed(tick, v);
 
-                    // TODO this should be a (configurable?) constant somewhere
-                    static Fraction ARTICULATION_CHANGE_TIME_MAX = Fraction(1, 16);
-                    Fraction ARTICULATION_CHANGE_TIME = qMin(s->ticks(), ARTICULATION_CHANGE_TIME_MAX);
-                    int start = veloMultiplier * MidiRenderer::ARTICULATION_CONV_FACTOR;
-                    int change = (veloMultiplier - 1) * MidiRenderer::ARTICULATION_CONV_FACTOR;
-                    mult.addFixed(chord->tick(), start);
-                    mult.addRamp(chord->tick(),
-                                 chord->tick() + ARTICULATION_CHANGE_TIME, change, ChangeMethod::NORMAL, ChangeDirection::DECREASING);
-                }
-            }
+        // If a dynamic has 'velocity change' update its ending
+        int change = d->changeInVelocity();
+        if (change != 0) {
+            ChangeDirection direction = change < 0 ? ChangeDirection::DECREASING : ChangeDirection::INCREASING;
+            Fraction etick = tick + d->velocityChangeLength();
+            velo.addRamp(tick, etick, change, ChangeMethod::NORMAL, direction);
         }
+    };
+
+    for (int staffIdx = 0; staffIdx < nstaves(); ++staffIdx) {
+        Staff* st      = staff(staffIdx);
+        Part* prt      = st->part();
+        int partStaves = prt->nstaves();
+        int partStaff  = Score::staffIdx(prt);
+
+        for (const auto& td : dynamics[staffIdx]) {
+            const Fraction& tick = td.first;
+            const Dynamic* d = td.second;
+            int v = d->velocity();
 
-        for (const auto& sp : _spanner.map()) {
-            Spanner* s = sp.second;
-            if (s->type() != ElementType::HAIRPIN || sp.second->staffIdx() != staffIdx) {
+            // treat an invalid dynamic as no change, i.e. a dynamic set to 0
+            if (v < 1) {
                 continue;
             }
-            Hairpin* h = toHairpin(s);
+
+            v = qBound(1, v, 127);             //  illegal values
+
+            switch (d->dynRange()) {
+            case Dynamic::Range::STAFF:
+                addDynamic(st->velocities(), tick, d, v);
+                break;
+            case Dynamic::Range::PART:
+                for (int i = partStaff; i < partStaff + partStaves; ++i) {
+                    addDynamic(staff(i)->velocities(), tick, d, v);
+                }
+                break;
+            case Dynamic::Range::SYSTEM:
+                for (int i = 0; i < nstaves(); ++i) {
+                    addDynamic(staff(i)->velocities(), tick, d, v);
+                }
+                break;
+            }
+        }
+
+        for (Hairpin* h : hairpins[staffIdx]) {
             updateHairpin(h);
         }
     }
@@ -1135,6 +1140,81 @@ void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const
     }
 }
 
+//---------------------------------------------------------
+//   renderStavesParallel
+///   Staves are independent while collecting measure events,
+///   so each one is rendered into its own buffer and the
+///   buffers are merged in staff order afterwards, which
+///   gives the same result as the sequential rendering.
+//---------------------------------------------------------
+
+void MidiRenderer::renderStavesParallel(const Chunk& chunk, EventMap* events, const std::vector<StaffContext>& sctxs)
+{
+    std::vector<EventMap> staffEvents(sctxs.size());
+
+#ifndef Q_OS_WASM
+    std::vector<int> indexes(sctxs.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i] = int(i);
+    }
+    QtConcurrent::blockingMap(indexes, [this, &chunk, &sctxs, &staffEvents](int i) {
+        renderStaffChunk(chunk, &staffEvents[i], sctxs[i]);
+    });
+#else
+    for (size_t i = 0; i < sctxs.size(); ++i) {
+        renderStaffChunk(chunk, &staffEvents[i], sctxs[i]);
+    }
+#endif
+
+    mergeStaffEvents(staffEvents, events);
+}
+
+//---------------------------------------------------------
+//   mergeStaffEvents
+///   k-way merge of sorted per staff buffers,
+///   equal ticks are ordered by staff index
+//---------------------------------------------------------
+
+void MidiRenderer::mergeStaffEvents(std::vector<EventMap>& staffEvents, EventMap* events)
+{
+    struct Cursor {
+        EventMap::const_iterator it;
+        EventMap::const_iterator end;
+        size_t staff;
+    };
+    auto greater = [](const Cursor& a, const Cursor& b) {
+        if (a.it->first != b.it->first) {
+            return a.it->first > b.it->first;
+        }
+        return a.staff > b.staff;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heap(greater);
+
+    for (size_t i = 0; i < staffEvents.size(); ++i) {
+        const EventMap& em = staffEvents[i];
+        events->registerChannel(em.highestChannel());
+        if (!em.empty()) {
+            heap.push({ em.cbegin(), em.cend(), i });
+        }
+    }
+
+    while (!heap.empty()) {
+        Cursor c = heap.top();
+        heap.pop();
+
+        // equal keys must go after the existing ones, as with a plain insert
+        if (events->empty() || events->rbegin()->first <= c.it->first) {
+            events->insert(events->end(), *c.it);
+        } else {
+            events->insert(*c.it);
+        }
+
+        if (++c.it != c.end) {
+            heap.push(c);
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   renderSpanners
 //---------------------------------------------------------
@@ -2298,13 +2378,15 @@ void Score::createPlayEvents(Chord* chord)
 
     Fraction tick = chord->tick();
     Slur* slur = 0;
-    for (auto sp : _spanner.map()) {
-        if (!sp.second->isSlur() || sp.second->staffIdx() != chord->staffIdx()) {
+    std::vector<interval_tree::Interval<Spanner*> > spanners;
+    _spanner.findOverlapping(tick.ticks(), tick.ticks(), spanners);
+    for (const auto& interval : spanners) {
+        Spanner* sp = interval.value;
+        if (!sp->isSlur() || sp->staffIdx() != chord->staffIdx()) {
             continue;
         }
-        Slur* s = toSlur(sp.second);
-        if (tick >= s->tick() && tick < s->tick2()) {
-            slur = s;
+        if (tick >= sp->tick() && tick < sp->tick2()) {
+            slur = toSlur(sp);
             break;
         }
     }
@@ -2445,25 +2527,50 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
     MidiRenderer::Context ctx(synthState);
     ctx.metronome = metronome;
     ctx.renderHarmony = true;
+    ctx.parallelStaves = true;
     MidiRenderer(this).renderScore(events, ctx);
 }
 
 void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 {
     updateState();
+
+    // the play events of the measures played again by a repeat are
+    // already there, the velocities and channels are for the whole score
+    std::set<std::pair<Measure const*, Measure const*> > played;
     for (const Chunk& chunk : chunks) {
-        renderChunk(chunk, events, ctx);
+        if (played.insert({ chunk.startMeasure(), chunk.endMeasure() }).second) {
+            score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+        }
+    }
+    score->updateChannel();
+    score->updateVelo();
+
+    for (const Chunk& chunk : chunks) {
+        renderChunkEvents(chunk, events, ctx);
     }
 }
 
 void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
 {
-    // TODO: avoid doing it multiple times for the same measures
+    TRACEFUNC;
+
     score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
 
     score->updateChannel();
     score->updateVelo();
 
+    renderChunkEvents(chunk, events, ctx);
+}
+
+//---------------------------------------------------------
+//   renderChunkEvents
+//    the play events, channels and velocities are already
+//    up to date
+//---------------------------------------------------------
+
+void MidiRenderer::renderChunkEvents(const Chunk& chunk, EventMap* events, const Context& ctx)
+{
     SynthesizerState s = score->synthesizerState();
     int method = s.method();
     int cc = s.ccToUse();
@@ -2502,13 +2609,23 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
     }
 
     // create note & other events
+    std::vector<StaffContext> sctxs;
+    sctxs.reserve(score->nstaves());
     for (Staff* st : score->staves()) {
         StaffContext sctx;
         sctx.staff = st;
         sctx.method = renderMethod;
         sctx.cc = cc;
         sctx.renderHarmony = ctx.renderHarmony;
-        renderStaffChunk(chunk, events, sctx);
+        sctxs.push_back(sctx);
+    }
+
+    if (ctx.parallelStaves && sctxs.size() > 1) {
+        renderStavesParallel(chunk, events, sctxs);
+    } else {
+        for (const StaffContext& sctx : sctxs) {
+            renderStaffChunk(chunk, events, sctx);
+        }
     }
     events->fixupMIDI();
 
@@ -2651,6 +2768,19 @@ void MidiRenderer::updateChunksPartition()
     }
 }
 
+//---------------------------------------------------------
+//   MidiRenderer::Chunk::contentHash
+//---------------------------------------------------------
+
+quint64 MidiRenderer::Chunk::contentHash() const
+{
+    quint64 hash = quint64(_tickOffset);
+    for (const Measure* m = first; m && m != endMeasure(); m = m->nextMeasure()) {
+        hash ^= m->contentHash() + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
 //---------------------------------------------------------
 //   MidiRenderer::getChunkAt
 //---------------------------------------------------------
@@ -2688,6 +2818,25 @@ MidiRenderer::Chunk MidiRenderer::chunkAt(int utick)
     return ch;
 }
 
+//---------------------------------------------------------
+//   MidiRenderer::chunksInRange
+///   Returns chunks which contain any measure of the
+///   [tick1, tick2) range, in all repeats.
+//---------------------------------------------------------
+
+std::vector<MidiRenderer::Chunk> MidiRenderer::chunksInRange(int tick1, int tick2)
+{
+    updateState();
+
+    std::vector<Chunk> result;
+    for (const Chunk& ch : chunks) {
+        if (ch.tick1() < tick2 && ch.tick2() > tick1) {
+            result.push_back(ch);
+        }
+    }
+    return result;
+}
+
 //---------------------------------------------------------
 //   RangeMap::setOccupied
 //---------------------------------------------------------
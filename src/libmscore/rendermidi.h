@@ -93,6 +93,10 @@ public:
         int tick2() const { return last ? last->endTick().ticks() : tick1(); }
         int utick1() const { return tick1() + tickOffset(); }
         int utick2() const { return tick2() + tickOffset(); }
+
+        // the same as long as nothing of the measures of the
+        // chunk is changed, see Measure::contentHash()
+        quint64 contentHash() const;
     };
 
 private:
@@ -111,6 +115,8 @@ private:
     void updateState();
 
     void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
+    void renderStavesParallel(const Chunk&, EventMap* events, const std::vector<StaffContext>& sctxs);
+    static void mergeStaffEvents(std::vector<EventMap>& staffEvents, EventMap* events);
     void renderSpanners(const Chunk&, EventMap* events);
     void renderMetronome(const Chunk&, EventMap* events);
     void renderMetronome(EventMap* events, Measure const* m, const Fraction& tickOffset);
@@ -128,6 +134,7 @@ public:
         const SynthesizerState& synthState;
         bool metronome{ true };
         bool renderHarmony{ false };
+        bool parallelStaves{ false };   // render each staff in its own buffer on a thread pool
         Context(const SynthesizerState& ss)
             : synthState(ss) {}
     };
@@ -143,6 +150,10 @@ public:
     static const int ARTICULATION_CONV_FACTOR { 100000 };
 
     Chunk chunkAt(int utick);
+    std::vector<Chunk> chunksInRange(int tick1, int tick2);
+
+private:
+    void renderChunkEvents(const Chunk&, EventMap* events, const Context& ctx);
 };
 
 class Spanner;
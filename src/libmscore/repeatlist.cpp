@@ -13,6 +13,7 @@
 #include "repeatlist.h"
 
 #include "jump.h"
+#include "layoutbreak.h"
 #include "marker.h"
 #include "measure.h"
 #include "score.h"
@@ -136,6 +137,17 @@ void RepeatList::update(bool expand)
     if (!_scoreChanged && expand == _expanded) {
         return;
     }
+    // most edits do not change the playback order, the list
+    // is only made again if an element it depends on changed
+    const quint64 key = structureKey();
+    if (key == _structureKey && expand == _expanded && !empty()) {
+        if (expand) {
+            updateTempo();
+        }
+        _scoreChanged = false;
+        return;
+    }
+    _structureKey = key;
 
     if (expand) {
         unwind();
@@ -146,6 +158,73 @@ void RepeatList::update(bool expand)
     _scoreChanged = false;
 }
 
+//---------------------------------------------------------
+//   mixKey
+//---------------------------------------------------------
+
+static void mixKey(quint64& h, quint64 v)
+{
+    h = (h ^ v) * 1099511628211ull;
+}
+
+//---------------------------------------------------------
+//   structureKey
+//    hash of the measures and of all elements which
+//    influence the playback order
+//---------------------------------------------------------
+
+quint64 RepeatList::structureKey() const
+{
+    quint64 h = 14695981039346656037ull;
+    for (const MeasureBase* mb = _score->first(); mb; mb = mb->next()) {
+        mixKey(h, quintptr(mb));
+        mixKey(h, mb->tick().ticks());
+        mixKey(h, mb->endTick().ticks());
+        const LayoutBreak* sectionBreak = mb->sectionBreak() ? mb->sectionBreakElement() : nullptr;
+        mixKey(h, quintptr(sectionBreak));
+        if (sectionBreak) {
+            mixKey(h, qHash(sectionBreak->pause()));
+        }
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        mixKey(h, (mb->repeatStart() ? 1 : 0) | (mb->repeatEnd() ? 2 : 0));
+        mixKey(h, toMeasure(mb)->repeatCount());
+        for (const Element* e : mb->el()) {
+            if (e->isJump()) {
+                const Jump* jump = toJump(e);
+                mixKey(h, quintptr(jump));
+                mixKey(h, qHash(jump->jumpTo()));
+                mixKey(h, qHash(jump->playUntil()));
+                mixKey(h, qHash(jump->continueAt()));
+                mixKey(h, jump->playRepeats());
+            } else if (e->isMarker()) {
+                const Marker* marker = toMarker(e);
+                mixKey(h, quintptr(marker));
+                mixKey(h, qHash(marker->label()));
+                mixKey(h, int(marker->align()));
+            }
+        }
+    }
+    for (const auto& i : _score->spanner()) {
+        const Spanner* s = i.second;
+        if (!s->isVolta()) {
+            continue;
+        }
+        const Volta* volta = toVolta(s);
+        mixKey(h, quintptr(volta));
+        mixKey(h, quintptr(volta->startElement()));
+        mixKey(h, quintptr(volta->endElement()));
+        mixKey(h, volta->tick().ticks());
+        mixKey(h, volta->tick2().ticks());
+        mixKey(h, int(volta->getProperty(Pid::END_HOOK_TYPE).value<HookType>()));
+        for (int ending : volta->endings()) {
+            mixKey(h, ending);
+        }
+    }
+    return h;
+}
+
 //---------------------------------------------------------
 //   updateTempo
 //---------------------------------------------------------
@@ -153,6 +232,7 @@ void RepeatList::update(bool expand)
 void RepeatList::updateTempo()
 {
     const TempoMap* tl = _score->tempomap();
+    TempoMap::Cursor cursor;
 
     int utick = 0;
     qreal t  = 0;
@@ -160,10 +240,10 @@ void RepeatList::updateTempo()
     for (RepeatSegment* s : *this) {
         s->utick      = utick;
         s->utime      = t;
-        qreal ct      = tl->tick2time(s->tick);
+        qreal ct      = tl->tick2time(s->tick, cursor);
         s->timeOffset = t - ct;
         utick        += s->len();
-        t            += tl->tick2time(s->tick + s->len()) - ct;
+        t            += tl->tick2time(s->tick + s->len(), cursor) - ct;
     }
 }
 
@@ -221,7 +301,7 @@ qreal RepeatList::utick2utime(int tick) const
     for (unsigned i = ii; i < n; ++i) {
         if ((tick >= at(i)->utick) && ((i + 1 == n) || (tick < at(i + 1)->utick))) {
             int t     = tick - (at(i)->utick - at(i)->tick);
-            qreal tt = _score->tempomap()->tick2time(t) + at(i)->timeOffset;
+            qreal tt = _score->tempomap()->tick2time(t, _tempoCursor) + at(i)->timeOffset;
             return tt;
         }
     }
@@ -239,7 +319,7 @@ int RepeatList::utime2utick(qreal t) const
     for (unsigned i = ii; i < n; ++i) {
         if ((t >= at(i)->utime) && ((i + 1 == n) || (t < at(i + 1)->utime))) {
             idx2 = i;
-            return _score->tempomap()->time2tick(t - at(i)->timeOffset) + (at(i)->utick - at(i)->tick);
+            return _score->tempomap()->time2tick(t - at(i)->timeOffset, _tempoCursor) + (at(i)->utick - at(i)->tick);
         }
     }
     if (MScore::debugMode) {
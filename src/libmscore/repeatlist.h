@@ -16,6 +16,8 @@
 #include <QList>
 #include <set>
 
+#include "tempo.h"
+
 namespace Ms {
 class Score;
 class Measure;
@@ -62,13 +64,16 @@ class RepeatList : public QList<RepeatSegment*>
 {
     Score* _score;
     mutable unsigned idx1, idx2;     // cached values
+    mutable TempoMap::Cursor _tempoCursor;
 
     bool _expanded = false;
     bool _scoreChanged = true;
+    quint64 _structureKey = 0;      // of the score the list was made for
 
     std::set<std::pair<Jump const* const, int> > _jumpsTaken;     // take the jumps only once, so track them during unwind
     QList<QList<RepeatListElement*>*> _rlElements;   // all elements of the score that influence the RepeatList
 
+    quint64 structureKey() const;
     void collectRepeatListElements();
     std::pair<QList<QList<RepeatListElement*>*>::const_iterator, QList<RepeatListElement*>::const_iterator> findMarker(
         QString label, QList<QList<RepeatListElement*>*>::const_iterator referenceSectionIt,
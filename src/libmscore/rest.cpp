@@ -911,7 +911,7 @@ void Rest::write(XmlWriter& xml) const
 void Rest::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "Symbol") {
             Symbol* s = new Symbol(score());
             s->setTrack(track());
@@ -1075,7 +1075,7 @@ Shape Rest::shape() const
     }
     for (Element* e : el()) {
         if (e->addToSkyline()) {
-            shape.add(e->shape().translated(e->pos()));
+            shape.add(e->shape(), e->pos());
         }
     }
     return shape;
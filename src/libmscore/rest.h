@@ -16,6 +16,7 @@
 #include "chordrest.h"
 #include "notedot.h"
 #include "sym.h"
+#include "elementpool.h"
 
 namespace Ms {
 class TDuration;
@@ -27,6 +28,8 @@ class TDuration;
 
 class Rest : public ChordRest
 {
+    ELEMENT_POOL_ALLOCATION
+
 public:
     Rest(Score* s = 0);
     Rest(Score*, const TDuration&);
@@ -88,6 +91,7 @@ public:
     QVariant propertyDefault(Pid) const override;
     void resetProperty(Pid id) override;
     bool setProperty(Pid propertyId, const QVariant& v) override;
+    bool setPropertyValue(Pid id, const PropertyValue& v) override { return ScoreElement::setPropertyValue(id, v); }
     QVariant getProperty(Pid propertyId) const override;
     void undoChangeDotsVisible(bool v);
 
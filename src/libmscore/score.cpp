@@ -62,6 +62,7 @@
 #include "revisions.h"
 #include "tie.h"
 #include "tiemap.h"
+#include "layout.h"
 #include "layoutbreak.h"
 #include "harmony.h"
 #include "mscore.h"
@@ -102,6 +103,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -122,6 +124,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -143,6 +146,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
 
 void MeasureBaseList::add(MeasureBase* e)
 {
+    _tickIndex.invalidate();
     MeasureBase* el = e->next();
     if (el == 0) {
         push_back(e);
@@ -165,6 +169,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    _tickIndex.invalidate();
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -184,6 +189,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    _tickIndex.invalidate();
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -209,6 +215,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    _tickIndex.invalidate();
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -227,12 +234,56 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
     }
 }
 
+//---------------------------------------------------------
+//   findMeasure
+//    the last measure starting at or before tick
+//---------------------------------------------------------
+
+Measure* MeasureBaseList::findMeasure(const Fraction& tick) const
+{
+    const std::vector<Measure*>* index = _tickIndex.items([this](std::vector<Measure*>& items) {
+        items.reserve(_size);
+        for (MeasureBase* mb = _first; mb; mb = mb->next()) {
+            if (mb->isMeasure()) {
+                items.push_back(toMeasure(mb));
+            }
+        }
+    }, [](const Measure* m) { return m->tick(); });
+
+    Measure* measure = nullptr;
+    if (index) {
+        auto i = std::upper_bound(index->begin(), index->end(), tick, [](const Fraction& t, const Measure* m) {
+            return t < m->tick();
+        });
+        measure = i != index->begin() ? *(i - 1) : nullptr;
+    } else {
+        for (MeasureBase* mb = _first; mb && mb->tick() <= tick; mb = mb->next()) {
+            if (mb->isMeasure()) {
+                measure = toMeasure(mb);
+            }
+        }
+    }
+#ifndef NDEBUG
+    if (MScore::debugMode && index) {
+        Measure* m = nullptr;
+        for (MeasureBase* mb = _first; mb && mb->tick() <= tick; mb = mb->next()) {
+            if (mb->isMeasure()) {
+                m = toMeasure(mb);
+            }
+        }
+        Q_ASSERT(m == measure);
+    }
+#endif
+    return measure;
+}
+
 //---------------------------------------------------------
 //   change
 //---------------------------------------------------------
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    _tickIndex.invalidate();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -362,6 +413,7 @@ Score::~Score()
     foreach (MuseScoreView* v, viewer) {
         v->removeScore();
     }
+    delete _pendingLayout;
     // deselectAll();
     qDeleteAll(_systems);   // systems are layout-only objects so we delete
                             // them prior to measures.
@@ -804,14 +856,52 @@ void MasterScore::setPlaylistDirty()
     _repeatList2->setScoreChanged();
 }
 
+//---------------------------------------------------------
+//   addPlaybackDirtyRange
+///   Remember the tick range changed by a command,
+///   so playback can re-render only this part of the score.
+//---------------------------------------------------------
+
+void MasterScore::addPlaybackDirtyRange(const Fraction& tick1, const Fraction& tick2)
+{
+    if (tick1 < Fraction(0, 1) || tick2 < Fraction(0, 1)) {
+        return;
+    }
+    if (_playbackDirtyTick1 < Fraction(0, 1) || tick1 < _playbackDirtyTick1) {
+        _playbackDirtyTick1 = tick1;
+    }
+    if (_playbackDirtyTick2 < Fraction(0, 1) || tick2 > _playbackDirtyTick2) {
+        _playbackDirtyTick2 = tick2;
+    }
+}
+
+//---------------------------------------------------------
+//   takePlaybackDirtyRange
+///   Return the accumulated dirty range and reset it,
+///   false if nothing has changed.
+//---------------------------------------------------------
+
+bool MasterScore::takePlaybackDirtyRange(Fraction& tick1, Fraction& tick2)
+{
+    if (_playbackDirtyTick1 < Fraction(0, 1)) {
+        return false;
+    }
+    tick1 = _playbackDirtyTick1;
+    tick2 = _playbackDirtyTick2;
+    _playbackDirtyTick1 = Fraction(-1, 1);
+    _playbackDirtyTick2 = Fraction(-1, 1);
+    return true;
+}
+
 //---------------------------------------------------------
 //   spell
 //---------------------------------------------------------
 
 void Score::spell()
 {
+    std::vector<std::vector<Note*> > lists(nstaves());
     for (int i = 0; i < nstaves(); ++i) {
-        std::vector<Note*> notes;
+        std::vector<Note*>& notes = lists[i];
         for (Segment* s = firstSegment(SegmentType::All); s; s = s->next1()) {
             int strack = i * VOICES;
             int etrack = strack + VOICES;
@@ -824,14 +914,16 @@ void Score::spell()
                 }
             }
         }
-        spellNotelist(notes);
     }
+    spellNotelists(lists);
 }
 
 void Score::spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment)
 {
+    std::vector<std::vector<Note*> > lists;
     for (int i = startStaff; i < endStaff; ++i) {
-        std::vector<Note*> notes;
+        lists.emplace_back();
+        std::vector<Note*>& notes = lists.back();
         for (Segment* s = startSegment; s && s != endSegment; s = s->next()) {
             int strack = i * VOICES;
             int etrack = strack + VOICES;
@@ -844,8 +936,8 @@ void Score::spell(int startStaff, int endStaff, Segment* startSegment, Segment*
                 }
             }
         }
-        spellNotelist(notes);
     }
+    spellNotelists(lists);
 }
 
 //---------------------------------------------------------
@@ -1386,6 +1478,7 @@ void Score::addElement(Element* element)
 {
     Element* parent = element->parent();
     element->triggerLayout();
+    element->revisionChanged();
 
 //      qDebug("Score(%p) Element(%p)(%s) parent %p(%s)",
 //         this, element, element->name(), parent, parent ? parent->name() : "");
@@ -1525,6 +1618,7 @@ void Score::removeElement(Element* element)
 {
     Element* parent = element->parent();
     element->triggerLayout();
+    element->revisionChanged();
 
 //      qDebug("Score(%p) Element(%p)(%s) parent %p(%s)",
 //         this, element, element->name(), parent, parent ? parent->name() : "");
@@ -2848,6 +2942,21 @@ void Score::mapExcerptTracks(QList<int>& dst)
     }
 }
 
+//---------------------------------------------------------
+//   isTransposingStaff
+//    staves without transposition and instrument changes
+//    look the same in concert pitch
+//---------------------------------------------------------
+
+static bool isTransposingStaff(Staff* staff)
+{
+    if (staff->staffType(Fraction(0,1))->group() == StaffGroup::PERCUSSION) {         // TODO
+        return false;
+    }
+    const Part* part = staff->part();
+    return !part->instrument()->transpose().isZero() || part->instruments()->size() != 1;      //tick?
+}
+
 //---------------------------------------------------------
 //   cmdConcertPitchChanged
 //---------------------------------------------------------
@@ -2856,50 +2965,91 @@ void Score::cmdConcertPitchChanged(bool flag)
 {
     undoChangeStyleVal(Sid::concertPitch, flag);         // change style flag
 
+    std::vector<bool> transposing(nstaves(), false);
+    bool transposingStaves = false;
     for (Staff* staff : qAsConst(_staves)) {
-        if (staff->staffType(Fraction(0,1))->group() == StaffGroup::PERCUSSION) {         // TODO
-            continue;
-        }
-        // if this staff has no transposition, and no instrument changes, we can skip it
-        Interval interval = staff->part()->instrument()->transpose(); //tick?
-        if (interval.isZero() && staff->part()->instruments()->size() == 1) {
+        if (!isTransposingStaff(staff)) {
             continue;
         }
+        Interval interval = staff->part()->instrument()->transpose();
         if (!flag) {
             interval.flip();
         }
-
-        int staffIdx   = staff->idx();
-        int startTrack = staffIdx * VOICES;
-        int endTrack   = startTrack + VOICES;
-
+        int staffIdx = staff->idx();
+        transposing[staffIdx] = true;
+        transposingStaves = true;
         transposeKeys(staffIdx, staffIdx + 1, Fraction(0,1), lastSegment()->tick(), interval, true, !flag);
+    }
+    if (!transposingStaves) {
+        return;
+    }
 
-        for (Segment* segment = firstSegment(SegmentType::ChordRest); segment; segment = segment->next1(SegmentType::ChordRest)) {
-            interval = staff->part()->instrument(segment->tick())->transpose();
+    // the harmonies of all transposing staves in one pass, and in one undo command
+    TransposeHarmony* transposeHarmony = nullptr;
+    for (Segment* segment = firstSegment(SegmentType::ChordRest); segment; segment = segment->next1(SegmentType::ChordRest)) {
+        for (Element* e : segment->annotations()) {
+            if (!e->isHarmony() || !transposing[e->staffIdx()]) {
+                continue;
+            }
+            Harmony* h  = toHarmony(e);
+            Interval interval = h->staff()->part()->instrument(segment->tick())->transpose();
             if (!flag) {
                 interval.flip();
             }
-            for (Element* e : segment->annotations()) {
-                if (!e->isHarmony() || (e->track() < startTrack) || (e->track() >= endTrack)) {
-                    continue;
-                }
-                Harmony* h  = toHarmony(e);
-                int rootTpc = transposeTpc(h->rootTpc(), interval, true);
-                int baseTpc = transposeTpc(h->baseTpc(), interval, true);
-                for (ScoreElement* se : h->linkList()) {
-                    // don't transpose all links
-                    // just ones resulting from mmrests
-                    Harmony* he = toHarmony(se);              // toHarmony() does not work as e is an ScoreElement
-                    if (he->staff() == h->staff()) {
-                        undoTransposeHarmony(he, rootTpc, baseTpc);
+            int rootTpc = transposeTpc(h->rootTpc(), interval, true);
+            int baseTpc = transposeTpc(h->baseTpc(), interval, true);
+            for (ScoreElement* se : h->linkList()) {
+                // don't transpose all links
+                // just ones resulting from mmrests
+                Harmony* he = toHarmony(se);              // toHarmony() does not work as e is an ScoreElement
+                if (he->staff() == h->staff()) {
+                    if (!transposeHarmony) {
+                        transposeHarmony = new TransposeHarmony();
                     }
+                    transposeHarmony->add(he, rootTpc, baseTpc);
                 }
-                //realized harmony should be invalid after a transpose command
-                Q_ASSERT(!h->realizedHarmony().valid());
             }
         }
     }
+    if (transposeHarmony) {
+        undo(transposeHarmony);
+    }
+}
+
+//---------------------------------------------------------
+//   concertPitchChanged
+//    Only the staves of transposing instruments change, so
+//    only the range where they play is laid out again, and
+//    nothing if there are none.
+//---------------------------------------------------------
+
+void Score::concertPitchChanged()
+{
+    Fraction tick1(-1, 1);
+    Fraction tick2(-1, 1);
+    for (Staff* staff : qAsConst(_staves)) {
+        if (!isTransposingStaff(staff)) {
+            continue;
+        }
+        const InstrumentList* il = staff->part()->instruments();
+        for (auto i = il->begin(); i != il->end(); ++i) {
+            if (i->second->transpose().isZero()) {
+                continue;
+            }
+            auto next = std::next(i);
+            const Fraction start = i == il->begin() ? Fraction(0, 1) : Fraction::fromTicks(i->first);
+            const Fraction end   = next == il->end() ? endTick() : Fraction::fromTicks(next->first);
+            if (tick1 < Fraction(0, 1) || start < tick1) {
+                tick1 = start;
+            }
+            if (end > tick2) {
+                tick2 = end;
+            }
+        }
+    }
+    if (tick1 >= Fraction(0, 1)) {
+        setLayout(tick1, tick2, 0, nstaves() - 1);
+    }
 }
 
 //---------------------------------------------------------
@@ -3189,6 +3339,9 @@ void Score::deselect(Element* el)
 
 void Score::select(Element* e, SelectType type, int staffIdx)
 {
+    // the selection can move to measures a lazy layout did not get to
+    finishLayout();
+
     // Move the playhead to the selected element's preferred play position.
     if (e) {
         const auto playTick = e->playTick();
@@ -3669,15 +3822,64 @@ qreal Score::maxSystemDistance() const
     }
 }
 
+//---------------------------------------------------------
+//   uncoveredParts
+//    the parts of r outside of covered
+//---------------------------------------------------------
+
+static QVector<QRectF> uncoveredParts(const QRectF& r, const QRectF& covered)
+{
+    const QRectF c = r & covered;
+    if (c.isEmpty()) {
+        return { r };
+    }
+    QVector<QRectF> parts;
+    if (r.top() < c.top()) {
+        parts.append(QRectF(QPointF(r.left(), r.top()), QPointF(r.right(), c.top())));
+    }
+    if (c.bottom() < r.bottom()) {
+        parts.append(QRectF(QPointF(r.left(), c.bottom()), QPointF(r.right(), r.bottom())));
+    }
+    if (r.left() < c.left()) {
+        parts.append(QRectF(QPointF(r.left(), c.top()), QPointF(c.left(), c.bottom())));
+    }
+    if (c.right() < r.right()) {
+        parts.append(QRectF(QPointF(c.right(), c.top()), QPointF(r.right(), c.bottom())));
+    }
+    return parts;
+}
+
 //---------------------------------------------------------
 //   lassoSelect
+//    selects the elements within bbox. While the lasso is
+//    moved, only the elements leaving it are deselected and
+//    only the parts of bbox the last lasso did not cover are
+//    searched for elements to add, until lassoSelectEnd().
 //---------------------------------------------------------
 
 void Score::lassoSelect(const QRectF& bbox)
 {
-    select(0, SelectType::SINGLE, 0);
     QRectF fr(bbox.normalized());
-    foreach (Page* page, pages()) {
+    QRectF old(_lassoRect);
+    if (old.isNull() || _selection.isRange()) {
+        select(0, SelectType::SINGLE, 0);
+        old = QRectF();
+    } else {
+        finishLayout();
+    }
+    _lassoRect = fr;
+
+    QList<Element*> removed;
+    for (Element* e : _selection.elements()) {
+        if (!fr.contains(e->abbox())) {
+            addRefresh(e->abbox());
+            removed.append(e);
+        }
+    }
+
+    QList<Element*> added;
+    QSet<Element*> found;
+    for (Page* page : pages()) {
         QRectF pr(page->bbox());
         QRectF frr(fr.translated(-page->pos()));
         if (pr.right() < frr.left()) {
@@ -3687,16 +3889,26 @@ void Score::lassoSelect(const QRectF& bbox)
             break;
         }
 
-        QList<Element*> el = page->items(frr);
-        for (int i = 0; i < el.size(); ++i) {
-            Element* e = el.at(i);
-            if (frr.contains(e->abbox())) {
+        QRectF oldr(old.translated(-page->pos()));
+        for (const QRectF& part : uncoveredParts(frr, oldr)) {
+            for (Element* e : page->items(part)) {
+                if (e->selected() || found.contains(e) || !frr.contains(e->abbox()) || oldr.contains(e->abbox())) {
+                    continue;
+                }
                 if (e->type() != ElementType::MEASURE && e->selectable()) {
-                    select(e, SelectType::ADD, 0);
+                    found.insert(e);
+                    addRefresh(e->abbox());
+                    added.append(e);
                 }
             }
         }
     }
+
+    if (!removed.empty() || !added.empty()) {
+        _selection.remove(removed);
+        _selection.add(added);
+        setSelectionChanged(true);
+    }
 }
 
 //---------------------------------------------------------
@@ -3712,6 +3924,8 @@ void Score::lassoSelectEnd()
     int endStaff          = 0;
     const ChordRest* endCR = 0;
 
+    _lassoRect = QRectF();
+
     if (_selection.elements().empty()) {
         _selection.setState(SelState::NONE);
         setUpdateAll();
@@ -4040,9 +4254,7 @@ void Score::appendPart(const InstrumentTemplate* t)
 
 void Score::appendMeasures(int n)
 {
-    for (int i = 0; i < n; ++i) {
-        insertMeasure(ElementType::MEASURE, 0, false);
-    }
+    insertMeasures(n, ElementType::MEASURE, 0, false);
 }
 
 //---------------------------------------------------------
@@ -5260,6 +5472,62 @@ void Score::addRefresh(const QRectF& r)
     cmdState().setUpdateMode(UpdateMode::Update);
 }
 
+//---------------------------------------------------------
+//   addChangedArea
+//    r is in canvas coordinates
+//---------------------------------------------------------
+
+static constexpr size_t MAX_CHANGED_AREAS = 64;
+
+void Score::addChangedArea(const QRectF& r)
+{
+    if (r.isEmpty()) {
+        return;
+    }
+    _changedAreas.push_back({ ++_changeRevision, r, false });
+    if (_changedAreas.size() > MAX_CHANGED_AREAS) {
+        _changedAreas.pop_front();
+    }
+}
+
+//---------------------------------------------------------
+//   setAllChanged
+//---------------------------------------------------------
+
+void Score::setAllChanged()
+{
+    _changedAreas.clear();
+    _changedAreas.push_back({ ++_changeRevision, QRectF(), true });
+}
+
+//---------------------------------------------------------
+//   changedAreaSince
+//    the area changed after revision; returns false if
+//    everything may have changed or the changes are too
+//    old to be known
+//---------------------------------------------------------
+
+bool Score::changedAreaSince(int revision, QRectF* area) const
+{
+    *area = QRectF();
+    if (revision == _changeRevision) {
+        return true;
+    }
+    if (_changedAreas.empty() || _changedAreas.front().revision > revision + 1) {
+        return false;
+    }
+    for (const ChangedArea& ca : _changedAreas) {
+        if (ca.revision <= revision) {
+            continue;
+        }
+        if (ca.all) {
+            return false;
+        }
+        *area |= ca.area;
+    }
+    return true;
+}
+
 //---------------------------------------------------------
 //   staffIdx
 //
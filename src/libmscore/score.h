@@ -18,6 +18,8 @@
  Definition of Score class.
 */
 
+#include <deque>
+#include <limits>
 #include <set>
 #include <QFileInfo>
 #include <QQueue>
@@ -31,8 +33,10 @@
 #include "mscoreview.h"
 #include "spannermap.h"
 #include "layoutbreak.h"
+#include "msczsnapshot.h"
 #include "property.h"
 #include "sym.h"
+#include "tickindex.h"
 
 namespace mu {
 namespace notation {
@@ -161,6 +165,7 @@ class MeasureBaseList
     int _size;
     MeasureBase* _first;
     MeasureBase* _last;
+    TickIndex<Measure> _tickIndex;        // the measures, without frames
 
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
@@ -169,7 +174,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; _tickIndex.invalidate(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -178,6 +183,9 @@ public:
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
     void fixupSystems();
+
+    Measure* findMeasure(const Fraction& tick) const;
+    void invalidateTickIndex() { _tickIndex.invalidate(); }
 };
 
 //---------------------------------------------------------
@@ -236,6 +244,7 @@ enum class LayoutFlag : char {
     FIX_PITCH_VELO = 1,
     PLAY_EVENTS    = 2,
     REBUILD_MIDI_MAPPING = 4,
+    SYSTEM_LOCAL   = 8,     // take the systems after the range over unchanged, as while dragging
 };
 
 typedef QFlags<LayoutFlag> LayoutFlags;
@@ -258,6 +267,23 @@ struct Layer {
     uint tags = 0;
 };
 
+//---------------------------------------------------------
+//   LayoutStatistics
+//    the work done by a layout of the score
+//---------------------------------------------------------
+
+struct LayoutStatistics {
+    int layouts       { 0 };
+    int measures      { 0 };        // measures laid out
+    int systems       { 0 };        // systems laid out
+    int reusedSystems { 0 };        // systems taken over from the previous layout
+    int pages         { 0 };        // pages filled
+    int cutOffs       { 0 };        // layouts stopped before the end of the score
+    double timeMs     { 0.0 };      // time spent laying out
+
+    void add(const LayoutStatistics& st);
+};
+
 //---------------------------------------------------------
 //   UpdateMode
 //    There is an implied order from least invasive update
@@ -472,6 +498,19 @@ private:
     //
     QList<Page*> _pages;            // pages are build from systems
     QList<System*> _systems;        // measures are accumulated to systems
+    LayoutStatistics _layoutStatistics;
+    LayoutStatistics _layoutTotals;
+    LayoutContext* _pendingLayout { nullptr };    // of a lazy layout that is not done yet
+    int _lazyLayoutPages { 0 };
+    int _pageCountHint   { 0 };
+
+    struct ChangedArea {
+        int revision;
+        QRectF area;
+        bool all;
+    };
+    int _changeRevision { 0 };
+    std::deque<ChangedArea> _changedAreas;      // the latest edits, for views that cache what they painted
 
     InputState _is;
     MStyle _style;
@@ -506,6 +545,7 @@ private:
     constexpr static double _defaultTempo = 2.0;   //default tempo is equal 120 bpm
 
     Selection _selection;
+    QRectF _lassoRect;              ///< of the last lassoSelect(), null while there is no lasso
     SelectionFilter _selectionFilter;
     Audio* _audio { 0 };
     PlayMode _playMode { PlayMode::SYNTHESIZER };
@@ -552,6 +592,8 @@ private:
 
     bool rewriteMeasures(Measure* fm, Measure* lm, const Fraction&, int staffIdx);
     bool rewriteMeasures(Measure* fm, const Fraction& ns, int staffIdx);
+    bool rebarEmptyMeasures(Measure* fm, Measure* lm, const Fraction& ns);
+    void resetInputSegment();
     void swingAdjustParams(Chord*, int&, int&, int, int);
     bool isSubdivided(ChordRest*, int);
     void addAudioTrack();
@@ -629,6 +671,7 @@ public:
     virtual ElementType type() const override { return ElementType::SCORE; }
 
     void rebuildBspTree();
+    void releaseBspTree();
     bool noStaves() const { return _staves.empty(); }
     void insertPart(Part*, int);
     void removePart(Part*);
@@ -705,10 +748,11 @@ public:
     void undoChangePitch(Note* note, int pitch, int tpc1, int tpc2);
     void undoChangeFretting(Note* note, int pitch, int string, int fret, int tpc1, int tpc2);
     void spellNotelist(std::vector<Note*>& notes);
+    void spellNotelists(std::vector<std::vector<Note*> >& lists);
     void undoChangeTpc(Note* note, int tpc);
     void undoChangeChordRestLen(ChordRest* cr, const TDuration&);
     void undoTransposeHarmony(Harmony*, int, int);
-    void undoExchangeVoice(Measure* measure, int val1, int val2, int staff1, int staff2);
+    void undoExchangeVoice(Measure* first, Measure* last, int val1, int val2, int staff1, int staff2);
     void undoRemovePart(Part* part, int idx = -1);
     void undoInsertPart(Part* part, int idx);
     void undoRemoveStaff(Staff* staff);
@@ -793,6 +837,7 @@ public:
     void globalInsertChord(const Position&);
 
     void cloneVoice(int strack, int dtrack, Segment* sf, const Fraction& lTick, bool link = true, bool spanner = true);
+    void exchangeVoice(Measure* first, Measure* last, int strack, int dtrack, int staffIdx);
 
     void repitchNote(const Position& pos, bool replace);
     void regroupNotesAndRests(const Fraction& startTick, const Fraction& endTick, int track);
@@ -817,6 +862,11 @@ public:
     virtual inline void setInstrumentsChanged(bool);
     void addRefresh(const QRectF&);
 
+    int changeRevision() const { return _changeRevision; }
+    void addChangedArea(const QRectF& r);
+    void setAllChanged();
+    bool changedAreaSince(int revision, QRectF* area) const;
+
     void cmdRelayout();
     void cmdToggleAutoplace(bool all);
 
@@ -860,6 +910,7 @@ public:
     bool saveFile(QIODevice* f, bool msczFormat, bool onlySelection = false);
     bool saveCompressedFile(QFileInfo&, bool onlySelection, bool createThumbnail = true);
     bool saveCompressedFile(QIODevice*, const QString& fileName, bool onlySelection, bool createThumbnail = true);
+    MsczSnapshot createMsczSnapshot(const QString& fileName, bool onlySelection, bool createThumbnail = true);
 
     void print(mu::draw::Painter* printer, int page);
     ChordRest* getSelectedChordRest() const;
@@ -940,12 +991,12 @@ public:
     bool saveStyle(const QString&);
 
     QVariant styleV(Sid idx) const { return style().value(idx); }
-    Spatium  styleS(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return style().value(idx).value<Spatium>(); }
+    Spatium  styleS(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return style().valueS(idx); }
     qreal    styleP(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return style().pvalue(idx); }
     QString  styleSt(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"QString")); return style().value(idx).toString(); }
-    bool     styleB(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool")); return style().value(idx).toBool(); }
-    qreal    styleD(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double")); return style().value(idx).toDouble(); }
-    int      styleI(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int")); return style().value(idx).toInt(); }
+    bool     styleB(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool")); return style().valueB(idx); }
+    qreal    styleD(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double")); return style().valueD(idx); }
+    int      styleI(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int")); return style().valueI(idx); }
 
     void setStyleValue(Sid sid, QVariant value) { style().set(sid, value); }
     QString getTextStyleUserName(Tid tid);
@@ -1003,6 +1054,7 @@ public:
     void updateChannel();
 
     void cmdConcertPitchChanged(bool);
+    void concertPitchChanged();
 
     virtual inline TempoMap* tempomap() const;
     virtual inline TimeSigMap* sigmap() const;
@@ -1066,6 +1118,8 @@ public:
 
     const QList<System*>& systems() const { return _systems; }
     QList<System*>& systems() { return _systems; }
+    const LayoutStatistics& layoutStatistics() const { return _layoutStatistics; }        // of the last layout
+    const LayoutStatistics& layoutTotals() const { return _layoutTotals; }
 
     MeasureBaseList* measures() { return &_measures; }
     bool checkHasMeasures() const;
@@ -1087,6 +1141,7 @@ public:
     Segment* lastSegmentMM() const;
 
     void connectTies(bool silent = false);
+    void connectTies(const Fraction& stick, const Fraction& etick, bool silent = false);
     void relayoutForStyles();
 
     qreal point(const Spatium sp) const { return sp.val() * spatium(); }
@@ -1112,6 +1167,11 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction&, const Fraction&);
+    void setLazyLayout(int firstPages, int pageCountHint = 0);
+    bool layoutPending() const { return _pendingLayout; }
+    bool continueLayout(int pages);
+    void finishLayout() { continueLayout(std::numeric_limits<int>::max()); }
+    void setLayoutStatistics(const LayoutStatistics&);
     void layoutLinear(bool layoutAll, LayoutContext& lc);
 
     void layoutChords1(Segment* segment, int staffIdx);
@@ -1179,6 +1239,8 @@ public:
 
     void insertMeasure(ElementType type, MeasureBase*, bool createEmptyMeasures = false, bool moveSignaturesClef = true,
                        bool needDeselectAll = true);
+    void insertMeasures(int count, ElementType type, MeasureBase*, bool createEmptyMeasures = false, bool moveSignaturesClef = true,
+                        bool needDeselectAll = true);
 
     Audio* audio() const { return _audio; }
     void setAudio(Audio* a) { _audio = a; }
@@ -1263,6 +1325,7 @@ public:
     QString accessibleMessage() const { return accMessage; }
 
     QImage createThumbnail();
+    QPicture createThumbnailPicture();
     QString createRehearsalMarkText(RehearsalMark* current) const;
     QString nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
 
@@ -1334,6 +1397,8 @@ class MasterScore : public Score
     RepeatList* _repeatList2;
     bool _expandRepeats     { MScore::playRepeats };
     bool _playlistDirty     { true };
+    Fraction _playbackDirtyTick1 { -1, 1 };     // range changed since the last takePlaybackDirtyRange()
+    Fraction _playbackDirtyTick2 { -1, 1 };
     QList<Excerpt*> _excerpts;
     std::vector<PartChannelSettingsLink> _playbackSettingsLinks;
     Score* _playbackScore = nullptr;
@@ -1370,6 +1435,7 @@ class MasterScore : public Score
 
     QFileInfo _sessionStartBackupInfo;
     QFileInfo info;
+    QString _cachePath;             // of the cache files for the content read, without suffix
 
     bool read(XmlReader&);
     void setPrev(MasterScore* s) { _prev = s; }
@@ -1392,6 +1458,9 @@ public:
     virtual void setPlaylistDirty() override;
     void setPlaylistClean() { _playlistDirty = false; }
 
+    void addPlaybackDirtyRange(const Fraction& tick1, const Fraction& tick2);
+    bool takePlaybackDirtyRange(Fraction& tick1, Fraction& tick2);
+
     void setExpandRepeats(bool expandRepeats);
     void updateRepeatListTempo();
     virtual const RepeatList& repeatList() const override;
@@ -1434,6 +1503,10 @@ public:
     FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
     FileError loadMsc(QString name, bool ignoreVersionError);
     FileError loadMsc(QString name, QIODevice*, bool ignoreVersionError);
+    FileError readScoreFile(QIODevice* dev, bool ignoreVersionError);
+    void setLazyScoreLayouts(int firstPages);
+    void finishScoreLayouts();
+    void layoutFinished();
     FileError read114(XmlReader&);
     FileError read206(XmlReader&);
     FileError read302(XmlReader&);
@@ -1478,6 +1551,7 @@ public:
     void removeExcerpt(Excerpt*);
     void deleteExcerpt(Excerpt*);
     void initExcerpt(Excerpt*);
+    void initExcerpts(const QList<Excerpt*>&);
 
     void setPlaybackScore(Score*);
     Score* playbackScore() { return _playbackScore; }
@@ -11,6 +11,9 @@
 //=============================================================================
 
 #include "scoreElement.h"
+
+#include <atomic>
+
 #include "score.h"
 #include "undo.h"
 #include "xml.h"
@@ -156,6 +159,39 @@ ScoreElement::ScoreElement(const ScoreElement& se)
     _links = 0;
 }
 
+//---------------------------------------------------------
+//   revisionChanged
+//    gives the element and its parents up to the measure
+//    a new revision and rolls it into the content hash of
+//    the measure, for its staff or, for a system element,
+//    for all staves. Called by the undo commands and when
+//    the element is added or removed.
+//---------------------------------------------------------
+
+void ScoreElement::revisionChanged()
+{
+    static std::atomic<quint64> revisions { 0 };
+    const quint64 revision = ++revisions;
+
+    _revision = revision;
+    if (!isElement()) {
+        return;
+    }
+
+    Element* e = toElement(this);
+    for (Element* p = e->parent(); p && !p->isMeasureBase() && !p->isSystem() && !p->isPage(); p = p->parent()) {
+        p->_revision = revision;
+    }
+
+    Measure* m = e->findMeasure();
+    if (!m && e->isSpanner() && score() && score()->firstMeasure()) {
+        m = score()->tick2measure(e->tick());
+    }
+    if (m) {
+        m->staffContentChanged(e->systemFlag() ? -1 : e->staffIdx(), revision);
+    }
+}
+
 //---------------------------------------------------------
 //   ~ScoreElement
 //---------------------------------------------------------
@@ -418,7 +454,7 @@ void ScoreElement::readProperty(XmlReader& e, Pid id)
 
 bool ScoreElement::readProperty(const QStringRef& s, XmlReader& e, Pid id)
 {
-    if (s == propertyName(id)) {
+    if (s == QLatin1String(propertyName(id))) {
         readProperty(e, id);
         return true;
     }
@@ -15,6 +15,7 @@
 
 #include "types.h"
 #include "style.h"
+#include "propertyvalue.h"
 
 namespace Ms {
 class ScoreElement;
@@ -174,6 +175,7 @@ struct ElementName {
 class ScoreElement
 {
     Score* _score;
+    quint64 _revision { 0 };      // changed by revisionChanged(), unique among all elements
     static ElementStyle const emptyStyle;
 
 protected:
@@ -229,6 +231,12 @@ public:
     Score* score() const { return _score; }
     MasterScore* masterScore() const;
     virtual void setScore(Score* s) { _score = s; }
+
+    // for the caches: an element (or one of its children)
+    // is not changed as long as its revision is the same
+    quint64 revision() const { return _revision; }
+    void revisionChanged();
+
     const char* name() const;
     virtual QString userName() const;
     virtual ElementType type() const = 0;
@@ -241,6 +249,9 @@ public:
 
     virtual QVariant getProperty(Pid) const = 0;
     virtual bool setProperty(Pid, const QVariant&) = 0;
+    // as getProperty()/setProperty(), without a QVariant for the values a class keeps typed
+    virtual PropertyValue getPropertyValue(Pid id) const { return getProperty(id); }
+    virtual bool setPropertyValue(Pid id, const PropertyValue& v) { return setProperty(id, v.toVariant()); }
     virtual QVariant propertyDefault(Pid) const;
     virtual void resetProperty(Pid id);
     QVariant propertyDefault(Pid pid, Tid tid) const;
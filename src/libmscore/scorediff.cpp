@@ -24,6 +24,28 @@
 #include <utility>
 
 namespace Ms {
+//---------------------------------------------------------
+//   DiffChunk
+//    a measure of a staff in the MSCX code, or a single
+//    line outside of measures. Chunks are compared by
+//    their hash first, so that the measures two scores
+//    have in common are matched without comparing them
+//    line by line.
+//---------------------------------------------------------
+
+struct DiffChunk {
+    const QStringRef* lines { nullptr };
+    int count { 0 };
+    uint hash { 0 };
+
+    bool operator==(const DiffChunk& c) const
+    {
+        return hash == c.hash && count == c.count && std::equal(lines, lines + count, c.lines);
+    }
+};
+
+typedef std::vector<std::pair<QStringRef, dtl::edit_t> > LineEdits;
+
 //---------------------------------------------------------
 //   MscxModeDiff
 //---------------------------------------------------------
@@ -46,6 +68,9 @@ class MscxModeDiff
     };
 
     static DiffType fromDtlDiffType(dtl::edit_t dtlType);
+    static std::vector<DiffChunk> diffChunks(const std::vector<QStringRef>& lines);
+    static void appendLineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2, LineEdits& edits);
+    static LineEdits lineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2);
 
     void adjustSemanticsMscx(std::vector<TextDiff>&);
     int adjustSemanticsMscxOneDiff(std::vector<TextDiff>& diffs, int index);
@@ -116,34 +141,119 @@ DiffType MscxModeDiff::fromDtlDiffType(dtl::edit_t dtlType)
     return DiffType::EQUAL;
 }
 
+//---------------------------------------------------------
+//   MscxModeDiff::diffChunks
+//---------------------------------------------------------
+
+std::vector<DiffChunk> MscxModeDiff::diffChunks(const std::vector<QStringRef>& lines)
+{
+    std::vector<DiffChunk> chunks;
+    size_t i = 0;
+    while (i < lines.size()) {
+        size_t end = i + 1;
+        const QStringRef line = lines[i].trimmed();
+        if ((line == QLatin1String("<Measure>") || line.startsWith(QLatin1String("<Measure ")))
+            && !line.endsWith(QLatin1String("/>"))) {
+            while (end < lines.size() && lines[end - 1].trimmed() != QLatin1String("</Measure>")) {
+                ++end;
+            }
+        }
+        DiffChunk c;
+        c.lines = &lines[i];
+        c.count = int(end - i);
+        for (size_t k = i; k < end; ++k) {
+            c.hash = c.hash * 31 + qHash(lines[k]);
+        }
+        chunks.push_back(c);
+        i = end;
+    }
+    return chunks;
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::appendLineEdits
+//    line by line diff with the dtl library
+//---------------------------------------------------------
+
+void MscxModeDiff::appendLineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2, LineEdits& edits)
+{
+    if (lines1.empty() || lines2.empty()) {
+        for (const QStringRef& l : lines1) {
+            edits.emplace_back(l, dtl::SES_DELETE);
+        }
+        for (const QStringRef& l : lines2) {
+            edits.emplace_back(l, dtl::SES_ADD);
+        }
+        return;
+    }
+    dtl::Diff<QStringRef, std::vector<QStringRef> > diff(lines1, lines2);
+    diff.compose();
+    for (const auto& ch : diff.getSes().getSequence()) {
+        edits.emplace_back(ch.first, ch.second.type);
+    }
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::lineEdits
+//    Diffs the sequences of chunks first, and then line
+//    by line only the chunks which differ. Scores which
+//    differ in a few measures are compared in time and
+//    memory depending on these measures.
+//---------------------------------------------------------
+
+LineEdits MscxModeDiff::lineEdits(const std::vector<QStringRef>& lines1, const std::vector<QStringRef>& lines2)
+{
+    const std::vector<DiffChunk> chunks1 = diffChunks(lines1);
+    const std::vector<DiffChunk> chunks2 = diffChunks(lines2);
+    dtl::Diff<DiffChunk, std::vector<DiffChunk> > chunkDiff(chunks1, chunks2);
+    chunkDiff.compose();
+
+    LineEdits edits;
+    std::vector<QStringRef> deleted;
+    std::vector<QStringRef> added;
+    for (const auto& ch : chunkDiff.getSes().getSequence()) {
+        const DiffChunk& c = ch.first;
+        switch (ch.second.type) {
+        case dtl::SES_DELETE:
+            deleted.insert(deleted.end(), c.lines, c.lines + c.count);
+            break;
+        case dtl::SES_ADD:
+            added.insert(added.end(), c.lines, c.lines + c.count);
+            break;
+        case dtl::SES_COMMON:
+            appendLineEdits(deleted, added, edits);
+            deleted.clear();
+            added.clear();
+            for (int i = 0; i < c.count; ++i) {
+                edits.emplace_back(c.lines[i], dtl::SES_COMMON);
+            }
+            break;
+        }
+    }
+    appendLineEdits(deleted, added, edits);
+    return edits;
+}
+
 //---------------------------------------------------------
 //   MscxModeDiff::lineModeDiff
 //---------------------------------------------------------
 
 std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QString& s2)
 {
-    // type declarations for dtl library
-    typedef QStringRef elem;
-    typedef std::pair<elem, dtl::elemInfo> sesElem;
-    typedef std::vector<sesElem> sesElemVec;
-
     const QVector<QStringRef> linesVec1 = s1.splitRef('\n');
     std::vector<QStringRef> lines1(linesVec1.begin(), linesVec1.end());
     const QVector<QStringRef> linesVec2 = s2.splitRef('\n');
     std::vector<QStringRef> lines2(linesVec2.begin(), linesVec2.end());
-    dtl::Diff<QStringRef, std::vector<QStringRef> > diff(lines1, lines2);
-
-    diff.compose();
 
-    const sesElemVec changes = diff.getSes().getSequence();
+    const LineEdits changes = lineEdits(lines1, lines2);
     std::vector<TextDiff> diffs;
     int line[2][2] { { 1, 1 }, { 1, 1 } }; // for correct assigning line numbers to
                                            // DELETE and INSERT diffs we need to
                                            // count lines separately for these diff
                                            // types (EQUAL can use both counters).
 
-    for (const sesElem& ch : changes) {
-        DiffType type = fromDtlDiffType(ch.second.type);
+    for (const auto& ch : changes) {
+        DiffType type = fromDtlDiffType(ch.second);
         const int iThis = (type == DiffType::DELETE) ? 0 : 1;     // for EQUAL doesn't matter
 
         if (diffs.empty() || diffs.back().type != type) {
@@ -11,8 +11,11 @@
 //=============================================================================
 
 #include <cmath>
+#include <memory>
 #include <QDir>
 #include <QBuffer>
+#include <QDataStream>
+#include <QSaveFile>
 
 #include "config.h"
 #include "score.h"
@@ -57,6 +60,9 @@
 #include "draw/qpainterprovider.h"
 
 namespace Ms {
+static const quint32 LAYOUT_CACHE_MAGIC = 0x4d534c43;     // "MSLC"
+static const quint32 LAYOUT_CACHE_VERSION = 1;
+
 //---------------------------------------------------------
 //   writeMeasure
 //---------------------------------------------------------
@@ -303,7 +309,7 @@ void Score::readStaff(XmlReader& e)
 
     if (staff == 0) {
         while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const XmlTag& tag(e.name());
 
             if (tag == "Measure") {
                 Measure* measure = nullptr;
@@ -348,7 +354,7 @@ void Score::readStaff(XmlReader& e)
     } else {
         Measure* measure = firstMeasure();
         while (e.readNextStartElement()) {
-            const QStringRef& tag(e.name());
+            const XmlTag& tag(e.name());
 
             if (tag == "Measure") {
                 if (measure == 0) {
@@ -547,6 +553,17 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
 //---------------------------------------------------------
 
 QImage Score::createThumbnail()
+{
+    return MsczSnapshot::renderThumbnail(createThumbnailPicture());
+}
+
+//---------------------------------------------------------
+//   createThumbnailPicture
+//    records the painting of the first page at the
+//    thumbnail size, it is rendered later and by any thread
+//---------------------------------------------------------
+
+QPicture Score::createThumbnailPicture()
 {
     LayoutMode mode = layoutMode();
     setLayoutMode(LayoutMode::PAGE);
@@ -558,29 +575,25 @@ QImage Score::createThumbnail()
     int w      = int(fr.width() * mag);
     int h      = int(fr.height() * mag);
 
-    QImage pm(w, h, QImage::Format_ARGB32_Premultiplied);
-
-    int dpm = lrint(DPMM * 1000.0);
-    pm.setDotsPerMeterX(dpm);
-    pm.setDotsPerMeterY(dpm);
-    pm.fill(0xffffffff);
+    QPicture picture;
 
     double pr = MScore::pixelRatio;
     MScore::pixelRatio = 1.0;
 
-    mu::draw::Painter p(mu::draw::QPainterProvider::make(&pm));
+    mu::draw::Painter p(mu::draw::QPainterProvider::make(&picture));
     p.setAntialiasing(true);
     p.scale(mag, mag);
     print(&p, 0);
     p.end();
 
     MScore::pixelRatio = pr;
+    picture.setBoundingRect(QRect(0, 0, w, h));
 
     if (layoutMode() != mode) {
         setLayoutMode(mode);
         doLayout();
     }
-    return pm;
+    return picture;
 }
 
 //---------------------------------------------------------
@@ -590,7 +603,20 @@ QImage Score::createThumbnail()
 
 bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelection, bool doCreateThumbnail)
 {
-    MQZipWriter uz(f);
+    return createMsczSnapshot(fn, onlySelection, doCreateThumbnail).write(f);
+}
+
+//---------------------------------------------------------
+//   createMsczSnapshot
+//    serializes the score and collects the other files of
+//    the .mscz; the snapshot can be written later and by
+//    another thread
+//---------------------------------------------------------
+
+MsczSnapshot Score::createMsczSnapshot(const QString& fn, bool onlySelection, bool doCreateThumbnail)
+{
+    MsczSnapshot snapshot;
+    snapshot.rootFile = fn;
 
     QBuffer cbuf;
     cbuf.open(QIODevice::ReadWrite);
@@ -610,56 +636,35 @@ bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelecti
 
     xml.etag();
     xml.etag();
-    cbuf.seek(0);
-    //uz.addDirectory("META-INF");
-    uz.addFile("META-INF/container.xml", cbuf.data());
+    snapshot.container = cbuf.data();
 
     QBuffer dbuf;
     dbuf.open(QIODevice::ReadWrite);
     saveFile(&dbuf, true, onlySelection);
-    dbuf.seek(0);
-    uz.addFile(fn, dbuf.data());
+    snapshot.score = dbuf.data();
 
-    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
-    if (fd) { // if is file (may be buffer)
-        fd->flush();     // flush to preserve score data in case of
-    }
-    // any failures on the further operations.
-
-    // save images
-    //uz.addDirectory("Pictures");
+    // images
     for (ImageStoreItem* ip : imageStore) {
         if (!ip->isUsed(this)) {
             continue;
         }
         QString path = QString("Pictures/") + ip->hashName();
-        uz.addFile(path, ip->buffer());
+        snapshot.files.emplace_back(path, ip->buffer());
     }
 
-    // create thumbnail
+    // record thumbnail, it is rendered while the snapshot is written
     if (doCreateThumbnail && !pages().isEmpty()) {
-        QImage pm = createThumbnail();
-
-        QByteArray ba;
-        QBuffer b(&ba);
-        if (!b.open(QIODevice::WriteOnly)) {
-            qDebug("open buffer failed");
-        }
-        if (!pm.save(&b, "PNG")) {
-            qDebug("save failed");
-        }
-        uz.addFile("Thumbnails/thumbnail.png", ba);
+        snapshot.thumbnail = createThumbnailPicture();
     }
 
     //
     // save audio
     //
     if (_audio) {
-        uz.addFile("audio.ogg", _audio->data());
+        snapshot.files.emplace_back("audio.ogg", _audio->data());
     }
 
-    uz.close();
-    return true;
+    return snapshot;
 }
 
 //---------------------------------------------------------
@@ -798,7 +803,7 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
                 continue;
             }
             while (e.readNextStartElement()) {
-                const QStringRef& tag(e.name());
+                const XmlTag& tag(e.name());
 
                 if (tag == "rootfile") {
                     if (rootfile.isEmpty()) {
@@ -832,30 +837,34 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     }
 
     //
-    // load images
+    // load images, the image store keeps a copy of the
+    // images it does not have yet
     //
     if (!MScore::noImages) {
         foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            imageStore.add(s, uz.fileDataView(s));
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
+    //
+    // the root file is parsed while it is inflated
+    //
+    std::unique_ptr<QIODevice> dev(uz.fileDevice(rootfile));
+    if (!dev) {
         QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                dev.reset(uz.fileDevice(fi.filePath));
                 break;
             }
         }
     }
+    if (!dev) {
+        dev.reset(new QBuffer);
+        dev->open(QIODevice::ReadOnly);
+    }
 
-    XmlReader e(dbuf);
-    e.setDocName(masterScore()->fileInfo()->completeBaseName());
-
-    FileError retval = read1(e, ignoreVersionError);
+    FileError retval = readScoreFile(dev.get(), ignoreVersionError);
 
     //
     //  read audio
@@ -926,15 +935,126 @@ Score::FileError MasterScore::loadMsc(QString name, QIODevice* io, bool ignoreVe
 {
     ScoreLoad sl;
     fileInfo()->setFile(name);
+    _cachePath = XmlTokens::cachePath(io);
 
     if (name.endsWith(".mscz") || name.endsWith(".mscz,")) {
         return loadCompressedMsc(io, ignoreVersionError);
     } else {
-        XmlReader r(io);
-        return read1(r, ignoreVersionError);
+        return readScoreFile(io, ignoreVersionError);
+    }
+}
+
+//---------------------------------------------------------
+//   readScoreFile
+//    reads the score file from dev by replaying its
+//    tokens, from the cache or from XmlTokens::parse().
+//    QXmlStreamReader reads the files parse() cannot. A
+//    file that was read without error is added to the
+//    cache.
+//---------------------------------------------------------
+
+Score::FileError MasterScore::readScoreFile(QIODevice* dev, bool ignoreVersionError)
+{
+    const QString docName = masterScore()->fileInfo()->completeBaseName();
+
+    if (std::shared_ptr<const XmlTokens> tokens = XmlTokens::load(_cachePath)) {
+        XmlReader e(tokens, docName);
+        FileError retval = read1(e, ignoreVersionError);
+        if (retval != FileError::FILE_NO_ERROR) {
+            XmlTokens::remove(_cachePath);
+        }
+        return retval;
+    }
+
+    if (std::shared_ptr<const XmlTokens> tokens = XmlTokens::parse(dev)) {
+        XmlReader e(tokens, docName);
+        FileError retval = read1(e, ignoreVersionError);
+        if (retval == FileError::FILE_NO_ERROR && !_cachePath.isEmpty()) {
+            tokens->save(_cachePath);
+        }
+        return retval;
+    }
+
+    XmlReader e(dev, docName);
+    if (!_cachePath.isEmpty()) {
+        e.recordTokens();
+    }
+    FileError retval = read1(e, ignoreVersionError);
+    if (retval == FileError::FILE_NO_ERROR && !_cachePath.isEmpty()) {
+        if (std::shared_ptr<const XmlTokens> tokens = e.recordedTokens()) {
+            tokens->save(_cachePath);
+        }
+    }
+    return retval;
+}
+
+//---------------------------------------------------------
+//   setLazyScoreLayouts
+//    the next complete layout of the score and its parts
+//    only lays out their first pages, see continueLayout().
+//    The page counts of the last layout of the same
+//    content are taken from the cache.
+//---------------------------------------------------------
+
+void MasterScore::setLazyScoreLayouts(int firstPages)
+{
+    QVector<qint32> pageCounts;
+    QFile f(_cachePath + ".layout");
+    if (!_cachePath.isEmpty() && f.open(QIODevice::ReadOnly)) {
+        QDataStream ds(&f);
+        ds.setVersion(QDataStream::Qt_5_9);
+        quint32 magic, version;
+        ds >> magic >> version >> pageCounts;
+        if (ds.status() != QDataStream::Ok || magic != LAYOUT_CACHE_MAGIC || version != LAYOUT_CACHE_VERSION) {
+            pageCounts.clear();
+        }
+    }
+    const QList<Score*> scores = scoreList();
+    for (int i = 0; i < scores.size(); ++i) {
+        scores[i]->setLazyLayout(firstPages, i < pageCounts.size() ? pageCounts[i] : 0);
     }
 }
 
+//---------------------------------------------------------
+//   finishScoreLayouts
+//---------------------------------------------------------
+
+void MasterScore::finishScoreLayouts()
+{
+    for (Score* s : scoreList()) {
+        s->finishLayout();
+    }
+}
+
+//---------------------------------------------------------
+//   layoutFinished
+//    called when a lazy layout is done. Once all of them
+//    are, the page counts are kept for the next time the
+//    same content is read.
+//---------------------------------------------------------
+
+void MasterScore::layoutFinished()
+{
+    if (_cachePath.isEmpty() || !saved()) {
+        return;
+    }
+    QVector<qint32> pageCounts;
+    for (Score* s : scoreList()) {
+        if (s->layoutPending()) {
+            return;
+        }
+        pageCounts.append(s->npages());
+    }
+    QSaveFile f(_cachePath + ".layout");
+    if (f.open(QIODevice::WriteOnly)) {
+        QDataStream ds(&f);
+        ds.setVersion(QDataStream::Qt_5_9);
+        ds << LAYOUT_CACHE_MAGIC << LAYOUT_CACHE_VERSION << pageCounts;
+        f.commit();
+    }
+    _cachePath.clear();
+}
+
 //---------------------------------------------------------
 //   parseVersion
 //---------------------------------------------------------
@@ -1046,10 +1166,8 @@ void Score::print(mu::draw::Painter* painter, int pageNo)
     _printing  = true;
     MScore::pdfPrinting = true;
     Page* page = pages().at(pageNo);
-    QRectF fr  = page->abbox();
 
-    QList<Element*> ell = page->items(fr);
-    std::stable_sort(ell.begin(), ell.end(), elementLessThan);
+    const QList<Element*> ell = page->sortedElements();
     for (const Element* e : qAsConst(ell)) {
         if (!e->visible()) {
             continue;
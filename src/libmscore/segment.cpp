@@ -77,12 +77,13 @@ const char* Segment::subTypeName(SegmentType t)
 
 void Segment::setElement(int track, Element* el)
 {
+    contentChanged();
     if (el) {
         el->setParent(this);
-        _elist[track] = el;
+        _elist.set(track, el);
         setEmpty(false);
     } else {
-        _elist[track] = 0;
+        _elist.reset(track);
         checkEmpty();
     }
 }
@@ -144,19 +145,31 @@ Segment::Segment(const Segment& s)
         add(e->clone());
     }
 
-    _elist.reserve(s._elist.size());
-    for (Element* e : s._elist) {
-        Element* ne = 0;
-        if (e) {
-            ne = e->clone();
+    _elist.assign(s._elist.size());
+    for (int track = 0; track < s._elist.size(); ++track) {
+        if (Element* e = s._elist[track]) {
+            Element* ne = e->clone();
             ne->setParent(this);
+            _elist.set(track, ne);
         }
-        _elist.push_back(ne);
     }
     _dotPosX = s._dotPosX;
     _shapes  = s._shapes;
 }
 
+//---------------------------------------------------------
+//   setRtick
+//---------------------------------------------------------
+
+void Segment::setRtick(const Fraction& v)
+{
+    Q_ASSERT(v >= Fraction(0,1));
+    _tick = v;
+    if (parent() && parent()->isMeasure()) {
+        measure()->segments().invalidateTickIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   setSegmentType
 //---------------------------------------------------------
@@ -206,9 +219,9 @@ void Segment::init()
 {
     int staves = score()->nstaves();
     int tracks = staves * VOICES;
-    _elist.assign(tracks, 0);
+    _elist.assign(tracks);
     _dotPosX.assign(staves, 0.0);
-    _shapes.assign(staves, Shape());
+    _shapes.assign(staves);
 }
 
 //---------------------------------------------------------
@@ -446,8 +459,7 @@ ChordRest* Segment::nextChordRest(int track, bool backwards) const
 
 Element* Segment::element(int track) const
 {
-    int elementsCount = static_cast<int>(_elist.size());
-    if (track < 0 || track >= elementsCount) {
+    if (track < 0 || track >= _elist.size()) {
         return nullptr;
     }
 
@@ -455,46 +467,49 @@ Element* Segment::element(int track) const
 }
 
 //---------------------------------------------------------
-//   insertStaff
+//   insertStaves
+//    insert the staves sStaff to eStaff (excluding), the
+//    slots of the staves after them are moved in one go
 //---------------------------------------------------------
 
-void Segment::insertStaff(int staff)
+void Segment::insertStaves(int sStaff, int eStaff)
 {
-    int track = staff * VOICES;
-    for (int voice = 0; voice < VOICES; ++voice) {
-        _elist.insert(_elist.begin() + track, 0);
-    }
-    _dotPosX.insert(_dotPosX.begin() + staff, 0.0);
-    _shapes.insert(_shapes.begin() + staff, Shape());
+    const int n = eStaff - sStaff;
+    _elist.insert(sStaff * VOICES, n * VOICES);
+    _dotPosX.insert(_dotPosX.begin() + sStaff, n, 0.0);
+    _shapes.insert(sStaff, n);
+    shapeChanged();
 
     for (Element* e : _annotations) {
         int staffIdx = e->staffIdx();
-        if (staffIdx >= staff && !e->systemFlag()) {
-            e->setTrack(e->track() + VOICES);
+        if (staffIdx >= sStaff && !e->systemFlag()) {
+            e->setTrack(e->track() + n * VOICES);
         }
     }
-    fixStaffIdx();
+    fixStaffIdx(eStaff * VOICES);
 }
 
 //---------------------------------------------------------
-//   removeStaff
+//   removeStaves
+//    remove the staves sStaff to eStaff (excluding)
 //---------------------------------------------------------
 
-void Segment::removeStaff(int staff)
+void Segment::removeStaves(int sStaff, int eStaff)
 {
-    int track = staff * VOICES;
-    _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
-    _dotPosX.erase(_dotPosX.begin() + staff);
-    _shapes.erase(_shapes.begin() + staff);
+    const int n = eStaff - sStaff;
+    _elist.erase(sStaff * VOICES, n * VOICES);
+    _dotPosX.erase(_dotPosX.begin() + sStaff, _dotPosX.begin() + eStaff);
+    _shapes.erase(sStaff, n);
+    shapeChanged();
 
     for (Element* e : _annotations) {
         int staffIdx = e->staffIdx();
-        if (staffIdx > staff && !e->systemFlag()) {
-            e->setTrack(e->track() - VOICES);
+        if (staffIdx >= eStaff && !e->systemFlag()) {
+            e->setTrack(e->track() - n * VOICES);
         }
     }
 
-    fixStaffIdx();
+    fixStaffIdx(sStaff * VOICES);
 }
 
 //---------------------------------------------------------
@@ -524,11 +539,12 @@ void Segment::add(Element* el)
 //      qDebug("%p segment %s add(%d, %d, %s)", this, subTypeName(), tick(), el->track(), el->name());
 
     el->setParent(this);
+    contentChanged();
 
     int track = el->track();
     Q_ASSERT(track != -1);
     Q_ASSERT(el->score() == score());
-    Q_ASSERT(score()->nstaves() * VOICES == int(_elist.size()));
+    Q_ASSERT(score()->nstaves() * VOICES == _elist.size());
     // make sure offset is correct for staff
     if (el->isStyled(Pid::OFFSET)) {
         el->setOffset(el->propertyDefault(Pid::OFFSET).toPointF());
@@ -536,7 +552,7 @@ void Segment::add(Element* el)
 
     switch (el->type()) {
     case ElementType::MEASURE_REPEAT:
-        _elist[track] = el;
+        _elist.set(track, el);
         setEmpty(false);
         break;
 
@@ -579,7 +595,7 @@ void Segment::add(Element* el)
     case ElementType::CLEF:
         Q_ASSERT(_segmentType == SegmentType::Clef || _segmentType == SegmentType::HeaderClef);
         checkElement(el, track);
-        _elist[track] = el;
+        _elist.set(track, el);
         if (!el->generated()) {
             el->staff()->setClef(toClef(el));
 //                        updateNoteLines(this, el->track());   TODO::necessary?
@@ -590,7 +606,7 @@ void Segment::add(Element* el)
     case ElementType::TIMESIG:
         Q_ASSERT(segmentType() == SegmentType::TimeSig || segmentType() == SegmentType::TimeSigAnnounce);
         checkElement(el, track);
-        _elist[track] = el;
+        _elist.set(track, el);
         el->staff()->addTimeSig(toTimeSig(el));
         setEmpty(false);
         break;
@@ -598,7 +614,7 @@ void Segment::add(Element* el)
     case ElementType::KEYSIG:
         Q_ASSERT(_segmentType == SegmentType::KeySig || _segmentType == SegmentType::KeySigAnnounce);
         checkElement(el, track);
-        _elist[track] = el;
+        _elist.set(track, el);
         if (!el->generated()) {
             el->staff()->setKey(tick(), toKeySig(el)->keySigEvent());
         }
@@ -643,7 +659,7 @@ void Segment::add(Element* el)
     case ElementType::BREATH:
         if (track < score()->nstaves() * VOICES) {
             checkElement(el, track);
-            _elist[track] = el;
+            _elist.set(track, el);
         }
         setEmpty(false);
         break;
@@ -651,7 +667,7 @@ void Segment::add(Element* el)
     case ElementType::AMBITUS:
         Q_ASSERT(_segmentType == SegmentType::Ambitus);
         checkElement(el, track);
-        _elist[track] = el;
+        _elist.set(track, el);
         setEmpty(false);
         break;
 
@@ -668,13 +684,14 @@ void Segment::remove(Element* el)
 {
 // qDebug("%p Segment::remove %s %p", this, el->name(), el);
 
+    contentChanged();
     int track = el->track();
 
     switch (el->type()) {
     case ElementType::CHORD:
     case ElementType::REST:
     {
-        _elist[track] = 0;
+        _elist.reset(track);
         int staffIdx = el->staffIdx();
         measure()->checkMultiVoices(staffIdx);
         // spanners with this cr as start or end element will need relayout
@@ -700,7 +717,7 @@ void Segment::remove(Element* el)
 
     case ElementType::MMREST:
     case ElementType::MEASURE_REPEAT:
-        _elist[track] = 0;
+        _elist.reset(track);
         break;
 
     case ElementType::DYNAMIC:
@@ -740,14 +757,14 @@ void Segment::remove(Element* el)
         break;
 
     case ElementType::TIMESIG:
-        _elist[track] = 0;
+        _elist.reset(track);
         el->staff()->removeTimeSig(toTimeSig(el));
         break;
 
     case ElementType::KEYSIG:
         Q_ASSERT(_elist[track] == el);
 
-        _elist[track] = 0;
+        _elist.reset(track);
         if (!el->generated()) {
             el->staff()->removeKey(tick());
         }
@@ -760,11 +777,11 @@ void Segment::remove(Element* el)
 
     case ElementType::BAR_LINE:
     case ElementType::AMBITUS:
-        _elist[track] = 0;
+        _elist.reset(track);
         break;
 
     case ElementType::BREATH:
-        _elist[track] = 0;
+        _elist.reset(track);
         score()->setPause(tick(), 0);
         break;
 
@@ -812,14 +829,13 @@ SegmentType Segment::segmentType(ElementType type)
 
 void Segment::sortStaves(QList<int>& dst)
 {
-    std::vector<Element*> dl;
-    dl.reserve(dst.size());
+    SparseArray<Element*> dl;
+    dl.assign(dst.size() * VOICES);
 
     for (int i = 0; i < dst.size(); ++i) {
         int startTrack = dst[i] * VOICES;
-        int endTrack   = startTrack + VOICES;
-        for (int k = startTrack; k < endTrack; ++k) {
-            dl.push_back(_elist[k]);
+        for (int voice = 0; voice < VOICES; ++voice) {
+            dl.set(i * VOICES + voice, _elist[startTrack + voice]);
         }
     }
     std::swap(_elist, dl);
@@ -837,16 +853,14 @@ void Segment::sortStaves(QList<int>& dst)
 
 //---------------------------------------------------------
 //   fixStaffIdx
+//    set the track of the elements from strack on to
+//    their slot
 //---------------------------------------------------------
 
-void Segment::fixStaffIdx()
+void Segment::fixStaffIdx(int strack)
 {
-    int track = 0;
-    for (Element* e : _elist) {
-        if (e) {
-            e->setTrack(track);
-        }
-        ++track;
+    for (int track = _elist.next(strack); track < _elist.size(); track = _elist.next(track + 1)) {
+        _elist[track]->setTrack(track);
     }
 }
 
@@ -875,7 +889,7 @@ void Segment::checkEmpty() const
 
 void Segment::swapElements(int i1, int i2)
 {
-    std::iter_swap(_elist.begin() + i1, _elist.begin() + i2);
+    _elist.swap(i1, i2);
     if (_elist[i1]) {
         _elist[i1]->setTrack(i1);
     }
@@ -910,7 +924,7 @@ void Segment::write(XmlWriter& xml) const
 void Segment::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "subtype") {
             e.skipCurrentElement();
@@ -1217,7 +1231,7 @@ void Segment::clearAnnotations()
 
 Ms::Element* Segment::elementAt(int track) const
 {
-    Element* e = track < int(_elist.size()) ? _elist[track] : 0;
+    Element* e = track < _elist.size() ? _elist[track] : 0;
     return e;
 }
 
@@ -1603,24 +1617,16 @@ Element* Segment::prevElementOfSegment(Segment* s, Element* e, int activeStaff)
 
 Element* Segment::lastElementOfSegment(Segment* s, int activeStaff)
 {
-    std::vector<Element*> elements = s->elist();
-    for (auto i = --elements.end(); i != elements.begin(); --i) {
-        if (*i && (*i)->staffIdx() == activeStaff) {
-            if ((*i)->isChord()) {
-                return toChord(*i)->notes().front();
+    for (int track = s->elist().size() - 1; track >= 0; --track) {
+        Element* e = s->element(track);
+        if (e && e->staffIdx() == activeStaff) {
+            if (e->isChord()) {
+                return toChord(e)->notes().front();
             } else {
-                return *i;
+                return e;
             }
         }
     }
-    auto i = elements.begin();
-    if (*i && (*i)->staffIdx() == activeStaff) {
-        if ((*i)->type() == ElementType::CHORD) {
-            return toChord(*i)->notes().front();
-        } else {
-            return *i;
-        }
-    }
     return nullptr;
 }
 
@@ -2183,14 +2189,41 @@ void Segment::createShapes()
     }
 }
 
+//---------------------------------------------------------
+//   shapeChanged
+//    the measure has to compute its minimum width again
+//---------------------------------------------------------
+
+void Segment::shapeChanged()
+{
+    if (Measure* m = measure()) {
+        m->invalidateMinWidth();
+    }
+}
+
+//---------------------------------------------------------
+//   contentChanged
+//    the measure has to find its empty staves again and
+//    its multimeasure rest has to be updated
+//---------------------------------------------------------
+
+void Segment::contentChanged()
+{
+    if (Measure* m = measure()) {
+        m->contentChanged();
+    }
+}
+
 //---------------------------------------------------------
 //   createShape
 //---------------------------------------------------------
 
 void Segment::createShape(int staffIdx)
 {
-    Shape& s = _shapes[staffIdx];
-    s.clear();
+    shapeChanged();
+
+    // built aside, computing the shapes of the elements may look at the other staves
+    Shape s;
 
     if (segmentType() & (SegmentType::BarLine | SegmentType::EndBarLine | SegmentType::StartRepeatBarLine | SegmentType::BeginBarLine)) {
         setVisible(true);
@@ -2205,18 +2238,20 @@ void Segment::createShape(int staffIdx)
         }
         s.addHorizontalSpacing(Shape::SPACING_GENERAL, 0, 0);
         s.addHorizontalSpacing(Shape::SPACING_LYRICS, 0, 0);
+        _shapes.set(staffIdx, std::move(s));
         return;
     }
 #if 0
     for (int track = staffIdx * VOICES; track < (staffIdx + 1) * VOICES; ++track) {
         Element* e = _elist[track];
         if (e) {
-            s.add(e->shape().translated(e->pos()));
+            s.add(e->shape(), e->pos());
         }
     }
 #endif
 
     if (!score()->staff(staffIdx)->show()) {
+        _shapes.reset(staffIdx);
         return;
     }
 
@@ -2230,7 +2265,7 @@ void Segment::createShape(int staffIdx)
         if (effectiveTrack >= strack && effectiveTrack < etrack) {
             setVisible(true);
             if (e->addToSkyline() && !e->isMeasureRepeat()) {
-                s.add(e->shape().translated(e->pos()));
+                s.add(e->shape(), e->pos());
             }
         }
     }
@@ -2266,9 +2301,11 @@ void Segment::createShape(int staffIdx)
                    && !e->isStaffText()) {
             // annotations added here are candidates for collision detection
             // lyrics, ...
-            s.add(e->shape().translated(e->pos()));
+            s.add(e->shape(), e->pos());
         }
     }
+
+    _shapes.set(staffIdx, std::move(s));
 }
 
 //---------------------------------------------------------
@@ -2326,8 +2363,8 @@ qreal Segment::minLeft() const
 qreal Segment::minHorizontalCollidingDistance(Segment* ns) const
 {
     qreal w = 0.0;
-    for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-        qreal d = staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx));
+    for (int staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
+        qreal d = staffShape(staffIdx).minHorizontalDistance(ns->shapes()[staffIdx]);
         w       = qMax(w, d);
     }
     return w;
@@ -2391,8 +2428,8 @@ qreal Segment::elementsBottomOffsetFromSkyline(int staffIndex) const
 qreal Segment::minHorizontalDistance(Segment* ns, bool systemHeaderGap) const
 {
     qreal ww = -1000000.0;          // can remain negative
-    for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-        qreal d = ns ? staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx)) : 0.0;
+    for (int staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
+        qreal d = ns ? staffShape(staffIdx).minHorizontalDistance(ns->shapes()[staffIdx]) : 0.0;
         // first chordrest of a staff should clear the widest header for any staff
         // so make sure segment is as wide as it needs to be
         if (systemHeaderGap) {
@@ -16,6 +16,8 @@
 #include "element.h"
 #include "shape.h"
 #include "mscore.h"
+#include "elementpool.h"
+#include "sparsearray.h"
 
 namespace Ms {
 class Measure;
@@ -48,6 +50,8 @@ class System;
 
 class Segment final : public Element
 {
+    ELEMENT_POOL_ALLOCATION
+
     SegmentType _segmentType { SegmentType::Invalid };
     Fraction _tick;    // { Fraction(0, 1) };
     Fraction _ticks;   // { Fraction(0, 1) };
@@ -58,8 +62,8 @@ class Segment final : public Element
     Segment* _prev = nullptr;
 
     std::vector<Element*> _annotations;
-    std::vector<Element*> _elist;         // Element storage, size = staves * VOICES.
-    std::vector<Shape> _shapes;           // size = staves
+    SparseArray<Element*> _elist;         // Element storage, size = staves * VOICES.
+    SparseArray<Shape> _shapes;           // size = staves, only the staves with a shape are set
     std::vector<qreal> _dotPosX;          // size = staves
 
     void init();
@@ -124,8 +128,7 @@ public:
     //@ returns the element at track 'track' (null if none)
     Ms::Element* elementAt(int track) const;
 
-    const std::vector<Element*>& elist() const { return _elist; }
-    std::vector<Element*>& elist() { return _elist; }
+    const SparseArray<Element*>& elist() const { return _elist; }
 
     void removeElement(int track);
     void setElement(int track, Element* el);
@@ -138,8 +141,8 @@ public:
 
     QRectF contentRect() const;
 
-    void insertStaff(int staff);
-    void removeStaff(int staff);
+    void insertStaves(int sStaff, int eStaff);
+    void removeStaves(int sStaff, int eStaff);
 
     void add(Element*) override;
     void remove(Element*) override;
@@ -158,13 +161,13 @@ public:
     bool written() const { return flag(ElementFlag::WRITTEN); }
     void setWritten(bool val) const { setFlag(ElementFlag::WRITTEN, val); }
 
-    void fixStaffIdx();
+    void fixStaffIdx(int strack = 0);
 
     qreal stretch() const { return _stretch; }
     void setStretch(qreal v) { _stretch = v; }
 
     Fraction rtick() const override { return _tick; }
-    void setRtick(const Fraction& v) { Q_ASSERT(v >= Fraction(0,1)); _tick = v; }
+    void setRtick(const Fraction& v);
     Fraction tick() const override;
 
     Fraction ticks() const { return _ticks; }
@@ -223,12 +226,13 @@ public:
     using Element::prevElement;
     Element* prevElement(int activeStaff);
 
-    std::vector<Shape> shapes() { return _shapes; }
-    const std::vector<Shape>& shapes() const { return _shapes; }
+    const SparseArray<Shape>& shapes() const { return _shapes; }
     const Shape& staffShape(int staffIdx) const { return _shapes[staffIdx]; }
-    Shape& staffShape(int staffIdx) { return _shapes[staffIdx]; }
+    Shape& staffShape(int staffIdx) { shapeChanged(); return _shapes.slot(staffIdx); }
     void createShapes();
     void createShape(int staffIdx);
+    void shapeChanged();
+    void contentChanged();
     qreal minRight() const;
     qreal minLeft(const Shape&) const;
     qreal minLeft() const;
@@ -116,6 +116,7 @@ void SegmentList::insert(Segment* e, Segment* el)
         el->prev()->setNext(e);
         el->setPrev(e);
     }
+    _tickIndex.invalidate();
     check();
 }
 
@@ -156,6 +157,7 @@ void SegmentList::remove(Segment* e)
         e->prev()->setNext(e->next());
         e->next()->setPrev(e->prev());
     }
+    _tickIndex.invalidate();
 }
 
 //---------------------------------------------------------
@@ -173,6 +175,7 @@ void SegmentList::push_back(Segment* e)
     }
     e->setPrev(_last);
     _last = e;
+    _tickIndex.invalidate();
     check();
 }
 
@@ -191,6 +194,7 @@ void SegmentList::push_front(Segment* e)
     }
     e->setNext(_first);
     _first = e;
+    _tickIndex.invalidate();
     check();
 }
 
@@ -244,4 +248,41 @@ Segment* SegmentList::last(ElementFlag flags) const
     }
     return nullptr;
 }
+
+//---------------------------------------------------------
+//   firstAt
+//    the first segment at or after the measure relative
+//    position rtick
+//---------------------------------------------------------
+
+Segment* SegmentList::firstAt(const Fraction& rtick) const
+{
+    const std::vector<Segment*>* index = _tickIndex.items([this](std::vector<Segment*>& items) {
+        items.reserve(_size);
+        for (Segment* s = _first; s; s = s->next()) {
+            items.push_back(s);
+        }
+    }, [](const Segment* s) { return s->rtick(); });
+
+    Segment* segment = nullptr;
+    if (index) {
+        auto i = std::lower_bound(index->begin(), index->end(), rtick, [](const Segment* s, const Fraction& t) {
+            return s->rtick() < t;
+        });
+        segment = i != index->end() ? *i : nullptr;
+    } else {
+        for (segment = _first; segment && segment->rtick() < rtick; segment = segment->next()) {
+        }
+    }
+#ifndef NDEBUG
+    if (MScore::debugMode && index) {
+        Segment* s = _first;
+        while (s && s->rtick() < rtick) {
+            s = s->next();
+        }
+        Q_ASSERT(s == segment);
+    }
+#endif
+    return segment;
+}
 }
@@ -14,6 +14,7 @@
 #define __SEGMENTLIST_H__
 
 #include "segment.h"
+#include "tickindex.h"
 
 namespace Ms {
 class Segment;
@@ -27,10 +28,11 @@ class SegmentList
     Segment* _first;          ///< First item of segment list
     Segment* _last;           ///< Last item of segment list
     int _size;                ///< Number of items in segment list
+    TickIndex<Segment> _tickIndex;
 
 public:
     SegmentList() { clear(); }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; _tickIndex.invalidate(); }
 #ifndef NDEBUG
     void check();
 #else
@@ -46,6 +48,8 @@ public:
     Segment* last() const { return _last; }
     Segment* last(ElementFlag) const;
     Segment* firstCRSegment() const;
+    Segment* firstAt(const Fraction& rtick) const;
+    void invalidateTickIndex() { _tickIndex.invalidate(); }
     void remove(Segment*);
     void push_back(Segment*);
     void push_front(Segment*);
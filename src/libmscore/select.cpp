@@ -15,6 +15,8 @@
  Implementation of class Selection plus other selection related functions.
 */
 
+#include <algorithm>
+
 #include <QBuffer>
 
 #include "log.h"
@@ -387,6 +389,19 @@ void Selection::remove(Element* el)
     }
 }
 
+void Selection::remove(const QList<Element*>& elements)
+{
+    if (elements.empty()) {
+        return;
+    }
+    const QSet<Element*> removed(elements.begin(), elements.end());
+    _el.erase(std::remove_if(_el.begin(), _el.end(), [&removed](Element* e) { return removed.contains(e); }), _el.end());
+    for (Element* e : elements) {
+        e->setSelected(false);
+    }
+    updateState();
+}
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -401,6 +416,25 @@ void Selection::add(Element* el)
     update();
 }
 
+//---------------------------------------------------------
+//   add
+//    elements which are not selected yet; only they are
+//    marked selected
+//---------------------------------------------------------
+
+void Selection::add(const QList<Element*>& elements)
+{
+    IF_ASSERT_FAILED(!isLocked()) {
+        LOGE() << "selection locked, reason: " << lockReason();
+        return;
+    }
+    for (Element* e : elements) {
+        _el.append(e);
+        e->setSelected(true);
+    }
+    updateState();
+}
+
 //---------------------------------------------------------
 //   canSelect
 //   see also `static const char* labels[]` in selectionwindow.cpp
@@ -507,13 +541,14 @@ void Selection::appendFiltered(Element* e)
 //   appendChord
 //---------------------------------------------------------
 
-void Selection::appendChord(Chord* chord)
+void Selection::appendChord(Chord* chord, QSet<const Element*>& beams)
 {
     IF_ASSERT_FAILED(!isLocked()) {
         LOGE() << "selection locked, reason: " << lockReason();
         return;
     }
-    if (chord->beam() && !_el.contains(chord->beam())) {
+    if (chord->beam() && !beams.contains(chord->beam())) {
+        beams.insert(chord->beam());
         _el.append(chord->beam());
     }
     if (chord->stem()) {
@@ -619,6 +654,8 @@ void Selection::updateSelectedElements()
     int startTrack = _staffStart * VOICES;
     int endTrack   = _staffEnd * VOICES;
 
+    QSet<const Element*> beams;     // the beams already selected, shared by their chords
+
     for (int st = startTrack; st < endTrack; ++st) {
         if (!canSelectVoice(st)) {
             continue;
@@ -649,10 +686,10 @@ void Selection::updateSelectedElements()
                 Chord* chord = toChord(e);
                 for (Chord* graceNote : chord->graceNotes()) {
                     if (canSelect(graceNote)) {
-                        appendChord(graceNote);
+                        appendChord(graceNote, beams);
                     }
                 }
-                appendChord(chord);
+                appendChord(chord, beams);
                 for (Articulation* art : chord->articulations()) {
                     appendFiltered(art);
                 }
@@ -850,37 +887,29 @@ QByteArray Selection::mimeData() const
 }
 
 //---------------------------------------------------------
-//   hasElementInTrack
+//   firstElementTicks
+//    the tick of the first element of each voice of a
+//    staff in one pass over the segments, -1 for a voice
+//    without elements
 //---------------------------------------------------------
 
-bool hasElementInTrack(Segment* startSeg, Segment* endSeg, int track)
+static void firstElementTicks(Segment* startSeg, Segment* endSeg, int startTrack, Fraction ticks[VOICES])
 {
-    for (Segment* seg = startSeg; seg != endSeg; seg = seg->next1MM()) {
-        if (!seg->enabled()) {
-            continue;
-        }
-        if (seg->element(track)) {
-            return true;
-        }
+    int missing = VOICES;
+    for (int voice = 0; voice < VOICES; ++voice) {
+        ticks[voice] = Fraction(-1, 1);
     }
-    return false;
-}
-
-//---------------------------------------------------------
-//   firstElementInTrack
-//---------------------------------------------------------
-
-static Fraction firstElementInTrack(Segment* startSeg, Segment* endSeg, int track)
-{
-    for (Segment* seg = startSeg; seg != endSeg; seg = seg->next1MM()) {
+    for (Segment* seg = startSeg; seg != endSeg && missing; seg = seg->next1MM()) {
         if (!seg->enabled()) {
             continue;
         }
-        if (seg->element(track)) {
-            return seg->tick();
+        for (int voice = 0; voice < VOICES; ++voice) {
+            if (ticks[voice] == Fraction(-1, 1) && seg->element(startTrack + voice)) {
+                ticks[voice] = seg->tick();
+                --missing;
+            }
         }
     }
-    return Fraction(-1,1);
 }
 
 //---------------------------------------------------------
@@ -927,10 +956,11 @@ QByteArray Selection::staffMimeData() const
             xml.tag("transposeDiatonic", interval.diatonic);
         }
         xml.stag("voiceOffset");
+        Fraction firstTicks[VOICES];
+        firstElementTicks(seg1, seg2, startTrack, firstTicks);
         for (int voice = 0; voice < VOICES; voice++) {
-            if (hasElementInTrack(seg1, seg2, startTrack + voice)
-                && xml.canWriteVoice(voice)) {
-                Fraction offset = firstElementInTrack(seg1, seg2, startTrack + voice) - tickStart();
+            if (firstTicks[voice] != Fraction(-1, 1) && xml.canWriteVoice(voice)) {
+                Fraction offset = firstTicks[voice] - tickStart();
                 xml.tag(QString("voice id=\"%1\"").arg(voice), offset.ticks());
             }
         }
@@ -1395,17 +1425,18 @@ bool Selection::measureRange(Measure** m1, Measure** m2) const
 const QList<Element*> Selection::uniqueElements() const
 {
     QList<Element*> l;
+    QSet<const ScoreElement*> found;      // the elements in l and the elements linked to them
 
     for (Element* e : elements()) {
-        bool alreadyThere = false;
-        for (Element* ee : l) {
-            if ((ee->links() && ee->links()->contains(e)) || e == ee) {
-                alreadyThere = true;
-                break;
-            }
+        if (found.contains(e)) {
+            continue;
         }
-        if (!alreadyThere) {
-            l.append(e);
+        l.append(e);
+        found.insert(e);
+        if (e->links()) {
+            for (const ScoreElement* linked : *e->links()) {
+                found.insert(linked);
+            }
         }
     }
     return l;
@@ -1421,18 +1452,19 @@ const QList<Element*> Selection::uniqueElements() const
 QList<Note*> Selection::uniqueNotes(int track) const
 {
     QList<Note*> l;
+    QSet<const ScoreElement*> found;      // the notes in l and the notes linked to them
 
     for (Note* nn : noteList(track)) {
         for (Note* note : nn->tiedNotes()) {
-            bool alreadyThere = false;
-            for (Note* n : l) {
-                if ((n->links() && n->links()->contains(note)) || n == note) {
-                    alreadyThere = true;
-                    break;
-                }
+            if (found.contains(note)) {
+                continue;
             }
-            if (!alreadyThere) {
-                l.append(note);
+            l.append(note);
+            found.insert(note);
+            if (note->links()) {
+                for (const ScoreElement* linked : *note->links()) {
+                    found.insert(linked);
+                }
             }
         }
     }
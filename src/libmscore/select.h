@@ -13,6 +13,8 @@
 #ifndef __SELECT_H__
 #define __SELECT_H__
 
+#include <QSet>
+
 #include "pitchspelling.h"
 #include "mscore.h"
 #include "durationtype.h"
@@ -169,7 +171,7 @@ class Selection
     bool canSelect(Element* e) const { return selectionFilter().canSelect(e); }
     bool canSelectVoice(int track) const { return selectionFilter().canSelectVoice(track); }
     void appendFiltered(Element* e);
-    void appendChord(Chord* chord);
+    void appendChord(Chord* chord, QSet<const Element*>& beams);
 
 public:
     Selection() { _score = 0; _state = SelState::NONE; }
@@ -196,8 +198,10 @@ public:
     bool isSingle() const { return (_state == SelState::LIST) && (_el.size() == 1); }
 
     void add(Element*);
+    void add(const QList<Element*>&);
     void deselectAll();
     void remove(Element*);
+    void remove(const QList<Element*>&);
     void clear();
     Element* element() const;
     ChordRest* cr() const;
@@ -13,6 +13,10 @@
 #include "shape.h"
 #include "segment.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace Ms {
 //---------------------------------------------------------
 //   addHorizontalSpacing
@@ -65,6 +69,7 @@ void Shape::translateY(qreal yo)
 Shape Shape::translated(const QPointF& pt) const
 {
     Shape s;
+    s.reserve(size());
     for (const ShapeElement& r : *this)
 #ifndef NDEBUG
     {
@@ -78,6 +83,146 @@ Shape Shape::translated(const QPointF& pt) const
     return s;
 }
 
+//---------------------------------------------------------
+//   add
+//---------------------------------------------------------
+
+void Shape::add(const Shape& s, const QPointF& pt)
+{
+    for (const ShapeElement& r : s)
+#ifndef NDEBUG
+    {
+        push_back(ShapeElement(r.translated(pt), r.text));
+    }
+#else
+    {
+        push_back(r.translated(pt));
+    }
+#endif
+}
+
+//---------------------------------------------------------
+//   ShapeColumns
+//    the values of the rectangles of a shape in separate
+//    arrays, so that a rectangle of the other shape is
+//    compared to two of them at a time. The buffer is kept
+//    per thread as the layout of staves runs in parallel.
+//---------------------------------------------------------
+
+class ShapeColumns
+{
+    std::vector<qreal>& _buffer;
+    size_t _n;
+
+    static std::vector<qreal>& buffer()
+    {
+        thread_local std::vector<qreal> b;
+        return b;
+    }
+
+public:
+    enum Column {
+        LEFT, RIGHT, TOP, BOTTOM, WIDTH, HEIGHT, COLUMNS
+    };
+
+    ShapeColumns(const Shape& s)
+        : _buffer(buffer()), _n(s.size())
+    {
+        _buffer.resize(_n * COLUMNS);
+        for (size_t i = 0; i < _n; ++i) {
+            const QRectF& r = s[i];
+            _buffer[LEFT * _n + i]   = r.left();
+            _buffer[RIGHT * _n + i]  = r.right();
+            _buffer[TOP * _n + i]    = r.top();
+            _buffer[BOTTOM * _n + i] = r.bottom();
+            _buffer[WIDTH * _n + i]  = r.width();
+            _buffer[HEIGHT * _n + i] = r.height();
+        }
+    }
+
+    size_t size() const { return _n; }
+    const qreal* operator[](Column c) const { return _buffer.data() + c * _n; }
+};
+
+#if defined(__SSE2__)
+//---------------------------------------------------------
+//   select
+//    mask ? a : b
+//---------------------------------------------------------
+
+static inline __m128d select(__m128d mask, __m128d a, __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+static inline __m128d maskOf(bool v)
+{
+    return _mm_castsi128_pd(_mm_set1_epi32(v ? -1 : 0));
+}
+
+static inline qreal horizontalMax(__m128d v)
+{
+    return qMax(_mm_cvtsd_f64(v), _mm_cvtsd_f64(_mm_unpackhi_pd(v, v)));
+}
+#endif
+
+//---------------------------------------------------------
+//   horizontalDistance
+//    minHorizontalDistance() of the rectangles c to r2
+//---------------------------------------------------------
+
+static qreal horizontalDistance(const ShapeColumns& c, const QRectF& r2, qreal dist)
+{
+    const qreal by1    = r2.top();
+    const qreal by2    = r2.bottom();
+    const qreal bl     = r2.left();
+    const bool flat2   = r2.height() == 0.0;
+    const bool thin2   = r2.width() == 0.0;
+    const bool empty2  = by1 == by2;
+    const qreal* right  = c[ShapeColumns::RIGHT];
+    const qreal* top    = c[ShapeColumns::TOP];
+    const qreal* bottom = c[ShapeColumns::BOTTOM];
+    const qreal* width  = c[ShapeColumns::WIDTH];
+    const qreal* height = c[ShapeColumns::HEIGHT];
+    const size_t n = c.size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (n >= 2) {
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d vby1 = _mm_set1_pd(by1);
+        const __m128d vby2 = _mm_set1_pd(by2);
+        const __m128d vbl  = _mm_set1_pd(bl);
+        const __m128d vflat2  = maskOf(flat2);
+        const __m128d vthin2  = maskOf(thin2);
+        const __m128d vspan2  = maskOf(!empty2);
+        __m128d vdist = _mm_set1_pd(dist);
+        for (; i + 2 <= n; i += 2) {
+            const __m128d t = _mm_loadu_pd(top + i);
+            const __m128d b = _mm_loadu_pd(bottom + i);
+            const __m128d overlap = _mm_and_pd(_mm_and_pd(_mm_cmpneq_pd(t, b), vspan2),
+                                               _mm_and_pd(_mm_cmpgt_pd(b, vby1), _mm_cmplt_pd(t, vby2)));
+            const __m128d flat = _mm_and_pd(vflat2,
+                                            _mm_and_pd(_mm_cmpeq_pd(_mm_loadu_pd(height + i), zero), _mm_cmpeq_pd(t, vby1)));
+            const __m128d thin = _mm_or_pd(vthin2, _mm_cmpeq_pd(_mm_loadu_pd(width + i), zero));
+            const __m128d hit  = _mm_or_pd(_mm_or_pd(overlap, flat), thin);
+            const __m128d d    = _mm_sub_pd(_mm_loadu_pd(right + i), vbl);
+            vdist = _mm_max_pd(vdist, select(hit, d, vdist));
+        }
+        dist = horizontalMax(vdist);
+    }
+#endif
+    for (; i < n; ++i) {
+        const qreal ay1 = top[i];
+        const qreal ay2 = bottom[i];
+        if (Ms::intersects(ay1, ay2, by1, by2)
+            || ((height[i] == 0.0) && flat2 && (ay1 == by1))
+            || ((width[i] == 0.0) || thin2)) {
+            dist = qMax(dist, right[i] - bl);
+        }
+    }
+    return dist;
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
@@ -88,17 +233,56 @@ Shape Shape::translated(const QPointF& pt) const
 qreal Shape::minHorizontalDistance(const Shape& a) const
 {
     qreal dist = -1000000.0;        // min real
+    if (empty()) {
+        return dist;
+    }
+    const ShapeColumns c(*this);
     for (const QRectF& r2 : a) {
-        qreal by1 = r2.top();
-        qreal by2 = r2.bottom();
-        for (const QRectF& r1 : *this) {
-            qreal ay1 = r1.top();
-            qreal ay2 = r1.bottom();
-            if (Ms::intersects(ay1, ay2, by1, by2)
-                || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
-                || ((r1.width() == 0.0) || (r2.width() == 0.0))) {
-                dist = qMax(dist, r1.right() - r2.left());
-            }
+        dist = horizontalDistance(c, r2, dist);
+    }
+    return dist;
+}
+
+//---------------------------------------------------------
+//   verticalDistance
+//    minVerticalDistance() of the rectangles c to r2
+//---------------------------------------------------------
+
+static qreal verticalDistance(const ShapeColumns& c, const QRectF& r2, qreal dist)
+{
+    const qreal bx1 = r2.left();
+    const qreal bx2 = r2.right();
+    const qreal bt  = r2.top();
+    if (bx1 == bx2) {       // intersects nothing
+        return dist;
+    }
+    const qreal* left   = c[ShapeColumns::LEFT];
+    const qreal* right  = c[ShapeColumns::RIGHT];
+    const qreal* bottom = c[ShapeColumns::BOTTOM];
+    const qreal* height = c[ShapeColumns::HEIGHT];
+    const size_t n = c.size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (n >= 2) {
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d vbx1 = _mm_set1_pd(bx1);
+        const __m128d vbx2 = _mm_set1_pd(bx2);
+        const __m128d vbt  = _mm_set1_pd(bt);
+        __m128d vdist = _mm_set1_pd(dist);
+        for (; i + 2 <= n; i += 2) {
+            const __m128d l = _mm_loadu_pd(left + i);
+            const __m128d r = _mm_loadu_pd(right + i);
+            const __m128d hit = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(_mm_loadu_pd(height + i), zero), _mm_cmpneq_pd(l, r)),
+                                           _mm_and_pd(_mm_cmpgt_pd(r, vbx1), _mm_cmplt_pd(l, vbx2)));
+            const __m128d d   = _mm_sub_pd(_mm_loadu_pd(bottom + i), vbt);
+            vdist = _mm_max_pd(vdist, select(hit, d, vdist));
+        }
+        dist = horizontalMax(vdist);
+    }
+#endif
+    for (; i < n; ++i) {
+        if (height[i] > 0.0 && Ms::intersects(left[i], right[i], bx1, bx2)) {
+            dist = qMax(dist, bottom[i] - bt);
         }
     }
     return dist;
@@ -113,22 +297,15 @@ qreal Shape::minHorizontalDistance(const Shape& a) const
 qreal Shape::minVerticalDistance(const Shape& a) const
 {
     qreal dist = -1000000.0;        // min real
+    if (empty()) {
+        return dist;
+    }
+    const ShapeColumns c(*this);
     for (const QRectF& r2 : a) {
         if (r2.height() <= 0.0) {
             continue;
         }
-        qreal bx1 = r2.left();
-        qreal bx2 = r2.right();
-        for (const QRectF& r1 : *this) {
-            if (r1.height() <= 0.0) {
-                continue;
-            }
-            qreal ax1 = r1.left();
-            qreal ax2 = r1.right();
-            if (Ms::intersects(ax1, ax2, bx1, bx2)) {
-                dist = qMax(dist, r1.bottom() - r2.top());
-            }
-        }
+        dist = verticalDistance(c, r2, dist);
     }
     return dist;
 }
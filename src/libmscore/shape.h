@@ -59,6 +59,7 @@ public:
     Shape(const QRectF& r) { add(r); }
 #endif
     void add(const Shape& s) { insert(end(), s.begin(), s.end()); }
+    void add(const Shape& s, const QPointF& offset);        // same as add(s.translated(offset)) without the copy
 #ifndef NDEBUG
     void add(const QRectF& r, const char* t = 0);
 #else
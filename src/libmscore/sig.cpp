@@ -11,6 +11,7 @@
 //=============================================================================
 
 #include "sig.h"
+#include "sortedsearch.h"
 #include "xml.h"
 
 namespace Ms {
@@ -208,6 +209,25 @@ bool SigEvent::operator==(const SigEvent& e) const
     return _timesig.identical(e._timesig);
 }
 
+//---------------------------------------------------------
+//   TimeSigMap
+//---------------------------------------------------------
+
+TimeSigMap::TimeSigMap(const TimeSigMap& m)
+    : std::map<int, SigEvent>(m)
+{
+    normalize();
+}
+
+TimeSigMap& TimeSigMap::operator=(const TimeSigMap& m)
+{
+    if (this != &m) {
+        std::map<int, SigEvent>::operator=(m);
+        normalize();
+    }
+    return *this;
+}
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
@@ -237,6 +257,16 @@ void TimeSigMap::del(int tick)
     normalize();
 }
 
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void TimeSigMap::clear()
+{
+    std::map<int, SigEvent>::clear();
+    _entries.clear();
+}
+
 //---------------------------------------------------------
 //   clearRange
 //    Clears the given range, start tick included, end tick
@@ -266,15 +296,28 @@ void TimeSigMap::normalize()
     TimeSigFrac bar;
     int tm   = ticks_measure(TimeSigFrac(z, n));
 
+    _entries.clear();
+    _entries.reserve(size());
     for (auto i = begin(); i != end(); ++i) {
         SigEvent& e  = i->second;
         bar += TimeSigFrac(i->first - tick, tm).reduced();
         e.setBar(bar.numerator() / bar.denominator());
         tick = i->first;
         tm   = ticks_measure(e.timesig());
+        _entries.push_back({ i->first, e.bar(), &e });
     }
 }
 
+//---------------------------------------------------------
+//   tickIndex
+//    index of the last entry at or before tick, -1 if none
+//---------------------------------------------------------
+
+int TimeSigMap::tickIndex(int tick) const
+{
+    return partitionPoint(_entries, [tick](const Entry& e) { return e.tick <= tick; }) - 1;
+}
+
 //---------------------------------------------------------
 //   timesig
 //---------------------------------------------------------
@@ -282,14 +325,11 @@ void TimeSigMap::normalize()
 const SigEvent& TimeSigMap::timesig(int tick) const
 {
     static const SigEvent ev(TimeSigFrac(4, 4));
-    if (empty()) {
+    if (_entries.empty()) {
         return ev;
     }
-    auto i = upper_bound(tick);
-    if (i != begin()) {
-        --i;
-    }
-    return i->second;
+    const int idx = tickIndex(tick);
+    return *_entries[qMax(idx, 0)].event;
 }
 
 //---------------------------------------------------------
@@ -310,22 +350,22 @@ void TimeSigMap::tickValues(int t, int* bar, int* beat, int* tick) const
         *tick = 0;
         return;
     }
-    auto e = upper_bound(t);
-    if (empty() || e == begin()) {
+    const int idx = tickIndex(t);
+    if (idx < 0) {
         qFatal("tickValue(0x%x) not found", t);
     }
-    --e;
-    int delta  = t - e->first;
-    int ticksB = ticks_beat(e->second.timesig().denominator());   // ticks in beat
-    int ticksM = ticksB * e->second.timesig().numerator();        // ticks in measure (bar)
+    const Entry& e = _entries[idx];
+    int delta  = t - e.tick;
+    int ticksB = ticks_beat(e.event->timesig().denominator());   // ticks in beat
+    int ticksM = ticksB * e.event->timesig().numerator();        // ticks in measure (bar)
     if (ticksM == 0) {
-        qDebug("TimeSigMap::tickValues: at %d %s", t, qPrintable(e->second.timesig().print()));
+        qDebug("TimeSigMap::tickValues: at %d %s", t, qPrintable(e.event->timesig().print()));
         *bar  = 0;
         *beat = 0;
         *tick = 0;
         return;
     }
-    *bar       = e->second.bar() + delta / ticksM;
+    *bar       = e.bar + delta / ticksM;
     int rest   = delta % ticksM;
     *beat      = rest / ticksB;
     *tick      = rest % ticksB;
@@ -354,24 +394,18 @@ int TimeSigMap::bar2tick(int bar, int beat) const
 {
     // bar - index of current bar (terminology: bar == measure)
     // beat - index of beat in current bar
-    auto e = begin();
-
-    for (; e != end(); ++e) {
-        if (bar < e->second.bar()) {
-            break;
-        }
-    }
-    if (empty() || e == begin()) {
+    const int idx = partitionPoint(_entries, [bar](const Entry& e) { return e.bar <= bar; }) - 1;
+    if (idx < 0) {
         qDebug("TimeSigMap::bar2tick(): not found(%d,%d) not found", bar, beat);
-        if (empty()) {
+        if (_entries.empty()) {
             qDebug("   list is empty");
         }
         return 0;
     }
-    --e;   // current TimeSigMap value
-    int ticksB = ticks_beat(e->second.timesig().denominator());   // ticks per beat
-    int ticksM = ticksB * e->second.timesig().numerator();        // bar length in ticks
-    return e->first + (bar - e->second.bar()) * ticksM + ticksB * beat;
+    const Entry& e = _entries[idx];   // current TimeSigMap value
+    int ticksB = ticks_beat(e.event->timesig().denominator());   // ticks per beat
+    int ticksM = ticksB * e.event->timesig().numerator();        // bar length in ticks
+    return e.tick + (bar - e.bar) * ticksM + ticksB * beat;
 }
 
 //---------------------------------------------------------
@@ -394,7 +428,7 @@ void TimeSigMap::write(XmlWriter& xml) const
 void TimeSigMap::read(XmlReader& e, int fileDivision)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "sig") {
             SigEvent t;
             int tick = t.read(e, fileDivision);
@@ -433,7 +467,7 @@ int SigEvent::read(XmlReader& e, int fileDivision)
     int numerator2   = -1;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "nom") {
             numerator = e.readInt();
         } else if (tag == "denom") {
@@ -13,6 +13,9 @@
 #ifndef __AL_SIG_H__
 #define __AL_SIG_H__
 
+#include <map>
+#include <vector>
+
 #include "fraction.h"
 
 namespace Ms {
@@ -125,20 +128,33 @@ public:
 
 //---------------------------------------------------------
 //   SigList
+//    The lookups search a sorted list of the events which
+//    is rebuilt on every change, a copy gets its own.
 //---------------------------------------------------------
 
 class TimeSigMap : public std::map<int, SigEvent >
 {
+    struct Entry {
+        int tick;
+        int bar;
+        const SigEvent* event;
+    };
+    std::vector<Entry> _entries;
+
     void normalize();
+    int tickIndex(int tick) const;
 
 public:
     TimeSigMap() {}
+    TimeSigMap(const TimeSigMap& m);
+    TimeSigMap& operator=(const TimeSigMap& m);
 
     void add(int tick, const Fraction&);
     void add(int tick, const SigEvent& ev);
 
     void del(int tick);
 
+    void clear();
     void clearRange(int tick1, int tick2);
 
     void read(XmlReader&, int fileDiv);
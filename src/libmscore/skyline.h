@@ -89,6 +89,7 @@ public:
 
     void clear();
     void add(const Shape& s);
+    void add(const Shape& s, const QPointF& offset);
     void add(const QRectF& r);
 
     qreal minDistance(const Skyline&) const;
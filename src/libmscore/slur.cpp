@@ -240,6 +240,15 @@ void SlurSegment::changeAnchor(EditData& ed, Element* element)
 
 void SlurSegment::computeBezier(QPointF p6o)
 {
+    qreal w = score()->styleP(Sid::SlurMidWidth) - score()->styleP(Sid::SlurEndWidth);
+    if (staff()) {
+        w *= staff()->staffMag(slur()->tick());
+    }
+    const BezierKey key = bezierKey(w, _extraHeight);
+    if (p6o.isNull() && restoreBezier(key)) {
+        return;
+    }
+
     qreal _spatium  = spatium();
     qreal shoulderW;                // height as fraction of slur-length
     qreal shoulderH;
@@ -300,10 +309,6 @@ void SlurSegment::computeBezier(QPointF p6o)
     QPointF p3(c1, -shoulderH);
     QPointF p4(c2, -shoulderH);
 
-    qreal w = score()->styleP(Sid::SlurMidWidth) - score()->styleP(Sid::SlurEndWidth);
-    if (staff()) {
-        w *= staff()->staffMag(slur()->tick());
-    }
     if ((c2 - c1) <= _spatium) {
         w *= .5;
     }
@@ -372,6 +377,9 @@ void SlurSegment::computeBezier(QPointF p6o)
         _shape.add(re);
         start = point;
     }
+    if (p6o.isNull()) {
+        saveBezier(key);
+    }
 }
 
 //---------------------------------------------------------
@@ -405,7 +413,7 @@ void SlurSegment::layoutSegment(const QPointF& p1, const QPointF& p2)
         qreal gdist = 0.0;
         qreal minDistance = score()->styleS(Sid::SlurMinDistance).val() * spatium();
         for (int tries = 1; true; ++tries) {
-            for (Segment* s = fs; s && s != ls; s = s->next1()) {
+            for (const Segment* s = fs; s && s != ls; s = s->next1()) {
                 if (!s->enabled()) {
                     continue;
                 }
@@ -1026,6 +1034,19 @@ static bool isDirectionMixture(Chord* c1, Chord* c2)
 //---------------------------------------------------------
 
 SpannerSegment* Slur::layoutSystem(System* system)
+{
+    SlurSegment* slurSegment = setupSystemSegment(system);
+    layoutSystemSegment(slurSegment, system);
+    return slurSegment;
+}
+
+//---------------------------------------------------------
+//   setupSystemSegment
+//    gets the segment of the slur in system and sets the
+//    direction of the slur and the type of the segment
+//---------------------------------------------------------
+
+SlurSegment* Slur::setupSystemSegment(System* system)
 {
     Fraction stick = system->firstMeasure()->tick();
     Fraction etick = system->lastMeasure()->endTick();
@@ -1108,11 +1129,25 @@ SpannerSegment* Slur::layoutSystem(System* system)
         sst = SpannerSegmentType::END;
     }
     slurSegment->setSpannerSegmentType(sst);
+    return slurSegment;
+}
 
+//---------------------------------------------------------
+//   layoutSystemSegment
+//    of a segment set up by setupSystemSegment(). This
+//    changes only the slur and the segment, so the slurs
+//    of a system can be laid out at the same time.
+//---------------------------------------------------------
+
+void Slur::layoutSystemSegment(SlurSegment* slurSegment, System* system)
+{
+    if (tick() >= system->firstMeasure()->tick() && (startCR() == 0 || startCR()->measure() == 0)) {
+        return;             // no start anchor
+    }
     SlurPos sPos;
     slurPos(&sPos);
 
-    switch (sst) {
+    switch (slurSegment->spannerSegmentType()) {
     case SpannerSegmentType::SINGLE:
         slurSegment->layoutSegment(sPos.p1, sPos.p2);
         break;
@@ -1130,8 +1165,6 @@ SpannerSegment* Slur::layoutSystem(System* system)
         slurSegment->layoutSegment(QPointF(system->firstNoteRestSegmentX(true), sPos.p2.y()), sPos.p2);
         break;
     }
-
-    return slurSegment;
 }
 
 //---------------------------------------------------------
@@ -65,6 +65,8 @@ public:
     void write(XmlWriter& xml) const override;
     void layout() override;
     SpannerSegment* layoutSystem(System*) override;
+    SlurSegment* setupSystemSegment(System*);
+    void layoutSystemSegment(SlurSegment*, System*);
     void setTrack(int val) override;
     void slurPos(SlurPos*) override;
 
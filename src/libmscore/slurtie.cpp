@@ -42,6 +42,77 @@ SlurTieSegment::SlurTieSegment(const SlurTieSegment& b)
     path = b.path;
 }
 
+//---------------------------------------------------------
+//   BezierKey::operator==
+//---------------------------------------------------------
+
+bool SlurTieSegment::BezierKey::operator==(const BezierKey& k) const
+{
+    for (int i = 0; i < 6; ++i) {
+        if (points[i] != k.points[i]) {
+            return false;
+        }
+    }
+    return spatium == k.spatium && width == k.width && extra == k.extra && lineType == k.lineType && up == k.up;
+}
+
+//---------------------------------------------------------
+//   bezierKey
+//---------------------------------------------------------
+
+SlurTieSegment::BezierKey SlurTieSegment::bezierKey(qreal width, qreal extra) const
+{
+    BezierKey k;
+    k.points[0] = ups(Grip::START).p;
+    k.points[1] = ups(Grip::START).off;
+    k.points[2] = ups(Grip::END).p;
+    k.points[3] = ups(Grip::END).off;
+    k.points[4] = ups(Grip::BEZIER1).off;
+    k.points[5] = ups(Grip::BEZIER2).off;
+    k.spatium   = spatium();
+    k.width     = width;
+    k.extra     = extra;
+    k.lineType  = slurTie()->lineType();
+    k.up        = slurTie()->up();
+    return k;
+}
+
+//---------------------------------------------------------
+//   restoreBezier
+//    sets the result of the last computeBezier() if it
+//    was computed for key
+//---------------------------------------------------------
+
+bool SlurTieSegment::restoreBezier(const BezierKey& key)
+{
+    if (!_bezierValid || !(key == _bezierKey)) {
+        return false;
+    }
+    for (int i = 0; i < int(Grip::GRIPS); ++i) {
+        _ups[i].p = _bezierPoints[i];
+    }
+    path      = _bezierPath;
+    shapePath = _bezierShapePath;
+    _shape    = _bezierShape;
+    return true;
+}
+
+//---------------------------------------------------------
+//   saveBezier
+//---------------------------------------------------------
+
+void SlurTieSegment::saveBezier(const BezierKey& key)
+{
+    _bezierKey = key;
+    for (int i = 0; i < int(Grip::GRIPS); ++i) {
+        _bezierPoints[i] = _ups[i].p;
+    }
+    _bezierPath      = path;
+    _bezierShapePath = shapePath;
+    _bezierShape     = _shape;
+    _bezierValid     = true;
+}
+
 //---------------------------------------------------------
 //   gripAnchorLines
 //---------------------------------------------------------
@@ -359,7 +430,7 @@ void SlurTieSegment::read(XmlReader& e)
 {
     qreal _spatium = score()->spatium();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "o1") {
             ups(Grip::START).off = e.readPoint() * _spatium;
         } else if (tag == "o2") {
@@ -459,7 +530,7 @@ void SlurTie::writeProperties(XmlWriter& xml) const
 
 bool SlurTie::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (readProperty(tag, e, Pid::SLUR_DIRECTION)) {
     } else if (tag == "lineType") {
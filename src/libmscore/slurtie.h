@@ -88,9 +88,38 @@ protected:
     QPainterPath shapePath;
     Shape _shape;
 
+    //---------------------------------------------------------
+    //   BezierKey
+    //    what computeBezier() depends on when not dragged
+    //---------------------------------------------------------
+
+    struct BezierKey {
+        QPointF points[6];          // start, end and their offsets, offsets of the bezier points
+        qreal spatium { 0.0 };
+        qreal width   { 0.0 };      // thickness
+        qreal extra   { 0.0 };      // extra height of a slur, tab staff of a tie
+        int lineType  { 0 };
+        bool up       { false };
+
+        bool operator==(const BezierKey&) const;
+    };
+
+    BezierKey bezierKey(qreal width, qreal extra) const;
+    bool restoreBezier(const BezierKey&);
+    void saveBezier(const BezierKey&);
+
     virtual void changeAnchor(EditData&, Element*) = 0;
     QVector<QLineF> gripAnchorLines(Grip grip) const override;
 
+private:
+    // the result of the last computeBezier()
+    BezierKey _bezierKey;
+    QPointF _bezierPoints[int(Grip::GRIPS)];
+    QPainterPath _bezierPath;
+    QPainterPath _bezierShapePath;
+    Shape _bezierShape;
+    bool _bezierValid { false };
+
 public:
     SlurTieSegment(Score*);
     SlurTieSegment(const SlurTieSegment&);
@@ -0,0 +1,45 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SORTEDSEARCH_H__
+#define __SORTEDSEARCH_H__
+
+#include <vector>
+
+namespace Ms {
+//---------------------------------------------------------
+//   partitionPoint
+//    number of leading items for which pred is true, the
+//    items being partitioned by pred. The search halves the
+//    range without a data dependent branch, the compiler
+//    makes a conditional move of the step, so that the
+//    small tables searched by tick or time during playback
+//    do not stall on mispredictions.
+//---------------------------------------------------------
+
+template<typename T, typename Pred>
+int partitionPoint(const std::vector<T>& items, Pred pred)
+{
+    int n = int(items.size());
+    if (n == 0) {
+        return 0;
+    }
+    const T* base = items.data();
+    while (n > 1) {
+        const int half = n / 2;
+        base = pred(base[half]) ? base + half : base;
+        n -= half;
+    }
+    return int(base - items.data()) + (pred(*base) ? 1 : 0);
+}
+}     // namespace Ms
+#endif
@@ -1197,7 +1197,7 @@ void Spanner::setTick(const Fraction& v)
 {
     _tick = v;
     if (score()) {
-        score()->spannerMap().setDirty();
+        score()->spannerMap().updateSpanner(this);
     }
 }
 
@@ -1218,7 +1218,7 @@ void Spanner::setTicks(const Fraction& f)
 {
     _ticks = f;
     if (score()) {
-        score()->spannerMap().setDirty();
+        score()->spannerMap().updateSpanner(this);
     }
 }
 
@@ -21,22 +21,6 @@ namespace Ms {
 SpannerMap::SpannerMap()
     : std::multimap<int, Spanner*>()
 {
-    dirty = true;
-}
-
-//---------------------------------------------------------
-//   update
-//   updates the internal lookup tree, not the map itself
-//---------------------------------------------------------
-
-void SpannerMap::update() const
-{
-    std::vector<interval_tree::Interval<Spanner*> > intervals;
-    for (auto i : *this) {
-        intervals.push_back(interval_tree::Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
-    }
-    tree = interval_tree::IntervalTree<Spanner*>(intervals);
-    dirty = false;
 }
 
 //---------------------------------------------------------
@@ -45,28 +29,30 @@ void SpannerMap::update() const
 
 const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained(int start, int stop)
 {
-    if (dirty) {
-        update();
-    }
-    results.clear();
     tree.findContained(start, stop, results);
     return results;
 }
 
+void SpannerMap::findContained(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const
+{
+    tree.findContained(start, stop, result);
+}
+
 //---------------------------------------------------------
 //   findOverlapping
 //---------------------------------------------------------
 
 const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlapping(int start, int stop)
 {
-    if (dirty) {
-        update();
-    }
-    results.clear();
     tree.findOverlapping(start, stop, results);
     return results;
 }
 
+void SpannerMap::findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const
+{
+    tree.findOverlapping(start, stop, result);
+}
+
 //---------------------------------------------------------
 //   addSpanner
 //---------------------------------------------------------
@@ -76,15 +62,14 @@ void SpannerMap::addSpanner(Spanner* s)
 #if 0
 #ifndef NDEBUG
     // check if spanner already in list
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            qFatal("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
-        }
+    if (entries.count(s)) {
+        qFatal("SpannerMap::addSpanner: %s already in list %p", s->name(), s);
     }
 #endif
 #endif
-    insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    auto it = insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
+    int node = tree.insert(s->tick().ticks(), s->tick2().ticks(), s);
+    entries.emplace(s, Entry { it, node });
 }
 
 //---------------------------------------------------------
@@ -93,15 +78,40 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
-        if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
-        }
+    auto i = entries.find(s);
+    if (i == entries.end()) {
+        qDebug("%s (%p) not found", s->name(), s);
+        return false;
     }
-    qDebug("%s (%p) not found", s->name(), s);
-    return false;
+    erase(i->second.it);
+    tree.erase(i->second.node);
+    entries.erase(i);
+    return true;
+}
+
+//---------------------------------------------------------
+//   updateSpanner
+//    moves the spanner in the tree to its current ticks,
+//    the map keeps the tick it was added with
+//---------------------------------------------------------
+
+void SpannerMap::updateSpanner(const Spanner* s)
+{
+    auto range = entries.equal_range(s);
+    for (auto i = range.first; i != range.second; ++i) {
+        tree.rekey(i->second.node, s->tick().ticks(), s->tick2().ticks());
+    }
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    entries.clear();
+    tree.clear();
 }
 
 #ifndef NDEBUG
@@ -14,25 +14,41 @@
 #define __SPANNERMAP_H__
 
 #include <map>
-#include "thirdparty/intervaltree/IntervalTree.h"
+#include <unordered_map>
+#include "spannertree.h"
 
 namespace Ms {
 class Spanner;
 
 //---------------------------------------------------------
 //   SpannerMap
+//    the spanners by start tick, and the tree of their
+//    intervals which is kept up to date by addSpanner(),
+//    removeSpanner() and updateSpanner()
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*>
 {
-    mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
+    struct Entry {
+        std::multimap<int, Spanner*>::iterator it;
+        int node;
+    };
+
+    std::unordered_multimap<const Spanner*, Entry> entries;
+    SpannerTree tree;
     std::vector<interval_tree::Interval<Spanner*> > results;
 
 public:
     SpannerMap();
+    SpannerMap(const SpannerMap&) = delete;
+    SpannerMap& operator=(const SpannerMap&) = delete;
+
+    // the results are valid until the next search of this map
     const std::vector<interval_tree::Interval<Spanner*> >& findContained(int start, int stop);
     const std::vector<interval_tree::Interval<Spanner*> >& findOverlapping(int start, int stop);
+    // fill the result, several searches may run at once
+    void findContained(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const;
+    void findOverlapping(int start, int stop, std::vector<interval_tree::Interval<Spanner*> >& result) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
     std::multimap<int,Spanner*>::const_reverse_iterator crbegin() const { return std::multimap<int, Spanner*>::crbegin(); }
     std::multimap<int,Spanner*>::const_reverse_iterator crend() const { return std::multimap<int, Spanner*>::crend(); }
@@ -40,9 +56,8 @@ public:
     std::multimap<int,Spanner*>::const_iterator cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
-    void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void clear();
+    void updateSpanner(const Spanner* s);       // must be called if a spanner changes start/length
 #ifndef NDEBUG
     void dump() const;
 #endif
@@ -0,0 +1,304 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "spannertree.h"
+
+#include <algorithm>
+
+namespace Ms {
+//---------------------------------------------------------
+//   less
+//    the order of the nodes a and b
+//---------------------------------------------------------
+
+bool SpannerTree::less(int a, int b) const
+{
+    const Node& na = _nodes[a];
+    const Node& nb = _nodes[b];
+    return na.start < nb.start || (na.start == nb.start && na.order < nb.order);
+}
+
+//---------------------------------------------------------
+//   updateNode
+//    height and maxStop from the children
+//---------------------------------------------------------
+
+void SpannerTree::updateNode(int n)
+{
+    Node& node = _nodes[n];
+    node.height = 1 + std::max(height(node.left), height(node.right));
+    node.maxStop = node.stop;
+    if (node.left != NO_NODE) {
+        node.maxStop = std::max(node.maxStop, _nodes[node.left].maxStop);
+    }
+    if (node.right != NO_NODE) {
+        node.maxStop = std::max(node.maxStop, _nodes[node.right].maxStop);
+    }
+}
+
+//---------------------------------------------------------
+//   rotateLeft
+//---------------------------------------------------------
+
+int SpannerTree::rotateLeft(int n)
+{
+    const int r = _nodes[n].right;
+    _nodes[n].right = _nodes[r].left;
+    _nodes[r].left = n;
+    updateNode(n);
+    updateNode(r);
+    return r;
+}
+
+//---------------------------------------------------------
+//   rotateRight
+//---------------------------------------------------------
+
+int SpannerTree::rotateRight(int n)
+{
+    const int l = _nodes[n].left;
+    _nodes[n].left = _nodes[l].right;
+    _nodes[l].right = n;
+    updateNode(n);
+    updateNode(l);
+    return l;
+}
+
+//---------------------------------------------------------
+//   balance
+//    the subtree n after an insertion or removal below it,
+//    returns its new root
+//---------------------------------------------------------
+
+int SpannerTree::balance(int n)
+{
+    updateNode(n);
+    const int l = _nodes[n].left;
+    const int r = _nodes[n].right;
+    const int bf = height(l) - height(r);
+    if (bf > 1) {
+        if (height(_nodes[l].left) < height(_nodes[l].right)) {
+            _nodes[n].left = rotateLeft(l);
+        }
+        return rotateRight(n);
+    }
+    if (bf < -1) {
+        if (height(_nodes[r].right) < height(_nodes[r].left)) {
+            _nodes[n].right = rotateRight(r);
+        }
+        return rotateLeft(n);
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   insertNode
+//    into the subtree n, returns its new root
+//---------------------------------------------------------
+
+int SpannerTree::insertNode(int n, int node)
+{
+    if (n == NO_NODE) {
+        return node;
+    }
+    if (less(node, n)) {
+        const int l = insertNode(_nodes[n].left, node);
+        _nodes[n].left = l;
+    } else {
+        const int r = insertNode(_nodes[n].right, node);
+        _nodes[n].right = r;
+    }
+    return balance(n);
+}
+
+//---------------------------------------------------------
+//   eraseMin
+//    removes the first node of the subtree n, which is
+//    returned in min, returns the new root
+//---------------------------------------------------------
+
+int SpannerTree::eraseMin(int n, int& min)
+{
+    if (_nodes[n].left == NO_NODE) {
+        min = n;
+        return _nodes[n].right;
+    }
+    const int l = eraseMin(_nodes[n].left, min);
+    _nodes[n].left = l;
+    return balance(n);
+}
+
+//---------------------------------------------------------
+//   eraseNode
+//    from the subtree n, returns its new root
+//---------------------------------------------------------
+
+int SpannerTree::eraseNode(int n, int node)
+{
+    if (n == NO_NODE) {
+        return NO_NODE;
+    }
+    if (n == node) {
+        const int l = _nodes[n].left;
+        const int r = _nodes[n].right;
+        if (l == NO_NODE) {
+            return r;
+        }
+        if (r == NO_NODE) {
+            return l;
+        }
+        int min = NO_NODE;
+        const int right = eraseMin(r, min);
+        _nodes[min].left = l;
+        _nodes[min].right = right;
+        return balance(min);
+    }
+    if (less(node, n)) {
+        const int l = eraseNode(_nodes[n].left, node);
+        _nodes[n].left = l;
+    } else {
+        const int r = eraseNode(_nodes[n].right, node);
+        _nodes[n].right = r;
+    }
+    return balance(n);
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+int SpannerTree::insert(int start, int stop, Spanner* value)
+{
+    int node;
+    if (_freeNodes.empty()) {
+        node = int(_nodes.size());
+        _nodes.emplace_back();
+    } else {
+        node = _freeNodes.back();
+        _freeNodes.pop_back();
+        _nodes[node] = Node();
+    }
+    Node& n = _nodes[node];
+    n.start = start;
+    n.stop = stop;
+    n.maxStop = stop;
+    n.order = _order++;
+    n.value = value;
+
+    _root = insertNode(_root, node);
+    ++_size;
+    return node;
+}
+
+//---------------------------------------------------------
+//   erase
+//---------------------------------------------------------
+
+void SpannerTree::erase(int node)
+{
+    _root = eraseNode(_root, node);
+    _nodes[node].value = nullptr;
+    _freeNodes.push_back(node);
+    --_size;
+}
+
+//---------------------------------------------------------
+//   rekey
+//    moves the node to the new interval of its spanner
+//---------------------------------------------------------
+
+int SpannerTree::rekey(int node, int start, int stop)
+{
+    Node& n = _nodes[node];
+    if (n.start == start && n.stop == stop) {
+        return node;
+    }
+    _root = eraseNode(_root, node);
+    n.start = start;
+    n.stop = stop;
+    n.order = _order++;
+    n.left = NO_NODE;
+    n.right = NO_NODE;
+    updateNode(node);
+    _root = insertNode(_root, node);
+    return node;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerTree::clear()
+{
+    _nodes.clear();
+    _freeNodes.clear();
+    _root = NO_NODE;
+    _size = 0;
+    _order = 0;
+}
+
+//---------------------------------------------------------
+//   findOverlapping
+//    the intervals overlapping [start, stop], by tick
+//---------------------------------------------------------
+
+void SpannerTree::findOverlapping(int start, int stop, Intervals& result) const
+{
+    result.clear();
+    findOverlapping(_root, start, stop, result);
+}
+
+void SpannerTree::findOverlapping(int n, int start, int stop, Intervals& result) const
+{
+    if (n == NO_NODE || _nodes[n].maxStop < start) {
+        return;
+    }
+    const Node& node = _nodes[n];
+    findOverlapping(node.left, start, stop, result);
+    if (node.start > stop) {
+        return;                             // and all of the right subtree
+    }
+    if (node.stop >= start) {
+        result.emplace_back(node.start, node.stop, node.value);
+    }
+    findOverlapping(node.right, start, stop, result);
+}
+
+//---------------------------------------------------------
+//   findContained
+//    the intervals within [start, stop], by tick
+//---------------------------------------------------------
+
+void SpannerTree::findContained(int start, int stop, Intervals& result) const
+{
+    result.clear();
+    findContained(_root, start, stop, result);
+}
+
+void SpannerTree::findContained(int n, int start, int stop, Intervals& result) const
+{
+    if (n == NO_NODE) {
+        return;
+    }
+    const Node& node = _nodes[n];
+    if (node.start >= start) {
+        findContained(node.left, start, stop, result);
+    }
+    if (node.start > stop) {
+        return;
+    }
+    if (node.start >= start && node.stop <= stop) {
+        result.emplace_back(node.start, node.stop, node.value);
+    }
+    findContained(node.right, start, stop, result);
+}
+}     // namespace Ms
@@ -0,0 +1,87 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SPANNERTREE_H__
+#define __SPANNERTREE_H__
+
+#include <vector>
+
+#include "thirdparty/intervaltree/IntervalTree.h"
+
+namespace Ms {
+class Spanner;
+
+//---------------------------------------------------------
+//   SpannerTree
+//    balanced (AVL) search tree of the spanner intervals
+//    [tick, tick2], ordered by tick and then by the order
+//    of insertion. Each node keeps the greatest tick2 of
+//    its subtree, so that the searches skip the subtrees
+//    ending before the searched range. The nodes live in
+//    one vector and are reused, a node is referred to by
+//    its index.
+//
+//    The searches do not change the tree and may run on
+//    several threads at once.
+//---------------------------------------------------------
+
+class SpannerTree
+{
+public:
+    using Interval = interval_tree::Interval<Spanner*>;
+    using Intervals = std::vector<Interval>;
+    static constexpr int NO_NODE = -1;
+
+    int insert(int start, int stop, Spanner* value);       // returns the node
+    void erase(int node);
+    int rekey(int node, int start, int stop);              // returns the node
+    void clear();
+
+    int size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    void findOverlapping(int start, int stop, Intervals& result) const;
+    void findContained(int start, int stop, Intervals& result) const;
+
+private:
+    struct Node {
+        int start          { 0 };
+        int stop           { 0 };
+        int maxStop        { 0 };       // of the subtree
+        unsigned order     { 0 };
+        Spanner* value     { nullptr };
+        int left           { NO_NODE };
+        int right          { NO_NODE };
+        int height         { 1 };
+    };
+
+    std::vector<Node> _nodes;
+    std::vector<int> _freeNodes;
+    int _root         { NO_NODE };
+    int _size         { 0 };
+    unsigned _order   { 0 };
+
+    bool less(int a, int b) const;
+    int height(int n) const { return n == NO_NODE ? 0 : _nodes[n].height; }
+    void updateNode(int n);
+    int rotateLeft(int n);
+    int rotateRight(int n);
+    int balance(int n);
+    int insertNode(int n, int node);
+    int eraseNode(int n, int node);
+    int eraseMin(int n, int& min);
+
+    void findOverlapping(int n, int start, int stop, Intervals& result) const;
+    void findContained(int n, int start, int stop, Intervals& result) const;
+};
+}     // namespace Ms
+#endif
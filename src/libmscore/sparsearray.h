@@ -0,0 +1,322 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SPARSEARRAY_H__
+#define __SPARSEARRAY_H__
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <QtGlobal>
+
+namespace Ms {
+//---------------------------------------------------------
+//   SparseArray
+//    fixed size array of which only the slots holding a
+//    value take memory: a bitmap tells which slots are
+//    set and their values are packed in slot order. A
+//    slot that is not set reads as the default value,
+//    nullptr or an empty container; setting the default
+//    value clears the slot. Each word of the bitmap keeps
+//    the count of the slots set before it, so that the
+//    access to a slot does not depend on the size.
+//---------------------------------------------------------
+
+template<typename T>
+class SparseArray
+{
+    struct Word {
+        quint64 bits { 0 };
+        int rank     { 0 };         // number of slots set in the words before
+    };
+
+    std::vector<Word> _words;
+    std::vector<T> _values;
+    int _size { 0 };
+
+    static bool isDefault(const T& value);
+    static const T& defaultValue();
+    static int wordCount(int size) { return (size + 63) / 64; }
+    static quint64 mask(int idx) { return quint64(1) << (idx & 63); }
+
+    static quint64 maskBelow(int n) { return n <= 0 ? 0 : (n >= 64 ? ~quint64(0) : (quint64(1) << n) - 1); }
+
+    bool test(int idx) const { return _words[idx >> 6].bits & mask(idx); }
+    quint64 bitsAt(int idx) const;
+    int position(int idx) const;
+    void updateRanks(int word, int delta);
+    void moveSlots(int idx, int removed, int inserted);
+
+public:
+    class const_iterator
+    {
+        const SparseArray* _array;
+        int _idx;
+        int _position;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = const T*;
+        using reference         = const T&;
+
+        const_iterator(const SparseArray* array, int idx, int position)
+            : _array(array), _idx(idx), _position(position) {}
+
+        const T& operator*() const { return _array->test(_idx) ? _array->_values[_position] : defaultValue(); }
+        const T* operator->() const { return &**this; }
+        const_iterator& operator++();
+        const_iterator operator++(int) { const_iterator i = *this; ++*this; return i; }
+        bool operator==(const const_iterator& i) const { return _idx == i._idx; }
+        bool operator!=(const const_iterator& i) const { return _idx != i._idx; }
+    };
+    using iterator = const_iterator;
+
+    int size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    int count() const { return int(_values.size()); }      // number of slots set
+
+    void assign(int size);
+    void clear() { assign(0); }
+
+    const T& operator[](int idx) const { return test(idx) ? _values[position(idx)] : defaultValue(); }
+    const T& at(int idx) const { return (*this)[idx]; }
+    bool contains(int idx) const { return test(idx); }
+    int next(int idx) const;                // first slot set from idx on, size() if there is none
+
+    void set(int idx, T value);
+    void reset(int idx);
+    T& slot(int idx);                       // sets the slot to the default value if it is not set
+    void swap(int idx1, int idx2);
+
+    void insert(int idx, int count) { moveSlots(idx, 0, count); }
+    void erase(int idx, int count) { moveSlots(idx, count, 0); }
+
+    const_iterator begin() const { return const_iterator(this, 0, 0); }
+    const_iterator end() const { return const_iterator(this, _size, count()); }
+};
+
+//---------------------------------------------------------
+//   isDefault
+//---------------------------------------------------------
+
+template<typename T>
+bool SparseArray<T>::isDefault(const T& value)
+{
+    if constexpr (std::is_pointer<T>::value) {
+        return !value;
+    } else {
+        return value.empty();
+    }
+}
+
+//---------------------------------------------------------
+//   defaultValue
+//---------------------------------------------------------
+
+template<typename T>
+const T& SparseArray<T>::defaultValue()
+{
+    static const T value {};
+    return value;
+}
+
+//---------------------------------------------------------
+//   bitsAt
+//    the 64 bits of the slots from idx on, which may be
+//    negative; the bits out of range are 0
+//---------------------------------------------------------
+
+template<typename T>
+quint64 SparseArray<T>::bitsAt(int idx) const
+{
+    if (idx < 0) {
+        return idx <= -64 ? 0 : bitsAt(0) << -idx;
+    }
+    if (idx >= _size) {
+        return 0;
+    }
+    const int word   = idx >> 6;
+    const int offset = idx & 63;
+    quint64 bits = _words[word].bits >> offset;
+    if (offset && word + 1 < int(_words.size())) {
+        bits |= _words[word + 1].bits << (64 - offset);
+    }
+    return bits;
+}
+
+//---------------------------------------------------------
+//   next
+//---------------------------------------------------------
+
+template<typename T>
+int SparseArray<T>::next(int idx) const
+{
+    for (int word = idx >> 6; idx < _size; idx = ++word << 6) {
+        const quint64 bits = _words[word].bits & ~maskBelow(idx & 63);
+        if (bits) {
+            return qMin(_size, (word << 6) + int(qCountTrailingZeroBits(bits)));
+        }
+    }
+    return _size;
+}
+
+//---------------------------------------------------------
+//   position
+//    of the value of a set slot in _values
+//---------------------------------------------------------
+
+template<typename T>
+int SparseArray<T>::position(int idx) const
+{
+    const Word& w = _words[idx >> 6];
+    return w.rank + int(qPopulationCount(w.bits & (mask(idx) - 1)));
+}
+
+//---------------------------------------------------------
+//   updateRanks
+//    of the words after word
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::updateRanks(int word, int delta)
+{
+    for (size_t i = word + 1; i < _words.size(); ++i) {
+        _words[i].rank += delta;
+    }
+}
+
+//---------------------------------------------------------
+//   moveSlots
+//    removes the slots [idx, idx + removed) and inserts
+//    inserted slots which are not set in their place
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::moveSlots(int idx, int removed, int inserted)
+{
+    if (removed) {
+        const int first = idx < _size ? position(idx) : count();
+        const int last  = idx + removed < _size ? position(idx + removed) : count();
+        _values.erase(_values.begin() + first, _values.begin() + last);
+    }
+    // the bitmap is moved by words: the slots before idx
+    // stay, the ones after the removed slots move by
+    // inserted - removed
+    const int size = _size - removed + inserted;
+    std::vector<Word> words(wordCount(size));
+    for (size_t i = 0; i < words.size(); ++i) {
+        const int base = int(i) << 6;
+        const quint64 kept  = bitsAt(base) & maskBelow(idx - base);
+        const quint64 moved = bitsAt(base + removed - inserted) & ~maskBelow(idx + inserted - base);
+        words[i].bits = kept | moved;
+    }
+    for (size_t i = 1; i < words.size(); ++i) {
+        words[i].rank = words[i - 1].rank + int(qPopulationCount(words[i - 1].bits));
+    }
+    _words = std::move(words);
+    _size = size;
+}
+
+//---------------------------------------------------------
+//   assign
+//    size slots, none of them set
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::assign(int size)
+{
+    _words.assign(wordCount(size), Word());
+    _values.clear();
+    _size = size;
+}
+
+//---------------------------------------------------------
+//   set
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::set(int idx, T value)
+{
+    if (isDefault(value)) {
+        reset(idx);
+    } else if (test(idx)) {
+        _values[position(idx)] = std::move(value);
+    } else {
+        _values.insert(_values.begin() + position(idx), std::move(value));
+        _words[idx >> 6].bits |= mask(idx);
+        updateRanks(idx >> 6, 1);
+    }
+}
+
+//---------------------------------------------------------
+//   reset
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::reset(int idx)
+{
+    if (!test(idx)) {
+        return;
+    }
+    _values.erase(_values.begin() + position(idx));
+    _words[idx >> 6].bits &= ~mask(idx);
+    updateRanks(idx >> 6, -1);
+}
+
+//---------------------------------------------------------
+//   slot
+//---------------------------------------------------------
+
+template<typename T>
+T& SparseArray<T>::slot(int idx)
+{
+    const int pos = position(idx);
+    if (!test(idx)) {
+        _values.emplace(_values.begin() + pos);
+        _words[idx >> 6].bits |= mask(idx);
+        updateRanks(idx >> 6, 1);
+    }
+    return _values[pos];
+}
+
+//---------------------------------------------------------
+//   swap
+//---------------------------------------------------------
+
+template<typename T>
+void SparseArray<T>::swap(int idx1, int idx2)
+{
+    T value1 = (*this)[idx1];
+    T value2 = (*this)[idx2];
+    set(idx1, std::move(value2));
+    set(idx2, std::move(value1));
+}
+
+//---------------------------------------------------------
+//   const_iterator::operator++
+//---------------------------------------------------------
+
+template<typename T>
+typename SparseArray<T>::const_iterator& SparseArray<T>::const_iterator::operator++()
+{
+    if (_array->test(_idx)) {
+        ++_position;
+    }
+    ++_idx;
+    return *this;
+}
+}     // namespace Ms
+#endif
@@ -0,0 +1,172 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "spatialgrid.h"
+
+#include <cmath>
+
+namespace Ms {
+static constexpr int ELEMENTS_PER_CELL = 8;
+static constexpr int MAX_CELLS = 64 * 64;
+
+//---------------------------------------------------------
+//   initialize
+//    n is the expected number of elements, the cells
+//    are made roughly square
+//---------------------------------------------------------
+
+void SpatialGrid::initialize(const QRectF& rect, int n)
+{
+    clear();
+    _rect = rect;
+
+    const int cells = qBound(1, n / ELEMENTS_PER_CELL, MAX_CELLS);
+    const qreal w = qMax(rect.width(), 1.0);
+    const qreal h = qMax(rect.height(), 1.0);
+    _columns    = qBound(1, int(std::ceil(std::sqrt(cells * w / h))), cells);
+    _rows       = qMax(1, (cells + _columns - 1) / _columns);
+    _cellWidth  = w / _columns;
+    _cellHeight = h / _rows;
+
+    _cells.resize(size_t(_columns) * _rows);
+    _ranges.reserve(n);
+}
+
+//---------------------------------------------------------
+//   clear
+//    keeps the memory of the cells for the next use
+//---------------------------------------------------------
+
+void SpatialGrid::clear()
+{
+    for (std::vector<Entry>& c : _cells) {
+        c.clear();
+    }
+    _ranges.clear();
+}
+
+//---------------------------------------------------------
+//   release
+//---------------------------------------------------------
+
+void SpatialGrid::release()
+{
+    std::vector<std::vector<Entry> >().swap(_cells);
+    std::unordered_map<Element*, CellRange>().swap(_ranges);
+    _columns = 0;
+    _rows    = 0;
+}
+
+//---------------------------------------------------------
+//   column
+//---------------------------------------------------------
+
+int SpatialGrid::column(qreal x) const
+{
+    return qBound(0, int(std::floor((x - _rect.x()) / _cellWidth)), _columns - 1);
+}
+
+//---------------------------------------------------------
+//   row
+//---------------------------------------------------------
+
+int SpatialGrid::row(qreal y) const
+{
+    return qBound(0, int(std::floor((y - _rect.y()) / _cellHeight)), _rows - 1);
+}
+
+//---------------------------------------------------------
+//   cellRange
+//---------------------------------------------------------
+
+SpatialGrid::CellRange SpatialGrid::cellRange(const QRectF& r) const
+{
+    return { column(r.left()), row(r.top()), column(r.right()), row(r.bottom()) };
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void SpatialGrid::insert(Element* e)
+{
+    if (_cells.empty() || contains(e)) {
+        return;
+    }
+    const CellRange range = cellRange(e->pageBoundingRect());
+    for (int y = range.y1; y <= range.y2; ++y) {
+        for (int x = range.x1; x <= range.x2; ++x) {
+            cell(x, y).push_back({ e, range });
+        }
+    }
+    _ranges.emplace(e, range);
+}
+
+//---------------------------------------------------------
+//   removeFromCells
+//---------------------------------------------------------
+
+void SpatialGrid::removeFromCells(Element* e, const CellRange& range)
+{
+    for (int y = range.y1; y <= range.y2; ++y) {
+        for (int x = range.x1; x <= range.x2; ++x) {
+            std::vector<Entry>& c = cell(x, y);
+            auto i = std::find_if(c.begin(), c.end(), [e](const Entry& entry) { return entry.element == e; });
+            if (i != c.end()) {
+                *i = c.back();
+                c.pop_back();
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   remove
+//    uses the cells the element was inserted into, so it
+//    also works after the element has moved
+//---------------------------------------------------------
+
+void SpatialGrid::remove(Element* e)
+{
+    auto i = _ranges.find(e);
+    if (i == _ranges.end()) {
+        return;
+    }
+    removeFromCells(e, i->second);
+    _ranges.erase(i);
+}
+
+//---------------------------------------------------------
+//   move
+//---------------------------------------------------------
+
+void SpatialGrid::move(Element* e)
+{
+    auto i = _ranges.find(e);
+    if (i == _ranges.end()) {
+        insert(e);
+        return;
+    }
+    const CellRange range = cellRange(e->pageBoundingRect());
+    const CellRange& old = i->second;
+    if (range.x1 == old.x1 && range.y1 == old.y1 && range.x2 == old.x2 && range.y2 == old.y2) {
+        return;
+    }
+    removeFromCells(e, old);
+    for (int y = range.y1; y <= range.y2; ++y) {
+        for (int x = range.x1; x <= range.x2; ++x) {
+            cell(x, y).push_back({ e, range });
+        }
+    }
+    i->second = range;
+}
+}     // namespace Ms
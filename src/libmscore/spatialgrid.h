@@ -0,0 +1,122 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SPATIALGRID_H__
+#define __SPATIALGRID_H__
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <QRectF>
+
+#include "element.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   SpatialGrid
+//    uniform grid over the elements of a page, in page
+//    coordinates. An element is kept in every cell its
+//    bounding rectangle touches; elements outside of the
+//    grid rectangle go to the border cells. Queries call
+//    a visitor for each element found and do not allocate.
+//---------------------------------------------------------
+
+class SpatialGrid
+{
+    struct CellRange {
+        int x1, y1, x2, y2;
+    };
+    struct Entry {
+        Element* element;
+        CellRange range;
+    };
+
+    QRectF _rect;
+    int _columns       { 0 };
+    int _rows          { 0 };
+    qreal _cellWidth   { 1.0 };
+    qreal _cellHeight  { 1.0 };
+    std::vector<std::vector<Entry> > _cells;
+    std::unordered_map<Element*, CellRange> _ranges;
+
+    int column(qreal x) const;
+    int row(qreal y) const;
+    CellRange cellRange(const QRectF& r) const;
+    const std::vector<Entry>& cell(int x, int y) const { return _cells[y * _columns + x]; }
+    std::vector<Entry>& cell(int x, int y) { return _cells[y * _columns + x]; }
+    void removeFromCells(Element* e, const CellRange& range);
+
+public:
+    void initialize(const QRectF& rect, int n);
+    void clear();
+    void release();                   // frees the memory, initialize() before the next use
+
+    void insert(Element* e);
+    void remove(Element* e);
+    void move(Element* e);            // after the bounding rectangle of e changed
+    bool contains(Element* e) const { return _ranges.find(e) != _ranges.end(); }
+    int count() const { return int(_ranges.size()); }
+
+    template<typename Visitor> void visit(const QRectF& rect, Visitor visitor) const;
+    template<typename Visitor> void visit(const QPointF& pos, Visitor visitor) const;
+};
+
+//---------------------------------------------------------
+//   visit
+//    calls visitor(Element*) once for each element whose
+//    bounding rectangle intersects rect. An element found
+//    in several cells is only reported by the first cell
+//    shared by the element and the query.
+//---------------------------------------------------------
+
+template<typename Visitor>
+void SpatialGrid::visit(const QRectF& rect, Visitor visitor) const
+{
+    if (_cells.empty()) {
+        return;
+    }
+    const CellRange q = cellRange(rect);
+    for (int y = q.y1; y <= q.y2; ++y) {
+        for (int x = q.x1; x <= q.x2; ++x) {
+            for (const Entry& entry : cell(x, y)) {
+                const CellRange& r = entry.range;
+                if (x != std::max(r.x1, q.x1) || y != std::max(r.y1, q.y1)) {
+                    continue;
+                }
+                if (entry.element->pageBoundingRect().intersects(rect)) {
+                    visitor(entry.element);
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   visit
+//    calls visitor(Element*) for each element containing pos
+//---------------------------------------------------------
+
+template<typename Visitor>
+void SpatialGrid::visit(const QPointF& pos, Visitor visitor) const
+{
+    if (_cells.empty()) {
+        return;
+    }
+    for (const Entry& entry : cell(column(pos.x()), row(pos.y()))) {
+        if (entry.element->contains(pos)) {
+            visitor(entry.element);
+        }
+    }
+}
+}     // namespace Ms
+#endif
@@ -98,7 +98,7 @@ void StaffTextBase::read(XmlReader& e)
 
 bool StaffTextBase::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (tag == "MidiAction") {
         int channel = e.intAttribute("channel", 0);
@@ -12,6 +12,8 @@
 
 #include "stafftype.h"
 
+#include <mutex>
+
 #include "chord.h"
 #include "measure.h"
 #include "mscore.h"
@@ -306,7 +308,7 @@ void StaffType::read(XmlReader& e)
     }
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "name") {
             setXmlName(e.readElementText());
         } else if (tag == "lines") {
@@ -507,6 +509,7 @@ void StaffType::setDurationFontName(const QString& name)
     if (idx >= _durationFonts.size()) {
         idx = 0;              // if name not found, use first font
     }
+    MScore::loadFontFamily(_durationFonts[idx].family);
     _durationFont.setFamily(_durationFonts[idx].family);
     _durationFontIdx = idx;
     _durationMetricsValid = false;
@@ -528,9 +531,11 @@ void StaffType::setFretFontName(const QString& name)
     if (idx >= _fretFonts.size()) {
         idx = 0;              // if name not found, use first font
     }
+    MScore::loadFontFamily(_fretFonts[idx].family);
     _fretFont.setFamily(_fretFonts[idx].family);
     _fretFontIdx = idx;
     _fretMetricsValid = false;
+    _fretWidths.clear();
 }
 
 //---------------------------------------------------------
@@ -571,6 +576,35 @@ void StaffType::setFretFontSize(qreal val)
     _fretFontSize = val;
     _fretFont.setPointSizeF(val);
     _fretMetricsValid = false;
+    _fretWidths.clear();
+}
+
+//---------------------------------------------------------
+//   fretStringWidth
+//    the width of text drawn with the fret font (raster units).
+//    The layout asks for it for the fret mark of every note of
+//    the staff, the few different marks are measured once.
+//    The staves may be laid out in parallel.
+//---------------------------------------------------------
+
+qreal StaffType::fretStringWidth(const QString& text) const
+{
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (_fretWidthsDPI != DPI) {
+        _fretWidths.clear();
+        _fretWidthsDPI = DPI;
+    }
+    auto i = _fretWidths.constFind(text);
+    if (i != _fretWidths.constEnd()) {
+        return i.value();
+    }
+    QFont f(_fretFont);
+    f.setPointSizeF(_fretFontSize);
+    QFontMetricsF fm(f, MScore::paintDevice());
+    qreal w = fm.width(text);
+    _fretWidths.insert(text, w);
+    return w;
 }
 
 //---------------------------------------------------------
@@ -1074,7 +1108,7 @@ bool TablatureFretFont::read(XmlReader& e)
     defPitch    = 9.0;
     defYOffset  = 0.0;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         int val = e.intAttribute("value");
 
@@ -1130,7 +1164,7 @@ bool TablatureFretFont::read(XmlReader& e)
 bool TablatureDurationFont::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "family") {
             family = e.readElementText();
@@ -1260,7 +1294,7 @@ bool StaffType::readConfigFile(const QString& fileName)
     while (e.readNextStartElement()) {
         if (e.name() == "museScore") {
             while (e.readNextStartElement()) {
-                const QStringRef& tag(e.name());
+                const XmlTag& tag(e.name());
                 if (tag == "fretFont") {
                     TablatureFretFont ff;
                     if (ff.read(e)) {
@@ -249,6 +249,8 @@ class StaffType
     // and the metrics of the fret font
     mutable bool _fretMetricsValid = false;       // whether fret font metrics are valid or not
     mutable qreal _refDPI = 0.0;                  // reference value used to last computed metrics and to see if they are still valid
+    mutable QHash<QString, qreal> _fretWidths;    // widths of the fret marks measured so far, see fretStringWidth()
+    mutable qreal _fretWidthsDPI = 0.0;           // the DPI _fretWidths have been measured at
 
     // the array of configured fonts
     static QList<TablatureFretFont> _fretFonts;
@@ -364,6 +366,7 @@ public:
     qreal fretFontSize() const { return _fretFontSize; }
     qreal fretFontUserY() const { return _fretFontUserY; }
     qreal fretFontYOffset() const { setFretMetrics(); return _fretYOffset + _fretFontUserY * SPATIUM20; }
+    qreal fretStringWidth(const QString& text) const;
     bool  genDurations() const { return _genDurations; }
     bool  linesThrough() const { return _linesThrough; }
     TablatureMinimStyle minimStyle() const { return _minimStyle; }
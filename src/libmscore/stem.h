@@ -14,6 +14,7 @@
 #define __STEM_H__
 
 #include "element.h"
+#include "elementpool.h"
 
 namespace Ms {
 class Chord;
@@ -25,6 +26,8 @@ class Chord;
 
 class Stem final : public Element
 {
+    ELEMENT_POOL_ALLOCATION
+
     QLineF line;                    // p1 is attached to notehead
     qreal _lineWidth;
     qreal _userLen;
@@ -24,7 +24,7 @@ namespace Ms {
 //   StringData
 //---------------------------------------------------------
 
-bool StringData::bFretting = false;
+thread_local bool StringData::bFretting = false;
 
 StringData::StringData(int numFrets, int numStrings, int strings[])
 {
@@ -64,7 +64,7 @@ void StringData::read(XmlReader& e)
 {
     stringTable.clear();
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "frets") {
             _frets = e.readInt();
         } else if (tag == "string") {
@@ -151,6 +151,10 @@ int StringData::fret(int pitch, int string, Staff* staff, const Fraction& tick)
 //    but marks as fretConflict notes which cannot be fretted
 //    (outside tablature range) or which cannot be assigned
 //    a separate string
+//
+//    The layout calls this for every chord of a TAB staff: a chord
+//    whose notes, frets and tuning did not change since its last
+//    fretting is skipped.
 //---------------------------------------------------------
 
 void StringData::fretChords(Chord* chord) const
@@ -181,6 +185,10 @@ void StringData::fretChords(Chord* chord) const
     // (ottavas not implemented yet)
     int transp = chord->staff() ? chord->part()->instrument(chord->tick())->transpose().chromatic : 0;       // TODO: tick?
     int pitchOffset = /*chord->staff()->pitchOffset(chord->segment()->tick())*/ -transp;
+    if (chord->frettingKey() && chord->frettingKey() == frettingKey(chord, pitchOffset)) {
+        bFretting = false;
+        return;
+    }
     // if chord parent is not a segment, the chord is special (usually a grace chord):
     // fret it by itself, ignoring the segment
     if (chord->parent()->type() != ElementType::SEGMENT) {
@@ -273,9 +281,51 @@ void StringData::fretChords(Chord* chord) const
         }
     }
 
+    chord->setFrettingKey(frettingKey(chord, pitchOffset));
     bFretting = false;
 }
 
+//---------------------------------------------------------
+//   frettingKey
+//    Hashes the tuning and the pitches and frettings of the notes
+//    fretChords() assigns together with chord; never 0.
+//---------------------------------------------------------
+
+uint StringData::frettingKey(const Chord* chord, int pitchOffset) const
+{
+    uint key = 17;
+    auto add = [&key](int val) { key = key * 31 + uint(val); };
+
+    add(pitchOffset);
+    add(_frets);
+    for (const instrString& s : stringTable) {
+        add(s.pitch);
+        add(s.open);
+        add(s.startFret);
+    }
+    auto addChord = [&add](const Chord* ch) {
+        add(ch->track());
+        for (const Note* note : ch->notes()) {
+            add(note->pitch());
+            add(note->string());
+            add(note->fret());
+        }
+    };
+    if (chord->parent()->type() != ElementType::SEGMENT) {
+        addChord(chord);
+    } else {
+        const Segment* seg = chord->segment();
+        int trkFrom = (chord->track() / VOICES) * VOICES;
+        for (int trk = trkFrom; trk < trkFrom + VOICES; ++trk) {
+            const Element* ch = seg->elist().at(trk);
+            if (ch && ch->type() == ElementType::CHORD) {
+                addChord(toChord(ch));
+            }
+        }
+    }
+    return key ? key : 1;
+}
+
 //---------------------------------------------------------
 //   frettedStrings
 //    Returns the number of fretted strings.
@@ -554,7 +604,7 @@ void StringData::readMusicXML(XmlReader& e)
     _frets = 25;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "staff-lines") {
             int val = e.readInt();
             if (val > 0) {
@@ -569,7 +619,7 @@ void StringData::readMusicXML(XmlReader& e)
             int alter  = 0;
             int octave = 0;
             while (e.readNextStartElement()) {
-                const QStringRef& tag(e.name());
+                const XmlTag& tag(e.name());
                 if (tag == "tuning-alter") {
                     alter = e.readInt();
                 } else if (tag == "tuning-octave") {
@@ -41,11 +41,12 @@ class StringData
     QList<instrString> stringTable {  };                      // no strings by default
     int _frets = 0;
 
-    static bool bFretting;
+    static thread_local bool bFretting;         // the staves of a measure may be laid out in parallel
 
     bool        convertPitch(int pitch, int pitchOffset, int* string, int* fret) const;
     int         fret(int pitch, int string, int pitchOffset) const;
     int         getPitch(int string, int fret, int pitchOffset) const;
+    uint        frettingKey(const Chord* chord, int pitchOffset) const;
     void        sortChordNotes(QMap<int, Note*>& sortedNotes, const Chord* chord, int pitchOffset, int* count) const;
 
 public:
@@ -236,6 +236,7 @@ static const StyleType styleTypes[] {
     { Sid::articulationAnchorLuteFingering, "articulationAnchorLuteFingering", int(ArticulationAnchor::BOTTOM_CHORD) },
     { Sid::articulationAnchorOther, "articulationAnchorOther", int(ArticulationAnchor::TOP_STAFF) },
     { Sid::lastSystemFillLimit,     "lastSystemFillLimit",     QVariant(0.3) },
+    { Sid::optimalSystemBreaks,     "optimalSystemBreaks",     QVariant(false) },
 
     { Sid::hairpinPlacement,        "hairpinPlacement",        int(Placement::BELOW) },
     { Sid::hairpinPosAbove,         "hairpinPosAbove",         QPointF(0.0, -2.0) },
@@ -2678,7 +2679,7 @@ const char* MStyle::valueType(const Sid i)
 
 const QVariant& MStyle::value(Sid idx) const
 {
-    const QVariant& val = _values[int(idx)];
+    const QVariant& val = _d->values[int(idx)];
     if (!val.isValid()) {
         qDebug("invalid style value %d %s", int(idx), MStyle::valueName(idx));
         static QVariant emptyVal;
@@ -2732,26 +2733,53 @@ MStyle* MStyle::resolveStyleDefaults(const int defaultsVersion)
 //---------------------------------------------------------
 
 MStyle::MStyle()
+    : _d(new Values)
 {
     _defaultStyleVersion = MSCVERSION;
     _customChordList = false;
     for (const StyleType& t : styleTypes) {
-        _values[t.idx()] = t.defaultValue();
+        _d->values[t.idx()] = t.defaultValue();
+        _d->numbers[t.idx()] = numericValue(t.styleIdx(), t.defaultValue());
     }
+    precomputeValues();
+}
+
+//---------------------------------------------------------
+//   numericValue
+//    of the values of the types with a typed getter,
+//    0 for the other types
+//---------------------------------------------------------
+
+qreal MStyle::numericValue(Sid idx, const QVariant& v)
+{
+    const char* type = valueType(idx);
+    if (!strcmp(type, "Ms::Spatium")) {
+        return v.value<Spatium>().val();
+    }
+    if (!strcmp(type, "double") || !strcmp(type, "int") || !strcmp(type, "bool")) {
+        return v.toDouble();
+    }
+    return 0.0;
 }
 
 //---------------------------------------------------------
 //   precomputeValues
+//    nothing to do if the spatium did not change, so that
+//    the values stay shared
 //---------------------------------------------------------
 
 void MStyle::precomputeValues()
 {
     qreal _spatium = value(Sid::spatium).toDouble();
+    if (_d.constData()->precomputedSpatium == _spatium) {
+        return;
+    }
     for (const StyleType& t : styleTypes) {
         if (!strcmp(t.valueType(), "Ms::Spatium")) {
-            _precomputedValues[t.idx()] = _values[t.idx()].value<Spatium>().val() * _spatium;
+            _d->precomputedValues[t.idx()] = _d->numbers[t.idx()] * _spatium;
         }
     }
+    _d->precomputedSpatium = _spatium;
 }
 
 //---------------------------------------------------------
@@ -2819,13 +2847,17 @@ void MStyle::setChordList(ChordList* cl, bool custom)
 void MStyle::set(const Sid t, const QVariant& val)
 {
     const int idx = int(t);
-    _values[idx] = val;
+    const QVariant& old = _d.constData()->values[idx];
+    if (old.userType() == val.userType() && old == val) {
+        return;                     // don't unshare the values
+    }
+    _d->values[idx] = val;
+    _d->numbers[idx] = numericValue(t, val);
     if (t == Sid::spatium) {
         precomputeValues();
     } else {
         if (!strcmp(styleTypes[idx].valueType(), "Ms::Spatium")) {
-            qreal _spatium = value(Sid::spatium).toDouble();
-            _precomputedValues[idx] = _values[idx].value<Spatium>().val() * _spatium;
+            _d->precomputedValues[idx] = _d->numbers[idx] * _d->precomputedSpatium;
         }
     }
 }
@@ -2836,7 +2868,7 @@ void MStyle::set(const Sid t, const QVariant& val)
 
 bool MStyle::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     for (const StyleType& t : styleTypes) {
         Sid idx = t.styleIdx();
@@ -3019,7 +3051,7 @@ void MStyle::load(XmlReader& e)
     QString oldChordDescriptionFile = value(Sid::chordDescriptionFile).toString();
     bool chordListTag = false;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "TextStyle") {
             //readTextStyle206(this, e);        // obsolete
@@ -3079,7 +3111,7 @@ void MStyle::applyNewDefaults(const MStyle& other, const int defaultsVersion)
     for (auto st : qAsConst(styleTypes)) {
         if (isDefault(st.styleIdx())) {
             st._defaultValue = other.value(st.styleIdx());
-            _values.at(st.idx()) = other.value(st.styleIdx());
+            set(st.styleIdx(), other.value(st.styleIdx()));
         }
     }
 }
@@ -16,8 +16,10 @@
 #include <array>
 #include <QFile>
 #include <QSet>
+#include <QSharedData>
 
 #include "chordlist.h"
+#include "spatium.h"
 #include "types.h"
 #include "qtenum.h"
 
@@ -224,6 +226,7 @@ enum class Sid {
     articulationAnchorLuteFingering,
     articulationAnchorOther,
     lastSystemFillLimit,
+    optimalSystemBreaks,
 
     hairpinPlacement,
     hairpinPosAbove,
@@ -1464,8 +1467,20 @@ inline uint qHash(Sid id)
 
 class MStyle
 {
-    std::array<QVariant, int(Sid::STYLES)> _values;
-    std::array<qreal, int(Sid::STYLES)> _precomputedValues;
+    //---------------------------------------------------------
+    //   Values
+    //    shared by the copies of a style, as those of the
+    //    excerpts and of the scores made from one template,
+    //    until one of them is changed
+    //---------------------------------------------------------
+
+    struct Values : public QSharedData {
+        std::array<QVariant, int(Sid::STYLES)> values;
+        std::array<qreal, int(Sid::STYLES)> numbers;            // bool, int, double and Spatium values, unconverted
+        std::array<qreal, int(Sid::STYLES)> precomputedValues;  // Spatium values times the spatium
+        qreal precomputedSpatium { -1.0 };
+    };
+    QSharedDataPointer<Values> _d;
 
     ChordList _chordList;
     bool _customChordList;          // if true, chordlist will be saved as part of score
@@ -1476,7 +1491,11 @@ public:
 
     void precomputeValues();
     const QVariant& value(Sid idx) const;
-    qreal pvalue(Sid idx) const { return _precomputedValues[int(idx)]; }
+    qreal pvalue(Sid idx) const { return _d->precomputedValues[int(idx)]; }
+    bool valueB(Sid idx) const { return _d->numbers[int(idx)] != 0.0; }
+    int valueI(Sid idx) const { return int(_d->numbers[int(idx)]); }
+    qreal valueD(Sid idx) const { return _d->numbers[int(idx)]; }
+    Spatium valueS(Sid idx) const { return Spatium(_d->numbers[int(idx)]); }
     void set(Sid idx, const QVariant& v);
 
     bool isDefault(Sid idx) const;
@@ -1501,6 +1520,7 @@ public:
     void resetStyles(Score* score, const QSet<Sid>& stylesToReset);
 
     static const char* valueType(const Sid);
+    static qreal numericValue(Sid idx, const QVariant& v);
     static const char* valueName(const Sid);
     static Sid styleIdx(const QString& name);
     static MStyle* resolveStyleDefaults(const int defaultsVersion);
@@ -17,6 +17,9 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCache>
+#include <QDataStream>
+#include <QDir>
+#include <QSaveFile>
 
 #include "style.h"
 #include "sym.h"
@@ -38,6 +41,9 @@ namespace Ms {
 //---------------------------------------------------------
 
 static const int FALLBACK_FONT = 1;       // Bravura
+static const int GLYPH_CACHE_KB = 16 * 1024;   // rendered glyphs, the cost of a glyph is its size in kB
+static const quint32 METRICS_MAGIC = 0x4d53464d;   // "MSFM"
+static const quint32 METRICS_VERSION = 1;
 
 QVector<ScoreFont> ScoreFont::_scoreFonts {
     ScoreFont("Leland",     "Leland",      ":/fonts/leland/",    "Leland.otf"),
@@ -6375,15 +6381,16 @@ bool GlyphKey::operator==(const GlyphKey& k) const
            && (magX == k.magX) && (magY == k.magY) && (worldScale == k.worldScale) && (color == k.color);
 }
 
-Sym ScoreFont::sym(SymId id) const
+const Sym& ScoreFont::sym(SymId id) const
 {
+    static const Sym noSym;
     int index = static_cast<int>(id);
 
     if (index >= 0 && index < _symbols.size()) {
         return _symbols[index];
     }
 
-    return Sym();
+    return noSym;
 }
 
 //---------------------------------------------------------
@@ -6421,16 +6428,17 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
-
     if (MScore::pdfPrinting) {
         if (font == 0) {
+            // the fonts which come with MuseScore are registered once,
+            // preferably from their installed file
+            static const QString internalFontPath(":/fonts/");
             QString s(_fontPath + _filename);
-            if (-1 == QFontDatabase::addApplicationFont(s)) {
+            if (s.startsWith(internalFontPath)) {
+                if (!MScore::addApplicationFont(s.mid(internalFontPath.size()))) {
+                    return;
+                }
+            } else if (-1 == QFontDatabase::addApplicationFont(s)) {
                 qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
                 return;
             }
@@ -6441,8 +6449,12 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
             font->setStyleStrategy(QFont::NoFontMerging);
             font->setHintingPreference(QFont::PreferVerticalHinting);
         }
-        qreal size = 20.0 * MScore::pixelRatio;
-        font->setPointSize(size);
+        // the size is the same for a whole export, keep the font and its engine
+        // instead of making a new one for each symbol
+        const int size = int(20.0 * MScore::pixelRatio);
+        if (font->pointSize() != size) {
+            font->setPointSize(size);
+        }
         QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
         painter->scale(mag.width(), mag.height());
         painter->setFont(*font);
@@ -6465,6 +6477,12 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
     GlyphPixmap* pm = cache->object(gk);
 
     if (!pm) {
+        int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+        if (rv) {
+            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+            return;
+        }
+
         FT_Matrix matrix {
             scale16X, 0,
             0,       scale16Y
@@ -6484,17 +6502,20 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
 
         if (bm->width == 0 || bm->rows == 0) {
             qDebug("zero glyph, id %d", int(id));
+            FT_Done_Glyph(glyph);
+            cache->insert(gk, new GlyphPixmap);     // not loaded again
             return;
         }
         QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
         img.fill(Qt::transparent);
 
+        const int alpha = color.alpha();
         for (unsigned y = 0; y < bm->rows; ++y) {
             unsigned* dst      = (unsigned*)img.scanLine(y);
             unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
             for (unsigned x = 0; x < bm->width; ++x) {
                 unsigned val = *src++;
-                color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
+                color.setAlpha(std::min(int(val), alpha));
                 *dst++ = color.rgba();
             }
         }
@@ -6502,21 +6523,31 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
         pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
         pm->pm.setDevicePixelRatio(worldScale);
         pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
-        }
         FT_Done_Glyph(glyph);
+
+        // a glyph larger than the whole cache is deleted by insert()
+        const int cost = std::max(1, img.bytesPerLine() * img.height() / 1024);
+        if (cost > cache->maxCost()) {
+            painter->drawPixmap(pos + pm->offset, pm->pm);
+            delete pm;
+            return;
+        }
+        cache->insert(gk, pm, cost);
+    }
+    if (!pm->pm.isNull()) {
+        painter->drawPixmap(pos + pm->offset, pm->pm);
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
 }
 
-void ScoreFont::draw(SymId id, mu::draw::Painter* painter, qreal mag, const QPointF& pos, int n) const
+void ScoreFont::draw(SymId id, mu::draw::Painter* painter, qreal mag, const QPointF& _pos, int n) const
 {
-    std::vector<SymId> d;
+    const qreal worldScale = painter->worldTransform().m11();
+    const qreal step = advance(id, mag);
+    QPointF pos(_pos);
     for (int i = 0; i < n; ++i) {
-        d.push_back(id);
+        draw(id, painter, mag, pos, worldScale);
+        pos.rx() += step;
     }
-    draw(d, painter, mag, pos);
 }
 
 void ScoreFont::draw(const std::vector<SymId>& ids, mu::draw::Painter* p, qreal mag, const QPointF& _pos, qreal scale) const
@@ -6668,11 +6699,132 @@ void ScoreFont::load()
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
+    cache = new QCache<GlyphKey, GlyphPixmap>(GLYPH_CACHE_KB);
 
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
 
+    QFile fi(_fontPath + "metadata.json");
+    if (!fi.open(QIODevice::ReadOnly)) {
+        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+    }
+    const QByteArray metadata = fi.readAll();
+
+    const uint key = metricsKey(metadata);
+    if (!readMetrics(key)) {
+        loadMetrics(metadata);
+        writeMetrics(key);
+    }
+
+    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
+
+    // create missing composed glyphs
+    struct Composed {
+        SymId id;
+        std::vector<SymId> rids;
+    } composed[] = {
+        { SymId::ornamentPrallMordent,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpPrall,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentUpMordent,
+          {
+              SymId::ornamentBottomLeftConcaveStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentMiddleVerticalStroke,
+              SymId::ornamentZigZagLineWithRightEnd
+          } },
+        { SymId::ornamentPrallDown,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentBottomRightConcaveStroke,
+          } },
+#if 0
+        {
+            SymId::ornamentDownPrall,
+            {
+                SymId::ornamentTopLeftConvexStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+#endif
+        {
+            SymId::ornamentDownMordent,
+            {
+                SymId::ornamentLeftVerticalStroke,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentZigZagLineNoRightEnd,
+                SymId::ornamentMiddleVerticalStroke,
+                SymId::ornamentZigZagLineWithRightEnd
+            }
+        },
+        { SymId::ornamentPrallUp,
+          {
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentTopRightConvexStroke,
+          } },
+        { SymId::ornamentLinePrall,
+          {
+              SymId::ornamentLeftVerticalStroke,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineNoRightEnd,
+              SymId::ornamentZigZagLineWithRightEnd
+          } }
+    };
+
+    for (const Composed& c : composed) {
+        if (!_symbols[int(c.id)].isValid()) {
+            Sym* sym = &_symbols[int(c.id)];
+            std::vector<SymId> s;
+            for (SymId id : c.rids) {
+                s.push_back(id);
+            }
+            sym->setSymList(s);
+            sym->setBbox(bbox(s, 1.0));
+        }
+    }
+
+#if 0
+    //
+    // check for missing symbols
+    //
+    ScoreFont* fb = ScoreFont::fallbackFont();
+    if (fb && fb != this) {
+        for (int i = 1; i < int(SymId::lastSym); ++i) {
+            const Sym& sym = _symbols[i];
+            if (!sym.isValid()) {
+                qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
+            }
+        }
+    }
+#endif
+}
+
+//---------------------------------------------------------
+//   loadMetrics
+//    measures the glyphs and reads the anchors and
+//    engraving defaults from the SMuFL metadata
+//---------------------------------------------------------
+
+void ScoreFont::loadMetrics(const QByteArray& metadata)
+{
     for (size_t id = 0; id < _mainSymCodeTable.size(); ++id) {
         uint code = _mainSymCodeTable[id];
         if (code == 0) {
@@ -6684,13 +6836,9 @@ void ScoreFont::load()
     }
 
     QJsonParseError error;
-    QFile fi(_fontPath + "metadata.json");
-    if (!fi.open(QIODevice::ReadOnly)) {
-        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-    }
-    QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+    QJsonObject metadataJson = QJsonDocument::fromJson(metadata, &error).object();
     if (error.error != QJsonParseError::NoError) {
-        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(_fontPath + "metadata.json"),
                error.offset, qPrintable(error.errorString()));
     }
 
@@ -6783,90 +6931,6 @@ void ScoreFont::load()
             }
         }
     }
-    _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
-
-    // create missing composed glyphs
-    struct Composed {
-        SymId id;
-        std::vector<SymId> rids;
-    } composed[] = {
-        { SymId::ornamentPrallMordent,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpPrall,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentUpMordent,
-          {
-              SymId::ornamentBottomLeftConcaveStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentMiddleVerticalStroke,
-              SymId::ornamentZigZagLineWithRightEnd
-          } },
-        { SymId::ornamentPrallDown,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentBottomRightConcaveStroke,
-          } },
-#if 0
-        {
-            SymId::ornamentDownPrall,
-            {
-                SymId::ornamentTopLeftConvexStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-#endif
-        {
-            SymId::ornamentDownMordent,
-            {
-                SymId::ornamentLeftVerticalStroke,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentZigZagLineNoRightEnd,
-                SymId::ornamentMiddleVerticalStroke,
-                SymId::ornamentZigZagLineWithRightEnd
-            }
-        },
-        { SymId::ornamentPrallUp,
-          {
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentTopRightConvexStroke,
-          } },
-        { SymId::ornamentLinePrall,
-          {
-              SymId::ornamentLeftVerticalStroke,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineNoRightEnd,
-              SymId::ornamentZigZagLineWithRightEnd
-          } }
-    };
-
-    for (const Composed& c : composed) {
-        if (!_symbols[int(c.id)].isValid()) {
-            Sym* sym = &_symbols[int(c.id)];
-            std::vector<SymId> s;
-            for (SymId id : c.rids) {
-                s.push_back(id);
-            }
-            sym->setSymList(s);
-            sym->setBbox(bbox(s, 1.0));
-        }
-    }
 
     // access needed stylistic alternates
 
@@ -6963,21 +7027,160 @@ void ScoreFont::load()
     // add space symbol
     Sym* sym = &_symbols[int(SymId::space)];
     computeMetrics(sym, 32);
+}
 
-#if 0
-    //
-    // check for missing symbols
-    //
-    ScoreFont* fb = ScoreFont::fallbackFont();
-    if (fb && fb != this) {
-        for (int i = 1; i < int(SymId::lastSym); ++i) {
-            const Sym& sym = _symbols[i];
-            if (!sym.isValid()) {
-                qDebug("invalid symbol %s", Sym::id2name(SymId(i)));
-            }
+//---------------------------------------------------------
+//   metricsKey
+//    changes with the font, its metadata and the symbol
+//    table of this version
+//---------------------------------------------------------
+
+uint ScoreFont::metricsKey(const QByteArray& metadata) const
+{
+    uint key = qHash(fontImage, METRICS_VERSION);
+    key = qHash(metadata, key);
+    return qHashRange(_mainSymCodeTable.begin(), _mainSymCodeTable.end(), key);
+}
+
+//---------------------------------------------------------
+//   metricsFilePath
+//---------------------------------------------------------
+
+QString ScoreFont::metricsFilePath() const
+{
+    if (MScore::fontMetricsCachePath.isEmpty()) {
+        return QString();
+    }
+    return QString("%1/%2.metrics").arg(MScore::fontMetricsCachePath, _name.toLower());
+}
+
+//---------------------------------------------------------
+//   readMetrics
+//    returns false if there is no cached metrics file
+//    for this font, key and version
+//---------------------------------------------------------
+
+bool ScoreFont::readMetrics(uint key)
+{
+    QString path = metricsFilePath();
+    if (path.isEmpty()) {
+        return false;
+    }
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const uchar* data = f.map(0, f.size());
+    if (!data) {
+        return false;
+    }
+    // the mapping is only read while f is open
+    QByteArray ba = QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(f.size()));
+    QDataStream ds(ba);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic, version, fileKey, lastSym;
+    ds >> magic >> version >> fileKey >> lastSym;
+    if (ds.status() != QDataStream::Ok || magic != METRICS_MAGIC || version != METRICS_VERSION
+        || fileKey != key || lastSym != quint32(SymId::lastSym)) {
+        return false;
+    }
+
+    QVector<Sym> symbols(int(SymId::lastSym) + 1);
+    quint32 n;
+    ds >> n;
+    for (quint32 i = 0; i < n && ds.status() == QDataStream::Ok; ++i) {
+        quint32 id, index, anchors;
+        qint32 code;
+        QRectF bbox;
+        double advance;
+        ds >> id >> code >> index >> bbox >> advance >> anchors;
+        if (id >= quint32(symbols.size())) {
+            return false;
+        }
+        Sym* sym = &symbols[int(id)];
+        sym->setCode(code);
+        sym->setIndex(index);
+        sym->setBbox(bbox);
+        sym->setAdvance(advance);
+        for (quint32 k = 0; k < anchors; ++k) {
+            quint32 anchorId;
+            QPointF pos;
+            ds >> anchorId >> pos;
+            sym->setSmuflAnchor(SmuflAnchorId(anchorId), pos);
         }
     }
-#endif
+
+    std::list<std::pair<Sid, QVariant> > engravingDefaults;
+    ds >> n;
+    for (quint32 i = 0; i < n && ds.status() == QDataStream::Ok; ++i) {
+        quint32 sid;
+        QVariant value;
+        ds >> sid >> value;
+        engravingDefaults.push_back(std::make_pair(Sid(sid), value));
+    }
+    double textEnclosureThickness;
+    ds >> textEnclosureThickness;
+
+    if (ds.status() != QDataStream::Ok) {
+        qDebug("ScoreFont: corrupted metrics file <%s>", qPrintable(path));
+        return false;
+    }
+    _symbols = symbols;
+    _engravingDefaults = engravingDefaults;
+    _textEnclosureThickness = textEnclosureThickness;
+    return true;
+}
+
+//---------------------------------------------------------
+//   writeMetrics
+//    the symbols measured by loadMetrics(), before the
+//    composed symbols are added
+//---------------------------------------------------------
+
+void ScoreFont::writeMetrics(uint key) const
+{
+    QString path = metricsFilePath();
+    if (path.isEmpty() || !QDir().mkpath(MScore::fontMetricsCachePath)) {
+        return;
+    }
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qDebug("ScoreFont: cannot write metrics file <%s>", qPrintable(path));
+        return;
+    }
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_9);
+    ds << METRICS_MAGIC << METRICS_VERSION << quint32(key) << quint32(SymId::lastSym);
+
+    quint32 n = 0;
+    for (const Sym& sym : _symbols) {
+        if (sym.isValid()) {
+            ++n;
+        }
+    }
+    ds << n;
+    for (int id = 0; id < _symbols.size(); ++id) {
+        const Sym& sym = _symbols[id];
+        if (!sym.isValid()) {
+            continue;
+        }
+        ds << quint32(id) << qint32(sym.code()) << quint32(sym.index()) << sym.bbox() << double(sym.advance())
+           << quint32(sym.smuflAnchors.size());
+        for (const auto& a : sym.smuflAnchors) {
+            ds << quint32(a.first) << a.second;
+        }
+    }
+
+    ds << quint32(_engravingDefaults.size());
+    for (const auto& d : _engravingDefaults) {
+        ds << quint32(d.first) << d.second;
+    }
+    ds << double(_textEnclosureThickness);
+
+    if (ds.status() != QDataStream::Ok || !f.commit()) {
+        qDebug("ScoreFont: cannot write metrics file <%s>", qPrintable(path));
+    }
 }
 
 //---------------------------------------------------------
@@ -3086,7 +3086,11 @@ public:
     qreal advance() const { return _advance; }
     void setAdvance(qreal val) { _advance = val; }
 
-    QPointF smuflAnchor(SmuflAnchorId anchorId) { return smuflAnchors[anchorId]; }
+    QPointF smuflAnchor(SmuflAnchorId anchorId) const
+    {
+        auto i = smuflAnchors.find(anchorId);
+        return i != smuflAnchors.end() ? i->second : QPointF();
+    }
     void setSmuflAnchor(SmuflAnchorId anchorId, const QPointF& newValue) { smuflAnchors[anchorId] = newValue; }
 
     static SymId name2id(const QString& s) { return lnhash.value(s, SymId::noSym); }           // return noSym if not found
@@ -3136,7 +3140,11 @@ struct GlyphPixmap {
 
 inline uint qHash(const GlyphKey& k)
 {
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+    uint h = ::qHash(k.face) ^ (uint(k.id) << 8);
+    h = h * 31 + uint(k.magX * 1000);
+    h = h * 31 + uint(k.magY * 1000);
+    h = h * 31 + uint(k.worldScale * 1000);
+    return h * 31 + k.color.rgba();
 }
 
 //---------------------------------------------------------
@@ -3161,8 +3169,14 @@ class ScoreFont
     static QVector<ScoreFont> _scoreFonts;
     static std::array<uint, size_t(SymId::lastSym) + 1> _mainSymCodeTable;
     void load();
+    void loadMetrics(const QByteArray& metadata);
     void computeMetrics(Sym* sym, int code);
 
+    uint metricsKey(const QByteArray& metadata) const;
+    QString metricsFilePath() const;
+    bool readMetrics(uint key);
+    void writeMetrics(uint key) const;
+
 public:
     ScoreFont() {}
     ScoreFont(const ScoreFont&);
@@ -3215,7 +3229,7 @@ public:
     bool isValid(SymId id) const { return sym(id).isValid(); }
     bool useFallbackFont(SymId id) const;
 
-    Sym sym(SymId id) const;
+    const Sym& sym(SymId id) const;
 
     friend void initScoreFonts();
 };
@@ -115,7 +115,7 @@ void Symbol::read(XmlReader& e)
 {
     QPointF pos;
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "name") {
             QString val(e.readElementText());
             SymId symId = Sym::name2id(val);
@@ -245,7 +245,7 @@ void FSymbol::write(XmlWriter& xml) const
 void FSymbol::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "font") {
             _font.setFamily(e.readElementText());
         } else if (tag == "fontsize") {
@@ -12,8 +12,10 @@
 
 #include "tempo.h"
 
+#include <algorithm>
 #include <cmath>
 
+#include "sortedsearch.h"
 #include "xml.h"
 
 namespace Ms {
@@ -116,9 +118,67 @@ void TempoMap::normalize()
         tick  = e->first;
         tempo = e->second.tempo;
     }
+    updateEvents();
     ++_tempoSN;
 }
 
+//---------------------------------------------------------
+//   updateEvents
+//    copies the events for the lookups
+//---------------------------------------------------------
+
+void TempoMap::updateEvents()
+{
+    _events.clear();
+    _events.reserve(size());
+    for (auto e = begin(); e != end(); ++e) {
+        _events.push_back({ e->first, e->second.time, e->second.tempo, e->second.pause });
+    }
+}
+
+//---------------------------------------------------------
+//   tickIndex
+//    index of the last event at or before tick, -1 if none
+//---------------------------------------------------------
+
+int TempoMap::tickIndex(int tick) const
+{
+    return partitionPoint(_events, [tick](const FlatEvent& e) { return e.tick <= tick; }) - 1;
+}
+
+int TempoMap::tickIndex(int tick, int hint) const
+{
+    const int n = int(_events.size());
+    for (int idx = std::max(hint, -1); idx <= hint + 1 && idx < n; ++idx) {
+        if ((idx < 0 || _events[idx].tick <= tick) && (idx + 1 == n || tick < _events[idx + 1].tick)) {
+            return idx;
+        }
+    }
+    return tickIndex(tick);
+}
+
+//---------------------------------------------------------
+//   timeIndex
+//    index of the first event at or after time, the size
+//    if none
+//---------------------------------------------------------
+
+int TempoMap::timeIndex(qreal time) const
+{
+    return partitionPoint(_events, [time](const FlatEvent& e) { return e.time < time; });
+}
+
+int TempoMap::timeIndex(qreal time, int hint) const
+{
+    const int n = int(_events.size());
+    for (int idx = std::max(hint, 0); idx <= hint + 1 && idx <= n; ++idx) {
+        if ((idx == 0 || _events[idx - 1].time < time) && (idx == n || time <= _events[idx].time)) {
+            return idx;
+        }
+    }
+    return timeIndex(time);
+}
+
 //---------------------------------------------------------
 //   TempoMap::dump
 //---------------------------------------------------------
@@ -139,6 +199,7 @@ void TempoMap::dump() const
 void TempoMap::clear()
 {
     std::map<int,TEvent>::clear();
+    _events.clear();
     ++_tempoSN;
 }
 
@@ -156,6 +217,7 @@ void TempoMap::clearRange(int tick1, int tick2)
         return;
     }
     erase(first, last);
+    updateEvents();
     ++_tempoSN;
 }
 
@@ -165,22 +227,14 @@ void TempoMap::clearRange(int tick1, int tick2)
 
 qreal TempoMap::tempo(int tick) const
 {
-    if (empty()) {
-        return 2.0;
-    }
-    auto i = lower_bound(tick);
-    if (i == end()) {
-        --i;
-        return i->second.tempo;
-    }
-    if (i->first == tick) {
-        return i->second.tempo;
-    }
-    if (i == begin()) {
-        return 2.0;
-    }
-    --i;
-    return i->second.tempo;
+    const int idx = tickIndex(tick);
+    return idx < 0 ? 2.0 : _events[idx].tempo;
+}
+
+qreal TempoMap::tempo(int tick, Cursor& cursor) const
+{
+    cursor._tickIdx = tickIndex(tick, cursor._tickIdx);
+    return cursor._tickIdx < 0 ? 2.0 : _events[cursor._tickIdx].tempo;
 }
 
 //---------------------------------------------------------
@@ -249,39 +303,38 @@ int TempoMap::time2tick(qreal time, int t, int* sn) const
 
 qreal TempoMap::tick2time(int tick, int* sn) const
 {
-    qreal time  = 0.0;
-    qreal delta = qreal(tick);
-    qreal tempo = 2.0;
-
-    if (!empty()) {
-        int ptick  = 0;
-        auto e = lower_bound(tick);
-        if (e == end()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        } else if (e->first == tick) {
-            ptick = tick;
-            tempo = e->second.tempo;
-            time  = e->second.time;
-        } else if (e != begin()) {
-            auto pe = e;
-            --pe;
-            ptick = pe->first;
-            tempo = pe->second.tempo;
-            time  = pe->second.time;
-        }
-        delta = qreal(tick - ptick);
-    } else {
+    if (_events.empty()) {
         qDebug("TempoMap: empty");
     }
     if (sn) {
         *sn = _tempoSN;
     }
-    time += delta / (MScore::division * tempo * _relTempo);
-    return time;
+    return tick2time(tickIndex(tick), tick);
+}
+
+qreal TempoMap::tick2time(int tick, Cursor& cursor) const
+{
+    cursor._tickIdx = tickIndex(tick, cursor._tickIdx);
+    return tick2time(cursor._tickIdx, tick);
+}
+
+//---------------------------------------------------------
+//   tick2time
+//    idx is the last event at or before tick
+//---------------------------------------------------------
+
+qreal TempoMap::tick2time(int idx, int tick) const
+{
+    qreal time  = 0.0;
+    int ptick   = 0;
+    qreal tempo = 2.0;
+    if (idx >= 0) {
+        const FlatEvent& e = _events[idx];
+        ptick = e.tick;
+        tempo = e.tempo;
+        time  = e.time;
+    }
+    return time + qreal(tick - ptick) / (MScore::division * tempo * _relTempo);
 }
 
 //---------------------------------------------------------
@@ -290,30 +343,39 @@ qreal TempoMap::tick2time(int tick, int* sn) const
 
 int TempoMap::time2tick(qreal time, int* sn) const
 {
-    int tick     = 0;
-    qreal delta = time;
-    qreal tempo = _tempo;
-
-    delta = 0.0;
-    tempo = 2.0;
-    for (auto e = begin(); e != end(); ++e) {
-        // if in a pause period, wait on previous tick
-        if ((time <= e->second.time) && (time > e->second.time - e->second.pause)) {
-            delta = (time - (e->second.time - e->second.pause) + delta);
-            break;
-        }
-        if (e->second.time >= time) {
-            break;
-        }
-        delta = e->second.time;
-        tick  = e->first;
-        tempo = e->second.tempo;
-    }
-    delta = time - delta;
-    tick += lrint(delta * _relTempo * MScore::division * tempo);
     if (sn) {
         *sn = _tempoSN;
     }
-    return tick;
+    return time2tick(timeIndex(time), time);
+}
+
+int TempoMap::time2tick(qreal time, Cursor& cursor) const
+{
+    cursor._timeIdx = timeIndex(time, cursor._timeIdx);
+    return time2tick(cursor._timeIdx, time);
+}
+
+//---------------------------------------------------------
+//   time2tick
+//    idx is the first event at or after time
+//---------------------------------------------------------
+
+int TempoMap::time2tick(int idx, qreal time) const
+{
+    int tick    = 0;
+    qreal ptime = 0.0;
+    qreal tempo = 2.0;
+    if (idx > 0) {
+        const FlatEvent& e = _events[idx - 1];
+        tick  = e.tick;
+        ptime = e.time;
+        tempo = e.tempo;
+    }
+    // if in a pause period, wait on previous tick
+    if (idx < int(_events.size())) {
+        const FlatEvent& e = _events[idx];
+        time = qMin(time, e.time - e.pause);
+    }
+    return tick + lrint((time - ptime) * _relTempo * MScore::division * tempo);
 }
 }
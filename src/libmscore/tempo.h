@@ -14,6 +14,7 @@
 #define __AL_TEMPO_H__
 
 #include <map>
+#include <vector>
 #include <QFlags>
 
 namespace Ms {
@@ -44,18 +45,50 @@ struct TEvent {
 
 //---------------------------------------------------------
 //   Tempomap
+//    The lookups search a sorted copy of the events which
+//    is rebuilt with the precomputed times on every change.
 //---------------------------------------------------------
 
 class TempoMap : public std::map<int, TEvent>
 {
+    struct FlatEvent {
+        int tick;
+        qreal time;
+        qreal tempo;
+        qreal pause;
+    };
+
     int _tempoSN;             // serial no to track tempo changes
     qreal _tempo;             // tempo if not using tempo list (beats per second)
     qreal _relTempo;          // rel. tempo
+    std::vector<FlatEvent> _events;
 
     void normalize();
+    void updateEvents();
     void del(int tick);
 
+    int tickIndex(int tick) const;
+    int tickIndex(int tick, int hint) const;
+    int timeIndex(qreal time) const;
+    int timeIndex(qreal time, int hint) const;
+    qreal tick2time(int idx, int tick) const;
+    int time2tick(int idx, qreal time) const;
+
 public:
+    //---------------------------------------------------------
+    //   Cursor
+    //    remembers the event of the last lookup, for a
+    //    sequence of lookups with increasing ticks or times
+    //    which then need no search
+    //---------------------------------------------------------
+
+    class Cursor
+    {
+        int _tickIdx { -1 };
+        int _timeIdx { -1 };
+        friend class TempoMap;
+    };
+
     TempoMap();
     void clear();
     void clearRange(int tick1, int tick2);
@@ -63,12 +96,15 @@ public:
     void dump() const;
 
     qreal tempo(int tick) const;
+    qreal tempo(int tick, Cursor& cursor) const;
 
     qreal tick2time(int tick, int* sn = 0) const;
+    qreal tick2time(int tick, Cursor& cursor) const;
     qreal tick2timeLC(int tick, int* sn) const;
     qreal tick2time(int tick, qreal time, int* sn) const;
     int time2tick(qreal time, int* sn = 0) const;
     int time2tick(qreal time, int tick, int* sn) const;
+    int time2tick(qreal time, Cursor& cursor) const;
     int tempoSN() const { return _tempoSN; }
 
     void setTempo(int t, qreal);
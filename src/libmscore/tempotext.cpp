@@ -74,7 +74,7 @@ void TempoText::write(XmlWriter& xml) const
 void TempoText::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "tempo") {
             setTempo(e.readDouble());
         } else if (tag == "followText") {
@@ -0,0 +1,129 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "libmscore/fraction.h"
+
+using namespace Ms;
+
+// the arithmetic is usable in constant expressions
+static_assert(Fraction(1, 4) + Fraction(1, 8) == Fraction(3, 8), "");
+static_assert(Fraction(3, 8) - Fraction(1, 4) == Fraction(1, 8), "");
+static_assert(Fraction(1, 4) < Fraction(1, 2), "");
+static_assert(Fraction(6, 8).reduced().identical(Fraction(3, 4)), "");
+
+//---------------------------------------------------------
+//   TestFractionBenchmark
+//---------------------------------------------------------
+
+class TestFractionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void gcd();
+    void largeValues();
+    void sameDenominator();
+    void differentDenominators();
+    void compare();
+};
+
+//---------------------------------------------------------
+//   gcd
+//---------------------------------------------------------
+
+void TestFractionBenchmark::gcd()
+{
+    QCOMPARE(Ms::gcd(0, 0), int_least64_t(0));
+    QCOMPARE(Ms::gcd(0, 7), int_least64_t(7));
+    QCOMPARE(Ms::gcd(-12, 18), int_least64_t(6));
+    QCOMPARE(Ms::gcd(1920, 1440), int_least64_t(480));
+    QCOMPARE(Ms::gcd(int_least64_t(3) << 40, int_least64_t(9) << 35), int_least64_t(3) << 35);
+}
+
+//---------------------------------------------------------
+//   largeValues
+//    denominators beyond the range of int must not be
+//    truncated while adding and reducing
+//---------------------------------------------------------
+
+void TestFractionBenchmark::largeValues()
+{
+    Fraction f(1, 1 << 20);
+    f *= Fraction(1, 1 << 20);
+    f += Fraction(1, 1 << 20);
+    f -= Fraction(1, 1 << 20);
+    f *= Fraction(1 << 20, 1);
+    QVERIFY(f.reduced().identical(Fraction(1, 1 << 20)));
+}
+
+//---------------------------------------------------------
+//   sameDenominator
+//---------------------------------------------------------
+
+void TestFractionBenchmark::sameDenominator()
+{
+    const Fraction eighth(1, 8);
+    Fraction sum;
+    QBENCHMARK {
+        sum = Fraction(0, 8);
+        for (int i = 0; i < 1000; ++i) {
+            sum += eighth;
+        }
+    }
+    QCOMPARE(sum, Fraction(125, 1));
+}
+
+//---------------------------------------------------------
+//   differentDenominators
+//---------------------------------------------------------
+
+void TestFractionBenchmark::differentDenominators()
+{
+    const Fraction triplet(1, 12);
+    const Fraction sixteenth(1, 16);
+    Fraction sum;
+    QBENCHMARK {
+        sum = Fraction(0, 1);
+        for (int i = 0; i < 500; ++i) {
+            sum += triplet;
+            sum += sixteenth;
+            sum.reduce();
+        }
+    }
+    QCOMPARE(sum, Fraction(875, 12));
+}
+
+//---------------------------------------------------------
+//   compare
+//---------------------------------------------------------
+
+void TestFractionBenchmark::compare()
+{
+    std::vector<Fraction> ticks;
+    for (int i = 0; i < 1000; ++i) {
+        ticks.push_back(Fraction(i, 16));
+    }
+    int count = 0;
+    QBENCHMARK {
+        count = 0;
+        for (size_t i = 1; i < ticks.size(); ++i) {
+            if (ticks[i - 1] < ticks[i] && ticks[i] != Fraction(1, 4)) {
+                ++count;
+            }
+        }
+    }
+    QCOMPARE(count, 999);
+}
+
+QTEST_MAIN(TestFractionBenchmark)
+#include "tst_fractionbenchmark.moc"
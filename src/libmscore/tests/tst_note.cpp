@@ -26,6 +26,7 @@
 #include "libmscore/sym.h"
 #include "libmscore/key.h"
 #include "libmscore/pitchspelling.h"
+#include "libmscore/undo.h"
 
 static const QString NOTE_DATA_DIR("note_data/");
 
@@ -49,6 +50,8 @@ private slots:
     void noteLimits();
     void tpcDegrees();
     void LongNoteAfterShort_183746();
+    void changePropertyOfNotes();
+    void revisions();
 };
 
 //---------------------------------------------------------
@@ -544,6 +547,101 @@ void TestNote::LongNoteAfterShort_183746()
     QVERIFY(totalTicks == breveTicks);   // total duration same as a breve
 }
 
+//---------------------------------------------------------
+///   changePropertyOfNotes
+///   a property changed for several notes in one command
+///   is undone and redone as one ChangeProperties
+//---------------------------------------------------------
+
+void TestNote::changePropertyOfNotes()
+{
+    MasterScore* score = readScore(NOTE_DATA_DIR + "empty.mscx");
+    score->doLayout();
+
+    score->inputState().setTrack(0);
+    score->inputState().setSegment(score->tick2segment(Fraction(0,1), false, SegmentType::ChordRest));
+    score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+    score->inputState().setNoteEntryMode(true);
+    for (int i = 0; i < 4; ++i) {
+        score->cmdAddPitch(5 * 7 + i, false, false);
+    }
+    score->inputState().setNoteEntryMode(false);
+
+    std::vector<Note*> notes;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        if (s->element(0) && s->element(0)->isChord()) {
+            notes.push_back(toChord(s->element(0))->upNote());
+        }
+    }
+    QCOMPARE(int(notes.size()), 4);
+
+    score->startCmd();
+    for (Note* n : notes) {
+        n->undoChangeProperty(Pid::GHOST, true);
+    }
+    score->endCmd();
+
+    for (Note* n : notes) {
+        QVERIFY(n->ghost());
+    }
+    UndoMacro* macro = score->undoStack()->last();
+    QCOMPARE(macro->childCount(), 1);
+    QCOMPARE(QString(macro->commands().front()->name()), QString("ChangeProperties"));
+
+    score->undoStack()->undo(&ed);
+    for (Note* n : notes) {
+        QVERIFY(!n->ghost());
+    }
+    score->undoStack()->redo(&ed);
+    for (Note* n : notes) {
+        QVERIFY(n->ghost());
+    }
+}
+
+//---------------------------------------------------------
+///   revisions
+///    an edit changes the revisions of the note and its
+///    chord and the content hash of its measure only, the
+///    undo changes them again
+//---------------------------------------------------------
+
+void TestNote::revisions()
+{
+    MasterScore* score = readScore(NOTE_DATA_DIR + "empty.mscx");
+    score->doLayout();
+
+    score->inputState().setTrack(0);
+    score->inputState().setSegment(score->tick2segment(Fraction(0, 1), false, SegmentType::ChordRest));
+    score->inputState().setDuration(TDuration::DurationType::V_QUARTER);
+    score->inputState().setNoteEntryMode(true);
+    score->cmdAddPitch(60, false, false);
+
+    Measure* first = score->firstMeasure();
+    Measure* last = score->lastMeasure();
+    Chord* chord = toChord(first->findSegment(SegmentType::ChordRest, Fraction(0, 1))->element(0));
+    Note* note = chord->upNote();
+    QVERIFY(note->revision() != 0);
+
+    const quint64 noteRevision = note->revision();
+    const quint64 firstHash = first->contentHash(0);
+    const quint64 lastHash = last->contentHash(0);
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::VELO_OFFSET, 20);
+    score->endCmd();
+
+    QVERIFY(note->revision() > noteRevision);
+    QCOMPARE(chord->revision(), note->revision());
+    QVERIFY(first->contentHash(0) != firstHash);
+    QCOMPARE(last->contentHash(0), lastHash);
+
+    const quint64 editedHash = first->contentHash(0);
+    EditData ed;
+    score->undoStack()->undo(&ed);
+    QVERIFY(first->contentHash(0) != editedHash);
+    QCOMPARE(last->contentHash(0), lastHash);
+}
+
 QTEST_MAIN(TestNote)
 
 #include "tst_note.moc"
@@ -0,0 +1,161 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <algorithm>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/hairpin.h"
+#include "libmscore/spannermap.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestSpannerMap
+//---------------------------------------------------------
+
+class TestSpannerMap : public QObject, public MTest
+{
+    Q_OBJECT
+
+    std::vector<Spanner*> spanners;
+
+    Hairpin* addHairpin(int tick, int ticks);
+    void setTicks(Spanner* s, int tick, int ticks);
+    void compare();
+
+private slots:
+    void initTestCase();
+    void spannerMap();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSpannerMap::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   addHairpin
+//---------------------------------------------------------
+
+Hairpin* TestSpannerMap::addHairpin(int tick, int ticks)
+{
+    Hairpin* hp = new Hairpin(score);
+    setTicks(hp, tick, ticks);
+    score->spannerMap().addSpanner(hp);
+    spanners.push_back(hp);
+    return hp;
+}
+
+//---------------------------------------------------------
+//   setTicks
+//---------------------------------------------------------
+
+void TestSpannerMap::setTicks(Spanner* s, int tick, int ticks)
+{
+    s->setTick(Fraction::fromTicks(tick));
+    s->setTicks(Fraction::fromTicks(ticks));
+}
+
+//---------------------------------------------------------
+//   compare
+//    the searches against a scan of all spanners of
+//    the score
+//---------------------------------------------------------
+
+void TestSpannerMap::compare()
+{
+    std::vector<interval_tree::Interval<Spanner*> > result;
+    for (int start = -10; start < 2100; start += 70) {
+        for (int length : { 0, 1, 240, 1000 }) {
+            const int stop = start + length;
+            std::vector<const Spanner*> overlapping;
+            std::vector<const Spanner*> contained;
+            for (const auto& i : score->spannerMap().map()) {
+                const Spanner* s = i.second;
+                if (s->tick2().ticks() >= start && s->tick().ticks() <= stop) {
+                    overlapping.push_back(s);
+                }
+                if (s->tick().ticks() >= start && s->tick2().ticks() <= stop) {
+                    contained.push_back(s);
+                }
+            }
+            std::sort(overlapping.begin(), overlapping.end());
+            std::sort(contained.begin(), contained.end());
+
+            score->spannerMap().findOverlapping(start, stop, result);
+            std::vector<const Spanner*> found;
+            for (size_t i = 0; i < result.size(); ++i) {
+                found.push_back(result[i].value);
+                QVERIFY(i == 0 || result[i - 1].start <= result[i].start);
+            }
+            std::sort(found.begin(), found.end());
+            QVERIFY(found == overlapping);
+
+            score->spannerMap().findContained(start, stop, result);
+            found.clear();
+            for (const auto& i : result) {
+                found.push_back(i.value);
+            }
+            std::sort(found.begin(), found.end());
+            QVERIFY(found == contained);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   spannerMap
+//    the interval tree follows the additions, removals and
+//    tick changes of the spanners
+//---------------------------------------------------------
+
+void TestSpannerMap::spannerMap()
+{
+    for (int i = 0; i < 300; ++i) {
+        addHairpin((i * 397) % 2000, (i * 131) % 480);
+    }
+    compare();
+
+    for (size_t i = 0; i < spanners.size(); i += 2) {
+        setTicks(spanners[i], (int(i) * 173) % 2000, (int(i) * 59) % 960);
+    }
+    compare();
+
+    for (size_t i = 0; i < spanners.size(); i += 3) {
+        QVERIFY(score->spannerMap().removeSpanner(spanners[i]));
+        delete spanners[i];
+        spanners[i] = nullptr;
+    }
+    spanners.erase(std::remove(spanners.begin(), spanners.end(), nullptr), spanners.end());
+    compare();
+
+    for (int i = 0; i < 50; ++i) {
+        addHairpin((i * 61) % 2000, 0);
+    }
+    compare();
+
+    for (Spanner* s : spanners) {
+        score->spannerMap().removeSpanner(s);
+        delete s;
+    }
+    spanners.clear();
+    compare();
+}
+
+QTEST_MAIN(TestSpannerMap)
+
+#include "tst_spannermap.moc"
@@ -0,0 +1,139 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "libmscore/mscore.h"
+#include "libmscore/sig.h"
+#include "libmscore/tempo.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTempoMap
+//---------------------------------------------------------
+
+class TestTempoMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tick2time();
+    void pause();
+    void cursor();
+    void timeSigMap();
+};
+
+//---------------------------------------------------------
+//   tick2time
+//---------------------------------------------------------
+
+void TestTempoMap::tick2time()
+{
+    const int div = MScore::division;
+    TempoMap tm;
+    QCOMPARE(tm.tempo(0), 2.0);
+    QCOMPARE(tm.tick2time(div), 0.5);
+
+    tm.setTempo(0, 2.0);
+    tm.setTempo(4 * div, 1.0);
+    QCOMPARE(tm.tempo(4 * div - 1), 2.0);
+    QCOMPARE(tm.tempo(4 * div), 1.0);
+    QCOMPARE(tm.tick2time(4 * div), 2.0);
+    QCOMPARE(tm.tick2time(6 * div), 4.0);
+    QCOMPARE(tm.time2tick(2.0), 4 * div);
+    QCOMPARE(tm.time2tick(4.0), 6 * div);
+    QCOMPARE(tm.time2tick(1.0), 2 * div);
+
+    tm.delTempo(4 * div);
+    QCOMPARE(tm.tick2time(6 * div), 3.0);
+}
+
+//---------------------------------------------------------
+//   pause
+//    the ticks do not advance while in a pause
+//---------------------------------------------------------
+
+void TestTempoMap::pause()
+{
+    const int div = MScore::division;
+    TempoMap tm;
+    tm.setTempo(0, 1.0);
+    tm.setPause(2 * div, 1.5);
+    QCOMPARE(tm.tick2time(2 * div), 3.5);
+    QCOMPARE(tm.time2tick(2.0), 2 * div);
+    QCOMPARE(tm.time2tick(3.0), 2 * div);
+    QCOMPARE(tm.time2tick(4.5), 3 * div);
+}
+
+//---------------------------------------------------------
+//   cursor
+//    the lookups with a cursor give the same results as
+//    the searches, also after a jump back and a change
+//---------------------------------------------------------
+
+void TestTempoMap::cursor()
+{
+    const int div = MScore::division;
+    TempoMap tm;
+    for (int i = 0; i < 32; ++i) {
+        tm.setTempo(i * div, 1.0 + (i % 5) * 0.25);
+        if (i % 7 == 3) {
+            tm.setPause(i * div, 0.5);
+        }
+    }
+
+    TempoMap::Cursor c;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int tick = 0; tick < 40 * div; tick += div / 3) {
+            QCOMPARE(tm.tick2time(tick, c), tm.tick2time(tick));
+            QCOMPARE(tm.tempo(tick, c), tm.tempo(tick));
+        }
+        for (qreal time = 0.0; time < 40.0; time += 0.1) {
+            QCOMPARE(tm.time2tick(time, c), tm.time2tick(time));
+        }
+        tm.clearRange(10 * div, 20 * div);
+    }
+}
+
+//---------------------------------------------------------
+//   timeSigMap
+//---------------------------------------------------------
+
+void TestTempoMap::timeSigMap()
+{
+    const int div = MScore::division;
+    TimeSigMap sm;
+    QCOMPARE(sm.timesig(0).timesig(), TimeSigFrac(4, 4));
+
+    sm.add(0, Fraction(4, 4));
+    sm.add(8 * div, Fraction(3, 4));
+    sm.add(14 * div, Fraction(6, 8));
+    QCOMPARE(sm.timesig(8 * div - 1).timesig(), TimeSigFrac(4, 4));
+    QCOMPARE(sm.timesig(8 * div).timesig(), TimeSigFrac(3, 4));
+    QCOMPARE(sm.timesig(20 * div).timesig(), TimeSigFrac(6, 8));
+
+    int bar, beat, tick;
+    sm.tickValues(12 * div + 1, &bar, &beat, &tick);
+    QCOMPARE(bar, 3);
+    QCOMPARE(beat, 1);
+    QCOMPARE(tick, 1);
+    QCOMPARE(sm.bar2tick(3, 1), 12 * div);
+    QCOMPARE(sm.bar2tick(5, 0), 17 * div);
+
+    TimeSigMap copy(sm);
+    sm.clear();
+    QCOMPARE(copy.timesig(8 * div).timesig(), TimeSigFrac(3, 4));
+    QCOMPARE(sm.timesig(8 * div).timesig(), TimeSigFrac(4, 4));
+}
+
+QTEST_MAIN(TestTempoMap)
+#include "tst_tempomap.moc"
@@ -40,7 +40,7 @@ Text::Text(Score* s, Tid tid)
 void Text::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "style") {
             QString sn = e.readElementText();
             if (sn == "Tuplet") {              // ugly hack for compatibility
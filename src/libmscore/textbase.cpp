@@ -35,6 +35,7 @@
 #include "xml.h"
 #include "undo.h"
 #include "mscore.h"
+#include "fontmetricscache.h"
 
 namespace Ms {
 #ifdef Q_OS_MAC
@@ -259,7 +260,7 @@ QRectF TextCursor::cursorRect() const
     const TextFragment* fragment = tline.fragment(column());
 
     QFont _font  = fragment ? fragment->font(_text) : _text->font();
-    qreal ascent = QFontMetricsF(_font, MScore::paintDevice()).ascent();
+    qreal ascent = FontMetricsCache::metrics(_font).ascent;
     qreal h = ascent;
     qreal x = tline.xpos(column(), _text);
     qreal y = tline.y() - ascent * .9;
@@ -1011,8 +1012,8 @@ QFont TextFragment::font(const TextBase* t) const
         family = t->score()->styleSt(Sid::MusicalTextFont);
 
         // check if all symbols are available
+        MScore::loadFontFamily(family);
         font.setFamily(family);
-        QFontMetricsF fm(font);
 
         bool fail = false;
         for (int i = 0; i < text.size(); ++i) {
@@ -1024,12 +1025,12 @@ QFont TextFragment::font(const TextBase* t) const
                 QChar c2 = text[i + 1];
                 ++i;
                 uint v = QChar::surrogateToUcs4(c, c2);
-                if (!fm.inFontUcs4(v)) {
+                if (!FontMetricsCache::inFont(font, v)) {
                     fail = true;
                     break;
                 }
             } else {
-                if (!fm.inFont(c)) {
+                if (!FontMetricsCache::inFont(font, c.unicode())) {
                     fail = true;
                     break;
                 }
@@ -1042,6 +1043,7 @@ QFont TextFragment::font(const TextBase* t) const
         family = format.fontFamily();
     }
 
+    MScore::loadFontFamily(family);
     font.setFamily(family);
     font.setBold(format.bold());
     font.setItalic(format.italic());
@@ -1112,9 +1114,9 @@ void TextBlock::layout(TextBase* t)
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const FontMetricsCache::Metrics fm = FontMetricsCache::metrics(f.font(t));
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
-            qreal voffset = fm.xHeight() / subScriptSize;   // use original height
+            qreal voffset = fm.xHeight / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                 voffset *= subScriptOffset;
             } else {
@@ -1126,17 +1128,18 @@ void TextBlock::layout(TextBase* t)
             f.pos.setY(0.0);
         }
 
-        QRectF temp(0.0, -fm.ascent(), 1.0, fm.descent());
+        QRectF temp(0.0, -fm.ascent, 1.0, fm.descent);
         _bbox |= temp;
-        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
     } else {
         const auto fiLast = --_fragments.end();
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
+            const FontMetricsCache::Metrics fm = FontMetricsCache::metrics(font);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                qreal voffset = fm.xHeight() / subScriptSize;           // use original height
+                qreal voffset = fm.xHeight / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                     voffset *= subScriptOffset;
                 } else {
@@ -1150,12 +1153,12 @@ void TextBlock::layout(TextBase* t)
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
+                const qreal w  = FontMetricsCache::width(font, f.text);
                 x += w;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+            _bbox   |= FontMetricsCache::tightBoundingRect(font, f.text).translated(f.pos);
+            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
         }
     }
 
@@ -1206,7 +1209,6 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
         int idx = 0;
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
@@ -1215,6 +1217,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
             }
             ++col;
             if (column == col) {
+                QFontMetricsF fm(f.font(t), MScore::paintDevice());
                 return f.pos.x() + fm.width(f.text.left(idx));
             }
         }
@@ -1306,12 +1309,12 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        QFontMetricsF fm(f.font(t), MScore::paintDevice());
         for (const QChar& c : qAsConst(f.text)) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
             qreal xo = fm.width(f.text.left(idx));
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
@@ -2072,9 +2075,9 @@ void TextBase::layoutFrame()
 //      if (empty()) {    // or bbox.width() <= 1.0
     if (bbox().width() <= 1.0 || bbox().height() < 1.0) {      // or bbox.width() <= 1.0
         // this does not work for Harmony:
-        QFontMetricsF fm = QFontMetricsF(font(), MScore::paintDevice());
-        qreal ch = fm.ascent();
-        qreal cw = fm.width('n');
+        const QFont f = font();
+        qreal ch = FontMetricsCache::metrics(f).ascent;
+        qreal cw = FontMetricsCache::width(f, QStringLiteral("n"));
         frame = QRectF(0.0, -ch, cw, ch);
     } else {
         frame = bbox();
@@ -2436,7 +2439,7 @@ static constexpr std::array<Pid, 18> pids { {
 
 bool TextBase::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
     for (Pid i :pids) {
         if (readProperty(tag, e, i)) {
             return true;
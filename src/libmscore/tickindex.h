@@ -0,0 +1,82 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TICKINDEX_H__
+#define __TICKINDEX_H__
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "fraction.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   TickIndex
+//    the items of a linked list in list order, for binary
+//    searches by tick. The owner of the list invalidates
+//    the index when the list or the ticks change, and the
+//    index is rebuilt by the next search. While the ticks
+//    are not in list order, as in the middle of an edit,
+//    there is no index and the owner searches the list.
+//
+//    Searches may run on several threads at once, edits
+//    never run at the same time as searches.
+//---------------------------------------------------------
+
+template<typename T>
+class TickIndex
+{
+    mutable std::vector<T*> _items;
+    mutable bool _sorted { false };
+    mutable std::atomic<bool> _valid { false };
+
+    static std::mutex& mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+public:
+    TickIndex() = default;
+    TickIndex(const TickIndex&) {}                  // a copy belongs to another list
+    TickIndex& operator=(const TickIndex&) { invalidate(); return *this; }
+
+    void invalidate() { _valid.store(false, std::memory_order_relaxed); }
+
+    //---------------------------------------------------------
+    //   items
+    //    fill(std::vector<T*>&) appends the items in list
+    //    order, tick(const T*) is the key; nullptr if the
+    //    items are not sorted by it
+    //---------------------------------------------------------
+
+    template<typename Fill, typename Tick>
+    const std::vector<T*>* items(Fill fill, Tick tick) const
+    {
+        if (!_valid.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex());
+            if (!_valid.load(std::memory_order_relaxed)) {
+                _items.clear();
+                fill(_items);
+                _sorted = std::is_sorted(_items.begin(), _items.end(), [&tick](const T* a, const T* b) {
+                    return tick(a) < tick(b);
+                });
+                _valid.store(true, std::memory_order_release);
+            }
+        }
+        return _sorted ? &_items : nullptr;
+    }
+};
+}     // namespace Ms
+#endif
@@ -192,6 +192,16 @@ void TieSegment::editDrag(EditData& ed)
 
 void TieSegment::computeBezier(QPointF p6o)
 {
+    qreal w = score()->styleP(Sid::SlurMidWidth) - score()->styleP(Sid::SlurEndWidth);
+    if (staff()) {
+        w *= staff()->staffMag(tie()->tick());
+    }
+    const bool tab = staff() && staff()->isTabStaff(slurTie()->tick());
+    const BezierKey key = bezierKey(w, tab ? 1.0 : 0.0);
+    if (p6o.isNull() && restoreBezier(key)) {
+        return;
+    }
+
     qreal _spatium  = spatium();
     qreal shoulderW;                // height as fraction of slur-length
     qreal shoulderH;
@@ -241,10 +251,6 @@ void TieSegment::computeBezier(QPointF p6o)
     QPointF p3(c1, -shoulderH);
     QPointF p4(c2, -shoulderH);
 
-    qreal w = score()->styleP(Sid::SlurMidWidth) - score()->styleP(Sid::SlurEndWidth);
-    if (staff()) {
-        w *= staff()->staffMag(tie()->tick());
-    }
     QPointF th(0.0, w);      // thickness of slur
 
     QPointF p3o = p6o + t.map(ups(Grip::BEZIER1).off);
@@ -286,7 +292,7 @@ void TieSegment::computeBezier(QPointF p6o)
     // translate back
     double y = pp1.y();
     const double offsetFactor = 0.2;
-    if (staff()->isTabStaff(slurTie()->tick())) {
+    if (tab) {
         y += (_spatium * (slurTie()->up() ? -offsetFactor : offsetFactor));
     }
     t.reset();
@@ -324,6 +330,9 @@ void TieSegment::computeBezier(QPointF p6o)
         _shape.add(re);
         start = point;
     }
+    if (p6o.isNull()) {
+        saveBezier(key);
+    }
 }
 
 //---------------------------------------------------------
@@ -157,7 +157,7 @@ void TimeSig::read(XmlReader& e)
     bool old = false;
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
 
         if (tag == "den") {
             old = true;
@@ -563,7 +563,7 @@ void Tremolo::write(XmlWriter& xml) const
 void Tremolo::read(XmlReader& e)
 {
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             setTremoloType(e.readElementText());
         }
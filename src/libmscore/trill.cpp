@@ -379,7 +379,7 @@ void Trill::read(XmlReader& e)
     eraseSpannerSegments();
 
     while (e.readNextStartElement()) {
-        const QStringRef& tag(e.name());
+        const XmlTag& tag(e.name());
         if (tag == "subtype") {
             setTrillType(e.readElementText());
         } else if (tag == "Accidental") {
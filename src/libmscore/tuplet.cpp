@@ -836,7 +836,7 @@ void Tuplet::read(XmlReader& e)
 
 bool Tuplet::readProperties(XmlReader& e)
 {
-    const QStringRef& tag(e.name());
+    const XmlTag& tag(e.name());
 
     if (readStyledProperty(e, tag)) {
     } else if (tag == "bold") { //important that these properties are read after number is created
@@ -23,6 +23,7 @@
 */
 
 #include "log.h"
+#include "commandstats.h"
 #include "undo.h"
 #include "element.h"
 #include "note.h"
@@ -260,6 +261,7 @@ UndoStack::UndoStack()
     curCmd   = 0;
     curIdx   = 0;
     cleanState = 0;
+    droppedCount = 0;
     stateList.push_back(cleanState);
     nextState = 1;
 }
@@ -314,8 +316,15 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         qDebug("<%s>", cmd->name());
     }
 #endif
-    curCmd->appendChild(cmd);
-    cmd->redo(ed);
+    {
+        mu::commandstats::PhaseTimer timer(mu::commandstats::Phase::Undo);
+        cmd->redo(ed);
+    }
+    if (curCmd->coalesce(cmd)) {
+        delete cmd;
+    } else {
+        curCmd->appendChild(cmd);
+    }
 }
 
 //---------------------------------------------------------
@@ -330,7 +339,11 @@ void UndoStack::push1(UndoCommand* cmd)
         }
         return;
     }
-    curCmd->appendChild(cmd);
+    if (curCmd->coalesce(cmd)) {
+        delete cmd;
+    } else {
+        curCmd->appendChild(cmd);
+    }
 }
 
 //---------------------------------------------------------
@@ -364,6 +377,7 @@ void UndoStack::remove(int idx)
 
 void UndoStack::mergeCommands(int startIdx)
 {
+    startIdx = qMax(startIdx - droppedCount, 0);
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -431,10 +445,30 @@ void UndoStack::endMacro(bool rollback)
         list.append(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
+        while (MScore::undoLimit > 0 && curIdx > MScore::undoLimit) {
+            dropOldest();
+        }
     }
     curCmd = 0;
 }
 
+//---------------------------------------------------------
+//   dropOldest
+//    forget the oldest macro, deleting the elements it
+//    holds on to for its undo
+//---------------------------------------------------------
+
+void UndoStack::dropOldest()
+{
+    Q_ASSERT(curIdx > 0);
+    UndoMacro* cmd = list.takeFirst();
+    stateList.erase(stateList.begin());
+    cmd->cleanup(true);
+    delete cmd;
+    --curIdx;
+    ++droppedCount;
+}
+
 //---------------------------------------------------------
 //   reopen
 //---------------------------------------------------------
@@ -471,7 +505,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -576,6 +610,48 @@ void UndoMacro::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   coalesce
+//    a change of the property which the last command of
+//    the macro changed already: the last command keeps
+//    the value to restore, and cmd is not needed. A change
+//    of the same property of another element is added to
+//    the last command, which becomes a ChangeProperties.
+//    Both keep cmd from being appended.
+//---------------------------------------------------------
+
+bool UndoMacro::coalesce(const UndoCommand* cmd)
+{
+    UndoCommand* last = lastChild();
+    if (!last || strcmp(cmd->name(), "ChangeProperty")) {
+        return false;
+    }
+    const ChangeProperty* cp = static_cast<const ChangeProperty*>(cmd);
+    if (!strcmp(last->name(), "ChangeProperty")) {
+        const ChangeProperty* lastCp = static_cast<const ChangeProperty*>(last);
+        if (lastCp->getId() != cp->getId()) {
+            return false;
+        }
+        if (lastCp->getElement() != cp->getElement()) {
+            UndoCommand* cps = new ChangeProperties(lastCp, cp);
+            delete removeChild();
+            appendChild(cps);
+        }
+        return true;
+    }
+    if (!strcmp(last->name(), "ChangeProperties")) {
+        ChangeProperties* cps = static_cast<ChangeProperties*>(last);
+        if (cps->getId() != cp->getId()) {
+            return false;
+        }
+        if (cps->lastElement() != cp->getElement()) {
+            cps->append(cp);
+        }
+        return true;
+    }
+    return false;
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
@@ -1181,6 +1257,7 @@ void ChangePitch::flip(EditData*)
     tpc1  = f_tpc1;
     tpc2  = f_tpc2;
 
+    note->revisionChanged();
     note->triggerLayout();
 }
 
@@ -1223,6 +1300,7 @@ void ChangeFretting::flip(EditData*)
     fret  = f_fret;
     tpc1  = f_tpc1;
     tpc2  = f_tpc2;
+    note->revisionChanged();
     note->triggerLayout();
 }
 
@@ -1283,6 +1361,8 @@ void ChangeElement::flip(EditData*)
         }
     }
     qSwap(oldElement, newElement);
+    oldElement->revisionChanged();
+    newElement->revisionChanged();
     oldElement->triggerLayout();
     newElement->triggerLayout();
     // score->setLayoutAll();
@@ -1350,6 +1430,7 @@ void ChangeKeySig::flip(EditData*)
 
     keysig->setKeySigEvent(ks);
     keysig->setShowCourtesy(showCourtesy);
+    segment->measure()->contentChanged();
 
     // Add/remove the corresponding key events, if appropriate.
     if (evtInStaff) {
@@ -1409,31 +1490,33 @@ void ChangeMeasureLen::flip(EditData*)
 
 TransposeHarmony::TransposeHarmony(Harmony* h, int rtpc, int btpc)
 {
-    harmony = h;
-    rootTpc = rtpc;
-    baseTpc = btpc;
+    add(h, rtpc, btpc);
 }
 
 void TransposeHarmony::flip(EditData*)
 {
-    harmony->realizedHarmony().setDirty(true);   //harmony should be re-realized after transposition
-    int baseTpc1 = harmony->baseTpc();
-    int rootTpc1 = harmony->rootTpc();
-    harmony->setBaseTpc(baseTpc);
-    harmony->setRootTpc(rootTpc);
-    harmony->setXmlText(harmony->harmonyName());
-    harmony->render();
-    rootTpc = rootTpc1;
-    baseTpc = baseTpc1;
+    for (Entry& e : entries) {
+        Harmony* harmony = e.harmony;
+        harmony->realizedHarmony().setDirty(true);   //harmony should be re-realized after transposition
+        int baseTpc1 = harmony->baseTpc();
+        int rootTpc1 = harmony->rootTpc();
+        harmony->setBaseTpc(e.baseTpc);
+        harmony->setRootTpc(e.rootTpc);
+        harmony->setXmlText(harmony->harmonyName());
+        harmony->render();
+        e.rootTpc = rootTpc1;
+        e.baseTpc = baseTpc1;
+    }
 }
 
 //---------------------------------------------------------
 //   ExchangeVoice
 //---------------------------------------------------------
 
-ExchangeVoice::ExchangeVoice(Measure* m, int _val1, int _val2, int _staff)
+ExchangeVoice::ExchangeVoice(Measure* _first, Measure* _last, int _val1, int _val2, int _staff)
 {
-    measure = m;
+    first   = _first;
+    last    = _last;
     val1    = _val1;
     val2    = _val2;
     staff   = _staff;
@@ -1441,13 +1524,12 @@ ExchangeVoice::ExchangeVoice(Measure* m, int _val1, int _val2, int _staff)
 
 void ExchangeVoice::undo(EditData*)
 {
-    measure->exchangeVoice(val2, val1, staff);
-    measure->checkMultiVoices(staff);
+    first->score()->exchangeVoice(first, last, val2, val1, staff);
 }
 
 void ExchangeVoice::redo(EditData*)
 {
-    measure->exchangeVoice(val1, val2, staff);
+    first->score()->exchangeVoice(first, last, val1, val2, staff);
 }
 
 //---------------------------------------------------------
@@ -1788,7 +1870,11 @@ void ChangeStyleVal::flip(EditData*)
         default:
             break;
         }
-        score->styleChanged();
+        if (idx == Sid::concertPitch) {
+            score->concertPitchChanged();
+        } else {
+            score->styleChanged();
+        }
     }
     value = v;
 }
@@ -1844,6 +1930,7 @@ void ChangeVelocity::flip(EditData*)
     note->setVeloOffset(veloOffset);
     veloType   = t;
     veloOffset = o;
+    note->revisionChanged();
 }
 
 //---------------------------------------------------------
@@ -2187,6 +2274,7 @@ void ChangeNoteEventList::flip(EditData*)
     note->setPlayEvents(newEvents);
     // Save copy of replaced list.
     newEvents = nel;
+    note->revisionChanged();
     // Get a copy of the current playEventType.
     PlayEventType petval = note->chord()->playEventType();
     // Replace current setting with new setting.
@@ -2212,6 +2300,7 @@ void ChangeChordPlayEventType::flip(EditData*)
     PlayEventType curPetype = chord->playEventType();
     chord->setPlayEventType(petype);
     petype = curPetype;
+    chord->revisionChanged();
 }
 
 //---------------------------------------------------------
@@ -2289,6 +2378,7 @@ void ChangeClefType::flip(EditData*)
 
     clef->staff()->setClef(clef);
     Segment* segment = clef->segment();
+    segment->measure()->contentChanged();
     updateNoteLines(segment, clef->track());
     clef->triggerLayoutAll();        // TODO: reduce layout to clef range
 
@@ -2321,15 +2411,112 @@ void MoveStaff::flip(EditData*)
 
 void ChangeProperty::flip(EditData*)
 {
-    qDebug() << element->name() << int(id) << "(" << propertyName(id) << ")" << element->getProperty(id) << "->" << property;
+    qDebug() << element->name() << int(id) << "(" << propertyName(id) << ")" << element->getProperty(id) << "->" << property.toVariant();
 
-    QVariant v       = element->getProperty(id);
+    PropertyValue v  = element->getPropertyValue(id);
     PropertyFlags ps = element->propertyFlags(id);
 
-    element->setProperty(id, property);
+    element->setPropertyValue(id, property);
     element->setPropertyFlags(id, flags);
     property = v;
     flags = ps;
+    element->revisionChanged();
+
+    // as the visibility or the staff of an element, which may empty a staff
+    if (element->isElement()) {
+        if (Measure* m = toElement(element)->findMeasure()) {
+            m->contentChanged();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeProperties
+//---------------------------------------------------------
+
+ChangeProperties::ChangeProperties(const ChangeProperty* cp1, const ChangeProperty* cp2)
+    : id(cp1->getId())
+{
+    append(cp1);
+    append(cp2);
+}
+
+//---------------------------------------------------------
+//   ChangeProperties::append
+//    cp is done already and keeps the value to restore
+//---------------------------------------------------------
+
+void ChangeProperties::append(const ChangeProperty* cp)
+{
+    items.push_back(Item { cp->getElement(), cp->value(), cp->getFlags() });
+}
+
+//---------------------------------------------------------
+//   ChangeProperties::flipItem
+//    as ChangeProperty::flip; a measure of which the
+//    content changed is told so once for its elements
+//---------------------------------------------------------
+
+void ChangeProperties::flipItem(Item& item, Pid id, Measure*& changedMeasure)
+{
+    PropertyValue v  = item.element->getPropertyValue(id);
+    PropertyFlags ps = item.element->propertyFlags(id);
+
+    item.element->setPropertyValue(id, item.property);
+    item.element->setPropertyFlags(id, item.flags);
+    item.property = v;
+    item.flags = ps;
+    item.element->revisionChanged();
+
+    if (item.element->isElement()) {
+        Measure* m = toElement(item.element)->findMeasure();
+        if (m && m != changedMeasure) {
+            m->contentChanged();
+            changedMeasure = m;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeProperties::undo
+//---------------------------------------------------------
+
+void ChangeProperties::undo(EditData*)
+{
+    Measure* changedMeasure = nullptr;
+    for (auto i = items.rbegin(); i != items.rend(); ++i) {
+        flipItem(*i, id, changedMeasure);
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeProperties::redo
+//---------------------------------------------------------
+
+void ChangeProperties::redo(EditData*)
+{
+    Measure* changedMeasure = nullptr;
+    for (Item& item : items) {
+        flipItem(item, id, changedMeasure);
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeProperties::isFiltered
+//---------------------------------------------------------
+
+bool ChangeProperties::isFiltered(UndoCommand::Filter f, const Element* target) const
+{
+    if (f != UndoCommand::Filter::ChangePropertyLinked) {
+        return false;
+    }
+    const auto links = target->linkList();
+    for (const Item& item : items) {
+        if (!links.contains(item.element)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 //---------------------------------------------------------
@@ -2527,6 +2714,7 @@ void ChangeNoteEvent::flip(EditData*)
     NoteEvent e = *oldEvent;
     *oldEvent   = newEvent;
     newEvent    = e;
+    note->revisionChanged();
     // Get a copy of the current playEventType.
     PlayEventType petval = note->chord()->playEventType();
     // Replace current setting with new setting.
@@ -40,6 +40,8 @@
 #include "drumset.h"
 #include "rest.h"
 #include "fret.h"
+#include "elementpool.h"
+#include "propertyvalue.h"
 
 #include "framework/midi_old/midipatch.h"
 
@@ -116,6 +118,7 @@ public:
     virtual void redo(EditData*);
     void appendChild(UndoCommand* cmd) { childList.append(cmd); }
     UndoCommand* removeChild() { return childList.takeLast(); }
+    UndoCommand* lastChild() const { return childList.isEmpty() ? nullptr : childList.last(); }
     int childCount() const { return childList.size(); }
     void unwind();
     const QList<UndoCommand*>& commands() const { return childList; }
@@ -163,6 +166,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     bool empty() const { return childCount() == 0; }
+    bool coalesce(const UndoCommand* cmd);
     void append(UndoMacro&& other);
 
     static bool canRecordSelectedElement(const Element* e);
@@ -182,8 +186,10 @@ class UndoStack
     int nextState;
     int cleanState;
     int curIdx;
+    int droppedCount;         // oldest macros reclaimed, the indices seen from outside count them
 
     void remove(int idx);
+    void dropOldest();
 
 public:
     UndoStack();
@@ -200,9 +206,10 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    int getCurIdx() const { return curIdx; }
+    int getCurIdx() const { return droppedCount + curIdx; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
+    const QList<UndoMacro*>& macros() const { return list; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
     UndoMacro* prev() const { return curIdx > 1 ? list[curIdx - 2] : 0; }
     void undo(EditData*);
@@ -470,27 +477,34 @@ public:
 
 class TransposeHarmony : public UndoCommand
 {
-    Harmony* harmony;
-    int rootTpc, baseTpc;
+    struct Entry {
+        Harmony* harmony;
+        int rootTpc, baseTpc;
+    };
+    std::vector<Entry> entries;
     void flip(EditData*) override;
 
 public:
+    TransposeHarmony() {}
     TransposeHarmony(Harmony*, int rootTpc, int baseTpc);
+    void add(Harmony* h, int rootTpc, int baseTpc) { entries.push_back({ h, rootTpc, baseTpc }); }
     UNDO_NAME("TransposeHarmony")
 };
 
 //---------------------------------------------------------
 //   ExchangeVoice
+//    in the measures first to last
 //---------------------------------------------------------
 
 class ExchangeVoice : public UndoCommand
 {
-    Measure* measure;
+    Measure* first;
+    Measure* last;
     int val1, val2;
     int staff;
 
 public:
-    ExchangeVoice(Measure*,int val1, int val2, int staff);
+    ExchangeVoice(Measure* first, Measure* last, int val1, int val2, int staff);
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("ExchangeVoice")
@@ -1105,20 +1119,24 @@ public:
 
 class ChangeProperty : public UndoCommand
 {
+    ELEMENT_POOL_ALLOCATION
+
 protected:
     ScoreElement* element;
+    PropertyValue property;
     Pid id;
-    QVariant property;
     PropertyFlags flags;
 
     void flip(EditData*) override;
 
 public:
     ChangeProperty(ScoreElement* e, Pid i, const QVariant& v, PropertyFlags ps = PropertyFlags::NOSTYLE)
-        : element(e), id(i), property(v), flags(ps) {}
+        : element(e), property(v), id(i), flags(ps) {}
     Pid getId() const { return id; }
     ScoreElement* getElement() const { return element; }
-    QVariant data() const { return property; }
+    QVariant data() const { return property.toVariant(); }
+    const PropertyValue& value() const { return property; }
+    PropertyFlags getFlags() const { return flags; }
     UNDO_NAME("ChangeProperty")
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override
@@ -1127,6 +1145,39 @@ public:
     }
 };
 
+//---------------------------------------------------------
+//   ChangeProperties
+//    the same property of several elements, as changed for
+//    a selection and the linked elements: one command in
+//    place of a ChangeProperty for each element
+//---------------------------------------------------------
+
+class ChangeProperties : public UndoCommand
+{
+    struct Item {
+        ScoreElement* element;
+        PropertyValue property;
+        PropertyFlags flags;
+    };
+
+    std::vector<Item> items;
+    Pid id;
+
+    static void flipItem(Item& item, Pid id, Measure*& changedMeasure);
+
+public:
+    ChangeProperties(const ChangeProperty* cp1, const ChangeProperty* cp2);
+    void append(const ChangeProperty* cp);
+    Pid getId() const { return id; }
+    ScoreElement* lastElement() const { return items.back().element; }
+
+    void undo(EditData*) override;
+    void redo(EditData*) override;
+    UNDO_NAME("ChangeProperties")
+
+    bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
+};
+
 //---------------------------------------------------------
 //   ChangeBracketProperty
 //---------------------------------------------------------
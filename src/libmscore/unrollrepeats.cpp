@@ -96,12 +96,11 @@ static void removeRepeatMarkings(Score* score)
     score->lastMeasure()->setEndBarLineType(BarLineType::END, false);
     Segment* last = score->lastMeasure()->segments().last();
     if (last->segmentType() == SegmentType::EndBarLine) {
-        auto els = last->elist();
-        for (uint i = 0; i < els.size(); i++) {
-            if (!els[i]) {
+        for (Element* e : last->elist()) {
+            if (!e) {
                 continue;
             }
-            toBarLine(els[i])->setBarLineType(BarLineType::END);
+            toBarLine(e)->setBarLineType(BarLineType::END);
         }
     }
 }
@@ -55,18 +55,17 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
-    Measure* lm = 0;
-    for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-        if (tick < m->tick()) {
-            Q_ASSERT(lm);
-            return lm;
-        }
-        lm = m;
+    Measure* lm = _measures.findMeasure(tick);
+    if (lm && lm->nextMeasure()) {
+        return lm;
     }
     // check last measure
-    if (lm && (tick >= lm->tick()) && (tick <= lm->endTick())) {
+    if (lm && (tick <= lm->endTick())) {
         return lm;
     }
+    if (!lm) {
+        lm = lastMeasure();
+    }
     qDebug("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
     return 0;
 }
@@ -156,19 +155,18 @@ Segment* Score::tick2segment(const Fraction& t, bool first, SegmentType st, bool
         qDebug("no measure for tick %d", tick.ticks());
         return 0;
     }
-    for (Segment* segment   = m->first(st); segment;) {
-        Fraction t1       = segment->tick();
-        Segment* nsegment = segment->next(st);
-        if (tick == t1) {
+    Fraction rtick = tick - m->tick();
+    Segment* found = 0;
+    for (Segment* segment = m->segments().firstAt(rtick); segment && segment->rtick() == rtick; segment = segment->next()) {
+        if (segment->segmentType() & st) {
             if (first) {
                 return segment;
-            } else {
-                if (!nsegment || tick < nsegment->tick()) {
-                    return segment;
-                }
             }
+            found = segment;
         }
-        segment = nsegment;
+    }
+    if (found) {
+        return found;
     }
     qDebug("no segment for tick %d (start search at %d (measure %d))", tick.ticks(), t.ticks(), m->tick().ticks());
     return 0;
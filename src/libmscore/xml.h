@@ -22,6 +22,7 @@
 #include "interval.h"
 #include "element.h"
 #include "select.h"
+#include "xmltokens.h"
 
 namespace Ms {
 enum class PlaceText : char;
@@ -64,6 +65,25 @@ public:
     int assignLocalIndex(const Location& mainElementInfo);
 };
 
+//---------------------------------------------------------
+//   XmlTag
+//    the name of the current element. Compares with
+//    string literals as Latin-1, tag and property names
+//    are ASCII; QStringRef converts the literal to a
+//    QString for each comparison
+//---------------------------------------------------------
+
+class XmlTag : public QStringRef
+{
+public:
+    XmlTag() = default;
+    XmlTag(const QStringRef& s)
+        : QStringRef(s) {}
+
+    bool operator==(const char* s) const { return static_cast<const QStringRef&>(*this) == QLatin1String(s); }
+    bool operator!=(const char* s) const { return !operator==(s); }
+};
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -107,6 +127,14 @@ class XmlReader : public QXmlStreamReader
 
     qint64 _offsetLines { 0 };
 
+    std::shared_ptr<const XmlTokens> _tokens;     // replayed instead of parsing the document
+    int _tokenIdx { -1 };
+    QString _tokenError;
+    std::shared_ptr<XmlTokens> _recorded;         // the tokens read so far, if recording
+
+    const XmlTokens::Token& token() const { return _tokens->token(_tokenIdx); }
+    bool findAttribute(const char* s, QStringRef* value) const;
+
 public:
     XmlReader(QFile* f)
         : QXmlStreamReader(f), docName(f->fileName()) {}
@@ -116,6 +144,8 @@ public:
         : QXmlStreamReader(d), docName(st) {}
     XmlReader(const QString& d, const QString& st = QString())
         : QXmlStreamReader(d), docName(st) {}
+    XmlReader(std::shared_ptr<const XmlTokens> tokens, const QString& st = QString())
+        : docName(st), _tokens(tokens) {}
     XmlReader(const XmlReader&) = delete;
     XmlReader& operator=(const XmlReader&) = delete;
     ~XmlReader();
@@ -123,8 +153,35 @@ public:
     bool hasAccidental { false };                       // used for userAccidental backward compatibility
     void unknown();
 
+    // the QXmlStreamReader interface, replaying the tokens
+    // if the reader was made from XmlTokens
+    TokenType readNext();
+    bool readNextStartElement();
+    QString readElementText(ReadElementTextBehaviour behaviour = ErrorOnUnexpectedElement);
+    void skipCurrentElement();
+    TokenType tokenType() const;
+    QString tokenString() const;
+    bool atEnd() const;
+    bool isStartElement() const { return tokenType() == StartElement; }
+    bool isEndElement() const { return tokenType() == EndElement; }
+    bool isCharacters() const { return tokenType() == Characters; }
+    bool isWhitespace() const;
+    XmlTag name() const;
+    QStringRef text() const;
+    QXmlStreamAttributes attributes() const;
+    qint64 lineNumber() const;
+    qint64 columnNumber() const;
+    Error error() const;
+    QString errorString() const;
+    bool hasError() const { return error() != NoError; }
+    void raiseError(const QString& message = QString());
+
+    // records the tokens read from the document from now on
+    void recordTokens() { _recorded = std::make_shared<XmlTokens>(); }
+    std::shared_ptr<const XmlTokens> recordedTokens();
+
     // attribute helper routines:
-    QString attribute(const char* s) const { return attributes().value(s).toString(); }
+    QString attribute(const char* s) const;
     QString attribute(const char* s, const QString&) const;
     int intAttribute(const char* s) const;
     int intAttribute(const char* s, int _default) const;
@@ -249,6 +306,12 @@ class XmlWriter : public QTextStream
     bool _recordElements = false;
 
     void putLevel();
+    void endLine();
+    void putNumber(int n);
+    void putNumber(qint64 n);
+    void putNumber(double d);
+    void putEscaped(const QString& s);
+    static QStringRef tagName(const QString& s);
 
 public:
     XmlWriter(Score*);
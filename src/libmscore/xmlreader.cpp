@@ -39,23 +39,340 @@ XmlReader::~XmlReader()
     }
 }
 
+//---------------------------------------------------------
+//   readNext
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType XmlReader::readNext()
+{
+    if (_tokens) {
+        if (!_tokenError.isEmpty()) {
+            return Invalid;
+        }
+        if (_tokenIdx + 1 >= _tokens->size()) {
+            _tokenError = QObject::tr("Premature end of document.");
+            return Invalid;
+        }
+        return TokenType(_tokens->token(++_tokenIdx).type);
+    }
+    TokenType t = QXmlStreamReader::readNext();
+    if (_recorded && t != Invalid) {
+        _recorded->append(*this);
+    }
+    return t;
+}
+
+//---------------------------------------------------------
+//   readNextStartElement
+//    QXmlStreamReader::readNextStartElement() et al. do not
+//    use readNext(), so they are done here for replaying and
+//    recording
+//---------------------------------------------------------
+
+bool XmlReader::readNextStartElement()
+{
+    if (!_tokens && !_recorded) {
+        return QXmlStreamReader::readNextStartElement();
+    }
+    while (readNext() != Invalid) {
+        if (isEndElement()) {
+            return false;
+        } else if (isStartElement()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------
+//   readElementText
+//---------------------------------------------------------
+
+QString XmlReader::readElementText(ReadElementTextBehaviour behaviour)
+{
+    if (!_tokens && !_recorded) {
+        return QXmlStreamReader::readElementText(behaviour);
+    }
+    QString result;
+    if (!isStartElement()) {
+        return result;
+    }
+    for (;;) {
+        switch (readNext()) {
+        case Characters:
+        case EntityReference:
+            if (result.isEmpty() && _tokens) {
+                result = _tokens->string(token().text);         // shared, not copied
+            } else {
+                result += text();
+            }
+            break;
+        case EndElement:
+            return result;
+        case ProcessingInstruction:
+        case Comment:
+            break;
+        case StartElement:
+            if (behaviour == SkipChildElements) {
+                skipCurrentElement();
+                break;
+            } else if (behaviour == IncludeChildElements) {
+                result += readElementText(behaviour);
+                break;
+            }
+            Q_FALLTHROUGH();
+        default:
+            if (hasError() || behaviour == ErrorOnUnexpectedElement) {
+                if (!hasError()) {
+                    raiseError(QObject::tr("Expected character data."));
+                }
+                return result;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   skipCurrentElement
+//---------------------------------------------------------
+
+void XmlReader::skipCurrentElement()
+{
+    if (!_tokens && !_recorded) {
+        QXmlStreamReader::skipCurrentElement();
+        return;
+    }
+    int depth = 1;
+    while (depth && readNext() != Invalid) {
+        if (isEndElement()) {
+            --depth;
+        } else if (isStartElement()) {
+            ++depth;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   tokenType
+//---------------------------------------------------------
+
+QXmlStreamReader::TokenType XmlReader::tokenType() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::tokenType();
+    }
+    if (!_tokenError.isEmpty()) {
+        return Invalid;
+    }
+    return _tokenIdx < 0 ? NoToken : TokenType(token().type);
+}
+
+//---------------------------------------------------------
+//   tokenString
+//---------------------------------------------------------
+
+QString XmlReader::tokenString() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::tokenString();
+    }
+    static const char* const names[] = {
+        "NoToken", "Invalid", "StartDocument", "EndDocument", "StartElement", "EndElement",
+        "Characters", "Comment", "DTD", "EntityReference", "ProcessingInstruction"
+    };
+    return QString::fromLatin1(names[tokenType()]);
+}
+
+//---------------------------------------------------------
+//   atEnd
+//---------------------------------------------------------
+
+bool XmlReader::atEnd() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::atEnd();
+    }
+    return !_tokenError.isEmpty() || tokenType() == EndDocument;
+}
+
+//---------------------------------------------------------
+//   isWhitespace
+//---------------------------------------------------------
+
+bool XmlReader::isWhitespace() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::isWhitespace();
+    }
+    return tokenType() == Characters && token().whitespace;
+}
+
+//---------------------------------------------------------
+//   name
+//---------------------------------------------------------
+
+XmlTag XmlReader::name() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::name();
+    }
+    return _tokenIdx < 0 ? XmlTag() : XmlTag(QStringRef(&_tokens->string(token().name)));
+}
+
+//---------------------------------------------------------
+//   text
+//---------------------------------------------------------
+
+QStringRef XmlReader::text() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::text();
+    }
+    return _tokenIdx < 0 ? QStringRef() : QStringRef(&_tokens->string(token().text));
+}
+
+//---------------------------------------------------------
+//   attributes
+//---------------------------------------------------------
+
+QXmlStreamAttributes XmlReader::attributes() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::attributes();
+    }
+    QXmlStreamAttributes attrs;
+    if (tokenType() == StartElement) {
+        const XmlTokens::Token& t = token();
+        for (quint32 i = t.attributes; i < t.attributes + t.attributeCount; ++i) {
+            const XmlTokens::Attribute& a = _tokens->attribute(i);
+            attrs.append(_tokens->string(a.name), _tokens->string(a.value));
+        }
+    }
+    return attrs;
+}
+
+//---------------------------------------------------------
+//   lineNumber
+//---------------------------------------------------------
+
+qint64 XmlReader::lineNumber() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::lineNumber();
+    }
+    return _tokenIdx < 0 ? 0 : token().line;
+}
+
+//---------------------------------------------------------
+//   columnNumber
+//---------------------------------------------------------
+
+qint64 XmlReader::columnNumber() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::columnNumber();
+    }
+    return _tokenIdx < 0 ? 0 : token().column;
+}
+
+//---------------------------------------------------------
+//   error
+//---------------------------------------------------------
+
+QXmlStreamReader::Error XmlReader::error() const
+{
+    if (!_tokens) {
+        return QXmlStreamReader::error();
+    }
+    return _tokenError.isEmpty() ? NoError : CustomError;
+}
+
+//---------------------------------------------------------
+//   errorString
+//---------------------------------------------------------
+
+QString XmlReader::errorString() const
+{
+    return _tokens ? _tokenError : QXmlStreamReader::errorString();
+}
+
+//---------------------------------------------------------
+//   raiseError
+//---------------------------------------------------------
+
+void XmlReader::raiseError(const QString& message)
+{
+    if (!_tokens) {
+        QXmlStreamReader::raiseError(message);
+        return;
+    }
+    _tokenError = message.isEmpty() ? QObject::tr("Unknown error") : message;
+}
+
+//---------------------------------------------------------
+//   recordedTokens
+//    reads the rest of the document, so that replaying
+//    gives all of it; nullptr if the document could not
+//    be read
+//---------------------------------------------------------
+
+std::shared_ptr<const XmlTokens> XmlReader::recordedTokens()
+{
+    if (!_recorded) {
+        return nullptr;
+    }
+    while (!atEnd()) {
+        readNext();
+    }
+    std::shared_ptr<const XmlTokens> tokens = std::move(_recorded);
+    _recorded.reset();
+    return hasError() ? nullptr : tokens;
+}
+
+//---------------------------------------------------------
+//   findAttribute
+//---------------------------------------------------------
+
+bool XmlReader::findAttribute(const char* s, QStringRef* value) const
+{
+    const QLatin1String name(s);
+    if (!_tokens) {
+        const QXmlStreamAttributes attrs = QXmlStreamReader::attributes();
+        for (const QXmlStreamAttribute& a : attrs) {
+            if (a.qualifiedName() == name) {
+                *value = a.value();
+                return true;
+            }
+        }
+        return false;
+    }
+    if (tokenType() != StartElement) {
+        return false;
+    }
+    const XmlTokens::Token& t = token();
+    for (quint32 i = t.attributes; i < t.attributes + t.attributeCount; ++i) {
+        const XmlTokens::Attribute& a = _tokens->attribute(i);
+        if (_tokens->string(a.name) == name) {
+            *value = QStringRef(&_tokens->string(a.value));
+            return true;
+        }
+    }
+    return false;
+}
+
 //---------------------------------------------------------
 //   intAttribute
 //---------------------------------------------------------
 
 int XmlReader::intAttribute(const char* s, int _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        // return attributes().value(s).toString().toInt();
-        return attributes().value(s).toInt();
-    } else {
-        return _default;
-    }
+    QStringRef value;
+    return findAttribute(s, &value) ? value.toInt() : _default;
 }
 
 int XmlReader::intAttribute(const char* s) const
 {
-    return attributes().value(s).toInt();
+    return intAttribute(s, 0);
 }
 
 //---------------------------------------------------------
@@ -64,29 +381,28 @@ int XmlReader::intAttribute(const char* s) const
 
 double XmlReader::doubleAttribute(const char* s) const
 {
-    return attributes().value(s).toDouble();
+    return doubleAttribute(s, 0.0);
 }
 
 double XmlReader::doubleAttribute(const char* s, double _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        return attributes().value(s).toDouble();
-    } else {
-        return _default;
-    }
+    QStringRef value;
+    return findAttribute(s, &value) ? value.toDouble() : _default;
 }
 
 //---------------------------------------------------------
 //   attribute
 //---------------------------------------------------------
 
+QString XmlReader::attribute(const char* s) const
+{
+    return attribute(s, QString());
+}
+
 QString XmlReader::attribute(const char* s, const QString& _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        return attributes().value(s).toString();
-    } else {
-        return _default;
-    }
+    QStringRef value;
+    return findAttribute(s, &value) ? value.toString() : _default;
 }
 
 //---------------------------------------------------------
@@ -95,7 +411,8 @@ QString XmlReader::attribute(const char* s, const QString& _default) const
 
 bool XmlReader::hasAttribute(const char* s) const
 {
-    return attributes().hasAttribute(s);
+    QStringRef value;
+    return findAttribute(s, &value);
 }
 
 //---------------------------------------------------------
@@ -205,7 +522,7 @@ Fraction XmlReader::readFraction()
 
 void XmlReader::unknown()
 {
-    if (QXmlStreamReader::error()) {
+    if (error()) {
         qDebug("%s ", qPrintable(errorString()));
     }
     if (!docName.isEmpty()) {
@@ -0,0 +1,518 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "xmltokens.h"
+
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <QtAlgorithms>
+
+namespace Ms {
+//---------------------------------------------------------
+//   find
+//    the first of the bytes a, b, c, d in [p, end), end if
+//    there is none. 16 bytes are compared at a time where
+//    SSE2 is available.
+//---------------------------------------------------------
+
+static const char* find(const char* p, const char* end, char a, char b, char c, char d)
+{
+#if defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    const __m128i vd = _mm_set1_epi8(d);
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(v, vc), _mm_cmpeq_epi8(v, vd)));
+        const int mask = _mm_movemask_epi8(eq);
+        if (mask) {
+            return p + qCountTrailingZeroBits(quint32(mask));
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == a || *p == b || *p == c || *p == d) {
+            return p;
+        }
+    }
+    return end;
+}
+
+static const char* find(const char* p, const char* end, char a)
+{
+    return find(p, end, a, a, a, a);
+}
+
+static const char* find(const char* p, const char* end, const char* s)
+{
+    const size_t n = strlen(s);
+    for (p = find(p, end, s[0]); size_t(end - p) >= n; p = find(p + 1, end, s[0])) {
+        if (memcmp(p, s, n) == 0) {
+            return p;
+        }
+    }
+    return end;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+}
+
+//---------------------------------------------------------
+//   XmlTokens::Tokenizer
+//    a tokenizer for well-formed UTF-8 documents, as score
+//    files are, which gives the tokens QXmlStreamReader
+//    gives for them. The names and texts are interned by
+//    their UTF-8 bytes, so that a string repeated in the
+//    document is converted to UTF-16 once. Anything it
+//    does not know, like a DTD, an entity which is not
+//    predefined or another encoding, fails the document,
+//    which is then read by QXmlStreamReader. The columns
+//    count bytes.
+//---------------------------------------------------------
+
+class XmlTokens::Tokenizer
+{
+    enum class Text : char {
+        CONTENT, ATTRIBUTE, RAW
+    };
+
+    XmlTokens& _t;
+    const char* _p;
+    const char* const _end;
+    int _line { 1 };
+    const char* _lineStart;
+    const char* _counted;
+    std::vector<std::string_view> _elements;                // open elements
+    std::unordered_map<std::string_view, quint32> _index;
+    std::deque<std::string> _decoded;                       // the keys of _index which are not in the document
+    std::string _buffer;
+
+    bool startsWith(const char* s) const
+    {
+        const size_t n = strlen(s);
+        return size_t(_end - _p) >= n && memcmp(_p, s, n) == 0;
+    }
+
+    const char* skipSpace(const char* p) const
+    {
+        while (p < _end && isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+
+    const char* nameEnd(const char* p) const
+    {
+        while (p < _end && !isSpace(*p) && *p != '/' && *p != '>' && *p != '=' && *p != '<') {
+            ++p;
+        }
+        return p;
+    }
+
+    quint32 noAttributes() const { return quint32(_t._attributes.size()); }
+
+    quint32 intern(std::string_view s);
+    bool decode(std::string_view s, Text mode, std::string_view& result);
+    void append(QXmlStreamReader::TokenType type, quint32 name, quint32 text, bool whitespace, quint32 attributes);
+
+    bool readDeclaration();
+    bool readText(const char* end);
+    bool readStartElement();
+    bool readEndElement();
+    bool readMarkup(const char* begin, QXmlStreamReader::TokenType type);
+
+public:
+    Tokenizer(XmlTokens& t, const char* data, int size)
+        : _t(t), _p(data), _end(data + size), _lineStart(data), _counted(data) {}
+
+    bool read();
+};
+
+//---------------------------------------------------------
+//   intern
+//    s is either in the document or in _buffer
+//---------------------------------------------------------
+
+quint32 XmlTokens::Tokenizer::intern(std::string_view s)
+{
+    if (s.empty()) {
+        return 0;
+    }
+    auto i = _index.find(s);
+    if (i != _index.end()) {
+        return i->second;
+    }
+    const quint32 idx = quint32(_t._strings.size());
+    _t._strings.push_back(QString::fromUtf8(s.data(), int(s.size())));
+    if (s.data() == _buffer.data()) {
+        _decoded.emplace_back(s);
+        s = _decoded.back();
+    }
+    _index.emplace(s, idx);
+    return idx;
+}
+
+//---------------------------------------------------------
+//   decode
+//    s with the line ends normalized and, unless it is
+//    RAW, the references replaced; an attribute value has
+//    its whitespace normalized too. result is s if there
+//    is nothing to change, else _buffer.
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::decode(std::string_view s, Text mode, std::string_view& result)
+{
+    const char* p = s.data();
+    const char* end = p + s.size();
+    auto next = [mode, end](const char* q) {
+        switch (mode) {
+        case Text::CONTENT:
+            return find(q, end, '&', '\r', '&', '&');
+        case Text::ATTRIBUTE:
+            return find(q, end, '&', '\r', '\n', '\t');
+        case Text::RAW:
+            break;
+        }
+        return find(q, end, '\r');
+    };
+
+    const char* q = next(p);
+    if (q == end) {
+        result = s;
+        return true;
+    }
+    _buffer.assign(p, q);
+    while (q < end) {
+        if (*q == '&') {
+            const char* semi = find(q, end, ';');
+            if (semi == end) {
+                return false;
+            }
+            const std::string_view ref(q + 1, semi - q - 1);
+            if (ref == "lt") {
+                _buffer += '<';
+            } else if (ref == "gt") {
+                _buffer += '>';
+            } else if (ref == "amp") {
+                _buffer += '&';
+            } else if (ref == "apos") {
+                _buffer += '\'';
+            } else if (ref == "quot") {
+                _buffer += '"';
+            } else if (ref.size() > 1 && ref[0] == '#') {
+                const bool hex = ref[1] == 'x';
+                bool ok = false;
+                const uint c = QByteArray(ref.data() + (hex ? 2 : 1), int(ref.size()) - (hex ? 2 : 1)).toUInt(&ok, hex ? 16 : 10);
+                if (!ok || c == 0 || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+                    return false;
+                }
+                if (c < 0x80) {
+                    _buffer += char(c);
+                } else if (c < 0x800) {
+                    _buffer += char(0xC0 | (c >> 6));
+                    _buffer += char(0x80 | (c & 0x3F));
+                } else if (c < 0x10000) {
+                    _buffer += char(0xE0 | (c >> 12));
+                    _buffer += char(0x80 | ((c >> 6) & 0x3F));
+                    _buffer += char(0x80 | (c & 0x3F));
+                } else {
+                    _buffer += char(0xF0 | (c >> 18));
+                    _buffer += char(0x80 | ((c >> 12) & 0x3F));
+                    _buffer += char(0x80 | ((c >> 6) & 0x3F));
+                    _buffer += char(0x80 | (c & 0x3F));
+                }
+            } else {
+                return false;
+            }
+            q = semi + 1;
+        } else if (*q == '\r') {
+            _buffer += mode == Text::ATTRIBUTE ? ' ' : '\n';
+            q += (q + 1 < end && q[1] == '\n') ? 2 : 1;
+        } else {
+            // a newline or a tab in an attribute value
+            _buffer += ' ';
+            ++q;
+        }
+        const char* n = next(q);
+        _buffer.append(q, n);
+        q = n;
+    }
+    result = _buffer;
+    return true;
+}
+
+//---------------------------------------------------------
+//   append
+//    a token ending at _p, its attributes are the ones
+//    from attributes on
+//---------------------------------------------------------
+
+void XmlTokens::Tokenizer::append(QXmlStreamReader::TokenType type, quint32 name, quint32 text, bool whitespace,
+                                  quint32 attributes)
+{
+    while (const char* nl = static_cast<const char*>(memchr(_counted, '\n', _p - _counted))) {
+        ++_line;
+        _counted = _lineStart = nl + 1;
+    }
+    _counted = _p;
+
+    Token t;
+    t.type = quint8(type);
+    t.whitespace = whitespace;
+    t.name = name;
+    t.text = text;
+    t.attributes = attributes;
+    t.attributeCount = quint32(_t._attributes.size()) - attributes;
+    t.line = _line;
+    t.column = qint32(_p - _lineStart);
+    _t._tokens.push_back(t);
+}
+
+//---------------------------------------------------------
+//   readDeclaration
+//    only UTF-8 is read
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::readDeclaration()
+{
+    const char* end = find(_p, _end, "?>");
+    if (end == _end) {
+        return false;
+    }
+    const char* e = find(_p, end, "encoding");
+    if (e != end) {
+        const char* quote = find(e, end, '"', '\'', '"', '"');
+        const char* quoteEnd = quote == end ? end : find(quote + 1, end, *quote);
+        if (quoteEnd == end) {
+            return false;
+        }
+        const QByteArray encoding = QByteArray(quote + 1, int(quoteEnd - quote - 1)).toUpper();
+        if (encoding != "UTF-8" && encoding != "UTF8") {
+            return false;
+        }
+    }
+    _p = end + 2;
+    return true;
+}
+
+//---------------------------------------------------------
+//   readText
+//    up to end, which is where the next markup begins
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::readText(const char* end)
+{
+    const std::string_view s(_p, end - _p);
+    bool whitespace = true;
+    for (char c : s) {
+        if (!isSpace(c)) {
+            whitespace = false;
+            break;
+        }
+    }
+    if (_elements.empty()) {
+        // outside of the document element only whitespace is allowed, and not reported
+        _p = end;
+        return whitespace;
+    }
+    std::string_view text;
+    if (!decode(s, Text::CONTENT, text)) {
+        return false;
+    }
+    _p = end;
+    append(QXmlStreamReader::Characters, 0, intern(text), whitespace, noAttributes());
+    return true;
+}
+
+//---------------------------------------------------------
+//   readStartElement
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::readStartElement()
+{
+    const char* p = _p + 1;
+    const char* e = nameEnd(p);
+    if (e == p) {
+        return false;
+    }
+    const std::string_view name(p, e - p);
+    const quint32 attributes = quint32(_t._attributes.size());
+    bool empty = false;
+
+    for (p = e;;) {
+        p = skipSpace(p);
+        if (p == _end) {
+            return false;
+        }
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+        if (*p == '/') {
+            if (p + 1 == _end || p[1] != '>') {
+                return false;
+            }
+            p += 2;
+            empty = true;
+            break;
+        }
+        e = nameEnd(p);
+        if (e == p) {
+            return false;
+        }
+        const quint32 attributeName = intern(std::string_view(p, e - p));
+        p = skipSpace(e);
+        if (p == _end || *p != '=') {
+            return false;
+        }
+        p = skipSpace(p + 1);
+        if (p == _end || (*p != '"' && *p != '\'')) {
+            return false;
+        }
+        const char quote = *p++;
+        e = find(p, _end, quote, '<', quote, quote);
+        if (e == _end || *e == '<') {
+            return false;
+        }
+        std::string_view value;
+        if (!decode(std::string_view(p, e - p), Text::ATTRIBUTE, value)) {
+            return false;
+        }
+        _t._attributes.push_back({ attributeName, intern(value) });
+        p = e + 1;
+    }
+
+    _p = p;
+    const quint32 n = intern(name);
+    append(QXmlStreamReader::StartElement, n, 0, false, attributes);
+    if (empty) {
+        append(QXmlStreamReader::EndElement, n, 0, false, noAttributes());
+    } else {
+        _elements.push_back(name);
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   readEndElement
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::readEndElement()
+{
+    const char* p = _p + 2;
+    const char* e = nameEnd(p);
+    const std::string_view name(p, e - p);
+    p = skipSpace(e);
+    if (p == _end || *p != '>' || _elements.empty() || _elements.back() != name) {
+        return false;
+    }
+    _elements.pop_back();
+    _p = p + 1;
+    append(QXmlStreamReader::EndElement, intern(name), 0, false, noAttributes());
+    return true;
+}
+
+//---------------------------------------------------------
+//   readMarkup
+//    a comment, a CDATA section or a processing
+//    instruction, its text from begin on
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::readMarkup(const char* begin, QXmlStreamReader::TokenType type)
+{
+    const char* close = type == QXmlStreamReader::Comment ? "-->" : (type == QXmlStreamReader::Characters ? "]]>" : "?>");
+    const char* e = find(begin, _end, close);
+    if (e == _end || (type == QXmlStreamReader::Characters && _elements.empty())) {
+        return false;
+    }
+    std::string_view text;
+    if (type != QXmlStreamReader::ProcessingInstruction && !decode(std::string_view(begin, e - begin), Text::RAW, text)) {
+        return false;
+    }
+    _p = e + strlen(close);
+    append(type, 0, intern(text), false, noAttributes());
+    return true;
+}
+
+//---------------------------------------------------------
+//   read
+//---------------------------------------------------------
+
+bool XmlTokens::Tokenizer::read()
+{
+    if (startsWith("\xEF\xBB\xBF")) {
+        _p += 3;
+    }
+    if (startsWith("<?xml") && _end - _p > 5 && isSpace(_p[5]) && !readDeclaration()) {
+        return false;
+    }
+    append(QXmlStreamReader::StartDocument, 0, 0, false, noAttributes());
+
+    bool root = false;
+    while (_p < _end) {
+        const char* lt = find(_p, _end, '<');
+        if (lt != _p && !readText(lt)) {
+            return false;
+        }
+        if (lt == _end) {
+            break;
+        }
+        bool ok;
+        if (startsWith("</")) {
+            ok = readEndElement();
+        } else if (startsWith("<!--")) {
+            ok = readMarkup(_p + 4, QXmlStreamReader::Comment);
+        } else if (startsWith("<![CDATA[")) {
+            ok = readMarkup(_p + 9, QXmlStreamReader::Characters);
+        } else if (startsWith("<?")) {
+            ok = readMarkup(_p + 2, QXmlStreamReader::ProcessingInstruction);
+        } else if (startsWith("<!")) {
+            ok = false;                     // a DTD
+        } else {
+            ok = !(root && _elements.empty()) && readStartElement();
+            root = true;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    if (!root || !_elements.empty()) {
+        return false;
+    }
+    append(QXmlStreamReader::EndDocument, 0, 0, false, noAttributes());
+    return true;
+}
+
+//---------------------------------------------------------
+//   tokenize
+//    nullptr if the Tokenizer cannot read data
+//---------------------------------------------------------
+
+std::shared_ptr<XmlTokens> XmlTokens::tokenize(const QByteArray& data)
+{
+    std::shared_ptr<XmlTokens> t = std::make_shared<XmlTokens>();
+    Tokenizer tokenizer(*t, data.constData(), data.size());
+    return tokenizer.read() ? t : nullptr;
+}
+}     // namespace Ms
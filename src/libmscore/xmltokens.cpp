@@ -0,0 +1,521 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "xmltokens.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#include "mscore.h"
+
+namespace Ms {
+static const quint32 TOKENS_MAGIC = 0x4d53544b;     // "MSTK"
+static const quint32 TOKENS_VERSION = 1;
+static const qint64 MIN_CACHED_SIZE = 64 * 1024;    // smaller files are parsed quickly enough
+static const int MAX_CACHED_FILES = 16;
+// below these the thread pool costs more than it saves
+static const qint64 PARALLEL_PARSE_MIN_SIZE = 256 * 1024;
+static const int PARALLEL_PARSE_MIN_STAVES = 4;
+static const char STAFF_BLOCK_TAG[] = "_StaffBlock_";
+
+//---------------------------------------------------------
+//   XmlTokens
+//---------------------------------------------------------
+
+XmlTokens::XmlTokens()
+{
+    _strings.emplace_back();
+}
+
+//---------------------------------------------------------
+//   cachePath
+//    the cache files for the content of io, without the
+//    suffix; empty if there is no cache or the file is
+//    not worth it. The position of io is kept.
+//---------------------------------------------------------
+
+QString XmlTokens::cachePath(QIODevice* io)
+{
+    if (MScore::scoreTokensCachePath.isEmpty() || io->isSequential() || io->size() < MIN_CACHED_SIZE) {
+        return QString();
+    }
+    const qint64 pos = io->pos();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    io->seek(0);
+    const bool ok = hash.addData(io);
+    io->seek(pos);
+    if (!ok) {
+        return QString();
+    }
+    return QString("%1/%2").arg(MScore::scoreTokensCachePath, QString::fromLatin1(hash.result().toHex()));
+}
+
+//---------------------------------------------------------
+//   intern
+//---------------------------------------------------------
+
+quint32 XmlTokens::intern(const QStringRef& s)
+{
+    if (s.isEmpty()) {
+        return 0;
+    }
+    auto i = _index.constFind(s);
+    if (i != _index.constEnd()) {
+        return i.value();
+    }
+    const quint32 idx = quint32(_strings.size());
+    _strings.push_back(s.toString());
+    _index.insert(QStringRef(&_strings.back()), idx);
+    return idx;
+}
+
+//---------------------------------------------------------
+//   append
+//    the token r just read
+//---------------------------------------------------------
+
+void XmlTokens::append(const QXmlStreamReader& r)
+{
+    Token t;
+    t.type = quint8(r.tokenType());
+    t.whitespace = r.isWhitespace();
+    t.name = intern(r.name());
+    t.text = intern(r.text());
+    t.attributes = quint32(_attributes.size());
+    t.attributeCount = 0;
+    t.line = qint32(r.lineNumber());
+    t.column = qint32(r.columnNumber());
+    if (r.tokenType() == QXmlStreamReader::StartElement) {
+        for (const QXmlStreamAttribute& a : r.attributes()) {
+            _attributes.push_back({ intern(a.qualifiedName()), intern(a.value()) });
+        }
+        t.attributeCount = quint32(_attributes.size()) - t.attributes;
+    }
+    _tokens.push_back(t);
+}
+
+//---------------------------------------------------------
+//   intern
+//    all strings of t, for the tokens of t appended
+//    with append(t, ...)
+//---------------------------------------------------------
+
+std::vector<quint32> XmlTokens::intern(const XmlTokens& t)
+{
+    std::vector<quint32> strings(t._strings.size(), 0);
+    for (size_t i = 1; i < t._strings.size(); ++i) {
+        strings[i] = intern(QStringRef(&t._strings[i]));
+    }
+    return strings;
+}
+
+//---------------------------------------------------------
+//   append
+//    token of t, its lines moved by line and the columns
+//    of its first line by column
+//---------------------------------------------------------
+
+void XmlTokens::append(const XmlTokens& t, const Token& token, const std::vector<quint32>& strings, int line, int column)
+{
+    Token tt = token;
+    tt.name = strings[token.name];
+    tt.text = strings[token.text];
+    tt.attributes = quint32(_attributes.size());
+    for (quint32 i = token.attributes; i < token.attributes + token.attributeCount; ++i) {
+        const Attribute& a = t._attributes[i];
+        _attributes.push_back({ strings[a.name], strings[a.value] });
+    }
+    if (tt.line == 1) {
+        tt.column += column;
+    }
+    tt.line += line;
+    _tokens.push_back(tt);
+}
+
+//---------------------------------------------------------
+//   StaffBlock
+//    the bytes of a <Staff> element of a <Score>, which
+//    holds the measures of the staff
+//---------------------------------------------------------
+
+struct StaffBlock {
+    int begin;
+    int end;
+    int line;               // of begin, from 0
+    int column;
+    int lines;              // newlines in the block
+};
+
+//---------------------------------------------------------
+//   scanStaffBlocks
+//    finds the staff blocks by the tags only, without
+//    parsing the document. False if the document has
+//    anything the scan does not know, like a DTD which
+//    could declare entities.
+//---------------------------------------------------------
+
+static bool scanStaffBlocks(const QByteArray& data, std::vector<StaffBlock>& blocks)
+{
+    const char* p = data.constData();
+    const int n = data.size();
+    std::vector<std::pair<int, int> > names;          // of the open elements, offset and length
+    int staffDepth = -1;
+    int line = 0;
+    int lineStart = 0;
+    int counted = 0;
+
+    auto find = [p, n](int from, const char* s) {
+        const char* e = std::search(p + from, p + n, s, s + strlen(s));
+        return e == p + n ? -1 : int(e - p);
+    };
+    auto startsWith = [p, n](int i, const char* s) {
+        const int len = int(strlen(s));
+        return i + len <= n && memcmp(p + i, s, len) == 0;
+    };
+    auto isName = [p, &names](size_t idx, const char* s) {
+        const int len = int(strlen(s));
+        return names[idx].second == len && memcmp(p + names[idx].first, s, len) == 0;
+    };
+    auto nameEnd = [p, n](int i) {
+        while (i < n && !strchr(" \t\r\n/>", p[i])) {
+            ++i;
+        }
+        return i;
+    };
+
+    for (int i = 0; i < n;) {
+        const char* lt = static_cast<const char*>(memchr(p + i, '<', n - i));
+        if (!lt) {
+            break;
+        }
+        i = int(lt - p);
+        if (startsWith(i, "<!--") || startsWith(i, "<![CDATA[") || startsWith(i, "<?")) {
+            const char* close = p[i + 1] == '?' ? "?>" : (p[i + 2] == '-' ? "-->" : "]]>");
+            const int e = find(i + 2, close);
+            if (e < 0) {
+                return false;
+            }
+            i = e + int(strlen(close));
+        } else if (i + 1 < n && p[i + 1] == '!') {
+            return false;
+        } else if (i + 1 < n && p[i + 1] == '/') {
+            const int e = nameEnd(i + 2);
+            const char* gt = static_cast<const char*>(memchr(p + e, '>', n - e));
+            if (!gt || names.empty() || names.back().second != e - i - 2
+                || memcmp(p + names.back().first, p + i + 2, e - i - 2) != 0) {
+                return false;
+            }
+            names.pop_back();
+            i = int(gt - p) + 1;
+            if (int(names.size()) == staffDepth) {
+                StaffBlock& b = blocks.back();
+                b.end = i;
+                b.lines = int(std::count(p + b.begin, p + b.end, '\n'));
+                staffDepth = -1;
+            }
+        } else {
+            const int e = nameEnd(i + 1);
+            // the end of the tag, the attribute values may hold '>'
+            int j = e;
+            char quote = 0;
+            for (; j < n && (quote || p[j] != '>'); ++j) {
+                if (quote) {
+                    quote = p[j] == quote ? 0 : quote;
+                } else if (p[j] == '"' || p[j] == '\'') {
+                    quote = p[j];
+                }
+            }
+            if (j == n) {
+                return false;
+            }
+            if (p[j - 1] != '/') {
+                names.push_back({ i + 1, e - i - 1 });
+                if (staffDepth < 0 && names.size() >= 2 && isName(names.size() - 1, "Staff")
+                    && isName(names.size() - 2, "Score")) {
+                    for (; counted < i; ++counted) {
+                        if (p[counted] == '\n') {
+                            ++line;
+                            lineStart = counted + 1;
+                        }
+                    }
+                    blocks.push_back({ i, -1, line, i - lineStart, 0 });
+                    staffDepth = int(names.size()) - 1;
+                }
+            }
+            i = j + 1;
+        }
+    }
+    return names.empty() && staffDepth < 0;
+}
+
+//---------------------------------------------------------
+//   parse
+//    the tokens of a score file, by the Tokenizer instead
+//    of QXmlStreamReader. Returns nullptr if the Tokenizer
+//    cannot read the file, which is then read by
+//    QXmlStreamReader; the position of io is kept.
+//---------------------------------------------------------
+
+std::shared_ptr<const XmlTokens> XmlTokens::parse(QIODevice* io)
+{
+    if (io->isSequential()) {
+        return nullptr;
+    }
+    const qint64 pos = io->pos();
+    const QByteArray data = io->readAll();
+    io->seek(pos);
+
+    // only UTF-8, the Tokenizer does not decode anything else
+    if (data.startsWith("\xFE\xFF") || data.startsWith("\xFF\xFE") || data.left(4).contains('\0')) {
+        return nullptr;
+    }
+#ifndef Q_OS_WASM
+    if (MScore::parallelLayout && data.size() >= PARALLEL_PARSE_MIN_SIZE) {
+        if (std::shared_ptr<const XmlTokens> tokens = parseStaves(data)) {
+            return tokens;
+        }
+    }
+#endif
+    std::shared_ptr<XmlTokens> tokens = tokenize(data);
+    return tokens && tokens->isValid() ? tokens : nullptr;
+}
+
+//---------------------------------------------------------
+//   parseStaves
+//    the tokens of a large score file, with the staff
+//    blocks tokenized in parallel. The rest of the
+//    document is tokenized with a placeholder for each
+//    block, which the tokens of the block replace when
+//    merging. The score itself is still read in one pass
+//    by replaying the tokens: the staves add to the same
+//    measures and segments, and the spanners, links and
+//    tuplets are resolved through the one XmlReader.
+//    Returns nullptr if the file cannot be split.
+//---------------------------------------------------------
+
+std::shared_ptr<const XmlTokens> XmlTokens::parseStaves(const QByteArray& data)
+{
+    std::vector<StaffBlock> blocks;
+    if (!scanStaffBlocks(data, blocks) || int(blocks.size()) < PARALLEL_PARSE_MIN_STAVES) {
+        return nullptr;
+    }
+
+    // the placeholder has the newlines of its block, so the
+    // lines of the rest of the document stay as they are
+    QByteArray document;
+    document.reserve(data.size() / 4);
+    int from = 0;
+    for (const StaffBlock& b : blocks) {
+        document.append(data.constData() + from, b.begin - from);
+        document.append('<').append(STAFF_BLOCK_TAG).append('>');
+        document.append(QByteArray(b.lines, '\n'));
+        document.append("</").append(STAFF_BLOCK_TAG).append('>');
+        from = b.end;
+    }
+    document.append(data.constData() + from, data.size() - from);
+
+    std::vector<std::shared_ptr<XmlTokens> > parts(blocks.size() + 1);
+    std::vector<int> indexes(parts.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i] = int(i);
+    }
+    QtConcurrent::blockingMap(indexes, [&](int i) {
+        if (i == 0) {
+            parts[0] = tokenize(document);
+        } else {
+            const StaffBlock& b = blocks[i - 1];
+            parts[i] = tokenize(QByteArray::fromRawData(data.constData() + b.begin, b.end - b.begin));
+        }
+    });
+    for (const std::shared_ptr<XmlTokens>& t : parts) {
+        if (!t) {
+            return nullptr;
+        }
+    }
+
+    // merge
+    std::shared_ptr<XmlTokens> tokens = std::make_shared<XmlTokens>();
+    size_t size = 0;
+    for (const std::shared_ptr<XmlTokens>& t : parts) {
+        size += t->_tokens.size();
+    }
+    tokens->_tokens.reserve(size);
+
+    const XmlTokens& doc = *parts[0];
+    const std::vector<quint32> docStrings = tokens->intern(doc);
+    size_t block = 0;
+    for (size_t i = 0; i < doc._tokens.size(); ++i) {
+        const Token& t = doc._tokens[i];
+        if (t.type == QXmlStreamReader::StartElement && doc._strings[t.name] == QLatin1String(STAFF_BLOCK_TAG)) {
+            if (block >= blocks.size()) {
+                return nullptr;
+            }
+            const XmlTokens& part = *parts[block + 1];
+            const std::vector<quint32> strings = tokens->intern(part);
+            for (const Token& pt : part._tokens) {
+                if (pt.type != QXmlStreamReader::StartDocument && pt.type != QXmlStreamReader::EndDocument) {
+                    tokens->append(part, pt, strings, blocks[block].line, blocks[block].column);
+                }
+            }
+            while (i + 1 < doc._tokens.size() && doc._tokens[i].type != QXmlStreamReader::EndElement) {
+                ++i;
+            }
+            ++block;
+            continue;
+        }
+        tokens->append(doc, t, docStrings, 0, 0);
+    }
+    tokens->_index.clear();
+
+    if (block != blocks.size() || !tokens->isValid()) {
+        return nullptr;
+    }
+    return tokens;
+}
+
+//---------------------------------------------------------
+//   isValid
+//    all indices in range, so that replaying the tokens
+//    cannot read beyond them
+//---------------------------------------------------------
+
+bool XmlTokens::isValid() const
+{
+    const quint32 strings = quint32(_strings.size());
+    for (const Token& t : _tokens) {
+        if (t.type > QXmlStreamReader::ProcessingInstruction || t.name >= strings || t.text >= strings
+            || t.attributes > _attributes.size() || t.attributeCount > _attributes.size() - t.attributes) {
+            return false;
+        }
+    }
+    for (const Attribute& a : _attributes) {
+        if (a.name >= strings || a.value >= strings) {
+            return false;
+        }
+    }
+    return !_tokens.empty() && _tokens.back().type == QXmlStreamReader::EndDocument;
+}
+
+//---------------------------------------------------------
+//   load
+//    returns nullptr if there is no valid cache file
+//---------------------------------------------------------
+
+std::shared_ptr<const XmlTokens> XmlTokens::load(const QString& cachePath)
+{
+    if (cachePath.isEmpty()) {
+        return nullptr;
+    }
+    const QString path = cachePath + ".tokens";
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic, version, mscVersion, tokenSize, tokens, attributes, strings;
+    ds >> magic >> version >> mscVersion >> tokenSize >> tokens >> attributes >> strings;
+    if (ds.status() != QDataStream::Ok || magic != TOKENS_MAGIC || version != TOKENS_VERSION
+        || mscVersion != MSCVERSION || tokenSize != sizeof(Token)) {
+        return nullptr;
+    }
+    if (qint64(tokens) * sizeof(Token) + qint64(attributes) * sizeof(Attribute) > f.size()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<XmlTokens> t = std::make_shared<XmlTokens>();
+    t->_tokens.resize(tokens);
+    t->_attributes.resize(attributes);
+    ds.readRawData(reinterpret_cast<char*>(t->_tokens.data()), int(tokens * sizeof(Token)));
+    ds.readRawData(reinterpret_cast<char*>(t->_attributes.data()), int(attributes * sizeof(Attribute)));
+    for (quint32 i = 1; i < strings && ds.status() == QDataStream::Ok; ++i) {
+        quint32 n;
+        ds >> n;
+        if (qint64(n) * 2 > f.size()) {
+            return nullptr;
+        }
+        QString s(int(n), Qt::Uninitialized);
+        ds.readRawData(reinterpret_cast<char*>(s.data()), int(n * sizeof(QChar)));
+        t->_strings.push_back(std::move(s));
+    }
+    if (ds.status() != QDataStream::Ok || !t->isValid()) {
+        qDebug("XmlTokens: corrupted cache file <%s>", qPrintable(path));
+        return nullptr;
+    }
+    // the cache keeps the files used last
+    f.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return t;
+}
+
+//---------------------------------------------------------
+//   remove
+//    the cache files for a content, the tokens and
+//    whatever else is kept with them
+//---------------------------------------------------------
+
+void XmlTokens::remove(const QString& cachePath)
+{
+    QFileInfo fi(cachePath);
+    for (const QFileInfo& f : fi.dir().entryInfoList({ fi.fileName() + ".*" }, QDir::Files)) {
+        QFile::remove(f.absoluteFilePath());
+    }
+}
+
+//---------------------------------------------------------
+//   save
+//    and remove the cache files used least recently
+//---------------------------------------------------------
+
+bool XmlTokens::save(const QString& cachePath) const
+{
+    if (cachePath.isEmpty() || !QDir().mkpath(MScore::scoreTokensCachePath)) {
+        return false;
+    }
+    const QString path = cachePath + ".tokens";
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qDebug("XmlTokens: cannot write cache file <%s>", qPrintable(path));
+        return false;
+    }
+    QDataStream ds(&f);
+    ds.setVersion(QDataStream::Qt_5_9);
+    ds << TOKENS_MAGIC << TOKENS_VERSION << quint32(MSCVERSION) << quint32(sizeof(Token))
+       << quint32(_tokens.size()) << quint32(_attributes.size()) << quint32(_strings.size());
+    ds.writeRawData(reinterpret_cast<const char*>(_tokens.data()), int(_tokens.size() * sizeof(Token)));
+    ds.writeRawData(reinterpret_cast<const char*>(_attributes.data()), int(_attributes.size() * sizeof(Attribute)));
+    for (size_t i = 1; i < _strings.size(); ++i) {
+        const QString& s = _strings[i];
+        ds << quint32(s.size());
+        ds.writeRawData(reinterpret_cast<const char*>(s.constData()), int(s.size() * sizeof(QChar)));
+    }
+    if (ds.status() != QDataStream::Ok || !f.commit()) {
+        qDebug("XmlTokens: cannot write cache file <%s>", qPrintable(path));
+        return false;
+    }
+
+    QDir dir(MScore::scoreTokensCachePath);
+    const QFileInfoList files = dir.entryInfoList({ "*.tokens" }, QDir::Files, QDir::Time);
+    for (int i = MAX_CACHED_FILES; i < files.size(); ++i) {
+        remove(files[i].dir().filePath(files[i].completeBaseName()));
+    }
+    return true;
+}
+}     // namespace Ms
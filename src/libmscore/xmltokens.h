@@ -0,0 +1,88 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __XMLTOKENS_H__
+#define __XMLTOKENS_H__
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QXmlStreamReader>
+
+class QIODevice;
+
+namespace Ms {
+//---------------------------------------------------------
+//   XmlTokens
+//    the tokens of a score file as XmlReader read them,
+//    with all names and texts interned. They are kept in
+//    a cache file keyed by the content hash of the score
+//    file, so that reading the same file again replays
+//    them instead of parsing the xml. The score file
+//    itself is never changed.
+//---------------------------------------------------------
+
+class XmlTokens
+{
+public:
+    struct Token {
+        quint8 type;                // QXmlStreamReader::TokenType
+        quint8 whitespace;
+        quint32 name;               // element name, index into the strings
+        quint32 text;               // characters, comment or processing instruction
+        quint32 attributes;         // index of the first attribute
+        quint32 attributeCount;
+        qint32 line;
+        qint32 column;
+    };
+    struct Attribute {
+        quint32 name;
+        quint32 value;
+    };
+
+    XmlTokens();
+
+    static QString cachePath(QIODevice* io);
+    static std::shared_ptr<const XmlTokens> load(const QString& cachePath);
+    static void remove(const QString& cachePath);
+    static std::shared_ptr<const XmlTokens> parse(QIODevice* io);
+    bool save(const QString& cachePath) const;
+
+    void append(const QXmlStreamReader& r);
+
+    int size() const { return int(_tokens.size()); }
+    const Token& token(int idx) const { return _tokens[idx]; }
+    const Attribute& attribute(quint32 idx) const { return _attributes[idx]; }
+    const QString& string(quint32 idx) const { return _strings[idx]; }
+
+private:
+    class Tokenizer;
+
+    static std::shared_ptr<XmlTokens> tokenize(const QByteArray& data);
+    static std::shared_ptr<const XmlTokens> parseStaves(const QByteArray& data);
+
+    quint32 intern(const QStringRef& s);
+    std::vector<quint32> intern(const XmlTokens& t);
+    void append(const XmlTokens& t, const Token& token, const std::vector<quint32>& strings, int line, int column);
+    bool isValid() const;
+
+    std::vector<Token> _tokens;
+    std::vector<Attribute> _attributes;
+    std::deque<QString> _strings;           // stable, _index refers to them
+    QHash<QStringRef, quint32> _index;      // only while recording
+};
+}     // namespace Ms
+#endif
@@ -10,6 +10,10 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
 #include "xml.h"
 #include "property.h"
 #include "scoreElement.h"
@@ -50,10 +54,120 @@ void XmlWriter::pTag(const char* name, PlaceText place)
 
 void XmlWriter::putLevel()
 {
-    int level = stack.size();
-    for (int i = 0; i < level * 2; ++i) {
-        *this << ' ';
+    static const char spaces[] = "                                                                ";
+    int n = stack.size() * 2;
+    while (n > 0) {
+        const int len = qMin(n, int(sizeof(spaces) - 1));
+        *this << QLatin1String(spaces, len);
+        n -= len;
+    }
+}
+
+//---------------------------------------------------------
+//   endLine
+//    the stream is only flushed once the outermost tag
+//    is written, not for every line
+//---------------------------------------------------------
+
+void XmlWriter::endLine()
+{
+    *this << '\n';
+    if (stack.isEmpty()) {
+        flush();
+    }
+}
+
+//---------------------------------------------------------
+//   putNumber
+//    formatted on the stack, the same way QTextStream
+//    formats numbers with its default settings
+//---------------------------------------------------------
+
+void XmlWriter::putNumber(int n)
+{
+    char buffer[16];
+    const auto res = std::to_chars(buffer, buffer + sizeof(buffer), n);
+    *this << QLatin1String(buffer, int(res.ptr - buffer));
+}
+
+void XmlWriter::putNumber(qint64 n)
+{
+    char buffer[24];
+    const auto res = std::to_chars(buffer, buffer + sizeof(buffer), n);
+    *this << QLatin1String(buffer, int(res.ptr - buffer));
+}
+
+void XmlWriter::putNumber(double d)
+{
+    if (d == 0.0) {
+        *this << '0';             // no "-0"
+        return;
+    }
+    if (std::isnan(d)) {
+        *this << QLatin1String("nan");
+        return;
+    }
+    if (std::isinf(d)) {
+        *this << (d > 0 ? QLatin1String("inf") : QLatin1String("-inf"));
+        return;
+    }
+    char buffer[32];
+    const int n = snprintf(buffer, sizeof(buffer), "%.6g", d);
+    *this << QLatin1String(buffer, n);
+}
+
+//---------------------------------------------------------
+//   putEscaped
+//    writes s like xmlString(s), in runs and without a
+//    temporary string
+//---------------------------------------------------------
+
+void XmlWriter::putEscaped(const QString& s)
+{
+    const QChar* data = s.constData();
+    const int size = s.size();
+    int start = 0;
+    for (int i = 0; i < size; ++i) {
+        const ushort c = data[i].unicode();
+        const char* escaped = nullptr;
+        switch (c) {
+        case '<':  escaped = "&lt;";
+            break;
+        case '>':  escaped = "&gt;";
+            break;
+        case '&':  escaped = "&amp;";
+            break;
+        case '\"': escaped = "&quot;";
+            break;
+        default:
+            if (c >= 0x20 || c == 0x09 || c == 0x0A || c == 0x0D) {
+                continue;
+            }
+            escaped = "";         // invalid in xml 1.0
+            break;
+        }
+        if (i > start) {
+            *this << QStringRef(&s, start, i - start);
+        }
+        *this << QLatin1String(escaped);
+        start = i + 1;
     }
+    if (start == 0) {
+        *this << s;
+    } else if (start < size) {
+        *this << QStringRef(&s, start, size - start);
+    }
+}
+
+//---------------------------------------------------------
+//   tagName
+//    the name of s without the attributes
+//---------------------------------------------------------
+
+QStringRef XmlWriter::tagName(const QString& s)
+{
+    const int i = s.indexOf(' ');
+    return i < 0 ? QStringRef(&s) : QStringRef(&s, 0, i);
 }
 
 //---------------------------------------------------------
@@ -73,8 +187,9 @@ void XmlWriter::header()
 void XmlWriter::stag(const QString& s)
 {
     putLevel();
-    *this << '<' << s << '>' << Qt::endl;
-    stack.append(s.split(' ')[0]);
+    *this << '<' << s << '>';
+    stack.append(tagName(s).toString());
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -99,8 +214,9 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
     if (!attributes.isEmpty()) {
         *this << ' ' << attributes;
     }
-    *this << '>' << Qt::endl;
+    *this << '>';
     stack.append(name);
+    endLine();
 
     if (_recordElements) {
         _elements.emplace_back(se, name);
@@ -115,7 +231,8 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
 void XmlWriter::etag()
 {
     putLevel();
-    *this << "</" << stack.takeLast() << '>' << Qt::endl;
+    *this << "</" << stack.takeLast() << '>';
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -133,7 +250,8 @@ void XmlWriter::tagE(const char* format, ...)
     vsnprintf(buffer, BS, format, args);
     *this << buffer;
     va_end(args);
-    *this << "/>" << Qt::endl;
+    *this << "/>";
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -143,7 +261,8 @@ void XmlWriter::tagE(const char* format, ...)
 void XmlWriter::tagE(const QString& s)
 {
     putLevel();
-    *this << '<' << s << "/>\n";
+    *this << '<' << s << "/>";
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -164,7 +283,8 @@ void XmlWriter::ntag(const char* name)
 
 void XmlWriter::netag(const char* s)
 {
-    *this << "</" << s << '>' << Qt::endl;
+    *this << "</" << s << '>';
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -197,13 +317,13 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
 void XmlWriter::tag(const char* name, QVariant data, QVariant defaultData)
 {
     if (data != defaultData) {
-        tag(QString(name), data);
+        tag(QString::fromLatin1(name), data);
     }
 }
 
 void XmlWriter::tag(const QString& name, QVariant data)
 {
-    QString ename(name.split(' ')[0]);
+    const QStringRef ename(tagName(name));
 
     putLevel();
     switch (data.type()) {
@@ -211,67 +331,102 @@ void XmlWriter::tag(const QString& name, QVariant data)
     case QVariant::Char:
     case QVariant::Int:
     case QVariant::UInt:
-        *this << "<" << name << ">";
-        *this << data.toInt();
-        *this << "</" << ename << ">\n";
+        *this << '<' << name << '>';
+        putNumber(data.toInt());
+        *this << "</" << ename << '>';
         break;
     case QVariant::LongLong:
-        *this << "<" << name << ">";
-        *this << data.toLongLong();
-        *this << "</" << ename << ">\n";
+        *this << '<' << name << '>';
+        putNumber(qint64(data.toLongLong()));
+        *this << "</" << ename << '>';
         break;
     case QVariant::Double:
-        *this << "<" << name << ">";
-        *this << data.value<double>();
-        *this << "</" << ename << ">\n";
+        *this << '<' << name << '>';
+        putNumber(data.value<double>());
+        *this << "</" << ename << '>';
         break;
     case QVariant::String:
-        *this << "<" << name << ">";
-        *this << xmlString(data.value<QString>());
-        *this << "</" << ename << ">\n";
+        *this << '<' << name << '>';
+        putEscaped(data.value<QString>());
+        *this << "</" << ename << '>';
         break;
     case QVariant::Color:
     {
         QColor color(data.value<QColor>());
-        *this << QString("<%1 r=\"%2\" g=\"%3\" b=\"%4\" a=\"%5\"/>\n")
-            .arg(name).arg(color.red()).arg(color.green()).arg(color.blue()).arg(color.alpha());
+        *this << '<' << name << " r=\"";
+        putNumber(color.red());
+        *this << "\" g=\"";
+        putNumber(color.green());
+        *this << "\" b=\"";
+        putNumber(color.blue());
+        *this << "\" a=\"";
+        putNumber(color.alpha());
+        *this << "\"/>";
     }
     break;
     case QVariant::Rect:
     {
         const QRect& r(data.value<QRect>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"/>\n").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+        *this << '<' << name << " x=\"";
+        putNumber(r.x());
+        *this << "\" y=\"";
+        putNumber(r.y());
+        *this << "\" w=\"";
+        putNumber(r.width());
+        *this << "\" h=\"";
+        putNumber(r.height());
+        *this << "\"/>";
     }
     break;
     case QVariant::RectF:
     {
         const QRectF& r(data.value<QRectF>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\" w=\"%4\" h=\"%5\"/>\n").arg(name).arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+        *this << '<' << name << " x=\"";
+        putNumber(r.x());
+        *this << "\" y=\"";
+        putNumber(r.y());
+        *this << "\" w=\"";
+        putNumber(r.width());
+        *this << "\" h=\"";
+        putNumber(r.height());
+        *this << "\"/>";
     }
     break;
     case QVariant::PointF:
     {
         const QPointF& p(data.value<QPointF>());
-        *this << QString("<%1 x=\"%2\" y=\"%3\"/>\n").arg(name).arg(p.x()).arg(p.y());
+        *this << '<' << name << " x=\"";
+        putNumber(p.x());
+        *this << "\" y=\"";
+        putNumber(p.y());
+        *this << "\"/>";
     }
     break;
     case QVariant::SizeF:
     {
         const QSizeF& p(data.value<QSizeF>());
-        *this << QString("<%1 w=\"%2\" h=\"%3\"/>\n").arg(name).arg(p.width()).arg(p.height());
+        *this << '<' << name << " w=\"";
+        putNumber(p.width());
+        *this << "\" h=\"";
+        putNumber(p.height());
+        *this << "\"/>";
     }
     break;
     default: {
         const char* type = data.typeName();
         if (strcmp(type, "Ms::Spatium") == 0) {
-            *this << "<" << name << ">";
-            *this << data.value<Spatium>().val();
-            *this << "</" << ename << ">\n";
+            *this << '<' << name << '>';
+            putNumber(data.value<Spatium>().val());
+            *this << "</" << ename << '>';
         } else if (strcmp(type, "Ms::Fraction") == 0) {
             const Fraction& f = data.value<Fraction>();
-            *this << QString("<%1>%2/%3</%1>\n").arg(name).arg(f.numerator()).arg(f.denominator());
+            *this << '<' << name << '>';
+            putNumber(f.numerator());
+            *this << '/';
+            putNumber(f.denominator());
+            *this << "</" << name << '>';
         } else if (strcmp(type, "Ms::Direction") == 0) {
-            *this << QString("<%1>%2</%1>\n").arg(name, toString(data.value<Direction>()));
+            *this << '<' << name << '>' << toString(data.value<Direction>()) << "</" << name << '>';
         } else if (strcmp(type, "Ms::Align") == 0) {
             // TODO: remove from here? (handled in Ms::propertyWritableValue())
             Align a = Align(data.toInt());
@@ -293,14 +448,14 @@ void XmlWriter::tag(const QString& name, QVariant data)
             } else {
                 v = "top";
             }
-            *this << QString("<%1>%2,%3</%1>\n").arg(name)
-                .arg(h, v);
+            *this << '<' << name << '>' << h << ',' << v << "</" << name << '>';
         } else {
             qFatal("XmlWriter::tag: unsupported type %d %s", data.type(), type);
         }
     }
     break;
     }
+    endLine();
 }
 
 void XmlWriter::tag(const char* name, const QWidget* g)
@@ -315,7 +470,8 @@ void XmlWriter::tag(const char* name, const QWidget* g)
 void XmlWriter::comment(const QString& text)
 {
     putLevel();
-    *this << "<!-- " << text << " -->" << Qt::endl;
+    *this << "<!-- " << text << " -->";
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -348,11 +504,42 @@ QString XmlWriter::xmlString(ushort c)
 
 QString XmlWriter::xmlString(const QString& s)
 {
+    int i = 0;
+    for (; i < s.size(); ++i) {
+        const ushort c = s.at(i).unicode();
+        if (c == '<' || c == '>' || c == '&' || c == '\"' || (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D)) {
+            break;
+        }
+    }
+    if (i == s.size()) {
+        return s;             // nothing to escape, shares the data
+    }
+
     QString escaped;
-    escaped.reserve(s.size());
-    for (int i = 0; i < s.size(); ++i) {
-        ushort c = s.at(i).unicode();
-        escaped += xmlString(c);
+    escaped.reserve(s.size() + 16);
+    escaped.append(s.constData(), i);
+    for (; i < s.size(); ++i) {
+        const QChar c = s.at(i);
+        switch (c.unicode()) {
+        case '<':
+            escaped += QLatin1String("&lt;");
+            break;
+        case '>':
+            escaped += QLatin1String("&gt;");
+            break;
+        case '&':
+            escaped += QLatin1String("&amp;");
+            break;
+        case '\"':
+            escaped += QLatin1String("&quot;");
+            break;
+        default:
+            // ignore invalid characters in xml 1.0
+            if (c.unicode() >= 0x20 || c.unicode() == 0x09 || c.unicode() == 0x0A || c.unicode() == 0x0D) {
+                escaped += c;
+            }
+            break;
+        }
     }
     return escaped;
 }
@@ -392,7 +579,7 @@ void XmlWriter::dump(int len, const unsigned char* p)
 
 void XmlWriter::writeXml(const QString& name, QString s)
 {
-    QString ename(name.split(' ')[0]);
+    const QStringRef ename(tagName(name));
     putLevel();
     for (int i = 0; i < s.size(); ++i) {
         ushort c = s.at(i).unicode();
@@ -400,9 +587,10 @@ void XmlWriter::writeXml(const QString& name, QString s)
             s[i] = '?';
         }
     }
-    *this << "<" << name << ">";
+    *this << '<' << name << '>';
     *this << s;
-    *this << "</" << ename << ">\n";
+    *this << "</" << ename << '>';
+    endLine();
 }
 
 //---------------------------------------------------------
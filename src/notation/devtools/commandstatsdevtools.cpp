@@ -0,0 +1,68 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "commandstatsdevtools.h"
+
+#include <algorithm>
+
+#include <QDateTime>
+
+#include "commandstats.h"
+
+using namespace mu::notation;
+using namespace mu::commandstats;
+
+CommandStatsDevTools::CommandStatsDevTools(QObject* parent)
+    : QObject(parent)
+{
+    m_commandStatsTimer.setInterval(500);
+    connect(&m_commandStatsTimer, &QTimer::timeout, this, &CommandStatsDevTools::commandStatsChanged);
+    m_commandStatsTimer.start();
+}
+
+QString CommandStatsDevTools::commandStats() const
+{
+    std::vector<Record> records = history();
+    if (records.empty()) {
+        return "no commands";
+    }
+
+    //! NOTE The command time includes its undo commands and its layout
+    QString result = "time | command | total ms | self | undo | layout (measures) | paint | playback\n";
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        const Record& r = *it;
+        double self = r.ms(Phase::Command) - r.ms(Phase::Undo) - r.ms(Phase::Layout);
+        result += QString("%1 | %2 | %3 | %4 | %5 | %6 (%7) | %8 | %9\n")
+                  .arg(QDateTime::fromMSecsSinceEpoch(r.timestamp).toString("hh:mm:ss.zzz"))
+                  .arg(QString::fromStdString(r.command))
+                  .arg(r.ms(Phase::Command), 0, 'f', 1)
+                  .arg(std::max(0.0, self), 0, 'f', 1)
+                  .arg(r.ms(Phase::Undo), 0, 'f', 1)
+                  .arg(r.ms(Phase::Layout), 0, 'f', 1)
+                  .arg(r.measures)
+                  .arg(r.ms(Phase::Paint), 0, 'f', 1)
+                  .arg(r.ms(Phase::Playback), 0, 'f', 1);
+    }
+    return result;
+}
+
+void CommandStatsDevTools::clear()
+{
+    commandstats::clear();
+    emit commandStatsChanged();
+}
@@ -0,0 +1,47 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_COMMANDSTATSDEVTOOLS_H
+#define MU_NOTATION_COMMANDSTATSDEVTOOLS_H
+
+#include <QObject>
+#include <QTimer>
+
+namespace mu::notation {
+class CommandStatsDevTools : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString commandStats READ commandStats NOTIFY commandStatsChanged)
+
+public:
+    explicit CommandStatsDevTools(QObject* parent = nullptr);
+
+    QString commandStats() const;
+
+    Q_INVOKABLE void clear();
+
+signals:
+    void commandStatsChanged();
+
+private:
+    QTimer m_commandStatsTimer;
+};
+}
+
+#endif // MU_NOTATION_COMMANDSTATSDEVTOOLS_H
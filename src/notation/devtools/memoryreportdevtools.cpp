@@ -0,0 +1,76 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "memoryreportdevtools.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "libmscore/memoryreport.h"
+#include "libmscore/score.h"
+
+using namespace mu::notation;
+
+MemoryReportDevTools::MemoryReportDevTools(QObject* parent)
+    : QObject(parent)
+{
+    update();
+}
+
+QString MemoryReportDevTools::memoryReport() const
+{
+    return m_memoryReport;
+}
+
+void MemoryReportDevTools::update()
+{
+    auto notation = globalContext()->currentNotation();
+    Ms::Score* score = notation ? notation->elements()->msScore() : nullptr;
+    if (!score) {
+        m_memoryReport = "no score";
+        emit memoryReportChanged();
+        return;
+    }
+
+    const Ms::MemoryReport report = Ms::MemoryReport::collect(score->masterScore());
+
+    using Row = std::pair<QString, Ms::MemoryReport::Entry>;
+    std::vector<Row> rows;
+    for (const auto& e : report.elements) {
+        rows.push_back({ Ms::Element::name(e.first), e.second });
+    }
+    rows.push_back({ "[shapes]", report.shapes });
+    rows.push_back({ "[skylines]", report.skylines });
+    rows.push_back({ "[undo]", report.undo });
+    rows.push_back({ "[style]", report.style });
+    rows.push_back({ "[excerpts]", report.excerpts });
+    rows.push_back({ "[images]", report.images });
+    rows.push_back({ "[audio]", report.audio });
+
+    std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        return a.second.bytes > b.second.bytes;
+    });
+
+    QString result = QString("total: %1 KB\n\nwhat | count | KB\n").arg(report.totalBytes() / 1024.0, 0, 'f', 1);
+    for (const Row& r : rows) {
+        result += QString("%1 | %2 | %3\n").arg(r.first).arg(r.second.count).arg(r.second.bytes / 1024.0, 0, 'f', 1);
+    }
+
+    m_memoryReport = result;
+    emit memoryReportChanged();
+}
@@ -0,0 +1,51 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_MEMORYREPORTDEVTOOLS_H
+#define MU_NOTATION_MEMORYREPORTDEVTOOLS_H
+
+#include <QObject>
+
+#include "modularity/ioc.h"
+#include "context/iglobalcontext.h"
+
+namespace mu::notation {
+//! NOTE The report walks the whole score, so it is made on request only
+class MemoryReportDevTools : public QObject
+{
+    Q_OBJECT
+    INJECT(notation, context::IGlobalContext, globalContext)
+
+    Q_PROPERTY(QString memoryReport READ memoryReport NOTIFY memoryReportChanged)
+
+public:
+    explicit MemoryReportDevTools(QObject* parent = nullptr);
+
+    QString memoryReport() const;
+
+    Q_INVOKABLE void update();
+
+signals:
+    void memoryReportChanged();
+
+private:
+    QString m_memoryReport;
+};
+}
+
+#endif // MU_NOTATION_MEMORYREPORTDEVTOOLS_H
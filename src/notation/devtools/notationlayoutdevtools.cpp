@@ -0,0 +1,52 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "notationlayoutdevtools.h"
+
+#include "libmscore/score.h"
+
+using namespace mu::notation;
+
+NotationLayoutDevTools::NotationLayoutDevTools(QObject* parent)
+    : QObject(parent)
+{
+    m_layoutStatsTimer.setInterval(500);
+    connect(&m_layoutStatsTimer, &QTimer::timeout, this, &NotationLayoutDevTools::layoutStatsChanged);
+    m_layoutStatsTimer.start();
+}
+
+QString NotationLayoutDevTools::layoutStats() const
+{
+    auto notation = globalContext()->currentNotation();
+    Ms::Score* score = notation ? notation->elements()->msScore() : nullptr;
+    if (!score) {
+        return "no score";
+    }
+
+    auto format = [](const QString& name, const Ms::LayoutStatistics& st) {
+        return QString("%1: layouts %2, measures %3, systems %4 (reused %5), pages %6, cut off %7")
+               .arg(name)
+               .arg(st.layouts).arg(st.measures)
+               .arg(st.systems).arg(st.reusedSystems)
+               .arg(st.pages).arg(st.cutOffs);
+    };
+
+    return QString("score: measures %1, systems %2, pages %3\n").arg(score->nmeasures()).arg(score->systems().size()).arg(score->npages())
+           + format("last layout", score->layoutStatistics()) + "\n"
+           + format("total", score->layoutTotals());
+}
@@ -35,6 +35,10 @@ public:
     virtual ~IMsczMetaReader() = default;
 
     virtual MetaList readMetaList(const io::paths& filePaths) const = 0;
+
+    //! NOTE Reads only what the score lists need, files in parallel,
+    //! and keeps the result on disk until a file changes
+    virtual MetaList readIndexedMetaList(const io::paths& filePaths) const = 0;
 };
 }
 
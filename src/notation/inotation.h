@@ -20,6 +20,7 @@
 #define MU_NOTATION_INOTATION_H
 
 #include "async/notification.h"
+#include "async/channel.h"
 #include "internal/inotationundostack.h"
 #include "notationtypes.h"
 #include "inotationstyle.h"
@@ -53,6 +54,8 @@ public:
     virtual void setViewMode(const ViewMode& vm) = 0;
     virtual ViewMode viewMode() const = 0;
     virtual void paint(mu::draw::Painter* painter, const QRectF& frameRect) = 0;
+    virtual void paintScore(mu::draw::Painter* painter, const QRectF& frameRect) = 0;     //! NOTE The pages only, without selection, cursors etc
+    virtual void paintInteraction(mu::draw::Painter* painter) = 0;
 
     virtual ValCh<bool> opened() const = 0;
     virtual void setOpened(bool opened) = 0;
@@ -83,6 +86,7 @@ public:
 
     // notify
     virtual async::Notification notationChanged() const = 0;
+    virtual async::Channel<NotationChanges> notationChanges() const = 0;
 };
 }
 
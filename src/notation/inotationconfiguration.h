@@ -67,9 +67,15 @@ public:
     virtual int fontSize() const = 0;
 
     virtual io::path stylesDirPath() const = 0;
+    virtual io::path fontMetricsCachePath() const = 0;
+    virtual io::path scoreMetaIndexPath() const = 0;
+    virtual io::path scoreTokensCachePath() const = 0;
+
+    virtual int undoLimit() const = 0;
 
     virtual bool isMidiInputEnabled() const = 0;
     virtual void setIsMidiInputEnabled(bool enabled) = 0;
+    virtual async::Channel<bool> isMidiInputEnabledChanged() const = 0;
 
     virtual bool isAutomaticallyPanEnabled() const = 0;
     virtual void setIsAutomaticallyPanEnabled(bool enabled) = 0;
@@ -34,6 +34,11 @@ public:
 
     virtual std::shared_ptr<midi::MidiStream> midiStream() const = 0;
 
+    //! NOTE For the offline rendering (audio export), doesn't affect the playback stream
+    virtual midi::MidiData exportMidiData() const = 0;
+    virtual midi::Chunk exportMidiChunk(midi::tick_t fromTick) const = 0;
+    virtual midi::tick_t exportLastTick() const = 0;
+
     virtual QTime totalPlayTime() const = 0;
 
     virtual float tickToSec(int tick) const = 0;
@@ -20,6 +20,8 @@
 #ifndef MU_NOTATION_INOTATIONWRITER_H
 #define MU_NOTATION_INOTATIONWRITER_H
 
+#include <vector>
+
 #include "ret.h"
 #include "val.h"
 
@@ -36,7 +38,13 @@ public:
         PAGE_NUMBER,
         TRANSPARENT_BACKGROUND,
         TRIM_MARGINS_SIZE,
-        NOTES_COLORS
+        NOTES_COLORS,
+
+        //! NOTE A part of the export, the numbers start from 0 and the last one is included
+        FIRST_PAGE_NUMBER,
+        LAST_PAGE_NUMBER,
+        FIRST_MEASURE_INDEX,
+        LAST_MEASURE_INDEX
     };
 
     using Options = QMap<OptionKey, Val>;
@@ -44,6 +52,15 @@ public:
     virtual ~INotationWriter() = default;
 
     virtual Ret write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) = 0;
+
+    //! NOTE Writes page FIRST_PAGE_NUMBER + i to destinationDevices[i], for the formats which hold one page
+    virtual Ret writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                           const Options& options = Options()) = 0;
+
+    //! NOTE Writes the whole score to destinationDevices[0] and each part alone to destinationDevices[i + 1],
+    //! from one render of the score, for the audio formats
+    virtual Ret writeStems(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                           const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
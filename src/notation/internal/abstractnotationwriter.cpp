@@ -24,6 +24,26 @@
 using namespace mu::notation;
 using namespace mu::framework;
 
+mu::Ret AbstractNotationWriter::writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                                           const Options& options)
+{
+    const int FIRST_PAGE_NUMBER = options.value(OptionKey::FIRST_PAGE_NUMBER, Val(0)).toInt();
+    for (size_t i = 0; i < destinationDevices.size(); ++i) {
+        Options pageOptions = options;
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(FIRST_PAGE_NUMBER + int(i));
+        Ret ret = write(notation, *destinationDevices[i], pageOptions);
+        if (!ret) {
+            return ret;
+        }
+    }
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret AbstractNotationWriter::writeStems(const INotationPtr, const std::vector<system::IODevice*>&, const Options&)
+{
+    return make_ret(Ret::Code::NotSupported);
+}
+
 void AbstractNotationWriter::abort()
 {
     NOT_IMPLEMENTED;
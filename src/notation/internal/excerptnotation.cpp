@@ -20,12 +20,14 @@
 #include "excerptnotation.h"
 
 #include "libmscore/excerpt.h"
+#include "libmscore/part.h"
 
 using namespace mu::notation;
 
 ExcerptNotation::ExcerptNotation(Ms::Excerpt* excerpt)
     : Notation(excerpt->partScore()), m_excerpt(excerpt)
 {
+    m_metaInfo.title = excerpt->title();
 }
 
 ExcerptNotation::~ExcerptNotation()
@@ -35,7 +37,7 @@ ExcerptNotation::~ExcerptNotation()
     }
 
     Ms::MasterScore* master = m_excerpt->oscore();
-    if (master) {
+    if (master && isCreated()) {
         master->deleteExcerpt(m_excerpt);
     }
 
@@ -50,6 +52,23 @@ INotationPtr ExcerptNotation::notation()
     return shared_from_this();
 }
 
+void ExcerptNotation::setOpened(bool opened)
+{
+    if (opened) {
+        createPartScore();
+    }
+
+    Notation::setOpened(opened);
+}
+
+INotationPartsPtr ExcerptNotation::parts() const
+{
+    //! NOTE The parts are edited on the part score, so it is created the first time they are needed
+    const_cast<ExcerptNotation*>(this)->createPartScore();
+
+    return Notation::parts();
+}
+
 Ms::Excerpt* ExcerptNotation::excerpt() const
 {
     return m_excerpt;
@@ -62,24 +81,84 @@ void ExcerptNotation::setExcerpt(Ms::Excerpt* excerpt)
     setMetaInfo(m_metaInfo);
 }
 
+bool ExcerptNotation::isCreated() const
+{
+    return m_excerpt && m_excerpt->partScore();
+}
+
+bool ExcerptNotation::isEmpty() const
+{
+    if (!m_excerpt) {
+        return true;
+    }
+
+    if (isCreated()) {
+        return m_excerpt->isEmpty();
+    }
+
+    const QList<Part*>& masterParts = m_excerpt->oscore()->parts();
+    for (Part* part : m_excerpt->parts()) {
+        if (masterParts.contains(part)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ExcerptNotation::createPartScore()
+{
+    if (!m_excerpt || isCreated()) {
+        return;
+    }
+
+    //! NOTE Until now the excerpt only described its parts, and the master score may have been edited since.
+    //! The part score is cloned from the master as it is now, so nothing has to be replayed into it
+    Ms::MasterScore* master = m_excerpt->oscore();
+    QList<Part*>& parts = m_excerpt->parts();
+
+    for (int i = parts.size() - 1; i >= 0; --i) {
+        if (!master->parts().contains(parts[i])) {
+            parts.removeAt(i);
+        }
+    }
+
+    m_excerpt->tracks().clear();
+    int excerptTrack = 0;
+    for (const Part* part : parts) {
+        for (int track = part->startTrack(); track < part->endTrack(); ++track) {
+            m_excerpt->tracks().insert(track, excerptTrack++);
+        }
+    }
+
+    master->initExcerpt(m_excerpt);
+    setScore(m_excerpt->partScore());
+
+    if (m_metaInfoChanged) {
+        Notation::setMetaInfo(m_metaInfo);
+    }
+}
+
 Meta ExcerptNotation::metaInfo() const
 {
-    return isInited() ? Notation::metaInfo() : m_metaInfo;
+    return isCreated() ? Notation::metaInfo() : m_metaInfo;
 }
 
 void ExcerptNotation::setMetaInfo(const Meta& meta)
 {
     m_metaInfo = meta;
 
-    if (isInited()) {
-        m_excerpt->setTitle(meta.title);
-        Notation::setMetaInfo(meta);
+    if (!m_excerpt) {
+        return;
     }
-}
 
-bool ExcerptNotation::isInited() const
-{
-    return m_excerpt;
+    m_excerpt->setTitle(meta.title);
+
+    if (isCreated()) {
+        Notation::setMetaInfo(meta);
+    } else {
+        m_metaInfoChanged = true;
+    }
 }
 
 INotationPtr ExcerptNotation::clone() const
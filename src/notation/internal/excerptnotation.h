@@ -38,19 +38,25 @@ public:
 
     INotationPtr notation() override;
 
+    void setOpened(bool opened) override;
+    INotationPartsPtr parts() const override;
+
     Ms::Excerpt* excerpt() const;
     void setExcerpt(Ms::Excerpt* excerpt);
 
+    bool isCreated() const;
+    bool isEmpty() const;
+    void createPartScore();
+
     Meta metaInfo() const override;
     void setMetaInfo(const Meta& meta) override;
 
     INotationPtr clone() const override;
 
 private:
-    bool isInited() const;
-
     Ms::Excerpt* m_excerpt = nullptr;
     Meta m_metaInfo;
+    bool m_metaInfoChanged = false;
 };
 }
 
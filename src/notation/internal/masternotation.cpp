@@ -20,10 +20,23 @@
 #include "excerptnotation.h"
 #include "masternotationparts.h"
 
+#include <algorithm>
+#include <map>
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QElapsedTimer>
 #include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
 
 #include "log.h"
 #include "translation.h"
+#include "perfcounters.h"
 
 #include "libmscore/score.h"
 #include "libmscore/part.h"
@@ -41,6 +54,10 @@
 using namespace mu::notation;
 using namespace mu::async;
 
+//! NOTE Only the pages shown first are laid out before a score that
+//! was read is shown, see Notation::continueLayout()
+static constexpr int LAZY_LAYOUT_FIRST_PAGES = 2;
+
 static ExcerptNotation* get_impl(const IExcerptNotationPtr& excerpt)
 {
     return static_cast<ExcerptNotation*>(excerpt.get());
@@ -65,6 +82,12 @@ Meta MasterNotation::metaInfo() const
     meta.filePath = masterScore()->fileInfo()->filePath();
     meta.partsCount = masterScore()->excerpts().count();
 
+    for (IExcerptNotationPtr excerpt : m_excerpts.val) {
+        if (!get_impl(excerpt)->isCreated()) {
+            meta.partsCount++;
+        }
+    }
+
     return meta;
 }
 
@@ -94,6 +117,9 @@ mu::Ret MasterNotation::load(const io::path& path, const INotationReaderPtr& rea
 {
     TRACEFUNC;
 
+    QElapsedTimer timer;
+    timer.start();
+
     Ms::ScoreLoad sl;
 
     Ms::MasterScore* score = new Ms::MasterScore(scoreGlobal()->baseStyle());
@@ -102,6 +128,7 @@ mu::Ret MasterNotation::load(const io::path& path, const INotationReaderPtr& rea
     if (ret) {
         setScore(score);
         initExcerpts();
+        mu::perfcounters::recordScoreOpen(score->nmeasures(), timer.elapsed());
     }
 
     return ret;
@@ -137,6 +164,9 @@ mu::Ret MasterNotation::doLoadScore(Ms::MasterScore* score,
     //score->updateExpressive(MuseScore::synthesizer("Fluid"));
     score->setSaved(true);
     score->setCreated(false);
+    if (!application()->noGui()) {
+        score->setLazyScoreLayouts(LAZY_LAYOUT_FIRST_PAGES);
+    }
     score->update();
 
     if (!score->sanityCheck(QString())) {
@@ -146,6 +176,64 @@ mu::Ret MasterNotation::doLoadScore(Ms::MasterScore* score,
     return make_ret(Ret::Code::Ok);
 }
 
+//! NOTE The templates new scores are made from are read once and kept, unless their file changed.
+//! They must not be modified: a new score only copies their parts, style, excerpts and first box,
+//! so they are not laid out either.
+static constexpr size_t MAX_TEMPLATE_SCORES = 8;
+
+struct TemplateScore {
+    QDateTime lastModified;
+    Ms::MasterScore* score = nullptr;
+    qint64 lastUsed = 0;
+};
+
+//! NOTE Never destroyed, so the scores are not deleted at exit after libmscore is torn down
+static std::map<QString, TemplateScore>& templateScores()
+{
+    static auto* scores = new std::map<QString, TemplateScore>();
+    return *scores;
+}
+
+mu::RetVal<Ms::MasterScore*> MasterNotation::templateScore(const io::path& path, const INotationReaderPtr& reader) const
+{
+    static qint64 useCount = 0;
+
+    RetVal<Ms::MasterScore*> result;
+    QFileInfo fi(path.toQString());
+    std::map<QString, TemplateScore>& scores = templateScores();
+
+    auto it = scores.find(fi.absoluteFilePath());
+    if (it != scores.end() && it->second.lastModified == fi.lastModified()) {
+        it->second.lastUsed = ++useCount;
+        result.ret = make_ret(Ret::Code::Ok);
+        result.val = it->second.score;
+        return result;
+    }
+
+    Ms::MasterScore* score = new Ms::MasterScore(scoreGlobal()->baseStyle());
+    score->setName(fi.completeBaseName());
+    result.ret = reader->read(score, path);
+    if (!result.ret) {
+        delete score;
+        return result;
+    }
+
+    if (it != scores.end()) {
+        delete it->second.score;
+        scores.erase(it);
+    } else if (scores.size() >= MAX_TEMPLATE_SCORES) {
+        auto oldest = std::min_element(scores.begin(), scores.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        delete oldest->second.score;
+        scores.erase(oldest);
+    }
+
+    scores[fi.absoluteFilePath()] = { fi.lastModified(), score, ++useCount };
+    result.val = score;
+    return result;
+}
+
 mu::io::path MasterNotation::path() const
 {
     const Ms::MasterScore* score = masterScore();
@@ -185,14 +273,13 @@ mu::Ret MasterNotation::createNew(const ScoreCreateOptions& scoreOptions)
             return make_ret(Ret::Code::InternalError);
         }
 
-        Ms::MasterScore* tscore = new Ms::MasterScore(scoreGlobal()->baseStyle());
-        Ret ret = doLoadScore(tscore, templatePath, reader);
-        if (!ret) {
-            delete tscore;
+        RetVal<Ms::MasterScore*> templ = templateScore(templatePath, reader);
+        if (!templ.ret) {
             delete score;
 
-            return ret;
+            return templ.ret;
         }
+        Ms::MasterScore* tscore = templ.val;
         score->setStyle(tscore->style());
 
         // create instruments from template
@@ -241,7 +328,6 @@ mu::Ret MasterNotation::createNew(const ScoreCreateOptions& scoreOptions)
             nvb->setRightMargin(tvb->rightMargin());
             nvb->setAutoSizeEnabled(tvb->isAutoSizeEnabled());
         }
-        delete tscore;
     } else {
         score = new Ms::MasterScore(scoreGlobal()->baseStyle());
     }
@@ -511,9 +597,15 @@ mu::RetVal<bool> MasterNotation::created() const
 
 mu::Ret MasterNotation::save(const io::path& path, SaveMode saveMode)
 {
+    TRACEFUNC;
+
+    masterScore()->finishScoreLayouts();
+
     switch (saveMode) {
     case SaveMode::SaveSelection:
         return saveSelectionOnScore(path);
+    case SaveMode::AutoSave:
+        return autosaveScore(path);
     case SaveMode::Unknown:
     case SaveMode::SaveAs:
     case SaveMode::SaveCopy:
@@ -534,6 +626,8 @@ mu::Ret MasterNotation::exportScore(const io::path& path, const std::string& suf
         return false;
     }
 
+    masterScore()->finishScoreLayouts();
+
     Ret ret = writer->write(shared_from_this(), file);
     file.close();
 
@@ -553,14 +647,17 @@ void MasterNotation::initExcerpts(const QList<Ms::Excerpt*>& scoreExcerpts)
 {
     QList<Ms::Excerpt*> excerpts = scoreExcerpts;
 
+    //! NOTE The excerpts created from the parts only describe them,
+    //! their scores are created when they are opened (see ExcerptNotation::createPartScore)
     if (scoreExcerpts.empty()) {
         excerpts = Ms::Excerpt::createExcerptsFromParts(score()->parts());
+    } else {
+        masterScore()->initExcerpts(excerpts);
     }
 
     ExcerptNotationList notationExcerpts;
 
     for (Ms::Excerpt* excerpt : excerpts) {
-        masterScore()->initExcerpt(excerpt);
         notationExcerpts.push_back(std::make_shared<ExcerptNotation>(excerpt));
     }
 
@@ -623,13 +720,19 @@ void MasterNotation::updateExcerpts()
     ExcerptNotationList newExcerpts;
 
     for (IExcerptNotationPtr excerpt : m_excerpts.val) {
-        if (!get_impl(excerpt)->excerpt()->isEmpty()) {
+        if (!get_impl(excerpt)->isEmpty()) {
             newExcerpts.push_back(excerpt);
         }
     }
 
     QList<Ms::Excerpt*> excerpts = score()->excerpts();
 
+    for (IExcerptNotationPtr excerpt : newExcerpts) {
+        if (!get_impl(excerpt)->isCreated()) {
+            excerpts.append(get_impl(excerpt)->excerpt());
+        }
+    }
+
     for (Part* part: score()->parts()) {
         bool isNewPart = true;
 
@@ -650,7 +753,6 @@ void MasterNotation::updateExcerpts()
 IExcerptNotationPtr MasterNotation::createExcerpt(Part* part)
 {
     Ms::Excerpt* excerpt = Ms::Excerpt::createExcerptFromPart(part);
-    masterScore()->initExcerpt(excerpt);
 
     return std::make_shared<ExcerptNotation>(excerpt);
 }
@@ -690,3 +792,47 @@ mu::Ret MasterNotation::saveSelectionOnScore(const mu::io::path& path)
 
     return ret;
 }
+
+mu::Ret MasterNotation::autosaveScore(const mu::io::path& path)
+{
+    if (path.empty()) {
+        return make_ret(Err::FileNotFound);
+    }
+
+    //! NOTE The previous autosave is still being written, this one is dropped
+    if (m_autosave.isRunning()) {
+        LOGI() << "autosave is still running, skipped: " << path;
+        return make_ret(Ret::Code::Ok);
+    }
+
+    //! NOTE Only the serialization runs on the main thread; compressing, writing,
+    //! syncing and renaming the file run in the background
+    QFileInfo fileInfo(path.toQString());
+    Ms::MsczSnapshot snapshot = score()->createMsczSnapshot(fileInfo.completeBaseName() + ".mscx", false, false);
+
+    m_autosave = QtConcurrent::run([snapshot, path]() {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        if (!snapshot.write(&buffer)) {
+            LOGE() << "failed compress autosave: " << path;
+            return;
+        }
+
+        QSaveFile file(path.toQString());
+        if (!file.open(QIODevice::WriteOnly)) {
+            LOGE() << "failed open autosave file: " << path << ", " << file.errorString();
+            return;
+        }
+
+        file.write(buffer.data());
+        file.flush();
+#ifdef Q_OS_UNIX
+        ::fsync(file.handle());
+#endif
+        if (!file.commit()) {
+            LOGE() << "failed write autosave file: " << path << ", " << file.errorString();
+        }
+    });
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -21,11 +21,14 @@
 
 #include <memory>
 
+#include <QFuture>
+
 #include "../imasternotation.h"
 #include "../inotationreadersregister.h"
 #include "../inotationwritersregister.h"
 
 #include "modularity/ioc.h"
+#include "iapplication.h"
 #include "notation.h"
 #include "retval.h"
 
@@ -38,6 +41,7 @@ class MasterNotation : public IMasterNotation, public Notation, public std::enab
 {
     INJECT(notation, INotationReadersRegister, readers)
     INJECT(notation, INotationWritersRegister, writers)
+    INJECT(notation, framework::IApplication, application)
 
 public:
     explicit MasterNotation();
@@ -68,6 +72,7 @@ private:
 
     Ret load(const io::path& path, const INotationReaderPtr& reader);
     Ret doLoadScore(Ms::MasterScore* score, const io::path& path, const INotationReaderPtr& reader) const;
+    RetVal<Ms::MasterScore*> templateScore(const io::path& path, const INotationReaderPtr& reader) const;
     mu::RetVal<Ms::MasterScore*> newScore(const ScoreCreateOptions& scoreInfo);
 
     void doSetExcerpts(ExcerptNotationList excerpts);
@@ -81,9 +86,11 @@ private:
 
     Ret saveScore(const io::path& path = io::path(), SaveMode saveMode = SaveMode::Unknown);
     Ret saveSelectionOnScore(const io::path& path = io::path());
+    Ret autosaveScore(const io::path& path);
 
     ValCh<ExcerptNotationList> m_excerpts;
     INotationPartsPtr m_parts;
+    QFuture<void> m_autosave;
 };
 }
 
@@ -19,6 +19,8 @@
 
 #include "masternotationparts.h"
 
+#include "excerptnotation.h"
+
 using namespace mu::notation;
 
 MasterNotationParts::MasterNotationParts(IGetScore* getScore, INotationInteractionPtr interaction, INotationUndoStackPtr undoStack)
@@ -302,6 +304,11 @@ std::vector<INotationPartsPtr> MasterNotationParts::excerptsParts() const
     std::vector<INotationPartsPtr> result;
 
     for (IExcerptNotationPtr excerpt : m_excerpts) {
+        //! NOTE The parts not created yet are cloned from the master score when they are opened
+        if (!static_cast<ExcerptNotation*>(excerpt.get())->isCreated()) {
+            continue;
+        }
+
         result.push_back(excerpt->notation()->parts());
     }
 
@@ -23,6 +23,12 @@ using namespace mu::notation;
 
 void MidiInputController::init()
 {
+    //! NOTE The audio thread plays the input itself, the notation only gets the notes
+    midiInPort()->setIsMonitoring(configuration()->isMidiInputEnabled());
+    configuration()->isMidiInputEnabledChanged().onReceive(this, [this](bool enabled) {
+        midiInPort()->setIsMonitoring(enabled);
+    });
+
     midiInPort()->eventReceived().onReceive(this, [this](const std::pair<midi::tick_t, midi::Event>& ev) {
         if (!configuration()->isMidiInputEnabled()) {
             return;
@@ -1,8 +1,14 @@
 #include "msczmetareader.h"
 
+#include <memory>
 #include <sstream>
 
-#include <QBuffer>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
 
 #include "log.h"
 #include "stringutils.h"
@@ -16,6 +22,26 @@ using namespace mu::notation;
 using namespace mu::framework;
 using namespace mu::system;
 
+static constexpr quint32 INDEX_MAGIC = 0x4d534d49;
+static constexpr quint32 INDEX_VERSION = 1;
+
+//! NOTE The score lists show the thumbnails at most at this size, on a screen of double density
+static const QSize THUMBNAIL_DISPLAY_SIZE(344, 448);
+
+static QImage decodeThumbnail(const QByteArray& png)
+{
+    QImage image;
+    if (png.isEmpty() || !image.loadFromData(png, "PNG")) {
+        return QImage();
+    }
+
+    if (image.width() > THUMBNAIL_DISPLAY_SIZE.width() || image.height() > THUMBNAIL_DISPLAY_SIZE.height()) {
+        image = image.scaled(THUMBNAIL_DISPLAY_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return image;
+}
+
 MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
 {
     MetaList result;
@@ -34,6 +60,82 @@ MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
     return result;
 }
 
+MetaList MsczMetaReader::readIndexedMetaList(const io::paths& filePaths) const
+{
+    loadIndex();
+
+    std::vector<IndexEntry> entries(filePaths.size());
+    std::vector<char> isChanged(filePaths.size(), false);
+    QVector<int> changed;
+    QVector<int> undecoded;
+
+    for (size_t i = 0; i < filePaths.size(); ++i) {
+        QFileInfo fileInfo(filePaths[i].toQString());
+        if (!fileInfo.exists()) {
+            LOGE() << "File not exists: " << filePaths[i];
+            entries[i].ret = make_ret(Err::FileNotFound);
+            continue;
+        }
+
+        auto it = m_index.find(fileInfo.absoluteFilePath());
+        if (it != m_index.end()
+            && it->second.lastModified == fileInfo.lastModified().toMSecsSinceEpoch()
+            && it->second.size == fileInfo.size()) {
+            entries[i] = it->second;
+            if (entries[i].thumbnailPixmap.isNull() && !entries[i].thumbnail.isEmpty()) {
+                undecoded.push_back(int(i));
+            }
+        } else {
+            changed.push_back(int(i));
+            isChanged[i] = true;
+        }
+    }
+
+    //! NOTE The files are independent, only the main thread touches the index.
+    //! The thumbnails are decoded here too, so the main thread only makes each pixmap, once
+    QVector<int> work = changed + undecoded;
+    QtConcurrent::blockingMap(work, [this, &entries, &isChanged, &filePaths](int i) {
+        if (isChanged[i]) {
+            entries[i] = readIndexEntry(filePaths[i]);
+        }
+        entries[i].thumbnailImage = decodeThumbnail(entries[i].thumbnail);
+    });
+
+    for (int i : work) {
+        IndexEntry& entry = entries[i];
+        if (!entry.ret) {
+            continue;
+        }
+
+        if (!entry.thumbnailImage.isNull()) {
+            entry.thumbnailPixmap = QPixmap::fromImage(entry.thumbnailImage);
+            entry.thumbnailImage = QImage();
+        }
+
+        m_index[QFileInfo(filePaths[i].toQString()).absoluteFilePath()] = entry;
+        if (isChanged[i]) {
+            m_indexChanged = true;
+        }
+    }
+
+    MetaList result;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!entries[i].ret) {
+            LOGE() << entries[i].ret.toString();
+            continue;
+        }
+
+        Meta meta = entries[i].meta;
+        meta.filePath = filePaths[i];
+        meta.thumbnail = entries[i].thumbnailPixmap;
+        result.push_back(meta);
+    }
+
+    saveIndex();
+
+    return result;
+}
+
 mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
 {
     RetVal<Meta> meta;
@@ -44,37 +146,64 @@ mu::RetVal<Meta> MsczMetaReader::readMeta(const io::path& filePath) const
         return meta;
     }
 
+    QByteArray thumbnail;
+    meta.ret = readFile(filePath, meta.val, thumbnail);
+    if (!thumbnail.isEmpty()) {
+        meta.val.thumbnail.loadFromData(thumbnail, "PNG");
+    }
+
+    return meta;
+}
+
+MsczMetaReader::IndexEntry MsczMetaReader::readIndexEntry(const io::path& filePath) const
+{
+    IndexEntry entry;
+
+    QFileInfo fileInfo(filePath.toQString());
+    entry.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    entry.size = fileInfo.size();
+    entry.ret = readFile(filePath, entry.meta, entry.thumbnail);
+
+    return entry;
+}
+
+mu::Ret MsczMetaReader::readFile(const io::path& filePath, Meta& meta, QByteArray& thumbnail) const
+{
+    RetVal<Meta> result;
+
     bool compressed = io::syffix(filePath) == "mscz";
 
     if (compressed) {
-        meta = loadCompressedMsc(filePath);
+        result = loadCompressedMsc(filePath, thumbnail);
     } else {
         framework::XmlReader reader(filePath);
-        meta = doReadMeta(reader);
+        result = doReadMeta(reader);
     }
 
-    if (meta.val.fileName.empty()) {
-        meta.val.fileName = io::basename(filePath);
+    meta = result.val;
+
+    if (meta.fileName.empty()) {
+        meta.fileName = io::basename(filePath);
     }
 
-    meta.val.filePath = filePath;
+    meta.filePath = filePath;
 
-    return meta;
+    return result.ret;
 }
 
-mu::RetVal<Meta> MsczMetaReader::loadCompressedMsc(const io::path& filePath) const
+mu::RetVal<Meta> MsczMetaReader::loadCompressedMsc(const io::path& filePath, QByteArray& thumbnail) const
 {
     RetVal<Meta> meta;
 
-    RetVal<QByteArray> data = fileSystem()->readFile(filePath);
-    if (!data.ret) {
-        meta.ret = data.ret;
+    //! NOTE The archive is mapped, only the central directory, the thumbnail
+    //! and the head of the root file up to the first staff are read
+    QFile file(filePath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        meta.ret = make_ret(Err::FileOpenError);
         return meta;
     }
 
-    QBuffer buffer(&data.val);
-
-    MQZipReader zipReader(&buffer);
+    MQZipReader zipReader(&file);
 
     io::path rootFile = readRootFile(&zipReader);
     if (rootFile.empty()) {
@@ -82,25 +211,110 @@ mu::RetVal<Meta> MsczMetaReader::loadCompressedMsc(const io::path& filePath) con
         return meta;
     }
 
-    QByteArray rootBuffer = zipReader.fileData(rootFile.toQString());
-    if (rootBuffer.isEmpty()) {
+    std::unique_ptr<QIODevice> rootDevice(zipReader.fileDevice(rootFile.toQString()));
+    if (!rootDevice) {
         auto fil = zipReader.fileInfoList();
         for (const MQZipReader::FileInfo& fi : fil) {
             if (mu::strings::endsWith(fi.filePath.toStdString(), ".mscx")) {
-                rootBuffer = zipReader.fileData(fi.filePath);
+                rootDevice.reset(zipReader.fileDevice(fi.filePath));
                 break;
             }
         }
     }
 
-    framework::XmlReader xmlReader(rootBuffer);
+    if (!rootDevice) {
+        meta.ret = make_ret(Err::FileNoRootFile);
+        return meta;
+    }
+
+    framework::XmlReader xmlReader(rootDevice.get());
     meta = doReadMeta(xmlReader);
 
-    meta.val.thumbnail = loadThumbnail(&zipReader);
+    thumbnail = readThumbnail(&zipReader);
 
     return meta;
 }
 
+void MsczMetaReader::loadIndex() const
+{
+    if (m_indexLoaded) {
+        return;
+    }
+    m_indexLoaded = true;
+
+    QFile file(configuration()->scoreMetaIndexPath().toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> count;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        return;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        QString fileName;
+        quint64 partsCount = 0;
+        IndexEntry entry;
+        Meta& meta = entry.meta;
+
+        stream >> path >> entry.lastModified >> entry.size >> fileName
+        >> meta.title >> meta.subtitle >> meta.composer >> meta.lyricist
+        >> meta.copyright >> meta.translator >> meta.arranger >> partsCount
+        >> meta.creationDate >> entry.thumbnail;
+
+        meta.fileName = fileName;
+        meta.partsCount = partsCount;
+        entry.ret = make_ret(Err::NoError);
+
+        if (stream.status() == QDataStream::Ok) {
+            m_index[path] = entry;
+        }
+    }
+}
+
+void MsczMetaReader::saveIndex() const
+{
+    if (!m_indexChanged) {
+        return;
+    }
+    m_indexChanged = false;
+
+    io::path path = configuration()->scoreMetaIndexPath();
+    QDir().mkpath(io::dirpath(path).toQString());
+
+    QSaveFile file(path.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed open index: " << path;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << INDEX_MAGIC << INDEX_VERSION << quint32(m_index.size());
+
+    for (const auto& pair : m_index) {
+        const IndexEntry& entry = pair.second;
+        const Meta& meta = entry.meta;
+
+        stream << pair.first << entry.lastModified << entry.size << meta.fileName.toQString()
+               << meta.title << meta.subtitle << meta.composer << meta.lyricist
+               << meta.copyright << meta.translator << meta.arranger << quint64(meta.partsCount)
+               << meta.creationDate << entry.thumbnail;
+    }
+
+    if (!file.commit()) {
+        LOGE() << "failed write index: " << path;
+    }
+}
+
 MsczMetaReader::RawMeta MsczMetaReader::doReadBox(framework::XmlReader& xmlReader) const
 {
     RawMeta meta;
@@ -194,31 +408,28 @@ MsczMetaReader::RawMeta MsczMetaReader::doReadRawMeta(framework::XmlReader& xmlR
                 xmlReader.skipCurrentElement();
             }
         } else if (tag == "Staff") {
-            if (meta.titleStyle.isEmpty()) {
-                while (xmlReader.readNextStartElement()) {
-                    std::string boxTag(xmlReader.tagName());
-
-                    if (boxTag == "HBox"
-                        || boxTag == "VBox"
-                        || boxTag == "TBox"
-                        || boxTag == "FBox") {
-                        RawMeta boxMeta = doReadBox(xmlReader);
-
-                        meta.titleStyle = boxMeta.titleStyle;
-                        meta.titleStyleHtml = boxMeta.titleStyleHtml;
-                        meta.subtitleStyle = boxMeta.subtitleStyle;
-                        meta.subtitleStyleHtml = boxMeta.subtitleStyleHtml;
-                        meta.composerStyle = boxMeta.composerStyle;
-                        meta.composerStyleHtml = boxMeta.composerStyleHtml;
-                        meta.lyricistStyle = boxMeta.lyricistStyle;
-                        meta.lyricistStyleHtml = boxMeta.lyricistStyleHtml;
-                    } else {
-                        xmlReader.skipCurrentElement();
-                    }
+            //! NOTE The meta tags and the parts come before the staves and the
+            //! title frame starts the first staff, the measures are not needed
+            if (xmlReader.readNextStartElement()) {
+                std::string boxTag(xmlReader.tagName());
+
+                if (boxTag == "HBox"
+                    || boxTag == "VBox"
+                    || boxTag == "TBox"
+                    || boxTag == "FBox") {
+                    RawMeta boxMeta = doReadBox(xmlReader);
+
+                    meta.titleStyle = boxMeta.titleStyle;
+                    meta.titleStyleHtml = boxMeta.titleStyleHtml;
+                    meta.subtitleStyle = boxMeta.subtitleStyle;
+                    meta.subtitleStyleHtml = boxMeta.subtitleStyleHtml;
+                    meta.composerStyle = boxMeta.composerStyle;
+                    meta.composerStyleHtml = boxMeta.composerStyleHtml;
+                    meta.lyricistStyle = boxMeta.lyricistStyle;
+                    meta.lyricistStyleHtml = boxMeta.lyricistStyleHtml;
                 }
-            } else {
-                xmlReader.skipCurrentElement();
             }
+            break;
         } else if (tag == "Part") {
             meta.partsCount++;
             xmlReader.skipCurrentElement();
@@ -245,11 +456,13 @@ RetVal<Meta> MsczMetaReader::doReadMeta(framework::XmlReader& xmlReader) const
                 while (xmlReader.readNextStartElement()) {
                     if (xmlReader.tagName() == "Score") {
                         rawMeta = doReadRawMeta(xmlReader);
+                        break;
                     } else {
                         xmlReader.skipCurrentElement();
                     }
                 }
             }
+            break;
         } else {
             xmlReader.skipCurrentElement();
         }
@@ -337,19 +550,15 @@ io::path MsczMetaReader::readRootFile(MQZipReader* zipReader) const
     return rootFile;
 }
 
-QPixmap MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
+QByteArray MsczMetaReader::readThumbnail(MQZipReader* zipReader) const
 {
     QByteArray thumbnailBuffer = zipReader->fileData("Thumbnails/thumbnail.png");
 
     if (thumbnailBuffer.isEmpty()) {
         LOGD() << "Can't find thumbnail";
-        return QPixmap();
     }
 
-    QPixmap thumbnail;
-    thumbnail.loadFromData(thumbnailBuffer, "PNG");
-
-    return thumbnail;
+    return thumbnailBuffer;
 }
 
 QString MsczMetaReader::formatFromXml(const std::string& xml) const
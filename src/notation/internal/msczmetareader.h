@@ -19,10 +19,16 @@
 #ifndef MU_NOTATION_MSCZMETAREADER_H
 #define MU_NOTATION_MSCZMETAREADER_H
 
+#include <map>
+
+#include <QImage>
+#include <QPixmap>
+
 #include "imsczmetareader.h"
 
 #include "system/ifilesystem.h"
 #include "modularity/ioc.h"
+#include "inotationconfiguration.h"
 
 namespace mu::framework {
 class XmlReader;
@@ -34,13 +40,32 @@ namespace mu::notation {
 class MsczMetaReader : public IMsczMetaReader
 {
     INJECT(notation, system::IFileSystem, fileSystem)
+    INJECT(notation, INotationConfiguration, configuration)
 
 public:
     MetaList readMetaList(const io::paths& filePaths) const override;
+    MetaList readIndexedMetaList(const io::paths& filePaths) const override;
 
 private:
     RetVal<Meta> readMeta(const io::path& filePath) const;
 
+    //! NOTE Everything read from one file. The thumbnail is decoded in the worker threads,
+    //! the pixmap can only be made in the main thread and is kept in the index for the next lists
+    struct IndexEntry {
+        Ret ret;
+        Meta meta;
+        QByteArray thumbnail;
+        QImage thumbnailImage;
+        QPixmap thumbnailPixmap;
+        qint64 lastModified = 0;
+        qint64 size = 0;
+    };
+
+    IndexEntry readIndexEntry(const io::path& filePath) const;
+    Ret readFile(const io::path& filePath, Meta& meta, QByteArray& thumbnail) const;
+    void loadIndex() const;
+    void saveIndex() const;
+
     struct RawMeta {
         QString titleTag;
         QString titleAttribute;
@@ -69,9 +94,9 @@ private:
 
     RetVal<Meta> doReadMeta(framework::XmlReader& xmlReader) const;
     RawMeta doReadBox(framework::XmlReader& xmlReader) const;
-    RetVal<Meta> loadCompressedMsc(const io::path& filePath) const;
+    RetVal<Meta> loadCompressedMsc(const io::path& filePath, QByteArray& thumbnail) const;
     io::path readRootFile(MQZipReader* zipReader) const;
-    QPixmap loadThumbnail(MQZipReader* zipReader) const;
+    QByteArray readThumbnail(MQZipReader* zipReader) const;
     RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
@@ -82,6 +107,10 @@ private:
 
     QString readText(framework::XmlReader& xmlReader) const;
     QString readMetaTagText(framework::XmlReader& xmlReader) const;
+
+    mutable std::map<QString, IndexEntry> m_index;
+    mutable bool m_indexLoaded = false;
+    mutable bool m_indexChanged = false;
 };
 }
 
@@ -54,6 +54,10 @@ static const QString PLATFORM_TAG("platform");
 static const QString MOVEMENT_TITLE_TAG("movementTitle");
 static const QString MOVEMENT_NUMBER_TAG("movementNumber");
 
+//! NOTE A notation which was not painted for this long is in a background tab,
+//! its spatial indexes and paint lists are freed and rebuilt when it is shown again
+static constexpr int RELEASE_CACHES_DELAY_MS = 10 * 60 * 1000;
+
 static bool isStandardTag(const QString& tag)
 {
     static const QSet<QString> standardTags {
@@ -81,7 +85,21 @@ Notation::Notation(Ms::Score* score)
     m_scoreGlobal = new Ms::MScore(); //! TODO May be static?
     m_opened.val = false;
 
-    m_undoStack = std::make_shared<NotationUndoStack>(this, m_notationChanged);
+    QObject::connect(&m_layoutTimer, &QTimer::timeout, [this]() {
+        continueLayout();
+    });
+
+    m_releaseTimer.setSingleShot(true);
+    m_releaseTimer.setInterval(RELEASE_CACHES_DELAY_MS);
+    QObject::connect(&m_releaseTimer, &QTimer::timeout, [this]() {
+        releaseCaches();
+    });
+
+    m_notationChanges.onReceive(this, [this](const NotationChanges&) {
+        m_notationChanged.notify();
+    });
+
+    m_undoStack = std::make_shared<NotationUndoStack>(this, m_notationChanges);
     m_interaction = std::make_shared<NotationInteraction>(this, m_undoStack);
     m_playback = std::make_shared<NotationPlayback>(this, m_notationChanged);
     m_midiInput = std::make_shared<NotationMidiInput>(this, m_undoStack);
@@ -128,6 +146,9 @@ Notation::~Notation()
 
 void Notation::init()
 {
+    Ms::MScore::fontMetricsCachePath = configuration()->fontMetricsCachePath().toQString();
+    Ms::MScore::scoreTokensCachePath = configuration()->scoreTokensCachePath().toQString();
+    Ms::MScore::undoLimit = configuration()->undoLimit();
     Ms::MScore::init(); // initialize libmscore
 
     Ms::MScore::setNudgeStep(.1); // cursor key (default 0.1)
@@ -151,6 +172,25 @@ void Notation::setScore(Ms::Score* score)
         static_cast<NotationInteraction*>(m_interaction.get())->init();
         static_cast<NotationPlayback*>(m_playback.get())->init();
     }
+
+    if (score && score->layoutPending()) {
+        m_layoutTimer.start(0);
+    } else {
+        m_layoutTimer.stop();
+    }
+}
+
+//! NOTE The first pages of a score that was just read are laid out
+//! before it is shown, the others are laid out here, a few at a time
+//! between the events
+void Notation::continueLayout()
+{
+    static constexpr int LAYOUT_PAGES_PER_STEP = 2;
+
+    if (!m_score || m_score->continueLayout(LAYOUT_PAGES_PER_STEP)) {
+        m_layoutTimer.stop();
+    }
+    notifyAboutNotationChanged();
 }
 
 Ms::MScore* Notation::scoreGlobal() const
@@ -240,6 +280,30 @@ ViewMode Notation::viewMode() const
 }
 
 void Notation::paint(mu::draw::Painter* painter, const QRectF& frameRect)
+{
+    TRACEFUNC;
+
+    if (score()->pages().empty()) {
+        return;
+    }
+
+    paintScore(painter, frameRect);
+    paintInteraction(painter);
+
+    m_releaseTimer.start();
+}
+
+void Notation::releaseCaches()
+{
+    if (!m_score) {
+        return;
+    }
+
+    m_score->releaseBspTree();
+    std::vector<Ms::Element*>().swap(m_paintElements);
+}
+
+void Notation::paintScore(mu::draw::Painter* painter, const QRectF& frameRect)
 {
     const QList<Ms::Page*>& pages = score()->pages();
     if (pages.empty()) {
@@ -259,7 +323,10 @@ void Notation::paint(mu::draw::Painter* painter, const QRectF& frameRect)
         paintPages(painter, frameRect, pages, paintBorders);
     }
     }
+}
 
+void Notation::paintInteraction(mu::draw::Painter* painter)
+{
     static_cast<NotationInteraction*>(m_interaction.get())->paint(painter);
 }
 
@@ -284,8 +351,11 @@ void Notation::paintPages(draw::Painter* painter, const QRectF& frameRect, const
         painter->translate(pagePosition);
         painter->fillRect(page->bbox(), configuration()->pageColor());
 
-        QList<Element*> elements = page->items(frameRect.translated(-page->pos()));
-        Ms::paintElements(*painter, elements);
+        m_paintElements.clear();
+        page->visitItems(frameRect.translated(-page->pos()), [this](Element* e) {
+            m_paintElements.push_back(e);
+        });
+        Ms::paintElements(*painter, m_paintElements);
 
         painter->translate(-pagePosition);
     }
@@ -329,7 +399,10 @@ void Notation::setOpened(bool opened)
 
 void Notation::notifyAboutNotationChanged()
 {
-    m_notationChanged.notify();
+    //! NOTE A command notifies after its changes were committed, they tell what it changed
+    if (!m_notationChanges.isPending()) {
+        m_notationChanges.send(NotationChanges());
+    }
 }
 
 INotationInteractionPtr Notation::interaction() const
@@ -367,6 +440,11 @@ mu::async::Notification Notation::notationChanged() const
     return m_notationChanged;
 }
 
+mu::async::Channel<NotationChanges> Notation::notationChanges() const
+{
+    return m_notationChanges.channel();
+}
+
 INotationAccessibilityPtr Notation::accessibility() const
 {
     return m_accessibility;
@@ -19,9 +19,14 @@
 #ifndef MU_NOTATION_NOTATION_H
 #define MU_NOTATION_NOTATION_H
 
+#include <vector>
+
+#include <QTimer>
+
 #include "inotation.h"
 #include "igetscore.h"
 #include "async/asyncable.h"
+#include "async/coalescedchannel.h"
 
 #include "modularity/ioc.h"
 #include "inotationconfiguration.h"
@@ -53,6 +58,8 @@ public:
     void setViewMode(const ViewMode& viewMode) override;
     ViewMode viewMode() const override;
     void paint(draw::Painter* painter, const QRectF& frameRect) override;
+    void paintScore(draw::Painter* painter, const QRectF& frameRect) override;
+    void paintInteraction(draw::Painter* painter) override;
 
     ValCh<bool> opened() const override;
     void setOpened(bool opened) override;
@@ -67,6 +74,7 @@ public:
     INotationPartsPtr parts() const override;
 
     async::Notification notationChanged() const override;
+    async::Channel<NotationChanges> notationChanges() const override;
 
 protected:
     Ms::Score* score() const override;
@@ -81,6 +89,8 @@ private:
     void paintPageBorder(mu::draw::Painter* painter, const Ms::Page* page) const;
 
     QSizeF viewSize() const;
+    void continueLayout();
+    void releaseCaches();
 
     QSizeF m_viewSize;
     Ms::MScore* m_scoreGlobal = nullptr;
@@ -96,6 +106,11 @@ private:
     INotationElementsPtr m_elements;
     INotationPartsPtr m_parts;
 
+    mutable std::vector<Ms::Element*> m_paintElements;      // reused by every paint
+    QTimer m_layoutTimer;                                   // goes on with a lazy layout while idle
+    QTimer m_releaseTimer;                                  // frees the paint caches when not painted for a while
+
+    async::CoalescedChannel<NotationChanges> m_notationChanges;
     async::Notification m_notationChanged;
 };
 }
@@ -38,6 +38,10 @@ NotationAccessibility::NotationAccessibility(const IGetScore* getScore, Notifica
     : m_getScore(getScore)
 {
     selectionChangedNotification.onNotify(this, [this]() {
+        m_selectionChanged.notify();
+    });
+
+    m_selectionChanged.onNotify(this, [this]() {
         if (score()) {
             updateAccessibilityInfo();
         }
@@ -56,6 +60,8 @@ const Ms::Selection* NotationAccessibility::selection() const
 
 mu::ValCh<std::string> NotationAccessibility::accessibilityInfo() const
 {
+    //! NOTE The pending selection change is applied first, so that the info is up to date
+    m_selectionChanged.flush();
     return m_accessibilityInfo;
 }
 
@@ -64,7 +70,18 @@ void NotationAccessibility::updateAccessibilityInfo()
     QString newAccessibilityInfo;
 
     if (selection()->isSingle()) {
-        newAccessibilityInfo = singleElementAccessibilityInfo();
+        //! NOTE The info of an element only changes with the score, the one of a revisited element is reused
+        if (m_cacheRevision != score()->changeRevision()) {
+            m_elementInfoCache.clear();
+            m_cacheRevision = score()->changeRevision();
+        }
+
+        const Element* element = selection()->element();
+        auto it = m_elementInfoCache.constFind(element);
+        if (it == m_elementInfoCache.constEnd()) {
+            it = m_elementInfoCache.insert(element, singleElementAccessibilityInfo());
+        }
+        newAccessibilityInfo = it.value();
     } else if (selection()->isRange()) {
         newAccessibilityInfo = rangeAccessibilityInfo();
     } else if (selection()->isList()) {
@@ -23,8 +23,11 @@
 #include "inotationaccessibility.h"
 #include "notationtypes.h"
 
+#include <QHash>
+
 #include "async/asyncable.h"
 #include "async/notification.h"
+#include "async/coalescednotification.h"
 
 namespace Ms {
 class Score;
@@ -58,6 +61,10 @@ private:
 
     const IGetScore* m_getScore = nullptr;
     ValCh<std::string> m_accessibilityInfo;
+
+    mutable async::CoalescedNotification m_selectionChanged;      // the info is built once for the moves in a row
+    int m_cacheRevision = -1;
+    QHash<const Element*, QString> m_elementInfoCache;            // for the score change revision m_cacheRevision
 };
 }
 }
@@ -67,6 +67,8 @@ static const Settings::Key TOOLBAR_KEY(module_name, "ui/toolbar/");
 
 static const Settings::Key IS_CANVAS_ORIENTATION_VERTICAL_KEY(module_name, "ui/canvas/scroll/verticalOrientation");
 
+static const Settings::Key UNDO_LIMIT(module_name, "application/undo/limit");
+
 void NotationConfiguration::init()
 {
     settings()->setDefaultValue(ANCHORLINE_COLOR, Val(QColor("#C31989")));
@@ -95,7 +97,11 @@ void NotationConfiguration::init()
     });
 
     settings()->setDefaultValue(SELECTION_PROXIMITY, Val(6));
+    settings()->setDefaultValue(UNDO_LIMIT, Val(1000));
     settings()->setDefaultValue(IS_MIDI_INPUT_ENABLED, Val(false));
+    settings()->valueChanged(IS_MIDI_INPUT_ENABLED).onReceive(nullptr, [this](const Val& val) {
+        m_isMidiInputEnabledChanged.send(val.toBool());
+    });
     settings()->setDefaultValue(IS_AUTOMATICALLY_PAN_ENABLED, Val(true));
     settings()->setDefaultValue(IS_PLAY_REPEATS_ENABLED, Val(false));
     settings()->setDefaultValue(IS_METRONOME_ENABLED, Val(false));
@@ -227,6 +233,26 @@ io::path NotationConfiguration::stylesDirPath() const
     return settings()->value(STYLES_DIR_KEY).toString();
 }
 
+io::path NotationConfiguration::fontMetricsCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/fontmetrics";
+}
+
+io::path NotationConfiguration::scoreMetaIndexPath() const
+{
+    return globalConfiguration()->dataPath() + "/scoremeta.index";
+}
+
+io::path NotationConfiguration::scoreTokensCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/scoretokens";
+}
+
+int NotationConfiguration::undoLimit() const
+{
+    return settings()->value(UNDO_LIMIT).toInt();
+}
+
 bool NotationConfiguration::isMidiInputEnabled() const
 {
     return settings()->value(IS_MIDI_INPUT_ENABLED).toBool();
@@ -237,6 +263,11 @@ void NotationConfiguration::setIsMidiInputEnabled(bool enabled)
     settings()->setValue(IS_MIDI_INPUT_ENABLED, Val(enabled));
 }
 
+async::Channel<bool> NotationConfiguration::isMidiInputEnabledChanged() const
+{
+    return m_isMidiInputEnabledChanged;
+}
+
 bool NotationConfiguration::isAutomaticallyPanEnabled() const
 {
     return settings()->value(IS_AUTOMATICALLY_PAN_ENABLED).toBool();
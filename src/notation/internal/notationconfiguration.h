@@ -68,9 +68,15 @@ public:
     int fontSize() const override;
 
     io::path stylesDirPath() const override;
+    io::path fontMetricsCachePath() const override;
+    io::path scoreMetaIndexPath() const override;
+    io::path scoreTokensCachePath() const override;
+
+    int undoLimit() const override;
 
     bool isMidiInputEnabled() const override;
     void setIsMidiInputEnabled(bool enabled) override;
+    async::Channel<bool> isMidiInputEnabledChanged() const override;
 
     bool isAutomaticallyPanEnabled() const override;
     void setIsAutomaticallyPanEnabled(bool enabled) override;
@@ -103,6 +109,7 @@ private:
     async::Channel<QColor> m_backgroundColorChanged;
     async::Channel<QColor> m_foregroundColorChanged;
     async::Channel<int> m_currentZoomChanged;
+    async::Channel<bool> m_isMidiInputEnabledChanged;
     async::Channel<framework::Orientation> m_canvasOrientationChanged;
 };
 }
@@ -90,22 +90,48 @@ std::vector<Element*> NotationElements::elements(const FilterElementsOptions& el
     return result;
 }
 
-Ms::RehearsalMark* NotationElements::rehearsalMark(const std::string& name) const
+const NotationElements::SearchIndex& NotationElements::searchIndex() const
 {
-    QString qname = QString::fromStdString(name).toLower();
+    Ms::ScoreContentState state = score()->state();
+    if (m_searchIndexValid && m_searchIndex.state == state) {
+        return m_searchIndex;
+    }
+
+    m_searchIndex = SearchIndex();
+    m_searchIndex.state = state;
+
+    for (Ms::Measure* measure = score()->firstMeasure(); measure; measure = measure->nextMeasure()) {
+        m_searchIndex.measures.push_back(measure);
+    }
 
     for (Ms::Segment* segment = score()->firstSegment(Ms::SegmentType::ChordRest); segment;
          segment = segment->next1(Ms::SegmentType::ChordRest)) {
         for (Element* element: segment->annotations()) {
-            if (element->type() != ElementType::REHEARSAL_MARK) {
-                continue;
+            if (element->type() == ElementType::REHEARSAL_MARK) {
+                Ms::RehearsalMark* rehearsalMark = static_cast<Ms::RehearsalMark*>(element);
+                m_searchIndex.rehearsalMarks.push_back({ rehearsalMark->plainText().toLower(), rehearsalMark });
             }
+        }
+    }
 
-            Ms::RehearsalMark* rehearsalMark = static_cast<Ms::RehearsalMark*>(element);
-            QString rehearsalMarkName = rehearsalMark->plainText().toLower();
-            if (rehearsalMarkName.startsWith(qname)) {
-                return rehearsalMark;
-            }
+    m_searchIndexValid = true;
+    return m_searchIndex;
+}
+
+Ms::RehearsalMark* NotationElements::rehearsalMark(const std::string& name) const
+{
+    QString qname = QString::fromStdString(name).toLower();
+    const SearchIndex& index = searchIndex();
+
+    //! NOTE A mark that starts with the name wins over one that only contains it
+    for (const auto& mark : index.rehearsalMarks) {
+        if (mark.first.startsWith(qname)) {
+            return mark.second;
+        }
+    }
+    for (const auto& mark : index.rehearsalMarks) {
+        if (mark.first.contains(qname)) {
+            return mark.second;
         }
     }
 
@@ -114,7 +140,12 @@ Ms::RehearsalMark* NotationElements::rehearsalMark(const std::string& name) cons
 
 Ms::Measure* NotationElements::measure(const int measureIndex) const
 {
-    return score()->crMeasure(measureIndex);
+    const SearchIndex& index = searchIndex();
+    if (measureIndex < 0 || measureIndex >= int(index.measures.size())) {
+        return nullptr;
+    }
+
+    return index.measures[measureIndex];
 }
 
 PageList NotationElements::pages() const
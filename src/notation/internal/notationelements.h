@@ -17,6 +17,8 @@
 #ifndef MU_NOTATION_NOTATIONELEMENTS_H
 #define MU_NOTATION_NOTATIONELEMENTS_H
 
+#include <QString>
+
 #include "inotationelements.h"
 #include "igetscore.h"
 
@@ -35,7 +37,16 @@ public:
     PageList pages() const override;
 
 private:
+    //! NOTE What the search looks up, in score order. It is built again when the content of the score
+    //! has changed: every edit, undo and redo gives the score another state
+    struct SearchIndex {
+        Ms::ScoreContentState state;
+        std::vector<Ms::Measure*> measures;
+        std::vector<std::pair<QString, Ms::RehearsalMark*> > rehearsalMarks;   // lower case text
+    };
+
     Ms::Score* score() const;
+    const SearchIndex& searchIndex() const;
 
     Ms::RehearsalMark* rehearsalMark(const std::string& name) const;
     Ms::Page* page(const int pageIndex) const;
@@ -49,6 +60,8 @@ private:
     Ms::NotePattern* constructNotePattern(const FilterNotesOptions* notesOptions) const;
 
     IGetScore* m_getScore = nullptr;
+    mutable SearchIndex m_searchIndex;
+    mutable bool m_searchIndexValid = false;
 };
 }
 
@@ -71,6 +71,12 @@ NotationInteraction::NotationInteraction(Notation* notation, INotationUndoStackP
     m_dragData.ed.view = new ScoreCallbacks();
     m_dropData.ed.view = new ScoreCallbacks();
     m_gripEditData.view = new ScoreCallbacks();
+
+    m_dragTimer.setSingleShot(true);
+    m_dragTimer.setInterval(0);
+    QObject::connect(&m_dragTimer, &QTimer::timeout, [this]() {
+        flushDrag();
+    });
 }
 
 NotationInteraction::~NotationInteraction()
@@ -292,7 +298,6 @@ QList<Ms::Element*> NotationInteraction::hitElements(const QPointF& p_in, float
 
     QRectF r(p.x() - w, p.y() - w, 3.0 * w, 3.0 * w);
 
-    QList<Ms::Element*> elements = page->items(r);
     //! TODO
     //    for (int i = 0; i < MAX_HEADERS; i++)
     //        if (score()->headerText(i) != nullptr)      // gives the ability to select the header
@@ -302,39 +307,36 @@ QList<Ms::Element*> NotationInteraction::hitElements(const QPointF& p_in, float
     //            el.push_back(score()->footerText(i));
     //! -------
 
-    for (Ms::Element* element : elements) {
-        element->itemDiscovered = 0;
+    page->visitItems(p, [&ll](Ms::Element* element) {
         if (!element->selectable() || element->isPage()) {
-            continue;
+            return;
         }
 
         if (!element->isInteractionAvailable()) {
-            continue;
+            return;
         }
 
-        if (element->contains(p)) {
-            ll.append(element);
-        }
-    }
+        ll.append(element);
+    });
 
     int n = ll.size();
     if ((n == 0) || ((n == 1) && (ll[0]->isMeasure()))) {
         //
         // if no relevant element hit, look nearby
         //
-        for (Ms::Element* element : elements) {
+        page->visitItems(r, [&ll, &r](Ms::Element* element) {
             if (element->isPage() || !element->selectable()) {
-                continue;
+                return;
             }
 
             if (!element->isInteractionAvailable()) {
-                continue;
+                return;
             }
 
             if (element->intersects(r)) {
                 ll.append(element);
             }
-        }
+        });
     }
 
     if (!ll.empty()) {
@@ -462,12 +464,15 @@ void NotationInteraction::DragData::reset()
     elementOffset = QPointF();
     ed = Ms::EditData();
     dragGroups.clear();
+    isMovePending = false;
+    layoutStartTick = Ms::Fraction(-1, 1);
 }
 
 void NotationInteraction::startDrag(const std::vector<Element*>& elems,
                                     const QPointF& eoffset,
                                     const IsDraggable& isDraggable)
 {
+    m_dragTimer.stop();
     m_dragData.reset();
     m_dragData.elements = elems;
     m_dragData.elementOffset = eoffset;
@@ -496,6 +501,36 @@ void NotationInteraction::startDrag(const std::vector<Element*>& elems,
 }
 
 void NotationInteraction::drag(const QPointF& fromPos, const QPointF& toPos, DragMode mode)
+{
+    if (isTextEditingStarted()) {
+        doDrag(fromPos, toPos, mode);
+        return;
+    }
+
+    //! NOTE The move is done once the events queued meanwhile are handled,
+    //! so that a layout slower than the mouse events does not fall behind
+    if (!m_dragData.isMovePending) {
+        m_dragData.pendingFromPos = fromPos;
+        m_dragData.isMovePending = true;
+    }
+    m_dragData.pendingToPos = toPos;
+    m_dragData.pendingMode = mode;
+
+    m_dragTimer.start();
+}
+
+void NotationInteraction::flushDrag()
+{
+    m_dragTimer.stop();
+    if (!m_dragData.isMovePending) {
+        return;
+    }
+
+    m_dragData.isMovePending = false;
+    doDrag(m_dragData.pendingFromPos, m_dragData.pendingToPos, m_dragData.pendingMode);
+}
+
+void NotationInteraction::doDrag(const QPointF& fromPos, const QPointF& toPos, DragMode mode)
 {
     if (m_dragData.beginMove.isNull()) {
         m_dragData.beginMove = fromPos;
@@ -549,6 +584,16 @@ void NotationInteraction::drag(const QPointF& fromPos, const QPointF& toPos, Dra
         }
     }
 
+    //! NOTE While dragging only the systems of the changed range are laid out,
+    //! endDrag() lays out the score from the first of them to the end
+    Ms::CmdState& cmdState = score()->cmdState();
+    if (cmdState.layoutRange()) {
+        cmdState.layoutFlags |= Ms::LayoutFlag::SYSTEM_LOCAL;
+        if (m_dragData.layoutStartTick < Ms::Fraction(0, 1) || cmdState.startTick() < m_dragData.layoutStartTick) {
+            m_dragData.layoutStartTick = cmdState.startTick();
+        }
+    }
+
     score()->update();
 
     QVector<QLineF> anchorLines;
@@ -582,6 +627,8 @@ void NotationInteraction::drag(const QPointF& fromPos, const QPointF& toPos, Dra
 
 void NotationInteraction::endDrag()
 {
+    flushDrag();
+
     if (isGripEditStarted()) {
         m_gripEditData.element->endEditDrag(m_gripEditData);
     } else {
@@ -590,6 +637,10 @@ void NotationInteraction::endDrag()
         }
     }
 
+    if (m_dragData.layoutStartTick >= Ms::Fraction(0, 1)) {
+        score()->setLayout(m_dragData.layoutStartTick, score()->endTick(), 0, score()->nstaves() - 1);
+    }
+
     m_dragData.reset();
     resetAnchorLines();
     apply();
@@ -1992,14 +2043,12 @@ void NotationInteraction::addBoxes(BoxType boxType, int count, int beforeBoxInde
     Ms::ElementType elementType = boxTypeToElementType(boxType);
     Ms::MeasureBase* beforeBox = beforeBoxIndex >= 0 ? score()->measure(beforeBoxIndex) : nullptr;
 
-    startEdit();
-    for (int i = 0; i < count; ++i) {
-        constexpr bool createEmptyMeasures = false;
-        constexpr bool moveSignaturesClef = true;
-        constexpr bool needDeselectAll = false;
+    constexpr bool createEmptyMeasures = false;
+    constexpr bool moveSignaturesClef = true;
+    constexpr bool needDeselectAll = false;
 
-        score()->insertMeasure(elementType, beforeBox, createEmptyMeasures, moveSignaturesClef, needDeselectAll);
-    }
+    startEdit();
+    score()->insertMeasures(count, elementType, beforeBox, createEmptyMeasures, moveSignaturesClef, needDeselectAll);
     apply();
 
     notifyAboutNotationChanged();
@@ -2047,7 +2096,8 @@ void NotationInteraction::swapSelection()
     QString mimeType = selection.mimeType();
 
     if (mimeType == Ms::mimeStaffListFormat) { // determine size of clipboard selection
-        const QMimeData* mimeData = this->selection()->mimeData();
+        //! NOTE Only the StaffList tag is read, the clipboard data is shared and not serialized again
+        const QMimeData* mimeData = QApplication::clipboard()->mimeData();
         QByteArray data = mimeData ? mimeData->data(Ms::mimeStaffListFormat) : QByteArray();
         Ms::XmlReader reader(data);
         reader.readNextStartElement();
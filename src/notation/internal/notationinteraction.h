@@ -23,6 +23,7 @@
 #include <vector>
 #include <QPointF>
 #include <QLineF>
+#include <QTimer>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -165,6 +166,8 @@ private:
     void apply();
 
     void notifyAboutDragChanged();
+    void doDrag(const QPointF& fromPos, const QPointF& toPos, DragMode mode);
+    void flushDrag();
     void notifyAboutDropChanged();
     void notifyAboutSelectionChanged();
     void notifyAboutNotationChanged();
@@ -227,6 +230,15 @@ private:
         Ms::EditData ed;
         std::vector<Element*> elements;
         std::vector<std::unique_ptr<Ms::ElementGroup> > dragGroups;
+
+        //! NOTE The moves coming in while the score is laid out are taken as one
+        bool isMovePending = false;
+        QPointF pendingFromPos;
+        QPointF pendingToPos;
+        DragMode pendingMode = DragMode::BothXY;
+
+        Ms::Fraction layoutStartTick { -1, 1 };     // of the system local layouts while dragging
+
         void reset();
     };
 
@@ -246,6 +258,7 @@ private:
     async::Notification m_selectionChanged;
 
     DragData m_dragData;
+    QTimer m_dragTimer;
     async::Notification m_dragChanged;
     std::vector<QLineF> m_anchorLines;
 
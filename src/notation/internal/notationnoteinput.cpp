@@ -38,6 +38,10 @@ NotationNoteInput::NotationNoteInput(const IGetScore* getScore, INotationInterac
 {
     m_scoreCallbacks = new ScoreCallbacks();
 
+    m_typedStateChanged.onNotify(this, [this]() {
+        m_stateChanged.notify();
+    });
+
     m_interaction->selectionChanged().onNotify(this, [this]() {
         if (!isNoteInputMode()) {
             updateInputState();
@@ -181,7 +185,7 @@ void NotationNoteInput::addNote(NoteName noteName, NoteAddingMode addingMode)
     score()->cmdAddPitch(editData, inote, addToUpOnCurrentChord, insertNewChord);
     apply();
 
-    notifyAboutStateChanged();
+    notifyAboutTypedStateChanged();
 }
 
 void NotationNoteInput::padNote(const Pad& pad)
@@ -193,7 +197,7 @@ void NotationNoteInput::padNote(const Pad& pad)
     score()->padToggle(pad, ed);
     apply();
 
-    notifyAboutStateChanged();
+    notifyAboutTypedStateChanged();
 }
 
 void NotationNoteInput::putNote(const QPointF& pos, bool replace, bool insert)
@@ -354,7 +358,7 @@ void NotationNoteInput::addTie()
     score()->cmdAddTie();
     apply();
 
-    notifyAboutStateChanged();
+    notifyAboutTypedStateChanged();
 }
 
 Notification NotationNoteInput::noteAdded() const
@@ -394,6 +398,13 @@ void NotationNoteInput::notifyAboutStateChanged()
     m_stateChanged.notify();
 }
 
+//! NOTE The toolbar, the canvas position and the shadow note follow the state once
+//! the typed notes were handled, not after each of them
+void NotationNoteInput::notifyAboutTypedStateChanged()
+{
+    m_typedStateChanged.notify();
+}
+
 void NotationNoteInput::notifyNoteAddedChanged()
 {
     m_noteAdded.notify();
@@ -22,6 +22,7 @@
 #include "../inotationnoteinput.h"
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
+#include "async/coalescednotification.h"
 #include "inotationconfiguration.h"
 #include "igetscore.h"
 #include "inotationinteraction.h"
@@ -75,6 +76,7 @@ private:
 
     void updateInputState();
     void notifyAboutStateChanged();
+    void notifyAboutTypedStateChanged();
     void notifyNoteAddedChanged();
 
     std::set<SymbolId> articulationIds() const;
@@ -84,6 +86,7 @@ private:
     INotationUndoStackPtr m_undoStack;
 
     async::Notification m_stateChanged;
+    async::CoalescedNotification m_typedStateChanged;     // sent once for the notes typed in a row
     async::Notification m_noteAdded;
 
     ScoreCallbacks* m_scoreCallbacks = nullptr;
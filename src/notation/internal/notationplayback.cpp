@@ -18,9 +18,11 @@
 //=============================================================================
 #include "notationplayback.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "log.h"
+#include "commandstats.h"
 
 #include "libmscore/rendermidi.h"
 #include "libmscore/score.h"
@@ -30,6 +32,7 @@
 #include "libmscore/repeatlist.h"
 #include "libmscore/measure.h"
 #include "libmscore/segment.h"
+#include "libmscore/sig.h"
 #include "libmscore/system.h"
 #include "libmscore/sym.h"
 #include "libmscore/page.h"
@@ -48,6 +51,7 @@ using namespace mu::notation;
 using namespace mu::midi;
 
 static constexpr int MIN_CHUNK_SIZE(10); // measure
+static constexpr int PREPARE_DATA_DELAY_MS(500);
 
 NotationPlayback::NotationPlayback(IGetScore* getScore, async::Notification notationChanged)
     : m_getScore(getScore)
@@ -56,8 +60,22 @@ NotationPlayback::NotationPlayback(IGetScore* getScore, async::Notification nota
     m_midiStream->isStreamingAllowed = true;
     m_midiStream->request.onReceive(this, [this](tick_t tick) { onChunkRequest(tick); });
 
+    m_prepareTimer.setSingleShot(true);
+    m_prepareTimer.setInterval(PREPARE_DATA_DELAY_MS);
+    QObject::connect(&m_prepareTimer, &QTimer::timeout, [this]() {
+        if (score() && !isDataPrepared()) {
+            prepareData();
+        }
+    });
+
     notationChanged.onNotify(this, [this]() {
+        mu::commandstats::PhaseTimer statsTimer(mu::commandstats::Phase::Playback);
         updateLoopBoundaries();
+        updateDirtyChunks();
+
+        m_isDataPrepared = false;
+        m_isCursorMapValid = false;
+        schedulePrepareData();
     });
 }
 
@@ -83,10 +101,13 @@ void NotationPlayback::init()
     QObject::connect(score(), &Ms::Score::posChanged, [this](Ms::POS pos, int tick) {
         if (Ms::POS::CURRENT == pos) {
             m_playPositionTickChanged.send(tick);
+            schedulePrepareData();
         } else {
             updateLoopBoundaries();
         }
     });
+
+    schedulePrepareData();
 }
 
 void NotationPlayback::updateLoopBoundaries()
@@ -113,19 +134,125 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
         return nullptr;
     }
 
-    m_midiStream->initData = MidiData();
-    m_midiRenderer->setScoreChanged();
+    Ms::Fraction tick1, tick2;
+    if (masterScore()->takePlaybackDirtyRange(tick1, tick2) || !m_isDataPrepared) {
+        m_midiRenderer->setScoreChanged(); // everything is rendered anew
+        m_isDataPrepared = false;
+    }
 
-    makeInitData(m_midiStream->initData, score());
-    midi::Chunk firstChunk;
-    makeChunk(firstChunk, 0 /*fromTick*/);
-    m_midiStream->initData.chunks.insert({ firstChunk.beginTick, std::move(firstChunk) });
+    if (!isDataPrepared()) {
+        prepareData();
+    }
+
+    m_midiStream->initData = m_preparedData;
+    m_sentChunks.clear();
+    for (const auto& it : m_midiStream->initData.chunks) {
+        markChunkSent(it.second);
+    }
 
     m_midiStream->lastTick = score()->lastMeasure()->endTick().ticks();
 
     return m_midiStream;
 }
 
+void NotationPlayback::schedulePrepareData()
+{
+    //! NOTE Restarted by every edit and move of the play position, so it is done when the user is idle
+    m_prepareTimer.start();
+}
+
+//! NOTE The init data and the chunks at the beginning and at the play position,
+//! so that play does not wait for them to be rendered
+void NotationPlayback::prepareData() const
+{
+    if (!score() || !score()->lastMeasure() || !m_midiRenderer) {
+        return;
+    }
+
+    if (!m_isDataPrepared) {
+        m_preparedData = MidiData();
+        makeInitData(m_preparedData, score());
+    }
+
+    midi::Chunks& chunks = m_preparedData.chunks;
+    auto prepareChunk = [this, &chunks](tick_t tick) {
+        midi::Chunk chunk;
+        makeChunk(chunk, tick);
+        if (chunk.endTick > chunk.beginTick) {
+            chunks.insert({ chunk.beginTick, std::move(chunk) });
+        }
+    };
+
+    if (!isChunkPrepared(0)) {
+        prepareChunk(0);
+    }
+
+    const tick_t playTick = score()->playPos().ticks();
+    if (!isChunkPrepared(playTick)) {
+        //! NOTE Only the chunk at the beginning and the one at the last play position are kept
+        auto it = chunks.begin();
+        if (it != chunks.end() && it->first == 0) {
+            ++it;
+        }
+        chunks.erase(it, chunks.end());
+        prepareChunk(playTick);
+    }
+
+    m_isDataPrepared = true;
+}
+
+bool NotationPlayback::isDataPrepared() const
+{
+    return m_isDataPrepared && isChunkPrepared(score()->playPos().ticks());
+}
+
+//! NOTE Past the end there is nothing to render
+bool NotationPlayback::isChunkPrepared(tick_t tick) const
+{
+    const Ms::Measure* lastMeasure = score()->lastMeasure();
+    if (!lastMeasure || tick >= lastMeasure->endTick().ticks()) {
+        return true;
+    }
+
+    auto it = m_preparedData.chunks.upper_bound(tick);
+    if (it == m_preparedData.chunks.begin()) {
+        return false;
+    }
+    --it;
+    return it->second.endTick > tick;
+}
+
+MidiData NotationPlayback::exportMidiData() const
+{
+    MidiData data;
+    if (!score()) {
+        return data;
+    }
+
+    makeInitData(data, score());
+    return data;
+}
+
+midi::Chunk NotationPlayback::exportMidiChunk(tick_t fromTick) const
+{
+    midi::Chunk chunk;
+    IF_ASSERT_FAILED(m_midiRenderer) {
+        return chunk;
+    }
+
+    makeChunk(chunk, fromTick);
+    return chunk;
+}
+
+tick_t NotationPlayback::exportLastTick() const
+{
+    if (!score() || !score()->lastMeasure()) {
+        return 0;
+    }
+
+    return score()->lastMeasure()->endTick().ticks();
+}
+
 void NotationPlayback::makeInitData(MidiData& data, Ms::Score* score) const
 {
     data.division = Ms::MScore::division;
@@ -134,9 +261,7 @@ void NotationPlayback::makeInitData(MidiData& data, Ms::Score* score) const
     makeSynthMap(data.synthMap, score);
     makeTracks(data.tracks, score);
     makeTempoMap(data.tempoMap, score);
-
-    //! TODO Not implemented, left not to be forgotten
-    //fillMetronome(data.metronome, score, midiSpec);
+    makeMetronome(data.metronome, score);
 }
 
 int NotationPlayback::instrumentBank(const Ms::Instrument* instrument) const
@@ -217,6 +342,40 @@ void NotationPlayback::makeTempoMap(midi::TempoMap& tempos, const Ms::Score* sco
     }
 }
 
+void NotationPlayback::makeMetronome(midi::Metronome& metronome, const Ms::Score* score) const
+{
+    for (const Ms::RepeatSegment* rs : score->repeatList()) {
+        int endTick = rs->tick + rs->len();
+        int tickOffset = rs->utick - rs->tick;
+
+        for (const Ms::Measure* m = rs->firstMeasure(); m && m->tick().ticks() < endTick; m = m->nextMeasure()) {
+            int msrTick = m->tick().ticks();
+            qreal tempo = score->tempomap()->tempo(msrTick);
+            Ms::TimeSigFrac timeSig = score->sigmap()->timesig(msrTick).nominal();
+
+            int clickTicks = timeSig.isBeatedCompound(tempo) ? timeSig.beatTicks() : timeSig.dUnitTicks();
+            int msrEndTick = m->endTick().ticks();
+
+            //! NOTE The beats of an anacrusis are counted from the end of the measure
+            int rtick = 0;
+            if (m->isAnacrusis()) {
+                int rem = m->ticks().ticks() % clickTicks;
+                msrTick += rem;
+                rtick = rem + timeSig.ticksPerMeasure() - m->ticks().ticks();
+            }
+
+            for (int tick = msrTick; tick < msrEndTick; tick += clickTicks, rtick += clickTicks) {
+                Ms::NPlayEvent beat(timeSig.rtick2beatType(rtick));
+
+                midi::MetronomeClick click;
+                click.accent = beat.type() == Ms::ME_TICK1;
+                click.velocity = static_cast<uint8_t>(beat.velo());
+                metronome.insert({ tick + tickOffset, click });
+            }
+        }
+    }
+}
+
 void NotationPlayback::onChunkRequest(tick_t tick)
 {
     if (tick >= m_midiStream->lastTick) {
@@ -226,18 +385,87 @@ void NotationPlayback::onChunkRequest(tick_t tick)
 
     midi::Chunk chunk;
     makeChunk(chunk, tick);
+    markChunkSent(chunk);
     m_midiStream->stream.send(chunk);
 }
 
+void NotationPlayback::markChunkSent(const midi::Chunk& chunk) const
+{
+    if (chunk.endTick > chunk.beginTick) {
+        m_sentChunks[chunk.beginTick] = chunk.endTick;
+    }
+}
+
+bool NotationPlayback::isChunkSent(int tick1, int tick2) const
+{
+    auto it = m_sentChunks.upper_bound(tick1);
+    if (it != m_sentChunks.begin()) {
+        --it;
+    }
+    for (; it != m_sentChunks.end() && it->first < tick2; ++it) {
+        if (it->second > tick1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//! NOTE Re-render only the already sent chunks that contain edited measures,
+//! the others will be rendered on request anyway
+void NotationPlayback::updateDirtyChunks()
+{
+    if (!score() || !m_midiRenderer) {
+        return;
+    }
+
+    Ms::Fraction dirtyTick1, dirtyTick2;
+    if (!masterScore()->takePlaybackDirtyRange(dirtyTick1, dirtyTick2)) {
+        return;
+    }
+
+    m_midiRenderer->setScoreChanged();
+
+    if (m_sentChunks.empty() || !score()->lastMeasure()) {
+        return;
+    }
+
+    const Ms::Measure* firstMeasure = score()->tick2measure(dirtyTick1);
+    const Ms::Measure* lastMeasure = score()->tick2measure(dirtyTick2);
+    int tick1 = firstMeasure ? firstMeasure->tick().ticks() : dirtyTick1.ticks();
+    int tick2 = lastMeasure ? lastMeasure->endTick().ticks() : score()->lastMeasure()->endTick().ticks();
+    m_midiStream->lastTick = score()->lastMeasure()->endTick().ticks();
+
+    for (const Ms::MidiRenderer::Chunk& mschunk : m_midiRenderer->chunksInRange(tick1, tick2)) {
+        if (!isChunkSent(mschunk.tick1(), mschunk.tick2())) {
+            continue;
+        }
+
+        midi::Chunk chunk;
+        makeChunk(chunk, mschunk.utick1());
+
+        //! NOTE The partition may have changed, forget the old chunks this one covers
+        auto it = m_sentChunks.lower_bound(chunk.beginTick);
+        while (it != m_sentChunks.end() && it->first < chunk.endTick) {
+            it = m_sentChunks.erase(it);
+        }
+        markChunkSent(chunk);
+
+        m_midiStream->replace.send(chunk);
+    }
+}
+
 void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
 {
-    Ms::EventMap msevents;
+    TRACEFUNC;
+    mu::commandstats::PhaseTimer statsTimer(mu::commandstats::Phase::Playback);
 
     const Ms::MidiRenderer::Chunk mschunk = m_midiRenderer->chunkAt(fromTick);
     if (!mschunk) {
         return;
     }
 
+    Ms::EventMap msevents;
+
     chunk.beginTick = mschunk.tick1();
     chunk.endTick = mschunk.tick2();
 
@@ -245,10 +473,13 @@ void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
 
     Ms::SynthesizerState synState;// = mscore->synthesizerState();
     Ms::MidiRenderer::Context ctx(synState);
-    ctx.metronome = configuration()->isMetronomeEnabled();
+    //! NOTE The metronome is clicked by the audio engine from the init data
+    ctx.metronome = false;
     ctx.renderHarmony = true;
+    ctx.parallelStaves = true;
     m_midiRenderer->renderChunk(mschunk, &msevents, ctx);
 
+    chunk.events.reserve(msevents.size());
     for (const auto& evp : msevents) {
         tick_t tick = evp.first;
         const Ms::NPlayEvent ev = evp.second;
@@ -268,6 +499,7 @@ void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
         };
         chunk.events.insert({ tick, std::move(e) });
     }
+    chunk.events.sort();
 }
 
 QTime NotationPlayback::totalPlayTime() const
@@ -295,85 +527,103 @@ int NotationPlayback::secToTick(float sec) const
     return score() ? score()->utime2utick(sec) : 0;
 }
 
-//! NOTE Copied from ScoreView::moveCursor(const Fraction& tick)
-QRect NotationPlayback::playbackCursorRectByTick(int _tick) const
+//! NOTE Based on ScoreView::moveCursor(const Fraction& tick), the layout is looked up once after each change
+QRect NotationPlayback::playbackCursorRectByTick(int tick) const
 {
     if (!score()) {
         return QRect();
     }
 
-    Fraction tick = Fraction::fromTicks(_tick);
-
-    Measure* measure = score()->tick2measureMM(tick);
-    if (!measure) {
-        return QRect();
+    if (!m_isCursorMapValid) {
+        buildCursorMap();
     }
 
-    Ms::System* system = measure->system();
-    if (!system) {
+    auto it = std::upper_bound(m_cursorPoints.cbegin(), m_cursorPoints.cend(), tick, [](int tick, const CursorPoint& p) {
+        return tick < p.tick;
+    });
+
+    if (it == m_cursorPoints.cbegin() || it == m_cursorPoints.cend()) {
         return QRect();
     }
 
-    qreal x = 0.0;
-    Ms::Segment* s = nullptr;
-    for (s = measure->first(Ms::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2;
-        Fraction t2;
-        Ms::Segment* ns = s->next(Ms::SegmentType::ChordRest);
-        while (ns && !ns->visible()) {
-            ns = ns->next(Ms::SegmentType::ChordRest);
-        }
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            // measure->width is not good enough because of courtesy keysig, timesig
-            Ms::Segment* seg = measure->findSegment(Ms::SegmentType::EndBarLine, measure->tick() + measure->ticks());
-            if (seg) {
-                x2 = seg->canvasPos().x();
-            } else {
-                x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
-            }
-        }
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
-        }
-        s = ns;
-    }
+    const CursorPoint& p1 = *(it - 1);
+    const CursorPoint& p2 = *it;
 
-    if (!s) {
-        return QRect();
+    qreal x = p1.x;
+    if (p2.system == p1.system && p2.tick > p1.tick) {
+        x += (p2.x - p1.x) * (tick - p1.tick) / (p2.tick - p1.tick);
     }
 
-    double y = system->staffYpage(0) + system->page()->pos().y();
+    const CursorSystem& system = m_cursorSystems[p1.system];
     double _spatium = score()->spatium();
 
     qreal mag = _spatium / Ms::SPATIUM20;
     double w  = _spatium * 2.0 + score()->scoreFont()->width(Ms::SymId::noteheadBlack, mag);
-    double h  = 6 * _spatium;
-    //
-    // set cursor height for whole system
-    //
-    double y2 = 0.0;
 
-    for (int i = 0; i < score()->nstaves(); ++i) {
-        Ms::SysStaff* ss = system->staff(i);
-        if (!ss->show() || !score()->staff(i)->show()) {
+    return QRect(x - _spatium, system.y, w, system.height);
+}
+
+void NotationPlayback::buildCursorMap() const
+{
+    TRACEFUNC;
+
+    m_cursorPoints.clear();
+    m_cursorSystems.clear();
+    m_isCursorMapValid = true;
+
+    double _spatium = score()->spatium();
+    const Ms::System* lastSystem = nullptr;
+
+    for (Measure* measure = score()->firstMeasureMM(); measure; measure = measure->nextMeasureMM()) {
+        const Ms::System* system = measure->system();
+        if (!system) {
             continue;
         }
-        y2 = ss->bbox().bottom();
-    }
-    h += y2;
-    x -= _spatium;
-    y -= 3 * _spatium;
 
-    return QRect(x, y, w, h);
+        if (system != lastSystem) {
+            lastSystem = system;
+
+            double y = system->staffYpage(0) + system->page()->pos().y();
+            double h = 6 * _spatium;
+            //
+            // set cursor height for whole system
+            //
+            double y2 = 0.0;
+
+            for (int i = 0; i < score()->nstaves(); ++i) {
+                Ms::SysStaff* ss = system->staff(i);
+                if (!ss->show() || !score()->staff(i)->show()) {
+                    continue;
+                }
+                y2 = ss->bbox().bottom();
+            }
+
+            m_cursorSystems.push_back({ y - 3 * _spatium, h + y2 });
+        }
+
+        size_t systemIndex = m_cursorSystems.size() - 1;
+
+        Ms::Segment* first = measure->first(Ms::SegmentType::ChordRest);
+        for (Ms::Segment* s = first; s; s = s->next(Ms::SegmentType::ChordRest)) {
+            if (s == first || s->visible()) {
+                m_cursorPoints.push_back({ s->tick().ticks(), static_cast<qreal>(static_cast<int>(s->canvasPos().x())), systemIndex });
+            }
+        }
+
+        if (!first) {
+            continue;
+        }
+
+        // measure->width is not good enough because of courtesy keysig, timesig
+        qreal x = 0.0;
+        Ms::Segment* seg = measure->findSegment(Ms::SegmentType::EndBarLine, measure->tick() + measure->ticks());
+        if (seg) {
+            x = seg->canvasPos().x();
+        } else {
+            x = measure->canvasPos().x() + measure->width();             //safety, should not happen
+        }
+        m_cursorPoints.push_back({ measure->endTick().ticks(), x, systemIndex });
+    }
 }
 
 //! NOTE Copied from PositionCursor::move(const Fraction& t)
@@ -20,6 +20,10 @@
 #define MU_NOTATION_NOTATIONPLAYBACK_H
 
 #include <memory>
+#include <map>
+#include <vector>
+
+#include <QTimer>
 
 #include "../inotationplayback.h"
 #include "igetscore.h"
@@ -46,6 +50,10 @@ public:
 
     std::shared_ptr<midi::MidiStream> midiStream() const override;
 
+    midi::MidiData exportMidiData() const override;
+    midi::Chunk exportMidiChunk(midi::tick_t fromTick) const override;
+    midi::tick_t exportLastTick() const override;
+
     QTime totalPlayTime() const override;
 
     float tickToSec(int tick) const override;
@@ -76,11 +84,21 @@ private:
     void makeInitEvents(std::vector<midi::Event>& events, const Ms::Score* score) const;
     void makeTracks(std::vector<midi::Track>& tracks, const Ms::Score* score) const;
     void makeTempoMap(midi::TempoMap& tempos, const Ms::Score* score) const;
+    void makeMetronome(midi::Metronome& metronome, const Ms::Score* score) const;
     void makeSynthMap(midi::SynthMap& synthMap, const Ms::Score* score) const;
 
+    void schedulePrepareData();
+    void prepareData() const;
+    bool isDataPrepared() const;
+    bool isChunkPrepared(midi::tick_t tick) const;
+
     void onChunkRequest(midi::tick_t tick);
     void makeChunk(midi::Chunk& chunk, midi::tick_t fromTick) const;
 
+    void markChunkSent(const midi::Chunk& chunk) const;
+    bool isChunkSent(int tick1, int tick2) const;
+    void updateDirtyChunks();
+
     int instrumentBank(const Ms::Instrument* instrument) const;
 
     // play element
@@ -95,11 +113,34 @@ private:
 
     const Ms::TempoText* tempoText(int tick) const;
 
+    //! NOTE The x of the cursor at the visible chord-rest segments and the ends of the measures,
+    //! in the order of the ticks; between them the x is interpolated
+    struct CursorPoint {
+        int tick = 0;
+        qreal x = 0.0;
+        size_t system = 0;
+    };
+
+    struct CursorSystem {
+        qreal y = 0.0;
+        qreal height = 0.0;
+    };
+
+    void buildCursorMap() const;
+
     IGetScore* m_getScore = nullptr;
     std::shared_ptr<midi::MidiStream> m_midiStream;
     std::unique_ptr<Ms::MidiRenderer> m_midiRenderer;
+    mutable std::map<midi::tick_t /*begin*/, midi::tick_t /*end*/> m_sentChunks;
+    mutable midi::MidiData m_preparedData;
+    mutable bool m_isDataPrepared = false;
+    QTimer m_prepareTimer;
     async::Channel<int> m_playPositionTickChanged;
     ValCh<LoopBoundaries> m_loopBoundaries;
+
+    mutable std::vector<CursorPoint> m_cursorPoints;
+    mutable std::vector<CursorSystem> m_cursorSystems;
+    mutable bool m_isCursorMapValid = false;
 };
 }
 
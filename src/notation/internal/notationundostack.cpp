@@ -27,8 +27,8 @@
 using namespace mu::notation;
 using namespace mu::async;
 
-NotationUndoStack::NotationUndoStack(IGetScore* getScore, Notification notationChanged)
-    : m_getScore(getScore), m_notationChanged(notationChanged)
+NotationUndoStack::NotationUndoStack(IGetScore* getScore, CoalescedChannel<NotationChanges> notationChanges)
+    : m_getScore(getScore), m_notationChanges(notationChanges)
 {
 }
 
@@ -103,15 +103,29 @@ void NotationUndoStack::commitChanges()
         return;
     }
 
+    //! NOTE The command state tells what the command changed, it is reset by endCmd
+    const Ms::CmdState& cmdState = score()->cmdState();
+    NotationChanges changes;
+    if (!cmdState.updateAll() && !cmdState._instrumentsChanged && !cmdState._excerptsChanged) {
+        changes.startTick = cmdState.startTick();
+        changes.endTick = cmdState.endTick();
+        changes.startStaffIndex = cmdState.startStaff();
+        changes.endStaffIndex = cmdState.endStaff();
+        if (const Ms::Element* element = cmdState.element()) {
+            changes.elementTypes.insert(element->type());
+        }
+    }
+
     score()->endCmd();
     masterScore()->setSaved(isStackClean());
 
+    notifyAboutNotationChanged(changes);
     notifyAboutStackStateChanged();
 }
 
 mu::async::Notification NotationUndoStack::stackChanged() const
 {
-    return m_stackStateChanged;
+    return m_stackStateChanged.notification();
 }
 
 Ms::Score* NotationUndoStack::score() const
@@ -129,9 +143,9 @@ Ms::UndoStack* NotationUndoStack::undoStack() const
     return score() ? score()->undoStack() : nullptr;
 }
 
-void NotationUndoStack::notifyAboutNotationChanged()
+void NotationUndoStack::notifyAboutNotationChanged(const NotationChanges& changes)
 {
-    m_notationChanged.notify();
+    m_notationChanges.send(changes);
 }
 
 void NotationUndoStack::notifyAboutStackStateChanged()
@@ -22,6 +22,9 @@
 
 #include "inotationundostack.h"
 #include "igetscore.h"
+#include "async/coalescedchannel.h"
+#include "async/coalescednotification.h"
+#include "notationtypes.h"
 
 namespace Ms {
 class Score;
@@ -33,7 +36,7 @@ namespace mu::notation {
 class NotationUndoStack : public INotationUndoStack
 {
 public:
-    NotationUndoStack(IGetScore* getScore, async::Notification notationChanged);
+    NotationUndoStack(IGetScore* getScore, async::CoalescedChannel<NotationChanges> notationChanges);
 
     bool canUndo() const override;
     void undo() override;
@@ -48,7 +51,7 @@ public:
     async::Notification stackChanged() const override;
 
 private:
-    void notifyAboutNotationChanged();
+    void notifyAboutNotationChanged(const NotationChanges& changes = NotationChanges());
     void notifyAboutStackStateChanged();
 
     bool isStackClean() const;
@@ -59,8 +62,8 @@ private:
 
     IGetScore* m_getScore = nullptr;
 
-    async::Notification m_notationChanged;
-    async::Notification m_stackStateChanged;
+    async::CoalescedChannel<NotationChanges> m_notationChanges;
+    async::CoalescedNotification m_stackStateChanged;      // the undo/redo buttons are updated once for the notes typed in a row
 };
 }
 
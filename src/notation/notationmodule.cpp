@@ -50,6 +50,9 @@
 #include "view/internal/undoredomodel.h"
 #include "view/notationtoolbarmodel.h"
 #include "view/notationnavigator.h"
+#include "devtools/notationlayoutdevtools.h"
+#include "devtools/commandstatsdevtools.h"
+#include "devtools/memoryreportdevtools.h"
 
 #include "ui/iinteractiveuriregister.h"
 #include "ui/uitypes.h"
@@ -165,6 +168,9 @@ void NotationModule::registerUiTypes()
     qmlRegisterType<NotationToolBarModel>("MuseScore.NotationScene", 1, 0, "NotationToolBarModel");
     qmlRegisterType<NotationNavigator>("MuseScore.NotationScene", 1, 0, "NotationNavigator");
     qmlRegisterType<UndoRedoModel>("MuseScore.NotationScene", 1, 0, "UndoRedoModel");
+    qmlRegisterType<NotationLayoutDevTools>("MuseScore.NotationScene", 1, 0, "NotationLayoutDevTools");
+    qmlRegisterType<CommandStatsDevTools>("MuseScore.NotationScene", 1, 0, "CommandStatsDevTools");
+    qmlRegisterType<MemoryReportDevTools>("MuseScore.NotationScene", 1, 0, "MemoryReportDevTools");
 
     qRegisterMetaType<EditStyle>("EditStyle");
     qRegisterMetaType<EditStaff>("EditStaff");
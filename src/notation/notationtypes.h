@@ -19,6 +19,9 @@
 #ifndef MU_NOTATION_NOTATIONTYPES_H
 #define MU_NOTATION_NOTATIONTYPES_H
 
+#include <algorithm>
+#include <set>
+
 #include <QPixmap>
 #include <QDate>
 
@@ -157,7 +160,8 @@ enum class SaveMode
     Unknown,
     SaveAs,
     SaveCopy,
-    SaveSelection
+    SaveSelection,
+    AutoSave
 };
 
 enum class ResettableValueType
@@ -406,6 +410,50 @@ inline QList<StaffType> allStaffTypes()
     return result;
 }
 
+//! NOTE What the changes of a notation might have touched, the whole score by default.
+//! An empty list of element types means any type
+struct NotationChanges
+{
+    Fraction startTick = Fraction(-1, 1);
+    Fraction endTick = Fraction(-1, 1);
+    int startStaffIndex = -1;
+    int endStaffIndex = -1;
+    std::set<ElementType> elementTypes;
+
+    bool isWholeScore() const
+    {
+        return startTick < Fraction(0, 1);
+    }
+
+    bool isAllStaves() const
+    {
+        return startStaffIndex < 0;
+    }
+
+    void unite(const NotationChanges& other)
+    {
+        if (isWholeScore() || other.isWholeScore()) {
+            startTick = endTick = Fraction(-1, 1);
+        } else {
+            startTick = std::min(startTick, other.startTick);
+            endTick = std::max(endTick, other.endTick);
+        }
+
+        if (isAllStaves() || other.isAllStaves()) {
+            startStaffIndex = endStaffIndex = -1;
+        } else {
+            startStaffIndex = std::min(startStaffIndex, other.startStaffIndex);
+            endStaffIndex = std::max(endStaffIndex, other.endStaffIndex);
+        }
+
+        if (elementTypes.empty() || other.elementTypes.empty()) {
+            elementTypes.clear();
+        } else {
+            elementTypes.insert(other.elementTypes.begin(), other.elementTypes.end());
+        }
+    }
+};
+
 struct MeasureBeat
 {
     int measureIndex = 0;
@@ -0,0 +1,42 @@
+import QtQuick 2.7
+import MuseScore.NotationScene 1.0
+import MuseScore.UiComponents 1.0
+
+Rectangle {
+
+    color: ui.theme.backgroundPrimaryColor
+
+    CommandStatsDevTools {
+        id: devtools
+    }
+
+    FlatButton {
+        id: clearButton
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 20
+
+        text: "Clear"
+        onClicked: devtools.clear()
+    }
+
+    Flickable {
+        anchors.top: clearButton.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        anchors.margins: 20
+
+        clip: true
+        contentHeight: statsText.implicitHeight
+
+        Text {
+            id: statsText
+            width: parent.width
+
+            color: ui.theme.fontPrimaryColor
+            font.family: "monospace"
+            text: devtools.commandStats
+        }
+    }
+}
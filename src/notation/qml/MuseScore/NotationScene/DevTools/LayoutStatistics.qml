@@ -0,0 +1,19 @@
+import QtQuick 2.7
+import MuseScore.NotationScene 1.0
+
+Rectangle {
+
+    color: ui.theme.backgroundPrimaryColor
+
+    NotationLayoutDevTools {
+        id: devtools
+    }
+
+    Text {
+        anchors.fill: parent
+        anchors.margins: 20
+
+        color: ui.theme.fontPrimaryColor
+        text: devtools.layoutStats
+    }
+}
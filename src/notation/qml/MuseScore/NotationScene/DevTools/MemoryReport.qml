@@ -0,0 +1,42 @@
+import QtQuick 2.7
+import MuseScore.NotationScene 1.0
+import MuseScore.UiComponents 1.0
+
+Rectangle {
+
+    color: ui.theme.backgroundPrimaryColor
+
+    MemoryReportDevTools {
+        id: devtools
+    }
+
+    FlatButton {
+        id: updateButton
+        anchors.top: parent.top
+        anchors.left: parent.left
+        anchors.margins: 20
+
+        text: "Update"
+        onClicked: devtools.update()
+    }
+
+    Flickable {
+        anchors.top: updateButton.bottom
+        anchors.left: parent.left
+        anchors.right: parent.right
+        anchors.bottom: parent.bottom
+        anchors.margins: 20
+
+        clip: true
+        contentHeight: reportText.implicitHeight
+
+        Text {
+            id: reportText
+            width: parent.width
+
+            color: ui.theme.fontPrimaryColor
+            font.family: "monospace"
+            text: devtools.memoryReport
+        }
+    }
+}
@@ -28,6 +28,7 @@ class MsczReaderMock : public IMsczMetaReader
 {
 public:
     MOCK_METHOD(MetaList, readMetaList, (const io::paths&), (const, override));
+    MOCK_METHOD(MetaList, readIndexedMetaList, (const io::paths&), (const, override));
 };
 }
 
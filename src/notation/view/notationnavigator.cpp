@@ -232,6 +232,13 @@ void NotationNavigator::paint(QPainter* painter)
     paintPageNumbers(painter);
 }
 
+bool NotationNavigator::isLivePaintingNeeded() const
+{
+    //! NOTE At the scale of the miniature a tile covers a large part of a page, only the tiles
+    //! of the changed area are rendered again, even while an element is dragged or edited
+    return false;
+}
+
 void NotationNavigator::paintCursor(QPainter* painter)
 {
     QColor color(configuration()->selectionColor());
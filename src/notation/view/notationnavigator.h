@@ -63,6 +63,7 @@ private:
     void rescale();
 
     void paint(QPainter* painter) override;
+    bool isLivePaintingNeeded() const override;
 
     void wheelEvent(QWheelEvent* event) override;
     void mousePressEvent(QMouseEvent* event) override;
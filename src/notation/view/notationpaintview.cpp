@@ -19,9 +19,12 @@
 #include "notationpaintview.h"
 
 #include <QPainter>
+#include <QQuickWindow>
 #include "libmscore/draw/qpainterprovider.h"
+#include "libmscore/score.h"
 
 #include "log.h"
+#include "commandstats.h"
 #include "actions/actiontypes.h"
 
 using namespace mu::notation;
@@ -40,6 +43,14 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
     setAcceptedMouseButtons(Qt::AllButtons);
     setAntialiasing(true);
 
+    //! NOTE The view paints with the OpenGL paint engine into a framebuffer object
+    //! instead of rasterizing into an image that is uploaded on each frame:
+    //! the tiles of the tile cache stay in the texture cache of the engine
+    //! while they are not changed, so a scroll only composites textures on the GPU.
+    //! The software scene graph backend ignores the render target.
+    setRenderTarget(QQuickPaintedItem::FramebufferObject);
+    setPerformanceHint(QQuickPaintedItem::FastFBOResizing);
+
     connect(this, &QQuickPaintedItem::widthChanged, this, &NotationPaintView::onViewSizeChanged);
     connect(this, &QQuickPaintedItem::heightChanged, this, &NotationPaintView::onViewSizeChanged);
 
@@ -58,6 +69,14 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
 
     m_loopInMarker = std::make_unique<LoopMarker>(LoopBoundaryType::LoopIn);
     m_loopOutMarker = std::make_unique<LoopMarker>(LoopBoundaryType::LoopOut);
+
+    m_tileCache = std::make_unique<NotationTileCache>([this](QPainter* qp, const QRectF& rect) {
+        if (!notation()) {
+            return;
+        }
+        mu::draw::Painter painter(mu::draw::QPainterProvider::make(qp));
+        notation()->paintScore(&painter, rect);
+    });
 }
 
 void NotationPaintView::load()
@@ -88,6 +107,12 @@ void NotationPaintView::initBackground()
 
     configuration()->backgroundColorChanged().onReceive(this, [this](const QColor& color) {
         setBackgroundColor(color);
+        m_tileCache->invalidateAll();
+        update();
+    });
+
+    configuration()->foregroundColorChanged().onReceive(this, [this](const QColor&) {
+        m_tileCache->invalidateAll();
         update();
     });
 }
@@ -168,6 +193,7 @@ void NotationPaintView::onCurrentNotationChanged()
     }
 
     m_notation = globalContext()->currentNotation();
+    resetTileCache();
     if (!m_notation) {
         return;
     }
@@ -284,14 +310,18 @@ void NotationPaintView::onNoteInputChanged()
 
 void NotationPaintView::onSelectionChanged()
 {
+    //! NOTE The selected elements are painted in the selection color, so their tiles are redrawn
+    QRectF selectionRect = notationSelection()->isNone() ? QRectF() : notationSelection()->canvasBoundingRect();
+    m_tileCache->invalidate(m_lastSelectionRect.united(selectionRect));
+    m_lastSelectionRect = selectionRect;
+
     if (notationSelection()->isNone()) {
+        update();
         return;
     }
 
     TRACEFUNC;
 
-    QRectF selectionRect = notationSelection()->canvasBoundingRect();
-
     adjustCanvasPosition(selectionRect);
     update();
 }
@@ -324,15 +354,24 @@ void NotationPaintView::paint(QPainter* qp)
         return;
     }
 
+    mu::commandstats::PhaseTimer statsTimer(mu::commandstats::Phase::Paint);
+
     mu::draw::Painter mup(mu::draw::QPainterProvider::make(qp));
     mu::draw::Painter* painter = &mup;
 
     QRect rect(0, 0, width(), height());
     painter->fillRect(rect, m_backgroundColor);
 
-    painter->setTransform(m_matrix);
-
-    notation()->paint(painter, toLogical(rect));
+    if (isLivePaintingNeeded()) {
+        m_tileCache->cancelPrefetch();
+        painter->setTransform(m_matrix);
+        notation()->paint(painter, toLogical(rect));
+    } else {
+        updateTileCache();
+        m_tileCache->paint(qp, m_matrix, rect);
+        painter->setTransform(m_matrix);
+        notation()->paintInteraction(painter);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -340,6 +379,44 @@ void NotationPaintView::paint(QPainter* qp)
     m_loopOutMarker->paint(painter);
 }
 
+bool NotationPaintView::isLivePaintingNeeded() const
+{
+    //! NOTE The score changes on every move while an element is dragged or edited,
+    //! the tiles would only be rendered to be thrown away
+    INotationInteractionPtr interaction = notationInteraction();
+    if (!interaction) {
+        return true;
+    }
+
+    return m_isDropping || interaction->isDragStarted() || interaction->isTextEditingStarted()
+           || interaction->isGripEditStarted();
+}
+
+void NotationPaintView::resetTileCache()
+{
+    m_tileCache->invalidateAll();
+    m_lastSelectionRect = QRectF();
+
+    Ms::Score* score = notationElements() ? notationElements()->msScore() : nullptr;
+    m_changeRevision = score ? score->changeRevision() : 0;
+}
+
+void NotationPaintView::updateTileCache()
+{
+    Ms::Score* score = notationElements() ? notationElements()->msScore() : nullptr;
+    if (!score) {
+        return;
+    }
+
+    QRectF area;
+    if (score->changedAreaSince(m_changeRevision, &area)) {
+        m_tileCache->invalidate(area);
+    } else {
+        m_tileCache->invalidateAll();
+    }
+    m_changeRevision = score->changeRevision();
+}
+
 QColor NotationPaintView::backgroundColor() const
 {
     return m_backgroundColor;
@@ -598,6 +675,8 @@ void NotationPaintView::keyReleaseEvent(QKeyEvent* event)
 
 void NotationPaintView::dragEnterEvent(QDragEnterEvent* event)
 {
+    m_isDropping = true;
+
     if (isInited()) {
         m_inputController->dragEnterEvent(event);
     }
@@ -605,6 +684,8 @@ void NotationPaintView::dragEnterEvent(QDragEnterEvent* event)
 
 void NotationPaintView::dragLeaveEvent(QDragLeaveEvent* event)
 {
+    m_isDropping = false;
+
     if (isInited()) {
         m_inputController->dragLeaveEvent(event);
     }
@@ -619,6 +700,8 @@ void NotationPaintView::dragMoveEvent(QDragMoveEvent* event)
 
 void NotationPaintView::dropEvent(QDropEvent* event)
 {
+    m_isDropping = false;
+
     if (isInited()) {
         m_inputController->dropEvent(event);
     }
@@ -629,6 +712,7 @@ void NotationPaintView::setNotation(INotationPtr notation)
     clear();
     initBackground();
     m_notation = notation;
+    resetTileCache();
     update();
 }
 
@@ -767,6 +851,14 @@ void NotationPaintView::onPlayingChanged()
     bool isPlaying = playbackController()->isPlaying();
     m_playbackCursor->setVisible(isPlaying);
 
+    QObject::disconnect(m_frameSwappedConnection);
+
+    //! NOTE The smooth cursor follows the play position published by the audio thread at each frame
+    if (isPlaying && playbackConfiguration()->cursorType() == playback::PlaybackCursorType::SMOOTH && window()) {
+        m_frameSwappedConnection = connect(window(), &QQuickWindow::frameSwapped, this, &NotationPaintView::onFrameSwapped,
+                                           Qt::QueuedConnection);
+    }
+
     if (isPlaying) {
         float playPosSec = playbackController()->playbackPositionInSeconds();
         uint32_t tick = notationPlayback()->secToTick(playPosSec);
@@ -784,6 +876,8 @@ void NotationPaintView::movePlaybackCursor(uint32_t tick)
 
     TRACEFUNC;
 
+    m_lastCursorTick = tick;
+
     QRect cursorRect = notationPlayback()->playbackCursorRectByTick(tick);
     m_playbackCursor->move(cursorRect);
 
@@ -794,6 +888,22 @@ void NotationPaintView::movePlaybackCursor(uint32_t tick)
     update(); //! TODO set rect to optimization
 }
 
+void NotationPaintView::onFrameSwapped()
+{
+    if (!notationPlayback() || !playbackController()->isPlaying()) {
+        return;
+    }
+
+    float playPosSec = playbackController()->playbackPositionInSeconds();
+    uint32_t tick = notationPlayback()->secToTick(playPosSec);
+
+    if (tick != m_lastCursorTick) {
+        movePlaybackCursor(tick);
+    } else {
+        window()->update();
+    }
+}
+
 const Page* NotationPaintView::pointToPage(const QPointF& point) const
 {
     if (!notationElements()) {
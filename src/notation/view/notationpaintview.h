@@ -31,11 +31,13 @@
 #include "context/iglobalcontext.h"
 #include "async/asyncable.h"
 #include "playback/iplaybackcontroller.h"
+#include "playback/iplaybackconfiguration.h"
 
 #include "notationviewinputcontroller.h"
 #include "noteinputcursor.h"
 #include "playbackcursor.h"
 #include "loopmarker.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class NotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -46,6 +48,7 @@ class NotationPaintView : public QQuickPaintedItem, public IControlledView, publ
     INJECT(notation, actions::IActionsDispatcher, dispatcher)
     INJECT(notation, context::IGlobalContext, globalContext)
     INJECT(notation, playback::IPlaybackController, playbackController)
+    INJECT(notation, playback::IPlaybackConfiguration, playbackConfiguration)
     INJECT(notation, INotationContextMenu, notationContextMenu)
 
     Q_PROPERTY(qreal startHorizontalScrollPosition READ startHorizontalScrollPosition NOTIFY horizontalScrollChanged)
@@ -119,6 +122,7 @@ protected:
 
     // Draw
     void paint(QPainter* painter) override;
+    virtual bool isLivePaintingNeeded() const;
 
 protected slots:
     virtual void onViewSizeChanged();
@@ -164,8 +168,12 @@ private:
     void onNoteInputChanged();
     void onSelectionChanged();
 
+    void resetTileCache();
+    void updateTileCache();
+
     void onPlayingChanged();
     void movePlaybackCursor(uint32_t tick);
+    void onFrameSwapped();
 
     void updateLoopMarkers(const LoopBoundaries& boundaries);
 
@@ -180,6 +188,12 @@ private:
     std::unique_ptr<NoteInputCursor> m_noteInputCursor;
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
+    std::unique_ptr<NotationTileCache> m_tileCache;
+    int m_changeRevision = 0;
+    QRectF m_lastSelectionRect;
+    bool m_isDropping = false;
+    QMetaObject::Connection m_frameSwappedConnection;
+    uint32_t m_lastCursorTick = 0;
 
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
@@ -22,7 +22,7 @@
 using namespace mu::notation;
 
 NotationSwitchListModel::NotationSwitchListModel(QObject* parent)
-    : QAbstractListModel(parent)
+    : IncrementalListModel(parent)
 {
 }
 
@@ -57,27 +57,25 @@ void NotationSwitchListModel::load()
 
 void NotationSwitchListModel::loadNotations()
 {
-    beginResetModel();
-    m_notations.clear();
+    QList<INotationPtr> notations;
 
     IMasterNotationPtr masterNotation = this->masterNotation();
-    if (!masterNotation) {
-        endResetModel();
-        return;
-    }
+    if (masterNotation) {
+        notations << masterNotation->notation();
+        listenNotationOpeningStatus(masterNotation->notation());
 
-    m_notations << masterNotation->notation();
-    listenNotationOpeningStatus(masterNotation->notation());
+        for (IExcerptNotationPtr excerpt: masterNotation->excerpts().val) {
+            if (excerpt->notation()->opened().val) {
+                notations << excerpt->notation();
+            }
 
-    for (IExcerptNotationPtr excerpt: masterNotation->excerpts().val) {
-        if (excerpt->notation()->opened().val) {
-            m_notations << excerpt->notation();
+            listenNotationOpeningStatus(excerpt->notation());
         }
-
-        listenNotationOpeningStatus(excerpt->notation());
     }
 
-    endResetModel();
+    updateItems(m_notations, notations, [](const INotationPtr& notation) {
+        return notation.get();
+    });
 }
 
 void NotationSwitchListModel::listenNotationOpeningStatus(INotationPtr notation)
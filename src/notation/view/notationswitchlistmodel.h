@@ -20,14 +20,13 @@
 #ifndef MU_NOTATION_NOTATIONSWITCHLISTMODEL_H
 #define MU_NOTATION_NOTATIONSWITCHLISTMODEL_H
 
-#include <QAbstractListModel>
-
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 #include "context/iglobalcontext.h"
+#include "uicomponents/view/incrementallistmodel.h"
 
 namespace mu::notation {
-class NotationSwitchListModel : public QAbstractListModel, public async::Asyncable
+class NotationSwitchListModel : public uicomponents::IncrementalListModel, public async::Asyncable
 {
     Q_OBJECT
 
@@ -0,0 +1,190 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "notationtilecache.h"
+
+#include <cmath>
+
+#include <QPainter>
+
+using namespace mu::notation;
+
+static constexpr size_t TILE_BYTES = size_t(NotationTileCache::TILE_SIZE) * NotationTileCache::TILE_SIZE * 4;
+static constexpr int PREFETCH_INTERVAL_MS = 20;
+static constexpr int PREFETCH_TILES_PER_TICK = 4;
+
+NotationTileCache::NotationTileCache(RenderFunction render, QObject* parent)
+    : QObject(parent), m_render(std::move(render))
+{
+    m_prefetchTimer.setSingleShot(true);
+    m_prefetchTimer.setInterval(PREFETCH_INTERVAL_MS);
+    connect(&m_prefetchTimer, &QTimer::timeout, this, &NotationTileCache::prefetch);
+}
+
+void NotationTileCache::paint(QPainter* painter, const QTransform& matrix, const QRect& viewRect)
+{
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QPointF deviceOrigin(matrix.dx() * dpr, matrix.dy() * dpr);
+
+    setEpoch(matrix.m11(), dpr, deviceOrigin);
+
+    //! NOTE The tiles are drawn at whole device pixels, at most half a pixel off the exact matrix
+    const QPoint offset = (deviceOrigin - m_phase).toPoint();
+    const QRectF deviceRect(viewRect.x() * dpr, viewRect.y() * dpr, viewRect.width() * dpr, viewRect.height() * dpr);
+    const TileRange range = tileRange(deviceRect.translated(-offset));
+
+    painter->save();
+    painter->resetTransform();
+    for (int r = range.y1; r <= range.y2; ++r) {
+        for (int c = range.x1; c <= range.x2; ++c) {
+            const QPointF pos((offset.x() + c * TILE_SIZE) / dpr, (offset.y() + r * TILE_SIZE) / dpr);
+            painter->drawImage(pos, tile({ c, r }));
+        }
+    }
+    painter->restore();
+
+    const TileRange prefetchRange = { range.x1 - 1, range.y1 - 1, range.x2 + 1, range.y2 + 1 };
+    const size_t prefetchTiles = size_t(prefetchRange.x2 - prefetchRange.x1 + 1) * (prefetchRange.y2 - prefetchRange.y1 + 1);
+    if (prefetchTiles * TILE_BYTES <= m_capacity) {
+        m_prefetchRange = prefetchRange;
+        m_prefetchTimer.start();
+    }
+}
+
+void NotationTileCache::invalidate(const QRectF& rect)
+{
+    if (m_tiles.empty() || rect.isEmpty()) {
+        return;
+    }
+
+    const qreal scale = m_scale * m_dpr;
+    const QRectF deviceRect(rect.x() * scale + m_phase.x(), rect.y() * scale + m_phase.y(),
+                            rect.width() * scale, rect.height() * scale);
+    const TileRange range = tileRange(deviceRect.adjusted(-2, -2, 2, 2));   // antialiasing
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        const Key& key = it->first;
+        if (key.first >= range.x1 && key.first <= range.x2 && key.second >= range.y1 && key.second <= range.y2) {
+            m_lru.erase(it->second.lru);
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::invalidateAll()
+{
+    m_tiles.clear();
+    m_lru.clear();
+    cancelPrefetch();
+}
+
+void NotationTileCache::cancelPrefetch()
+{
+    m_prefetchTimer.stop();
+    m_prefetchRange = TileRange();
+}
+
+void NotationTileCache::setEpoch(qreal scale, qreal dpr, const QPointF& deviceOrigin)
+{
+    //! NOTE Scrolling keeps the tiles, they are only drawn at another offset
+    if (qFuzzyCompare(scale, m_scale) && qFuzzyCompare(dpr, m_dpr)) {
+        return;
+    }
+
+    invalidateAll();
+    m_scale = scale;
+    m_dpr = dpr;
+    m_phase = QPointF(deviceOrigin.x() - std::floor(deviceOrigin.x()), deviceOrigin.y() - std::floor(deviceOrigin.y()));
+}
+
+NotationTileCache::TileRange NotationTileCache::tileRange(const QRectF& deviceRect) const
+{
+    TileRange range;
+    range.x1 = int(std::floor(deviceRect.left() / TILE_SIZE));
+    range.y1 = int(std::floor(deviceRect.top() / TILE_SIZE));
+    range.x2 = int(std::ceil(deviceRect.right() / TILE_SIZE)) - 1;
+    range.y2 = int(std::ceil(deviceRect.bottom() / TILE_SIZE)) - 1;
+    return range;
+}
+
+const QImage& NotationTileCache::tile(const Key& key)
+{
+    auto it = m_tiles.find(key);
+    if (it != m_tiles.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+        return it->second.image;
+    }
+
+    m_lru.push_front(key);
+    Tile& tile = m_tiles[key];
+    tile.lru = m_lru.begin();
+    render(key, tile.image);
+
+    shrink();
+    return tile.image;
+}
+
+void NotationTileCache::render(const Key& key, QImage& image) const
+{
+    image = QImage(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    const qreal scale = m_scale * m_dpr;
+    const qreal x = key.first * TILE_SIZE - m_phase.x();
+    const qreal y = key.second * TILE_SIZE - m_phase.y();
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::TextAntialiasing, true);
+    painter.translate(-x, -y);
+    painter.scale(scale, scale);
+
+    m_render(&painter, QRectF(x / scale, y / scale, TILE_SIZE / scale, TILE_SIZE / scale));
+    painter.end();
+
+    //! NOTE Set after painting, so that the tile is drawn 1:1 into the device pixels
+    image.setDevicePixelRatio(m_dpr);
+}
+
+void NotationTileCache::shrink()
+{
+    while (!m_lru.empty() && m_tiles.size() * TILE_BYTES > m_capacity) {
+        m_tiles.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+}
+
+void NotationTileCache::prefetch()
+{
+    int rendered = 0;
+    for (int r = m_prefetchRange.y1; r <= m_prefetchRange.y2; ++r) {
+        for (int c = m_prefetchRange.x1; c <= m_prefetchRange.x2; ++c) {
+            if (m_tiles.find({ c, r }) != m_tiles.end()) {
+                continue;
+            }
+            if (rendered == PREFETCH_TILES_PER_TICK) {
+                m_prefetchTimer.start();
+                return;
+            }
+            tile({ c, r });
+            ++rendered;
+        }
+    }
+}
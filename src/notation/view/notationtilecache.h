@@ -0,0 +1,92 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2021 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+#include <list>
+#include <map>
+
+#include <QImage>
+#include <QObject>
+#include <QPointF>
+#include <QRect>
+#include <QTimer>
+#include <QTransform>
+
+class QPainter;
+
+namespace mu::notation {
+//! NOTE Keeps the rendered score in device pixel tiles, so that scrolling
+//! and repainting only draw the tiles that became visible or were changed.
+//! The tiles belong to one scale and device pixel ratio, a zoom drops them all.
+//! Tiles around the visible ones are rendered ahead when the view is idle.
+class NotationTileCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int TILE_SIZE = 256;       // device pixels
+    static constexpr size_t DEFAULT_CAPACITY = size_t(128) * 1024 * 1024;
+
+    //! Paints the score into the given rectangle, in score coordinates
+    using RenderFunction = std::function<void (QPainter* painter, const QRectF& rect)>;
+
+    explicit NotationTileCache(RenderFunction render, QObject* parent = nullptr);
+
+    void paint(QPainter* painter, const QTransform& matrix, const QRect& viewRect);
+
+    void invalidate(const QRectF& rect);
+    void invalidateAll();
+    void cancelPrefetch();
+
+private:
+    using Key = std::pair<int, int>;     // column, row
+    struct Tile {
+        QImage image;
+        std::list<Key>::iterator lru;
+    };
+    struct TileRange {
+        int x1 = 0, y1 = 0, x2 = -1, y2 = -1;
+        bool isEmpty() const { return x2 < x1 || y2 < y1; }
+    };
+
+    void setEpoch(qreal scale, qreal dpr, const QPointF& deviceOrigin);
+    TileRange tileRange(const QRectF& deviceRect) const;
+    const QImage& tile(const Key& key);
+    void render(const Key& key, QImage& image) const;
+    void shrink();
+    void prefetch();
+
+    RenderFunction m_render;
+
+    qreal m_scale = 0;
+    qreal m_dpr = 0;
+    QPointF m_phase;            // the fraction of a device pixel the tiles were rendered at
+
+    std::list<Key> m_lru;       // most recently used first
+    std::map<Key, Tile> m_tiles;
+    size_t m_capacity = DEFAULT_CAPACITY;
+
+    TileRange m_prefetchRange;
+    QTimer m_prefetchTimer;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -28,6 +28,7 @@
 #include "framework/global/widgetstatestore.h"
 #include "libmscore/figuredbass.h"
 #include "libmscore/layout.h"
+#include "libmscore/mscore.h"
 #include "libmscore/sym.h"
 #include "log.h"
 #include "offsetSelect.h"
@@ -58,6 +59,8 @@ EditStyle::EditStyle(QWidget* parent)
     : QDialog(parent)
 {
     setObjectName("EditStyle");
+    // so that the font lists also show the score fonts not used yet
+    Ms::MScore::loadAllFontFamilies();
     setupUi(this);
     setWindowFlags(this->windowFlags() & ~Qt::WindowContextHelpButtonHint);
     setModal(true);
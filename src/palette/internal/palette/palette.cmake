@@ -6,6 +6,8 @@ set(PALETTE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/palettemodel.h
     ${CMAKE_CURRENT_LIST_DIR}/palettetree.cpp
     ${CMAKE_CURRENT_LIST_DIR}/palettetree.h
+    ${CMAKE_CURRENT_LIST_DIR}/palettecelliconcache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/palettecelliconcache.h
     ${CMAKE_CURRENT_LIST_DIR}/paletteworkspace.cpp
     ${CMAKE_CURRENT_LIST_DIR}/paletteworkspace.h
     ${CMAKE_CURRENT_LIST_DIR}/palette.h
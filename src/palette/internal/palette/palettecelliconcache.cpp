@@ -0,0 +1,179 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "palettecelliconcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include "libmscore/element.h"
+#include "version.h"
+#include "log.h"
+
+namespace Ms {
+static const quint32 ICON_CACHE_MAGIC = 0x4d535049; // MSPI
+static const int ICON_CACHE_MAX_COST = 64 * 1024 * 1024; // bytes of the images
+
+//---------------------------------------------------------
+//   PaletteCellIconCache
+//---------------------------------------------------------
+
+PaletteCellIconCache::PaletteCellIconCache()
+{
+    _icons.setMaxCost(ICON_CACHE_MAX_COST);
+}
+
+PaletteCellIconCache* PaletteCellIconCache::instance()
+{
+    static PaletteCellIconCache cache;
+    return &cache;
+}
+
+//---------------------------------------------------------
+//   setPath
+//---------------------------------------------------------
+
+void PaletteCellIconCache::setPath(const mu::io::path& path)
+{
+    _path = path;
+    _loaded = false;
+}
+
+//---------------------------------------------------------
+//   load
+//    the icons are written by the version of the app, an
+//    update may draw the elements differently
+//---------------------------------------------------------
+
+void PaletteCellIconCache::load()
+{
+    _loaded = true;
+    if (_path.empty()) {
+        return;
+    }
+
+    QFile file(_path.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    QString version;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != ICON_CACHE_MAGIC || version != QString::fromStdString(mu::framework::Version::fullVersion())) {
+        return;
+    }
+
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QByteArray key;
+        QImage image;
+        in >> key >> image;
+        if (in.status() == QDataStream::Ok && !image.isNull() && !_icons.contains(key)) {
+            _icons.insert(key, new QImage(image), int(image.sizeInBytes()));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   save
+//---------------------------------------------------------
+
+void PaletteCellIconCache::save()
+{
+    if (_path.empty() || !_modified) {
+        return;
+    }
+
+    QSaveFile file(_path.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed to write the palette icons: " << _path;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+
+    const QList<QByteArray> keys = _icons.keys();
+    out << ICON_CACHE_MAGIC << QString::fromStdString(mu::framework::Version::fullVersion()) << qint32(keys.size());
+    for (const QByteArray& key : keys) {
+        out << key << *_icons.object(key);
+    }
+
+    if (file.commit()) {
+        _modified = false;
+    }
+}
+
+//---------------------------------------------------------
+//   elementHash
+//    of the element as it is written, kept until the
+//    element is deleted
+//---------------------------------------------------------
+
+QByteArray PaletteCellIconCache::elementHash(const std::shared_ptr<const Element>& element)
+{
+    if (!element) {
+        return QByteArray();
+    }
+
+    auto it = _elementHashes.find(element.get());
+    if (it != _elementHashes.end() && it->second.first.lock() == element) {
+        return it->second.second;
+    }
+
+    QByteArray hash = QCryptographicHash::hash(element->mimeData(QPointF()), QCryptographicHash::Sha1);
+    _elementHashes[element.get()] = { element, hash };
+
+    if (_elementHashes.size() > _elementHashesCleanSize) {
+        for (auto i = _elementHashes.begin(); i != _elementHashes.end();) {
+            i = i->second.first.expired() ? _elementHashes.erase(i) : std::next(i);
+        }
+        _elementHashesCleanSize = std::max(size_t(64), _elementHashes.size() * 2);
+    }
+
+    return hash;
+}
+
+//---------------------------------------------------------
+//   icon
+//---------------------------------------------------------
+
+const QImage* PaletteCellIconCache::icon(const QByteArray& key)
+{
+    if (!_loaded) {
+        load();
+    }
+    return _icons.object(key);
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void PaletteCellIconCache::insert(const QByteArray& key, const QImage& icon)
+{
+    _icons.insert(key, new QImage(icon), int(icon.sizeInBytes()));
+    _modified = true;
+}
+} // namespace Ms
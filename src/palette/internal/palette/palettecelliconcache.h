@@ -0,0 +1,68 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef __PALETTECELLICONCACHE_H__
+#define __PALETTECELLICONCACHE_H__
+
+#include <map>
+#include <memory>
+
+#include <QByteArray>
+#include <QCache>
+#include <QImage>
+
+#include "io/path.h"
+
+namespace Ms {
+class Element;
+
+//---------------------------------------------------------
+//   PaletteCellIconCache
+//    the rendered icons of the palette cells, keyed by the
+//    hash of the element and everything else the icon
+//    depends on: the size, the device pixel ratio and the
+//    colors of the theme. Kept on disk between sessions.
+//---------------------------------------------------------
+
+class PaletteCellIconCache
+{
+    QCache<QByteArray, QImage> _icons;
+    std::map<const Element*, std::pair<std::weak_ptr<const Element>, QByteArray> > _elementHashes;
+    size_t _elementHashesCleanSize { 64 };
+
+    mu::io::path _path;
+    bool _loaded { false };
+    bool _modified { false };
+
+    PaletteCellIconCache();
+    void load();
+
+public:
+    static PaletteCellIconCache* instance();
+
+    void setPath(const mu::io::path& path);
+    void save();
+
+    QByteArray elementHash(const std::shared_ptr<const Element>& element);
+
+    const QImage* icon(const QByteArray& key);
+    void insert(const QByteArray& key, const QImage& icon);
+};
+} // namespace Ms
+
+#endif
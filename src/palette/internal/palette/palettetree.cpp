@@ -19,10 +19,13 @@
 
 #include <QBuffer>
 #include <QAction>
+#include <QDataStream>
 #include <QMetaEnum>
+#include <QPainter>
 
 #include "palette.h"
 #include "palettetree.h"
+#include "palettecelliconcache.h"
 
 #include "libmscore/articulation.h"
 #include "libmscore/fret.h"
@@ -1188,12 +1191,10 @@ void PaletteCellIconEngine::paintTag(mu::draw::Painter& painter, const QRect& re
 //   PaletteCellIconEngine::paintCell
 //---------------------------------------------------------
 
-void PaletteCellIconEngine::paintCell(mu::draw::Painter& p, const QRect& r, bool selected, bool current) const
+void PaletteCellIconEngine::paintCell(mu::draw::Painter& p, const QRect& r) const
 {
     const qreal _yOffset = 0.0;   // TODO
 
-    paintBackground(p, r, selected, current);
-
     if (!_cell) {
         return;
     }
@@ -1232,12 +1233,68 @@ void PaletteCellIconEngine::paintCell(mu::draw::Painter& p, const QRect& r, bool
 //   PaletteCellIconEngine::paint
 //---------------------------------------------------------
 
+//---------------------------------------------------------
+//   PaletteCellIconEngine::iconKey
+//---------------------------------------------------------
+
+QByteArray PaletteCellIconEngine::iconKey(const QSize& size, qreal dpr) const
+{
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    stream << PaletteCellIconCache::instance()->elementHash(_cell->element) << size << dpr << _extraMag;
+    stream << _cell->tag << _cell->drawStaff << _cell->xoffset << _cell->yoffset << _cell->mag;
+    stream << configuration()->elementsColor().rgba();
+    return key;
+}
+
+//---------------------------------------------------------
+//   PaletteCellIconEngine::renderIcon
+//---------------------------------------------------------
+
+QImage PaletteCellIconEngine::renderIcon(const QSize& size, qreal dpr) const
+{
+    QImage image(size * dpr, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+
+    QPainter qp(&image);
+    mu::draw::Painter p(mu::draw::QPainterProvider::make(&qp));
+    p.setAntialiasing(true);
+    paintCell(p, QRect(QPoint(), size));
+
+    return image;
+}
+
+//---------------------------------------------------------
+//   PaletteCellIconEngine::paint
+//    the cell is drawn once for each size and kept in the
+//    icon cache, only the background is painted each time
+//---------------------------------------------------------
+
 void PaletteCellIconEngine::paint(QPainter* qp, const QRect& r, QIcon::Mode mode, QIcon::State state)
 {
     mu::draw::Painter p(mu::draw::QPainterProvider::make(qp));
     p.save();   // so we can restore it later
     p.setAntialiasing(true);
-    paintCell(p, r, mode == QIcon::Selected, state == QIcon::On);
+    paintBackground(p, r, mode == QIcon::Selected, state == QIcon::On);
     p.restore();   // return painter to saved initial state (undo any changes to pen, coordinates, font, etc.)
+
+    if (!_cell || r.isEmpty()) {
+        return;
+    }
+
+    const qreal dpr = qp->device() ? qp->device()->devicePixelRatioF() : 1.0;
+    const QByteArray key = iconKey(r.size(), dpr);
+
+    PaletteCellIconCache* cache = PaletteCellIconCache::instance();
+    const QImage* icon = cache->icon(key);
+    if (icon) {
+        qp->drawImage(r.topLeft(), *icon);
+        return;
+    }
+
+    QImage image = renderIcon(r.size(), dpr);
+    qp->drawImage(r.topLeft(), image);
+    cache->insert(key, image);
 }
 } // namespace Ms
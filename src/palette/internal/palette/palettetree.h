@@ -94,7 +94,9 @@ class PaletteCellIconEngine : public QIconEngine
     INJECT_STATIC(palette, mu::palette::IPaletteConfiguration, configuration)
 
 private:
-    void paintCell(mu::draw::Painter& p, const QRect& r, bool selected, bool current) const;
+    QByteArray iconKey(const QSize& size, qreal dpr) const;
+    QImage renderIcon(const QSize& size, qreal dpr) const;
+    void paintCell(mu::draw::Painter& p, const QRect& r) const;
     void paintScoreElement(mu::draw::Painter& p, Element* e, qreal spatium, bool alignToStaff) const;
 
     static qreal paintStaff(mu::draw::Painter& p, const QRect& rect, qreal spatium);
@@ -81,6 +81,11 @@ mu::io::path PaletteConfiguration::timeSignaturesDirPath() const
     return globalConfiguration()->dataPath() + "/timesigs";
 }
 
+mu::io::path PaletteConfiguration::iconCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/palette_icons.cache";
+}
+
 bool PaletteConfiguration::useFactorySettings() const
 {
     return globalConfiguration()->useFactorySettings();
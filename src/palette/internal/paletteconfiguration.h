@@ -46,6 +46,7 @@ public:
 
     io::path keySignaturesDirPath() const override;
     io::path timeSignaturesDirPath() const override;
+    io::path iconCachePath() const override;
 
     bool useFactorySettings() const override;
     bool enableExperimental() const override;
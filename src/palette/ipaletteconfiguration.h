@@ -46,6 +46,7 @@ public:
 
     virtual io::path keySignaturesDirPath() const = 0;
     virtual io::path timeSignaturesDirPath() const = 0;
+    virtual io::path iconCachePath() const = 0;
 
     virtual bool useFactorySettings() const = 0;
     virtual bool enableExperimental() const = 0;
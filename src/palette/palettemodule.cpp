@@ -30,6 +30,7 @@
 #include "internal/mu4paletteadapter.h"
 #include "internal/paletteconfiguration.h"
 #include "internal/palette/masterpalette.h"
+#include "internal/palette/palettecelliconcache.h"
 #include "internal/paletteactionscontroller.h"
 #include "internal/paletteactions.h"
 
@@ -52,6 +53,7 @@ using namespace mu::framework;
 using namespace mu::ui;
 
 static std::shared_ptr<MU4PaletteAdapter> s_adapter = std::make_shared<MU4PaletteAdapter>();
+static std::shared_ptr<PaletteConfiguration> s_configuration = std::make_shared<PaletteConfiguration>();
 static std::shared_ptr<PaletteActionsController> s_actionsController = std::make_shared<PaletteActionsController>();
 
 static void palette_init_qrc()
@@ -67,7 +69,7 @@ std::string PaletteModule::moduleName() const
 void PaletteModule::registerExports()
 {
     ioc()->registerExport<IPaletteAdapter>(moduleName(), s_adapter);
-    ioc()->registerExport<IPaletteConfiguration>(moduleName(), std::make_shared<PaletteConfiguration>());
+    ioc()->registerExport<IPaletteConfiguration>(moduleName(), s_configuration);
     ioc()->registerExport<IPaletteActionsController>(moduleName(), s_actionsController);
 
     // create a score for internal use
@@ -135,9 +137,16 @@ void PaletteModule::onInit(const IApplication::RunMode& mode)
         return;
     }
 
+    Ms::PaletteCellIconCache::instance()->setPath(s_configuration->iconCachePath());
+
     // load workspace
     PaletteWorkspaceSetup w;
     w.setup();
 
     s_actionsController->init();
 }
+
+void PaletteModule::onDeinit()
+{
+    Ms::PaletteCellIconCache::instance()->save();
+}
@@ -64,11 +64,8 @@ void PlaybackController::init()
 
     sequencer()->initMIDITrack(MIDI_TRACK);
 
+    //! NOTE The smooth cursor is moved by the notation view at each frame, it reads the position itself
     sequencer()->positionChanged().onNotify(this, [this]() {
-        if (configuration()->cursorType() == PlaybackCursorType::SMOOTH) {
-            m_tickPlayed.send(currentTick());
-        }
-
         m_playbackPositionChanged.notify();
     });
 
@@ -216,6 +213,7 @@ void PlaybackController::play()
 
     auto stream = playback()->midiStream();
     sequencer()->setMIDITrack(MIDI_TRACK, stream);
+    sequencer()->setIsMetronomeEnabled(MIDI_TRACK, notationConfiguration()->isMetronomeEnabled());
 
     RetVal<int> tick = playback()->playPositionTick();
     if (!tick.ret) {
@@ -282,6 +280,7 @@ void PlaybackController::toggleMetronome()
 {
     bool metronomeEnabled = notationConfiguration()->isMetronomeEnabled();
     notationConfiguration()->setIsMetronomeEnabled(!metronomeEnabled);
+    sequencer()->setIsMetronomeEnabled(MIDI_TRACK, !metronomeEnabled);
     notifyActionEnabledChanged(METRONOME_CODE);
 }
 
@@ -13,8 +13,10 @@
 #include "score.h"
 #include "cursor.h"
 #include "elements.h"
+#include "libmscore/chord.h"
 #include "libmscore/instrtemplate.h"
 #include "libmscore/measure.h"
+#include "libmscore/note.h"
 #include "libmscore/score.h"
 #include "libmscore/segment.h"
 #include "libmscore/text.h"
@@ -203,5 +205,130 @@ void Score::startCmd()
 {
     score()->startCmd();
 }
+
+//---------------------------------------------------------
+//   forEachNote
+//    calls f(chord, note) for the notes of the chords in
+//    [start, end), in the order listed by noteData
+//---------------------------------------------------------
+
+template<typename F>
+static void forEachNote(Ms::Score* score, int startTick, int endTick, F f)
+{
+    const Fraction start = Fraction::fromTicks(startTick);
+    const Fraction end = endTick < 0 ? score->endTick() : Fraction::fromTicks(endTick);
+    const int tracks = score->ntracks();
+
+    for (Ms::Measure* m = score->firstMeasure(); m && m->tick() < end; m = m->nextMeasure()) {
+        if (m->endTick() <= start) {
+            continue;
+        }
+        for (Ms::Segment* s = m->first(Ms::SegmentType::ChordRest); s; s = s->next(Ms::SegmentType::ChordRest)) {
+            if (s->tick() < start) {
+                continue;
+            }
+            if (s->tick() >= end) {
+                break;
+            }
+            for (int track = 0; track < tracks; ++track) {
+                Ms::Element* el = s->element(track);
+                if (!el || !el->isChord()) {
+                    continue;
+                }
+                Ms::Chord* chord = toChord(el);
+                for (Ms::Note* note : chord->notes()) {
+                    f(chord, note);
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   Score::noteData
+//---------------------------------------------------------
+
+QVariantMap Score::noteData(int startTick, int endTick)
+{
+    QVector<int> pitch, tpc, velocity, tick, duration, track;
+    forEachNote(score(), startTick, endTick, [&](Ms::Chord* chord, Ms::Note* note) {
+        pitch.append(note->pitch());
+        tpc.append(note->tpc());
+        velocity.append(note->veloOffset());
+        tick.append(chord->tick().ticks());
+        duration.append(chord->actualTicks().ticks());
+        track.append(chord->track());
+    });
+
+    QVariantMap data;
+    data["pitch"] = QVariant::fromValue(pitch);
+    data["tpc"] = QVariant::fromValue(tpc);
+    data["velocity"] = QVariant::fromValue(velocity);
+    data["tick"] = QVariant::fromValue(tick);
+    data["duration"] = QVariant::fromValue(duration);
+    data["track"] = QVariant::fromValue(track);
+    return data;
+}
+
+//---------------------------------------------------------
+//   Score::setNoteProperty
+//---------------------------------------------------------
+
+int Score::setNoteProperty(const QString& name, const QVariantList& values, int startTick, int endTick)
+{
+    const Pid pid = propertyId(name);
+    if (pid == Pid::END) {
+        qWarning("setNoteProperty: unknown property <%s>", qPrintable(name));
+        return 0;
+    }
+
+    const bool startedCmd = !score()->undoStack()->active();
+    if (startedCmd) {
+        score()->startCmd();
+    }
+    int n = 0;
+    forEachNote(score(), startTick, endTick, [&](Ms::Chord*, Ms::Note* note) {
+        if (n < values.size()) {
+            ScoreElement w(note, Ownership::SCORE);
+            w.set(pid, values[n]);
+            ++n;
+        }
+    });
+    if (startedCmd) {
+        score()->endCmd();
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   Score::setProperties
+//---------------------------------------------------------
+
+int Score::setProperties(const QVariantList& elements, const QString& name, const QVariantList& values)
+{
+    const Pid pid = propertyId(name);
+    if (pid == Pid::END) {
+        qWarning("setProperties: unknown property <%s>", qPrintable(name));
+        return 0;
+    }
+
+    const bool startedCmd = !score()->undoStack()->active();
+    if (startedCmd) {
+        score()->startCmd();
+    }
+    int n = 0;
+    const int count = std::min(elements.size(), values.size());
+    for (int i = 0; i < count; ++i) {
+        ScoreElement* w = qobject_cast<ScoreElement*>(elements[i].value<QObject*>());
+        if (w && w->element() && w->element()->score()->masterScore() == score()->masterScore()) {
+            w->set(pid, values[i]);
+            ++n;
+        }
+    }
+    if (startedCmd) {
+        score()->endCmd();
+    }
+    return n;
+}
 }
 }
@@ -187,6 +187,40 @@ public:
 
     Q_INVOKABLE QString extractLyrics() { return score()->extractLyrics(); }
 
+    /**
+     * Returns the notes of the chords in the tick range
+     * [\p startTick, \p endTick) as arrays of numbers, one
+     * item per note: \c pitch, \c tpc, \c velocity, \c tick,
+     * \c duration (in ticks) and \c track. The notes are
+     * listed by segment, track and from bottom to top in
+     * a chord, grace notes are not listed. This is much
+     * faster than walking the score with a Cursor for
+     * plugins which only read these values.
+     * \param endTick -1 for the end of the score.
+     * \see setNoteProperty
+     * \since MuseScore 4.0
+     */
+    Q_INVOKABLE QVariantMap noteData(int startTick = 0, int endTick = -1);
+    /**
+     * Sets the property \p name of the notes listed by
+     * \ref noteData for the same range to the items of
+     * \p values, which are in the same order. The changes
+     * are done in one undoable command with one layout
+     * at the end, or in the command started by startCmd().
+     * \returns the number of notes changed.
+     * \since MuseScore 4.0
+     */
+    Q_INVOKABLE int setNoteProperty(const QString& name, const QVariantList& values, int startTick = 0, int endTick = -1);
+    /**
+     * Sets the property \p name of each element of
+     * \p elements to the item of \p values at the same
+     * index, in one undoable command with one layout at
+     * the end, or in the command started by startCmd().
+     * \returns the number of elements changed.
+     * \since MuseScore 4.0
+     */
+    Q_INVOKABLE int setProperties(const QVariantList& elements, const QString& name, const QVariantList& values);
+
 //      //@ ??
 //      Q_INVOKABLE void updateRepeatList(bool expandRepeats) { score()->updateRepeatList(); } // TODO: needed?
 
@@ -26,6 +26,51 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+bool AudioConfigurationStub::driverExclusiveMode() const
+{
+    return false;
+}
+
+bool AudioConfigurationStub::useLegacyAudioBuffer() const
+{
+    return false;
+}
+
+unsigned int AudioConfigurationStub::zerberusRenderThreads() const
+{
+    return 1;
+}
+
+unsigned int AudioConfigurationStub::fluidRenderThreads() const
+{
+    return 1;
+}
+
+unsigned int AudioConfigurationStub::mixerThreads() const
+{
+    return 1;
+}
+
+size_t AudioConfigurationStub::zerberusSampleCacheSize() const
+{
+    return 0;
+}
+
+float AudioConfigurationStub::renderHighLoad() const
+{
+    return 0.f;
+}
+
+float AudioConfigurationStub::renderLowLoad() const
+{
+    return 0.f;
+}
+
+unsigned int AudioConfigurationStub::renderVoiceLimit() const
+{
+    return 0;
+}
+
 std::vector<io::path> AudioConfigurationStub::soundFontPaths() const
 {
     return {};
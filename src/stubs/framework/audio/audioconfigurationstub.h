@@ -26,6 +26,15 @@ class AudioConfigurationStub : public IAudioConfiguration
 {
 public:
     unsigned int driverBufferSize() const override;
+    bool driverExclusiveMode() const override;
+    bool useLegacyAudioBuffer() const override;
+    unsigned int zerberusRenderThreads() const override;
+    unsigned int fluidRenderThreads() const override;
+    unsigned int mixerThreads() const override;
+    size_t zerberusSampleCacheSize() const override;
+    float renderHighLoad() const override;
+    float renderLowLoad() const override;
+    unsigned int renderVoiceLimit() const override;
 
     std::vector<io::path> soundFontPaths() const override;
     const synth::SynthesizerState& synthesizerState() const override;
@@ -24,6 +24,7 @@
 #include "audioconfigurationstub.h"
 #include "audiodriverstub.h"
 #include "sequencerstub.h"
+#include "offlineaudiorendererstub.h"
 #include "synthesizersregisterstub.h"
 #include "soundfontsproviderstub.h"
 #include "internal/rpc/rpcchannelstub.h"
@@ -46,6 +47,7 @@ void AudioStubModule::registerExports()
     ioc()->registerExport<IAudioConfiguration>(moduleName(), new AudioConfigurationStub());
     ioc()->registerExport<IAudioDriver>(moduleName(), new AudioDriverStub());
     ioc()->registerExport<ISequencer>(moduleName(), new SequencerStub());
+    ioc()->registerExport<IOfflineAudioRenderer>(moduleName(), new OfflineAudioRendererStub());
 
     ioc()->registerExport<synth::ISynthesizersRegister>(moduleName(), new synth::SynthesizersRegisterStub());
     ioc()->registerExport<synth::ISoundFontsProvider>(moduleName(), new synth::SoundFontsProviderStub());
@@ -37,3 +37,8 @@ IRpcChannel::ListenID RpcChannelStub::listen(IRpcChannel::Handler)
 void RpcChannelStub::unlisten(IRpcChannel::ListenID)
 {
 }
+
+ChannelStats RpcChannelStub::stats() const
+{
+    return ChannelStats();
+}
@@ -31,6 +31,8 @@ public:
 
     ListenID listen(Handler h) override;
     void unlisten(ListenID id) override;
+
+    ChannelStats stats() const override;
 };
 }
 
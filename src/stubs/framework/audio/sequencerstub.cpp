@@ -75,6 +75,14 @@ void SequencerStub::unsetLoop()
 {
 }
 
+void SequencerStub::setIsTrackFrozen(TrackID, midi::track_t, bool)
+{
+}
+
+void SequencerStub::setIsMetronomeEnabled(TrackID, bool)
+{
+}
+
 async::Channel<midi::tick_t> SequencerStub::midiTickPlayed(ISequencer::TrackID) const
 {
     return async::Channel<midi::tick_t>();
@@ -40,6 +40,8 @@ public:
     void rewind() override;
     void setLoop(uint64_t fromMilliseconds, uint64_t toMilliseconds) override;
     void unsetLoop() override;
+    void setIsTrackFrozen(TrackID id, midi::track_t trackIndex, bool frozen) override;
+    void setIsMetronomeEnabled(TrackID id, bool enabled) override;
 
     async::Channel<midi::tick_t> midiTickPlayed(TrackID id) const override;
     async::Notification positionChanged() const override;
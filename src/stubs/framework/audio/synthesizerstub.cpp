@@ -99,6 +99,10 @@ bool SynthesizerStub::handleEvent(const midi::Event&)
     return false;
 }
 
+void SynthesizerStub::scheduleEvent(const midi::Event&, unsigned int)
+{
+}
+
 void SynthesizerStub::writeBuf(float*, unsigned int)
 {
 }
@@ -129,3 +133,7 @@ bool SynthesizerStub::channelPitch(midi::channel_t, int16_t)
 {
     return false;
 }
+
+void SynthesizerStub::setRenderBudget(const RenderBudget&)
+{
+}
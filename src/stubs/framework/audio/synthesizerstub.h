@@ -53,6 +53,7 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override;
@@ -61,6 +62,7 @@ public:
     bool channelVolume(midi::channel_t chan, float val) override;
     bool channelBalance(midi::channel_t chan, float val) override;
     bool channelPitch(midi::channel_t chan, int16_t val) override;
+    void setRenderBudget(const RenderBudget& budget) override;
 };
 }
 
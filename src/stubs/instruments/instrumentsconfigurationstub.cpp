@@ -24,3 +24,8 @@ mu::io::paths InstrumentsConfigurationStub::instrumentPaths() const
 {
     return {};
 }
+
+mu::io::path InstrumentsConfigurationStub::instrumentsCachePath() const
+{
+    return mu::io::path();
+}
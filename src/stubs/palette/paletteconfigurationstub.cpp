@@ -65,6 +65,11 @@ mu::io::path PaletteConfigurationStub::timeSignaturesDirPath() const
     return mu::io::path();
 }
 
+mu::io::path PaletteConfigurationStub::iconCachePath() const
+{
+    return mu::io::path();
+}
+
 bool PaletteConfigurationStub::useFactorySettings() const
 {
     return false;
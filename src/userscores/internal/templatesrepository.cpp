@@ -50,7 +50,7 @@ RetVal<Templates> TemplatesRepository::templates() const
 Templates TemplatesRepository::loadTemplates(const io::paths& filePaths) const
 {
     Templates result;
-    MetaList metaList = msczReader()->readMetaList(filePaths);
+    MetaList metaList = msczReader()->readIndexedMetaList(filePaths);
 
     for (const Meta& meta: metaList) {
         Template templ(meta);
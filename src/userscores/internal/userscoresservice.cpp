@@ -36,7 +36,7 @@ void UserScoresService::init()
 void UserScoresService::updateRecentScoreList()
 {
     io::paths paths = configuration()->recentScorePaths().val;
-    MetaList metaList = msczMetaReader()->readMetaList(paths);
+    MetaList metaList = msczMetaReader()->readIndexedMetaList(paths);
     m_recentScoreList.set(metaList);
 }
 
@@ -111,7 +111,7 @@ TEST_F(TemplatesRepositoryTest, Templates)
     for (const io::path& path: allPathsToMsczFiles) {
         Meta meta = createMeta(path.toQString());
 
-        ON_CALL(*m_msczReader, readMetaList(io::paths { path }))
+        ON_CALL(*m_msczReader, readIndexedMetaList(io::paths { path }))
         .WillByDefault(Return(MetaList { meta }));
 
         Template templ(meta);
@@ -76,6 +76,8 @@ void Workspace::setTags(const WorkspaceTagList& tags)
 
 AbstractDataPtr Workspace::data(WorkspaceTag tag, const std::string& name) const
 {
+    loadData(tag);
+
     DataKey key { tag, name };
     auto it = m_data.find(key);
     if (it != m_data.end()) {
@@ -86,6 +88,8 @@ AbstractDataPtr Workspace::data(WorkspaceTag tag, const std::string& name) const
 
 AbstractDataPtrList Workspace::dataList(WorkspaceTag tag) const
 {
+    loadData(tag);
+
     AbstractDataPtrList result;
 
     for (auto it = m_data.cbegin(); it != m_data.cend(); ++it) {
@@ -118,6 +122,8 @@ async::Channel<AbstractDataPtr> Workspace::dataChanged() const
 
 void Workspace::addData(AbstractDataPtr data)
 {
+    loadData(data->tag);
+
     DataKey key { data->tag, data->name };
     m_data[key] = data;
 
@@ -150,13 +156,47 @@ Ret Workspace::read()
         return ret;
     }
 
+    m_rootFileData = data;
+
     m_isInited = true;
 
     return make_ret(Ret::Code::Ok);
 }
 
+void Workspace::loadData(WorkspaceTag tag) const
+{
+    if (m_loadedTags.find(tag) != m_loadedTags.end()) {
+        return;
+    }
+
+    m_loadedTags.insert(tag);
+
+    if (m_rootFileData.isEmpty()) {
+        return;
+    }
+
+    QBuffer buffer;
+    buffer.setData(m_rootFileData);
+    buffer.open(IODevice::ReadOnly);
+
+    for (const IWorkspaceDataStreamPtr& stream : streamRegister()->streams()) {
+        if (stream->tag() != tag) {
+            continue;
+        }
+
+        for (AbstractDataPtr data : stream->read(buffer)) {
+            DataKey key { data->tag, data->name };
+            m_data.insert({ key, data });
+        }
+
+        buffer.seek(0);
+    }
+}
+
 void Workspace::clear()
 {
+    m_rootFileData.clear();
+    m_loadedTags.clear();
     m_data.clear();
     m_hasUnsavedChanges = false;
     m_isInited = false;
@@ -227,17 +267,6 @@ Ret Workspace::readWorkspace(const QByteArray& xmlData)
         }
     }
 
-    buffer.seek(0);
-
-    for (const IWorkspaceDataStreamPtr& stream : streamRegister()->streams()) {
-        for (AbstractDataPtr data : stream->read(buffer)) {
-            DataKey key { data->tag, data->name };
-            m_data[key] = data;
-        }
-
-        buffer.seek(0);
-    }
-
     return make_ret(Ret::Code::Ok);
 }
 
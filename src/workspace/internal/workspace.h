@@ -20,6 +20,9 @@
 #define MU_WORKSPACE_WORKSPACE_H
 
 #include <map>
+#include <set>
+
+#include <QByteArray>
 
 #include "../iworkspace.h"
 #include "modularity/ioc.h"
@@ -56,6 +59,7 @@ public:
 
 private:
     Ret readWorkspace(const QByteArray& data);
+    void loadData(WorkspaceTag tag) const;
     void clear();
 
     std::string tagsNames() const;
@@ -82,7 +86,10 @@ private:
         }
     };
 
-    std::map<DataKey, AbstractDataPtr> m_data;
+    //! NOTE The data of a tag is parsed from the root file on the first access to it
+    QByteArray m_rootFileData;
+    mutable std::set<WorkspaceTag> m_loadedTags;
+    mutable std::map<DataKey, AbstractDataPtr> m_data;
     async::Channel<AbstractDataPtr> m_dataChanged;
 
     WorkspaceTagList m_tags;
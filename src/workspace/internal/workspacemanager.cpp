@@ -18,6 +18,8 @@
 //=============================================================================
 #include "workspacemanager.h"
 
+#include <QTimer>
+
 #include "log.h"
 
 using namespace mu;
@@ -166,7 +168,7 @@ void WorkspaceManager::init()
     }
 
     configuration()->currentWorkspaceName().ch.onReceive(this, [this](const std::string&) {
-        setupCurrentWorkspace();
+        scheduleSetupCurrentWorkspace();
     });
 
     load();
@@ -227,6 +229,21 @@ void WorkspaceManager::setupCurrentWorkspace()
     }
 }
 
+//! NOTE The switch is applied when the event loop gets back control, so the change of the setting returns at once
+//! and only the last of the switches in a row is applied
+void WorkspaceManager::scheduleSetupCurrentWorkspace()
+{
+    if (m_isSetupScheduled) {
+        return;
+    }
+
+    m_isSetupScheduled = true;
+    QTimer::singleShot(0, [this]() {
+        m_isSetupScheduled = false;
+        setupCurrentWorkspace();
+    });
+}
+
 WorkspacePtr WorkspaceManager::findByName(const std::string& name) const
 {
     for (auto workspace : m_workspaces) {
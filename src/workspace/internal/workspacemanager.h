@@ -56,12 +56,14 @@ private:
 
     io::paths findWorkspaceFiles() const;
     void setupCurrentWorkspace();
+    void scheduleSetupCurrentWorkspace();
 
     WorkspacePtr findByName(const std::string& name) const;
     WorkspacePtr findAndInit(const std::string& name) const;
 
     WorkspacePtr m_currentWorkspace;
     std::vector<WorkspacePtr> m_workspaces;
+    bool m_isSetupScheduled = false;
 
     async::Channel<IWorkspacePtr> m_currentWorkspaceChanged;
 };
@@ -25,11 +25,22 @@ using namespace mu::async;
 
 void WorkspaceSettings::init()
 {
-    manager()->currentWorkspace().ch.onReceive(this, [this](const IWorkspacePtr) {
+    m_workspace = currentWorkspace();
+
+    manager()->currentWorkspace().ch.onReceive(this, [this](const IWorkspacePtr workspace) {
+        IWorkspacePtr previousWorkspace = m_workspace;
+        m_workspace = workspace;
+
         m_valuesChanged.notify();
 
+        //! NOTE The values the workspaces have in common are kept, their receivers are not bothered
         for (auto it = m_channels.begin(); it != m_channels.end(); ++it) {
-            it->second.send(value(it->first));
+            Val newValue = value(workspace, it->first);
+            if (previousWorkspace && newValue == value(previousWorkspace, it->first)) {
+                continue;
+            }
+
+            it->second.send(newValue);
         }
     });
 }
@@ -50,11 +61,16 @@ bool WorkspaceSettings::isManage(WorkspaceTag tag) const
 
 mu::Val WorkspaceSettings::value(const Key& key) const
 {
-    if (!currentWorkspace()) {
+    return value(currentWorkspace(), key);
+}
+
+mu::Val WorkspaceSettings::value(const IWorkspacePtr& workspace, const Key& key) const
+{
+    if (!workspace) {
         return Val();
     }
 
-    AbstractDataPtr abstractData = currentWorkspace()->data(key.tag);
+    AbstractDataPtr abstractData = workspace->data(key.tag);
     SettingsDataPtr settingsData = std::dynamic_pointer_cast<SettingsData>(abstractData);
     if (settingsData && settingsData->values.find(key.key) != settingsData->values.end()) {
         return settingsData->values[key.key];
@@ -42,7 +42,9 @@ public:
 
 private:
     IWorkspacePtr currentWorkspace() const;
+    Val value(const IWorkspacePtr& workspace, const Key& key) const;
 
+    IWorkspacePtr m_workspace;
     mutable std::map<Key, async::Channel<Val> > m_channels;
     async::Notification m_valuesChanged;
 };
@@ -87,8 +87,9 @@ bool Agent::considerAsBeat(const Event &e, AgentList &a)
             if ((beats > 0) && (-preMargin <= err) && (err <= postMargin)) {
                   if (std::fabs(err) > innerMargin) {
                                     // Create new agent that skips this event (avoids
-                                    // large phase jump)
-                        a.add(clone());
+                                    // large phase jump); the list is sorted by
+                                    // AgentList::beatTrack() after the event
+                        a.add(clone(), false);
                         }
                   accept(e, err, (int)beats);
                   return true;
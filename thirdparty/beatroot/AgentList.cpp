@@ -72,17 +72,16 @@ void AgentList::removeDuplicates()
                         }
                   }
             }
-      int removed = 0;
-      for (iterator itr = begin(); itr != end(); ) {
-            if ((*itr)->phaseScore < 0.0) {
-                  ++removed;
+                  // compact the list in one pass, erasing the flagged agents
+                  // one by one would move the rest of the list for each of them
+      iterator kept = begin();
+      for (iterator itr = begin(); itr != end(); ++itr) {
+            if ((*itr)->phaseScore < 0.0)
                   delete *itr;
-                  list.erase(itr);
-                  }
-            else {
-                  ++itr;
-                  }
+            else
+                  *kept++ = *itr;
             }
+      list.erase(kept, end());
       }
 
 
@@ -104,8 +103,12 @@ void AgentList::beatTrack(const EventList &el,
                         // list while scanning without disrupting our scan.  Each
                         // agent needs to be re-added to our own list explicitly
                         // (since it is modified by e.g. considerAsBeat)
-            Container currentAgents = list;
-            list.clear();
+                        // The agents are added unsorted, removeDuplicates()
+                        // sorts the list once for the event; the order of the
+                        // list is not used while scanning the copy.
+            Container currentAgents;
+            currentAgents.swap(list);
+            list.reserve(currentAgents.size());
             for (Container::iterator ai = currentAgents.begin();
                         ai != currentAgents.end(); ++ai) {
                   Agent *currentAgent = *ai;
@@ -115,14 +118,14 @@ void AgentList::beatTrack(const EventList &el,
                               Agent *newAgent = new Agent(params, prevBeatInterval);
                                           // This may add another agent to our list as well
                               newAgent->considerAsBeat(ev, *this);
-                              add(newAgent);
+                              add(newAgent, false);
                               }
                         prevBeatInterval = currentAgent->beatInterval;
                         created = phaseGiven;
                         }
                   if (currentAgent->considerAsBeat(ev, *this))
                         created = true;
-                  add(currentAgent);
+                  add(currentAgent, false);
                   }           // loop for each agent
             removeDuplicates();
             }           // loop for each event
@@ -26,18 +26,28 @@ void AbstractInvoker::invoke(int type, const NotifyData& data)
         return;
     }
 
-    std::thread::id threadID = std::this_thread::get_id();
+    //! NOTE: explicit copy because collection can be modified from elsewhere,
+    //! a single callback, as most have, is copied without allocation
+    if (it->second.size() == 1) {
+        CallBack c = it->second.front();
+        invokeOne(type, c, data);
+        return;
+    }
 
-    //! NOTE: explicit copy because collection can be modified from elsewhere
     CallBacks callbacks = it->second;
 
     for (const CallBack& c : callbacks) {
-        if (c.threadID == threadID) {
-            invokeCallback(type, c, data);
-        } else {
-            auto functor = [this, type, c, data]() { invokeCallback(type, c, data); };
-            QueuedInvoker::instance()->invoke(c.threadID, functor);
-        }
+        invokeOne(type, c, data);
+    }
+}
+
+void AbstractInvoker::invokeOne(int type, const CallBack& c, const NotifyData& data)
+{
+    if (c.threadID == std::this_thread::get_id()) {
+        invokeCallback(type, c, data);
+    } else {
+        auto functor = [this, type, c, data]() { invokeCallback(type, c, data); };
+        QueuedInvoker::instance()->invoke(c.threadID, functor);
     }
 }
 
@@ -21,18 +21,17 @@ public:
     template<typename T>
     void setArg(int i, const T& val)
     {
-        IArg* p = new Arg<T>(val);
-        m_args.insert(m_args.begin() + i, std::shared_ptr<IArg>(p));
+        insertArg(i, std::make_shared<Arg<T> >(val));
     }
 
     template<typename T>
     T arg(int i = 0) const
     {
-        IArg* p = m_args.at(i).get();
+        const IArg* p = argAt(i);
         if (!p) {
             return T();
         }
-        Arg<T>* d = reinterpret_cast<Arg<T>*>(p);
+        const Arg<T>* d = reinterpret_cast<const Arg<T>*>(p);
         return d->val;
     }
 
@@ -48,7 +47,35 @@ public:
     };
 
 private:
+    // the arguments set in order, as all the notifications do, are kept in place
+    static constexpr int InlineArgs = 2;
+
+    void insertArg(int i, std::shared_ptr<IArg> p)
+    {
+        if (m_args.empty() && i == m_count && m_count < InlineArgs) {
+            m_inline[m_count++] = std::move(p);
+            return;
+        }
+        if (m_args.empty()) {
+            for (int k = 0; k < m_count; ++k) {
+                m_args.push_back(std::move(m_inline[k]));
+            }
+        }
+        m_args.insert(m_args.begin() + i, std::move(p));
+        m_count = int(m_args.size());
+    }
+
+    const IArg* argAt(int i) const
+    {
+        if (i < 0 || i >= m_count) {
+            return nullptr;
+        }
+        return m_args.empty() ? m_inline[i].get() : m_args[i].get();
+    }
+
+    std::shared_ptr<IArg> m_inline[InlineArgs];
     std::vector<std::shared_ptr<IArg> > m_args;
+    int m_count = 0;
 };
 
 class QueuedInvoker;
@@ -89,6 +116,7 @@ protected:
         bool containsReceiver(Asyncable* receiver) const;
     };
 
+    void invokeOne(int type, const CallBack& c, const NotifyData& data);
     void invokeCallback(int type, const CallBack& c, const NotifyData& data);
 
     void addCallBack(int type, Asyncable* receiver, void* call, Asyncable::AsyncMode mode = Asyncable::AsyncMode::AsyncSetRepeat);
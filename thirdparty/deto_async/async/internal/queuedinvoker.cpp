@@ -12,7 +12,9 @@ void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f)
 {
     if (m_onMainThreadInvoke) {
         if (th == m_mainThreadID) {
+            // the main thread runs it from its event loop, it must not wait in a queue no one processes
             m_onMainThreadInvoke(f);
+            return;
         }
     }
 
@@ -39,6 +39,10 @@
 
 #ifndef QT_NO_TEXTODFWRITER
 
+#include <climits>
+#include <memory>
+
+#include <QBuffer>
 #include <QDir>
 #include <QDebug>
 #include <QFileInfo>
@@ -542,10 +546,130 @@ public:
     }
 
     void scanFiles();
+    int findFile(const QString& fileName) const;
+    bool findEntryData(int index, int* method, qint64* offset, qint64* compressedSize, qint64* uncompressedSize) const;
 
     MQZipReader::Status status;
+
+    // the whole archive, if the device is a file that could be mapped
+    const uchar* mapped = nullptr;
+    qint64 mappedSize = 0;
+};
+
+//---------------------------------------------------------
+//   MQZipInflateDevice
+//    a sequential device that inflates a deflated entry
+//    while it is read. The compressed bytes come from the
+//    mapped archive or, in chunks, from the archive device.
+//---------------------------------------------------------
+
+class MQZipInflateDevice : public QIODevice
+{
+public:
+    MQZipInflateDevice(const uchar* source, QIODevice* device, qint64 offset, qint64 compressedSize, qint64 size)
+        : _source(source), _device(device), _offset(offset), _remaining(compressedSize), _size(size)
+    {
+        memset(&_stream, 0, sizeof(_stream));
+        _ok = inflateInit2(&_stream, -MAX_WBITS) == Z_OK;
+        open(QIODevice::ReadOnly);
+    }
+
+    ~MQZipInflateDevice() override
+    {
+        if (_ok) {
+            inflateEnd(&_stream);
+        }
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 size() const override { return _size; }
+    bool atEnd() const override { return _end && QIODevice::atEnd(); }
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override;
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    static constexpr qint64 CHUNK_SIZE = 64 * 1024;
+
+    bool refill();
+
+    const uchar* _source;
+    QIODevice* _device;
+    qint64 _offset;
+    qint64 _remaining;
+    qint64 _size;
+    QByteArray _chunk;
+    z_stream _stream;
+    bool _ok = false;
+    bool _end = false;
 };
 
+//---------------------------------------------------------
+//   refill
+//    hands the next compressed bytes to zlib; the archive
+//    device is shared, so it is positioned for every chunk
+//---------------------------------------------------------
+
+bool MQZipInflateDevice::refill()
+{
+    if (_remaining <= 0) {
+        return false;
+    }
+    const qint64 n = qMin(_remaining, _source ? qint64(UINT_MAX) : CHUNK_SIZE);
+    if (_source) {
+        _stream.next_in = const_cast<Bytef*>(_source + _offset);
+    } else {
+        if (!_device->seek(_offset)) {
+            return false;
+        }
+        _chunk = _device->read(n);
+        if (_chunk.size() != n) {
+            return false;
+        }
+        _stream.next_in = reinterpret_cast<Bytef*>(_chunk.data());
+    }
+    _stream.avail_in = uInt(n);
+    _offset += n;
+    _remaining -= n;
+    return true;
+}
+
+//---------------------------------------------------------
+//   readData
+//---------------------------------------------------------
+
+qint64 MQZipInflateDevice::readData(char* data, qint64 maxlen)
+{
+    if (!_ok) {
+        return -1;
+    }
+    if (_end) {
+        return 0;
+    }
+    _stream.next_out = reinterpret_cast<Bytef*>(data);
+    _stream.avail_out = uInt(qMin(maxlen, qint64(UINT_MAX)));
+    while (_stream.avail_out > 0) {
+        if (_stream.avail_in == 0 && !refill()) {
+            setErrorString(QStringLiteral("QZip: unexpected end of compressed data"));
+            break;
+        }
+        const int res = inflate(&_stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            _end = true;
+            break;
+        }
+        if (res != Z_OK && res != Z_BUF_ERROR) {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            setErrorString(QStringLiteral("QZip: input data is corrupted"));
+            _ok = false;
+            break;
+        }
+    }
+    const qint64 n = reinterpret_cast<char*>(_stream.next_out) - data;
+    return n > 0 || _end ? n : -1;
+}
+
 class MQZipWriterPrivate : public MQZipPrivate
 {
 public:
@@ -613,6 +737,10 @@ void MQZipReaderPrivate::scanFiles()
     int start_of_directory_local = -1;
     int num_dir_entries = 0;
     EndOfDirectory eod;
+    if (QFile* file = qobject_cast<QFile*>(device)) {
+        mappedSize = file->size();
+        mapped = mappedSize > 0 ? file->map(0, mappedSize) : nullptr;
+    }
     while (start_of_directory_local == -1) {
         const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
         if (pos < 0 || i > 65535) {
@@ -620,6 +748,16 @@ void MQZipReaderPrivate::scanFiles()
             return;
         }
 
+        if (mapped) {
+            // search the mapping, no seek and read for every byte of the comment
+            if (readUInt(mapped + pos) != 0x06054b50) {
+                ++i;
+                continue;
+            }
+            memcpy(&eod, mapped + pos, sizeof(EndOfDirectory));
+            device->seek(pos + sizeof(EndOfDirectory));
+            break;
+        }
         device->seek(pos);
         device->read((char*)&eod, sizeof(EndOfDirectory));
         if (readUInt(eod.signature) == 0x06054b50) {
@@ -965,95 +1103,179 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
     return MQZipReader::FileInfo();
 }
 
-/*!
-    Fetch the file contents from the zip archive and return the uncompressed bytes.
-*/
-QByteArray MQZipReader::fileData(const QString& fileName) const
+int MQZipReaderPrivate::findFile(const QString& fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
-            break;
+    const QByteArray name = fileName.toUtf8();
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (fileHeaders.at(i).file_name == name) {
+            return i;
         }
     }
-    if (i == d->fileHeaders.size()) {
-        return QByteArray();
-    }
+    return -1;
+}
 
-    FileHeader header = d->fileHeaders.at(i);
+/*!
+    \internal
+    Locates the data of the entry at \a index, behind its local header.
+    Returns false for entries that cannot be extracted.
+*/
+bool MQZipReaderPrivate::findEntryData(int index, int* method, qint64* offset, qint64* compressedSize,
+                                       qint64* uncompressedSize) const
+{
+    const FileHeader& header = fileHeaders.at(index);
 
     ushort version_needed = readUShort(header.h.version_needed);
     if (version_needed > ZIP_VERSION) {
         qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
+        return false;
     }
 
     ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    *compressedSize = readUInt(header.h.compressed_size);
+    *uncompressedSize = readUInt(header.h.uncompressed_size);
+    qint64 start = readUInt(header.h.offset_local_header);
 
-    d->device->seek(start);
     LocalFileHeader lh;
-    d->device->read((char*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
+    if (mapped) {
+        if (start + qint64(sizeof(LocalFileHeader)) > mappedSize) {
+            return false;
+        }
+        memcpy(&lh, mapped + start, sizeof(LocalFileHeader));
+    } else {
+        device->seek(start);
+        if (device->read((char*)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader))) {
+            return false;
+        }
+    }
+    *offset = start + sizeof(LocalFileHeader) + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    *method = readUShort(lh.compression_method);
 
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
+    if (mapped && *offset + *compressedSize > mappedSize) {
+        qWarning("QZip: entry %d is truncated", index);
+        return false;
+    }
+    if (*method != CompressionMethodStored && *method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", *method);
+        return false;
+    }
+    return true;
+}
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+/*!
+    Fetch the file contents from the zip archive and return the uncompressed bytes.
+*/
+QByteArray MQZipReader::fileData(const QString& fileName) const
+{
+    d->scanFiles();
+    const int i = d->findFile(fileName);
+    int compression_method;
+    qint64 start, compressed_size, uncompressed_size;
+    if (i == -1 || !d->findEntryData(i, &compression_method, &start, &compressed_size, &uncompressed_size)) {
         return QByteArray();
     }
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
-    } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
-        QByteArray baunzip;
-        ulong len = qMax(uncompressed_size,  1);
-        int res;
-        do {
-            baunzip.resize(len);
-            res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
+        const qint64 size = qMin(compressed_size, uncompressed_size);
+        if (d->mapped) {
+            return QByteArray(reinterpret_cast<const char*>(d->mapped + start), int(size));
+        }
+        d->device->seek(start);
+        return d->device->read(size);
+    }
 
-            switch (res) {
-            case Z_OK:
-                if ((int)len != baunzip.size()) {
-                    baunzip.resize(len);
-                }
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory");
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            case Z_DATA_ERROR:
-                qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
-                break;
+    // Deflate, the compressed bytes are read from the mapping in place
+    QByteArray compressed;
+    if (d->mapped) {
+        compressed = QByteArray::fromRawData(reinterpret_cast<const char*>(d->mapped + start), int(compressed_size));
+    } else {
+        d->device->seek(start);
+        compressed = d->device->read(compressed_size);
+    }
+    QByteArray baunzip;
+    ulong len = qMax(uncompressed_size, qint64(1));
+    int res;
+    do {
+        baunzip.resize(len);
+        res = inflate((uchar*)baunzip.data(), &len,
+                      (const uchar*)compressed.constData(), compressed.size());
+
+        switch (res) {
+        case Z_OK:
+            if ((int)len != baunzip.size()) {
+                baunzip.resize(len);
             }
-        } while (res == Z_BUF_ERROR);
-        return baunzip;
+            break;
+        case Z_MEM_ERROR:
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            break;
+        case Z_BUF_ERROR:
+            len *= 2;
+            break;
+        case Z_DATA_ERROR:
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            break;
+        }
+    } while (res == Z_BUF_ERROR);
+    return baunzip;
+}
+
+/*!
+    Like fileData(), but a stored entry of a mapped archive is returned
+    without a copy: the bytes then point into the mapping and are only
+    valid until the reader or its device is closed. Copy them to keep them.
+*/
+QByteArray MQZipReader::fileDataView(const QString& fileName) const
+{
+    d->scanFiles();
+    const int i = d->findFile(fileName);
+    int compression_method;
+    qint64 start, compressed_size, uncompressed_size;
+    if (i == -1 || !d->mapped
+        || !d->findEntryData(i, &compression_method, &start, &compressed_size, &uncompressed_size)
+        || compression_method != CompressionMethodStored) {
+        return i == -1 ? QByteArray() : fileData(fileName);
+    }
+    const qint64 size = qMin(compressed_size, uncompressed_size);
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(d->mapped + start), int(size));
+}
+
+/*!
+    Returns an open device that reads the uncompressed contents of \a fileName,
+    or nullptr if there is no such entry. Deflated entries are inflated while
+    the device is read, stored entries are read in place. The caller owns the
+    device, it must not outlive the reader and should be the only reader of
+    the archive while it is used.
+*/
+QIODevice* MQZipReader::fileDevice(const QString& fileName) const
+{
+    d->scanFiles();
+    const int i = d->findFile(fileName);
+    int compression_method;
+    qint64 start, compressed_size, uncompressed_size;
+    if (i == -1 || !d->findEntryData(i, &compression_method, &start, &compressed_size, &uncompressed_size)) {
+        return nullptr;
+    }
+
+    if (compression_method == CompressionMethodDeflated) {
+        return new MQZipInflateDevice(d->mapped, d->device, start, compressed_size, uncompressed_size);
     }
 
-    qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
-    return QByteArray();
+    QBuffer* buffer = new QBuffer;
+    buffer->setData(fileDataView(fileName));
+    buffer->open(QIODevice::ReadOnly);
+    return buffer;
 }
 
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
-    the local filesystem.
+    the local filesystem. The files are inflated and written block by block,
+    an entry is never held in memory as a whole.
     In case writing or linking a file fails, the extraction will be aborted.
 */
 bool MQZipReader::extractAll(const QString& destinationDir) const
@@ -1099,11 +1321,21 @@ bool MQZipReader::extractAll(const QString& destinationDir) const
     for (const FileInfo& fi : allFiles) {
         const QString absPath = destinationDir + QDir::separator() + fi.filePath;
         if (fi.isFile) {
+            std::unique_ptr<QIODevice> in(fileDevice(fi.filePath));
             QFile f(absPath);
-            if (!f.open(QIODevice::WriteOnly)) {
+            if (!in || !f.open(QIODevice::WriteOnly)) {
+                return false;
+            }
+            char block[64 * 1024];
+            qint64 n;
+            while ((n = in->read(block, sizeof(block))) > 0) {
+                if (f.write(block, n) != n) {
+                    return false;
+                }
+            }
+            if (n < 0) {
                 return false;
             }
-            f.write(fileData(fi.filePath));
             f.setPermissions(fi.permissions);
             f.close();
         }
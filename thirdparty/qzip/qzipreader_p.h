@@ -99,6 +99,8 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+    QByteArray fileDataView(const QString &fileName) const;
+    QIODevice* fileDevice(const QString &fileName) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
@@ -11,6 +11,10 @@ PNG_CUR_DIR=$ARTIFACTS_DIR/current
 COMPARE_DIR=$ARTIFACTS_DIR/compare
 MSCORE_BIN=build.debug/install/bin/mscore
 DPI=130
+GEN_JOBS=1          # converter workers, more than one makes the timings less comparable
+DIFF_JOBS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)
+TIME_THRESHOLD=20   # percent
+TIME_MIN_MS=50      # smaller slowdowns are noise
 
 while [[ "$#" -gt 0 ]]; do
     case $1 in
@@ -20,6 +24,10 @@ while [[ "$#" -gt 0 ]]; do
         -m|--mscore) MSCORE_BIN="$2"; shift ;;
         --ref-dir) PNG_REF_DIR="$2"; shift ;;
         --cur-dir) PNG_CUR_DIR="$2"; shift ;;
+        --gen-jobs) GEN_JOBS="$2"; shift ;;
+        --diff-jobs) DIFF_JOBS="$2"; shift ;;
+        --time-threshold) TIME_THRESHOLD="$2"; shift ;;
+        --time-min-ms) TIME_MIN_MS="$2"; shift ;;
         *) echo "Unknown parameter passed: $1"; exit 1 ;;
     esac
     shift
@@ -49,11 +57,13 @@ if [ "$RUN_CMD" == "gen" ]; then
         PNG_DIR=$PNG_REF_DIR
         PNG_PREFIX=".ref.png"
         LOG_FILE=$PNG_REF_DIR/convert_ref.log
+        TIMINGS_FILE=$PNG_REF_DIR/timings_ref.json
     else 
         JSON_FILE=$PNG_CUR_DIR/vtestjob.json; 
         PNG_DIR=$PNG_CUR_DIR
         PNG_PREFIX=".png"
         LOG_FILE=$PNG_CUR_DIR/convert.log
+        TIMINGS_FILE=$PNG_CUR_DIR/timings.json
     fi
 
     rm -rf $PNG_DIR
@@ -71,8 +81,16 @@ if [ "$RUN_CMD" == "gen" ]; then
     echo "{}]" >> $JSON_FILE
     cat $JSON_FILE        
 
+    # The scores are converted in one run of the converter, so the startup is paid once,
+    # and the converter writes the load, layout and write time of each score.
+    # An older build without the timings just converts.
+    CONVERT_ARGS="-j $JSON_FILE -r $DPI"
+    if $MSCORE_BIN --help 2>&1 | grep -q -- "--job-result"; then
+        CONVERT_ARGS="$CONVERT_ARGS --job-result $TIMINGS_FILE --jobs $GEN_JOBS"
+    fi
+
     echo "Generate PNG files"
-    $MSCORE_BIN -j $JSON_FILE -r $DPI >$LOG_FILE 2>&1
+    $MSCORE_BIN $CONVERT_ARGS >$LOG_FILE 2>&1
 
     echo "LOG:"
     cat $LOG_FILE
@@ -87,23 +105,35 @@ if [ "$RUN_CMD" == "gen" ]; then
 elif [ "$RUN_CMD" == "compare" ]; then
     echo "Compare PNG files and references"
 
-    # Compare
+    # Compare, the images are compared in parallel, each compare writes its metric next to its diff
     rm -rf $COMPARE_DIR
     mkdir $COMPARE_DIR
     PNG_REF_LIST=$(ls $PNG_REF_DIR/*.ref.png)
+    for PNG_REF_FILE in $PNG_REF_LIST ; do
+        png_file_name=$(basename $PNG_REF_FILE)
+        FILE_NAME=${png_file_name%.ref.png}
+        if test -f $PNG_CUR_DIR/${FILE_NAME}.png; then
+            echo $FILE_NAME
+        fi
+    done | xargs -P $DIFF_JOBS -I {} sh -c \
+        'compare -metric AE -fuzz 0.0% "$1/{}.ref.png" "$2/{}.png" "$3/{}.diff.png" >/dev/null 2>"$3/{}.ae"' \
+        sh "$PNG_REF_DIR" "$PNG_CUR_DIR" "$COMPARE_DIR"
+
     DIFF_NAME_LIST=""
     for PNG_REF_FILE in $PNG_REF_LIST ; do
         png_file_name=$(basename $PNG_REF_FILE)
         FILE_NAME=${png_file_name%.ref.png}
         PNG_CUR_FILE=$PNG_CUR_DIR/${FILE_NAME}.png
         PNG_DIFF_FILE=$COMPARE_DIR/${FILE_NAME}.diff.png
-        
-        if test -f $PNG_CUR_FILE; then
-            code=$(compare -metric AE -fuzz 0.0% $PNG_REF_FILE $PNG_CUR_FILE $PNG_DIFF_FILE 2>&1)
+        AE_FILE=$COMPARE_DIR/${FILE_NAME}.ae
+
+        if test -f $AE_FILE; then
+            code=$(cat $AE_FILE)
+            rm -f $AE_FILE
             if (( $code > 0 )); then
                 echo "Different ref: $PNG_REF_FILE, current: $PNG_CUR_FILE, code: $code"
                 export VTEST_DIFF_FOUND=true
-                DIFF_NAME_LIST+=$FILE_NAME
+                DIFF_NAME_LIST+="$FILE_NAME "
 
                 cp $PNG_REF_FILE $COMPARE_DIR
                 cp $PNG_CUR_FILE $COMPARE_DIR
@@ -146,7 +176,22 @@ elif [ "$RUN_CMD" == "compare" ]; then
         echo "</html>" >> $HTML
     fi
 
-    if [ "$VTEST_DIFF_FOUND" != "true" ]; then
+    # Compare the timings
+    REF_TIMINGS=$PNG_REF_DIR/timings_ref.json
+    CUR_TIMINGS=$PNG_CUR_DIR/timings.json
+    if test -f $REF_TIMINGS && test -f $CUR_TIMINGS; then
+        echo "Compare timings, threshold: $TIME_THRESHOLD%, at least $TIME_MIN_MS ms"
+        cp $HERE/style.css $COMPARE_DIR
+        python3 $HERE/vtest_timings.py $REF_TIMINGS $CUR_TIMINGS \
+            --threshold $TIME_THRESHOLD --min-ms $TIME_MIN_MS --html $COMPARE_DIR/vtest_timings.html
+        if [ $? -eq 2 ]; then
+            export VTEST_PERF_REGRESSION=true
+        fi
+    else
+        echo "No timings to compare"
+    fi
+
+    if [ "$VTEST_DIFF_FOUND" != "true" ] && [ "$VTEST_PERF_REGRESSION" != "true" ]; then
         rm -rf $COMPARE_DIR
     fi
 
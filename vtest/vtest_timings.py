@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# Compares the conversion timings of the reference and the current build,
+# as written by the converter with --job-result, and writes an html report.
+# Exits with 2 if a score got slower than the threshold allows.
+
+import argparse
+import html
+import json
+import os
+import sys
+
+FIELDS = ["timeMs", "loadMs", "layoutMs", "writeMs"]
+
+
+def read_timings(path):
+    with open(path) as f:
+        root = json.load(f)
+
+    timings = {}
+    for job in root.get("jobs", []):
+        if job.get("code", 0) != 0:
+            continue
+        name = os.path.basename(job["in"])
+        timings[name] = {field: float(job.get(field, 0)) for field in FIELDS}
+    return timings
+
+
+def delta_percent(ref, cur):
+    if ref <= 0:
+        return 0.0
+    return (cur - ref) * 100.0 / ref
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("ref", help="job result of the reference build")
+    parser.add_argument("cur", help="job result of the current build")
+    parser.add_argument("--threshold", type=float, default=20.0, help="allowed slowdown, percent")
+    parser.add_argument("--min-ms", type=float, default=50.0, help="smaller slowdowns are noise, ms")
+    parser.add_argument("--html", help="report file")
+    args = parser.parse_args()
+
+    ref = read_timings(args.ref)
+    cur = read_timings(args.cur)
+
+    rows = []
+    regressions = []
+    for name in sorted(set(ref) & set(cur)):
+        r = ref[name]
+        c = cur[name]
+        slower = c["timeMs"] - r["timeMs"]
+        regressed = slower >= args.min_ms and delta_percent(r["timeMs"], c["timeMs"]) > args.threshold
+        if regressed:
+            regressions.append(name)
+        rows.append((name, r, c, regressed))
+
+    ref_total = sum(r["timeMs"] for _, r, _, _ in rows)
+    cur_total = sum(c["timeMs"] for _, _, c, _ in rows)
+    print("Total time ref: {:.0f} ms, current: {:.0f} ms ({:+.1f}%)".format(ref_total, cur_total,
+                                                                           delta_percent(ref_total, cur_total)))
+    for name, r, c, regressed in rows:
+        if regressed:
+            print("Slower: {}, ref: {:.0f} ms, current: {:.0f} ms ({:+.1f}%)".format(
+                name, r["timeMs"], c["timeMs"], delta_percent(r["timeMs"], c["timeMs"])))
+
+    if args.html:
+        write_html(args.html, rows, ref_total, cur_total, args)
+
+    return 2 if regressions else 0
+
+
+def write_html(path, rows, ref_total, cur_total, args):
+    out = []
+    out.append("<html>")
+    out.append("  <head>")
+    out.append("   <link rel=\"stylesheet\" type=\"text/css\" href=\"style.css\">")
+    out.append("  </head>")
+    out.append("  <body>")
+    out.append("    <h2>Timings</h2>")
+    out.append("    <p>Threshold: {:.0f}%, at least {:.0f} ms. Total ref: {:.0f} ms, current: {:.0f} ms ({:+.1f}%)</p>".format(
+        args.threshold, args.min_ms, ref_total, cur_total, delta_percent(ref_total, cur_total)))
+    out.append("    <table class=\"timings\">")
+    header = "".join("<th>{0} ref</th><th>{0} current</th><th>{0} delta</th>".format(f[:-2]) for f in FIELDS)
+    out.append("      <tr><th>Score</th>{}</tr>".format(header))
+    for name, r, c, regressed in rows:
+        cells = []
+        for f in FIELDS:
+            d = delta_percent(r[f], c[f])
+            cls = "slower" if d > args.threshold else ("faster" if d < -args.threshold else "")
+            cells.append("<td>{:.0f}</td><td>{:.0f}</td><td class=\"{}\">{:+.1f}%</td>".format(r[f], c[f], cls, d))
+        row_cls = " class=\"regressed\"" if regressed else ""
+        out.append("      <tr{}><td>{}</td>{}</tr>".format(row_cls, html.escape(name), "".join(cells)))
+    out.append("    </table>")
+    out.append("  </body>")
+    out.append("</html>")
+
+    with open(path, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    sys.exit(main())